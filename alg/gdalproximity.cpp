@@ -18,20 +18,100 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
-static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
-                                   int *panNearY, int bForward, int iLine,
-                                   int nXSize, double nMaxDist,
-                                   float *pafProximity,
-                                   double *pdfSrcNoDataValue, int nTargetValues,
-                                   int *panTargetValues);
+/************************************************************************/
+/*                           IsTargetValue()                            */
+/************************************************************************/
+
+static bool IsTargetValue(GInt32 nValue, int nTargetValues,
+                          const int *panTargetValues)
+{
+    if (nTargetValues == 0)
+        return nValue != 0;
+    for (int i = 0; i < nTargetValues; i++)
+    {
+        if (nValue == panTargetValues[i])
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        ProcessProximityLine()                        */
+/*                                                                      */
+/*      Second (horizontal) phase of the separable Euclidean distance   */
+/*      transform of Meijster et al. / Felzenszwalb & Huttenlocher.     */
+/*      On input pafLine[] contains, for each column, the number of     */
+/*      lines to the nearest target pixel in that column, or a negative */
+/*      value if there is none within reach.  On output it contains     */
+/*      the exact distance in pixels to the nearest target pixel, or -1 */
+/*      if it is further than dfMaxDist.                                */
+/************************************************************************/
+
+static void ProcessProximityLine(float *pafLine, int nXSize, double dfYScale,
+                                 double dfMaxDist, int *panV, double *padfH,
+                                 double *padfZ)
+{
+    // Compute the lower envelope of the parabolas
+    // x -> (x - q)^2 + G(q)^2, where G(q) is the vertical distance of
+    // column q. panV[] are the columns whose parabola is part of the
+    // envelope, padfH[] their G(q)^2 + q^2 value, and padfZ[] the abscissa
+    // from which they are the minimum.
+    int k = -1;
+    for (int q = 0; q < nXSize; q++)
+    {
+        if (pafLine[q] < 0)
+            continue;
+        const double dfG = pafLine[q] * dfYScale;
+        const double dfH = dfG * dfG + static_cast<double>(q) * q;
+        double dfS = -std::numeric_limits<double>::infinity();
+        while (k >= 0)
+        {
+            dfS = (dfH - padfH[k]) / (2.0 * (q - panV[k]));
+            if (dfS > padfZ[k])
+                break;
+            k--;
+        }
+        k++;
+        panV[k] = q;
+        padfH[k] = dfH;
+        padfZ[k] = k == 0 ? -std::numeric_limits<double>::infinity() : dfS;
+    }
+
+    if (k < 0)
+    {
+        for (int x = 0; x < nXSize; x++)
+            pafLine[x] = -1.0f;
+        return;
+    }
+
+    // Evaluate the envelope on each pixel.
+    const double dfMaxDistSq = dfMaxDist * dfMaxDist;
+    for (int x = 0, j = 0; x < nXSize; x++)
+    {
+        while (j < k && padfZ[j + 1] < x)
+            j++;
+        const double dfDX = static_cast<double>(x) - panV[j];
+        const double dfDistSq = dfDX * dfDX + padfH[j] -
+                                static_cast<double>(panV[j]) * panV[j];
+        if (dfDistSq <= dfMaxDistSq)
+            pafLine[x] = static_cast<float>(sqrt(dfDistSq));
+        else
+            pafLine[x] = -1.0f;
+    }
+}
 
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
@@ -65,7 +145,9 @@ integers.
 
 Indicates whether distances will be computed in pixel units or
 in georeferenced units.  The default is pixel units.  This also
-determines the interpretation of MAXDIST.
+determines the interpretation of MAXDIST.  Starting with GDAL 3.12,
+non-square pixels are taken into account when computing distances
+in georeferenced units.
 
   MAXDIST=n
 
@@ -89,6 +171,15 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threshold are
 set to this fixed value instead of to a proximity distance.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.12) Number of worker threads used to compute the distances.
+Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+
+Starting with GDAL 3.12, distances are exact Euclidean distances, computed
+with a separable distance transform (Meijster et al., 2000) that only keeps
+a few lines in memory.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -108,6 +199,8 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     /*      Are we using pixels or georeferenced coordinates for distances? */
     /* -------------------------------------------------------------------- */
     double dfDistMult = 1.0;
+    // Height of a pixel, relatively to its width.
+    double dfYScale = 1.0;
     const char *pszOpt = CSLFetchNameValue(papszOptions, "DISTUNITS");
     if (pszOpt)
     {
@@ -119,12 +212,9 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
                 double adfGeoTransform[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
                 GDALGetGeoTransform(hSrcDS, adfGeoTransform);
-                if (std::abs(adfGeoTransform[1]) !=
-                    std::abs(adfGeoTransform[5]))
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Pixels not square, distances will be inaccurate.");
                 dfDistMult = std::abs(adfGeoTransform[1]);
+                if (adfGeoTransform[1] != 0 && adfGeoTransform[5] != 0)
+                    dfYScale = std::abs(adfGeoTransform[5]) / dfDistMult;
             }
         }
         else if (!EQUAL(pszOpt, "PIXEL"))
@@ -141,9 +231,10 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     /*      What is our maxdist value?                                      */
     /* -------------------------------------------------------------------- */
     pszOpt = CSLFetchNameValue(papszOptions, "MAXDIST");
-    const double dfMaxDist = pszOpt ? CPLAtof(pszOpt) / dfDistMult
-                                    : GDALGetRasterBandXSize(hSrcBand) +
-                                          GDALGetRasterBandYSize(hSrcBand);
+    const double dfMaxDist =
+        pszOpt ? CPLAtof(pszOpt) / dfDistMult
+               : GDALGetRasterBandXSize(hSrcBand) +
+                     GDALGetRasterBandYSize(hSrcBand) * std::max(1.0, dfYScale);
 
     CPLDebug("GDAL", "MAXDIST=%g, DISTMULT=%g", dfMaxDist, dfDistMult);
 
@@ -236,9 +327,10 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      We need a signed type for the working proximity values kept     */
-    /*      on disk.  If our proximity band is not signed, then create a    */
-    /*      temporary file for this purpose.                                */
+    /*      The first pass stores in the working band, for each pixel,      */
+    /*      the number of lines to the nearest target pixel above it in     */
+    /*      the same column, or -1.  If our proximity band cannot hold      */
+    /*      those values, then create a temporary file for this purpose.    */
     /* -------------------------------------------------------------------- */
     GDALRasterBandH hWorkProximityBand = hProximityBand;
     GDALDatasetH hWorkProximityDS = nullptr;
@@ -246,14 +338,28 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     CPLErr eErr = CE_None;
 
     // TODO(schwehr): Localize after removing gotos.
-    float *pafProximity = nullptr;
-    int *panNearX = nullptr;
-    int *panNearY = nullptr;
-    GInt32 *panSrcScanline = nullptr;
     bool bTempFileAlreadyDeleted = false;
+    int nBatchLines = 0;
+    std::vector<float> afProximity;
+    std::vector<GInt32> anSrc;
+    std::vector<int> anColDist;
+    const int nThreads = GDALGetNumThreads(papszOptions, "NUM_THREADS",
+                                         "GDAL_NUM_THREADS", 1);
+    CPLWorkerThreadPool *poThreadPool = nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+
+    bool bProxBandCanHoldLineCount = false;
+    if (GDALDataTypeIsSigned(eProxType) && !GDALDataTypeIsComplex(eProxType))
+    {
+        const int nBits = GDALGetDataTypeSizeBits(eProxType);
+        if (GDALDataTypeIsFloating(eProxType))
+            bProxBandCanHoldLineCount = nBits >= 32;
+        else
+            bProxBandCanHoldLineCount =
+                nBits >= 32 || nYSize <= (1 << (nBits - 1));
+    }
 
-    if (eProxType == GDT_Byte || eProxType == GDT_UInt16 ||
-        eProxType == GDT_UInt32)
+    if (!bProxBandCanHoldLineCount)
     {
         GDALDriverH hDriver = GDALGetDriverByName("GTiff");
         if (hDriver == nullptr)
@@ -279,63 +385,73 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Allocate buffer for two scanlines of distances as floats        */
-    /*      (the current and last line).                                    */
+    /*      Allocate buffers for a batch of lines.                          */
     /* -------------------------------------------------------------------- */
-    pafProximity =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    panNearX = static_cast<int *>(VSI_MALLOC2_VERBOSE(sizeof(int), nXSize));
-    panNearY = static_cast<int *>(VSI_MALLOC2_VERBOSE(sizeof(int), nXSize));
-    panSrcScanline =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    if (pafProximity == nullptr || panNearX == nullptr || panNearY == nullptr ||
-        panSrcScanline == nullptr)
+    nBatchLines = static_cast<int>(std::min<size_t>(
+        nYSize,
+        std::max<size_t>(nThreads, 16 * 1024 * 1024 /
+                                       ((sizeof(float) + sizeof(GInt32)) *
+                                        static_cast<size_t>(nXSize)))));
+    try
     {
+        afProximity.resize(static_cast<size_t>(nBatchLines) * nXSize);
+        anSrc.resize(static_cast<size_t>(nBatchLines) * nXSize);
+        anColDist.resize(nXSize, -1);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory allocating proximity buffers");
         eErr = CE_Failure;
         goto end;
     }
 
+    if (nThreads > 1 && nBatchLines > 1)
+        poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
     /* -------------------------------------------------------------------- */
-    /*      Loop from top to bottom of the image.                           */
+    /*      Loop from top to bottom of the image, computing the vertical    */
+    /*      distance to the nearest target pixel above.                     */
     /* -------------------------------------------------------------------- */
-
-    for (int i = 0; i < nXSize; i++)
+    for (int iLine = 0; eErr == CE_None && iLine < nYSize;
+         iLine += nBatchLines)
     {
-        panNearX[i] = -1;
-        panNearY[i] = -1;
-    }
+        const int nLines = std::min(nBatchLines, nYSize - iLine);
 
-    for (int iLine = 0; eErr == CE_None && iLine < nYSize; iLine++)
-    {
         // Read for target values.
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, 1,
-                            panSrcScanline, nXSize, 1, GDT_Int32, 0, 0);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, nLines,
+                            anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
         if (eErr != CE_None)
             break;
 
-        for (int i = 0; i < nXSize; i++)
-            pafProximity[i] = -1.0;
-
-        // Left to right.
-        ProcessProximityLine(panSrcScanline, panNearX, panNearY, TRUE, iLine,
-                             nXSize, dfMaxDist, pafProximity, pdfSrcNoData,
-                             nTargetValues, panTargetValues);
-
-        // Right to Left.
-        ProcessProximityLine(panSrcScanline, panNearX, panNearY, FALSE, iLine,
-                             nXSize, dfMaxDist, pafProximity, pdfSrcNoData,
-                             nTargetValues, panTargetValues);
+        for (int iBatchLine = 0; iBatchLine < nLines; iBatchLine++)
+        {
+            const size_t nOffset = static_cast<size_t>(iBatchLine) * nXSize;
+            for (int i = 0; i < nXSize; i++)
+            {
+                int &nDist = anColDist[i];
+                if (IsTargetValue(anSrc[nOffset + i], nTargetValues,
+                                  panTargetValues))
+                    nDist = 0;
+                else if (nDist >= 0 && (nDist + 1) * dfYScale <= dfMaxDist)
+                    nDist++;
+                else
+                    nDist = -1;
+                afProximity[nOffset + i] = static_cast<float>(nDist);
+            }
+        }
 
         // Write out results.
-        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, iLine, nXSize, 1,
-                            pafProximity, nXSize, 1, GDT_Float32, 0, 0);
-
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, iLine, nXSize,
+                            nLines, afProximity.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
         if (eErr != CE_None)
             break;
 
-        if (!pfnProgress(0.5 * (iLine + 1) / static_cast<double>(nYSize), "",
-                         pProgressArg))
+        if (!pfnProgress(0.5 * (iLine + nLines) / static_cast<double>(nYSize),
+                         "", pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
             eErr = CE_Failure;
@@ -343,59 +459,108 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Loop from bottom to top of the image.                           */
+    /*      Loop from bottom to top of the image, combining the vertical    */
+    /*      distances to the nearest target pixels above and below, and     */
+    /*      then computing the distance along each line.                    */
     /* -------------------------------------------------------------------- */
-    for (int i = 0; i < nXSize; i++)
-    {
-        panNearX[i] = -1;
-        panNearY[i] = -1;
-    }
+    std::fill(anColDist.begin(), anColDist.end(), -1);
 
-    for (int iLine = nYSize - 1; eErr == CE_None && iLine >= 0; iLine--)
+    for (int iLineEnd = nYSize; eErr == CE_None && iLineEnd > 0;
+         iLineEnd -= nBatchLines)
     {
-        // Read first pass proximity.
-        eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, iLine, nXSize, 1,
-                            pafProximity, nXSize, 1, GDT_Float32, 0, 0);
+        const int nLines = std::min(nBatchLines, iLineEnd);
+        const int iLine = iLineEnd - nLines;
 
+        // Read first pass distances.
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, iLine, nXSize,
+                            nLines, afProximity.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
         if (eErr != CE_None)
             break;
 
         // Read pixel values.
-
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, 1,
-                            panSrcScanline, nXSize, 1, GDT_Int32, 0, 0);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, nLines,
+                            anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
         if (eErr != CE_None)
             break;
 
-        // Right to left.
-        ProcessProximityLine(panSrcScanline, panNearX, panNearY, FALSE, iLine,
-                             nXSize, dfMaxDist, pafProximity, pdfSrcNoData,
-                             nTargetValues, panTargetValues);
-
-        // Left to right.
-        ProcessProximityLine(panSrcScanline, panNearX, panNearY, TRUE, iLine,
-                             nXSize, dfMaxDist, pafProximity, pdfSrcNoData,
-                             nTargetValues, panTargetValues);
-
-        // Final post processing of distances.
-        for (int i = 0; i < nXSize; i++)
+        for (int iBatchLine = nLines - 1; iBatchLine >= 0; iBatchLine--)
         {
-            if (pafProximity[i] < 0.0)
-                pafProximity[i] = fNoDataValue;
-            else if (pafProximity[i] > 0.0)
+            const size_t nOffset = static_cast<size_t>(iBatchLine) * nXSize;
+            for (int i = 0; i < nXSize; i++)
             {
-                if (bFixedBufVal)
-                    pafProximity[i] = static_cast<float>(dfFixedBufVal);
+                int &nDist = anColDist[i];
+                const float fUpDist = afProximity[nOffset + i];
+                if (fUpDist == 0)
+                    nDist = 0;
+                else if (nDist >= 0 && (nDist + 1) * dfYScale <= dfMaxDist)
+                    nDist++;
                 else
-                    pafProximity[i] =
-                        static_cast<float>(pafProximity[i] * dfDistMult);
+                    nDist = -1;
+                if (nDist >= 0 && (fUpDist < 0 || nDist < fUpDist))
+                    afProximity[nOffset + i] = static_cast<float>(nDist);
             }
         }
 
-        // Write out results.
-        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iLine, nXSize, 1,
-                            pafProximity, nXSize, 1, GDT_Float32, 0, 0);
+        // Compute the distances along the lines, in parallel if possible,
+        // and do the final post processing of distances.
+        const int nJobs = poJobQueue ? std::min(nThreads, nLines) : 1;
+        for (int iJob = 0; iJob < nJobs; iJob++)
+        {
+            const auto ProcessLines =
+                [&afProximity, &anSrc, nXSize, dfYScale, dfMaxDist,
+                 pdfSrcNoData, bFixedBufVal, dfFixedBufVal, fNoDataValue,
+                 dfDistMult](int iFirstLine, int iLastLine)
+            {
+                std::vector<int> anV(nXSize);
+                std::vector<double> adfH(nXSize);
+                std::vector<double> adfZ(nXSize);
+                for (int iBatchLine = iFirstLine; iBatchLine < iLastLine;
+                     iBatchLine++)
+                {
+                    const size_t nOffset =
+                        static_cast<size_t>(iBatchLine) * nXSize;
+                    float *pafLine = afProximity.data() + nOffset;
+                    ProcessProximityLine(pafLine, nXSize, dfYScale, dfMaxDist,
+                                         anV.data(), adfH.data(),
+                                         adfZ.data());
+                    for (int i = 0; i < nXSize; i++)
+                    {
+                        if (pafLine[i] > 0.0f && pdfSrcNoData != nullptr &&
+                            anSrc[nOffset + i] == *pdfSrcNoData)
+                            pafLine[i] = -1.0f;
+
+                        if (pafLine[i] < 0.0f)
+                            pafLine[i] = fNoDataValue;
+                        else if (pafLine[i] > 0.0f)
+                        {
+                            if (bFixedBufVal)
+                                pafLine[i] = static_cast<float>(dfFixedBufVal);
+                            else
+                                pafLine[i] =
+                                    static_cast<float>(pafLine[i] * dfDistMult);
+                        }
+                    }
+                }
+            };
+
+            const int iFirstLine =
+                static_cast<int>(static_cast<int64_t>(nLines) * iJob / nJobs);
+            const int iLastLine = static_cast<int>(
+                static_cast<int64_t>(nLines) * (iJob + 1) / nJobs);
+            if (nJobs == 1)
+                ProcessLines(iFirstLine, iLastLine);
+            else
+                poJobQueue->SubmitJob([ProcessLines, iFirstLine, iLastLine]()
+                                      { ProcessLines(iFirstLine, iLastLine); });
+        }
+        if (nJobs > 1)
+            poJobQueue->WaitCompletion();
 
+        // Write out results.
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iLine, nXSize, nLines,
+                            afProximity.data(), nXSize, nLines, GDT_Float32, 0,
+                            0);
         if (eErr != CE_None)
             break;
 
@@ -412,10 +577,6 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
 /*      Cleanup                                                         */
 /* -------------------------------------------------------------------- */
 end:
-    CPLFree(panNearX);
-    CPLFree(panNearY);
-    CPLFree(panSrcScanline);
-    CPLFree(pafProximity);
     CPLFree(panTargetValues);
 
     if (hWorkProximityDS != nullptr)
@@ -430,146 +591,3 @@ end:
 
     return eErr;
 }
-
-/************************************************************************/
-/*                         SquareDistance()                             */
-/************************************************************************/
-
-static double SquareDistance(double dfX1, double dfX2, double dfY1, double dfY2)
-{
-    const double dfDX = dfX1 - dfX2;
-    const double dfDY = dfY1 - dfY2;
-    return dfDX * dfDX + dfDY * dfDY;
-}
-
-/************************************************************************/
-/*                        ProcessProximityLine()                        */
-/************************************************************************/
-
-static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
-                                   int *panNearY, int bForward, int iLine,
-                                   int nXSize, double dfMaxDist,
-                                   float *pafProximity,
-                                   double *pdfSrcNoDataValue, int nTargetValues,
-                                   int *panTargetValues)
-
-{
-    const int iStart = bForward ? 0 : nXSize - 1;
-    const int iEnd = bForward ? nXSize : -1;
-    const int iStep = bForward ? 1 : -1;
-
-    for (int iPixel = iStart; iPixel != iEnd; iPixel += iStep)
-    {
-        bool bIsTarget = false;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Is the current pixel a target pixel? */
-        /* --------------------------------------------------------------------
-         */
-        if (nTargetValues == 0)
-        {
-            bIsTarget = panSrcScanline[iPixel] != 0;
-        }
-        else
-        {
-            for (int i = 0; i < nTargetValues; i++)
-            {
-                if (panSrcScanline[iPixel] == panTargetValues[i])
-                    bIsTarget = TRUE;
-            }
-        }
-
-        if (bIsTarget)
-        {
-            pafProximity[iPixel] = 0.0;
-            panNearX[iPixel] = iPixel;
-            panNearY[iPixel] = iLine;
-            continue;
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Are we near(er) to the closest target to the above (below) */
-        /*      pixel? */
-        /* --------------------------------------------------------------------
-         */
-        double dfNearDistSq = std::max(dfMaxDist, static_cast<double>(nXSize)) *
-                              std::max(dfMaxDist, static_cast<double>(nXSize)) *
-                              2.0;
-
-        if (panNearX[iPixel] != -1)
-        {
-            const double dfDistSq = SquareDistance(panNearX[iPixel], iPixel,
-                                                   panNearY[iPixel], iLine);
-
-            if (dfDistSq < dfNearDistSq)
-            {
-                dfNearDistSq = dfDistSq;
-            }
-            else
-            {
-                panNearX[iPixel] = -1;
-                panNearY[iPixel] = -1;
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Are we near(er) to the closest target to the left (right) */
-        /*      pixel? */
-        /* --------------------------------------------------------------------
-         */
-        const int iLast = iPixel - iStep;
-
-        if (iPixel != iStart && panNearX[iLast] != -1)
-        {
-            const double dfDistSq =
-                SquareDistance(panNearX[iLast], iPixel, panNearY[iLast], iLine);
-
-            if (dfDistSq < dfNearDistSq)
-            {
-                dfNearDistSq = dfDistSq;
-                panNearX[iPixel] = panNearX[iLast];
-                panNearY[iPixel] = panNearY[iLast];
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Are we near(er) to the closest target to the topright */
-        /*      (bottom left) pixel? */
-        /* --------------------------------------------------------------------
-         */
-        const int iTR = iPixel + iStep;
-
-        if (iTR != iEnd && panNearX[iTR] != -1)
-        {
-            const double dfDistSq =
-                SquareDistance(panNearX[iTR], iPixel, panNearY[iTR], iLine);
-
-            if (dfDistSq < dfNearDistSq)
-            {
-                dfNearDistSq = dfDistSq;
-                panNearX[iPixel] = panNearX[iTR];
-                panNearY[iPixel] = panNearY[iTR];
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Update our proximity value. */
-        /* --------------------------------------------------------------------
-         */
-        if (panNearX[iPixel] != -1 &&
-            (pdfSrcNoDataValue == nullptr ||
-             panSrcScanline[iPixel] != *pdfSrcNoDataValue) &&
-            dfNearDistSq <= dfMaxDist * dfMaxDist &&
-            (pafProximity[iPixel] < 0 ||
-             dfNearDistSq < static_cast<double>(pafProximity[iPixel]) *
-                                pafProximity[iPixel]))
-            pafProximity[iPixel] = static_cast<float>(sqrt(dfNearDistSq));
-    }
-
-    return CE_None;
-}
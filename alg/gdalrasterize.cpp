@@ -16,22 +16,27 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
 #include <limits>
+#include <memory>
 #include <vector>
 #include <algorithm>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -1461,6 +1466,323 @@ static CPLErr GDALRasterizeGeometriesInternal(
     return eErr;
 }
 
+namespace
+{
+struct GDALRasterizeFeature
+{
+    std::unique_ptr<OGRGeometry> poGeom{};
+    double dfAttrValue = 0;
+    // Range of lines that the geometry may touch. Empty if nYMin > nYMax.
+    int nYMin = 0;
+    int nYMax = -1;
+};
+}  // namespace
+
+/************************************************************************/
+/*                  GDALRasterizeLayerMultiThreaded()                   */
+/*                                                                      */
+/*      Features are read by batches. The range of lines touched by     */
+/*      each geometry is computed by worker threads, and used to        */
+/*      dispatch the geometries into buckets of consecutive lines.      */
+/*      Each bucket is then burnt by a single thread, in the order of   */
+/*      the features, so that the result is the same as with the        */
+/*      single-threaded code, whatever the merge algorithm.             */
+/*      apTransformArgs contains one transformer per thread.            */
+/************************************************************************/
+
+static CPLErr GDALRasterizeLayerMultiThreaded(
+    GDALDataset *poDS, int nBandCount, int *panBandList, GDALDataType eType,
+    OGRLayer *poLayer, int iBurnField, const double *padfBurnValues,
+    GDALTransformerFunc pfnTransformer,
+    const std::vector<void *> &apTransformArgs, int nYChunkSize,
+    unsigned char *pabyChunkBuf, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSource, GDALRasterMergeAlg eMergeAlg,
+    CPLJobQueue *poJobQueue, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const int nThreads = static_cast<int>(apTransformArgs.size());
+    const bool bSingleChunk = nYChunkSize == nYSize;
+
+    // Each chunk is split in at most nThreads buckets
+    const int nBucketYSize = DIV_ROUND_UP(nYChunkSize, nThreads);
+    const int nBucketsPerChunk = DIV_ROUND_UP(nYChunkSize, nBucketYSize);
+    const int nChunks = DIV_ROUND_UP(nYSize, nYChunkSize);
+    const auto GetBucket = [nYChunkSize, nBucketYSize, nBucketsPerChunk](int iY)
+    {
+        return (iY / nYChunkSize) * nBucketsPerChunk +
+               (iY % nYChunkSize) / nBucketYSize;
+    };
+
+    const GSpacing nLineSpace =
+        static_cast<GSpacing>(nXSize) * GDALGetDataTypeSizeBytes(eType);
+    const GIntBig nFeatureCount = poLayer->GetFeatureCount(FALSE);
+
+    // Limit the number of geometries held in memory
+    constexpr size_t MAX_BATCH_FEATURES = 100 * 1000;
+    constexpr size_t MAX_BATCH_BYTES = 256 * 1024 * 1024;
+
+    std::vector<GDALRasterizeFeature> aoBatch;
+    std::vector<std::vector<int>> aanBuckets;
+    try
+    {
+        aanBuckets.resize(static_cast<size_t>(nChunks) * nBucketsPerChunk);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeLayers()");
+        return CE_Failure;
+    }
+
+    CPLErr eErr = CE_None;
+    GIntBig nFeaturesDone = 0;
+    bool bEOF = false;
+    poLayer->ResetReading();
+    while (eErr == CE_None && !bEOF)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Read a batch of features.                                   */
+        /* ---------------------------------------------------------------- */
+        aoBatch.clear();
+        size_t nBatchBytes = 0;
+        while (aoBatch.size() < MAX_BATCH_FEATURES &&
+               nBatchBytes < MAX_BATCH_BYTES)
+        {
+            auto poFeature = std::unique_ptr<OGRFeature>(
+                poLayer->GetNextFeature());
+            if (!poFeature)
+            {
+                bEOF = true;
+                break;
+            }
+            ++nFeaturesDone;
+            GDALRasterizeFeature oFeature;
+            oFeature.poGeom.reset(poFeature->StealGeometry());
+            if (oFeature.poGeom == nullptr || oFeature.poGeom->IsEmpty())
+                continue;
+            if (iBurnField >= 0)
+                oFeature.dfAttrValue = poFeature->GetFieldAsDouble(iBurnField);
+            nBatchBytes += oFeature.poGeom->WkbSize();
+            aoBatch.push_back(std::move(oFeature));
+        }
+        const int nBatchSize = static_cast<int>(aoBatch.size());
+
+        /* ---------------------------------------------------------------- */
+        /*      Compute the range of lines touched by each geometry.        */
+        /* ---------------------------------------------------------------- */
+        const int nJobs = std::min(nThreads, nBatchSize);
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+        for (int iJob = 0; iJob < nJobs; iJob++)
+        {
+            const int iStart = static_cast<int>(
+                static_cast<GIntBig>(iJob) * nBatchSize / nJobs);
+            const int iEnd = static_cast<int>(
+                static_cast<GIntBig>(iJob + 1) * nBatchSize / nJobs);
+            void *pTransformArg = apTransformArgs[iJob];
+            auto &oErrorAccumulator = aoErrorAccumulators[iJob];
+            poJobQueue->SubmitJob(
+                [&aoBatch, &oErrorAccumulator, iStart, iEnd, nYSize,
+                 pfnTransformer, pTransformArg, eBurnValueSource]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+
+                    std::vector<double> aPointX;
+                    std::vector<double> aPointY;
+                    std::vector<double> aPointVariant;
+                    std::vector<int> aPartSize;
+                    std::vector<int> anSuccess;
+                    for (int i = iStart; i < iEnd; i++)
+                    {
+                        auto &oFeature = aoBatch[i];
+                        aPointX.clear();
+                        aPointY.clear();
+                        aPointVariant.clear();
+                        aPartSize.clear();
+                        GDALCollectRingsFromGeometry(
+                            oFeature.poGeom.get(), aPointX, aPointY,
+                            aPointVariant, aPartSize, eBurnValueSource);
+                        if (aPointY.empty())
+                            continue;
+
+                        // Be conservative if a point cannot be transformed
+                        oFeature.nYMin = 0;
+                        oFeature.nYMax = nYSize - 1;
+                        if (pfnTransformer != nullptr)
+                        {
+                            anSuccess.assign(aPointX.size(), 0);
+                            pfnTransformer(
+                                pTransformArg, FALSE,
+                                static_cast<int>(aPointX.size()),
+                                aPointX.data(), aPointY.data(), nullptr,
+                                anSuccess.data());
+                            if (std::find(anSuccess.begin(), anSuccess.end(),
+                                          0) != anSuccess.end())
+                                continue;
+                        }
+
+                        double dfMinY = std::numeric_limits<double>::max();
+                        double dfMaxY = -std::numeric_limits<double>::max();
+                        bool bValid = true;
+                        for (const double dfY : aPointY)
+                        {
+                            if (!std::isfinite(dfY))
+                            {
+                                bValid = false;
+                                break;
+                            }
+                            dfMinY = std::min(dfMinY, dfY);
+                            dfMaxY = std::max(dfMaxY, dfY);
+                        }
+                        if (!bValid)
+                            continue;
+
+                        // One line of margin for the rounding done when
+                        // burning
+                        dfMinY = std::max(dfMinY - 1, 0.0);
+                        dfMaxY = std::min(dfMaxY + 1, nYSize - 1.0);
+                        if (dfMinY > dfMaxY)
+                        {
+                            oFeature.nYMax = -1;
+                        }
+                        else
+                        {
+                            oFeature.nYMin = static_cast<int>(dfMinY);
+                            oFeature.nYMax = static_cast<int>(dfMaxY);
+                        }
+                    }
+                });
+        }
+        poJobQueue->WaitCompletion();
+        for (auto &oErrorAccumulator : aoErrorAccumulators)
+            oErrorAccumulator.ReplayErrors();
+
+        /* ---------------------------------------------------------------- */
+        /*      Dispatch the geometries into buckets of lines.              */
+        /* ---------------------------------------------------------------- */
+        for (auto &anBucket : aanBuckets)
+            anBucket.clear();
+        try
+        {
+            for (int i = 0; i < nBatchSize; i++)
+            {
+                const auto &oFeature = aoBatch[i];
+                if (oFeature.nYMin > oFeature.nYMax)
+                    continue;
+                const int iLastBucket = GetBucket(oFeature.nYMax);
+                for (int iBucket = GetBucket(oFeature.nYMin);
+                     iBucket <= iLastBucket; iBucket++)
+                {
+                    aanBuckets[iBucket].push_back(i);
+                }
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALRasterizeLayers()");
+            return CE_Failure;
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Burn the buckets of each chunk concurrently.                */
+        /* ---------------------------------------------------------------- */
+        for (int iChunk = 0; eErr == CE_None && iChunk < nChunks; iChunk++)
+        {
+            const int iY = iChunk * nYChunkSize;
+            const int nThisYChunkSize = std::min(nYChunkSize, nYSize - iY);
+            const auto oIterFirstBucket =
+                aanBuckets.begin() +
+                static_cast<size_t>(iChunk) * nBucketsPerChunk;
+            if (std::all_of(oIterFirstBucket,
+                            oIterFirstBucket + nBucketsPerChunk,
+                            [](const std::vector<int> &anBucket)
+                            { return anBucket.empty(); }))
+            {
+                continue;
+            }
+
+            // Only re-read image if not a single chunk is being rendered.
+            if (!bSingleChunk)
+            {
+                eErr = poDS->RasterIO(GF_Read, 0, iY, nXSize, nThisYChunkSize,
+                                      pabyChunkBuf, nXSize, nThisYChunkSize,
+                                      eType, nBandCount, panBandList, 0, 0, 0,
+                                      nullptr);
+                if (eErr != CE_None)
+                    break;
+            }
+
+            const GSpacing nBandSpace = nLineSpace * nThisYChunkSize;
+            for (int iBucket = 0; iBucket < nBucketsPerChunk; iBucket++)
+            {
+                const int nBucketYOff = iBucket * nBucketYSize;
+                const auto &anBucket = oIterFirstBucket[iBucket];
+                if (nBucketYOff >= nThisYChunkSize || anBucket.empty())
+                    continue;
+                const int nThisBucketYSize =
+                    std::min(nBucketYSize, nThisYChunkSize - nBucketYOff);
+                unsigned char *pabyBucketBuf =
+                    pabyChunkBuf + nBucketYOff * nLineSpace;
+                void *pTransformArg = apTransformArgs[iBucket];
+                poJobQueue->SubmitJob(
+                    [&aoBatch, &anBucket, pabyBucketBuf, iY, nBucketYOff,
+                     nXSize, nThisBucketYSize, nBandCount, eType, nLineSpace,
+                     nBandSpace, bAllTouched, iBurnField, padfBurnValues,
+                     eBurnValueSource, eMergeAlg, pfnTransformer,
+                     pTransformArg]()
+                    {
+                        std::vector<double> adfAttrValues(nBandCount);
+                        for (const int i : anBucket)
+                        {
+                            const auto &oFeature = aoBatch[i];
+                            const double *padfThisBurnValues = padfBurnValues;
+                            if (iBurnField >= 0)
+                            {
+                                std::fill(adfAttrValues.begin(),
+                                          adfAttrValues.end(),
+                                          oFeature.dfAttrValue);
+                                padfThisBurnValues = adfAttrValues.data();
+                            }
+                            gv_rasterize_one_shape(
+                                pabyBucketBuf, 0, iY + nBucketYOff, nXSize,
+                                nThisBucketYSize, nBandCount, eType, 0,
+                                nLineSpace, nBandSpace, bAllTouched,
+                                oFeature.poGeom.get(), GDT_Float64,
+                                padfThisBurnValues, nullptr, eBurnValueSource,
+                                eMergeAlg, pfnTransformer, pTransformArg);
+                        }
+                    });
+            }
+            poJobQueue->WaitCompletion();
+
+            // Only write image if not a single chunk is being rendered.
+            if (!bSingleChunk)
+            {
+                eErr = poDS->RasterIO(GF_Write, 0, iY, nXSize, nThisYChunkSize,
+                                      pabyChunkBuf, nXSize, nThisYChunkSize,
+                                      eType, nBandCount, panBandList, 0, 0, 0,
+                                      nullptr);
+            }
+        }
+
+        const double dfProgress =
+            nFeatureCount > 0
+                ? std::min(1.0, static_cast<double>(nFeaturesDone) /
+                                    static_cast<double>(nFeatureCount))
+                : 0.0;
+        if (eErr == CE_None && !pfnProgress(dfProgress, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1516,6 +1838,14 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.12) Number of threads to use, or ALL_CPUS.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * When more than one thread is used, features are read once by batches, and
+ * dispatched into buckets of lines according to their extent. Buckets are
+ * burnt concurrently, each one in the order of features, so that the result
+ * is the same as with a single thread. This requires the transformer to be
+ * a GenImgProj transformer, such as the one created when pfnTransformer is
+ * NULL.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1618,6 +1948,12 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
     CPLErr eErr = CE_None;
     const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
 
+    const int nThreads = GDALGetNumThreads(papszOptions, "NUM_THREADS",
+                                         "GDAL_NUM_THREADS", 1);
+    auto poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
     pfnProgress(0.0, nullptr, pProgressArg);
 
     for (int iLayer = 0; iLayer < nLayerCount; iLayer++)
@@ -1720,79 +2056,117 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
             }
         }
 
-        poLayer->ResetReading();
-
         /* --------------------------------------------------------------------
          */
-        /*      Loop over image in designated chunks. */
+        /*      Use worker threads if asked to, and if we can have one */
+        /*      transformer per thread. */
         /* --------------------------------------------------------------------
          */
-
-        double *padfAttrValues = static_cast<double *>(
-            VSI_MALLOC_VERBOSE(sizeof(double) * nBandCount));
-        if (padfAttrValues == nullptr)
-            eErr = CE_Failure;
-
-        for (int iY = 0; iY < poDS->GetRasterYSize() && eErr == CE_None;
-             iY += nYChunkSize)
+        std::vector<void *> apTransformArgs;
+        if (poJobQueue &&
+            GDALIsTransformer(pTransformArg,
+                              GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME))
         {
-            int nThisYChunkSize = nYChunkSize;
-            if (nThisYChunkSize + iY > poDS->GetRasterYSize())
-                nThisYChunkSize = poDS->GetRasterYSize() - iY;
-
-            // Only re-read image if not a single chunk is being rendered.
-            if (nYChunkSize < poDS->GetRasterYSize())
+            apTransformArgs.push_back(pTransformArg);
+            for (int i = 1; i < nThreads; i++)
             {
-                eErr = poDS->RasterIO(
-                    GF_Read, 0, iY, poDS->GetRasterXSize(), nThisYChunkSize,
-                    pabyChunkBuf, poDS->GetRasterXSize(), nThisYChunkSize,
-                    eType, nBandCount, panBandList, 0, 0, 0, nullptr);
-                if (eErr != CE_None)
+                void *pClonedTransformArg = GDALCloneTransformer(pTransformArg);
+                if (pClonedTransformArg == nullptr)
                     break;
+                apTransformArgs.push_back(pClonedTransformArg);
             }
+        }
+
+        if (static_cast<int>(apTransformArgs.size()) == nThreads)
+        {
+            eErr = GDALRasterizeLayerMultiThreaded(
+                poDS, nBandCount, panBandList, eType, poLayer, iBurnField,
+                padfBurnValues, pfnTransformer, apTransformArgs, nYChunkSize,
+                pabyChunkBuf, bAllTouched, eBurnValueSource, eMergeAlg,
+                poJobQueue.get(), pfnProgress, pProgressArg);
+        }
+        else
+        {
+            poLayer->ResetReading();
 
-            for (auto &poFeat : poLayer)
+            /* -------------------------------------------------------------- */
+            /*      Loop over image in designated chunks.                     */
+            /* -------------------------------------------------------------- */
+
+            double *padfAttrValues = static_cast<double *>(
+                VSI_MALLOC_VERBOSE(sizeof(double) * nBandCount));
+            if (padfAttrValues == nullptr)
+                eErr = CE_Failure;
+
+            for (int iY = 0; iY < poDS->GetRasterYSize() && eErr == CE_None;
+                 iY += nYChunkSize)
             {
-                OGRGeometry *poGeom = poFeat->GetGeometryRef();
+                int nThisYChunkSize = nYChunkSize;
+                if (nThisYChunkSize + iY > poDS->GetRasterYSize())
+                    nThisYChunkSize = poDS->GetRasterYSize() - iY;
 
-                if (pszBurnAttribute)
+                // Only re-read image if not a single chunk is being rendered.
+                if (nYChunkSize < poDS->GetRasterYSize())
                 {
-                    const double dfAttrValue =
-                        poFeat->GetFieldAsDouble(iBurnField);
-                    for (int iBand = 0; iBand < nBandCount; iBand++)
-                        padfAttrValues[iBand] = dfAttrValue;
-
-                    padfBurnValues = padfAttrValues;
+                    eErr = poDS->RasterIO(
+                        GF_Read, 0, iY, poDS->GetRasterXSize(), nThisYChunkSize,
+                        pabyChunkBuf, poDS->GetRasterXSize(), nThisYChunkSize,
+                        eType, nBandCount, panBandList, 0, 0, 0, nullptr);
+                    if (eErr != CE_None)
+                        break;
                 }
 
-                gv_rasterize_one_shape(
-                    pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
-                    nThisYChunkSize, nBandCount, eType, 0, 0, 0, bAllTouched,
-                    poGeom, GDT_Float64, padfBurnValues, nullptr,
-                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
-            }
+                for (auto &poFeat : poLayer)
+                {
+                    OGRGeometry *poGeom = poFeat->GetGeometryRef();
 
-            // Only write image if not a single chunk is being rendered.
-            if (nYChunkSize < poDS->GetRasterYSize())
-            {
-                eErr = poDS->RasterIO(
-                    GF_Write, 0, iY, poDS->GetRasterXSize(), nThisYChunkSize,
-                    pabyChunkBuf, poDS->GetRasterXSize(), nThisYChunkSize,
-                    eType, nBandCount, panBandList, 0, 0, 0, nullptr);
-            }
+                    if (pszBurnAttribute)
+                    {
+                        const double dfAttrValue =
+                            poFeat->GetFieldAsDouble(iBurnField);
+                        for (int iBand = 0; iBand < nBandCount; iBand++)
+                            padfAttrValues[iBand] = dfAttrValue;
 
-            poLayer->ResetReading();
+                        padfBurnValues = padfAttrValues;
+                    }
 
-            if (!pfnProgress((iY + nThisYChunkSize) /
-                                 static_cast<double>(poDS->GetRasterYSize()),
-                             "", pProgressArg))
-            {
-                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                eErr = CE_Failure;
+                    gv_rasterize_one_shape(
+                        pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
+                        nThisYChunkSize, nBandCount, eType, 0, 0, 0,
+                        bAllTouched, poGeom, GDT_Float64, padfBurnValues,
+                        nullptr, eBurnValueSource, eMergeAlg, pfnTransformer,
+                        pTransformArg);
+                }
+
+                // Only write image if not a single chunk is being rendered.
+                if (nYChunkSize < poDS->GetRasterYSize())
+                {
+                    eErr = poDS->RasterIO(GF_Write, 0, iY,
+                                          poDS->GetRasterXSize(),
+                                          nThisYChunkSize, pabyChunkBuf,
+                                          poDS->GetRasterXSize(),
+                                          nThisYChunkSize, eType, nBandCount,
+                                          panBandList, 0, 0, 0, nullptr);
+                }
+
+                poLayer->ResetReading();
+
+                if (!pfnProgress(
+                        (iY + nThisYChunkSize) /
+                            static_cast<double>(poDS->GetRasterYSize()),
+                        "", pProgressArg))
+                {
+                    CPLError(CE_Failure, CPLE_UserInterrupt,
+                             "User terminated");
+                    eErr = CE_Failure;
+                }
             }
+
+            VSIFree(padfAttrValues);
         }
 
-        VSIFree(padfAttrValues);
+        for (size_t i = 1; i < apTransformArgs.size(); i++)
+            GDALDestroyTransformer(apTransformArgs[i]);
 
         if (bNeedToFreeTransformer)
         {
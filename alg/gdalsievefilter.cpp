@@ -17,16 +17,21 @@
 #include <cstring>
 
 #include <algorithm>
+#include <map>
 #include <set>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
@@ -125,6 +130,738 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                        ResolveBigNeighbours()                        */
+/*                                                                      */
+/*      If our biggest neighbour is still smaller than the              */
+/*      threshold, then try tracking to that polygons biggest           */
+/*      neighbour, and so forth.                                        */
+/************************************************************************/
+
+static void ResolveBigNeighbours(const int *panPolyIdMap,
+                                 const std::int64_t *panPolyValue,
+                                 const std::vector<int> &anPolySizes,
+                                 std::vector<int> &anBigNeighbour,
+                                 int nSizeThreshold)
+
+{
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
+    {
+        if (panPolyIdMap[iPoly] != iPoly)
+            continue;
+
+        // Ignore nodata polygons.
+        if (panPolyValue[iPoly] == GP_NODATA_MARKER)
+            continue;
+
+        // Don't try to merge polygons larger than the threshold.
+        if (anPolySizes[iPoly] >= nSizeThreshold)
+        {
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        nSieveTargets++;
+
+        // if we have no neighbours but we are small, what shall we do?
+        if (anBigNeighbour[iPoly] == -1)
+        {
+            nIsolatedSmall++;
+            continue;
+        }
+
+        std::set<int> oSetVisitedPoly;
+        oSetVisitedPoly.insert(iPoly);
+
+        // Walk through our neighbours until we find a polygon large enough.
+        int iFinalId = iPoly;
+        bool bFoundBigEnoughPoly = false;
+        while (true)
+        {
+            iFinalId = anBigNeighbour[iFinalId];
+            if (iFinalId < 0)
+            {
+                break;
+            }
+            // If the biggest neighbour is larger than the threshold
+            // then we are golden.
+            if (anPolySizes[iFinalId] >= nSizeThreshold)
+            {
+                bFoundBigEnoughPoly = true;
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+                break;
+            oSetVisitedPoly.insert(iFinalId);
+        }
+
+        if (!bFoundBigEnoughPoly)
+        {
+            nFailedMerges++;
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        // Map the whole intermediate chain to it.
+        int iPolyCur = iPoly;
+        while (anBigNeighbour[iPolyCur] != iFinalId)
+        {
+            int iNextPoly = anBigNeighbour[iPolyCur];
+            anBigNeighbour[iPolyCur] = iFinalId;
+            iPolyCur = iNextPoly;
+        }
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+}
+
+/************************************************************************/
+/*                               GSStrip                                */
+/*                                                                      */
+/*      A horizontal strip of the raster, processed independently of    */
+/*      its neighbours by a worker thread.                              */
+/************************************************************************/
+
+namespace
+{
+struct GSStrip
+{
+    int nYOff = 0;
+    int nYSize = 0;
+    // Pixel values, set to GP_NODATA_MARKER where the mask is zero
+    std::vector<std::int64_t> anVal{};
+    // Unmasked pixel values, only read when applying the merges
+    std::vector<std::int64_t> anWriteVal{};
+    std::vector<GInt32> anId{};
+    // First pass: local polygon id map, value and size of each fragment
+    std::vector<GInt32> anPolyIdMap{};
+    std::vector<std::int64_t> anPolyValue{};
+    std::vector<int> anPolySize{};
+    // Second pass: biggest neighbour of the polygons whose final id is a
+    // fragment of this strip, and of the polygons coming from above.
+    std::vector<GInt32> anBigNeighbour{};
+    std::map<GInt32, GInt32> oMapBigNeighbour{};
+    bool bOK = true;
+};
+}  // namespace
+
+/************************************************************************/
+/*                            GSReadStrip()                             */
+/************************************************************************/
+
+static CPLErr GSReadStrip(GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                          int nXSize, int nYOff, int nYSize,
+                          bool bKeepWriteVal, GByte *pabyMaskLine,
+                          GSStrip &oStrip)
+{
+    oStrip.nYOff = nYOff;
+    oStrip.nYSize = nYSize;
+    oStrip.bOK = true;
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+    try
+    {
+        oStrip.anVal.resize(nPixels);
+        oStrip.anId.resize(nPixels);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory allocating sieve strip");
+        return CE_Failure;
+    }
+
+    CPLErr eErr =
+        GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nYSize,
+                     oStrip.anVal.data(), nXSize, nYSize, GDT_Int64, 0, 0);
+    if (eErr == CE_None && bKeepWriteVal)
+    {
+        try
+        {
+            oStrip.anWriteVal = oStrip.anVal;
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory allocating sieve strip");
+            return CE_Failure;
+        }
+    }
+    for (int iY = 0; eErr == CE_None && hMaskBand != nullptr && iY < nYSize;
+         iY++)
+    {
+        eErr = GPMaskImageData(hMaskBand, pabyMaskLine, nYOff + iY, nXSize,
+                               oStrip.anVal.data() +
+                                   static_cast<size_t>(iY) * nXSize);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                            GSLabelStrip()                            */
+/*                                                                      */
+/*      Assign local polygon ids to the pixels of a strip, and collect   */
+/*      the value and size of its polygon fragments. When panFinalId    */
+/*      is provided, local ids are instead translated to the final      */
+/*      global ids computed by the stitching phase, starting at         */
+/*      nIdOffset.                                                      */
+/************************************************************************/
+
+static void GSLabelStrip(GSStrip &oStrip, int nXSize, int nConnectedness,
+                         const GInt32 *panFinalId, GInt32 nIdOffset)
+{
+    GDALRasterPolygonEnumerator oEnum(nConnectedness);
+    for (int iY = 0; iY < oStrip.nYSize; iY++)
+    {
+        const size_t nOffset = static_cast<size_t>(iY) * nXSize;
+        if (!oEnum.ProcessLine(
+                iY == 0 ? nullptr : oStrip.anVal.data() + nOffset - nXSize,
+                oStrip.anVal.data() + nOffset,
+                iY == 0 ? nullptr : oStrip.anId.data() + nOffset - nXSize,
+                oStrip.anId.data() + nOffset, nXSize))
+        {
+            oStrip.bOK = false;
+            return;
+        }
+    }
+    oEnum.CompleteMerges();
+
+    if (panFinalId)
+    {
+        for (auto &nId : oStrip.anId)
+        {
+            if (nId >= 0)
+                nId = panFinalId[nIdOffset + nId];
+        }
+        return;
+    }
+
+    try
+    {
+        oStrip.anPolyIdMap.assign(oEnum.panPolyIdMap,
+                                  oEnum.panPolyIdMap + oEnum.nNextPolygonId);
+        oStrip.anPolyValue.assign(oEnum.panPolyValue,
+                                  oEnum.panPolyValue + oEnum.nNextPolygonId);
+        oStrip.anPolySize.assign(oEnum.nNextPolygonId, 0);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        oStrip.bOK = false;
+        return;
+    }
+    // A strip has less than MY_MAX_INT pixels, so no overflow is possible.
+    for (const GInt32 nId : oStrip.anId)
+    {
+        if (nId >= 0)
+            oStrip.anPolySize[nId]++;
+    }
+}
+
+/************************************************************************/
+/*                        GSFindBigNeighbours()                         */
+/*                                                                      */
+/*      Find the biggest neighbour of each polygon met in a strip,      */
+/*      including across the seam with the previous strip, visiting     */
+/*      pairs of neighbours in the same order as the single threaded    */
+/*      code. Only a strictly bigger neighbour replaces the current     */
+/*      one, so that combining the results of the strips in order       */
+/*      gives the same result.                                          */
+/************************************************************************/
+
+static void GSFindBigNeighbours(GSStrip &oStrip, int nXSize,
+                                int nConnectedness,
+                                const GInt32 *panPrevLineId, GInt32 nIdOffset,
+                                size_t nFragments,
+                                const std::vector<int> &anPolySizes)
+{
+    try
+    {
+        oStrip.anBigNeighbour.assign(nFragments, -1);
+        oStrip.oMapBigNeighbour.clear();
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        oStrip.bOK = false;
+        return;
+    }
+
+    const auto Update = [&oStrip, nIdOffset, &anPolySizes](GInt32 nPolyId,
+                                                           GInt32 nOtherId)
+    {
+        GInt32 &nBig =
+            nPolyId >= nIdOffset
+                ? oStrip.anBigNeighbour[nPolyId - nIdOffset]
+                : oStrip.oMapBigNeighbour.emplace(nPolyId, -1).first->second;
+        if (nBig == -1 || anPolySizes[nBig] < anPolySizes[nOtherId])
+            nBig = nOtherId;
+    };
+
+    const auto Compare = [&Update](GInt32 nPolyId1, GInt32 nPolyId2)
+    {
+        if (nPolyId1 < 0 || nPolyId2 < 0 || nPolyId1 == nPolyId2)
+            return;
+        Update(nPolyId1, nPolyId2);
+        Update(nPolyId2, nPolyId1);
+    };
+
+    for (int iY = 0; iY < oStrip.nYSize; iY++)
+    {
+        const GInt32 *panThisLineId =
+            oStrip.anId.data() + static_cast<size_t>(iY) * nXSize;
+        const GInt32 *panLastLineId =
+            iY > 0 ? panThisLineId - nXSize : panPrevLineId;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (panLastLineId)
+            {
+                Compare(panThisLineId[iX], panLastLineId[iX]);
+
+                if (iX > 0 && nConnectedness == 8)
+                    Compare(panThisLineId[iX], panLastLineId[iX - 1]);
+
+                if (iX < nXSize - 1 && nConnectedness == 8)
+                    Compare(panThisLineId[iX], panLastLineId[iX + 1]);
+            }
+
+            if (iX > 0)
+                Compare(panThisLineId[iX], panThisLineId[iX - 1]);
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALSieveFilterMultiThreaded()                   */
+/*                                                                      */
+/*      Same plan as GDALSieveFilter(), but each pass processes         */
+/*      batches of horizontal strips in worker threads. Polygon         */
+/*      fragments of the strips are merged into a global union-find     */
+/*      forest, rooted at the smallest fragment id, whose size is       */
+/*      bounded by the number of polygon fragments and not by the       */
+/*      size of the raster. The result is identical to the single       */
+/*      threaded code.                                                  */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+    GDALRasterBandH hDstBand, int nSizeThreshold, int nConnectedness,
+    CPLWorkerThreadPool *poThreadPool, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Limit the size of a strip, so that memory use remains bounded
+    // to a strip per thread.
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    const size_t nBytesPerLine = static_cast<size_t>(nXSize) *
+                                 (2 * sizeof(std::int64_t) + sizeof(GInt32));
+    int nStripYSize = static_cast<int>(std::min<size_t>(
+        {static_cast<size_t>(nYSize),
+         std::max<size_t>(1, MAX_STRIP_BYTES / nBytesPerLine),
+         static_cast<size_t>(MY_MAX_INT / nXSize)}));
+    nStripYSize = std::min(nStripYSize, (nYSize + nThreads - 1) / nThreads);
+    const int nStrips = (nYSize + nStripYSize - 1) / nStripYSize;
+
+    std::vector<GByte> abyMaskLine;
+    std::vector<GInt32> anPrevLineId;
+    std::vector<std::int64_t> anPrevLineVal;
+    try
+    {
+        abyMaskLine.resize(nXSize);
+        anPrevLineId.resize(nXSize);
+        anPrevLineVal.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return CE_Failure;
+    }
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    std::vector<GSStrip> aoBatch(nThreads);
+
+    // Read the strips of a batch, and run fnJob on each of them in worker
+    // threads.
+    const auto ProcessBatch = [&](int iFirstStrip, int &nBatchSize,
+                                  bool bKeepWriteVal, const auto &fnJob)
+    {
+        nBatchSize = std::min(nThreads, nStrips - iFirstStrip);
+        for (int i = 0; i < nBatchSize; i++)
+        {
+            const int nYOff = (iFirstStrip + i) * nStripYSize;
+            if (GSReadStrip(hSrcBand, hMaskBand, nXSize, nYOff,
+                            std::min(nStripYSize, nYSize - nYOff),
+                            bKeepWriteVal, abyMaskLine.data(),
+                            aoBatch[i]) != CE_None)
+                return CE_Failure;
+        }
+
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nBatchSize);
+        for (int i = 0; i < nBatchSize; i++)
+        {
+            auto &oStrip = aoBatch[i];
+            auto &oErrorAccumulator = aoErrorAccumulators[i];
+            poJobQueue->SubmitJob(
+                [&oStrip, &oErrorAccumulator, &fnJob, iFirstStrip, i]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    fnJob(oStrip, iFirstStrip + i);
+                });
+        }
+        poJobQueue->WaitCompletion();
+
+        CPLErr eErr = CE_None;
+        for (int i = 0; i < nBatchSize; i++)
+        {
+            aoErrorAccumulators[i].ReplayErrors();
+            if (!aoBatch[i].bOK)
+                eErr = CE_Failure;
+        }
+        return eErr;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: label the strips, and stitch their polygon          */
+    /*      fragments together, accumulating their sizes.                   */
+    /* -------------------------------------------------------------------- */
+    std::vector<GInt32> anParent;
+    std::vector<std::int64_t> anPolyValue;
+    std::vector<int> anPolySizes;
+    std::vector<GInt32> anStripIdOffset;
+    std::vector<GInt32> anLocalRoot;
+
+    const auto Find = [&anParent](GInt32 nId)
+    {
+        while (anParent[nId] != nId)
+        {
+            anParent[nId] = anParent[anParent[nId]];
+            nId = anParent[nId];
+        }
+        return nId;
+    };
+
+    const auto Union = [&anParent, &Find](GInt32 nId1, GInt32 nId2)
+    {
+        nId1 = Find(nId1);
+        nId2 = Find(nId2);
+        if (nId1 < nId2)
+            anParent[nId2] = nId1;
+        else if (nId2 < nId1)
+            anParent[nId1] = nId2;
+    };
+
+    const auto Stitch = [&](GSStrip &oStrip)
+    {
+        const size_t nFragments = oStrip.anPolyIdMap.size();
+        if (nFragments >=
+            static_cast<size_t>(MY_MAX_INT) - anParent.size())
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "GDALSieveFilter(): too many polygon fragments");
+            return false;
+        }
+        const GInt32 nIdOffset = static_cast<GInt32>(anParent.size());
+        try
+        {
+            anStripIdOffset.push_back(nIdOffset);
+            anLocalRoot.assign(nFragments, -1);
+            anParent.reserve(anParent.size() + nFragments);
+            anPolyValue.insert(anPolyValue.end(), oStrip.anPolyValue.begin(),
+                               oStrip.anPolyValue.end());
+            anPolySizes.insert(anPolySizes.end(), oStrip.anPolySize.begin(),
+                               oStrip.anPolySize.end());
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALSieveFilter()");
+            return false;
+        }
+
+        // Merges inside the strip, rooted at the smallest local id.
+        for (size_t i = 0; i < nFragments; i++)
+        {
+            const GInt32 nRoot = oStrip.anPolyIdMap[i];
+            if (anLocalRoot[nRoot] < 0)
+                anLocalRoot[nRoot] = static_cast<GInt32>(i);
+            anParent.push_back(nIdOffset + anLocalRoot[nRoot]);
+        }
+        oStrip.anPolyIdMap.clear();
+        oStrip.anPolyValue.clear();
+        oStrip.anPolySize.clear();
+
+        // Merges across the seam with the previous strip, following
+        // the same neighbourhood rules as ProcessLine().
+        const GInt32 *panThisLineId = oStrip.anId.data();
+        const std::int64_t *panThisLineVal = oStrip.anVal.data();
+        for (int iX = 0; oStrip.nYOff > 0 && iX < nXSize; iX++)
+        {
+            if (panThisLineId[iX] < 0)
+                continue;
+            const GInt32 nId = nIdOffset + panThisLineId[iX];
+            for (int iXPrev = iX - (nConnectedness == 8 ? 1 : 0);
+                 iXPrev <= iX + (nConnectedness == 8 ? 1 : 0); iXPrev++)
+            {
+                if (iXPrev >= 0 && iXPrev < nXSize &&
+                    anPrevLineId[iXPrev] >= 0 &&
+                    anPrevLineVal[iXPrev] == panThisLineVal[iX])
+                {
+                    Union(anPrevLineId[iXPrev], nId);
+                }
+            }
+        }
+
+        const size_t nLastLineOffset =
+            static_cast<size_t>(oStrip.nYSize - 1) * nXSize;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const GInt32 nLocalId = oStrip.anId[nLastLineOffset + iX];
+            anPrevLineId[iX] = nLocalId < 0 ? -1 : nIdOffset + nLocalId;
+            anPrevLineVal[iX] = oStrip.anVal[nLastLineOffset + iX];
+        }
+        return true;
+    };
+
+    const auto LabelJob = [nXSize, nConnectedness](GSStrip &oStrip, int)
+    { GSLabelStrip(oStrip, nXSize, nConnectedness, nullptr, 0); };
+
+    CPLErr eErr = CE_None;
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips;)
+    {
+        int nBatchSize = 0;
+        eErr = ProcessBatch(iStrip, nBatchSize, false, LabelJob);
+        for (int i = 0; eErr == CE_None && i < nBatchSize; i++)
+        {
+            if (!Stitch(aoBatch[i]))
+                eErr = CE_Failure;
+        }
+        iStrip += nBatchSize;
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.25 * iStrip / nStrips, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+    anLocalRoot.clear();
+    anPrevLineVal.clear();
+
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Check if there are polygons                                     */
+    /* -------------------------------------------------------------------- */
+    if (anParent.empty())
+    {
+        // Can happen if all pixels are masked
+        if (hSrcBand == hDstBand)
+        {
+            pfnProgress(1.0, "", pProgressArg);
+            return CE_None;
+        }
+        else
+        {
+            return GDALRasterBandCopyWholeRaster(hSrcBand, hDstBand, nullptr,
+                                                 pfnProgress, pProgressArg);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Flatten the forest, and push the sizes of merged polygon        */
+    /*      fragments into the merged polygon id's count. Parents always   */
+    /*      have a smaller id than their children, so a single ascending   */
+    /*      pass is enough.                                                 */
+    /* -------------------------------------------------------------------- */
+    for (size_t i = 0; i < anParent.size(); i++)
+    {
+        const GInt32 nRoot = anParent[anParent[i]];
+        anParent[i] = nRoot;
+        if (nRoot != static_cast<GInt32>(i))
+        {
+            GIntBig nSize = anPolySizes[nRoot];
+
+            nSize += anPolySizes[i];
+
+            if (nSize > MY_MAX_INT)
+                nSize = MY_MAX_INT;
+
+            anPolySizes[nRoot] = static_cast<int>(nSize);
+            anPolySizes[i] = 0;
+        }
+    }
+
+    std::vector<int> anBigNeighbour;
+    try
+    {
+        anBigNeighbour.resize(anPolySizes.size(), -1);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s: Out of memory",
+                 __FUNCTION__);
+        return CE_Failure;
+    }
+
+    /* ==================================================================== */
+    /*      Second pass ... identify the largest neighbour for each         */
+    /*      polygon. The strips of a batch are labeled with final ids,      */
+    /*      before looking for neighbours, since each strip needs the       */
+    /*      last line of the previous one.                                  */
+    /* ==================================================================== */
+    const GInt32 *panFinalId = anParent.data();
+    const auto RelabelJob =
+        [nXSize, nConnectedness, panFinalId,
+         &anStripIdOffset](GSStrip &oStrip, int iStrip)
+    {
+        GSLabelStrip(oStrip, nXSize, nConnectedness, panFinalId,
+                     anStripIdOffset[iStrip]);
+    };
+
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips;)
+    {
+        int nBatchSize = 0;
+        eErr = ProcessBatch(iStrip, nBatchSize, false, RelabelJob);
+        if (eErr != CE_None)
+            break;
+
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nBatchSize);
+        for (int i = 0; i < nBatchSize; i++)
+        {
+            auto &oStrip = aoBatch[i];
+            auto &oErrorAccumulator = aoErrorAccumulators[i];
+            const GInt32 *panPrevLineId =
+                oStrip.nYOff == 0 ? nullptr
+                : i == 0          ? anPrevLineId.data()
+                                  : aoBatch[i - 1].anId.data() +
+                               static_cast<size_t>(aoBatch[i - 1].nYSize - 1) *
+                                   nXSize;
+            const GInt32 nIdOffset = anStripIdOffset[iStrip + i];
+            const size_t nFragments =
+                (iStrip + i + 1 < nStrips
+                     ? static_cast<size_t>(anStripIdOffset[iStrip + i + 1])
+                     : anParent.size()) -
+                nIdOffset;
+            poJobQueue->SubmitJob(
+                [&oStrip, &oErrorAccumulator, &anPolySizes, nXSize,
+                 nConnectedness, panPrevLineId, nIdOffset, nFragments]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    GSFindBigNeighbours(oStrip, nXSize, nConnectedness,
+                                        panPrevLineId, nIdOffset, nFragments,
+                                        anPolySizes);
+                });
+        }
+        poJobQueue->WaitCompletion();
+
+        // Combine the results of the strips in order.
+        const auto Merge = [&anBigNeighbour, &anPolySizes](GInt32 nPolyId,
+                                                           GInt32 nOtherId)
+        {
+            if (nOtherId >= 0 &&
+                (anBigNeighbour[nPolyId] == -1 ||
+                 anPolySizes[anBigNeighbour[nPolyId]] < anPolySizes[nOtherId]))
+                anBigNeighbour[nPolyId] = nOtherId;
+        };
+        for (int i = 0; i < nBatchSize; i++)
+        {
+            auto &oStrip = aoBatch[i];
+            aoErrorAccumulators[i].ReplayErrors();
+            if (!oStrip.bOK)
+            {
+                eErr = CE_Failure;
+                continue;
+            }
+            const GInt32 nIdOffset = anStripIdOffset[iStrip + i];
+            for (const auto &oIter : oStrip.oMapBigNeighbour)
+                Merge(oIter.first, oIter.second);
+            for (size_t j = 0; j < oStrip.anBigNeighbour.size(); j++)
+                Merge(nIdOffset + static_cast<GInt32>(j),
+                      oStrip.anBigNeighbour[j]);
+            oStrip.anBigNeighbour.clear();
+            oStrip.oMapBigNeighbour.clear();
+        }
+
+        const auto &oLastStrip = aoBatch[nBatchSize - 1];
+        std::copy_n(oLastStrip.anId.data() +
+                        static_cast<size_t>(oLastStrip.nYSize - 1) * nXSize,
+                    nXSize, anPrevLineId.begin());
+        iStrip += nBatchSize;
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.25 + 0.25 * iStrip / nStrips, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    if (eErr != CE_None)
+        return eErr;
+
+    ResolveBigNeighbours(anParent.data(), anPolyValue.data(), anPolySizes,
+                         anBigNeighbour, nSizeThreshold);
+
+    /* ==================================================================== */
+    /*      Make a third pass over the image, actually applying the         */
+    /*      merges.                                                         */
+    /* ==================================================================== */
+    const auto ApplyJob =
+        [nXSize, nConnectedness, panFinalId, &anStripIdOffset, &anBigNeighbour,
+         &anPolyValue](GSStrip &oStrip, int iStrip)
+    {
+        GSLabelStrip(oStrip, nXSize, nConnectedness, panFinalId,
+                     anStripIdOffset[iStrip]);
+        if (!oStrip.bOK)
+            return;
+        for (size_t i = 0; i < oStrip.anId.size(); i++)
+        {
+            const GInt32 iThisPoly = oStrip.anId[i];
+            if (iThisPoly >= 0 && anBigNeighbour[iThisPoly] != -1)
+                oStrip.anWriteVal[i] = anPolyValue[anBigNeighbour[iThisPoly]];
+        }
+    };
+
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips;)
+    {
+        int nBatchSize = 0;
+        eErr = ProcessBatch(iStrip, nBatchSize, true, ApplyJob);
+        for (int i = 0; eErr == CE_None && i < nBatchSize; i++)
+        {
+            auto &oStrip = aoBatch[i];
+            eErr = GDALRasterIO(hDstBand, GF_Write, 0, oStrip.nYOff, nXSize,
+                                oStrip.nYSize, oStrip.anWriteVal.data(), nXSize,
+                                oStrip.nYSize, GDT_Int64, 0, 0);
+        }
+        iStrip += nBatchSize;
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.5 + 0.5 * iStrip / nStrips, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -166,8 +903,14 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form. The
+ * following option is supported:
+ * <ul>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.12) Number of worker threads used to
+ * process horizontal strips of the raster. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1. The result does not depend on
+ * the number of threads.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -178,8 +921,7 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
 CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
-                                   int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   int nConnectedness, char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -189,6 +931,18 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    const int nThreads = GDALGetNumThreads(papszOptions, "NUM_THREADS",
+                                         "GDAL_NUM_THREADS", 1);
+    auto poThreadPool = nThreads > 1 && GDALGetRasterBandYSize(hSrcBand) > 1
+                            ? GDALGetGlobalThreadPool(nThreads)
+                            : nullptr;
+    if (poThreadPool)
+    {
+        return GDALSieveFilterMultiThreaded(
+            hSrcBand, hMaskBand, hDstBand, nSizeThreshold, nConnectedness,
+            poThreadPool, nThreads, pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
@@ -468,81 +1222,8 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     /*      threshold, then try tracking to that polygons biggest           */
     /*      neighbour, and so forth.                                        */
     /* -------------------------------------------------------------------- */
-    int nFailedMerges = 0;
-    int nIsolatedSmall = 0;
-    int nSieveTargets = 0;
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-            continue;
-
-        // Ignore nodata polygons.
-        if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
-    }
-
-    CPLDebug("GDALSieveFilter",
-             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
-             nIsolatedSmall, nFailedMerges);
+    ResolveBigNeighbours(oFirstEnum.panPolyIdMap, oFirstEnum.panPolyValue,
+                         anPolySizes, anBigNeighbour, nSizeThreshold);
 
     /* ==================================================================== */
     /*      Make a third pass over the image, actually applying the         */
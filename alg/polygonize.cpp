@@ -31,9 +31,12 @@
 #include "ogr_core.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "polygonize_polygonizer.h"
 
@@ -65,6 +68,505 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                              GPStrip                                 */
+/*                                                                      */
+/*      A horizontal strip of the raster, labeled independently of      */
+/*      its neighbours by a worker thread.                              */
+/************************************************************************/
+
+namespace
+{
+template <class DataType> struct GPStrip
+{
+    int nYOff = 0;
+    int nYSize = 0;
+    std::vector<DataType> anVal{};
+    std::vector<GInt32> anId{};
+    // Local polygon id map of the strip, after CompleteMerges()
+    std::vector<GInt32> anPolyIdMap{};
+    bool bOK = true;
+};
+}  // namespace
+
+/************************************************************************/
+/*                            GPReadStrip()                             */
+/************************************************************************/
+
+template <class DataType>
+static CPLErr GPReadStrip(GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                          GDALDataType eDT, int nXSize, int nYOff, int nYSize,
+                          GByte *pabyMaskLine, GPStrip<DataType> &oStrip)
+{
+    oStrip.nYOff = nYOff;
+    oStrip.nYSize = nYSize;
+    oStrip.bOK = true;
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+    try
+    {
+        oStrip.anVal.resize(nPixels);
+        oStrip.anId.resize(nPixels);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory allocating polygonize strip");
+        return CE_Failure;
+    }
+
+    CPLErr eErr =
+        GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nYSize,
+                     oStrip.anVal.data(), nXSize, nYSize, eDT, 0, 0);
+    for (int iY = 0; eErr == CE_None && hMaskBand != nullptr && iY < nYSize;
+         iY++)
+    {
+        eErr = GPMaskImageData(hMaskBand, pabyMaskLine, nYOff + iY, nXSize,
+                               oStrip.anVal.data() +
+                                   static_cast<size_t>(iY) * nXSize);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                            GPLabelStrip()                            */
+/*                                                                      */
+/*      Assign local polygon ids to the pixels of a strip. When         */
+/*      panFinalId is provided, local ids are translated to the final   */
+/*      global ids computed by the stitching phase, starting at         */
+/*      nIdOffset.                                                      */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static void GPLabelStrip(GPStrip<DataType> &oStrip, int nXSize,
+                         int nConnectedness, const GInt32 *panFinalId,
+                         GInt32 nIdOffset)
+{
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(nConnectedness);
+    for (int iY = 0; iY < oStrip.nYSize; iY++)
+    {
+        const size_t nOffset = static_cast<size_t>(iY) * nXSize;
+        if (!oEnum.ProcessLine(
+                iY == 0 ? nullptr : oStrip.anVal.data() + nOffset - nXSize,
+                oStrip.anVal.data() + nOffset,
+                iY == 0 ? nullptr : oStrip.anId.data() + nOffset - nXSize,
+                oStrip.anId.data() + nOffset, nXSize))
+        {
+            oStrip.bOK = false;
+            return;
+        }
+    }
+    oEnum.CompleteMerges();
+
+    if (panFinalId)
+    {
+        for (auto &nId : oStrip.anId)
+        {
+            if (nId >= 0)
+                nId = panFinalId[nIdOffset + nId];
+        }
+    }
+    else
+    {
+        try
+        {
+            oStrip.anPolyIdMap.assign(oEnum.panPolyIdMap,
+                                      oEnum.panPolyIdMap +
+                                          oEnum.nNextPolygonId);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            oStrip.bOK = false;
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GDALPolygonizeMultiThreadedT()                    */
+/*                                                                      */
+/*      The raster is split in horizontal strips that are labeled       */
+/*      concurrently. The polygon fragments of each strip are then      */
+/*      merged into a global union-find forest, first with the          */
+/*      merges done inside the strip, and then with the fragments of    */
+/*      the previous strip touching them across the seam. The root of   */
+/*      each tree is the smallest fragment id, so that the final id of  */
+/*      a polygon, and thus the order in which polygons are emitted,    */
+/*      does not depend on the number of strips. The edge tracing of    */
+/*      the second pass is then done sequentially, while the next       */
+/*      strip is being relabeled by a worker thread.                    */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeMultiThreadedT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+    int iPixValField, int nConnectedness, double *padfGeoTransform,
+    CPLWorkerThreadPool *poThreadPool, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg, GDALDataType eDT)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Limit the size of a strip, so that memory use remains bounded
+    // to a few strips per thread.
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    const size_t nBytesPerLine =
+        static_cast<size_t>(nXSize) * (sizeof(DataType) + sizeof(GInt32));
+    int nStripYSize = static_cast<int>(std::min<size_t>(
+        nYSize, std::max<size_t>(1, MAX_STRIP_BYTES / nBytesPerLine)));
+    nStripYSize = std::min(nStripYSize, (nYSize + nThreads - 1) / nThreads);
+    const int nStrips = (nYSize + nStripYSize - 1) / nStripYSize;
+
+    std::vector<GByte> abyMaskLine;
+    std::vector<GInt32> anPrevLineId;
+    std::vector<DataType> anPrevLineVal;
+    try
+    {
+        abyMaskLine.resize(nXSize);
+        anPrevLineId.resize(nXSize);
+        anPrevLineVal.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return CE_Failure;
+    }
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    CPLErr eErr = CE_None;
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: label batches of strips in parallel, while the     */
+    /*      next batch is being read, and stitch them in order.             */
+    /* -------------------------------------------------------------------- */
+    std::vector<GPStrip<DataType>> aoCurBatch(nThreads);
+    std::vector<GPStrip<DataType>> aoNextBatch(nThreads);
+    std::vector<GInt32> anParent;
+    std::vector<GInt32> anStripIdOffset;
+    std::vector<GInt32> anLocalRoot;
+
+    const auto Find = [&anParent](GInt32 nId)
+    {
+        while (anParent[nId] != nId)
+        {
+            anParent[nId] = anParent[anParent[nId]];
+            nId = anParent[nId];
+        }
+        return nId;
+    };
+
+    const auto Union = [&anParent, &Find](GInt32 nId1, GInt32 nId2)
+    {
+        nId1 = Find(nId1);
+        nId2 = Find(nId2);
+        if (nId1 < nId2)
+            anParent[nId2] = nId1;
+        else if (nId2 < nId1)
+            anParent[nId1] = nId2;
+    };
+
+    const auto ReadBatch =
+        [hSrcBand, hMaskBand, eDT, nXSize, nYSize, nStripYSize, nStrips,
+         &abyMaskLine](int iFirstStrip, std::vector<GPStrip<DataType>> &aoBatch,
+                       int &nBatchSize)
+    {
+        nBatchSize = std::min(static_cast<int>(aoBatch.size()),
+                              nStrips - iFirstStrip);
+        for (int i = 0; i < nBatchSize; i++)
+        {
+            const int nYOff = (iFirstStrip + i) * nStripYSize;
+            if (GPReadStrip(hSrcBand, hMaskBand, eDT, nXSize, nYOff,
+                            std::min(nStripYSize, nYSize - nYOff),
+                            abyMaskLine.data(), aoBatch[i]) != CE_None)
+                return CE_Failure;
+        }
+        return CE_None;
+    };
+
+    const auto Stitch = [&](GPStrip<DataType> &oStrip)
+    {
+        const size_t nFragments = oStrip.anPolyIdMap.size();
+        // THE_OUTER_POLYGON_ID is INT_MAX
+        if (nFragments >= static_cast<size_t>(
+                              std::numeric_limits<GInt32>::max() - 1) -
+                              anParent.size())
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "GDALPolygonize(): too many polygon fragments");
+            return false;
+        }
+        const GInt32 nIdOffset = static_cast<GInt32>(anParent.size());
+        try
+        {
+            anStripIdOffset.push_back(nIdOffset);
+            anLocalRoot.assign(nFragments, -1);
+            anParent.reserve(anParent.size() + nFragments);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            return false;
+        }
+
+        // Merges inside the strip, rooted at the smallest local id.
+        for (size_t i = 0; i < nFragments; i++)
+        {
+            const GInt32 nRoot = oStrip.anPolyIdMap[i];
+            if (anLocalRoot[nRoot] < 0)
+                anLocalRoot[nRoot] = static_cast<GInt32>(i);
+            anParent.push_back(nIdOffset + anLocalRoot[nRoot]);
+        }
+        oStrip.anPolyIdMap.clear();
+
+        // Merges across the seam with the previous strip, following
+        // the same neighbourhood rules as ProcessLine().
+        EqualityTest eq;
+        const GInt32 *panThisLineId = oStrip.anId.data();
+        const DataType *panThisLineVal = oStrip.anVal.data();
+        for (int iX = 0; oStrip.nYOff > 0 && iX < nXSize; iX++)
+        {
+            if (panThisLineId[iX] < 0)
+                continue;
+            const GInt32 nId = nIdOffset + panThisLineId[iX];
+            for (int iXPrev = iX - (nConnectedness == 8 ? 1 : 0);
+                 iXPrev <= iX + (nConnectedness == 8 ? 1 : 0); iXPrev++)
+            {
+                if (iXPrev >= 0 && iXPrev < nXSize &&
+                    anPrevLineId[iXPrev] >= 0 &&
+                    eq(anPrevLineVal[iXPrev], panThisLineVal[iX]))
+                {
+                    Union(anPrevLineId[iXPrev], nId);
+                }
+            }
+        }
+
+        const size_t nLastLineOffset =
+            static_cast<size_t>(oStrip.nYSize - 1) * nXSize;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const GInt32 nLocalId = oStrip.anId[nLastLineOffset + iX];
+            anPrevLineId[iX] = nLocalId < 0 ? -1 : nIdOffset + nLocalId;
+            anPrevLineVal[iX] = oStrip.anVal[nLastLineOffset + iX];
+        }
+        return true;
+    };
+
+    int nCurBatchSize = 0;
+    eErr = ReadBatch(0, aoCurBatch, nCurBatchSize);
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips;)
+    {
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nCurBatchSize);
+        for (int i = 0; i < nCurBatchSize; i++)
+        {
+            auto &oStrip = aoCurBatch[i];
+            auto &oErrorAccumulator = aoErrorAccumulators[i];
+            poJobQueue->SubmitJob(
+                [&oStrip, &oErrorAccumulator, nXSize, nConnectedness]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    GPLabelStrip<DataType, EqualityTest>(
+                        oStrip, nXSize, nConnectedness, nullptr, 0);
+                });
+        }
+
+        int nNextBatchSize = 0;
+        if (iStrip + nCurBatchSize < nStrips)
+            eErr =
+                ReadBatch(iStrip + nCurBatchSize, aoNextBatch, nNextBatchSize);
+
+        poJobQueue->WaitCompletion();
+
+        for (int i = 0; i < nCurBatchSize; i++)
+        {
+            auto &oStrip = aoCurBatch[i];
+            aoErrorAccumulators[i].ReplayErrors();
+            if (eErr == CE_None && !(oStrip.bOK && Stitch(oStrip)))
+                eErr = CE_Failure;
+        }
+
+        iStrip += nCurBatchSize;
+        std::swap(aoCurBatch, aoNextBatch);
+        nCurBatchSize = nNextBatchSize;
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.10 * iStrip / nStrips, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+    aoCurBatch.clear();
+    aoNextBatch.clear();
+    anLocalRoot.clear();
+
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Flatten the forest. Parents always have a smaller id than      */
+    /*      their children, so a single ascending pass is enough.           */
+    /* -------------------------------------------------------------------- */
+    int nFinalPolyCount = 0;
+    for (size_t i = 0; i < anParent.size(); i++)
+    {
+        anParent[i] = anParent[anParent[i]];
+        if (anParent[i] == static_cast<GInt32>(i))
+            nFinalPolyCount++;
+    }
+    CPLDebug("GDALPolygonize",
+             "Counted %d polygon fragments in %d strips forming %d final "
+             "polygons.",
+             static_cast<int>(anParent.size()), nStrips, nFinalPolyCount);
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: trace the polygon edges of a strip, while the      */
+    /*      next one is relabeled with the final ids.                       */
+    /* -------------------------------------------------------------------- */
+    OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
+                                              padfGeoTransform};
+    using PolygonizerType = Polygonizer<GInt32, DataType>;
+    PolygonizerType oPolygonizer{-1, &oPolygonWriter};
+    std::vector<TwoArm> aoLastLineArm;
+    std::vector<TwoArm> aoThisLineArm;
+    try
+    {
+        aoLastLineArm.resize(nXSize + 2);
+        aoThisLineArm.resize(nXSize + 2);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return CE_Failure;
+    }
+    for (auto &oArm : aoLastLineArm)
+        oArm.poPolyInside = oPolygonizer.getTheOuterPolygon();
+    std::fill(anPrevLineVal.begin(), anPrevLineVal.end(), DataType(0));
+
+    GPStrip<DataType> aoStrips[2];
+    GPStrip<DataType> *poCurStrip = &aoStrips[0];
+    GPStrip<DataType> *poNextStrip = &aoStrips[1];
+    const GInt32 *panFinalId = anParent.data();
+
+    const auto SubmitLabelJob =
+        [&](GPStrip<DataType> &oStrip, CPLErrorAccumulator &oErrorAccumulator,
+            int iStrip)
+    {
+        const GInt32 nIdOffset = anStripIdOffset[iStrip];
+        poJobQueue->SubmitJob(
+            [&oStrip, &oErrorAccumulator, nXSize, nConnectedness, panFinalId,
+             nIdOffset]()
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+                GPLabelStrip<DataType, EqualityTest>(
+                    oStrip, nXSize, nConnectedness, panFinalId, nIdOffset);
+            });
+    };
+
+    eErr = GPReadStrip(hSrcBand, hMaskBand, eDT, nXSize, 0,
+                       std::min(nStripYSize, nYSize), abyMaskLine.data(),
+                       *poCurStrip);
+    if (eErr == CE_None)
+    {
+        CPLErrorAccumulator oErrorAccumulator;
+        SubmitLabelJob(*poCurStrip, oErrorAccumulator, 0);
+        poJobQueue->WaitCompletion();
+        oErrorAccumulator.ReplayErrors();
+        if (!poCurStrip->bOK)
+            eErr = CE_Failure;
+    }
+
+    for (int iStrip = 0; eErr == CE_None && iStrip < nStrips; iStrip++)
+    {
+        CPLErrorAccumulator oErrorAccumulator;
+        if (iStrip + 1 < nStrips)
+        {
+            const int nYOff = (iStrip + 1) * nStripYSize;
+            eErr = GPReadStrip(hSrcBand, hMaskBand, eDT, nXSize, nYOff,
+                               std::min(nStripYSize, nYSize - nYOff),
+                               abyMaskLine.data(), *poNextStrip);
+            if (eErr != CE_None)
+                break;
+            SubmitLabelJob(*poNextStrip, oErrorAccumulator, iStrip + 1);
+        }
+
+        for (int iY = 0; eErr == CE_None && iY < poCurStrip->nYSize; iY++)
+        {
+            const size_t nOffset = static_cast<size_t>(iY) * nXSize;
+            if (!oPolygonizer.processLine(
+                    poCurStrip->anId.data() + nOffset, anPrevLineVal.data(),
+                    aoThisLineArm.data(), aoLastLineArm.data(),
+                    poCurStrip->nYOff + iY, nXSize))
+            {
+                eErr = CE_Failure;
+            }
+            else
+            {
+                eErr = oPolygonWriter.getErr();
+            }
+
+            std::copy_n(poCurStrip->anVal.data() + nOffset, nXSize,
+                        anPrevLineVal.data());
+            std::swap(aoThisLineArm, aoLastLineArm);
+
+            if (eErr == CE_None &&
+                !pfnProgress(0.10 + 0.90 * (poCurStrip->nYOff + iY + 1) /
+                                        static_cast<double>(nYSize),
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+            }
+        }
+
+        poJobQueue->WaitCompletion();
+        if (iStrip + 1 < nStrips)
+        {
+            oErrorAccumulator.ReplayErrors();
+            if (eErr == CE_None && !poNextStrip->bOK)
+                eErr = CE_Failure;
+            std::swap(poCurStrip, poNextStrip);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Close the polygons touching the last line.                      */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None)
+    {
+        std::vector<GInt32> anOuterLineId;
+        try
+        {
+            anOuterLineId.resize(nXSize, PolygonizerType::THE_OUTER_POLYGON_ID);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            return CE_Failure;
+        }
+        if (!oPolygonizer.processLine(
+                anOuterLineId.data(), anPrevLineVal.data(),
+                aoThisLineArm.data(), aoLastLineArm.data(), nYSize, nXSize))
+        {
+            eErr = CE_Failure;
+        }
+        else
+        {
+            eErr = oPolygonWriter.getErr();
+        }
+        if (eErr == CE_None)
+            pfnProgress(1.0, "", pProgressArg);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -97,9 +599,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
-    /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
     if (nXSize > std::numeric_limits<int>::max() - 2)
@@ -108,29 +607,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    DataType *panLastLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    DataType *panThisLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -166,6 +642,48 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the strip based multi-threaded implementation if asked.     */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads(papszOptions, "NUM_THREADS",
+                                         "GDAL_NUM_THREADS", 1);
+    auto poThreadPool = nThreads > 1 && nYSize > 1
+                            ? GDALGetGlobalThreadPool(nThreads)
+                            : nullptr;
+    if (poThreadPool)
+    {
+        return GDALPolygonizeMultiThreadedT<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            adfGeoTransform, poThreadPool, nThreads, pfnProgress, pProgressArg,
+            eDT);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    DataType *panThisLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+
+    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        pabyMaskLine == nullptr)
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -489,6 +1007,12 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS: (GDAL >= 3.12) Number of
+ * threads to use. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option, or 1. When more than one thread is used, the raster is split in
+ * horizontal strips that are labeled concurrently and then stitched together.
+ * The resulting polygons are the same as with a single thread, but they may
+ * be emitted in a different order.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -563,6 +1087,12 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS: (GDAL >= 3.12) Number of
+ * threads to use. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option, or 1. When more than one thread is used, the raster is split in
+ * horizontal strips that are labeled concurrently and then stitched together.
+ * The resulting polygons are the same as with a single thread, but they may
+ * be emitted in a different order.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -21,14 +21,17 @@
 #include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -316,6 +319,213 @@ static CPLErr GDALMultiFilter(GDALRasterBandH hTargetBand,
     return eErr;
 }
 
+/************************************************************************/
+/*                    GDALMultiFilterMultiThreaded()                    */
+/*                                                                      */
+/*      Same as GDALMultiFilter(), but processing horizontal strips     */
+/*      of the band in worker threads. Each strip is loaded with        */
+/*      nIterations lines of context above and below it, which is       */
+/*      what the iterations need to compute the lines of the strip      */
+/*      exactly as a single pass over the whole band would.             */
+/************************************************************************/
+
+static CPLErr GDALMultiFilterMultiThreaded(
+    GDALRasterBandH hTargetBand, GDALRasterBandH hTargetMaskBand,
+    GDALRasterBandH hFiltMaskBand, int nIterations,
+    CPLWorkerThreadPool *poThreadPool, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    if (!pfnProgress(0.0, "Smoothing Filter...", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Figure out the strip height, so that memory use remains         */
+    /*      bounded to a few strips per thread.                             */
+    /* -------------------------------------------------------------------- */
+    const int nHalo = std::min(nIterations, nYSize);
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    const size_t nBytesPerLine =
+        static_cast<size_t>(nXSize) * (3 * sizeof(float) + 2);
+    int nStripYSize = static_cast<int>(
+        std::min<size_t>(static_cast<size_t>(nYSize),
+                         std::max<size_t>(1, MAX_STRIP_BYTES / nBytesPerLine)));
+    nStripYSize = std::min(nStripYSize, (nYSize + nThreads - 1) / nThreads);
+    const int nBatchYSize = nStripYSize * nThreads;
+
+    // Values and masks of the lines of a batch, with their context.
+    std::vector<float> afVal;
+    std::vector<GByte> abyTMask;
+    std::vector<GByte> abyFMask;
+    // Two work buffers per strip, for the previous and current iterations.
+    std::vector<std::vector<float>> aafPass(2 * nThreads);
+    try
+    {
+        const size_t nBatchBufSize =
+            static_cast<size_t>(nBatchYSize + 2 * nHalo) * nXSize;
+        afVal.resize(nBatchBufSize);
+        abyTMask.resize(nBatchBufSize);
+        abyFMask.resize(nBatchBufSize);
+        for (auto &afPass : aafPass)
+            afPass.resize(static_cast<size_t>(nStripYSize + 2 * nHalo) *
+                          nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALFillNodata()");
+        return CE_Failure;
+    }
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    std::vector<float *> apafResult(nThreads);
+
+    CPLErr eErr = CE_None;
+
+    for (int nBatchYOff = 0; eErr == CE_None && nBatchYOff < nYSize;
+         nBatchYOff += nBatchYSize)
+    {
+        const int nBatchYEnd = std::min(nYSize, nBatchYOff + nBatchYSize);
+
+        /* ---------------------------------------------------------------- */
+        /*      The context lines above the batch have already been         */
+        /*      written out, so keep their original values from the         */
+        /*      previous batch, and read the other lines.                   */
+        /* ---------------------------------------------------------------- */
+        const int nBufYOff = nBatchYOff - std::min(nHalo, nBatchYOff);
+        if (nBufYOff < nBatchYOff)
+        {
+            const int nPrevBatchYOff = nBatchYOff - nBatchYSize;
+            const int nPrevBufYOff =
+                nPrevBatchYOff - std::min(nHalo, nPrevBatchYOff);
+            const size_t nSrcOffset =
+                static_cast<size_t>(nBufYOff - nPrevBufYOff) * nXSize;
+            const size_t nCount =
+                static_cast<size_t>(nBatchYOff - nBufYOff) * nXSize;
+            memmove(afVal.data(), afVal.data() + nSrcOffset,
+                    nCount * sizeof(float));
+            memmove(abyTMask.data(), abyTMask.data() + nSrcOffset, nCount);
+            memmove(abyFMask.data(), abyFMask.data() + nSrcOffset, nCount);
+        }
+
+        const int nBufYEnd = std::min(nYSize, nBatchYEnd + nHalo);
+        const size_t nReadOffset =
+            static_cast<size_t>(nBatchYOff - nBufYOff) * nXSize;
+        const int nReadYSize = nBufYEnd - nBatchYOff;
+        eErr = GDALRasterIO(hTargetMaskBand, GF_Read, 0, nBatchYOff, nXSize,
+                            nReadYSize, abyTMask.data() + nReadOffset, nXSize,
+                            nReadYSize, GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hFiltMaskBand, GF_Read, 0, nBatchYOff, nXSize,
+                                nReadYSize, abyFMask.data() + nReadOffset,
+                                nXSize, nReadYSize, GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hTargetBand, GF_Read, 0, nBatchYOff, nXSize,
+                                nReadYSize, afVal.data() + nReadOffset, nXSize,
+                                nReadYSize, GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        /* ---------------------------------------------------------------- */
+        /*      Filter the strips of the batch.                             */
+        /* ---------------------------------------------------------------- */
+        const int nStrips =
+            (nBatchYEnd - nBatchYOff + nStripYSize - 1) / nStripYSize;
+        for (int iStrip = 0; iStrip < nStrips; iStrip++)
+        {
+            poJobQueue->SubmitJob(
+                [&, iStrip]()
+                {
+                    const int nStripYOff = nBatchYOff + iStrip * nStripYSize;
+                    const int nStripYEnd =
+                        std::min(nBatchYEnd, nStripYOff + nStripYSize);
+                    const int nCtxYOff = std::max(0, nStripYOff - nHalo);
+                    const int nCtxYEnd = std::min(nYSize, nStripYEnd + nHalo);
+
+                    const size_t nCtxOffset =
+                        static_cast<size_t>(nCtxYOff - nBufYOff) * nXSize;
+                    const GByte *pabyTMask = abyTMask.data() + nCtxOffset;
+                    const GByte *pabyFMask = abyFMask.data() + nCtxOffset;
+                    float *pafLastPass = aafPass[2 * iStrip].data();
+                    float *pafThisPass = aafPass[2 * iStrip + 1].data();
+                    memcpy(pafLastPass, afVal.data() + nCtxOffset,
+                           sizeof(float) * nXSize * (nCtxYEnd - nCtxYOff));
+
+                    for (int iIter = 1; iIter <= nIterations; iIter++)
+                    {
+                        // Only the lines still needed by the following
+                        // iterations are computed.
+                        const int nMargin = nIterations - iIter;
+                        const int iFirstLine =
+                            std::max(nCtxYOff, nStripYOff - nMargin);
+                        const int iLastLine =
+                            std::min(nCtxYEnd, nStripYEnd + nMargin);
+                        for (int iFLine = iFirstLine; iFLine < iLastLine;
+                             iFLine++)
+                        {
+                            const size_t nOffset =
+                                static_cast<size_t>(iFLine - nCtxYOff) *
+                                nXSize;
+
+                            // Skip the first and last line.
+                            if (iFLine < 1 || iFLine >= nYSize - 1)
+                            {
+                                memcpy(pafThisPass + nOffset,
+                                       pafLastPass + nOffset,
+                                       sizeof(float) * nXSize);
+                                continue;
+                            }
+
+                            GDALFilterLine(pafLastPass + nOffset - nXSize,
+                                           pafLastPass + nOffset,
+                                           pafLastPass + nOffset + nXSize,
+                                           pafThisPass + nOffset,
+                                           pabyTMask + nOffset - nXSize,
+                                           pabyTMask + nOffset,
+                                           pabyTMask + nOffset + nXSize,
+                                           pabyFMask + nOffset, nXSize);
+                        }
+                        std::swap(pafLastPass, pafThisPass);
+                    }
+
+                    apafResult[iStrip] =
+                        pafLastPass +
+                        static_cast<size_t>(nStripYOff - nCtxYOff) * nXSize;
+                });
+        }
+        poJobQueue->WaitCompletion();
+
+        /* ---------------------------------------------------------------- */
+        /*      Write out the filtered strips.                              */
+        /* ---------------------------------------------------------------- */
+        for (int iStrip = 0; eErr == CE_None && iStrip < nStrips; iStrip++)
+        {
+            const int nStripYOff = nBatchYOff + iStrip * nStripYSize;
+            const int nLines =
+                std::min(nBatchYEnd, nStripYOff + nStripYSize) - nStripYOff;
+            eErr = GDALRasterIO(hTargetBand, GF_Write, 0, nStripYOff, nXSize,
+                                nLines, apafResult[iStrip],
+                                nXSize, nLines, GDT_Float32, 0, 0);
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(nBatchYEnd / static_cast<double>(nYSize),
+                         "Smoothing Filter...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                             QUAD_CHECK()                             */
 /*                                                                      */
@@ -344,6 +554,159 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                        GDALFillNodataLine()                          */
+/*                                                                      */
+/*      Interpolate the nodata pixels of one scanline from the          */
+/*      closest known values found in each quadrant, given the          */
+/*      top down column information for this line, and the bottom       */
+/*      up column information for the line below.                       */
+/************************************************************************/
+
+static void GDALFillNodataLine(int iY, int nXSize, double dfMaxSearchDist,
+                               int nMaxSearchDist, GUInt32 nNoDataVal,
+                               bool bNearest, bool bHasNoData, float fNoData,
+                               const GUInt32 *panTopDownY,
+                               const float *pafTopDownValue,
+                               const GUInt32 *panLastY,
+                               const float *pafLastValue, GByte *pabyMask,
+                               float *pafScanline, GByte *pabyFiltMask)
+{
+    memset(pabyFiltMask, 0, nXSize);
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        enum Quadrants
+        {
+            QUAD_TOP_LEFT = 0,
+            QUAD_BOTTOM_LEFT = 1,
+            QUAD_TOP_RIGHT = 2,
+            QUAD_BOTTOM_RIGHT = 3,
+        };
+
+        constexpr int QUAD_COUNT = 4;
+        double adfQuadDist[QUAD_COUNT] = {};
+        float afQuadValue[QUAD_COUNT] = {};
+
+        for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            afQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
+                       afQuadValue[QUAD_TOP_LEFT], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
+                       afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
+                       afQuadValue[QUAD_TOP_RIGHT], iRightX,
+                       panTopDownY[iRightX], iX, iY,
+                       pafTopDownValue[iRightX], nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
+                       afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        bool bHasSrcValues = false;
+        if (bNearest)
+        {
+            double dfNearestDist = dfMaxSearchDist + 1;
+            float fNearestValue = 0.0f;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] < dfNearestDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        fNearestValue = afQuadValue[iQuad];
+                        dfNearestDist = adfQuadDist[iQuad];
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfNearestDist <= dfMaxSearchDist)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] = fNearestValue;
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+        else
+        {
+            double dfWeightSum = 0.0;
+            double dfValueSum = 0.0;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                        dfWeightSum += dfWeight;
+                        dfValueSum += afQuadValue[iQuad] * dfWeight;
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfWeightSum > 0.0)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] =
+                        static_cast<float>(dfValueSum / dfWeightSum);
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -384,6 +747,10 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>INTERPOLATION=INV_DIST/NEAREST (GDAL >= 3.9). By default, pixels are
  * interpolated using an inverse distance weighting (INV_DIST). It is also
  * possible to choose a nearest neighbour (NEAREST) strategy.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS (GDAL >= 3.12). Number of worker threads used
+ * to interpolate lines and to apply the smoothing filter. Defaults to the
+ * value of the GDAL_NUM_THREADS configuration option, or 1. The result does
+ * not depend on the number of threads.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -586,6 +953,28 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     GDALRasterBandH hFiltMaskBand =
         GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
 
+    /* -------------------------------------------------------------------- */
+    /*      When using several threads, the second pass processes batches   */
+    /*      of lines, so that they can be interpolated concurrently.        */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = GDALGetNumThreads(papszOptions, "NUM_THREADS",
+                                         "GDAL_NUM_THREADS", 1);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nYSize > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                   : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    int nBatchLines = 1;
+    if (poThreadPool)
+    {
+        constexpr size_t MAX_BATCH_BYTES = 16 * 1024 * 1024;
+        const size_t nBytesPerLine =
+            static_cast<size_t>(nXSize) *
+            (3 * sizeof(GUInt32) + 3 * sizeof(float) + 2);
+        nBatchLines = static_cast<int>(std::min<size_t>(
+            static_cast<size_t>(nYSize),
+            std::max<size_t>(nThreads, MAX_BATCH_BYTES / nBytesPerLine)));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffers for last scanline and this scanline.           */
     /* -------------------------------------------------------------------- */
@@ -594,24 +983,31 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     GUInt32 *panThisY =
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panTopDownY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
+    GUInt32 *panTopDownY = static_cast<GUInt32 *>(
+        VSI_CALLOC_VERBOSE(nXSize, nBatchLines * sizeof(GUInt32)));
+    GUInt32 *panBelowY = static_cast<GUInt32 *>(
+        VSI_CALLOC_VERBOSE(nXSize, nBatchLines * sizeof(GUInt32)));
     float *pafLastValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafThisValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafTopDownValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafScanline =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    GByte *pabyMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
-    GByte *pabyFiltMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
+    float *pafTopDownValue = static_cast<float *>(
+        VSI_CALLOC_VERBOSE(nXSize, nBatchLines * sizeof(float)));
+    float *pafBelowValue = static_cast<float *>(
+        VSI_CALLOC_VERBOSE(nXSize, nBatchLines * sizeof(float)));
+    float *pafScanline = static_cast<float *>(
+        VSI_CALLOC_VERBOSE(nXSize, nBatchLines * sizeof(float)));
+    GByte *pabyMask =
+        static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, nBatchLines));
+    GByte *pabyFiltMask =
+        static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, nBatchLines));
 
     CPLErr eErr = CE_None;
 
     if (panLastY == nullptr || panThisY == nullptr || panTopDownY == nullptr ||
-        pafLastValue == nullptr || pafThisValue == nullptr ||
-        pafTopDownValue == nullptr || pafScanline == nullptr ||
+        panBelowY == nullptr || pafLastValue == nullptr ||
+        pafThisValue == nullptr || pafTopDownValue == nullptr ||
+        pafBelowValue == nullptr || pafScanline == nullptr ||
         pabyMask == nullptr || pabyFiltMask == nullptr)
     {
         eErr = CE_Failure;
@@ -717,44 +1113,65 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /* ==================================================================== */
     /*      Now we will do collect similar this/last information from       */
     /*      bottom to top and use it in combination with the top to         */
-    /*      bottom search info to interpolate.                              */
+    /*      bottom search info to interpolate. This is done by batches      */
+    /*      of lines: the column information is collected sequentially,     */
+    /*      after which the lines of the batch are independent.             */
     /* ==================================================================== */
-    for (int iY = nYSize - 1; iY >= 0 && eErr == CE_None; iY--)
+    for (int iYEnd = nYSize; iYEnd > 0 && eErr == CE_None;
+         iYEnd -= nBatchLines)
     {
-        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1, pabyMask,
-                            nXSize, 1, GDT_Byte, 0, 0);
+        const int nLines = std::min(nBatchLines, iYEnd);
+        const int iYOff = iYEnd - nLines;
+
+        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iYOff, nXSize, nLines,
+                            pabyMask, nXSize, nLines, GDT_Byte, 0, 0);
 
         if (eErr != CE_None)
             break;
 
-        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1, pafScanline,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iYOff, nXSize, nLines,
+                            pafScanline, nXSize, nLines, GDT_Float32, 0, 0);
 
         if (eErr != CE_None)
             break;
 
         /* --------------------------------------------------------------------
          */
-        /*      Figure out the most recent pixel for each column. */
+        /*      Figure out the most recent pixel for each column, keeping */
+        /*      the one of the line below for the interpolation. */
         /* --------------------------------------------------------------------
          */
-
-        for (int iX = 0; iX < nXSize; iX++)
+        for (int iLine = nLines - 1; iLine >= 0; iLine--)
         {
-            if (pabyMask[iX])
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if (panLastY[iX] - iY <= dfMaxSearchDist)
-            {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
+            const int iY = iYOff + iLine;
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            const GByte *pabyLineMask = pabyMask + nOffset;
+            const float *pafLine = pafScanline + nOffset;
+
+            memcpy(panBelowY + nOffset, panLastY, sizeof(GUInt32) * nXSize);
+            memcpy(pafBelowValue + nOffset, pafLastValue,
+                   sizeof(float) * nXSize);
+
+            for (int iX = 0; iX < nXSize; iX++)
             {
-                panThisY[iX] = nNoDataVal;
+                if (pabyLineMask[iX])
+                {
+                    pafThisValue[iX] = pafLine[iX];
+                    panThisY[iX] = iY;
+                }
+                else if (panLastY[iX] - iY <= dfMaxSearchDist)
+                {
+                    pafThisValue[iX] = pafLastValue[iX];
+                    panThisY[iX] = panLastY[iX];
+                }
+                else
+                {
+                    panThisY[iX] = nNoDataVal;
+                }
             }
+
+            std::swap(pafThisValue, pafLastValue);
+            std::swap(panThisY, panLastY);
         }
 
         /* --------------------------------------------------------------------
@@ -763,14 +1180,14 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
          */
         /* --------------------------------------------------------------------
          */
-        eErr = GDALRasterIO(hYBand, GF_Read, 0, iY, nXSize, 1, panTopDownY,
-                            nXSize, 1, GDT_UInt32, 0, 0);
+        eErr = GDALRasterIO(hYBand, GF_Read, 0, iYOff, nXSize, nLines,
+                            panTopDownY, nXSize, nLines, GDT_UInt32, 0, 0);
 
         if (eErr != CE_None)
             break;
 
-        eErr = GDALRasterIO(hValBand, GF_Read, 0, iY, nXSize, 1,
-                            pafTopDownValue, nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hValBand, GF_Read, 0, iYOff, nXSize, nLines,
+                            pafTopDownValue, nXSize, nLines, GDT_Float32, 0, 0);
 
         if (eErr != CE_None)
             break;
@@ -780,138 +1197,37 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         /*      Attempt to interpolate any pixels that are nodata. */
         /* --------------------------------------------------------------------
          */
-        memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
+        const auto InterpolateLine = [&](int iLine)
         {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            enum Quadrants
-            {
-                QUAD_TOP_LEFT = 0,
-                QUAD_BOTTOM_LEFT = 1,
-                QUAD_TOP_RIGHT = 2,
-                QUAD_BOTTOM_RIGHT = 3,
-            };
-
-            constexpr int QUAD_COUNT = 4;
-            double adfQuadDist[QUAD_COUNT] = {};
-            float afQuadValue[QUAD_COUNT] = {};
-
-            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                afQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
-                           afQuadValue[QUAD_TOP_LEFT], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
-                           afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
-                           afQuadValue[QUAD_TOP_RIGHT], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
-                           afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            bool bHasSrcValues = false;
-            if (bNearest)
-            {
-                double dfNearestDist = dfMaxSearchDist + 1;
-                float fNearestValue = 0.0f;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] < dfNearestDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            fNearestValue = afQuadValue[iQuad];
-                            dfNearestDist = adfQuadDist[iQuad];
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfNearestDist <= dfMaxSearchDist)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] = fNearestValue;
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-            else
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            GDALFillNodataLine(iYOff + iLine, nXSize, dfMaxSearchDist,
+                               nMaxSearchDist, nNoDataVal, bNearest,
+                               bHasNoData, fNoData, panTopDownY + nOffset,
+                               pafTopDownValue + nOffset, panBelowY + nOffset,
+                               pafBelowValue + nOffset, pabyMask + nOffset,
+                               pafScanline + nOffset, pabyFiltMask + nOffset);
+        };
+
+        if (poJobQueue)
+        {
+            // Interleave the lines between jobs, as the cost of a line
+            // depends on the size of the nodata areas it crosses.
+            const int nJobs = std::min(nThreads, nLines);
+            for (int iJob = 0; iJob < nJobs; iJob++)
             {
-                double dfWeightSum = 0.0;
-                double dfValueSum = 0.0;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+                poJobQueue->SubmitJob(
+                    [&InterpolateLine, iJob, nJobs, nLines]()
                     {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                            dfWeightSum += dfWeight;
-                            dfValueSum += afQuadValue[iQuad] * dfWeight;
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfWeightSum > 0.0)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] =
-                            static_cast<float>(dfValueSum / dfWeightSum);
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
+                        for (int iLine = iJob; iLine < nLines; iLine += nJobs)
+                            InterpolateLine(iLine);
+                    });
             }
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (int iLine = 0; iLine < nLines; iLine++)
+                InterpolateLine(iLine);
         }
 
         /* --------------------------------------------------------------------
@@ -919,8 +1235,8 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         /*      Write out the updated data and mask information. */
         /* --------------------------------------------------------------------
          */
-        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
-                            pafScanline, nXSize, 1, GDT_Float32, 0, 0);
+        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iYOff, nXSize, nLines,
+                            pafScanline, nXSize, nLines, GDT_Float32, 0, 0);
 
         if (eErr != CE_None)
             break;
@@ -929,36 +1245,28 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         {
             // Update (copy of) mask band when it has been provided by the
             // user
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1, pabyMask,
-                                nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iYOff, nXSize, nLines,
+                                pabyMask, nXSize, nLines, GDT_Byte, 0, 0);
 
             if (eErr != CE_None)
                 break;
         }
 
-        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
-                            pabyFiltMask, nXSize, 1, GDT_Byte, 0, 0);
+        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iYOff, nXSize, nLines,
+                            pabyFiltMask, nXSize, nLines, GDT_Byte, 0, 0);
 
         if (eErr != CE_None)
             break;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Flip this/last buffers. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
-
         /* --------------------------------------------------------------------
          */
         /*      report progress. */
         /* --------------------------------------------------------------------
          */
-        if (!pfnProgress(
-                dfProgressRatio *
-                    (0.5 + 0.5 * (nYSize - iY) / static_cast<double>(nYSize)),
-                "Filling...", pProgressArg))
+        if (!pfnProgress(dfProgressRatio *
+                             (0.5 + 0.5 * (nYSize - iYOff) /
+                                        static_cast<double>(nYSize)),
+                         "Filling...", pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
             eErr = CE_Failure;
@@ -983,9 +1291,14 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         void *pScaledProgress = GDALCreateScaledProgress(
             dfProgressRatio, 1.0, pfnProgress, pProgressArg);
 
-        eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
-                               nSmoothingIterations, GDALScaledProgress,
-                               pScaledProgress);
+        if (poThreadPool)
+            eErr = GDALMultiFilterMultiThreaded(
+                hTargetBand, hMaskBand, hFiltMaskBand, nSmoothingIterations,
+                poThreadPool, nThreads, GDALScaledProgress, pScaledProgress);
+        else
+            eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
+                                   nSmoothingIterations, GDALScaledProgress,
+                                   pScaledProgress);
 
         GDALDestroyScaledProgress(pScaledProgress);
     }
@@ -997,9 +1310,11 @@ end:
     CPLFree(panLastY);
     CPLFree(panThisY);
     CPLFree(panTopDownY);
+    CPLFree(panBelowY);
     CPLFree(pafLastValue);
     CPLFree(pafThisValue);
     CPLFree(pafTopDownValue);
+    CPLFree(pafBelowValue);
     CPLFree(pafScanline);
     CPLFree(pabyMask);
     CPLFree(pabyFiltMask);
@@ -12,6 +12,7 @@
 ###############################################################################
 
 import array
+import random
 import struct
 
 import pytest
@@ -386,3 +387,45 @@ def test_fillnodata_nearest(
         for i in range(height)
     ]
     assert got == expected
+
+
+###############################################################################
+# Test that using several threads gives the same result as a single thread
+
+
+@pytest.mark.parametrize("interpolation", ["INV_DIST", "NEAREST"])
+@pytest.mark.parametrize("smoothing_iterations", [0, 4])
+def test_fillnodata_multithreaded(interpolation, smoothing_iterations):
+
+    width = 73
+    height = 61
+    rng = random.Random(0)
+    values = [rng.randint(1, 255) for _ in range(width * height)]
+    # Dig a few nodata holes of various sizes
+    for cx, cy, r in ((10, 10, 6), (40, 30, 12), (60, 55, 4), (5, 50, 9)):
+        for y in range(height):
+            for x in range(width):
+                if (x - cx) ** 2 + (y - cy) ** 2 <= r * r:
+                    values[y * width + x] = 0
+
+    def run(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", width, height)
+        ds.GetRasterBand(1).SetNoDataValue(0)
+        ds.WriteRaster(0, 0, width, height, array.array("B", values).tobytes())
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maxSearchDist=10,
+            maskBand=None,
+            smoothingIterations=smoothing_iterations,
+            options=[
+                "INTERPOLATION=" + interpolation,
+                "NUM_THREADS=" + str(num_threads),
+                "TEMP_FILE_DRIVER=MEM",
+            ],
+        )
+        return ds.ReadRaster()
+
+    ref = run(1)
+    assert ref != array.array("B", values).tobytes()
+    assert run(3) == ref
+    assert run(8) == ref
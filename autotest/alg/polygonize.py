@@ -427,3 +427,34 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that the multi-threaded implementation, which processes the raster
+# by strips, produces the same polygons as the single-threaded one.
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+def test_polygonize_multithreaded(connectedness, is_int_polygonize):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(num_threads):
+        mem_ds = ogr.GetDriverByName("MEM").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        options = ["NUM_THREADS=%d" % num_threads]
+        if connectedness == 8:
+            options.append("8CONNECTED=8")
+        func = gdal.Polygonize if is_int_polygonize else gdal.FPolygonize
+        assert func(src_band, src_band.GetMaskBand(), mem_layer, 0, options) == 0
+        return [(f["DN"], f.GetGeometryRef().ExportToWkt()) for f in mem_layer]
+
+    ref = polygonize(1)
+    res2 = polygonize(2)
+    res5 = polygonize(5)
+    assert sorted(res2) == sorted(ref)
+    # The order of polygons does not depend on the number of strips
+    assert res5 == res2
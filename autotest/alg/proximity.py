@@ -12,6 +12,10 @@
 ###############################################################################
 
 
+import math
+import random
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -109,3 +113,41 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that distances are exact Euclidean distances, including with
+# non-square pixels and several threads
+
+
+@pytest.mark.parametrize("num_threads", [1, 3])
+@pytest.mark.parametrize("maxdist", [None, 25])
+def test_proximity_exact(num_threads, maxdist):
+
+    xsize, ysize = 41, 37
+    rng = random.Random(0)
+    targets = [(rng.randrange(xsize), rng.randrange(ysize)) for _ in range(12)]
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+    src_ds.SetGeoTransform((0, 2, 0, 0, 0, -3))
+    for x, y in targets:
+        src_ds.GetRasterBand(1).WriteRaster(x, y, 1, 1, b"\x01")
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    options = ["DISTUNITS=GEO", "NODATA=-1", "NUM_THREADS=%d" % num_threads]
+    if maxdist:
+        options.append("MAXDIST=%d" % maxdist)
+    assert (
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1), dst_ds.GetRasterBand(1), options=options
+        )
+        == 0
+    )
+    got = struct.unpack("f" * (xsize * ysize), dst_ds.ReadRaster())
+
+    for y in range(ysize):
+        for x in range(xsize):
+            expected = min(math.hypot(2 * (x - tx), 3 * (y - ty)) for tx, ty in targets)
+            if maxdist and expected > maxdist:
+                expected = -1
+            assert got[y * xsize + x] == pytest.approx(expected, rel=1e-6), (x, y)
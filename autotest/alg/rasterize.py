@@ -11,6 +11,7 @@
 # SPDX-License-Identifier: MIT
 ###############################################################################
 
+import random
 import struct
 
 import ogrtest
@@ -1039,3 +1040,76 @@ def test_rasterize_bugfix_gh12129():
 
     # 121 on s390x
     assert target_ds.GetRasterBand(1).Checksum() in (120, 121)
+
+
+###############################################################################
+# Test that the multi-threaded implementation of RasterizeLayer() gives the
+# same result as the single-threaded one
+
+
+@pytest.mark.parametrize("chunkysize", [0, 7])
+@pytest.mark.parametrize(
+    "options",
+    [["MERGE_ALG=REPLACE"], ["MERGE_ALG=ADD"], ["ALL_TOUCHED=YES"]],
+    ids=["replace", "add", "all_touched"],
+)
+def test_rasterize_layer_multithreaded(chunkysize, options):
+
+    sr = osr.SpatialReference('LOCAL_CS["arbitrary"]')
+
+    rast_ogr_ds = ogr.GetDriverByName("MEM").CreateDataSource("wrk")
+    rast_mem_lyr = rast_ogr_ds.CreateLayer("lyr", srs=sr)
+    rast_mem_lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+
+    rng = random.Random(0)
+
+    def coord():
+        return rng.randint(-40, 840) / 8.0
+
+    for i in range(300):
+        kind = i % 3
+        if kind == 0:
+            x, y = coord(), coord()
+            w, h = rng.randint(1, 160) / 8.0, rng.randint(1, 160) / 8.0
+            wkt = "POLYGON ((%f %f,%f %f,%f %f,%f %f))" % (
+                x,
+                y,
+                x + w,
+                y + h / 2,
+                x,
+                y + h,
+                x,
+                y,
+            )
+        elif kind == 1:
+            wkt = "LINESTRING (%f %f,%f %f,%f %f)" % tuple(coord() for _ in range(6))
+        else:
+            wkt = "POINT (%f %f)" % (coord(), coord())
+        f = ogr.Feature(rast_mem_lyr.GetLayerDefn())
+        f["val"] = i % 250 + 1
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        rast_mem_lyr.CreateFeature(f)
+
+    def rasterize(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 100, 100, 2, gdal.GDT_Float32)
+        ds.SetGeoTransform((0, 1, 0, 100, 0, -1))
+        ds.SetSpatialRef(sr)
+        assert (
+            gdal.RasterizeLayer(
+                ds,
+                [1, 2],
+                rast_mem_lyr,
+                options=options
+                + [
+                    "ATTRIBUTE=val",
+                    "CHUNKYSIZE=%d" % chunkysize,
+                    "NUM_THREADS=%d" % num_threads,
+                ],
+            )
+            == 0
+        )
+        return ds.ReadRaster()
+
+    ref = rasterize(1)
+    assert rasterize(4) == ref
+    assert rasterize(3) == ref
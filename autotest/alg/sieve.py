@@ -13,6 +13,8 @@
 ###############################################################################
 
 
+import random
+
 import gdaltest
 import pytest
 
@@ -341,3 +343,45 @@ def test_sieve_all_masked():
     gdal.SieveFilter(src_band, mask_band, src_band, 4, 4)
 
     assert src_band.Checksum() == expected_cs
+
+
+###############################################################################
+# Test that the multi-threaded implementation gives the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+def test_sieve_multithreaded(connectedness, use_mask):
+
+    rng = random.Random(0)
+    drv = gdal.GetDriverByName("MEM")
+    src_ds = drv.Create("", 97, 83)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 97, 83, bytes(rng.randrange(4) for _ in range(97 * 83))
+    )
+    mask_ds = drv.Create("", 97, 83)
+    mask_ds.GetRasterBand(1).WriteRaster(
+        0, 0, 97, 83, bytes(int(rng.randrange(10) != 0) for _ in range(97 * 83))
+    )
+    mask_band = mask_ds.GetRasterBand(1) if use_mask else None
+
+    def sieve(num_threads):
+        dst_ds = drv.Create("", 97, 83)
+        assert (
+            gdal.SieveFilter(
+                src_ds.GetRasterBand(1),
+                mask_band,
+                dst_ds.GetRasterBand(1),
+                6,
+                connectedness,
+                options=["NUM_THREADS=%d" % num_threads],
+            )
+            == 0
+        )
+        return dst_ds.ReadRaster()
+
+    ref = sieve(1)
+    assert ref != src_ds.ReadRaster()
+    assert sieve(4) == ref
+    assert sieve(7) == ref
@@ -3567,6 +3567,156 @@ def test_ogr_csv_do_not_write_header(tmp_vsimem):
         assert lyr.GetFeatureCount() == 10
 
 
+###############################################################################
+# Test multi-threaded reading
+
+
+@pytest.mark.parametrize("chunk_size", ["7", "1000", "1000000"])
+@gdaltest.enable_exceptions()
+def test_ogr_csv_read_multithreaded(tmp_vsimem, chunk_size):
+
+    filename = tmp_vsimem / "test.csv"
+    lines = ["\ufeffid,int,str,WKT"]
+    for i in range(5000):
+        if i % 7 == 0:
+            s = f'"multi\r\nline ""{i}""\n\rvalue"'
+        elif i % 11 == 0:
+            s = f'"with,comma {i}"'
+        else:
+            s = f"value {i}"
+        intval = "invalid" if i == 3000 else str(i)
+        lines.append(f'{i},{intval},{s},"POINT ({i} {-i})"')
+        if i % 13 == 0:
+            lines.append("")
+    gdal.FileFromMemBuffer(filename, "\r\n".join(lines))
+    gdal.FileFromMemBuffer(str(filename) + "t", "Integer,Integer,String,String")
+
+    def read(num_threads):
+        ret = []
+        with gdaltest.config_options(
+            {
+                "OGR_CSV_NUM_THREADS": num_threads,
+                "OGR_CSV_PARALLEL_CHUNK_SIZE": chunk_size,
+            }
+        ):
+            with ogr.Open(filename) as ds:
+                lyr = ds.GetLayer(0)
+                with gdal.quiet_errors():
+                    for f in lyr:
+                        ret.append(
+                            (
+                                f.GetFID(),
+                                f["id"],
+                                f["int"],
+                                f["str"],
+                                f.GetGeometryRef().ExportToIsoWkt(),
+                            )
+                        )
+                    assert (
+                        gdal.GetLastErrorMsg()
+                        == "Invalid value type found in record 3001 for field int. This warning will no longer be emitted"
+                    )
+                # Random access after multi-threaded reading
+                assert lyr.GetFeature(4000)["id"] == 3999
+                lyr.ResetReading()
+                assert lyr.GetNextFeature().GetFID() == 1
+        return ret
+
+    ref = read("1")
+    assert len(ref) == 5000
+    assert ref[-1] == (5000, 4999, 4999, "value 4999", "POINT (4999 -4999)")
+    assert ref[7] == (8, 7, 7, 'multi\nline "7"\nvalue', "POINT (7 -7)")
+    assert read("4") == ref
+
+
+###############################################################################
+# Test that multi-threaded reading falls back to sequential reading, with the
+# same error, on a unbalanced double quote
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_csv_read_multithreaded_unbalanced_quote(tmp_vsimem):
+
+    filename = tmp_vsimem / "test.csv"
+    content = "id,str\n" + "".join(f"{i},foo\n" for i in range(2000))
+    content += '2000,"unbalanced\n2001,bar\n'
+    gdal.FileFromMemBuffer(filename, content)
+
+    with gdaltest.config_option("OGR_CSV_NUM_THREADS", "4"):
+        with ogr.Open(filename) as ds:
+            lyr = ds.GetLayer(0)
+            for i in range(2000):
+                assert lyr.GetNextFeature().GetFID() == i + 1
+            with pytest.raises(
+                Exception,
+                match="CSV file has unbalanced number of double-quotes. Corrupted data will likely be returned",
+            ):
+                lyr.GetNextFeature()
+
+
+###############################################################################
+# Test GetFeatureCount() and AUTODETECT_TYPE=YES with multi-threading
+
+
+@pytest.mark.parametrize("chunk_size", ["5", "1000"])
+@pytest.mark.parametrize("size_limit", ["0", "20000"])
+@gdaltest.enable_exceptions()
+def test_ogr_csv_autodetect_and_count_multithreaded(tmp_vsimem, chunk_size, size_limit):
+
+    filename = tmp_vsimem / "test.csv"
+    lines = ["int,int64,real,date,datetime,bool,str,late_str"]
+    for i in range(3000):
+        s = f'"multi\r\nline ""{i}"""' if i % 7 == 0 else f"str {i}"
+        lines.append(
+            f"{i},{i * 1000000000},{i}.5,2025-01-{1 + i % 28:02d},"
+            f"2025-01-01T00:00:{i % 60:02d},{'true' if i % 2 else 'false'},{s},"
+            + ("foo" if i == 2500 else str(i))
+        )
+        if i % 13 == 0:
+            lines.append("")
+    gdal.FileFromMemBuffer(filename, "\r\n".join(lines) + "\r\n")
+
+    def read(num_threads, width):
+        with gdaltest.config_options(
+            {
+                "OGR_CSV_NUM_THREADS": num_threads,
+                "OGR_CSV_PARALLEL_CHUNK_SIZE": chunk_size,
+            }
+        ):
+            with gdal.OpenEx(
+                filename,
+                open_options=[
+                    "AUTODETECT_TYPE=YES",
+                    "AUTODETECT_SIZE_LIMIT=" + size_limit,
+                    "AUTODETECT_WIDTH=" + width,
+                ],
+            ) as ds:
+                lyr = ds.GetLayer(0)
+                defn = lyr.GetLayerDefn()
+                return lyr.GetFeatureCount(), [
+                    (
+                        defn.GetFieldDefn(i).GetType(),
+                        defn.GetFieldDefn(i).GetSubType(),
+                        defn.GetFieldDefn(i).GetWidth(),
+                        defn.GetFieldDefn(i).GetPrecision(),
+                    )
+                    for i in range(defn.GetFieldCount())
+                ]
+
+    for width in ("NO", "YES"):
+        ref = read("1", width)
+        assert ref[0] == 3000
+        assert ref[1][0][0] == ogr.OFTInteger
+        assert ref[1][1][0] == ogr.OFTInteger64
+        assert ref[1][2][0] == ogr.OFTReal
+        assert ref[1][3][0] == ogr.OFTDate
+        assert ref[1][4][0] == ogr.OFTDateTime
+        assert ref[1][5][1] == ogr.OFSTBoolean
+        assert ref[1][6][0] == ogr.OFTString
+        assert ref[1][7][0] == (ogr.OFTString if size_limit == "0" else ogr.OFTInteger)
+        assert read("4", width) == ref
+
+
 ###############################################################################
 
 
@@ -1254,6 +1254,63 @@ def test_ogr_flatgeobuf_title_description_metadata(tmp_vsimem):
     }
 
 
+###############################################################################
+# Test that the external sort of feature items used when they do not fit in
+# the allowed RAM produces the same file as the in-memory sort
+
+
+@pytest.mark.parametrize("on_disk", [False, True])
+def test_ogr_flatgeobuf_spatial_index_external_sort(tmp_vsimem, tmp_path, on_disk):
+
+    tmpdir = tmp_path if on_disk else tmp_vsimem
+
+    def create(filename):
+        ds = ogr.GetDriverByName("FlatGeoBuf").CreateDataSource(filename)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(1000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            # Include duplicated points to check the ordering of ties
+            x = (i * 37) % 101 if i % 3 else 50
+            y = (i * 53) % 97 if i % 3 else 50
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({x} {y})"))
+            lyr.CreateFeature(f)
+        ds = None
+
+    ref_filename = str(tmpdir / "ref.fgb")
+    create(ref_filename)
+
+    filename = str(tmpdir / "test.fgb")
+    with gdaltest.config_option("OGR_FLATGEOBUF_SORT_MAX_RAM", "2000"):
+        create(filename)
+
+    def read_bytes(filename):
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            return gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+        finally:
+            gdal.VSIFCloseL(f)
+
+    assert read_bytes(filename) == read_bytes(ref_filename)
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 1000
+    lyr.SetSpatialFilterRect(49.5, 49.5, 50.5, 50.5)
+    expected_ids = set(
+        i
+        for i in range(1000)
+        if i % 3 == 0 or ((i * 37) % 101, (i * 53) % 97) == (50, 50)
+    )
+    assert set(f["id"] for f in lyr) == expected_ids
+    ds = None
+
+    # Check that no temporary file remains
+    assert sorted(gdal.ReadDir(str(tmpdir))) == ["ref.fgb", "test.fgb"]
+
+
 ###############################################################################
 
 
@@ -1398,6 +1455,89 @@ def test_ogr_flatgeobuf_write_arrow(tmp_vsimem):
     )
 
 
+###############################################################################
+# Test the native WriteArrowBatch() implementation against the generic one
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.parametrize("base_impl", ["NO", "YES"])
+def test_ogr_flatgeobuf_write_arrow_native(tmp_vsimem, base_impl):
+
+    src_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("src_lyr")
+
+    field_def = ogr.FieldDefn("field_bool", ogr.OFTInteger)
+    field_def.SetSubType(ogr.OFSTBoolean)
+    src_lyr.CreateField(field_def)
+    field_def = ogr.FieldDefn("field_int16", ogr.OFTInteger)
+    field_def.SetSubType(ogr.OFSTInt16)
+    src_lyr.CreateField(field_def)
+    src_lyr.CreateField(ogr.FieldDefn("field_integer", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("field_integer64", ogr.OFTInteger64))
+    field_def = ogr.FieldDefn("field_float32", ogr.OFTReal)
+    field_def.SetSubType(ogr.OFSTFloat32)
+    src_lyr.CreateField(field_def)
+    src_lyr.CreateField(ogr.FieldDefn("field_real", ogr.OFTReal))
+    src_lyr.CreateField(ogr.FieldDefn("field_string", ogr.OFTString))
+    src_lyr.CreateField(ogr.FieldDefn("field_binary", ogr.OFTBinary))
+    src_lyr.CreateField(ogr.FieldDefn("field_date", ogr.OFTDate))
+
+    for i in range(5):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        if i != 2:
+            f["field_bool"] = i % 2
+            f["field_int16"] = -i
+            f["field_integer"] = i * 1000
+            f["field_integer64"] = 9876543210 + i
+            f["field_float32"] = 1.5 * i
+            f["field_real"] = 18.25 * i
+            f["field_string"] = "abc\u00e9" * i
+            f.SetFieldBinaryFromHexString("field_binary", "0123" * i)
+            f["field_date"] = "2011/11/%02d" % (i + 1)
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {-i})"))
+        src_lyr.CreateFeature(f)
+
+    filename = str(tmp_vsimem / "temp.fgb")
+    dst_ds = ogr.GetDriverByName("FlatGeoBuf").CreateDataSource(filename)
+    dst_lyr = dst_ds.CreateLayer(
+        "dst_lyr", geom_type=ogr.wkbPoint, options=["SPATIAL_INDEX=NO"]
+    )
+    assert dst_lyr.TestCapability(ogr.OLCFastWriteArrowBatch)
+
+    stream = src_lyr.GetArrowStream(["MAX_FEATURES_IN_BATCH=2"])
+    schema = stream.GetSchema()
+    for i in range(schema.GetChildrenCount()):
+        if schema.GetChild(i).GetName() not in ("OGC_FID", "wkb_geometry"):
+            dst_lyr.CreateFieldFromArrowSchema(schema.GetChild(i))
+
+    with gdaltest.config_option("OGR_FLATGEOBUF_WRITE_ARROW_BASE_IMPL", base_impl):
+        while True:
+            array = stream.GetNextRecordBatch()
+            if array is None:
+                break
+            dst_lyr.WriteArrowBatch(schema, array, ["FID=OGC_FID"])
+    dst_ds.Close()
+
+    dst_ds = ogr.Open(filename)
+    dst_lyr = dst_ds.GetLayer(0)
+    assert dst_lyr.GetFeatureCount() == src_lyr.GetFeatureCount()
+    src_lyr.ResetReading()
+    for src_f, dst_f in zip(src_lyr, dst_lyr):
+        assert dst_f.GetFID() == src_f.GetFID()
+        for i in range(src_lyr.GetLayerDefn().GetFieldCount()):
+            name = src_lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+            is_set = src_f.IsFieldSetAndNotNull(name)
+            assert dst_f.IsFieldSetAndNotNull(name) == is_set, name
+            if name == "field_date" and is_set:
+                assert dst_f[name] == src_f[name] + " 00:00:00"
+            else:
+                assert dst_f[name] == src_f[name], name
+        if src_f.GetGeometryRef() is None:
+            assert dst_f.GetGeometryRef() is None
+        else:
+            ogrtest.check_feature_geometry(dst_f, src_f.GetGeometryRef())
+
+
 ###############################################################################
 
 
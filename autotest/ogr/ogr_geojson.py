@@ -5947,3 +5947,140 @@ def test_ogr_geojson_sqlite_dialect_id_property():
             f = sql_lyr.GetNextFeature()
             assert f["id"] == 5
             assert f["foo"] == "bar"
+
+
+###############################################################################
+# Test multi-threaded reading of a FeatureCollection
+
+
+@pytest.mark.parametrize("chunk_size", ["100", "1000000"])
+@pytest.mark.parametrize("variant", ["regular", "bom", "fallback"])
+def test_ogr_geojson_read_multithreaded(tmp_vsimem, chunk_size, variant):
+
+    filename = tmp_vsimem / "test.json"
+    features = []
+    for i in range(1000):
+        feature = {
+            "type": "Feature",
+            "properties": {
+                "int": i,
+                "str": 'with "quote", {brace} and [bracket] %d\\' % i,
+                "nested": {"features": [i, {"a": "b"}]},
+            },
+            "geometry": {"type": "Point", "coordinates": [i, -i]},
+        }
+        if i % 3 == 0:
+            # Some duplicated ids
+            feature["id"] = i // 6
+        features.append(json.dumps(feature, indent=(1 if i % 2 else None)))
+    content = '{"type": "FeatureCollection", "name": "test",\n"features": [\n'
+    content += ",\n".join(features)
+    if variant == "fallback":
+        # Not a Feature object: the reader switches to the streaming parser
+        content += ", null"
+    content += ' ], "foo": {"features": []} }\n'
+    if variant == "bom":
+        content = "\ufeff" + content
+    gdal.FileFromMemBuffer(filename, content)
+
+    def read(num_threads):
+        ret = []
+        with gdaltest.config_options(
+            {
+                "OGR_GEOJSON_NUM_THREADS": num_threads,
+                "OGR_GEOJSON_PARALLEL_CHUNK_SIZE": chunk_size,
+            }
+        ):
+            with ogr.Open(filename) as ds:
+                lyr = ds.GetLayer(0)
+                for i_pass in range(2):
+                    with gdal.quiet_errors():
+                        gdal.ErrorReset()
+                        for f in lyr:
+                            ret.append(
+                                (
+                                    f.GetFID(),
+                                    f["int"],
+                                    f["str"],
+                                    f["nested"],
+                                    f.GetGeometryRef().ExportToIsoWkt(),
+                                )
+                            )
+                        if i_pass == 0:
+                            assert gdal.GetLastErrorMsg().startswith(
+                                "Several features with id = 0 have been found"
+                            )
+                    lyr.ResetReading()
+                assert lyr.GetFeature(998)["int"] == 998
+        return ret
+
+    ref = read("1")
+    assert len(ref) == 2000
+    assert ref[999] == (
+        999,
+        999,
+        'with "quote", {brace} and [bracket] 999\\',
+        '{ "features": [ 999, { "a": "b" } ] }',
+        "POINT (999 -999)",
+    )
+    assert read("4") == ref
+
+
+###############################################################################
+# Test that multi-threaded writing gives the same output as single-threaded one
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        [],
+        ["WRITE_BBOX=YES", "ID_GENERATE=YES", "COORDINATE_PRECISION=3"],
+        ["RFC7946=YES", 'FOREIGN_MEMBERS_FEATURE={"foo":"bar"}'],
+        ["SYNC_TO_DISK"],
+    ],
+)
+def test_ogr_geojson_write_multithreaded(tmp_vsimem, options):
+
+    sync_to_disk = "SYNC_TO_DISK" in options
+    options = [x for x in options if x != "SYNC_TO_DISK"]
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+
+    def write(num_threads):
+        filename = str(tmp_vsimem / f"out_{num_threads}.json")
+        with gdal.config_option("OGR_GEOJSON_NUM_THREADS", num_threads):
+            ds = ogr.GetDriverByName("GeoJSON").CreateDataSource(filename)
+            lyr = ds.CreateLayer("test", srs=srs, options=options)
+            lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+            lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+            for i in range(3000):
+                f = ogr.Feature(lyr.GetLayerDefn())
+                f["int"] = i
+                f["str"] = "feature %d" % i
+                x = 500000 + i * 1.234567
+                y = 4500000 - i * 7.654321
+                if i % 3 == 0:
+                    f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({x} {y})"))
+                elif i % 3 == 1:
+                    f.SetGeometry(
+                        ogr.CreateGeometryFromWkt(
+                            f"POLYGON (({x} {y},{x + 1e-4} {y},{x + 1e-4} {y + 10},{x} {y}))"
+                        )
+                    )
+                assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+                if "ID_GENERATE=YES" in options:
+                    assert f.GetFID() == i
+                if sync_to_disk and i == 2000:
+                    assert lyr.SyncToDisk() == ogr.OGRERR_NONE
+            ds = None
+        return gdal.VSIFile(filename, "rb").read()
+
+    ref = write("1")
+    assert write("4") == ref
+
+    ds = ogr.Open(ref.decode("UTF-8"))
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 3000
+    assert [f["int"] for f in lyr] == list(range(3000))
@@ -522,3 +522,60 @@ def test_ogr_geojsonseq_WRITE_BBOX(tmp_vsimem):
     gdal.VSIFCloseL(f)
 
     assert b'"bbox": [ 2.0, 49.0, 3.0, 50.0 ]' in data
+
+
+###############################################################################
+# Test multi-threaded reading
+
+
+@pytest.mark.parametrize("rs", [False, True])
+def test_ogr_geojsonseq_read_multithreaded(tmp_vsimem, rs):
+
+    filename = tmp_vsimem / "test.geojsons"
+    records = []
+    for i in range(1000):
+        if i % 100 == 50:
+            records.append("invalid")
+        elif i % 10 == 5:
+            records.append('{"type":"Point","coordinates":[%d,%d]}' % (i, -i))
+        else:
+            id_member = (',"id":%d' % (2000 + i)) if i % 3 == 0 else ""
+            records.append(
+                '{"type":"Feature"%s,"properties":{"int":%d,"str":"{[\\"%d\\"]}"},'
+                '"geometry":{"type":"Point","coordinates":[%d,%d]}}'
+                % (id_member, i, i, i, -i)
+            )
+    sep = "\x1e" if rs else ""
+    gdal.FileFromMemBuffer(filename, "".join(sep + r + "\n" for r in records))
+
+    def read(num_threads):
+        ret = []
+        with gdaltest.config_options(
+            {
+                "OGR_GEOJSON_NUM_THREADS": num_threads,
+                "OGR_GEOJSON_PARALLEL_CHUNK_SIZE": "1000",
+            }
+        ):
+            with ogr.Open(filename) as ds:
+                lyr = ds.GetLayer(0)
+                with gdal.quiet_errors():
+                    for f in lyr:
+                        ret.append(
+                            (
+                                f.GetFID(),
+                                f["int"],
+                                f["str"],
+                                f.GetGeometryRef().ExportToIsoWkt(),
+                            )
+                        )
+                    assert gdal.GetLastErrorMsg() != ""
+                lyr.SetAttributeFilter("int = 999")
+                lyr.ResetReading()
+                assert [f.GetFID() for f in lyr] == [2999]
+        return ret
+
+    ref = read("1")
+    assert len(ref) == 990
+    assert ref[5][1] is None
+    assert ref[5][3] == "POINT (5 -5)"
+    assert read("4") == ref
@@ -5025,3 +5025,136 @@ def test_ogr_gml_write_error(tmp_vsimem):
     with pytest.raises(Exception, match="Could not write line"):
         lyr.CreateFeature(f)
     ds.Close()
+
+
+###############################################################################
+# Test that write errors are still reported when geometries are encoded in
+# worker threads, where the write of a feature is deferred
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_gml_write_error_multithreaded(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.gml||maxlength=600")
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = ogr.GetDriverByName("GML").CreateDataSource(
+            filename, options=["XSISCHEMA=OFF"]
+        )
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (1 2)"))
+        with pytest.raises(Exception, match="Could not write line"):
+            lyr.CreateFeature(f)
+            ds.Close()
+        ds = None
+
+
+###############################################################################
+# Test that building geometries in worker threads gives the same result
+
+
+@pytest.mark.parametrize("read_mode", ["STANDARD", "SEQUENTIAL_LAYERS"])
+def test_ogr_gml_multithreaded_geometry_building(tmp_vsimem, read_mode):
+
+    filename = str(tmp_vsimem / "test.gml")
+    ds = ogr.GetDriverByName("GML").CreateDataSource(
+        filename, options=["XSISCHEMA=OFF"]
+    )
+    for layer_name in ("points", "lines"):
+        lyr = ds.CreateLayer(layer_name)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(2500):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            if layer_name == "points":
+                f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {i % 7})"))
+            elif i % 100 != 0:
+                f.SetGeometry(
+                    ogr.CreateGeometryFromWkt(
+                        f"LINESTRING ({i} 0,{i + 1} {i % 11},{i + 2} 1)"
+                    )
+                )
+            lyr.CreateFeature(f)
+    ds.Close()
+
+    def read(num_threads):
+        gdal.Unlink(filename[0:-3] + "gfs")
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.OpenEx(filename, open_options=["READ_MODE=" + read_mode])
+            ret = []
+            for lyr in ds:
+                ret.append(lyr.GetGeomType())
+                ret.append(lyr.GetExtent())
+                for f in lyr:
+                    g = f.GetGeometryRef()
+                    ret.append((f["id"], g.ExportToWkt() if g else None))
+                lyr.SetSpatialFilterRect(100, 0, 200, 10)
+                ret.append([f["id"] for f in lyr])
+            return ret
+
+    ref = read("1")
+    assert len(ref) == 2 * (2 + 2500 + 1)
+    assert read("4") == ref
+
+
+###############################################################################
+# Test closing a dataset while geometries are still being built in worker
+# threads
+
+
+def test_ogr_gml_multithreaded_geometry_building_close_early(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.gml")
+    ds = ogr.GetDriverByName("GML").CreateDataSource(
+        filename, options=["XSISCHEMA=OFF"]
+    )
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(2500):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"LINESTRING ({i} 0,{i + 1} 1)"))
+        lyr.CreateFeature(f)
+    ds.Close()
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        for _ in range(10):
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            for i in range(3):
+                f = lyr.GetNextFeature()
+                assert f["id"] == i
+            ds.Close()
+
+
+###############################################################################
+# Test that encoding geometries in worker threads gives the same output
+
+
+@pytest.mark.parametrize("format", ["GML2", "GML3", "GML3.2"])
+def test_ogr_gml_write_multithreaded_geometry_encoding(tmp_vsimem, format):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+
+    def write(num_threads):
+        filename = str(tmp_vsimem / num_threads / "test.gml")
+        with gdal.config_option("OGR_GML_NUM_THREADS", num_threads):
+            ds = ogr.GetDriverByName("GML").CreateDataSource(
+                filename, options=["FORMAT=" + format]
+            )
+            lyr_points = ds.CreateLayer("points", srs=srs)
+            lyr_lines = ds.CreateLayer("lines", geom_type=ogr.wkbLineString)
+            for i in range(1000):
+                f = ogr.Feature(lyr_points.GetLayerDefn())
+                f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i % 90} 2)"))
+                lyr_points.CreateFeature(f)
+                if i % 300 == 0:
+                    f = ogr.Feature(lyr_lines.GetLayerDefn())
+                    wkt = f"LINESTRING ({i} 0,{i + 1} 1)"
+                    f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+                    lyr_lines.CreateFeature(f)
+            ds.Close()
+        return gdal.VSIFile(filename, "rb").read()
+
+    assert write("4") == write("1")
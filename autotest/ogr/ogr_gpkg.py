@@ -10116,6 +10116,150 @@ def test_ogr_gpkg_write_arrow_fallback_types(tmp_vsimem):
     assert f.GetGeometryRef().ExportToIsoWkt() == "POINT (1 2)"
 
 
+###############################################################################
+# Test that the native WriteArrowBatch() implementation fails on a date it
+# cannot encode
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_gpkg_write_arrow_native_unsupported_date(tmp_vsimem):
+
+    src_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("test", geom_type=ogr.wkbNone)
+    src_lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    f = ogr.Feature(src_lyr.GetLayerDefn())
+    f["date"] = "10000/01/01"
+    src_lyr.CreateFeature(f)
+
+    filename = str(tmp_vsimem / "test.gpkg")
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone)
+    stream = src_lyr.GetArrowStream()
+    schema = stream.GetSchema()
+    lyr.CreateFieldFromArrowSchema(schema.GetChild(1))
+    array = stream.GetNextRecordBatch()
+    with pytest.raises(Exception, match="WriteArrowBatch: year 10000 unsupported"):
+        lyr.WriteArrowBatch(schema, array, ["FID=OGC_FID"])
+    assert lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Test native WriteArrowBatch() implementation against the generic one
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_gpkg_write_arrow_native(tmp_vsimem):
+
+    src_ds = ogr.GetDriverByName("MEM").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("test")
+    field_def = ogr.FieldDefn("bool", ogr.OFTInteger)
+    field_def.SetSubType(ogr.OFSTBoolean)
+    src_lyr.CreateField(field_def)
+    field_def = ogr.FieldDefn("int16", ogr.OFTInteger)
+    field_def.SetSubType(ogr.OFSTInt16)
+    src_lyr.CreateField(field_def)
+    src_lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    field_def = ogr.FieldDefn("float32", ogr.OFTReal)
+    field_def.SetSubType(ogr.OFSTFloat32)
+    src_lyr.CreateField(field_def)
+    src_lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    src_lyr.CreateField(ogr.FieldDefn("string", ogr.OFTString))
+    src_lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+    src_lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+
+    wkts = [
+        "POINT (1 2)",
+        None,
+        "POINT EMPTY",
+        "LINESTRING Z (1 2 3,4 5 6)",
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        "MULTIPOLYGON EMPTY",
+        "MULTILINESTRING M ((1 2 3,4 5 6))",
+        "CIRCULARSTRING (0 0,1 1,2 0)",
+        "GEOMETRYCOLLECTION (POINT (1 2),LINESTRING (3 4,5 6))",
+    ]
+    for i, wkt in enumerate(wkts):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        if i != 1:
+            f["bool"] = i % 2
+            f["int16"] = -i
+            f["int"] = i * 1000
+            f["int64"] = 9876543210 + i
+            f["float32"] = 1.5 * i
+            f["real"] = 18.25 * i
+            f["string"] = "abc\u00e9" * i
+            f.SetFieldBinaryFromHexString("binary", "0123" * i)
+            f["date"] = "2011/11/%02d" % (i + 1)
+        if i % 3 == 0:
+            f.SetFID(100 + i)
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        src_lyr.CreateFeature(f)
+
+    def create(filename, base_impl):
+        ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbUnknown)
+        assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch)
+
+        stream = src_lyr.GetArrowStream(["MAX_FEATURES_IN_BATCH=4"])
+        schema = stream.GetSchema()
+        for i in range(schema.GetChildrenCount()):
+            if schema.GetChild(i).GetName() not in ("wkb_geometry", "OGC_FID"):
+                lyr.CreateFieldFromArrowSchema(schema.GetChild(i))
+
+        with gdaltest.config_option("OGR_GPKG_WRITE_ARROW_BASE_IMPL", base_impl):
+            ds.StartTransaction()
+            while True:
+                array = stream.GetNextRecordBatch()
+                if array is None:
+                    break
+                lyr.WriteArrowBatch(schema, array, ["FID=OGC_FID"])
+            ds.CommitTransaction()
+        ds.Close()
+
+    def dump(filename):
+        ret = []
+        with ogr.Open(filename) as ds:
+            for sql in [
+                'SELECT fid, hex(geom), "bool", "int16", "int", "int64", '
+                '"float32", "real", "string", hex("binary"), "date" '
+                "FROM test ORDER BY fid",
+                "SELECT * FROM rtree_test_geom ORDER BY id",
+                "SELECT feature_count FROM gpkg_ogr_contents",
+                "SELECT z, m FROM gpkg_geometry_columns",
+                "SELECT min_x, min_y, max_x, max_y FROM gpkg_contents "
+                "WHERE table_name = 'test'",
+                "SELECT extension_name FROM gpkg_extensions "
+                "ORDER BY extension_name",
+            ]:
+                with ds.ExecuteSQL(sql) as sql_lyr:
+                    for f in sql_lyr:
+                        ret.append([f.GetField(i) for i in range(f.GetFieldCount())])
+        return ret
+
+    ref_filename = str(tmp_vsimem / "ref.gpkg")
+    create(ref_filename, "YES")
+    filename = str(tmp_vsimem / "test.gpkg")
+    create(filename, "NO")
+
+    assert dump(filename) == dump(ref_filename)
+
+    with ogr.Open(filename) as ds:
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() == len(wkts)
+        src_lyr.ResetReading()
+        for src_f, dst_f in zip(src_lyr, lyr):
+            assert dst_f.GetFID() == src_f.GetFID()
+            for i in range(src_lyr.GetLayerDefn().GetFieldCount()):
+                name = src_lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+                assert dst_f[name] == src_f[name], name
+            if src_f.GetGeometryRef() is None:
+                assert dst_f.GetGeometryRef() is None
+            else:
+                assert dst_f.GetGeometryRef().Equals(src_f.GetGeometryRef())
+
+
 ###############################################################################
 # Test a SQL request with the geometry in the first row being null
 
@@ -1668,40 +1668,32 @@ def test_ogr_mvt_write_errors():
     assert gdal.GetLastErrorMsg() != ""
     gdal.RmdirRecursive("tmp/tmpmvt")
 
-    # Test failure in writing in temp db (multi-threaded)
-    gdal.RmdirRecursive("/vsimem/foo")
-    with gdaltest.config_option("OGR_MVT_REMOVE_TEMP_FILE", "NO"):
-        ds = ogr.GetDriverByName("MVT").CreateDataSource("/vsimem/foo")
-    temp_ds = ogr.Open("/vsimem/foo.temp.db", update=1)
-    temp_ds.ExecuteSQL("DROP TABLE temp")
-    temp_ds = None
-    gdal.Unlink("/vsimem/foo.temp.db")
-    lyr = ds.CreateLayer("test")
-    f = ogr.Feature(lyr.GetLayerDefn())
-    f.SetGeometry(ogr.CreateGeometryFromWkt("GEOMETRYCOLLECTION(POINT(0 0))"))
-    with gdal.quiet_errors():
-        lyr.CreateFeature(f)
-        ds = None
-    assert gdal.GetLastErrorMsg() != ""
-    gdal.RmdirRecursive("tmp/tmpmvt")
-
-    # Test failure in writing in temp db (single-threaded)
-    gdal.RmdirRecursive("/vsimem/foo")
-    with gdaltest.config_option("OGR_MVT_REMOVE_TEMP_FILE", "NO"):
-        with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
-            ds = ogr.GetDriverByName("MVT").CreateDataSource("/vsimem/foo")
-    temp_ds = ogr.Open("/vsimem/foo.temp.db", update=1)
-    temp_ds.ExecuteSQL("DROP TABLE temp")
-    temp_ds = None
-    gdal.Unlink("/vsimem/foo.temp.db")
-    lyr = ds.CreateLayer("test")
-    f = ogr.Feature(lyr.GetLayerDefn())
-    f.SetGeometry(ogr.CreateGeometryFromWkt("GEOMETRYCOLLECTION(POINT(0 0))"))
-    with gdal.quiet_errors():
-        lyr.CreateFeature(f)
-        ds = None
-    assert gdal.GetLastErrorMsg() != ""
-    gdal.RmdirRecursive("tmp/tmpmvt")
+    # Test failure in writing in the temporary file
+    for num_threads in ("1", "4"):
+        gdal.RmdirRecursive("/vsimem/foo")
+        # Writes beyond the first 100 bytes of the subfile fail
+        gdal.FileFromMemBuffer("/vsimem/foo.tmp_fragments", "")
+        with gdaltest.config_options(
+            {
+                "GDAL_NUM_THREADS": num_threads,
+                "OGR_MVT_SORT_MAX_RAM": "1",
+                "OGR_MVT_REMOVE_TEMP_FILE": "NO",
+            }
+        ):
+            ds = ogr.GetDriverByName("MVT").CreateDataSource(
+                "/vsimem/foo",
+                options=["TEMPORARY_DB=/vsisubfile/0_100,/vsimem/foo.tmp_fragments"],
+            )
+            lyr = ds.CreateLayer("test")
+            gdal.ErrorReset()
+            with gdal.quiet_errors():
+                for i in range(10):
+                    f = ogr.Feature(lyr.GetLayerDefn())
+                    f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT({i} 0)"))
+                    lyr.CreateFeature(f)
+                ds = None
+        assert gdal.GetLastErrorMsg() != ""
+        gdal.Unlink("/vsimem/foo.tmp_fragments")
 
     # Test reprojection failure
     gdal.RmdirRecursive("/vsimem/foo")
@@ -1722,34 +1714,67 @@ def test_ogr_mvt_write_errors():
 
 @pytest.mark.require_driver("SQLite")
 @pytest.mark.require_geos
-def test_ogr_mvt_write_reuse_temp_db():
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_mvt_write_sort_spill(tmp_vsimem, num_threads):
 
     src_ds = gdal.GetDriverByName("MEM").Create("", 0, 0, 0, gdal.GDT_Unknown)
-    lyr = src_ds.CreateLayer("mylayer")
-
-    f = ogr.Feature(lyr.GetLayerDefn())
-    f.SetGeometry(ogr.CreateGeometryFromWkt("LINESTRING(0 0,100000 100000,200000 0)"))
-    lyr.CreateFeature(f)
-
-    with gdaltest.config_option("OGR_MVT_REMOVE_TEMP_FILE", "NO"):
-        gdal.VectorTranslate("/vsimem/out", src_ds, format="MVT")
-
-    assert gdal.VSIStatL("/vsimem/out.temp.db") is not None
-
-    gdal.RmdirRecursive("/vsimem/out")
+    for layer_name in ("layer_b", "layer_a"):
+        lyr = src_ds.CreateLayer(layer_name)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(20):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            x = -10000000 + i * 1000000
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    f"LINESTRING({x} -5000000,{x + 500000} 5000000)"
+                )
+            )
+            lyr.CreateFeature(f)
+
+    def get_tiles(filename):
+        tiles = {}
+        for z in range(4):
+            for x_dir in gdal.ReadDir(f"{filename}/{z}") or []:
+                for y_file in gdal.ReadDir(f"{filename}/{z}/{x_dir}"):
+                    tile = f"{z}/{x_dir}/{y_file}"
+                    with gdal.VSIFile(f"{filename}/{tile}", "rb") as f:
+                        tiles[tile] = f.read()
+        return tiles
+
+    ref_filename = str(tmp_vsimem / "ref")
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        gdal.VectorTranslate(
+            ref_filename,
+            src_ds,
+            format="MVT",
+            datasetCreationOptions=["MAXZOOM=3", "COMPRESS=NO"],
+        )
+    ref_tiles = get_tiles(ref_filename)
+    assert len(ref_tiles) > 10
 
-    with gdaltest.config_option("OGR_MVT_REUSE_TEMP_FILE", "YES"):
-        gdal.VectorTranslate("/vsimem/out", src_ds, format="MVT")
+    # Force the fragments to be spilled to the temporary file almost for
+    # each insertion
+    filename = str(tmp_vsimem / "out")
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": num_threads, "OGR_MVT_SORT_MAX_RAM": "100"}
+    ):
+        gdal.VectorTranslate(
+            filename,
+            src_ds,
+            format="MVT",
+            datasetCreationOptions=["MAXZOOM=3", "COMPRESS=NO"],
+        )
+    assert get_tiles(filename) == ref_tiles
+    assert gdal.VSIStatL(filename + ".tmp_fragments") is None
 
-    out_ds = ogr.Open("/vsimem/out/5")
-    assert out_ds is not None
-    out_lyr = out_ds.GetLayerByName("mylayer")
-    out_f = out_lyr.GetNextFeature()
-    assert out_f is not None
-    out_ds = None
+    with gdal.VSIFile(ref_filename + "/metadata.json", "rb") as f:
+        ref_metadata = f.read()
+    with gdal.VSIFile(filename + "/metadata.json", "rb") as f:
+        assert f.read() == ref_metadata
 
-    gdal.RmdirRecursive("/vsimem/out")
-    gdal.Unlink("/vsimem/out.temp.db")
+    out_ds = ogr.Open(filename + "/3")
+    assert out_ds.GetLayerCount() == 2
 
 
 ###############################################################################
@@ -4708,3 +4708,119 @@ def test_ogropenfilegdb_write_gdal_driver_openfilegdb_repack(tmp_path):
     alg["dataset"] = out_directory
     assert alg.Run(my_progress)
     assert last_pct[0] == 1.0
+
+
+###############################################################################
+# Test native GetArrowStream() implementation, with multi-threaded decoding
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_openfilegdb_write_arrow_stream(tmp_vsimem, num_threads):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "out.gdb")
+    ds = ogr.GetDriverByName("OpenFileGDB").CreateDataSource(filename)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    lyr = ds.CreateLayer(
+        "test",
+        geom_type=ogr.wkbPoint,
+        srs=srs,
+        options=["TARGET_ARCGIS_VERSION=ARCGIS_PRO_3_2_OR_LATER"],
+    )
+    fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+    fld_defn.SetSubType(ogr.OFSTFloat32)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("float64", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("bin", ogr.OFTBinary))
+    lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    lyr.CreateField(ogr.FieldDefn("datetime", ogr.OFTDateTime))
+    lyr.StartTransaction()
+    for i in range(5000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i % 7 != 0:
+            f["int16"] = i % 1000
+            f["int32"] = i
+            f["int64"] = 1234567890123 + i
+            f["float32"] = i + 0.5
+            f["float64"] = i + 0.25
+            f["str"] = "x" * (i % 10)
+            f.SetFieldBinaryFromHexString("bin", "0102%04X" % i)
+            f["date"] = "2024/01/%02d" % (1 + i % 28)
+            f["datetime"] = "2024/01/%02d 12:34:%02d" % (1 + i % 28, i % 60)
+        if i % 11 != 0:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i % 100, i // 100))
+            )
+        lyr.CreateFeature(f)
+    lyr.CommitTransaction()
+    for fid in range(1, 5000, 13):
+        lyr.DeleteFeature(fid)
+    ds.ExecuteSQL("CREATE INDEX idx_int32 ON test(int32)")
+    ds.Close()
+
+    def get_batches(lyr, options=[]):
+        stream = lyr.GetArrowStreamAsNumPy(options=options)
+        ret = []
+        for batch in stream:
+            ret.append({k: v.tolist() for k, v in batch.items()})
+        return ret
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    for attr_filter, spatial_filter in [
+        (None, None),
+        ("int32 > 1000", None),
+        (None, (10, 10, 30, 40)),
+        ("int32 < 3000", (10, 10, 30, 40)),
+    ]:
+        lyr.SetAttributeFilter(attr_filter)
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+        else:
+            lyr.SetSpatialFilter(None)
+
+        with gdal.config_option("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "YES"):
+            expected = get_batches(lyr)
+        assert (
+            lyr.GetMetadataItem(
+                "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+            )
+            == "NO"
+        )
+        assert expected
+
+        with gdal.config_option("OPENFILEGDB_NUM_THREADS", num_threads):
+            got = get_batches(lyr)
+            assert (
+                lyr.GetMetadataItem(
+                    "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+                )
+                == "YES"
+            )
+            assert got == expected
+
+            got = get_batches(lyr, ["MAX_FEATURES_IN_BATCH=1234"])
+            assert len(got) > 1 or len(got[0]["OBJECTID"]) <= 1234
+            for k in expected[0]:
+                assert sum([b[k] for b in got], []) == sum([b[k] for b in expected], [])
+
+    # Attribute filter that cannot be evaluated with indexes: generic code path
+    lyr.SetAttributeFilter("str = 'xxx'")
+    lyr.SetSpatialFilter(None)
+    got = get_batches(lyr)
+    assert (
+        lyr.GetMetadataItem(
+            "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+        )
+        == "NO"
+    )
+    assert len(got[0]["OBJECTID"]) == lyr.GetFeatureCount()
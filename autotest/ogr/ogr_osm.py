@@ -13,6 +13,7 @@
 ###############################################################################
 
 import os
+import sys
 
 import gdaltest
 import ogrtest
@@ -307,6 +308,47 @@ def test_ogr_osm_3_custom_compress_nodes():
         test_ogr_osm_3()
 
 
+###############################################################################
+# Test ogr2ogr with --config OSM_DENSE_NODE_INDEX YES
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Incorrect platform")
+def test_ogr_osm_3_dense_node_index():
+    with gdal.config_option("OSM_DENSE_NODE_INDEX", "YES"):
+        test_ogr_osm_3()
+
+
+###############################################################################
+# Test that the dense node index does not lose a node at (0,0)
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Incorrect platform")
+def test_ogr_osm_dense_node_index_node_at_origin(tmp_vsimem):
+
+    if not ogrtest.osm_drv_parse_osm:
+        pytest.skip("Expat support missing")
+
+    filename = str(tmp_vsimem / "test.osm")
+    gdal.FileFromMemBuffer(
+        filename,
+        """<osm version="0.6">
+<node id="1" lat="0" lon="0"/>
+<node id="2" lat="0" lon="1"/>
+<node id="4" lat="1" lon="1"/>
+<way id="1"><nd ref="1"/><nd ref="2"/><nd ref="4"/><tag k="highway" v="road"/></way>
+</osm>""",
+    )
+
+    for dense_node_index in ("YES", "NO"):
+        ds = gdal.OpenEx(
+            filename, open_options=["DENSE_NODE_INDEX=" + dense_node_index]
+        )
+        lyr = ds.GetLayerByName("lines")
+        f = lyr.GetNextFeature()
+        assert f is not None, dense_node_index
+        ogrtest.check_feature_geometry(f, "LINESTRING (0 0,1 0,1 1)")
+
+
 ###############################################################################
 # Test ogr2ogr with all layers
 
@@ -315,6 +357,101 @@ def test_ogr_osm_3_all_layers():
     return test_ogr_osm_3(options="-skip", all_layers=True)
 
 
+###############################################################################
+# Test that building geometries of ways and multipolygons with several threads
+# gives the same result as with a single thread
+
+
+def test_ogr_osm_multithreaded_geometry_building(tmp_vsimem):
+
+    if not ogrtest.osm_drv_parse_osm:
+        pytest.skip("Expat support missing")
+
+    nodes = []
+    ways = []
+    relations = []
+    node_id = 1
+    way_id = 1
+    for i in range(1500):
+        x = (i % 50) * 0.01
+        y = (i // 50) * 0.01
+        ids = []
+        for dx, dy in ((0, 0), (0.005, 0), (0.005, 0.005), (0, 0.005)):
+            nodes.append(f'<node id="{node_id}" lat="{y + dy}" lon="{x + dx}"/>')
+            ids.append(node_id)
+            node_id += 1
+        if i % 3 == 0:
+            # Closed way tagged as area
+            refs = "".join(f'<nd ref="{n}"/>' for n in ids + ids[0:1])
+            tags = '<tag k="building" v="yes"/>'
+            if i == 0:
+                # Triggers a "Too many tags for way" debug message
+                tags += "".join(f'<tag k="key{k}" v="v"/>' for k in range(300))
+            ways.append(f'<way id="{way_id}">{refs}{tags}</way>')
+            way_id += 1
+        elif i % 3 == 1:
+            # Line
+            refs = "".join(f'<nd ref="{n}"/>' for n in ids)
+            tags = '<tag k="highway" v="residential"/>'
+            ways.append(f'<way id="{way_id}">{refs}{tags}</way>')
+            way_id += 1
+        else:
+            # Multipolygon made of two open ways
+            refs1 = "".join(f'<nd ref="{n}"/>' for n in ids[0:3])
+            refs2 = "".join(f'<nd ref="{n}"/>' for n in ids[2:4] + ids[0:1])
+            ways.append(f'<way id="{way_id}">{refs1}</way>')
+            ways.append(f'<way id="{way_id + 1}">{refs2}</way>')
+            relations.append(
+                f'<relation id="{i}">'
+                f'<member type="way" ref="{way_id}" role="outer"/>'
+                f'<member type="way" ref="{way_id + 1}" role="outer"/>'
+                '<tag k="type" v="multipolygon"/>'
+                '<tag k="landuse" v="forest"/></relation>'
+            )
+            way_id += 2
+
+    filename = str(tmp_vsimem / "test.osm")
+    gdal.FileFromMemBuffer(
+        filename,
+        '<osm version="0.6">'
+        + "".join(nodes)
+        + "".join(ways)
+        + "".join(relations)
+        + "</osm>",
+    )
+
+    def get_features(num_threads):
+        debug_msgs = []
+
+        def my_handler(errorClass, errno, msg):
+            if errorClass == gdal.CE_Debug and "Too many tags for way" in msg:
+                debug_msgs.append(msg)
+
+        with gdaltest.config_options(
+            {"GDAL_NUM_THREADS": num_threads, "CPL_DEBUG": "ON"}
+        ), gdaltest.error_handler(my_handler):
+            ds = ogr.Open(filename)
+            ret = {}
+            for layer_name in ("lines", "multipolygons"):
+                lyr = ds.GetLayerByName(layer_name)
+                ret[layer_name] = [
+                    (
+                        f["osm_id"],
+                        f["osm_way_id"] if layer_name == "multipolygons" else None,
+                        f.GetGeometryRef().ExportToIsoWkt(),
+                    )
+                    for f in lyr
+                ]
+            ret["debug_msgs"] = debug_msgs
+            return ret
+
+    ref = get_features("1")
+    assert len(ref["lines"]) == 500
+    assert len(ref["multipolygons"]) == 1000
+    assert ref["debug_msgs"]
+    assert get_features("4") == ref
+
+
 ###############################################################################
 # Test optimization when reading only the points layer through a SQL request
 
@@ -14,6 +14,7 @@
 
 import json
 import math
+import re
 
 import gdaltest
 import ogrtest
@@ -1669,6 +1670,99 @@ def test_ogr_parquet_attribute_filter_and_spatial_filter_with_spatial_index(
     assert lyr.GetFeatureCount() == ref_fc
 
 
+###############################################################################
+# Test row group pruning with complex attribute filters
+
+
+@pytest.mark.parametrize(
+    "filter,max_row_groups,options",
+    [
+        ("i IN (5, 57)", 2, {}),
+        ("i IN (5, 1000)", 1, {}),
+        ("i NOT IN (5, 57)", 10, {}),
+        ("i = 5 OR i = 57", 2, {}),
+        ("i = 5 OR s = 'val057'", 3, {}),
+        ("i = 5 OR s LIKE '%57'", 10, {}),
+        ("NOT (i < 90)", 1, {}),
+        ("NOT (i < 90 OR i > 95)", 1, {}),
+        ("NOT (i >= 10 AND i <= 89)", 2, {}),
+        ("i BETWEEN 12 AND 14", 1, {}),
+        ("i BETWEEN 12 AND 14 OR r BETWEEN 80.5 AND 81.5", 2, {}),
+        ("i < 1.5", 10, {}),
+        ("r IN (3.5, 42.5)", 2, {}),
+        ("i64 IN (3, 1234567890123)", 2, {}),
+        ("s LIKE 'val05%'", 2, {}),
+        ("s LIKE 'val0_1'", 10, {}),
+        ("s LIKE 'zzz%'", 1, {}),
+        ("s LIKE 'VAL05%'", 10, {"OGR_SQL_LIKE_AS_ILIKE": "YES"}),
+        ("s ILIKE 'VAL05%'", 10, {}),
+        ("s IN ('val001', 'val099')", 3, {}),
+        ("NOT (s IS NULL)", 9, {}),
+        ("s IS NULL OR i = 1", 3, {}),
+        ("NOT (s IS NOT NULL AND i > 5)", 3, {}),
+        # s is null for fid 75, which makes the expression true for it
+        ("NOT (i >= 0 AND s < 'val080')", 4, {}),
+        ("NOT (s >= 'val080' OR i < 0)", 8, {}),
+        ("s NOT IN ('val075', 'val076')", 10, {}),
+        ("fid IN (1, 99)", 2, {}),
+    ],
+)
+def test_ogr_parquet_attribute_filter_row_group_pruning(
+    tmp_vsimem, filter, max_row_groups, options
+):
+
+    filename = str(tmp_vsimem / "test.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(filename)
+    lyr = ds.CreateLayer(
+        "test", geom_type=ogr.wkbNone, options=["ROW_GROUP_SIZE=10", "FID=fid"]
+    )
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("i64", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("s", ogr.OFTString))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["i"] = i
+        f["i64"] = i if i != 50 else 1234567890123
+        f["r"] = i + 0.5
+        if (i < 20 or i >= 30) and i != 75:
+            f["s"] = "val%03d" % i
+        lyr.CreateFeature(f)
+    ds = None
+
+    with gdaltest.config_options(
+        {**options, "OGR_PARQUET_OPTIMIZED_ATTRIBUTE_FILTER": "NO"}
+    ):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(filter)
+        ref_fids = [f.GetFID() for f in lyr]
+        ds = None
+
+    debug_msgs = []
+
+    def my_handler(errorClass, errno, msg):
+        if errorClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    with gdaltest.config_options({**options, "CPL_DEBUG": "ON"}):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(filter)
+        with gdaltest.error_handler(my_handler):
+            fids = [f.GetFID() for f in lyr]
+        assert fids == ref_fids
+        assert lyr.GetFeatureCount() == len(ref_fids)
+
+    # No message is emitted when all row groups are selected
+    selected_row_groups = 10
+    for msg in debug_msgs:
+        m = re.search(r"(\d+)/10 row groups selected", msg)
+        if m:
+            selected_row_groups = int(m.group(1))
+    assert selected_row_groups <= max_row_groups
+
+
 ###############################################################################
 # Test IS NULL / IS NOT NULL
 
@@ -3737,33 +3831,23 @@ def test_ogr_parquet_get_extent_3d(tmp_vsimem):
 
 
 @gdaltest.enable_exceptions()
-@pytest.mark.require_driver("GPKG")
-def test_ogr_parquet_sort_by_bbox(tmp_vsimem):
+@pytest.mark.parametrize("max_ram", [None, "1000"])
+def test_ogr_parquet_sort_by_bbox(tmp_vsimem, max_ram):
 
     outfilename = str(tmp_vsimem / "test_ogr_parquet_sort_by_bbox.parquet")
     ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
 
-    gpkg_drv = gdal.GetDriverByName("GPKG")
-    gpkg_drv.Deregister()
     ROW_GROUP_SIZE = 100
-    try:
-        with pytest.raises(
-            Exception,
-            match="Driver GPKG required for SORT_BY_BBOX layer creation option",
-        ):
-            ds.CreateLayer(
-                "test",
-                geom_type=ogr.wkbPoint,
-                options=["SORT_BY_BBOX=YES", f"ROW_GROUP_SIZE={ROW_GROUP_SIZE}"],
-            )
-    finally:
-        gpkg_drv.Register()
-
-    lyr = ds.CreateLayer(
-        "test",
-        geom_type=ogr.wkbPoint,
-        options=["SORT_BY_BBOX=YES", f"ROW_GROUP_SIZE={ROW_GROUP_SIZE}", "FID=fid"],
-    )
+    with gdaltest.config_option("OGR_PARQUET_SORT_MAX_RAM", max_ram):
+        lyr = ds.CreateLayer(
+            "test",
+            geom_type=ogr.wkbPoint,
+            options=[
+                "SORT_BY_BBOX=YES",
+                f"ROW_GROUP_SIZE={ROW_GROUP_SIZE}",
+                "FID=fid",
+            ],
+        )
     assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
     lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
     COUNT_NON_SPATIAL = 501
@@ -3825,11 +3909,12 @@ def test_ogr_parquet_sort_by_bbox(tmp_vsimem):
 
     # Check that this works also when using the Arrow interface for creation
     outfilename2 = str(tmp_vsimem / "test_ogr_parquet_sort_by_bbox2.parquet")
-    gdal.VectorTranslate(
-        outfilename2,
-        outfilename,
-        layerCreationOptions=["SORT_BY_BBOX=YES", "ROW_GROUP_SIZE=100"],
-    )
+    with gdaltest.config_option("OGR_PARQUET_SORT_MAX_RAM", max_ram):
+        gdal.VectorTranslate(
+            outfilename2,
+            outfilename,
+            layerCreationOptions=["SORT_BY_BBOX=YES", "ROW_GROUP_SIZE=100"],
+        )
     check_file(outfilename2)
 
 
@@ -4431,3 +4516,125 @@ def test_ogr_parquet_test_ogrsf_parquet_geometry():
 
     assert "INFO" in ret
     assert "ERROR" not in ret
+
+
+###############################################################################
+# Test writing a Hive-partitioned dataset
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("max_open_files", [None, "3"])
+def test_ogr_parquet_write_partitioned(tmp_vsimem, num_threads, max_open_files):
+
+    outdirname = str(tmp_vsimem / "test_ogr_parquet_write_partitioned")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outdirname)
+    options = ["PARTITION_BY=str", "PARTITION_GRID_SIZE=10", "FID=fid"]
+    if max_open_files:
+        options.append("MAX_OPEN_FILES=" + max_open_files)
+    with gdaltest.config_option("OGR_PARQUET_NUM_THREADS", num_threads):
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint, options=options)
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+        COUNT = 3000
+        for i in range(COUNT):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            if i % 7 != 0:
+                f["str"] = "a/b" if i % 2 == 0 else "c"
+            f["i"] = i
+            x = (i // 100) % 15
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT({x} 5)"))
+            lyr.CreateFeature(f)
+        assert lyr.GetFeatureCount() == COUNT
+        with pytest.raises(Exception, match="Cannot add field"):
+            lyr.CreateField(ogr.FieldDefn("other", ogr.OFTString))
+        ds = None
+
+    assert set(gdal.ReadDir(outdirname)) == set(
+        ["_metadata", "str=a%2Fb", "str=c", "str=__HIVE_DEFAULT_PARTITION__"]
+    )
+    assert set(gdal.ReadDir(outdirname + "/str=c")) == set(["grid_x=0", "grid_x=1"])
+    # With MAX_OPEN_FILES=3, the files of the partitions of the first cell
+    # are closed when writing the second one, and new ones are created after.
+    assert (
+        gdal.VSIStatL(outdirname + "/str=c/grid_x=0/grid_y=0/part-1.parquet")
+        is not None
+    ) == (max_open_files is not None)
+    part_filename = outdirname + "/str=c/grid_x=1/grid_y=0/part-0.parquet"
+    ds = ogr.Open(part_filename)
+    lyr = ds.GetLayer(0)
+    assert [
+        lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+        for i in range(lyr.GetLayerDefn().GetFieldCount())
+    ] == ["i"]
+    assert lyr.GetFIDColumn() == "fid"
+    f = lyr.GetNextFeature()
+    assert f["i"] % 2 == 1 and f["i"] % 7 != 0
+    assert f.GetFID() == f["i"]
+    assert 10 <= f.GetGeometryRef().GetX() < 15
+    ds = None
+
+    if _has_arrow_dataset():
+        for use_metadata_file in ["YES", "NO"]:
+            with gdaltest.config_option(
+                "OGR_PARQUET_USE_METADATA_FILE", use_metadata_file
+            ):
+                ds = ogr.Open(outdirname)
+                lyr = ds.GetLayer(0)
+                assert lyr.GetFeatureCount() == COUNT
+                lyr.SetAttributeFilter("i = 1003")
+                f = lyr.GetNextFeature()
+                assert f["str"] == "c"
+                assert f["grid_x"] == 1
+                assert f["grid_y"] == 0
+                assert f.GetGeometryRef().ExportToWkt() == "POINT (10 5)"
+                ds = None
+
+
+###############################################################################
+# Test that Create() creates the output file of a non-partitioned dataset
+
+
+def test_ogr_parquet_create_output_file(tmp_vsimem):
+
+    with pytest.raises(Exception, match="Cannot create"):
+        with gdaltest.enable_exceptions():
+            ogr.GetDriverByName("Parquet").CreateDataSource(
+                "/i_do/not/exist/out.parquet"
+            )
+
+    filename = str(tmp_vsimem / "out.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(filename)
+    assert gdal.VSIStatL(filename) is not None
+    ds.Close()
+    assert gdal.VSIStatL(filename) is not None
+
+    # The file is replaced by a directory for a partitioned dataset
+    dirname = str(tmp_vsimem / "out_dir")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(dirname)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone, options=["PARTITION_BY=x"])
+    lyr.CreateField(ogr.FieldDefn("x", ogr.OFTString))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["x"] = "a"
+    lyr.CreateFeature(f)
+    ds.Close()
+    assert gdal.VSIStatL(dirname).IsDirectory()
+    assert gdal.VSIStatL(dirname + "/x=a/part-0.parquet") is not None
+
+
+###############################################################################
+# Test errors when writing a Hive-partitioned dataset
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_parquet_write_partitioned_errors(tmp_vsimem):
+
+    outdirname = str(tmp_vsimem / "test_ogr_parquet_write_partitioned_errors")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outdirname)
+    with pytest.raises(Exception, match="PARTITION_GRID_SIZE requires"):
+        ds.CreateLayer("test", geom_type=ogr.wkbNone, options=["PARTITION_GRID_SIZE=1"])
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone, options=["PARTITION_BY=x"])
+    lyr.CreateField(ogr.FieldDefn("y", ogr.OFTString))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    with pytest.raises(Exception, match="PARTITION_BY field x does not exist"):
+        lyr.CreateFeature(f)
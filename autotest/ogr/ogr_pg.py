@@ -6352,3 +6352,207 @@ def test_ogr_pg_gdal_vector_pipeline(pg_ds):
         },
     ) as alg:
         assert alg.Output().GetLayerCount() == 1
+
+
+###############################################################################
+# Test that the binary and text formats of COPY give the same result
+
+
+@pytest.mark.parametrize("binary_copy", ("YES", "NO"))
+def test_ogr_pg_copy_binary(pg_ds, binary_copy):
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+
+    with gdal.config_options({"PG_USE_COPY": "YES", "PG_USE_BINARY_COPY": binary_copy}):
+        lyr = pg_ds.CreateLayer("test_copy_binary", srs=srs, options=["OVERWRITE=YES"])
+        fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+        fld_defn.SetSubType(ogr.OFSTInt16)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+        fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+        fld_defn.SetSubType(ogr.OFSTFloat32)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("float64", ogr.OFTReal))
+        fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+        fld_defn.SetSubType(ogr.OFSTBoolean)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        fld_defn = ogr.FieldDefn("str_width", ogr.OFTString)
+        fld_defn.SetWidth(3)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+        lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int16"] = -32768
+        f["int32"] = 123456789
+        f["int64"] = 1234567890123
+        f["float32"] = 1.5
+        f["float64"] = 1.2345678901234567
+        f["bool"] = True
+        f["str"] = "tab\tnew line\nback\\slash é"
+        f["str_width"] = "éabcd"
+        f.SetFieldBinaryFromHexString("binary", "00FF10")
+        f["date"] = "1969/07/21"
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON ((0 0,0 1,1 1,0 0))"))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = ""
+        f["date"] = "2038/02/01"
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT EMPTY"))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFieldNull("int32")
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        assert pg_ds.SyncToDisk() == ogr.OGRERR_NONE
+
+    ds = reconnect(pg_ds)
+    lyr = ds.GetLayerByName("test_copy_binary")
+    f = lyr.GetNextFeature()
+    assert f["int16"] == -32768
+    assert f["int32"] == 123456789
+    assert f["int64"] == 1234567890123
+    assert f["float32"] == 1.5
+    assert f["float64"] == 1.2345678901234567
+    assert f["bool"] == 1
+    assert f["str"] == "tab\tnew line\nback\\slash é"
+    assert f["str_width"] == "éab"
+    assert f.GetFieldAsBinary("binary") == b"\x00\xff\x10"
+    assert f["date"] == "1969/07/21"
+    assert f.GetGeometryRef().ExportToWkt() == "POLYGON ((0 0,0 1,1 1,0 0))"
+    assert f.GetGeometryRef().GetSpatialReference().GetAuthorityCode(None) == "4326"
+    f = lyr.GetNextFeature()
+    assert f["str"] == ""
+    assert f["date"] == "2038/02/01"
+    assert f.GetGeometryRef().ExportToWkt() == "POINT EMPTY"
+    f = lyr.GetNextFeature()
+    assert f.IsFieldNull("int32")
+    assert f.GetGeometryRef() is None
+
+
+###############################################################################
+# Test that reading with a binary cursor, including through the specialized
+# GetNextArrowArray() implementation, gives the same result as a text cursor
+
+
+def _get_features_and_arrow_batches(ds, layer_name, binary_cursor):
+
+    with gdal.config_options(
+        {"PG_USE_BINARY_CURSOR": binary_cursor, "OGR_PG_CURSOR_PAGE": "2"}
+    ):
+        lyr = ds.GetLayerByName(layer_name)
+        features = [f.DumpReadableAsString() for f in lyr]
+
+        stream = lyr.GetArrowStreamAsNumPy(options=["MAX_FEATURES_IN_BATCH=2"])
+        batches = [{k: v.tolist() for k, v in batch.items()} for batch in stream]
+        optimized = lyr.GetMetadataItem(
+            "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+        )
+
+    return features, batches, optimized
+
+
+def test_ogr_pg_binary_cursor(pg_ds, use_postgis):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+
+    lyr = pg_ds.CreateLayer(
+        "test_binary_cursor", srs=srs, options=["OVERWRITE=YES", "FID=fid"]
+    )
+    fld_defn = ogr.FieldDefn("int16", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    fld_defn = ogr.FieldDefn("float32", ogr.OFTReal)
+    fld_defn.SetSubType(ogr.OFSTFloat32)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("float64", ogr.OFTReal))
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    fld_defn = ogr.FieldDefn("str_width", ogr.OFTString)
+    fld_defn.SetWidth(5)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("binary", ogr.OFTBinary))
+    lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["int16"] = -32768
+    f["int32"] = 123456789
+    f["int64"] = 1234567890123
+    f["float32"] = 1.1
+    f["float64"] = 1.2345678901234567
+    f["bool"] = True
+    f["str"] = "tab\tnew line\nback\\slash é"
+    f["str_width"] = "éa"
+    f.SetFieldBinaryFromHexString("binary", "00FF10")
+    f["date"] = "1969/07/21"
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON ((0 0,0 1,1 1,0 0))"))
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["str"] = ""
+    f["date"] = "2038/02/01"
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (1 2)"))
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetFieldNull("int32")
+    f["bool"] = False
+    f["float32"] = -3.4e38
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetFID(100)
+    f["int64"] = -(1 << 62)
+    f.SetGeometry(ogr.CreateGeometryFromWkt("MULTIPOINT ((1 2),(3 4))"))
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+    pg_ds.ExecuteSQL("INSERT INTO test_binary_cursor (date) VALUES ('infinity')")
+
+    ds = reconnect(pg_ds, update=False)
+
+    features_text, batches_text, optimized = _get_features_and_arrow_batches(
+        ds, "test_binary_cursor", "NO"
+    )
+    assert optimized == "NO"
+    assert len(features_text) == 5
+    assert len(batches_text) == 3
+
+    features_binary, batches_binary, optimized = _get_features_and_arrow_batches(
+        ds, "test_binary_cursor", "YES"
+    )
+    # Geometries stored as bytea cannot be read with a binary cursor
+    assert optimized == ("YES" if use_postgis else "NO")
+    assert features_binary == features_text
+    assert batches_binary == batches_text
+
+    f = ds.GetLayerByName("test_binary_cursor").GetFeature(100)
+    assert f["int64"] == -(1 << 62)
+
+    # Unsupported column type: fall back to a text cursor
+    pg_ds.ExecuteSQL("ALTER TABLE test_binary_cursor ADD COLUMN num numeric")
+    pg_ds.ExecuteSQL("UPDATE test_binary_cursor SET num = 1.25 WHERE fid = 100")
+
+    ds = reconnect(pg_ds, update=False)
+
+    features_text, batches_text, _ = _get_features_and_arrow_batches(
+        ds, "test_binary_cursor", "NO"
+    )
+    features_binary, batches_binary, optimized = _get_features_and_arrow_batches(
+        ds, "test_binary_cursor", "YES"
+    )
+    assert optimized == "NO"
+    assert features_binary == features_text
+    assert batches_binary == batches_text
+    assert ds.GetLayerByName("test_binary_cursor").GetFeature(100)["num"] == 1.25
@@ -565,6 +565,68 @@ def test_ogr_pmtiles_write():
             gdal.Unlink(filename)
 
 
+###############################################################################
+# Test deduplication and external sorting of tiles in direct writing mode
+
+
+@pytest.mark.require_driver("MBTiles")
+# MBTiles vector writing mode requires SQLite and GEOS
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("sort_max_ram", [None, "100", "4000"])
+def test_ogr_pmtiles_write_deduplication(tmp_vsimem, num_threads, sort_max_ram):
+
+    filename = str(tmp_vsimem / "test.pmtiles")
+    with gdaltest.config_options(
+        {
+            "OGR_PMTILES_NUM_THREADS": num_threads,
+            "OGR_PMTILES_SORT_MAX_RAM": sort_max_ram,
+        }
+    ):
+        ds = gdal.GetDriverByName("PMTiles").Create(
+            filename, 0, 0, 0, gdal.GDT_Unknown, options=["MINZOOM=2", "MAXZOOM=3"]
+        )
+        lyr = ds.CreateLayer("test")
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON((-20000000 -20000000,-20000000 20000000,20000000 20000000,20000000 -20000000,-20000000 -20000000))"
+            )
+        )
+        lyr.CreateFeature(f)
+        ds = None
+
+    f = gdal.VSIFOpenL(f"/vsipmtiles/{filename}/pmtiles_header.json", "rb")
+    assert f
+    try:
+        data = gdal.VSIFReadL(1, 10000, f)
+    finally:
+        gdal.VSIFCloseL(f)
+    got = json.loads(data)
+
+    assert got["addressed_tiles_count"] == 16 + 64
+    if sort_max_ram == "100":
+        # Too small to remember any tile content hash for deduplication
+        assert got["tile_contents_count"] == got["tile_entries_count"]
+        assert got["tile_entries_count"] == got["addressed_tiles_count"]
+    else:
+        assert got["tile_contents_count"] < got["tile_entries_count"]
+        assert got["tile_entries_count"] < got["addressed_tiles_count"]
+    assert got["clustered"]
+
+    for z in (2, 3):
+        for x in range(1 << z):
+            for y in range(1 << z):
+                assert gdal.VSIStatL(f"/vsipmtiles/{filename}/{z}/{x}/{y}.mvt")
+
+    ds = ogr.Open(filename)
+    assert ds.GetLayer(0).GetFeatureCount() > 0
+
+    # No temporary file left behind
+    assert gdal.ReadDir(str(tmp_vsimem)) == ["test.pmtiles"]
+
+
 ###############################################################################
 
 
@@ -5938,7 +5938,7 @@ def test_ogr_shape_arrow_stream():
         lyr.GetMetadataItem(
             "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
         )
-        == "NO"
+        == "YES"
     )
     assert len(batches) == 1
     assert len(batches[0]) == 5
@@ -6035,7 +6035,7 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
     )
     assert len(batches) == 0
 
-    # Regular code path
+    # Optimized code path
     lyr.SetIgnoredFields(ignored_fields[0:-1])
     stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
     batches = [batch for batch in stream]
@@ -6044,14 +6044,14 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
         lyr.GetMetadataItem(
             "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
         )
-        == "NO"
+        == "YES"
     )
     assert len(batches) == 1
     assert len(batches[0]) == 2
     assert len(batches[0]["OGC_FID"]) == 10
     assert list(batches[0]["OGC_FID"]) == [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]
 
-    # Regular code path
+    # Optimized code path
     lyr.SetIgnoredFields(ignored_fields[1:])
     stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
     batches = [batch for batch in stream]
@@ -6060,7 +6060,7 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
         lyr.GetMetadataItem(
             "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
         )
-        == "NO"
+        == "YES"
     )
     assert len(batches) == 1
     assert len(batches[0]) == 2
@@ -6132,6 +6132,94 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
     assert len(batches) == 0
 
 
+###############################################################################
+# Test that the optimized GetArrowStream() implementation returns the same
+# content as the generic one, with attributes, geometries and filters
+
+
+@pytest.mark.parametrize(
+    "geom_type,spatial_filter,expected_fids",
+    [
+        (ogr.wkbPoint, None, [0, 1, 2, 3, 4, 5, 6, 8, 9]),
+        (ogr.wkbPoint, (0.5, 0.5, 2.5, 2.5), [1, 2]),
+        (ogr.wkbPolygon, None, [0, 1, 2, 3, 4, 5, 6, 8, 9]),
+        (ogr.wkbPolygon, (0.5, 0.5, 2.5, 2.5), [0, 1, 2]),
+    ],
+)
+def test_ogr_shape_arrow_stream_optimized_vs_generic(
+    tmp_vsimem, geom_type, spatial_filter, expected_fids
+):
+    gdaltest.importorskip_gdal_array()
+    pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test_ogr_shape_arrow_stream_optim.shp")
+    ds = gdal.GetDriverByName("ESRI Shapefile").Create(
+        filename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer("test", geom_type=geom_type, options=["AUTO_REPACK=NO"])
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("int64", ogr.OFTInteger64)
+    fld_defn.SetWidth(18)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    fld_defn = ogr.FieldDefn("bool", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(fld_defn)
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i % 3 != 0:
+            f["str"] = "  val%d  " % i
+            f["int"] = -i
+            f["int64"] = 1234567890123 * i
+            f["real"] = 1.5 * i
+            f["date"] = "2024/01/%02d" % (i + 1)
+            f["bool"] = i % 2
+        if i != 4:
+            if geom_type == ogr.wkbPoint:
+                f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+            else:
+                f.SetGeometry(
+                    ogr.CreateGeometryFromWkt(
+                        "POLYGON ((%d %d,%d %d,%d %d,%d %d))"
+                        % (i, i, i, i + 1, i + 1, i + 1, i, i)
+                    )
+                )
+        lyr.CreateFeature(f)
+    lyr.DeleteFeature(7)
+    ds.Close()
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    if spatial_filter:
+        lyr.SetSpatialFilterRect(*spatial_filter)
+
+    def get_batches():
+        stream = lyr.GetArrowStreamAsNumPy(options=["MAX_FEATURES_IN_BATCH=3"])
+        return [{k: v.tolist() for k, v in batch.items()} for batch in stream]
+
+    batches_optimized = get_batches()
+    assert (
+        lyr.GetMetadataItem(
+            "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+        )
+        == "YES"
+    )
+
+    with gdaltest.config_option("OGR_SHAPE_STREAM_BASE_IMPL", "YES"):
+        batches_generic = get_batches()
+    assert (
+        lyr.GetMetadataItem(
+            "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+        )
+        == "NO"
+    )
+
+    assert batches_optimized == batches_generic
+    assert [fid for b in batches_optimized for fid in b["OGC_FID"]] == expected_fids
+
+
 ###############################################################################
 # Test DBF Logical field type
 
@@ -6218,3 +6306,131 @@ def test_ogr_shape_write_check_golden_file(tmp_path, src_directory):
         assert (
             open(src_filename, "rb").read() == open(out_filename, "rb").read()
         ), filename
+
+
+###############################################################################
+# Test .hrt packed Hilbert R-tree spatial index
+
+
+@pytest.mark.parametrize("auto_mode", [None, "DEFAULT", "YES", "IN_MEMORY"])
+def test_ogr_shape_hilbert_rtree_spatial_index(tmp_path, auto_mode):
+
+    filename = str(tmp_path / "test.shp")
+    hrt_filename = str(tmp_path / "test.hrt")
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        if i % 10 != 0:
+            x = i % 40
+            y = i // 40
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    f"POLYGON(({x} {y},{x} {y+0.5},{x+0.5} {y+0.5},{x+0.5} {y},{x} {y}))"
+                )
+            )
+        lyr.CreateFeature(f)
+    ds.Close()
+
+    def get_ids(lyr, minx, miny, maxx, maxy):
+        lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+        ret = [f["id"] for f in lyr]
+        lyr.SetSpatialFilter(None)
+        return ret
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    queries = [
+        (0, 0, 1, 1),
+        (10.2, 3.2, 20.7, 8.1),
+        (-10, -10, -5, -5),
+        (39, 24, 40, 25),
+    ]
+    expected = [get_ids(lyr, *q) for q in queries]
+    assert expected[0] == [1, 40, 41]
+    assert not lyr.TestCapability(ogr.OLCFastSpatialFilter)
+    ds.Close()
+
+    if auto_mode is None:
+        # Explicit creation
+        ds = ogr.Open(filename, update=1)
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE HILBERT")
+        ds.Close()
+        assert os.path.exists(hrt_filename)
+    else:
+        options = {"SHAPE_AUTO_SPATIAL_INDEX_MIN_FEATURES": "1000"}
+        if auto_mode != "DEFAULT":
+            options["SHAPE_AUTO_SPATIAL_INDEX"] = auto_mode
+        with gdal.config_options(options):
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            assert [get_ids(lyr, *q) for q in queries] == expected
+            assert lyr.TestCapability(ogr.OLCFastSpatialFilter)
+            ds.Close()
+        # By default, the index is only built in memory
+        assert os.path.exists(hrt_filename) == (auto_mode == "YES")
+        if auto_mode != "YES":
+            return
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCFastSpatialFilter)
+    assert [get_ids(lyr, *q) for q in queries] == expected
+    assert hrt_filename in ds.GetFileList()
+    ds.Close()
+
+    # Index is ignored if the .shp file has been modified, even if its size
+    # has not changed
+    shp_mtime = os.stat(filename).st_mtime
+    os.utime(filename, (shp_mtime + 10, shp_mtime + 10))
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert not lyr.TestCapability(ogr.OLCFastSpatialFilter)
+    ds.Close()
+    os.utime(filename, (shp_mtime, shp_mtime))
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCFastSpatialFilter)
+    ds.Close()
+
+    # Editing the layer invalidates the index
+    ds = ogr.Open(filename, update=1)
+    lyr = ds.GetLayer(0)
+    lyr.DeleteFeature(1)
+    ds.Close()
+    assert not os.path.exists(hrt_filename)
+
+    # Index that does not match the .shp file is ignored
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE HILBERT")
+    lyr = ds.GetLayer(0)
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f["id"] = 1000
+    f.SetGeometry(
+        ogr.CreateGeometryFromWkt("POLYGON((100 100,100 101,101 101,101 100,100 100))")
+    )
+    hrt_content = open(hrt_filename, "rb").read()
+    lyr.CreateFeature(f)
+    ds.Close()
+    open(hrt_filename, "wb").write(hrt_content)
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert not lyr.TestCapability(ogr.OLCFastSpatialFilter)
+    assert get_ids(lyr, 99, 99, 101, 101) == [1000]
+    ds.Close()
+
+    # Replacing by a .qix index
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE HILBERT")
+    assert os.path.exists(hrt_filename)
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test")
+    assert not os.path.exists(hrt_filename)
+    assert os.path.exists(str(tmp_path / "test.qix"))
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON test TYPE HILBERT")
+    assert os.path.exists(hrt_filename)
+    assert not os.path.exists(str(tmp_path / "test.qix"))
+    ds.ExecuteSQL("DROP SPATIAL INDEX ON test")
+    assert not os.path.exists(hrt_filename)
+    ds.Close()
@@ -12,8 +12,13 @@
 
 #include "gdal_thread_pool.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <mutex>
 
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
 // For unclear reasons, attempts at making this a std::unique_ptr<>, even
 // through a GetCompressThreadPool() method like GetMutexThreadPool(), lead
 // to "ctest -R autotest_alg" (and other autotest components as well)
@@ -52,3 +57,34 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/************************************************************************/
+/*                         GDALGetNumThreads()                          */
+/************************************************************************/
+
+/** Return the number of worker threads to use.
+ *
+ * The value is taken from the pszItem option of papszOptions if it is set,
+ * otherwise from the pszConfigOption configuration option if it is set,
+ * otherwise nDefault is used. The value may be an integer or ALL_CPUS, and
+ * the result is clamped to [1, 128].
+ *
+ * @param papszOptions option list, or nullptr.
+ * @param pszItem name of the option in papszOptions, or nullptr.
+ * @param pszConfigOption name of the configuration option, or nullptr.
+ * @param nDefault value used when neither option is set.
+ * @return the number of threads.
+ */
+int GDALGetNumThreads(CSLConstList papszOptions, const char *pszItem,
+                      const char *pszConfigOption, int nDefault)
+{
+    const char *pszNumThreads =
+        pszItem ? CSLFetchNameValue(papszOptions, pszItem) : nullptr;
+    if (pszNumThreads == nullptr && pszConfigOption != nullptr)
+        pszNumThreads = CPLGetConfigOption(pszConfigOption, nullptr);
+    const int nThreads =
+        pszNumThreads == nullptr          ? nDefault
+        : EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                           : atoi(pszNumThreads);
+    return std::max(1, std::min(128, nThreads));
+}
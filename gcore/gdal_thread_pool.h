@@ -13,10 +13,14 @@
 #ifndef GDAL_THREAD_POOL_H
 #define GDAL_THREAD_POOL_H
 
+#include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
 CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
+int CPL_DLL GDALGetNumThreads(CSLConstList papszOptions, const char *pszItem,
+                              const char *pszConfigOption, int nDefault);
+
 void GDALDestroyGlobalThreadPool();
 
 #endif  // GDAL_THREAD_POOL_H
@@ -31,6 +31,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -92,10 +93,34 @@ static void AppendString(char **ppszText, size_t *pnLength, size_t *pnMaxLength,
                          const char *pszTextToAppend)
 
 {
-    _GrowBuffer(*pnLength + strlen(pszTextToAppend) + 1, ppszText, pnMaxLength);
+    const size_t nTextToAppendLen = strlen(pszTextToAppend);
 
-    strcat(*ppszText + *pnLength, pszTextToAppend);
+    // Callers may have written in the buffer without updating *pnLength
     *pnLength += strlen(*ppszText + *pnLength);
+    _GrowBuffer(*pnLength + nTextToAppendLen + 1, ppszText, pnMaxLength);
+
+    memcpy(*ppszText + *pnLength, pszTextToAppend, nTextToAppendLen + 1);
+    *pnLength += nTextToAppendLen;
+}
+
+/************************************************************************/
+/*                          AppendCoordinate()                          */
+/************************************************************************/
+
+// Append a coordinate tuple, formatted as in WKT, preceded by a space
+// separator if it is not the first one of a list.
+static void AppendCoordinate(char **ppszText, size_t *pnLength,
+                             size_t *pnMaxLength,
+                             const std::string &osCoordinate, bool bFirst)
+
+{
+    _GrowBuffer(*pnLength + osCoordinate.size() + 2, ppszText, pnMaxLength);
+
+    if (!bFirst)
+        (*ppszText)[(*pnLength)++] = ' ';
+    memcpy(*ppszText + *pnLength, osCoordinate.c_str(),
+           osCoordinate.size() + 1);
+    *pnLength += osCoordinate.size();
 }
 
 /************************************************************************/
@@ -115,20 +140,14 @@ static void AppendCoordinateList(const OGRLineString *poLine, char **ppszText,
     strcat(*ppszText + *pnLength, "<gml:coordinates>");
     *pnLength += strlen(*ppszText + *pnLength);
 
-    char szCoordinate[256] = {};
     for (int iPoint = 0; iPoint < poLine->getNumPoints(); iPoint++)
     {
-        MakeGMLCoordinate(szCoordinate, poLine->getX(iPoint),
-                          poLine->getY(iPoint), poLine->getZ(iPoint), b3D,
-                          coordOpts);
-        _GrowBuffer(*pnLength + strlen(szCoordinate) + 1, ppszText,
-                    pnMaxLength);
-
-        if (iPoint != 0)
-            strcat(*ppszText + *pnLength, " ");
-
-        strcat(*ppszText + *pnLength, szCoordinate);
-        *pnLength += strlen(*ppszText + *pnLength);
+        std::string osCoordinate =
+            OGRMakeWktCoordinate(poLine->getX(iPoint), poLine->getY(iPoint),
+                                 poLine->getZ(iPoint), b3D ? 3 : 2, coordOpts);
+        std::replace(osCoordinate.begin(), osCoordinate.end(), ' ', ',');
+        AppendCoordinate(ppszText, pnLength, pnMaxLength, osCoordinate,
+                         iPoint == 0);
     }
 
     _GrowBuffer(*pnLength + 20, ppszText, pnMaxLength);
@@ -494,32 +513,20 @@ static void AppendGML3CoordinateList(const OGRSimpleCurve *poLine,
         strcat(*ppszText + *pnLength, "<gml:posList>");
     *pnLength += strlen(*ppszText + *pnLength);
 
-    char szCoordinate[256] = {};
-
     for (int iPoint = 0; iPoint < poLine->getNumPoints(); iPoint++)
     {
-        if (bCoordSwap)
-        {
-            const std::string wkt = OGRMakeWktCoordinate(
-                poLine->getY(iPoint), poLine->getX(iPoint),
-                poLine->getZ(iPoint), b3D ? 3 : 2, coordOpts);
-            memcpy(szCoordinate, wkt.data(), wkt.size() + 1);
-        }
-        else
-        {
-            const std::string wkt = OGRMakeWktCoordinate(
-                poLine->getX(iPoint), poLine->getY(iPoint),
-                poLine->getZ(iPoint), b3D ? 3 : 2, coordOpts);
-            memcpy(szCoordinate, wkt.data(), wkt.size() + 1);
-        }
-        _GrowBuffer(*pnLength + strlen(szCoordinate) + 1, ppszText,
-                    pnMaxLength);
-
-        if (iPoint != 0)
-            strcat(*ppszText + *pnLength, " ");
-
-        strcat(*ppszText + *pnLength, szCoordinate);
-        *pnLength += strlen(*ppszText + *pnLength);
+        const std::string osCoordinate =
+            bCoordSwap
+                ? OGRMakeWktCoordinate(poLine->getY(iPoint),
+                                       poLine->getX(iPoint),
+                                       poLine->getZ(iPoint), b3D ? 3 : 2,
+                                       coordOpts)
+                : OGRMakeWktCoordinate(poLine->getX(iPoint),
+                                       poLine->getY(iPoint),
+                                       poLine->getZ(iPoint), b3D ? 3 : 2,
+                                       coordOpts);
+        AppendCoordinate(ppszText, pnLength, pnMaxLength, osCoordinate,
+                         iPoint == 0);
     }
 
     _GrowBuffer(*pnLength + 20, ppszText, pnMaxLength);
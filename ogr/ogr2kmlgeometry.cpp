@@ -171,10 +171,14 @@ static void AppendString(char **ppszText, size_t *pnLength, size_t *pnMaxLength,
                          const char *pszTextToAppend)
 
 {
-    _GrowBuffer(*pnLength + strlen(pszTextToAppend) + 1, ppszText, pnMaxLength);
+    const size_t nTextToAppendLen = strlen(pszTextToAppend);
 
-    strcat(*ppszText + *pnLength, pszTextToAppend);
+    // Callers may have written in the buffer without updating *pnLength
     *pnLength += strlen(*ppszText + *pnLength);
+    _GrowBuffer(*pnLength + nTextToAppendLen + 1, ppszText, pnMaxLength);
+
+    memcpy(*ppszText + *pnLength, pszTextToAppend, nTextToAppendLen + 1);
+    *pnLength += nTextToAppendLen;
 }
 
 /************************************************************************/
@@ -196,17 +200,18 @@ static void AppendCoordinateList(OGRLineString *poLine, char **ppszText,
 
     for (int iPoint = 0; iPoint < poLine->getNumPoints(); iPoint++)
     {
-        MakeKMLCoordinate(szCoordinate, sizeof(szCoordinate),
+        if (iPoint != 0)
+            szCoordinate[0] = ' ';
+        char *pszCoordinate = szCoordinate + (iPoint != 0 ? 1 : 0);
+        MakeKMLCoordinate(pszCoordinate,
+                          sizeof(szCoordinate) - (pszCoordinate - szCoordinate),
                           poLine->getX(iPoint), poLine->getY(iPoint),
                           poLine->getZ(iPoint), b3D);
-        _GrowBuffer(*pnLength + strlen(szCoordinate) + 1, ppszText,
-                    pnMaxLength);
+        const size_t nCoordinateLen = strlen(szCoordinate);
+        _GrowBuffer(*pnLength + nCoordinateLen + 1, ppszText, pnMaxLength);
 
-        if (iPoint != 0)
-            strcat(*ppszText + *pnLength, " ");
-
-        strcat(*ppszText + *pnLength, szCoordinate);
-        *pnLength += strlen(*ppszText + *pnLength);
+        memcpy(*ppszText + *pnLength, szCoordinate, nCoordinateLen + 1);
+        *pnLength += nCoordinateLen;
     }
 
     _GrowBuffer(*pnLength + 20, ppszText, pnMaxLength);
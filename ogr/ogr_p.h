@@ -202,6 +202,9 @@ OGRGeometry CPL_DLL *OGRGeometryFromHexEWKB(const char *pszBytea, int *pnSRID,
                                             int bIsPostGIS1_EWKB);
 char CPL_DLL *OGRGeometryToHexEWKB(OGRGeometry *poGeometry, int nSRSId,
                                    int nPostGISMajor, int nPostGISMinor);
+bool CPL_DLL OGRGeometryToEWKB(const OGRGeometry *poGeometry, int nSRSId,
+                               int nPostGISMajor, int nPostGISMinor,
+                               std::string &osEWKB);
 
 /************************************************************************/
 /*                        WKB Type Handling encoding                    */
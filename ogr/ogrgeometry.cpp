@@ -7235,109 +7235,92 @@ OGRGeometry *OGRGeometryFromHexEWKB(const char *pszBytea, int *pnSRID,
 }
 
 /************************************************************************/
-/*                       OGRGeometryToHexEWKB()                         */
+/*                         OGRGeometryToEWKB()                          */
 /************************************************************************/
 
-char *OGRGeometryToHexEWKB(OGRGeometry *poGeometry, int nSRSId,
-                           int nPostGISMajor, int nPostGISMinor)
+// Binary counterpart of OGRGeometryToHexEWKB(). The SRID is included if
+// nSRSId is strictly positive.
+bool OGRGeometryToEWKB(const OGRGeometry *poGeometry, int nSRSId,
+                       int nPostGISMajor, int nPostGISMinor,
+                       std::string &osEWKB)
 {
     const size_t nWkbSize = poGeometry->WkbSize();
-    GByte *pabyWKB = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nWkbSize));
-    if (pabyWKB == nullptr)
-        return CPLStrdup("");
+    const size_t nSRIDSize = nSRSId > 0 ? sizeof(GUInt32) : 0;
+    try
+    {
+        osEWKB.resize(nWkbSize + nSRIDSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory: too large geometry");
+        return false;
+    }
 
+    // The WKB is exported after room for the SRID, so that only its 5 first
+    // bytes have to be moved.
+    GByte *pabyEWKB = reinterpret_cast<GByte *>(&osEWKB[0]);
+    GByte *pabyWKB = pabyEWKB + nSRIDSize;
+    OGRwkbVariant eVariant = wkbVariantOldOgc;
     if ((nPostGISMajor > 2 || (nPostGISMajor == 2 && nPostGISMinor >= 2)) &&
         wkbFlatten(poGeometry->getGeometryType()) == wkbPoint &&
         poGeometry->IsEmpty())
     {
-        if (poGeometry->exportToWkb(wkbNDR, pabyWKB, wkbVariantIso) !=
-            OGRERR_NONE)
-        {
-            CPLFree(pabyWKB);
-            return CPLStrdup("");
-        }
-    }
-    else if (poGeometry->exportToWkb(wkbNDR, pabyWKB,
-                                     (nPostGISMajor < 2)
-                                         ? wkbVariantPostGIS1
-                                         : wkbVariantOldOgc) != OGRERR_NONE)
-    {
-        CPLFree(pabyWKB);
-        return CPLStrdup("");
+        eVariant = wkbVariantIso;
     }
-
-    // When converting to hex, each byte takes 2 hex characters.  In addition
-    // we add in 8 characters to represent the SRID integer in hex, and
-    // one for a null terminator.
-    // The limit of INT_MAX = 2 GB is a bit artificial, but at time of writing
-    // (2024), PostgreSQL by default cannot handle objects larger than 1 GB:
-    // https://github.com/postgres/postgres/blob/5d39becf8ba0080c98fee4b63575552f6800b012/src/include/utils/memutils.h#L40
-    if (nWkbSize >
-        static_cast<size_t>(std::numeric_limits<int>::max() - 8 - 1) / 2)
+    else if (nPostGISMajor < 2)
     {
-        CPLFree(pabyWKB);
-        return CPLStrdup("");
+        eVariant = wkbVariantPostGIS1;
     }
-    const size_t nTextSize = nWkbSize * 2 + 8 + 1;
-    char *pszTextBuf = static_cast<char *>(VSI_MALLOC_VERBOSE(nTextSize));
-    if (pszTextBuf == nullptr)
+    if (nWkbSize < 5 ||
+        poGeometry->exportToWkb(wkbNDR, pabyWKB, eVariant) != OGRERR_NONE)
     {
-        CPLFree(pabyWKB);
-        return CPLStrdup("");
+        return false;
     }
-    char *pszTextBufCurrent = pszTextBuf;
-
-    // Convert the 1st byte, which is the endianness flag, to hex.
-    char *pszHex = CPLBinaryToHex(1, pabyWKB);
-    strcpy(pszTextBufCurrent, pszHex);
-    CPLFree(pszHex);
-    pszTextBufCurrent += 2;
 
-    // Next, get the geom type which is bytes 2 through 5.
-    GUInt32 geomType;
-    memcpy(&geomType, pabyWKB + 1, 4);
-
-    // Now add the SRID flag if an SRID is provided.
     if (nSRSId > 0)
     {
-        // Change the flag to wkbNDR (little) endianness.
+        // Byte order, then geometry type with the SRID flag, then SRID.
+        GUInt32 nGeomType;
+        memcpy(&nGeomType, pabyWKB + 1, sizeof(nGeomType));
         constexpr GUInt32 WKBSRIDFLAG = 0x20000000;
-        GUInt32 nGSrsFlag = CPL_LSBWORD32(WKBSRIDFLAG);
-        // Apply the flag.
-        geomType = geomType | nGSrsFlag;
+        nGeomType |= CPL_LSBWORD32(WKBSRIDFLAG);
+        const GUInt32 nGSRSId = CPL_LSBWORD32(static_cast<GUInt32>(nSRSId));
+        pabyEWKB[0] = pabyWKB[0];
+        memcpy(pabyEWKB + 1, &nGeomType, sizeof(nGeomType));
+        memcpy(pabyEWKB + 5, &nGSRSId, sizeof(nGSRSId));
     }
 
-    // Now write the geom type which is 4 bytes.
-    pszHex = CPLBinaryToHex(4, reinterpret_cast<const GByte *>(&geomType));
-    strcpy(pszTextBufCurrent, pszHex);
-    CPLFree(pszHex);
-    pszTextBufCurrent += 8;
+    return true;
+}
 
-    // Now include SRID if provided.
-    if (nSRSId > 0)
+/************************************************************************/
+/*                       OGRGeometryToHexEWKB()                         */
+/************************************************************************/
+
+char *OGRGeometryToHexEWKB(OGRGeometry *poGeometry, int nSRSId,
+                           int nPostGISMajor, int nPostGISMinor)
+{
+    std::string osEWKB;
+    if (!OGRGeometryToEWKB(poGeometry, nSRSId, nPostGISMajor, nPostGISMinor,
+                           osEWKB))
     {
-        // Force the srsid to wkbNDR (little) endianness.
-        const GUInt32 nGSRSId = CPL_LSBWORD32(nSRSId);
-        pszHex = CPLBinaryToHex(sizeof(nGSRSId),
-                                reinterpret_cast<const GByte *>(&nGSRSId));
-        strcpy(pszTextBufCurrent, pszHex);
-        CPLFree(pszHex);
-        pszTextBufCurrent += 8;
+        return CPLStrdup("");
     }
 
-    // Copy the rest of the data over - subtract
-    // 5 since we already copied 5 bytes above.
-    pszHex = CPLBinaryToHex(static_cast<int>(nWkbSize - 5), pabyWKB + 5);
-    CPLFree(pabyWKB);
-    if (!pszHex || pszHex[0] == 0)
+    // When converting to hex, each byte takes 2 hex characters, plus one for
+    // a null terminator.
+    // The limit of INT_MAX = 2 GB is a bit artificial, but at time of writing
+    // (2024), PostgreSQL by default cannot handle objects larger than 1 GB:
+    // https://github.com/postgres/postgres/blob/5d39becf8ba0080c98fee4b63575552f6800b012/src/include/utils/memutils.h#L40
+    if (osEWKB.size() >
+        static_cast<size_t>(std::numeric_limits<int>::max() - 1) / 2)
     {
-        CPLFree(pszTextBuf);
-        return pszHex;
+        return CPLStrdup("");
     }
-    strcpy(pszTextBufCurrent, pszHex);
-    CPLFree(pszHex);
 
-    return pszTextBuf;
+    return CPLBinaryToHex(static_cast<int>(osEWKB.size()),
+                          reinterpret_cast<const GByte *>(osEWKB.data()));
 }
 
 /************************************************************************/
@@ -16,6 +16,9 @@
 
 #include "ogrsf_frmts.h"
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <set>
 
 typedef enum
@@ -82,6 +85,20 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
     bool bHasFieldNames = false;
 
     OGRFeature *GetNextUnfilteredFeature();
+    OGRFeature *GetNextUnfilteredFeatureSequential();
+    OGRFeature *BuildFeatureFromTokens(char **papszTokens, int64_t nFID);
+
+    // Multi-threaded reading. See ReadFeaturesInParallel()
+    bool m_bParallelReadingDisabled = false;
+    bool m_bParallelEOF = false;
+    int64_t m_nParallelNextFID = FID_INITIAL_VALUE;
+    vsi_l_offset m_nParallelBufferOffset = 0;
+    std::string m_osParallelBuffer{};
+    std::deque<std::unique_ptr<OGRFeature>> m_apoParallelFeatures{};
+
+    bool CanReadInParallel() const;
+    bool ReadFeaturesInParallel();
+    void StopParallelReading();
 
     bool bNew = false;
     bool bInWriteMode = false;
@@ -122,7 +139,7 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
 
     char **AutodetectFieldTypes(CSLConstList papszOpenOptions, int nFieldCount);
 
-    bool bWarningBadTypeOrWidth = false;
+    std::atomic<bool> bWarningBadTypeOrWidth{false};
     bool bKeepSourceColumns = false;
     bool bKeepGeomColumns = true;
 
@@ -26,15 +26,20 @@
 #include <algorithm>
 #include <cinttypes>
 #include <limits>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_csv.h"
+#include "cpl_csv_priv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -47,6 +52,272 @@
 
 IOGRCSVLayer::~IOGRCSVLayer() = default;
 
+/************************************************************************/
+/*                         CSVFindSpecialChar()                         */
+/************************************************************************/
+
+// Return the index of the first double quote, carriage return, line feed or
+// nul character in pszData[i:nSize], or nSize if there is none.
+// Eight bytes are tested at a time, so that runs of ordinary characters are
+// skipped quickly.
+static size_t CSVFindSpecialChar(const char *pszData, size_t i, size_t nSize)
+{
+    constexpr uint64_t ONES = 0x0101010101010101U;
+    constexpr uint64_t HIGH_BITS = 0x8080808080808080U;
+    const auto HasZeroByte = [](uint64_t v)
+    { return ((v - ONES) & ~v & HIGH_BITS) != 0; };
+
+    for (; i + sizeof(uint64_t) <= nSize; i += sizeof(uint64_t))
+    {
+        uint64_t v;
+        memcpy(&v, pszData + i, sizeof(v));
+        if (HasZeroByte(v) || HasZeroByte(v ^ (ONES * '"')) ||
+            HasZeroByte(v ^ (ONES * '\r')) || HasZeroByte(v ^ (ONES * '\n')))
+        {
+            break;
+        }
+    }
+    for (; i < nSize; ++i)
+    {
+        const char ch = pszData[i];
+        if (ch == '"' || ch == '\r' || ch == '\n' || ch == '\0')
+            break;
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                           CSVScanRecord()                            */
+/************************************************************************/
+
+namespace
+{
+struct OGRCSVRecord
+{
+    size_t nStart = 0;  // after the UTF-8 BOM, if any
+    size_t nEnd = 0;    // excluding the end of line
+    size_t nNext = 0;   // start of the next record
+    bool bMultiLine = false;
+};
+
+enum class CSVScanStatus
+{
+    COMPLETE,
+    INCOMPLETE,   // more data is needed
+    UNSUPPORTED,  // must be handled by CSVReadParseLine3L()
+};
+}  // namespace
+
+// Find the extent of the record starting at pszData[nPos], following the
+// rules of CSVReadParseLine3L() with bHonourStrings = bSkipBOM = true.
+// Situations where CSVReadParseLine3L() would emit an error (nul character,
+// line reaching the maximum line size, unbalanced double quotes) are
+// reported as UNSUPPORTED, so that the caller falls back to it.
+static CSVScanStatus CSVScanRecord(const char *pszData, size_t nSize,
+                                   size_t nPos, bool bEOF, char chDelimiter,
+                                   int nMaxLineSize, OGRCSVRecord &sRecord,
+                                   size_t &nNextPos)
+{
+    if (nSize - nPos < 3 && !bEOF)
+        return CSVScanStatus::INCOMPLETE;
+
+    sRecord.nStart = nPos;
+    if (nSize - nPos >= 3 && memcmp(pszData + nPos, "\xEF\xBB\xBF", 3) == 0)
+        sRecord.nStart += 3;
+    sRecord.bMultiLine = false;
+
+    size_t nLineStart = nPos;
+    const auto IsLineTooLong = [&nLineStart, nMaxLineSize](size_t nLineEnd)
+    {
+        return nMaxLineSize > 0 &&
+               nLineEnd - nLineStart + 1 >= static_cast<size_t>(nMaxLineSize);
+    };
+
+    bool bInString = false;
+    size_t i = sRecord.nStart;
+    while (true)
+    {
+        i = CSVFindSpecialChar(pszData, i, nSize);
+        if (i == nSize)
+        {
+            if (!bEOF)
+                return CSVScanStatus::INCOMPLETE;
+            if (bInString || IsLineTooLong(i))
+                return CSVScanStatus::UNSUPPORTED;
+            sRecord.nEnd = i;
+            nNextPos = i;
+            return CSVScanStatus::COMPLETE;
+        }
+
+        const char ch = pszData[i];
+        if (ch == '\0')
+        {
+            return CSVScanStatus::UNSUPPORTED;
+        }
+        else if (ch == '"')
+        {
+            if (!bInString)
+            {
+                // Only consider " as the start of a quoted string if it is
+                // the first character of the record, or if it is immediately
+                // after the field delimiter.
+                bInString =
+                    i == sRecord.nStart || pszData[i - 1] == chDelimiter;
+            }
+            else if (i + 1 == nSize && !bEOF)
+            {
+                return CSVScanStatus::INCOMPLETE;
+            }
+            else if (i + 1 < nSize && pszData[i + 1] == '"')
+            {
+                // Escaped double quote in a quoted string
+                ++i;
+            }
+            else
+            {
+                bInString = false;
+            }
+            ++i;
+        }
+        else
+        {
+            // End of line: CR, LF, CR LF or LF CR, as in CPLReadLine3L()
+            if (IsLineTooLong(i))
+                return CSVScanStatus::UNSUPPORTED;
+            if (i + 1 == nSize && !bEOF)
+                return CSVScanStatus::INCOMPLETE;
+            size_t nEOLSize = 1;
+            if (i + 1 < nSize &&
+                (pszData[i + 1] == '\r' || pszData[i + 1] == '\n') &&
+                pszData[i + 1] != ch)
+            {
+                nEOLSize = 2;
+            }
+            if (!bInString)
+            {
+                sRecord.nEnd = i;
+                nNextPos = i + nEOLSize;
+                return CSVScanStatus::COMPLETE;
+            }
+            sRecord.bMultiLine = true;
+            i += nEOLSize;
+            nLineStart = i;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      CSVNormalizeLineEndings()                       */
+/************************************************************************/
+
+// Replace in place the ends of line of a multi-line record by a single line
+// feed, as done by CSVReadParseLine3L(), and nul-terminate it.
+static void CSVNormalizeLineEndings(char *pszStart, const char *pszEnd)
+{
+    char *pszOut = pszStart;
+    for (const char *pszIn = pszStart; pszIn < pszEnd; ++pszIn)
+    {
+        const char ch = *pszIn;
+        if (ch == '\r' || ch == '\n')
+        {
+            if (pszIn + 1 < pszEnd && (pszIn[1] == '\r' || pszIn[1] == '\n') &&
+                pszIn[1] != ch)
+            {
+                ++pszIn;
+            }
+            *pszOut++ = '\n';
+        }
+        else
+        {
+            *pszOut++ = ch;
+        }
+    }
+    *pszOut = '\0';
+}
+
+/************************************************************************/
+/*                          CSVSplitRecords()                           */
+/************************************************************************/
+
+// Split pszData[0:nSize] into records with CSVScanRecord(), appending the
+// non-empty ones to asRecords. nConsumed is set to the offset of the first
+// record that has not been split. Records are nul-terminated in place, except
+// multi-line ones which must be processed by CSVNormalizeLineEndings().
+static CSVScanStatus CSVSplitRecords(char *pszData, size_t nSize, bool bEOF,
+                                     char chDelimiter, int nMaxLineSize,
+                                     std::vector<OGRCSVRecord> &asRecords,
+                                     size_t &nConsumed)
+{
+    CSVScanStatus eStatus = CSVScanStatus::COMPLETE;
+    size_t nPos = 0;
+    while (nPos < nSize)
+    {
+        OGRCSVRecord sRecord;
+        size_t nNextPos = 0;
+        eStatus = CSVScanRecord(pszData, nSize, nPos, bEOF, chDelimiter,
+                                nMaxLineSize, sRecord, nNextPos);
+        if (eStatus != CSVScanStatus::COMPLETE)
+            break;
+        // Empty lines are skipped by CSVReadParseLine3L() callers
+        if (sRecord.nEnd > sRecord.nStart)
+        {
+            if (!sRecord.bMultiLine && sRecord.nEnd < nSize)
+                pszData[sRecord.nEnd] = '\0';
+            sRecord.nNext = nNextPos;
+            asRecords.push_back(sRecord);
+        }
+        nPos = nNextPos;
+    }
+    nConsumed = nPos;
+    return eStatus;
+}
+
+/************************************************************************/
+/*                           CSVReadChunk()                             */
+/************************************************************************/
+
+// Append up to nChunkSize bytes from fp to osBuffer
+static bool CSVReadChunk(VSILFILE *fp, size_t nChunkSize, std::string &osBuffer,
+                         bool &bEOF)
+{
+    const size_t nOldSize = osBuffer.size();
+    try
+    {
+        osBuffer.resize(nOldSize + nChunkSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %" PRIu64 " bytes",
+                 static_cast<uint64_t>(nOldSize + nChunkSize));
+        return false;
+    }
+    const size_t nRead = VSIFReadL(&osBuffer[nOldSize], 1, nChunkSize, fp);
+    osBuffer.resize(nOldSize + nRead);
+    bEOF = nRead < nChunkSize;
+    return true;
+}
+
+/************************************************************************/
+/*                          GetCSVNumThreads()                          */
+/************************************************************************/
+
+static int GetCSVNumThreads()
+{
+    return GDALGetNumThreads(nullptr, nullptr, "OGR_CSV_NUM_THREADS", 1);
+}
+
+/************************************************************************/
+/*                        GetCSVChunkSize()                             */
+/************************************************************************/
+
+static size_t GetCSVChunkSize(int nDefault)
+{
+    return static_cast<size_t>(
+        std::max(1, atoi(CPLGetConfigOption("OGR_CSV_PARALLEL_CHUNK_SIZE",
+                                            CPLSPrintf("%d", nDefault)))));
+}
+
 /************************************************************************/
 /*                            OGRCSVLayer()                             */
 /*                                                                      */
@@ -875,6 +1146,102 @@ static bool OGRCSVIsFalse(const char *pszStr)
            EQUAL(pszStr, "no") || EQUAL(pszStr, "off");
 }
 
+/************************************************************************/
+/*                          CSVClassifyValue()                          */
+/************************************************************************/
+
+namespace
+{
+// Characteristics of a value used by AutodetectFieldTypes(), that do not
+// depend on the other values of the field.
+struct OGRCSVValueClass
+{
+    bool bSet = false;
+    // OFTInteger, OFTInteger64, OFTReal, OFTDate, OFTDateTime, OFTTime or
+    // OFTString
+    OGRFieldType eType = OFTString;
+    bool bIsBoolean = false;
+    int nWidth = 0;
+    int nPrecision = 0;
+};
+}  // namespace
+
+// pszValue may be modified. If bTestDate is false, date and time values are
+// reported as OFTString. Must be thread-safe.
+static void CSVClassifyValue(char *pszValue, char chDelimiter,
+                             bool bAutodetectWidth,
+                             bool bAutodetectWidthForIntOrReal, bool bTestDate,
+                             OGRCSVValueClass &sClass)
+{
+    sClass.bSet = true;
+
+    if (chDelimiter == ';')
+    {
+        char *chComma = strchr(pszValue, ',');
+        if (chComma)
+            *chComma = '.';
+    }
+    const CPLValueType eType = CPLGetValueType(pszValue);
+
+    if (bAutodetectWidth)
+    {
+        int nFieldWidth = static_cast<int>(strlen(pszValue));
+        if (pszValue[0] == '"' && pszValue[nFieldWidth - 1] == '"')
+        {
+            nFieldWidth -= 2;
+        }
+        int nFieldPrecision = 0;
+        if (eType == CPL_VALUE_REAL && bAutodetectWidthForIntOrReal)
+        {
+            const char *pszDot = strchr(pszValue, '.');
+            if (pszDot != nullptr)
+                nFieldPrecision = static_cast<int>(strlen(pszDot + 1));
+        }
+        sClass.nWidth = nFieldWidth;
+        sClass.nPrecision = nFieldPrecision;
+    }
+
+    if (eType == CPL_VALUE_INTEGER)
+    {
+        GIntBig nVal = CPLAtoGIntBig(pszValue);
+        if (!CPL_INT64_FITS_ON_INT32(nVal))
+            sClass.eType = OFTInteger64;
+        else
+            sClass.eType = OFTInteger;
+    }
+    else if (eType == CPL_VALUE_REAL || EQUAL(pszValue, "inf") ||
+             EQUAL(pszValue, "-inf") || EQUAL(pszValue, "nan"))
+    {
+        sClass.eType = OFTReal;
+    }
+    else
+    {
+        sClass.eType = OFTString;
+        sClass.bIsBoolean = OGRCSVIsTrue(pszValue) || OGRCSVIsFalse(pszValue);
+        if (bTestDate)
+        {
+            OGRField sWrkField;
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            const bool bSuccess =
+                CPL_TO_BOOL(OGRParseDate(pszValue, &sWrkField, 0));
+            CPLPopErrorHandler();
+            CPLErrorReset();
+            if (bSuccess)
+            {
+                const bool bHasDate = strchr(pszValue, '/') != nullptr ||
+                                      strchr(pszValue, '-') != nullptr;
+                const bool bHasTime = strchr(pszValue, ':') != nullptr;
+                if (bHasDate && bHasTime)
+                    sClass.eType = OFTDateTime;
+                else if (bHasDate)
+                    sClass.eType = OFTDate;
+                else
+                    sClass.eType = OFTTime;
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                        AutodetectFieldTypes()                        */
 /************************************************************************/
@@ -950,213 +1317,321 @@ char **OGRCSVLayer::AutodetectFieldTypes(CSLConstList papszOpenOptions,
     std::vector<int> anFieldPrecision(nFieldCount);
     int nStringFieldCount = 0;
 
-    while (!fp->Eof() && !fp->Error())
+    // Whether the type of the field can no longer change
+    const auto IsFieldTypeFinal = [&abFinalTypeStringSet,
+                                   bAutodetectWidth](int iField)
+    { return abFinalTypeStringSet[iField] && !bAutodetectWidth; };
+
+    // Whether values of the field need to be tested for a date
+    const auto MustTestDate = [&abFieldSet, &aeFieldType](int iField)
+    { return !(abFieldSet[iField] && aeFieldType[iField] == OFTString); };
+
+    // Update the type of a field from the characteristics of a new value.
+    // The result depends on the order of the values, so this must be
+    // called in file order.
+    const auto UpdateFieldType =
+        [&](int iField, const OGRCSVValueClass &sClass)
     {
-        char **papszTokens =
-            CSVReadParseLine3L(fp, m_nMaxLineSize, szDelimiter,
-                               true,  // bHonourStrings
-                               bQuotedFieldAsString, bMergeDelimiter,
-                               true  // bSkipBOM
-            );
-        // Can happen if we just reach EOF while trying to read new bytes.
-        if (papszTokens == nullptr)
-            break;
+        if (bAutodetectWidth)
+        {
+            if (sClass.nWidth > anFieldWidth[iField])
+                anFieldWidth[iField] = sClass.nWidth;
+            if (sClass.nPrecision > anFieldPrecision[iField])
+                anFieldPrecision[iField] = sClass.nPrecision;
+        }
 
-        if (bStreaming)
+        OGRFieldType eOGRFieldType;
+        bool bIsBoolean = false;
+        if (sClass.eType == OFTInteger || sClass.eType == OFTInteger64 ||
+            sClass.eType == OFTReal)
         {
-            // Ignore last line if it is truncated.
-            if (fp->Eof() && nRead == static_cast<size_t>(nRequested) &&
-                pszData[nRead - 1] != 13 && pszData[nRead - 1] != 10)
+            eOGRFieldType = sClass.eType;
+        }
+        else if (abFieldSet[iField] && aeFieldType[iField] == OFTString)
+        {
+            eOGRFieldType = OFTString;
+            if (abFieldBoolean[iField])
             {
-                CSLDestroy(papszTokens);
-                break;
+                abFieldBoolean[iField] = sClass.bIsBoolean;
             }
         }
-        else if (VSIFTellL(fp) > nBytes)
+        else
         {
-            CSLDestroy(papszTokens);
-            break;
+            eOGRFieldType = sClass.eType;
+            bIsBoolean = sClass.eType == OFTString && sClass.bIsBoolean;
         }
 
-        for (int iField = 0;
-             iField < nFieldCount && papszTokens[iField] != nullptr; iField++)
+        const auto SetFinalStringType = [&abFinalTypeStringSet, &aeFieldType,
+                                         &nStringFieldCount, iField]()
         {
-            if (papszTokens[iField][0] == 0)
-                continue;
-            if (abFinalTypeStringSet[iField] && !bAutodetectWidth)
-                continue;
-            if (szDelimiter[0] == ';')
+            if (!abFinalTypeStringSet[iField])
             {
-                char *chComma = strchr(papszTokens[iField], ',');
-                if (chComma)
-                    *chComma = '.';
+                aeFieldType[iField] = OFTString;
+                abFinalTypeStringSet[iField] = true;
+                nStringFieldCount++;
             }
-            const CPLValueType eType = CPLGetValueType(papszTokens[iField]);
+        };
 
-            if (bAutodetectWidth)
+        if (!abFieldSet[iField])
+        {
+            aeFieldType[iField] = eOGRFieldType;
+            abFieldSet[iField] = TRUE;
+            abFieldBoolean[iField] = bIsBoolean;
+            if (eOGRFieldType == OFTString && !bIsBoolean)
             {
-                int nFieldWidth = static_cast<int>(strlen(papszTokens[iField]));
-                if (papszTokens[iField][0] == '"' &&
-                    papszTokens[iField][nFieldWidth - 1] == '"')
-                {
-                    nFieldWidth -= 2;
-                }
-                int nFieldPrecision = 0;
-                if (eType == CPL_VALUE_REAL && bAutodetectWidthForIntOrReal)
-                {
-                    const char *pszDot = strchr(papszTokens[iField], '.');
-                    if (pszDot != nullptr)
-                        nFieldPrecision = static_cast<int>(strlen(pszDot + 1));
-                }
-
-                if (nFieldWidth > anFieldWidth[iField])
-                    anFieldWidth[iField] = nFieldWidth;
-                if (nFieldPrecision > anFieldPrecision[iField])
-                    anFieldPrecision[iField] = nFieldPrecision;
+                SetFinalStringType();
             }
-
-            OGRFieldType eOGRFieldType;
-            bool bIsBoolean = false;
-            if (eType == CPL_VALUE_INTEGER)
+        }
+        else if (aeFieldType[iField] != eOGRFieldType)
+        {
+            // Promotion rules.
+            if (aeFieldType[iField] == OFTInteger)
             {
-                GIntBig nVal = CPLAtoGIntBig(papszTokens[iField]);
-                if (!CPL_INT64_FITS_ON_INT32(nVal))
-                    eOGRFieldType = OFTInteger64;
+                if (eOGRFieldType == OFTInteger64 || eOGRFieldType == OFTReal)
+                    aeFieldType[iField] = eOGRFieldType;
                 else
-                    eOGRFieldType = OFTInteger;
-            }
-            else if (eType == CPL_VALUE_REAL ||
-                     EQUAL(papszTokens[iField], "inf") ||
-                     EQUAL(papszTokens[iField], "-inf") ||
-                     EQUAL(papszTokens[iField], "nan"))
-            {
-                eOGRFieldType = OFTReal;
+                {
+                    SetFinalStringType();
+                }
             }
-            else if (abFieldSet[iField] && aeFieldType[iField] == OFTString)
+            else if (aeFieldType[iField] == OFTInteger64)
             {
-                eOGRFieldType = OFTString;
-                if (abFieldBoolean[iField])
+                if (eOGRFieldType == OFTReal)
+                    aeFieldType[iField] = eOGRFieldType;
+                else if (eOGRFieldType != OFTInteger)
                 {
-                    abFieldBoolean[iField] =
-                        OGRCSVIsTrue(papszTokens[iField]) ||
-                        OGRCSVIsFalse(papszTokens[iField]);
+                    SetFinalStringType();
                 }
             }
-            else
+            else if (aeFieldType[iField] == OFTReal)
             {
-                OGRField sWrkField;
-                CPLPushErrorHandler(CPLQuietErrorHandler);
-                const bool bSuccess = CPL_TO_BOOL(
-                    OGRParseDate(papszTokens[iField], &sWrkField, 0));
-                CPLPopErrorHandler();
-                CPLErrorReset();
-                if (bSuccess)
+                if (eOGRFieldType != OFTInteger &&
+                    eOGRFieldType != OFTInteger64)
                 {
-                    const bool bHasDate =
-                        strchr(papszTokens[iField], '/') != nullptr ||
-                        strchr(papszTokens[iField], '-') != nullptr;
-                    const bool bHasTime =
-                        strchr(papszTokens[iField], ':') != nullptr;
-                    if (bHasDate && bHasTime)
-                        eOGRFieldType = OFTDateTime;
-                    else if (bHasDate)
-                        eOGRFieldType = OFTDate;
-                    else
-                        eOGRFieldType = OFTTime;
+                    SetFinalStringType();
                 }
+            }
+            else if (aeFieldType[iField] == OFTDate)
+            {
+                if (eOGRFieldType == OFTDateTime)
+                    aeFieldType[iField] = OFTDateTime;
                 else
                 {
-                    eOGRFieldType = OFTString;
-                    bIsBoolean = OGRCSVIsTrue(papszTokens[iField]) ||
-                                 OGRCSVIsFalse(papszTokens[iField]);
+                    SetFinalStringType();
                 }
             }
-
-            const auto SetFinalStringType = [&abFinalTypeStringSet,
-                                             &aeFieldType, &nStringFieldCount,
-                                             iField]()
+            else if (aeFieldType[iField] == OFTDateTime)
             {
-                if (!abFinalTypeStringSet[iField])
+                if (eOGRFieldType != OFTDate)
                 {
-                    aeFieldType[iField] = OFTString;
-                    abFinalTypeStringSet[iField] = true;
-                    nStringFieldCount++;
+                    SetFinalStringType();
                 }
-            };
+            }
+            else if (aeFieldType[iField] == OFTTime)
+            {
+                SetFinalStringType();
+            }
+        }
+        else if (!abFinalTypeStringSet[iField] && eOGRFieldType == OFTString &&
+                 !bIsBoolean)
+        {
+            SetFinalStringType();
+        }
+    };
 
-            if (!abFieldSet[iField])
+    // If all fields are String and we don't need to compute width,
+    // auto-detection can stop.
+    const auto AreAllFieldTypesFinal = [&nStringFieldCount, nFieldCount,
+                                        bAutodetectWidth]()
+    { return nStringFieldCount == nFieldCount && !bAutodetectWidth; };
+
+    // When reading a regular file, records are split by chunks, and the
+    // values of each chunk are classified by worker threads. Their types
+    // are then updated in file order. Situations that CSVScanRecord() does
+    // not handle are left to the sequential reading loop below.
+    const int nThreads = bStreaming ? 1 : GetCSVNumThreads();
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    bool bDone = false;
+    if (poJobQueue)
+    {
+        // Records are taken into account if they end before nBytes, as
+        // the sequential loop does. One extra byte is read to be able to
+        // identify an end of line at that position.
+        const vsi_l_offset nLimit =
+            nBytes == static_cast<vsi_l_offset>(-1) ? nBytes : nBytes + 1;
+        const size_t nMaxChunkSize = GetCSVChunkSize(1024 * 1024);
+        std::string osBuffer;
+        std::vector<OGRCSVRecord> asRecords;
+        std::vector<OGRCSVValueClass> asClasses;
+        vsi_l_offset nBufferOffset = VSIFTellL(fp);
+        bool bEOF = false;
+        while (true)
+        {
+            if (bEOF && osBuffer.empty())
             {
-                aeFieldType[iField] = eOGRFieldType;
-                abFieldSet[iField] = TRUE;
-                abFieldBoolean[iField] = bIsBoolean;
-                if (eOGRFieldType == OFTString && !bIsBoolean)
-                {
-                    SetFinalStringType();
-                }
+                bDone = true;
+                break;
             }
-            else if (aeFieldType[iField] != eOGRFieldType)
+
+            const vsi_l_offset nRemaining =
+                nLimit - (nBufferOffset + osBuffer.size());
+            bool bLimitReached = false;
+            if (!bEOF)
             {
-                // Promotion rules.
-                if (aeFieldType[iField] == OFTInteger)
-                {
-                    if (eOGRFieldType == OFTInteger64 ||
-                        eOGRFieldType == OFTReal)
-                        aeFieldType[iField] = eOGRFieldType;
-                    else
-                    {
-                        SetFinalStringType();
-                    }
-                }
-                else if (aeFieldType[iField] == OFTInteger64)
-                {
-                    if (eOGRFieldType == OFTReal)
-                        aeFieldType[iField] = eOGRFieldType;
-                    else if (eOGRFieldType != OFTInteger)
-                    {
-                        SetFinalStringType();
-                    }
-                }
-                else if (aeFieldType[iField] == OFTReal)
-                {
-                    if (eOGRFieldType != OFTInteger &&
-                        eOGRFieldType != OFTInteger64)
+                const size_t nChunkSize = static_cast<size_t>(
+                    std::min<vsi_l_offset>(nMaxChunkSize, nRemaining));
+                if (!CSVReadChunk(fp, nChunkSize, osBuffer, bEOF))
+                    break;
+                bLimitReached = nChunkSize < nMaxChunkSize && !bEOF;
+            }
+
+            asRecords.clear();
+            size_t nConsumed = 0;
+            const CSVScanStatus eStatus = CSVSplitRecords(
+                &osBuffer[0], osBuffer.size(), bEOF, szDelimiter[0],
+                m_nMaxLineSize, asRecords, nConsumed);
+
+            // Classify values
+            const size_t nRecords = asRecords.size();
+            asClasses.clear();
+            asClasses.resize(nRecords * nFieldCount);
+            std::vector<bool> abSkipField(nFieldCount);
+            std::vector<bool> abTestDate(nFieldCount);
+            for (int iField = 0; iField < nFieldCount; ++iField)
+            {
+                abSkipField[iField] = IsFieldTypeFinal(iField);
+                abTestDate[iField] = MustTestDate(iField);
+            }
+            const size_t nJobs =
+                std::min(static_cast<size_t>(nThreads), nRecords);
+            char *pszBuffer = &osBuffer[0];
+            for (size_t iJob = 0; iJob < nJobs; ++iJob)
+            {
+                const size_t iStart = nRecords * iJob / nJobs;
+                const size_t iEnd = nRecords * (iJob + 1) / nJobs;
+                poJobQueue->SubmitJob(
+                    [this, pszBuffer, nFieldCount, iStart, iEnd, &asRecords,
+                     &asClasses, &abSkipField, &abTestDate,
+                     bQuotedFieldAsString, bAutodetectWidth,
+                     bAutodetectWidthForIntOrReal]()
                     {
-                        SetFinalStringType();
-                    }
-                }
-                else if (aeFieldType[iField] == OFTDate)
+                        for (size_t i = iStart; i < iEnd; ++i)
+                        {
+                            const OGRCSVRecord &sRecord = asRecords[i];
+                            char *pszRecord = pszBuffer + sRecord.nStart;
+                            if (sRecord.bMultiLine)
+                                CSVNormalizeLineEndings(
+                                    pszRecord, pszBuffer + sRecord.nEnd);
+                            char **papszTokens =
+                                CSVSplitLine(pszRecord, szDelimiter,
+                                             bQuotedFieldAsString,
+                                             bMergeDelimiter);
+                            for (int iField = 0; iField < nFieldCount &&
+                                                 papszTokens[iField] != nullptr;
+                                 iField++)
+                            {
+                                if (papszTokens[iField][0] == 0 ||
+                                    abSkipField[iField])
+                                    continue;
+                                CSVClassifyValue(
+                                    papszTokens[iField], szDelimiter[0],
+                                    bAutodetectWidth,
+                                    bAutodetectWidthForIntOrReal,
+                                    abTestDate[iField],
+                                    asClasses[i * nFieldCount + iField]);
+                            }
+                            CSLDestroy(papszTokens);
+                        }
+                    });
+            }
+            poJobQueue->WaitCompletion();
+
+            // Update field types in file order
+            for (size_t i = 0; i < nRecords && !bDone; ++i)
+            {
+                if (nBufferOffset + asRecords[i].nNext > nBytes)
                 {
-                    if (eOGRFieldType == OFTDateTime)
-                        aeFieldType[iField] = OFTDateTime;
-                    else
-                    {
-                        SetFinalStringType();
-                    }
+                    bDone = true;
+                    break;
                 }
-                else if (aeFieldType[iField] == OFTDateTime)
+                for (int iField = 0; iField < nFieldCount; ++iField)
                 {
-                    if (eOGRFieldType != OFTDate)
-                    {
-                        SetFinalStringType();
-                    }
+                    const auto &sClass = asClasses[i * nFieldCount + iField];
+                    if (sClass.bSet && !IsFieldTypeFinal(iField))
+                        UpdateFieldType(iField, sClass);
                 }
-                else if (aeFieldType[iField] == OFTTime)
+                if (AreAllFieldTypesFinal())
                 {
-                    SetFinalStringType();
+                    CPLDebugOnly("CSV",
+                                 "AutodetectFieldTypes() stopped after "
+                                 "reading " CPL_FRMT_GUIB " bytes",
+                                 static_cast<GUIntBig>(nBufferOffset +
+                                                       asRecords[i].nNext));
+                    bDone = true;
                 }
             }
-            else if (!abFinalTypeStringSet[iField] &&
-                     eOGRFieldType == OFTString && !bIsBoolean)
+
+            osBuffer.erase(0, nConsumed);
+            nBufferOffset += nConsumed;
+
+            // The record crossing the size limit, if any, is left to the
+            // sequential loop, so that it emits the same errors.
+            if (bDone || bLimitReached ||
+                eStatus == CSVScanStatus::UNSUPPORTED)
+                break;
+        }
+        if (!bDone)
+            VSIFSeekL(fp, nBufferOffset, SEEK_SET);
+    }
+
+    while (!bDone && !fp->Eof() && !fp->Error())
+    {
+        char **papszTokens =
+            CSVReadParseLine3L(fp, m_nMaxLineSize, szDelimiter,
+                               true,  // bHonourStrings
+                               bQuotedFieldAsString, bMergeDelimiter,
+                               true  // bSkipBOM
+            );
+        // Can happen if we just reach EOF while trying to read new bytes.
+        if (papszTokens == nullptr)
+            break;
+
+        if (bStreaming)
+        {
+            // Ignore last line if it is truncated.
+            if (fp->Eof() && nRead == static_cast<size_t>(nRequested) &&
+                pszData[nRead - 1] != 13 && pszData[nRead - 1] != 10)
             {
-                SetFinalStringType();
+                CSLDestroy(papszTokens);
+                break;
             }
         }
+        else if (VSIFTellL(fp) > nBytes)
+        {
+            CSLDestroy(papszTokens);
+            break;
+        }
+
+        for (int iField = 0;
+             iField < nFieldCount && papszTokens[iField] != nullptr; iField++)
+        {
+            if (papszTokens[iField][0] == 0)
+                continue;
+            if (IsFieldTypeFinal(iField))
+                continue;
+            OGRCSVValueClass sClass;
+            CSVClassifyValue(papszTokens[iField], szDelimiter[0],
+                             bAutodetectWidth, bAutodetectWidthForIntOrReal,
+                             MustTestDate(iField), sClass);
+            UpdateFieldType(iField, sClass);
+        }
 
         CSLDestroy(papszTokens);
 
-        // If all fields are String and we don't need to compute width,
-        // just stop auto-detection now.
-        if (nStringFieldCount == nFieldCount && !bAutodetectWidth)
+        if (AreAllFieldTypesFinal())
         {
             CPLDebugOnly("CSV",
                          "AutodetectFieldTypes() stopped after "
@@ -1278,6 +1753,11 @@ void OGRCSVLayer::ResetReading()
     bNeedRewindBeforeRead = false;
 
     m_nNextFID = FID_INITIAL_VALUE;
+
+    m_apoParallelFeatures.clear();
+    m_osParallelBuffer.clear();
+    m_bParallelEOF = false;
+    m_bParallelReadingDisabled = false;
 }
 
 /************************************************************************/
@@ -1313,7 +1793,10 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
 {
     if (nFID < FID_INITIAL_VALUE || fpCSV == nullptr)
         return nullptr;
-    if (nFID < m_nNextFID || bNeedRewindBeforeRead)
+    // The file position is ahead of m_nNextFID when features have been
+    // read in advance by ReadFeaturesInParallel()
+    if (nFID < m_nNextFID || bNeedRewindBeforeRead ||
+        !m_apoParallelFeatures.empty() || !m_osParallelBuffer.empty())
         ResetReading();
     while (m_nNextFID < nFID)
     {
@@ -1323,7 +1806,7 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
         CSLDestroy(papszTokens);
         m_nNextFID++;
     }
-    return GetNextUnfilteredFeature();
+    return GetNextUnfilteredFeatureSequential();
 }
 
 /************************************************************************/
@@ -1332,6 +1815,31 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
 
 OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
 
+{
+    if (fpCSV == nullptr)
+        return nullptr;
+
+    if (m_apoParallelFeatures.empty() && CanReadInParallel())
+        ReadFeaturesInParallel();
+
+    if (!m_apoParallelFeatures.empty())
+    {
+        OGRFeature *poFeature = m_apoParallelFeatures.front().release();
+        m_apoParallelFeatures.pop_front();
+        m_nNextFID = poFeature->GetFID() + 1;
+        m_nFeaturesRead++;
+        return poFeature;
+    }
+
+    return GetNextUnfilteredFeatureSequential();
+}
+
+/************************************************************************/
+/*                 GetNextUnfilteredFeatureSequential()                 */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::GetNextUnfilteredFeatureSequential()
+
 {
     if (fpCSV == nullptr)
         return nullptr;
@@ -1341,6 +1849,34 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
     if (papszTokens == nullptr)
         return nullptr;
 
+    OGRFeature *poFeature = BuildFeatureFromTokens(papszTokens, m_nNextFID);
+
+    CSLDestroy(papszTokens);
+
+    if ((m_nNextFID % 100000) == 0)
+    {
+        CPLDebug("CSV", "FID = %" PRId64 ", file offset = %" PRIu64, m_nNextFID,
+                 static_cast<uint64_t>(fpCSV->Tell()));
+    }
+
+    m_nNextFID++;
+
+    m_nFeaturesRead++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                       BuildFeatureFromTokens()                       */
+/*                                                                      */
+/*      Must be safe to call concurrently from several threads, as      */
+/*      done by ReadFeaturesInParallel().                               */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::BuildFeatureFromTokens(char **papszTokens,
+                                                int64_t nFID)
+
+{
     // Create the OGR feature.
     OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
 
@@ -1447,29 +1983,27 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         const OGRFieldType eFieldType = poFieldDefn->GetType();
         const OGRFieldSubType eFieldSubType = poFieldDefn->GetSubType();
 
-        const auto WarnOnceBadValue = [this, poFieldDefn]()
+        const auto WarnOnceBadValue = [this, poFieldDefn, nFID]()
         {
-            if (!bWarningBadTypeOrWidth)
+            if (!bWarningBadTypeOrWidth.exchange(true))
             {
-                bWarningBadTypeOrWidth = true;
                 CPLError(CE_Warning, CPLE_AppDefined,
                          "Invalid value type found in record %" PRId64
                          " for field %s. "
                          "This warning will no longer be emitted",
-                         m_nNextFID, poFieldDefn->GetNameRef());
+                         nFID, poFieldDefn->GetNameRef());
             };
         };
 
-        const auto WarnTooLargeWidth = [this, poFieldDefn]()
+        const auto WarnTooLargeWidth = [this, poFieldDefn, nFID]()
         {
-            if (!bWarningBadTypeOrWidth)
+            if (!bWarningBadTypeOrWidth.exchange(true))
             {
-                bWarningBadTypeOrWidth = true;
                 CPLError(CE_Warning, CPLE_AppDefined,
                          "Value with a width greater than field width "
                          "found in record %" PRId64 " for field %s. "
                          "This warning will no longer be emitted",
-                         m_nNextFID, poFieldDefn->GetNameRef());
+                         nFID, poFieldDefn->GetNameRef());
             };
         };
 
@@ -1547,15 +2081,15 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                             pszDot != nullptr
                                 ? static_cast<int>(strlen(pszDot + 1))
                                 : 0;
-                        if (nPrecision > poFieldDefn->GetPrecision())
+                        if (nPrecision > poFieldDefn->GetPrecision() &&
+                            !bWarningBadTypeOrWidth.exchange(true))
                         {
-                            bWarningBadTypeOrWidth = true;
                             CPLError(CE_Warning, CPLE_AppDefined,
                                      "Value with a precision greater than "
                                      "field precision found in record %" PRId64
                                      " for field %s. "
                                      "This warning will no longer be emitted",
-                                     m_nNextFID, poFieldDefn->GetNameRef());
+                                     nFID, poFieldDefn->GetNameRef());
                         }
                     }
                 }
@@ -1715,20 +2249,156 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         }
     }
 
-    CSLDestroy(papszTokens);
+    // Translate the record id.
+    poFeature->SetFID(nFID);
 
-    if ((m_nNextFID % 100000) == 0)
+    return poFeature;
+}
+
+/************************************************************************/
+/*                         CanReadInParallel()                          */
+/************************************************************************/
+
+bool OGRCSVLayer::CanReadInParallel() const
+{
+    // Do not bother spawning threads for small files: the first features
+    // are always read sequentially.
+    constexpr int64_t MIN_FEATURES_READ_SEQUENTIALLY = 1000;
+
+    return !m_bParallelReadingDisabled && !bInWriteMode && !bIsEurostatTSV &&
+           bHonourStrings &&
+           m_nNextFID - FID_INITIAL_VALUE >= MIN_FEATURES_READ_SEQUENTIALLY;
+}
+
+/************************************************************************/
+/*                        StopParallelReading()                         */
+/************************************************************************/
+
+// Go back to sequential reading from the first record that has not been
+// parsed yet. Features already parsed remain in m_apoParallelFeatures.
+void OGRCSVLayer::StopParallelReading()
+{
+    if (!m_osParallelBuffer.empty())
+        VSIFSeekL(fpCSV, m_nParallelBufferOffset, SEEK_SET);
+    m_osParallelBuffer.clear();
+    m_bParallelEOF = false;
+    m_bParallelReadingDisabled = true;
+}
+
+/************************************************************************/
+/*                       ReadFeaturesInParallel()                       */
+/************************************************************************/
+
+// Read a chunk of the file, split it into records on the calling thread,
+// and parse the records into features using OGR_CSV_NUM_THREADS worker
+// threads. Features are appended to m_apoParallelFeatures in file order,
+// with the same FIDs as the sequential reader would have assigned.
+// The incomplete record at the end of the chunk, if any, is kept in
+// m_osParallelBuffer for the next call.
+bool OGRCSVLayer::ReadFeaturesInParallel()
+{
+    const int nThreads = GetCSVNumThreads();
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
     {
-        CPLDebug("CSV", "FID = %" PRId64 ", file offset = %" PRIu64, m_nNextFID,
-                 static_cast<uint64_t>(fpCSV->Tell()));
+        StopParallelReading();
+        return false;
     }
 
-    // Translate the record id.
-    poFeature->SetFID(m_nNextFID++);
+    const size_t nChunkSize = GetCSVChunkSize(4 * 1024 * 1024);
 
-    m_nFeaturesRead++;
+    while (m_apoParallelFeatures.empty())
+    {
+        if (m_bParallelEOF && m_osParallelBuffer.empty())
+            return false;
 
-    return poFeature;
+        if (!m_bParallelEOF)
+        {
+            if (m_osParallelBuffer.empty())
+                m_nParallelBufferOffset = VSIFTellL(fpCSV);
+            if (!CSVReadChunk(fpCSV, nChunkSize, m_osParallelBuffer,
+                              m_bParallelEOF))
+            {
+                StopParallelReading();
+                return false;
+            }
+        }
+
+        // Split the buffer into records. Empty lines are skipped without
+        // consuming a FID.
+        char *pszBuffer = &m_osParallelBuffer[0];
+        std::vector<OGRCSVRecord> asRecords;
+        size_t nPos = 0;
+        const CSVScanStatus eStatus = CSVSplitRecords(
+            pszBuffer, m_osParallelBuffer.size(), m_bParallelEOF,
+            szDelimiter[0], m_nMaxLineSize, asRecords, nPos);
+
+        // Parse them
+        if (!asRecords.empty())
+        {
+            const size_t nRecords = asRecords.size();
+            const size_t nJobs =
+                std::min(static_cast<size_t>(nThreads), nRecords);
+            const int64_t nFirstFID = m_nNextFID;
+            std::vector<std::unique_ptr<OGRFeature>> apoFeatures(nRecords);
+            std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+            for (size_t iJob = 0; iJob < nJobs; ++iJob)
+            {
+                const size_t iStart = nRecords * iJob / nJobs;
+                const size_t iEnd = nRecords * (iJob + 1) / nJobs;
+                poJobQueue->SubmitJob(
+                    [this, pszBuffer, &asRecords, &apoFeatures,
+                     &aoErrorAccumulators, iJob, iStart, iEnd, nFirstFID]()
+                    {
+                        auto oAccumulator =
+                            aoErrorAccumulators[iJob].InstallForCurrentScope();
+                        CPL_IGNORE_RET_VAL(oAccumulator);
+
+                        for (size_t i = iStart; i < iEnd; ++i)
+                        {
+                            const OGRCSVRecord &sRecord = asRecords[i];
+                            char *pszRecord = pszBuffer + sRecord.nStart;
+                            if (sRecord.bMultiLine)
+                                CSVNormalizeLineEndings(
+                                    pszRecord, pszBuffer + sRecord.nEnd);
+                            char **papszTokens = CSVSplitLine(
+                                pszRecord, szDelimiter,
+                                /* bKeepLeadingAndClosingQuotes = */ false,
+                                bMergeDelimiter);
+                            apoFeatures[i].reset(BuildFeatureFromTokens(
+                                papszTokens,
+                                nFirstFID + static_cast<int64_t>(i)));
+                            CSLDestroy(papszTokens);
+                        }
+                    });
+            }
+            poJobQueue->WaitCompletion();
+
+            // Errors are replayed in the order of the records
+            for (auto &oErrorAccumulator : aoErrorAccumulators)
+                oErrorAccumulator.ReplayErrors();
+
+            for (auto &poFeature : apoFeatures)
+                m_apoParallelFeatures.push_back(std::move(poFeature));
+        }
+
+        m_osParallelBuffer.erase(0, nPos);
+        m_nParallelBufferOffset += nPos;
+
+        if (eStatus == CSVScanStatus::UNSUPPORTED)
+        {
+            CPLDebug("CSV",
+                     "Switching to sequential reading at file offset %" PRIu64,
+                     static_cast<uint64_t>(m_nParallelBufferOffset));
+            StopParallelReading();
+            break;
+        }
+    }
+
+    return !m_apoParallelFeatures.empty();
 }
 
 /************************************************************************/
@@ -2596,6 +3266,36 @@ GIntBig OGRCSVLayer::GetFeatureCount(int bForce)
     else
     {
         nTotalFeatures = 0;
+
+        // Count records without tokenizing them. In situations where
+        // CSVReadParseLine3L() would emit an error, go on with it from that
+        // record.
+        if (bHonourStrings)
+        {
+            const size_t nChunkSize = GetCSVChunkSize(4 * 1024 * 1024);
+            std::string osBuffer;
+            std::vector<OGRCSVRecord> asRecords;
+            vsi_l_offset nBufferOffset = VSIFTellL(fpCSV);
+            bool bEOF = false;
+            while (!(bEOF && osBuffer.empty()))
+            {
+                if (!bEOF && !CSVReadChunk(fpCSV, nChunkSize, osBuffer, bEOF))
+                    break;
+                asRecords.clear();
+                size_t nConsumed = 0;
+                const CSVScanStatus eStatus =
+                    CSVSplitRecords(&osBuffer[0], osBuffer.size(), bEOF,
+                                    szDelimiter[0], m_nMaxLineSize, asRecords,
+                                    nConsumed);
+                nTotalFeatures += static_cast<GIntBig>(asRecords.size());
+                osBuffer.erase(0, nConsumed);
+                nBufferOffset += nConsumed;
+                if (eStatus == CSVScanStatus::UNSUPPORTED)
+                    break;
+            }
+            VSIFSeekL(fpCSV, nBufferOffset, SEEK_SET);
+        }
+
         while (true)
         {
             char **papszTokens = GetNextLineTokens();
@@ -30,7 +30,7 @@
 #pragma clang diagnostic pop
 #endif
 
-#include <deque>
+#include <functional>
 #include <limits>
 
 class OGRFlatGeobufDataset;
@@ -48,6 +48,7 @@ static constexpr uint32_t feature_max_buffer_size =
 struct FeatureItem : FlatGeobuf::Item
 {
     uint32_t size;
+    uint32_t hilbertValue;  // sort key, computed once the extent is known
     uint64_t offset;
 };
 
@@ -98,8 +99,13 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     // creation
     GDALDataset *m_poDS = nullptr;  // parent dataset to get metadata from it
     bool m_create = false;
-    std::deque<FeatureItem> m_featureItems;  // feature item description used to
-                                             // create spatial index
+    std::vector<FeatureItem>
+        m_featureItems{};  // feature item description used to create spatial
+                           // index, spilled to m_poFpItems when too large
+    FlatGeobuf::NodeItem m_featureItemsExtent = FlatGeobuf::NodeItem::create(0);
+    size_t m_maxFeatureItemsInRAM = 0;
+    VSILFILE *m_poFpItems = nullptr;        // spilled feature items
+    VSILFILE *m_poFpSortedItems = nullptr;  // feature items in Hilbert order
     bool m_bCreateSpatialIndexAtClose = true;
     bool m_bVerifyBuffers = true;
     VSILFILE *m_poFpWrite = nullptr;
@@ -130,6 +136,12 @@ class OGRFlatGeobufLayer final : public OGRLayer,
 
     // serialize
     bool CreateFinalFile();
+    bool spillFeatureItems();
+    bool sortFeatureItems(const FlatGeobuf::NodeItem &extent);
+    bool forEachSortedFeatureItem(
+        const std::function<bool(const FeatureItem *, size_t)> &func);
+    OGRErr writeFeature(const OGRGeometry *ogrGeometry,
+                        const std::vector<uint8_t> &properties);
     void writeHeader(VSILFILE *poFp, uint64_t featuresCount,
                      std::vector<double> *extentVector);
 
@@ -168,6 +180,9 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     virtual OGRErr CreateField(const OGRFieldDefn *poField,
                                int bApproxOK = true) override;
     virtual OGRErr ICreateFeature(OGRFeature *poFeature) override;
+    virtual bool WriteArrowBatch(const struct ArrowSchema *schema,
+                                 struct ArrowArray *array,
+                                 CSLConstList papszOptions = nullptr) override;
     virtual int TestCapability(const char *) override;
 
     virtual void ResetReading() override;
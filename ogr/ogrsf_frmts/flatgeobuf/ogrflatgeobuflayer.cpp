@@ -20,6 +20,7 @@
 #include "ograrrowarrayhelper.h"
 #include "ogrlayerarrow.h"
 #include "ogr_recordbatch.h"
+#include "gdal_thread_pool.h"
 
 #include "ogr_flatgeobuf.h"
 #include "cplerrors.h"
@@ -593,8 +594,6 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
     m_writeOffset = 0;
     m_indexNodeSize = 16;
 
-    size_t c;
-
     if (m_featuresCount >= std::numeric_limits<size_t>::max() / 8)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -602,51 +601,123 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
         return false;
     }
 
-    NodeItem extent = calcExtent(m_featureItems);
+    NodeItem extent = m_featureItemsExtent;
     auto extentVector = extent.toVector();
 
     writeHeader(m_poFp, m_featuresCount, &extentVector);
 
     CPLDebugOnly("FlatGeobuf", "Sorting items for Packed R-tree");
-    hilbertSort(m_featureItems);
-    CPLDebugOnly("FlatGeobuf", "Calc new feature offsets");
-    uint64_t featureOffset = 0;
-    for (auto &item : m_featureItems)
-    {
-        item.nodeItem.offset = featureOffset;
-        featureOffset += item.size;
-    }
+    if (!sortFeatureItems(extent))
+        return false;
+
     CPLDebugOnly("FlatGeobuf", "Creating Packed R-tree");
-    c = 0;
+    CPLDebugOnly("FlatGeobuf", "PackedRTree extent %f, %f, %f, %f",
+                 extentVector[0], extentVector[1], extentVector[2],
+                 extentVector[3]);
+    uint64_t c = 0;
     try
     {
-        const auto fillNodeItems = [this](NodeItem *dest)
+        // The tree is generated as FlatGeobuf::PackedRTree would do, except
+        // that only the non-leaf nodes are kept in memory: the leaf nodes
+        // are streamed from the sorted feature items.
+        const auto levelBounds = PackedRTree::generateLevelBounds(
+            m_featuresCount, m_indexNodeSize);
+        const uint64_t leafNodesOffset = levelBounds.front().first;
+        const uint64_t treeSize =
+            PackedRTree::size(m_featuresCount, m_indexNodeSize);
+
+        std::vector<NodeItem> nodes(static_cast<size_t>(leafNodesOffset));
+        const uint64_t parentsOffset = levelBounds[1].first;
+        uint64_t iItem = 0;
+        const bool bOK = forEachSortedFeatureItem(
+            [this, &nodes, &iItem, leafNodesOffset,
+             parentsOffset](const FeatureItem *items, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i, ++iItem)
+                {
+                    auto &parent = nodes[static_cast<size_t>(
+                        parentsOffset + iItem / m_indexNodeSize)];
+                    if ((iItem % m_indexNodeSize) == 0)
+                        parent = NodeItem::create(leafNodesOffset + iItem);
+                    parent.expand(items[i].nodeItem);
+                }
+                return true;
+            });
+        if (!bOK)
+            return false;
+        for (size_t i = 1; i + 1 < levelBounds.size(); i++)
         {
-            size_t i = 0;
-            for (const auto &featureItem : m_featureItems)
+            auto pos = levelBounds[i].first;
+            const auto end = levelBounds[i].second;
+            auto newpos = levelBounds[i + 1].first;
+            while (pos < end)
             {
-                dest[i] = featureItem.nodeItem;
-                ++i;
+                NodeItem node = NodeItem::create(pos);
+                for (uint32_t j = 0; j < m_indexNodeSize && pos < end; j++)
+                    node.expand(nodes[static_cast<size_t>(pos++)]);
+                nodes[static_cast<size_t>(newpos++)] = node;
             }
-        };
-        PackedRTree tree(fillNodeItems, m_featureItems.size(), extent);
-        CPLDebugOnly("FlatGeobuf", "PackedRTree extent %f, %f, %f, %f",
-                     extentVector[0], extentVector[1], extentVector[2],
-                     extentVector[3]);
-        tree.streamWrite([this, &c](uint8_t *data, size_t size)
-                         { c += VSIFWriteL(data, 1, size, m_poFp); });
+        }
+
+#if !CPL_IS_LSB
+        for (auto &node : nodes)
+        {
+            CPL_LSBPTR64(&node.minX);
+            CPL_LSBPTR64(&node.minY);
+            CPL_LSBPTR64(&node.maxX);
+            CPL_LSBPTR64(&node.maxY);
+            CPL_LSBPTR64(&node.offset);
+        }
+#endif
+        c += VSIFWriteL(nodes.data(), sizeof(NodeItem), nodes.size(),
+                        m_poFp) *
+             sizeof(NodeItem);
+        std::vector<NodeItem>().swap(nodes);
+
+        // Leaf nodes point to the offset of the features in the final file
+        uint64_t featureOffset = 0;
+        std::vector<NodeItem> leaves;
+        const bool bLeavesOK = forEachSortedFeatureItem(
+            [this, &c, &leaves, &featureOffset](const FeatureItem *items,
+                                                size_t count)
+            {
+                leaves.resize(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto &leaf = leaves[i];
+                    leaf = items[i].nodeItem;
+                    leaf.offset = featureOffset;
+                    featureOffset += items[i].size;
+#if !CPL_IS_LSB
+                    CPL_LSBPTR64(&leaf.minX);
+                    CPL_LSBPTR64(&leaf.minY);
+                    CPL_LSBPTR64(&leaf.maxX);
+                    CPL_LSBPTR64(&leaf.maxY);
+                    CPL_LSBPTR64(&leaf.offset);
+#endif
+                }
+                const size_t nWritten =
+                    VSIFWriteL(leaves.data(), sizeof(NodeItem), count, m_poFp);
+                c += nWritten * sizeof(NodeItem);
+                return nWritten == count;
+            });
+
+        if (!bLeavesOK || c != treeSize)
+        {
+            CPLErrorIO("writing spatial index");
+            return false;
+        }
     }
     catch (const std::exception &e)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Create: %s", e.what());
         return false;
     }
-    CPLDebugOnly("FlatGeobuf", "Wrote tree (%lu bytes)",
-                 static_cast<long unsigned int>(c));
+    CPLDebugOnly("FlatGeobuf", "Wrote tree (%" PRIu64 " bytes)", c);
     m_writeOffset += c;
 
-    CPLDebugOnly("FlatGeobuf", "Writing feature buffers at offset %lu",
-                 static_cast<long unsigned int>(m_writeOffset));
+    CPLDebugOnly("FlatGeobuf", "Writing feature buffers at offset %" PRIu64,
+                 m_writeOffset);
 
     c = 0;
 
@@ -668,7 +739,8 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
 
         struct BatchItem
         {
-            size_t featureIdx;  // index of m_featureItems[]
+            uint64_t offset;  // offset in the temporary file
+            uint32_t size;
             uint32_t offsetInBuffer;
         };
 
@@ -678,23 +750,20 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
         {
             // Sort by increasing source offset
             std::sort(batch.begin(), batch.end(),
-                      [this](const BatchItem &a, const BatchItem &b)
-                      {
-                          return m_featureItems[a.featureIdx].offset <
-                                 m_featureItems[b.featureIdx].offset;
-                      });
+                      [](const BatchItem &a, const BatchItem &b)
+                      { return a.offset < b.offset; });
 
             // Read source features
             for (const auto &batchItem : batch)
             {
-                const auto &item = m_featureItems[batchItem.featureIdx];
-                if (VSIFSeekL(m_poFpWrite, item.offset, SEEK_SET) == -1)
+                if (VSIFSeekL(m_poFpWrite, batchItem.offset, SEEK_SET) == -1)
                 {
                     CPLErrorIO("seeking to temp feature location");
                     return false;
                 }
                 if (VSIFReadL(m_featureBuf + batchItem.offsetInBuffer, 1,
-                              item.size, m_poFpWrite) != item.size)
+                              batchItem.size,
+                              m_poFpWrite) != batchItem.size)
                 {
                     CPLErrorIO("reading temp feature");
                     return false;
@@ -715,28 +784,35 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
             return true;
         };
 
-        for (size_t i = 0; i < m_featuresCount; i++)
-        {
-            const auto &featureItem = m_featureItems[i];
-            const auto featureSize = featureItem.size;
-
-            if (offsetInBuffer + featureSize > m_featureBufSize)
+        const bool bOK = forEachSortedFeatureItem(
+            [this, &batch, &offsetInBuffer, &flushBatch,
+             &c](const FeatureItem *items, size_t count)
             {
-                if (!flushBatch())
+                for (size_t i = 0; i < count; i++)
                 {
-                    return false;
-                }
-            }
+                    const auto &featureItem = items[i];
+                    const auto featureSize = featureItem.size;
 
-            BatchItem bachItem;
-            bachItem.offsetInBuffer = offsetInBuffer;
-            bachItem.featureIdx = i;
-            batch.emplace_back(bachItem);
-            offsetInBuffer += featureSize;
-            c += featureSize;
-        }
+                    if (offsetInBuffer + featureSize > m_featureBufSize)
+                    {
+                        if (!flushBatch())
+                        {
+                            return false;
+                        }
+                    }
 
-        if (!flushBatch())
+                    BatchItem batchItem;
+                    batchItem.offset = featureItem.offset;
+                    batchItem.size = featureSize;
+                    batchItem.offsetInBuffer = offsetInBuffer;
+                    batch.emplace_back(batchItem);
+                    offsetInBuffer += featureSize;
+                    c += featureSize;
+                }
+                return true;
+            });
+
+        if (!bOK || !flushBatch())
         {
             return false;
         }
@@ -747,40 +823,392 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
         if (err != OGRERR_NONE)
             return false;
 
-        for (const auto &featureItem : m_featureItems)
+        const bool bOK = forEachSortedFeatureItem(
+            [this, &c](const FeatureItem *items, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    const auto &featureItem = items[i];
+                    const auto featureSize = featureItem.size;
+
+                    if (VSIFSeekL(m_poFpWrite, featureItem.offset, SEEK_SET) ==
+                        -1)
+                    {
+                        CPLErrorIO("seeking to temp feature location");
+                        return false;
+                    }
+                    if (VSIFReadL(m_featureBuf, 1, featureSize,
+                                  m_poFpWrite) != featureSize)
+                    {
+                        CPLErrorIO("reading temp feature");
+                        return false;
+                    }
+                    if (VSIFWriteL(m_featureBuf, 1, featureSize, m_poFp) !=
+                        featureSize)
+                    {
+                        CPLErrorIO("writing feature");
+                        return false;
+                    }
+                    c += featureSize;
+                }
+                return true;
+            });
+        if (!bOK)
+            return false;
+    }
+
+    CPLDebugOnly("FlatGeobuf", "Wrote feature buffers (%" PRIu64 " bytes)", c);
+    m_writeOffset += c;
+
+    CPLDebugOnly("FlatGeobuf", "Now at offset %" PRIu64, m_writeOffset);
+
+    return true;
+}
+
+/************************************************************************/
+/*                      GetMaxFeatureItemsInRAM()                       */
+/************************************************************************/
+
+// Maximum number of feature items kept in RAM while creating a file with a
+// spatial index. Beyond that, items are spilled to a temporary file and
+// sorted with an external merge sort at closing time.
+static size_t GetMaxFeatureItemsInRAM()
+{
+    GIntBig nMaxRAM = 0;
+    const char *pszMaxRAM =
+        CPLGetConfigOption("OGR_FLATGEOBUF_SORT_MAX_RAM", nullptr);
+    if (pszMaxRAM == nullptr ||
+        CPLParseMemorySize(pszMaxRAM, &nMaxRAM, nullptr) != CE_None)
+    {
+        const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+        nMaxRAM = nUsableRAM > 0 ? nUsableRAM / 4 : 1024 * 1024 * 1024;
+    }
+    const uint64_t nMaxItems = std::min<uint64_t>(
+        std::max<GIntBig>(0, nMaxRAM) / sizeof(FeatureItem),
+        std::numeric_limits<size_t>::max() / sizeof(FeatureItem));
+    return std::max<size_t>(1, static_cast<size_t>(nMaxItems));
+}
+
+/************************************************************************/
+/*                        HilbertSortFeatureItems()                     */
+/************************************************************************/
+
+// Order of feature items in the file: decreasing Hilbert value, as done by
+// FlatGeobuf::hilbertSort(). Ties are broken by the offset of the feature in
+// the temporary file, i.e. its insertion order, so that the result does not
+// depend on how the items have been partitioned into runs.
+static bool CompareFeatureItems(const FeatureItem &a, const FeatureItem &b)
+{
+    if (a.hilbertValue != b.hilbertValue)
+        return a.hilbertValue > b.hilbertValue;
+    return a.offset < b.offset;
+}
+
+static void HilbertSortFeatureItems(FeatureItem *items, size_t count,
+                                    const NodeItem &extent)
+{
+    const double minX = extent.minX;
+    const double minY = extent.minY;
+    const double width = extent.width();
+    const double height = extent.height();
+    const auto sortRange =
+        [items, minX, minY, width, height](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            items[i].hilbertValue = hilbert(items[i].nodeItem, HILBERT_MAX,
+                                             minX, minY, width, height);
+        }
+        std::sort(items + begin, items + end, CompareFeatureItems);
+    };
+
+    // Sort runs in parallel, and then merge them pairwise
+    constexpr size_t MIN_ITEMS_PER_THREAD = 100 * 1000;
+    const size_t nThreads = std::min(
+        static_cast<size_t>(GDALGetNumThreads(
+            nullptr, nullptr, "OGR_FLATGEOBUF_NUM_THREADS",
+            std::min(4, CPLGetNumCPUs()))),
+        std::max<size_t>(1, count / MIN_ITEMS_PER_THREAD));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(static_cast<int>(nThreads))
+                     : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+    {
+        sortRange(0, count);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= nThreads; ++i)
+        bounds.push_back(static_cast<size_t>(static_cast<uint64_t>(count) *
+                                             i / nThreads));
+    for (size_t i = 0; i < nThreads; ++i)
+    {
+        const size_t begin = bounds[i];
+        const size_t end = bounds[i + 1];
+        poJobQueue->SubmitJob([&sortRange, begin, end]()
+                              { sortRange(begin, end); });
+    }
+    poJobQueue->WaitCompletion();
+
+    while (bounds.size() > 2)
+    {
+        std::vector<size_t> newBounds;
+        for (size_t i = 0; i + 2 < bounds.size(); i += 2)
         {
-            const auto featureSize = featureItem.size;
+            const size_t first = bounds[i];
+            const size_t middle = bounds[i + 1];
+            const size_t last = bounds[i + 2];
+            poJobQueue->SubmitJob(
+                [items, first, middle, last]()
+                {
+                    std::inplace_merge(items + first, items + middle,
+                                       items + last, CompareFeatureItems);
+                });
+            newBounds.push_back(first);
+        }
+        // Odd number of runs: the last one is carried over as it is
+        if (((bounds.size() - 1) % 2) == 1)
+            newBounds.push_back(bounds[bounds.size() - 2]);
+        newBounds.push_back(bounds.back());
+        poJobQueue->WaitCompletion();
+        bounds = std::move(newBounds);
+    }
+}
 
-            // CPLDebugOnly("FlatGeobuf", "featureItem.offset: %lu",
-            // static_cast<long unsigned int>(featureItem.offset));
-            // CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
-            if (VSIFSeekL(m_poFpWrite, featureItem.offset, SEEK_SET) == -1)
+/************************************************************************/
+/*                         spillFeatureItems()                          */
+/************************************************************************/
+
+bool OGRFlatGeobufLayer::spillFeatureItems()
+{
+    if (m_poFpItems == nullptr)
+    {
+        const std::string osItemsFile = m_osTempFile + "_items.tmp";
+        CPLDebug("FlatGeobuf", "Spilling feature items to %s",
+                 osItemsFile.c_str());
+        m_poFpItems = VSIFOpenL(osItemsFile.c_str(), "w+b");
+        if (m_poFpItems == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                     osItemsFile.c_str());
+            return false;
+        }
+        // Unlink it now to avoid stale temporary file if killing the process
+        // (only works on Unix)
+        VSIUnlink(osItemsFile.c_str());
+    }
+    const size_t count = m_featureItems.size();
+    if (count > 0 && VSIFWriteL(m_featureItems.data(), sizeof(FeatureItem),
+                                count, m_poFpItems) != count)
+    {
+        CPLErrorIO("writing temporary feature items");
+        return false;
+    }
+    m_featureItems.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                         sortFeatureItems()                           */
+/************************************************************************/
+
+// Sort feature items in Hilbert order. If they all fit in RAM, this is done
+// in place in m_featureItems. Otherwise, sorted runs of at most
+// m_maxFeatureItemsInRAM items are written to a temporary file, and then
+// merged into m_poFpSortedItems, so that memory usage stays bounded and all
+// temporary file accesses are sequential within a run.
+bool OGRFlatGeobufLayer::sortFeatureItems(const NodeItem &extent)
+{
+    if (m_poFpItems == nullptr)
+    {
+        HilbertSortFeatureItems(m_featureItems.data(), m_featureItems.size(),
+                                extent);
+        return true;
+    }
+
+    if (!spillFeatureItems())
+        return false;
+    std::vector<FeatureItem>().swap(m_featureItems);
+
+    const std::string osRunsFile = m_osTempFile + "_runs.tmp";
+    VSIVirtualHandleUniquePtr fpRuns(VSIFOpenL(osRunsFile.c_str(), "w+b"));
+    if (!fpRuns)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                 osRunsFile.c_str());
+        return false;
+    }
+    VSIUnlink(osRunsFile.c_str());
+
+    // Create sorted runs
+    const uint64_t nItems = m_featuresCount;
+    const size_t nMaxRunSize = m_maxFeatureItemsInRAM;
+    std::vector<uint64_t> runStarts;
+    {
+        std::vector<FeatureItem> items;
+        items.resize(static_cast<size_t>(
+            std::min<uint64_t>(nMaxRunSize, nItems)));
+        VSIFSeekL(m_poFpItems, 0, SEEK_SET);
+        for (uint64_t start = 0; start < nItems; start += nMaxRunSize)
+        {
+            const size_t count =
+                static_cast<size_t>(std::min<uint64_t>(nMaxRunSize,
+                                                       nItems - start));
+            if (VSIFReadL(items.data(), sizeof(FeatureItem), count,
+                          m_poFpItems) != count)
             {
-                CPLErrorIO("seeking to temp feature location");
+                CPLErrorIO("reading temporary feature items");
                 return false;
             }
-            if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFpWrite) !=
-                featureSize)
+            HilbertSortFeatureItems(items.data(), count, extent);
+            if (fpRuns->Write(items.data(), sizeof(FeatureItem), count) !=
+                count)
             {
-                CPLErrorIO("reading temp feature");
+                CPLErrorIO("writing temporary feature items");
                 return false;
             }
-            if (VSIFWriteL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
+            runStarts.push_back(start);
+        }
+        runStarts.push_back(nItems);
+    }
+    VSIFCloseL(m_poFpItems);
+    m_poFpItems = nullptr;
+
+    const size_t nRuns = runStarts.size() - 1;
+    CPLDebugOnly("FlatGeobuf", "Merging %d runs of sorted feature items",
+                 static_cast<int>(nRuns));
+
+    const std::string osSortedItemsFile = m_osTempFile + "_sorted.tmp";
+    m_poFpSortedItems = VSIFOpenL(osSortedItemsFile.c_str(), "w+b");
+    if (m_poFpSortedItems == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                 osSortedItemsFile.c_str());
+        return false;
+    }
+    VSIUnlink(osSortedItemsFile.c_str());
+
+    // k-way merge of the runs, with a read buffer per run and a write buffer
+    // sharing the RAM budget.
+    const size_t nBufferSize = std::max<size_t>(1, nMaxRunSize / (nRuns + 1));
+
+    struct Run
+    {
+        uint64_t next = 0;
+        uint64_t end = 0;
+        std::vector<FeatureItem> buffer{};
+        size_t pos = 0;
+    };
+
+    std::vector<Run> runs(nRuns);
+    const auto refill = [&fpRuns, nBufferSize](Run &run)
+    {
+        const size_t count = static_cast<size_t>(
+            std::min<uint64_t>(nBufferSize, run.end - run.next));
+        run.buffer.resize(count);
+        run.pos = 0;
+        if (fpRuns->Seek(run.next * sizeof(FeatureItem), SEEK_SET) != 0 ||
+            fpRuns->Read(run.buffer.data(), sizeof(FeatureItem), count) !=
+                count)
+        {
+            CPLErrorIO("reading temporary feature items");
+            return false;
+        }
+        run.next += count;
+        return true;
+    };
+
+    // Heap of run indices, whose top is the run with the next item in order
+    const auto heapCmp = [&runs](size_t a, size_t b)
+    {
+        return CompareFeatureItems(runs[b].buffer[runs[b].pos],
+                                   runs[a].buffer[runs[a].pos]);
+    };
+    std::vector<size_t> heap;
+    for (size_t i = 0; i < nRuns; ++i)
+    {
+        runs[i].next = runStarts[i];
+        runs[i].end = runStarts[i + 1];
+        if (!refill(runs[i]))
+            return false;
+        heap.push_back(i);
+    }
+    std::make_heap(heap.begin(), heap.end(), heapCmp);
+
+    std::vector<FeatureItem> output;
+    output.reserve(nBufferSize);
+    const auto flushOutput = [this, &output]()
+    {
+        if (VSIFWriteL(output.data(), sizeof(FeatureItem), output.size(),
+                       m_poFpSortedItems) != output.size())
+        {
+            CPLErrorIO("writing temporary feature items");
+            return false;
+        }
+        output.clear();
+        return true;
+    };
+
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), heapCmp);
+        auto &run = runs[heap.back()];
+        output.push_back(run.buffer[run.pos]);
+        if (output.size() == nBufferSize && !flushOutput())
+            return false;
+        ++run.pos;
+        if (run.pos == run.buffer.size())
+        {
+            if (run.next == run.end)
             {
-                CPLErrorIO("writing feature");
-                return false;
+                std::vector<FeatureItem>().swap(run.buffer);
+                heap.pop_back();
+                continue;
             }
-            c += featureSize;
+            if (!refill(run))
+                return false;
         }
+        std::push_heap(heap.begin(), heap.end(), heapCmp);
     }
 
-    CPLDebugOnly("FlatGeobuf", "Wrote feature buffers (%lu bytes)",
-                 static_cast<long unsigned int>(c));
-    m_writeOffset += c;
+    return flushOutput();
+}
 
-    CPLDebugOnly("FlatGeobuf", "Now at offset %lu",
-                 static_cast<long unsigned int>(m_writeOffset));
+/************************************************************************/
+/*                      forEachSortedFeatureItem()                      */
+/************************************************************************/
 
+// Call func() on consecutive chunks of the feature items in Hilbert order,
+// until it returns false.
+bool OGRFlatGeobufLayer::forEachSortedFeatureItem(
+    const std::function<bool(const FeatureItem *, size_t)> &func)
+{
+    if (m_poFpSortedItems == nullptr)
+    {
+        return m_featureItems.empty() ||
+               func(m_featureItems.data(), m_featureItems.size());
+    }
+
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+    std::vector<FeatureItem> items(static_cast<size_t>(std::min<uint64_t>(
+        std::min(CHUNK_SIZE, m_maxFeatureItemsInRAM), m_featuresCount)));
+    VSIFSeekL(m_poFpSortedItems, 0, SEEK_SET);
+    for (uint64_t start = 0; start < m_featuresCount; start += items.size())
+    {
+        const size_t count = static_cast<size_t>(
+            std::min<uint64_t>(items.size(), m_featuresCount - start));
+        if (VSIFReadL(items.data(), sizeof(FeatureItem), count,
+                      m_poFpSortedItems) != count)
+        {
+            CPLErrorIO("reading temporary feature items");
+            return false;
+        }
+        if (!func(items.data(), count))
+            return false;
+    }
     return true;
 }
 
@@ -826,9 +1254,29 @@ CPLErr OGRFlatGeobufLayer::Close()
         m_poFpWrite = nullptr;
     }
 
+    if (m_poFpItems)
+    {
+        VSIFCloseL(m_poFpItems);
+        m_poFpItems = nullptr;
+    }
+
+    if (m_poFpSortedItems)
+    {
+        VSIFCloseL(m_poFpSortedItems);
+        m_poFpSortedItems = nullptr;
+    }
+    std::vector<FeatureItem>().swap(m_featureItems);
+
     if (!m_osTempFile.empty())
     {
         VSIUnlink(m_osTempFile.c_str());
+        for (const char *pszSuffix : {"_items.tmp", "_runs.tmp", "_sorted.tmp"})
+        {
+            VSIStatBufL sStat;
+            const std::string osFile = m_osTempFile + pszSuffix;
+            if (VSIStatL(osFile.c_str(), &sStat) == 0)
+                VSIUnlink(osFile.c_str());
+        }
         m_osTempFile.clear();
     }
 
@@ -2081,8 +2529,6 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
     std::vector<uint8_t> &properties = m_writeProperties;
     properties.clear();
     properties.reserve(1024 * 4);
-    FlatBufferBuilder fbb;
-    fbb.TrackMinAlign(8);
 
     for (int i = 0; i < fieldCount; i++)
     {
@@ -2285,6 +2731,21 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
     // ogrGeometry->exportToWkt(&wkt);
     // CPLDebugOnly("FlatGeobuf", "poNewFeature as wkt: %s", wkt);
 #endif
+    return writeFeature(ogrGeometry, properties);
+}
+
+/************************************************************************/
+/*                           writeFeature()                             */
+/************************************************************************/
+
+// Serialize a feature from its geometry and its already encoded properties,
+// and write it to the output file.
+OGRErr OGRFlatGeobufLayer::writeFeature(const OGRGeometry *ogrGeometry,
+                                        const std::vector<uint8_t> &properties)
+{
+    FlatBufferBuilder fbb;
+    fbb.TrackMinAlign(8);
+
     if (m_bCreateSpatialIndexAtClose &&
         (ogrGeometry == nullptr || ogrGeometry->IsEmpty()))
     {
@@ -2371,6 +2832,8 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
             }
             CPLDebugOnly("FlatGeobuf", "Writing first feature at offset: %lu",
                          static_cast<long unsigned int>(m_writeOffset));
+            if (m_bCreateSpatialIndexAtClose)
+                m_maxFeatureItemsInRAM = GetMaxFeatureItemsInRAM();
         }
 
         m_maxFeatureSize =
@@ -2383,10 +2846,17 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
         {
             FeatureItem item;
             item.size = static_cast<uint32_t>(fbb.GetSize());
+            item.hilbertValue = 0;
             item.offset = m_writeOffset;
             item.nodeItem = {psEnvelope.MinX, psEnvelope.MinY, psEnvelope.MaxX,
                              psEnvelope.MaxY, 0};
+            m_featureItemsExtent.expand(item.nodeItem);
             m_featureItems.emplace_back(std::move(item));
+            if (m_featureItems.size() >= m_maxFeatureItemsInRAM &&
+                !spillFeatureItems())
+            {
+                return OGRERR_FAILURE;
+            }
         }
         m_writeOffset += c;
 
@@ -2402,6 +2872,216 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
     }
 }
 
+/************************************************************************/
+/*                           AppendLE()                                 */
+/************************************************************************/
+
+template <class T>
+static inline void AppendLE(std::vector<uint8_t> &properties, T val)
+{
+    const auto *pabyVal = reinterpret_cast<const uint8_t *>(&val);
+    const size_t nOldSize = properties.size();
+    properties.insert(properties.end(), pabyVal, pabyVal + sizeof(val));
+#if !CPL_IS_LSB
+    std::reverse(properties.begin() + nOldSize, properties.end());
+#else
+    CPL_IGNORE_RET_VAL(nOldSize);
+#endif
+}
+
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+// Native implementation that encodes the properties directly from the Arrow
+// buffers, without going through OGRFeature. Falls back to the generic
+// implementation for Arrow types that do not map exactly to the OGR field
+// types of the layer.
+bool OGRFlatGeobufLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                         struct ArrowArray *array,
+                                         CSLConstList papszOptions)
+{
+    if (!m_create)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "WriteArrowBatch() not supported on read-only layer");
+        return false;
+    }
+
+    OGRArrowArrayReaderHelper oReader(this, schema, array, papszOptions);
+    if (!oReader.IsCompatible() ||
+        CPLTestBool(CPLGetConfigOption("OGR_FLATGEOBUF_WRITE_ARROW_BASE_IMPL",
+                                       "NO")))
+    {
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+    }
+
+    const int fieldCount = m_poFeatureDefn->GetFieldCount();
+    std::vector<uint8_t> &properties = m_writeProperties;
+    properties.reserve(1024 * 4);
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    try
+    {
+        const size_t nLength = oReader.GetLength();
+        for (size_t iRow = 0; iRow < nLength; ++iRow)
+        {
+            properties.clear();
+            for (int i = 0; i < fieldCount; ++i)
+            {
+                const auto psCol = oReader.GetColumnForOGRField(i);
+                if (psCol == nullptr ||
+                    OGRArrowArrayReaderHelper::IsNull(*psCol, iRow))
+                {
+                    continue;
+                }
+
+                AppendLE(properties, static_cast<uint16_t>(i));
+
+                const auto fieldDef = m_poFeatureDefn->GetFieldDefn(i);
+                const auto fieldSubType = fieldDef->GetSubType();
+                switch (fieldDef->GetType())
+                {
+                    case OFTInteger:
+                    {
+                        const int nVal = static_cast<int>(
+                            OGRArrowArrayReaderHelper::GetInteger(*psCol,
+                                                                  iRow));
+                        if (fieldSubType == OFSTBoolean)
+                            properties.push_back(static_cast<GByte>(nVal));
+                        else if (fieldSubType == OFSTInt16)
+                            AppendLE(properties, static_cast<int16_t>(nVal));
+                        else
+                            AppendLE(properties, static_cast<int32_t>(nVal));
+                        break;
+                    }
+
+                    case OFTInteger64:
+                    {
+                        AppendLE(properties,
+                                 static_cast<int64_t>(
+                                     OGRArrowArrayReaderHelper::GetInteger(
+                                         *psCol, iRow)));
+                        break;
+                    }
+
+                    case OFTReal:
+                    {
+                        const double dfVal =
+                            OGRArrowArrayReaderHelper::GetReal(*psCol, iRow);
+                        if (fieldSubType == OFSTFloat32)
+                            AppendLE(properties, static_cast<float>(dfVal));
+                        else
+                            AppendLE(properties, dfVal);
+                        break;
+                    }
+
+                    case OFTDate:
+                    {
+                        CPLUnixTimeToYMDHMS(
+                            OGRArrowArrayReaderHelper::GetInteger(*psCol,
+                                                                  iRow) *
+                                86400,
+                            &brokenDown);
+                        OGRField sField;
+                        sField.Date.Year =
+                            static_cast<GInt16>(brokenDown.tm_year + 1900);
+                        sField.Date.Month =
+                            static_cast<GByte>(brokenDown.tm_mon + 1);
+                        sField.Date.Day =
+                            static_cast<GByte>(brokenDown.tm_mday);
+                        sField.Date.Hour = 0;
+                        sField.Date.Minute = 0;
+                        sField.Date.Second = 0;
+                        sField.Date.TZFlag = 0;
+                        char szBuffer[OGR_SIZEOF_ISO8601_DATETIME_BUFFER];
+                        const size_t len = OGRGetISO8601DateTime(
+                            &sField, false, szBuffer);
+                        AppendLE(properties, static_cast<uint32_t>(len));
+                        properties.insert(properties.end(), szBuffer,
+                                          szBuffer + len);
+                        break;
+                    }
+
+                    case OFTString:
+                    case OFTBinary:
+                    {
+                        size_t len = 0;
+                        const GByte *pabyData =
+                            OGRArrowArrayReaderHelper::GetBytes(*psCol, iRow,
+                                                                len);
+                        if (len >= feature_max_buffer_size ||
+                            properties.size() > feature_max_buffer_size - len)
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "WriteArrowBatch: %s too long",
+                                     fieldDef->GetType() == OFTString
+                                         ? "String"
+                                         : "Binary");
+                            return false;
+                        }
+                        if (fieldDef->GetType() == OFTString &&
+                            !CPLIsUTF8(reinterpret_cast<const char *>(pabyData),
+                                       static_cast<int>(len)))
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "WriteArrowBatch: String '%s' is not a "
+                                     "valid UTF-8 string",
+                                     std::string(reinterpret_cast<const char *>(
+                                                     pabyData),
+                                                 len)
+                                         .c_str());
+                            return false;
+                        }
+                        AppendLE(properties, static_cast<uint32_t>(len));
+                        properties.insert(properties.end(), pabyData,
+                                          pabyData + len);
+                        break;
+                    }
+
+                    default:
+                        CPLAssert(false);
+                        break;
+                }
+            }
+
+            std::unique_ptr<OGRGeometry> poGeom;
+            size_t nWKBSize = 0;
+            const GByte *pabyWKB = oReader.GetWKB(iRow, nWKBSize);
+            if (pabyWKB)
+            {
+                OGRGeometry *poGeomPtr = nullptr;
+                if (OGRGeometryFactory::createFromWkb(
+                        pabyWKB, nullptr, &poGeomPtr, nWKBSize) != OGRERR_NONE)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "WriteArrowBatch: invalid WKB geometry");
+                    return false;
+                }
+                poGeom.reset(poGeomPtr);
+            }
+
+            const GIntBig nInputFID = oReader.GetFID(iRow);
+            const GIntBig nFID = static_cast<GIntBig>(m_featuresCount);
+            if (writeFeature(poGeom.get(), properties) != OGRERR_NONE ||
+                !oReader.SetOutputFID(iRow, nInputFID, nFID))
+            {
+                return false;
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "WriteArrowBatch: Memory allocation failure");
+        return false;
+    }
+
+    oReader.Finalize();
+    return true;
+}
+
 OGRErr OGRFlatGeobufLayer::IGetExtent(int iGeomField, OGREnvelope *psExtent,
                                       bool bForce)
 {
@@ -2440,6 +3120,8 @@ int OGRFlatGeobufLayer::TestCapability(const char *pszCap)
         return true;
     else if (EQUAL(pszCap, OLCFastGetArrowStream))
         return true;
+    else if (EQUAL(pszCap, OLCFastWriteArrowBatch))
+        return m_create;
     else
         return false;
 }
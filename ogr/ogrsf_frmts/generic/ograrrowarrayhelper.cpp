@@ -12,6 +12,7 @@
 
 #include "ograrrowarrayhelper.h"
 #include "ogrlayerarrow.h"
+#include "ogrlayer_private.h"
 #include "ogr_p.h"
 
 #include <limits>
@@ -464,4 +465,225 @@ bool OGRArrowArrayHelper::FillDict(struct ArrowArray *psChild,
     return true;
 }
 
+/************************************************************************/
+/*                      OGRArrowArrayReaderHelper()                     */
+/************************************************************************/
+
+OGRArrowArrayReaderHelper::OGRArrowArrayReaderHelper(
+    OGRLayer *poLayer, const struct ArrowSchema *schema,
+    struct ArrowArray *array, CSLConstList papszOptions)
+{
+    const char *format = schema->format;
+    if (!(format[0] == '+' && format[1] == 's' && format[2] == 0) ||
+        schema->n_children != array->n_children || array->offset != 0)
+    {
+        return;
+    }
+    m_nLength = static_cast<size_t>(array->length);
+
+    const OGRFeatureDefn *poFeatureDefn = poLayer->GetLayerDefn();
+    m_anMapOGRFieldToColumn.resize(poFeatureDefn->GetFieldCount(), -1);
+
+    const char *pszFIDName =
+        CSLFetchNameValueDef(papszOptions, "FID", poLayer->GetFIDColumn());
+    if (!pszFIDName || pszFIDName[0] == 0)
+        pszFIDName = OGRLayer::DEFAULT_ARROW_FID_NAME;
+    const char *pszGeomFieldName = CSLFetchNameValueDef(
+        papszOptions, "GEOMETRY_NAME", poLayer->GetGeometryColumn());
+    if (!pszGeomFieldName || pszGeomFieldName[0] == 0)
+        pszGeomFieldName = OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME;
+    const char *pszIfFIDNotPreserved =
+        CSLFetchNameValueDef(papszOptions, "IF_FID_NOT_PRESERVED", "");
+    m_bErrorIfFIDNotPreserved = EQUAL(pszIfFIDNotPreserved, "ERROR");
+    m_bWarningIfFIDNotPreserved = EQUAL(pszIfFIDNotPreserved, "WARNING");
+
+    const auto &oMapArrowFieldNameToOGRFieldName =
+        poLayer->m_poPrivate->m_oMapArrowFieldNameToOGRFieldName;
+
+    for (int64_t i = 0; i < schema->n_children; ++i)
+    {
+        const struct ArrowSchema *psChildSchema = schema->children[i];
+        struct ArrowArray *psChildArray = array->children[i];
+        const char *pszName = psChildSchema->name;
+        const char *pszFormat = psChildSchema->format;
+        if (psChildSchema->dictionary || psChildArray->dictionary ||
+            pszName == nullptr)
+        {
+            return;
+        }
+        const bool bIsBinary = (pszFormat[0] == 'z' || pszFormat[0] == 'Z') &&
+                               pszFormat[1] == 0;
+
+        if (strcmp(pszName, pszFIDName) == 0)
+        {
+            if (strcmp(pszFormat, "i") != 0 && strcmp(pszFormat, "l") != 0)
+                return;
+            m_psFIDArray = psChildArray;
+            m_bFIDIsInt64 = pszFormat[0] == 'l';
+            continue;
+        }
+
+        std::string osOGRFieldName(pszName);
+        const auto oIter = oMapArrowFieldNameToOGRFieldName.find(pszName);
+        if (oIter != oMapArrowFieldNameToOGRFieldName.end())
+            osOGRFieldName = oIter->second;
+        const int iOGRField =
+            poFeatureDefn->GetFieldIndex(osOGRFieldName.c_str());
+        if (iOGRField < 0)
+        {
+            if (!bIsBinary || m_psGeomArray != nullptr ||
+                poFeatureDefn->GetGeomFieldCount() != 1)
+            {
+                return;
+            }
+            bool bIsGeom =
+                strcmp(pszName, pszGeomFieldName) == 0 ||
+                poFeatureDefn->GetGeomFieldIndex(osOGRFieldName.c_str()) == 0;
+            if (!bIsGeom && psChildSchema->metadata)
+            {
+                const auto oMetadata =
+                    OGRParseArrowMetadata(psChildSchema->metadata);
+                const auto oIterExt = oMetadata.find(ARROW_EXTENSION_NAME_KEY);
+                bIsGeom = oIterExt != oMetadata.end() &&
+                          (oIterExt->second == EXTENSION_NAME_OGC_WKB ||
+                           oIterExt->second == EXTENSION_NAME_GEOARROW_WKB);
+            }
+            if (!bIsGeom)
+                return;
+            m_psGeomArray = psChildArray;
+            m_bGeomLarge = pszFormat[0] == 'Z';
+            continue;
+        }
+
+        Column sCol;
+        sCol.psArray = psChildArray;
+        bool bTypeOK = false;
+        switch (poFeatureDefn->GetFieldDefn(iOGRField)->GetType())
+        {
+            case OFTInteger:
+            case OFTInteger64:
+                bTypeOK =
+                    pszFormat[1] == 0 &&
+                    (pszFormat[0] == 'b' || pszFormat[0] == 's' ||
+                     pszFormat[0] == 'i' ||
+                     (pszFormat[0] == 'l' &&
+                      poFeatureDefn->GetFieldDefn(iOGRField)->GetType() ==
+                          OFTInteger64));
+                sCol.chFormat = pszFormat[0];
+                break;
+            case OFTReal:
+                bTypeOK = pszFormat[1] == 0 &&
+                          (pszFormat[0] == 'f' || pszFormat[0] == 'g');
+                sCol.chFormat = pszFormat[0];
+                break;
+            case OFTString:
+                bTypeOK = pszFormat[1] == 0 &&
+                          (pszFormat[0] == 'u' || pszFormat[0] == 'U');
+                sCol.chFormat = 'u';
+                sCol.bLarge = pszFormat[0] == 'U';
+                break;
+            case OFTBinary:
+                bTypeOK = bIsBinary;
+                sCol.chFormat = 'z';
+                sCol.bLarge = pszFormat[0] == 'Z';
+                break;
+            case OFTDate:
+                bTypeOK = strcmp(pszFormat, "tdD") == 0;
+                sCol.chFormat = 'D';
+                break;
+            default:
+                break;
+        }
+        if (!bTypeOK || m_anMapOGRFieldToColumn[iOGRField] >= 0)
+            return;
+        m_anMapOGRFieldToColumn[iOGRField] =
+            static_cast<int>(m_asColumns.size());
+        m_asColumns.push_back(sCol);
+    }
+
+    m_bCompatible = true;
+}
+
+/************************************************************************/
+/*                               GetFID()                               */
+/************************************************************************/
+
+GIntBig OGRArrowArrayReaderHelper::GetFID(size_t iRow) const
+{
+    if (m_psFIDArray == nullptr || IsNull(m_psFIDArray, iRow))
+        return OGRNullFID;
+    const size_t nIdx = iRow + static_cast<size_t>(m_psFIDArray->offset);
+    if (m_bFIDIsInt64)
+        return static_cast<const int64_t *>(m_psFIDArray->buffers[1])[nIdx];
+    return static_cast<const int32_t *>(m_psFIDArray->buffers[1])[nIdx];
+}
+
+/************************************************************************/
+/*                            SetOutputFID()                            */
+/************************************************************************/
+
+// Same logic as in OGRLayer::WriteArrowBatch()
+bool OGRArrowArrayReaderHelper::SetOutputFID(size_t iRow, GIntBig nInputFID,
+                                             GIntBig nOutputFID)
+{
+    if (nInputFID != OGRNullFID && nOutputFID != nInputFID)
+    {
+        if (m_bWarningIfFIDNotPreserved)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Feature id " CPL_FRMT_GIB " not preserved", nInputFID);
+        }
+        else if (m_bErrorIfFIDNotPreserved)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Feature id " CPL_FRMT_GIB " not preserved", nInputFID);
+            return false;
+        }
+    }
+
+    if (m_psFIDArray)
+    {
+        const size_t nIdx = iRow + static_cast<size_t>(m_psFIDArray->offset);
+        uint8_t *pabyValidity = static_cast<uint8_t *>(
+            const_cast<void *>(m_psFIDArray->buffers[0]));
+        if (!m_bFIDIsInt64 && nOutputFID > std::numeric_limits<int32_t>::max())
+        {
+            if (pabyValidity)
+            {
+                ++m_nFIDNullCount;
+                pabyValidity[nIdx / 8] &=
+                    static_cast<uint8_t>(~(1 << (nIdx % 8)));
+            }
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "FID " CPL_FRMT_GIB
+                     " cannot be stored in FID array of type int32",
+                     nOutputFID);
+        }
+        else
+        {
+            if (pabyValidity)
+                pabyValidity[nIdx / 8] |= static_cast<uint8_t>(1 << (nIdx % 8));
+            if (m_bFIDIsInt64)
+                static_cast<int64_t *>(
+                    const_cast<void *>(m_psFIDArray->buffers[1]))[nIdx] =
+                    nOutputFID;
+            else
+                static_cast<int32_t *>(
+                    const_cast<void *>(m_psFIDArray->buffers[1]))[nIdx] =
+                    static_cast<int32_t>(nOutputFID);
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+void OGRArrowArrayReaderHelper::Finalize()
+{
+    if (m_psFIDArray && m_psFIDArray->buffers[0])
+        m_psFIDArray->null_count = m_nFIDNullCount;
+}
+
 //! @endcond
@@ -262,4 +262,162 @@ class CPL_DLL OGRArrowArrayHelper
                          const OGRCodedFieldDomain *poCodedDomain);
 };
 
+/** Helper to read the content of an ArrowArray passed to WriteArrowBatch(),
+ * for drivers implementing a native WriteArrowBatch() that directly
+ * encodes Arrow buffers, without going through OGRFeature.
+ *
+ * Only a subset of the Arrow types is handled: those that map exactly to the
+ * OGR type of the target field. IsCompatible() returns false in other
+ * situations, in which case the caller should fall back to
+ * OGRLayer::WriteArrowBatch().
+ */
+class CPL_DLL OGRArrowArrayReaderHelper
+{
+    OGRArrowArrayReaderHelper(const OGRArrowArrayReaderHelper &) = delete;
+    OGRArrowArrayReaderHelper &
+    operator=(const OGRArrowArrayReaderHelper &) = delete;
+
+  public:
+    struct Column
+    {
+        const struct ArrowArray *psArray = nullptr;
+        char chFormat = 0;  // Arrow format letter. 'D' for date32
+        bool bLarge = false;
+    };
+
+    OGRArrowArrayReaderHelper(OGRLayer *poLayer,
+                              const struct ArrowSchema *schema,
+                              struct ArrowArray *array,
+                              CSLConstList papszOptions);
+
+    bool IsCompatible() const
+    {
+        return m_bCompatible;
+    }
+
+    size_t GetLength() const
+    {
+        return m_nLength;
+    }
+
+    //! Returns the Column corresponding to an OGR field, or nullptr
+    const Column *GetColumnForOGRField(int iOGRField) const
+    {
+        const int iCol = m_anMapOGRFieldToColumn[iOGRField];
+        return iCol >= 0 ? &m_asColumns[iCol] : nullptr;
+    }
+
+    bool HasGeometryColumn() const
+    {
+        return m_psGeomArray != nullptr;
+    }
+
+    bool HasFIDColumn() const
+    {
+        return m_psFIDArray != nullptr;
+    }
+
+    static bool IsNull(const struct ArrowArray *psArray, size_t iRow)
+    {
+        if (psArray->null_count == 0 || psArray->buffers[0] == nullptr)
+            return false;
+        const size_t nIdx = iRow + static_cast<size_t>(psArray->offset);
+        return (static_cast<const uint8_t *>(psArray->buffers[0])[nIdx / 8] &
+                (1 << (nIdx % 8))) == 0;
+    }
+
+    static bool IsNull(const Column &sCol, size_t iRow)
+    {
+        return IsNull(sCol.psArray, iRow);
+    }
+
+    static int64_t GetInteger(const Column &sCol, size_t iRow)
+    {
+        const size_t nIdx = iRow + static_cast<size_t>(sCol.psArray->offset);
+        const void *pData = sCol.psArray->buffers[1];
+        switch (sCol.chFormat)
+        {
+            case 'b':
+                return (static_cast<const uint8_t *>(pData)[nIdx / 8] &
+                        (1 << (nIdx % 8))) != 0;
+            case 's':
+                return static_cast<const int16_t *>(pData)[nIdx];
+            case 'i':
+            case 'D':
+                return static_cast<const int32_t *>(pData)[nIdx];
+            default:
+                return static_cast<const int64_t *>(pData)[nIdx];
+        }
+    }
+
+    static double GetReal(const Column &sCol, size_t iRow)
+    {
+        const size_t nIdx = iRow + static_cast<size_t>(sCol.psArray->offset);
+        if (sCol.chFormat == 'f')
+            return static_cast<const float *>(sCol.psArray->buffers[1])[nIdx];
+        return static_cast<const double *>(sCol.psArray->buffers[1])[nIdx];
+    }
+
+    //! Returns a pointer to the content of a string or binary value
+    static const GByte *GetBytes(const struct ArrowArray *psArray, bool bLarge,
+                                 size_t iRow, size_t &nLen)
+    {
+        const size_t nIdx = iRow + static_cast<size_t>(psArray->offset);
+        size_t nStart;
+        if (bLarge)
+        {
+            const auto panOffsets =
+                static_cast<const int64_t *>(psArray->buffers[1]);
+            nStart = static_cast<size_t>(panOffsets[nIdx]);
+            nLen = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+        }
+        else
+        {
+            const auto panOffsets =
+                static_cast<const int32_t *>(psArray->buffers[1]);
+            nStart = static_cast<size_t>(panOffsets[nIdx]);
+            nLen = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+        }
+        return static_cast<const GByte *>(psArray->buffers[2]) + nStart;
+    }
+
+    static const GByte *GetBytes(const Column &sCol, size_t iRow, size_t &nLen)
+    {
+        return GetBytes(sCol.psArray, sCol.bLarge, iRow, nLen);
+    }
+
+    //! Returns the WKB geometry of a row, or nullptr if it is null.
+    const GByte *GetWKB(size_t iRow, size_t &nLen) const
+    {
+        if (m_psGeomArray == nullptr || IsNull(m_psGeomArray, iRow))
+        {
+            nLen = 0;
+            return nullptr;
+        }
+        return GetBytes(m_psGeomArray, m_bGeomLarge, iRow, nLen);
+    }
+
+    //! Returns the input FID of a row, or OGRNullFID
+    GIntBig GetFID(size_t iRow) const;
+
+    //! Store back the FID assigned to a row in the FID column, if any.
+    bool SetOutputFID(size_t iRow, GIntBig nInputFID, GIntBig nOutputFID);
+
+    //! Must be called once all rows have been processed.
+    void Finalize();
+
+  private:
+    bool m_bCompatible = false;
+    size_t m_nLength = 0;
+    std::vector<Column> m_asColumns{};
+    std::vector<int> m_anMapOGRFieldToColumn{};
+    const struct ArrowArray *m_psGeomArray = nullptr;
+    bool m_bGeomLarge = false;
+    struct ArrowArray *m_psFIDArray = nullptr;
+    bool m_bFIDIsInt64 = false;
+    int64_t m_nFIDNullCount = 0;
+    bool m_bErrorIfFIDNotPreserved = false;
+    bool m_bWarningIfFIDNotPreserved = false;
+};
+
 //! @endcond
@@ -19,6 +19,8 @@
 #include "memdataset.h"
 
 #include <cstdio>
+#include <memory>
+#include <string>
 #include <vector>  // Used by OGRGeoJSONLayer.
 #include "ogrgeojsonutils.h"
 #include "ogrgeojsonwriter.h"
@@ -227,9 +229,34 @@ class OGRGeoJSONWriteLayer final : public OGRLayer
     OGRGeometryFactory::TransformWithOptionsCache oTransformCache_;
     OGRGeoJSONWriteOptions oWriteOptions_;
 
+    /** Feature queued for serialization by a worker thread. */
+    struct PendingFeature
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        /** Geometry before reprojection, only set when needed by
+         * RepairGeometryForPrecision() */
+        std::unique_ptr<OGRGeometry> poOrigGeom{};
+        std::string osJSON{};
+        OGREnvelope3D sEnvelope{};
+        bool bHasEnvelope = false;
+        bool b3D = false;
+    };
+
+    const int m_nNumThreads;
+    std::vector<PendingFeature> m_aoPendingFeatures{};
+
     CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONWriteLayer)
 
     void FinishWriting();
+    bool MightNeedGeometryRepair(const OGRGeometry *poOrigGeom) const;
+    std::unique_ptr<OGRGeometry>
+    RepairGeometryForPrecision(OGRGeometry *poOrigGeom,
+                               const OGRGeometry *poGeomToWrite,
+                               bool bGeomTransformed) const;
+    void EncodePendingFeature(PendingFeature &oPending) const;
+    OGRErr WriteSerializedFeature(const char *pszJson, size_t nLen);
+    void MergeEnvelope(const OGREnvelope3D &sEnvelope, bool b3D);
+    OGRErr FlushPendingFeatures();
 };
 
 /************************************************************************/
@@ -18,8 +18,14 @@
 #include "ogrlibjsonutils.h"
 #include "ogrjsoncollectionstreamingparser.h"
 #include "ogr_api.h"
+#include "cpl_error_internal.h"
+#include "gdal_thread_pool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cmath>
+#include <deque>
 #include <limits>
 #include <set>
 #include <functional>
@@ -73,6 +79,249 @@ class OGRGeoJSONReaderStreamingParser final
     }
 };
 
+/************************************************************************/
+/*                      OGRGeoJSONFeatureScanner                        */
+/************************************************************************/
+
+// Lightweight structural scanner of a GeoJSON FeatureCollection, that
+// identifies the byte range of each element of the top-level "features"
+// array, without building any JSON object. It is fed with a growing buffer,
+// and only accepts the regular layout of a FeatureCollection: anything else
+// makes Scan() return false, in which case the caller should fall back to
+// OGRGeoJSONReaderStreamingParser.
+
+namespace
+{
+class OGRGeoJSONFeatureScanner
+{
+    std::vector<char> m_achClosers{};  // expected closing '}' or ']'
+    std::string m_osKey{};
+    size_t m_nPos = 0;
+    size_t m_nFeatureStart = 0;
+    bool m_bRootSeen = false;
+    bool m_bInString = false;
+    bool m_bInKey = false;
+    bool m_bEscape = false;
+    bool m_bExpectKey = false;
+    bool m_bLastKeyIsFeatures = false;
+    bool m_bInFeaturesArray = false;
+    bool m_bExpectMember = false;
+    bool m_bAfterComma = false;
+
+  public:
+    bool Scan(const char *pszBuf, size_t nSize,
+              std::vector<std::pair<size_t, size_t>> &aoRanges);
+
+    // Whether the root object has been fully scanned.
+    bool IsComplete() const
+    {
+        return m_bRootSeen && m_achClosers.empty() && !m_bInString;
+    }
+
+    bool IsInFeature() const
+    {
+        return m_bInFeaturesArray && m_achClosers.size() > 2;
+    }
+
+    size_t GetFeatureStart() const
+    {
+        return m_nFeatureStart;
+    }
+
+    // Offset before which the buffer is no longer needed.
+    size_t GetConsumedOffset() const
+    {
+        return IsInFeature() ? m_nFeatureStart : m_nPos;
+    }
+
+    // To be called after removing the nOffset first bytes of the buffer.
+    void Rebase(size_t nOffset)
+    {
+        m_nPos -= nOffset;
+        if (IsInFeature())
+            m_nFeatureStart -= nOffset;
+    }
+};
+
+/************************************************************************/
+/*                   OGRGeoJSONFeatureScanner::Scan()                   */
+/************************************************************************/
+
+bool OGRGeoJSONFeatureScanner::Scan(
+    const char *pszBuf, size_t nSize,
+    std::vector<std::pair<size_t, size_t>> &aoRanges)
+{
+    size_t i = m_nPos;
+    if (m_bEscape && i < nSize)
+    {
+        m_bEscape = false;
+        ++i;
+    }
+    while (i < nSize)
+    {
+        if (m_bInString)
+        {
+            if (m_bInKey)
+            {
+                // Escaped member names are left to the streaming parser
+                const char ch = pszBuf[i];
+                if (ch == '\\')
+                    return false;
+                if (ch == '"')
+                {
+                    m_bInString = false;
+                    m_bInKey = false;
+                    m_bLastKeyIsFeatures = m_osKey == "features";
+                }
+                else if (m_osKey.size() <= strlen("features"))
+                {
+                    m_osKey += ch;
+                }
+                ++i;
+                continue;
+            }
+
+            while (i < nSize && pszBuf[i] != '"' && pszBuf[i] != '\\')
+                ++i;
+            if (i == nSize)
+                break;
+            if (pszBuf[i] == '\\')
+            {
+                if (i + 1 == nSize)
+                {
+                    m_bEscape = true;
+                    i = nSize;
+                    break;
+                }
+                i += 2;
+                continue;
+            }
+            m_bInString = false;
+            ++i;
+            continue;
+        }
+
+        const size_t nDepth = m_achClosers.size();
+        const bool bInFeaturesArrayLevel = m_bInFeaturesArray && nDepth == 2;
+        const char ch = pszBuf[i];
+        switch (ch)
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+
+            case '"':
+                if (nDepth == 0 || bInFeaturesArrayLevel)
+                    return false;
+                m_bInString = true;
+                if (nDepth == 1 && m_bExpectKey)
+                {
+                    m_bInKey = true;
+                    m_osKey.clear();
+                }
+                break;
+
+            case '{':
+                if (nDepth == 0)
+                {
+                    if (m_bRootSeen)
+                        return false;
+                    m_bRootSeen = true;
+                    m_bExpectKey = true;
+                }
+                else if (bInFeaturesArrayLevel)
+                {
+                    if (!m_bExpectMember)
+                        return false;
+                    m_bExpectMember = false;
+                    m_bAfterComma = false;
+                    m_nFeatureStart = i;
+                }
+                m_achClosers.push_back('}');
+                break;
+
+            case '[':
+                if (nDepth == 0 || bInFeaturesArrayLevel)
+                    return false;
+                if (nDepth == 1 && !m_bExpectKey && m_bLastKeyIsFeatures)
+                {
+                    m_bInFeaturesArray = true;
+                    m_bExpectMember = true;
+                    m_bAfterComma = false;
+                }
+                m_achClosers.push_back(']');
+                break;
+
+            case '}':
+            case ']':
+                if (nDepth == 0 || m_achClosers.back() != ch ||
+                    (bInFeaturesArrayLevel && m_bAfterComma))
+                {
+                    return false;
+                }
+                m_achClosers.pop_back();
+                if (m_bInFeaturesArray && nDepth == 3)
+                {
+                    aoRanges.emplace_back(m_nFeatureStart, i + 1);
+                }
+                else if (bInFeaturesArrayLevel)
+                {
+                    m_bInFeaturesArray = false;
+                }
+                break;
+
+            case ',':
+                if (nDepth == 1)
+                {
+                    m_bExpectKey = true;
+                }
+                else if (bInFeaturesArrayLevel)
+                {
+                    if (m_bExpectMember)
+                        return false;
+                    m_bExpectMember = true;
+                    m_bAfterComma = true;
+                }
+                break;
+
+            case ':':
+                if (nDepth == 1)
+                    m_bExpectKey = false;
+                break;
+
+            default:
+                // Only objects are expected as members of the "features"
+                // array.
+                if (nDepth == 0 || bInFeaturesArrayLevel)
+                    return false;
+                break;
+        }
+        ++i;
+    }
+    m_nPos = i;
+    return true;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                    OGRGeoJSONReaderParallelState                     */
+/************************************************************************/
+
+struct OGRGeoJSONReaderParallelState
+{
+    OGRGeoJSONFeatureScanner oScanner{};
+    std::string osBuffer{};
+    vsi_l_offset nFileOffset = 0;
+    bool bEOF = false;
+    std::deque<std::unique_ptr<OGRFeature>> apoFeatures{};
+    std::set<GIntBig> oSetUsedFIDs{};
+    bool bOriginalIdModifiedEmitted = false;
+    GIntBig nFeaturesQueued = 0;
+};
+
 /************************************************************************/
 /*                        OGRGeoJSONBaseReader()                        */
 /************************************************************************/
@@ -267,6 +516,47 @@ OGRFeature *OGRGeoJSONReaderStreamingParser::GetNextFeature()
     return nullptr;
 }
 
+/************************************************************************/
+/*                    OGRGeoJSONReaderSetUniqueFID()                    */
+/************************************************************************/
+
+// Assign to poFeat its "id" if it is not already used by a previous feature,
+// or a new unique FID otherwise.
+static void OGRGeoJSONReaderSetUniqueFID(OGRFeature *poFeat,
+                                         std::set<GIntBig> &oSetUsedFIDs,
+                                         bool &bOriginalIdModifiedEmitted)
+{
+    GIntBig nFID = poFeat->GetFID();
+    if (nFID == OGRNullFID)
+    {
+        nFID = static_cast<GIntBig>(oSetUsedFIDs.size());
+        while (cpl::contains(oSetUsedFIDs, nFID))
+        {
+            ++nFID;
+        }
+    }
+    else if (cpl::contains(oSetUsedFIDs, nFID))
+    {
+        if (!bOriginalIdModifiedEmitted)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Several features with id = " CPL_FRMT_GIB " have "
+                     "been found. Altering it to be unique. "
+                     "This warning will not be emitted anymore for "
+                     "this layer",
+                     nFID);
+            bOriginalIdModifiedEmitted = true;
+        }
+        nFID = static_cast<GIntBig>(oSetUsedFIDs.size());
+        while (cpl::contains(oSetUsedFIDs, nFID))
+        {
+            ++nFID;
+        }
+    }
+    oSetUsedFIDs.insert(nFID);
+    poFeat->SetFID(nFID);
+}
+
 /************************************************************************/
 /*                          GotFeature()                                */
 /************************************************************************/
@@ -289,36 +579,8 @@ void OGRGeoJSONReaderStreamingParser::GotFeature(json_object *poObj,
             m_oReader.ReadFeature(m_poLayer, poObj, osJson.c_str());
         if (poFeat)
         {
-            GIntBig nFID = poFeat->GetFID();
-            if (nFID == OGRNullFID)
-            {
-                nFID = static_cast<GIntBig>(m_oSetUsedFIDs.size());
-                while (cpl::contains(m_oSetUsedFIDs, nFID))
-                {
-                    ++nFID;
-                }
-            }
-            else if (cpl::contains(m_oSetUsedFIDs, nFID))
-            {
-                if (!m_bOriginalIdModifiedEmitted)
-                {
-                    CPLError(CE_Warning, CPLE_AppDefined,
-                             "Several features with id = " CPL_FRMT_GIB " have "
-                             "been found. Altering it to be unique. "
-                             "This warning will not be emitted anymore for "
-                             "this layer",
-                             nFID);
-                    m_bOriginalIdModifiedEmitted = true;
-                }
-                nFID = static_cast<GIntBig>(m_oSetUsedFIDs.size());
-                while (cpl::contains(m_oSetUsedFIDs, nFID))
-                {
-                    ++nFID;
-                }
-            }
-            m_oSetUsedFIDs.insert(nFID);
-            poFeat->SetFID(nFID);
-
+            OGRGeoJSONReaderSetUniqueFID(poFeat, m_oSetUsedFIDs,
+                                         m_bOriginalIdModifiedEmitted);
             m_apoFeatures.push_back(poFeat);
         }
     }
@@ -659,6 +921,267 @@ void OGRGeoJSONReader::ResetReading()
             poStreamingParser_->GetOriginalIdModifiedEmitted();
     delete poStreamingParser_;
     poStreamingParser_ = nullptr;
+    if (poParallelState_)
+        bOriginalIdModifiedEmitted_ =
+            poParallelState_->bOriginalIdModifiedEmitted;
+    poParallelState_.reset();
+    nFeaturesToSkip_ = 0;
+}
+
+/************************************************************************/
+/*                        StartParallelReading()                        */
+/************************************************************************/
+
+// Initialize multi-threaded reading of features, if enabled and if the
+// file is larger than a chunk.
+void OGRGeoJSONReader::StartParallelReading()
+{
+    if (bParallelReadingDisabled_ || bStoreNativeData_ ||
+        GeoJSONGetNumThreads() < 2)
+    {
+        return;
+    }
+
+    const size_t nChunkSize = GeoJSONGetParallelChunkSize(4 * 1024 * 1024);
+    auto poState = std::make_unique<OGRGeoJSONReaderParallelState>();
+    VSIFSeekL(fp_, 0, SEEK_SET);
+    try
+    {
+        poState->osBuffer.resize(nChunkSize);
+    }
+    catch (const std::exception &)
+    {
+        bParallelReadingDisabled_ = true;
+        return;
+    }
+    const size_t nRead = VSIFReadL(&poState->osBuffer[0], 1, nChunkSize, fp_);
+    poState->osBuffer.resize(nRead);
+    if (nRead < nChunkSize)
+    {
+        bParallelReadingDisabled_ = true;
+        return;
+    }
+
+    // Detect UTF-8 BOM and JSONP-like wrapper. The latter is left to the
+    // streaming parser.
+    const size_t nPrologSize = std::min(nRead, nBufferSize_);
+    memcpy(pabyBuffer_, poState->osBuffer.data(), nPrologSize);
+    bJSonPLikeWrapper_ = false;
+    const size_t nSkip = SkipPrologEpilogAndUpdateJSonPLikeWrapper(nPrologSize);
+    if (bJSonPLikeWrapper_)
+    {
+        bParallelReadingDisabled_ = true;
+        return;
+    }
+    poState->osBuffer.erase(0, nSkip);
+    poState->nFileOffset = nRead;
+    poState->bOriginalIdModifiedEmitted = bOriginalIdModifiedEmitted_;
+    poParallelState_ = std::move(poState);
+}
+
+/************************************************************************/
+/*                        StopParallelReading()                         */
+/************************************************************************/
+
+// Switch to the streaming parser, which will restart from the beginning of
+// the file and skip the features already returned.
+void OGRGeoJSONReader::StopParallelReading()
+{
+    CPLDebug("GeoJSON",
+             "Switching to single-threaded reading after feature " CPL_FRMT_GIB,
+             poParallelState_->nFeaturesQueued);
+    bOriginalIdModifiedEmitted_ = poParallelState_->bOriginalIdModifiedEmitted;
+    nFeaturesToSkip_ = poParallelState_->nFeaturesQueued;
+    poParallelState_.reset();
+    bParallelReadingDisabled_ = true;
+}
+
+/************************************************************************/
+/*                    OGRGeoJSONReaderParseObject()                     */
+/************************************************************************/
+
+static json_object *OGRGeoJSONReaderParseObject(const char *pszText,
+                                                size_t nLen)
+{
+    json_tokener *jstok = json_tokener_new();
+    json_object *poObj =
+        json_tokener_parse_ex(jstok, pszText, static_cast<int>(nLen));
+    const bool bOK = jstok->err == json_tokener_success;
+    json_tokener_free(jstok);
+    if (!bOK)
+    {
+        json_object_put(poObj);
+        return nullptr;
+    }
+    return poObj;
+}
+
+/************************************************************************/
+/*                       ReadFeaturesInParallel()                       */
+/************************************************************************/
+
+// Read the file by chunks, locate features with OGRGeoJSONFeatureScanner
+// on the calling thread, and parse them with OGR_GEOJSON_NUM_THREADS worker
+// threads. Features are appended to poParallelState_->apoFeatures in file
+// order, with the same FIDs as the streaming parser would have assigned.
+// Returns false when there are no more features, or after having switched
+// to the streaming parser (in which case poParallelState_ is reset).
+bool OGRGeoJSONReader::ReadFeaturesInParallel(OGRGeoJSONLayer *poLayer)
+{
+    const int nThreads = GeoJSONGetNumThreads();
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+    {
+        StopParallelReading();
+        return false;
+    }
+
+    const size_t nChunkSize = GeoJSONGetParallelChunkSize(4 * 1024 * 1024);
+    const size_t nMaxObjectSize =
+        OGRGeoJSONReaderStreamingParserGetMaxObjectSize();
+    auto &oState = *poParallelState_;
+    auto &oScanner = oState.oScanner;
+
+    while (oState.apoFeatures.empty())
+    {
+        std::vector<std::pair<size_t, size_t>> aoRanges;
+        bool bOK = oScanner.Scan(oState.osBuffer.data(),
+                                 oState.osBuffer.size(), aoRanges);
+        for (const auto &oRange : aoRanges)
+        {
+            const size_t nLen = oRange.second - oRange.first;
+            if (nLen > static_cast<size_t>(INT_MAX) ||
+                (nMaxObjectSize > 0 && nLen > nMaxObjectSize))
+            {
+                bOK = false;
+            }
+        }
+        if (bOK && oScanner.IsInFeature() && nMaxObjectSize > 0 &&
+            oState.osBuffer.size() - oScanner.GetFeatureStart() >
+                nMaxObjectSize)
+        {
+            bOK = false;
+        }
+
+        if (bOK && !aoRanges.empty())
+        {
+            const char *pszBuffer = oState.osBuffer.data();
+            const size_t nRanges = aoRanges.size();
+            const size_t nJobs =
+                std::min(static_cast<size_t>(nThreads), nRanges);
+            std::vector<std::unique_ptr<OGRFeature>> apoFeatures(nRanges);
+            std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+            std::atomic<bool> bParsingError{false};
+            for (size_t iJob = 0; iJob < nJobs; ++iJob)
+            {
+                const size_t iStart = nRanges * iJob / nJobs;
+                const size_t iEnd = nRanges * (iJob + 1) / nJobs;
+                poJobQueue->SubmitJob(
+                    [this, poLayer, pszBuffer, &aoRanges, &apoFeatures,
+                     &aoErrorAccumulators, &bParsingError, iJob, iStart,
+                     iEnd]()
+                    {
+                        auto oAccumulator =
+                            aoErrorAccumulators[iJob].InstallForCurrentScope();
+                        CPL_IGNORE_RET_VAL(oAccumulator);
+
+                        for (size_t i = iStart; i < iEnd && !bParsingError;
+                             ++i)
+                        {
+                            json_object *poObj = OGRGeoJSONReaderParseObject(
+                                pszBuffer + aoRanges[i].first,
+                                aoRanges[i].second - aoRanges[i].first);
+                            if (!poObj)
+                            {
+                                bParsingError = true;
+                                break;
+                            }
+                            json_object *poObjType =
+                                CPL_json_object_object_get(poObj, "type");
+                            if (poObjType &&
+                                json_object_get_type(poObjType) ==
+                                    json_type_string &&
+                                strcmp(json_object_get_string(poObjType),
+                                       "Feature") == 0)
+                            {
+                                apoFeatures[i].reset(
+                                    ReadFeature(poLayer, poObj, nullptr));
+                            }
+                            json_object_put(poObj);
+                        }
+                    });
+            }
+            poJobQueue->WaitCompletion();
+
+            if (bParsingError)
+            {
+                // Let the streaming parser report the error at the right
+                // place.
+                bOK = false;
+            }
+            else
+            {
+                // Errors are replayed in the order of the features
+                for (auto &oErrorAccumulator : aoErrorAccumulators)
+                    oErrorAccumulator.ReplayErrors();
+
+                for (auto &poFeature : apoFeatures)
+                {
+                    if (!poFeature)
+                        continue;
+                    OGRGeoJSONReaderSetUniqueFID(
+                        poFeature.get(), oState.oSetUsedFIDs,
+                        oState.bOriginalIdModifiedEmitted);
+                    oState.apoFeatures.push_back(std::move(poFeature));
+                    ++oState.nFeaturesQueued;
+                }
+            }
+        }
+
+        if (bOK && oState.apoFeatures.empty() && oState.bEOF &&
+            !oScanner.IsComplete())
+        {
+            // Truncated or invalid file
+            bOK = false;
+        }
+        if (!bOK)
+        {
+            oState.apoFeatures.clear();
+            StopParallelReading();
+            return false;
+        }
+        if (!oState.apoFeatures.empty())
+            break;
+        if (oState.bEOF)
+            return false;
+
+        // Discard the part of the buffer that has been processed, and
+        // read the next chunk.
+        const size_t nConsumed = oScanner.GetConsumedOffset();
+        oState.osBuffer.erase(0, nConsumed);
+        oScanner.Rebase(nConsumed);
+        const size_t nOldSize = oState.osBuffer.size();
+        try
+        {
+            oState.osBuffer.resize(nOldSize + nChunkSize);
+        }
+        catch (const std::exception &)
+        {
+            StopParallelReading();
+            return false;
+        }
+        VSIFSeekL(fp_, oState.nFileOffset, SEEK_SET);
+        const size_t nRead =
+            VSIFReadL(&oState.osBuffer[nOldSize], 1, nChunkSize, fp_);
+        oState.osBuffer.resize(nOldSize + nRead);
+        oState.nFileOffset += nRead;
+        oState.bEOF = nRead < nChunkSize;
+    }
+
+    return true;
 }
 
 /************************************************************************/
@@ -668,6 +1191,23 @@ void OGRGeoJSONReader::ResetReading()
 OGRFeature *OGRGeoJSONReader::GetNextFeature(OGRGeoJSONLayer *poLayer)
 {
     CPLAssert(fp_);
+    if (poStreamingParser_ == nullptr && !poParallelState_)
+        StartParallelReading();
+    if (poParallelState_)
+    {
+        if (!poParallelState_->apoFeatures.empty() ||
+            ReadFeaturesInParallel(poLayer))
+        {
+            OGRFeature *poFeat =
+                poParallelState_->apoFeatures.front().release();
+            poParallelState_->apoFeatures.pop_front();
+            return poFeat;
+        }
+        if (poParallelState_)
+            return nullptr;
+        // Otherwise continue with the streaming parser
+    }
+
     if (poStreamingParser_ == nullptr)
     {
         poStreamingParser_ = new OGRGeoJSONReaderStreamingParser(
@@ -677,6 +1217,21 @@ OGRFeature *OGRGeoJSONReader::GetNextFeature(OGRGeoJSONLayer *poLayer)
         VSIFSeekL(fp_, 0, SEEK_SET);
         bFirstSeg_ = true;
         bJSonPLikeWrapper_ = false;
+
+        if (nFeaturesToSkip_ > 0)
+        {
+            // Skip features already returned by ReadFeaturesInParallel()
+            const GIntBig nFeaturesToSkip = nFeaturesToSkip_;
+            nFeaturesToSkip_ = 0;
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            for (GIntBig i = 0; i < nFeaturesToSkip; ++i)
+            {
+                OGRFeature *poFeat = GetNextFeature(poLayer);
+                if (!poFeat)
+                    return nullptr;
+                delete poFeat;
+            }
+        }
     }
 
     OGRFeature *poFeat = poStreamingParser_->GetNextFeature();
@@ -2381,10 +2936,9 @@ OGRFeature *OGRGeoJSONBaseReader::ReadFeature(OGRLayer *poLayer,
     }
     else
     {
-        static bool bWarned = false;
-        if (!bWarned)
+        static std::atomic<bool> bWarned{false};
+        if (!bWarned.exchange(true))
         {
-            bWarned = true;
             CPLDebug(
                 "GeoJSON",
                 "Non conformant Feature object. Missing \'geometry\' member.");
@@ -23,6 +23,7 @@
 
 #include <utility>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -131,6 +132,8 @@ class OGRGeoJSONBaseReader
 class OGRGeoJSONDataSource;
 class OGRGeoJSONReaderStreamingParser;
 
+struct OGRGeoJSONReaderParallelState;
+
 class OGRGeoJSONReader : public OGRGeoJSONBaseReader
 {
   public:
@@ -189,6 +192,11 @@ class OGRGeoJSONReader : public OGRGeoJSONBaseReader
 
     std::map<GIntBig, std::pair<vsi_l_offset, vsi_l_offset>>
         oMapFIDToOffsetSize_;
+
+    std::unique_ptr<OGRGeoJSONReaderParallelState> poParallelState_{};
+    bool bParallelReadingDisabled_ = false;
+    GIntBig nFeaturesToSkip_ = 0;
+
     //
     // Copy operations not supported.
     //
@@ -204,6 +212,10 @@ class OGRGeoJSONReader : public OGRGeoJSONBaseReader
 
     void ReadFeatureCollection(OGRGeoJSONLayer *poLayer, json_object *poObj);
     size_t SkipPrologEpilogAndUpdateJSonPLikeWrapper(size_t nRead);
+
+    void StartParallelReading();
+    bool ReadFeaturesInParallel(OGRGeoJSONLayer *poLayer);
+    void StopParallelReading();
 };
 
 void OGRGeoJSONGenerateFeatureDefnDealWithID(
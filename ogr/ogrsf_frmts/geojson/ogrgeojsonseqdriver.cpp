@@ -15,6 +15,9 @@
 #include "cpl_http.h"
 #include "cpl_vsi_error.h"
 
+#include "cpl_error_internal.h"
+#include "gdal_thread_pool.h"
+
 #include "ogr_geojson.h"
 #include "ogrlibjsonutils.h"
 #include "ogrgeojsonreader.h"
@@ -22,6 +25,7 @@
 #include "ogrgeojsongeometry.h"
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 
 constexpr char RS = '\x1e';
@@ -86,11 +90,17 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
     GIntBig m_nTotalFeatures = 0;
     GIntBig m_nNextFID = 0;
 
+    std::deque<std::unique_ptr<OGRFeature>> m_apoParallelFeatures{};
+
     std::unique_ptr<OGRCoordinateTransformation> m_poCT{};
     OGRGeometryFactory::TransformWithOptionsCache m_oTransformCache;
     OGRGeoJSONWriteOptions m_oWriteOptions;
 
+    bool GetNextRecord();
     json_object *GetNextObject(bool bLooseIdentification);
+    OGRFeature *TranslateObject(json_object *poObject,
+                                const char *pszSerializedObj);
+    bool ReadFeaturesInParallel();
 
   public:
     OGRGeoJSONSeqLayer(OGRGeoJSONSeqDataSource *poDS, const char *pszName);
@@ -480,13 +490,15 @@ void OGRGeoJSONSeqLayer::ResetReading()
     m_nPosInBuffer = nBufferSizeValidated;
     m_nBufferValidSize = nBufferSizeValidated;
     m_nNextFID = 0;
+    m_apoParallelFeatures.clear();
 }
 
 /************************************************************************/
-/*                           GetNextObject()                            */
+/*                           GetNextRecord()                            */
 /************************************************************************/
 
-json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+// Read the next non-empty record in m_osFeatureBuffer.
+bool OGRGeoJSONSeqLayer::GetNextRecord()
 {
     m_osFeatureBuffer.clear();
     while (true)
@@ -496,7 +508,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         {
             if (m_nBufferValidSize < m_osBuffer.size())
             {
-                return nullptr;
+                return false;
             }
             m_nBufferValidSize =
                 VSIFReadL(&m_osBuffer[0], 1, m_osBuffer.size(), m_poDS->m_fp);
@@ -520,7 +532,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
             }
             if (m_nPosInBuffer >= m_nBufferValidSize)
             {
-                return nullptr;
+                return false;
             }
         }
 
@@ -548,7 +560,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
                          "for larger features, or 0 to remove any size limit.",
                          static_cast<unsigned>(m_osFeatureBuffer.size() / 1024 /
                                                1024));
-                return nullptr;
+                return false;
             }
             m_nPosInBuffer = m_nBufferValidSize;
             if (m_nBufferValidSize == m_osBuffer.size())
@@ -565,21 +577,159 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         }
         if (!m_osFeatureBuffer.empty())
         {
-            json_object *poObject = nullptr;
-            CPL_IGNORE_RET_VAL(
-                OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
-            m_osFeatureBuffer.clear();
-            if (json_object_get_type(poObject) == json_type_object)
+            return true;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           GetNextObject()                            */
+/************************************************************************/
+
+json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+{
+    while (GetNextRecord())
+    {
+        json_object *poObject = nullptr;
+        CPL_IGNORE_RET_VAL(OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
+        m_osFeatureBuffer.clear();
+        if (json_object_get_type(poObject) == json_type_object)
+        {
+            return poObject;
+        }
+        json_object_put(poObject);
+        if (bLooseIdentification)
+        {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                          TranslateObject()                           */
+/************************************************************************/
+
+// Translate a Feature or a geometry object into a OGRFeature. Returns
+// nullptr for other objects. Takes ownership of poObject.
+OGRFeature *OGRGeoJSONSeqLayer::TranslateObject(json_object *poObject,
+                                                const char *pszSerializedObj)
+{
+    OGRFeature *poFeature = nullptr;
+    const auto type = OGRGeoJSONGetType(poObject);
+    if (type == GeoJSONObject::eFeature)
+    {
+        poFeature = m_oReader.ReadFeature(this, poObject, pszSerializedObj);
+    }
+    else if (type != GeoJSONObject::eFeatureCollection &&
+             type != GeoJSONObject::eUnknown)
+    {
+        OGRGeometry *poGeom = m_oReader.ReadGeometry(poObject, GetSpatialRef());
+        if (poGeom)
+        {
+            poFeature = new OGRFeature(m_poFeatureDefn);
+            poFeature->SetGeometryDirectly(poGeom);
+        }
+    }
+    json_object_put(poObject);
+    return poFeature;
+}
+
+/************************************************************************/
+/*                       ReadFeaturesInParallel()                       */
+/************************************************************************/
+
+// Collect the next records on the calling thread, and parse them with
+// OGR_GEOJSON_NUM_THREADS worker threads. Features are appended to
+// m_apoParallelFeatures in file order.
+bool OGRGeoJSONSeqLayer::ReadFeaturesInParallel()
+{
+    const int nThreads = GeoJSONGetNumThreads();
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads >= 2 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+        return false;
+
+    const size_t nBatchSize = GeoJSONGetParallelChunkSize(4 * 1024 * 1024);
+    while (m_apoParallelFeatures.empty())
+    {
+        std::vector<std::string> aosRecords;
+        size_t nBatchBytes = 0;
+        CPLErrorAccumulator oReadErrorAccumulator;
+        bool bEOF = false;
+        {
+            auto oAccumulator = oReadErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oAccumulator);
+            while (nBatchBytes < nBatchSize)
             {
-                return poObject;
+                if (!GetNextRecord())
+                {
+                    bEOF = true;
+                    break;
+                }
+                nBatchBytes += m_osFeatureBuffer.size();
+                aosRecords.push_back(std::move(m_osFeatureBuffer));
+                m_osFeatureBuffer.clear();
             }
-            json_object_put(poObject);
-            if (bLooseIdentification)
+        }
+
+        const size_t nRecords = aosRecords.size();
+        const size_t nJobs = std::min(static_cast<size_t>(nThreads), nRecords);
+        std::vector<std::unique_ptr<OGRFeature>> apoFeatures(nRecords);
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+        for (size_t iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const size_t iStart = nRecords * iJob / nJobs;
+            const size_t iEnd = nRecords * (iJob + 1) / nJobs;
+            poJobQueue->SubmitJob(
+                [this, &aosRecords, &apoFeatures, &aoErrorAccumulators, iJob,
+                 iStart, iEnd]()
+                {
+                    auto oAccumulator =
+                        aoErrorAccumulators[iJob].InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+
+                    for (size_t i = iStart; i < iEnd; ++i)
+                    {
+                        json_object *poObject = nullptr;
+                        CPL_IGNORE_RET_VAL(
+                            OGRJSonParse(aosRecords[i].c_str(), &poObject));
+                        if (json_object_get_type(poObject) != json_type_object)
+                        {
+                            json_object_put(poObject);
+                            continue;
+                        }
+                        apoFeatures[i].reset(
+                            TranslateObject(poObject, aosRecords[i].c_str()));
+                    }
+                });
+        }
+        poJobQueue->WaitCompletion();
+
+        // Errors are replayed in the order of the records
+        for (auto &oErrorAccumulator : aoErrorAccumulators)
+            oErrorAccumulator.ReplayErrors();
+        oReadErrorAccumulator.ReplayErrors();
+
+        for (auto &poFeature : apoFeatures)
+        {
+            if (!poFeature)
+                continue;
+            if (poFeature->GetFID() == OGRNullFID)
             {
-                return nullptr;
+                poFeature->SetFID(m_nNextFID);
+                m_nNextFID++;
             }
+            m_apoParallelFeatures.push_back(std::move(poFeature));
         }
+
+        if (bEOF)
+            break;
     }
+
+    return !m_apoParallelFeatures.empty();
 }
 
 /************************************************************************/
@@ -600,42 +750,31 @@ OGRFeature *OGRGeoJSONSeqLayer::GetNextFeature()
     }
 
     GetLayerDefn();  // force scan if not already done
+    const bool bParallel = GeoJSONGetNumThreads() >= 2;
     while (true)
     {
-        auto poObject = GetNextObject(false);
-        if (!poObject)
-            return nullptr;
         OGRFeature *poFeature;
-        auto type = OGRGeoJSONGetType(poObject);
-        if (type == GeoJSONObject::eFeature)
-        {
-            poFeature = m_oReader.ReadFeature(this, poObject,
-                                              m_osFeatureBuffer.c_str());
-            json_object_put(poObject);
-        }
-        else if (type == GeoJSONObject::eFeatureCollection ||
-                 type == GeoJSONObject::eUnknown)
+        if (bParallel)
         {
-            json_object_put(poObject);
-            continue;
+            if (m_apoParallelFeatures.empty() && !ReadFeaturesInParallel())
+                return nullptr;
+            poFeature = m_apoParallelFeatures.front().release();
+            m_apoParallelFeatures.pop_front();
         }
         else
         {
-            OGRGeometry *poGeom =
-                m_oReader.ReadGeometry(poObject, GetSpatialRef());
-            json_object_put(poObject);
-            if (!poGeom)
-            {
+            auto poObject = GetNextObject(false);
+            if (!poObject)
+                return nullptr;
+            poFeature = TranslateObject(poObject, m_osFeatureBuffer.c_str());
+            if (!poFeature)
                 continue;
-            }
-            poFeature = new OGRFeature(m_poFeatureDefn);
-            poFeature->SetGeometryDirectly(poGeom);
-        }
 
-        if (poFeature->GetFID() == OGRNullFID)
-        {
-            poFeature->SetFID(m_nNextFID);
-            m_nNextFID++;
+            if (poFeature->GetFID() == OGRNullFID)
+            {
+                poFeature->SetFID(m_nNextFID);
+                m_nNextFID++;
+            }
         }
         if ((m_poFilterGeom == nullptr ||
              FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter))) &&
@@ -16,6 +16,8 @@
 #include "cpl_port.h"
 #include "cpl_conv.h"
 #include "cpl_json_streaming_parser.h"
+#include "cpl_multiproc.h"
+#include "gdal_thread_pool.h"
 #include "ogr_geometry.h"
 #include <json.h>  // JSON-C
 
@@ -1139,3 +1141,25 @@ CPLHTTPResult *GeoJSONHTTPFetchWithContentTypeHeader(const char *pszURL)
 
     return pResult;
 }
+
+/************************************************************************/
+/*                        GeoJSONGetNumThreads()                        */
+/************************************************************************/
+
+int GeoJSONGetNumThreads()
+{
+    return GDALGetNumThreads(nullptr, nullptr, "OGR_GEOJSON_NUM_THREADS", 1);
+}
+
+/************************************************************************/
+/*                     GeoJSONGetParallelChunkSize()                    */
+/************************************************************************/
+
+size_t GeoJSONGetParallelChunkSize(size_t nDefault)
+{
+    const char *pszChunkSize =
+        CPLGetConfigOption("OGR_GEOJSON_PARALLEL_CHUNK_SIZE", nullptr);
+    if (pszChunkSize == nullptr)
+        return nDefault;
+    return static_cast<size_t>(std::max(1, atoi(pszChunkSize)));
+}
@@ -62,4 +62,12 @@ OGRFieldType GeoJSONStringPropertyToFieldType(json_object *poObject,
 
 CPLHTTPResult *GeoJSONHTTPFetchWithContentTypeHeader(const char *pszURL);
 
+/************************************************************************/
+/*                         GeoJSONGetNumThreads                         */
+/************************************************************************/
+
+int GeoJSONGetNumThreads();
+
+size_t GeoJSONGetParallelChunkSize(size_t nDefault);
+
 #endif  // OGR_GEOJSONUTILS_H_INCLUDED
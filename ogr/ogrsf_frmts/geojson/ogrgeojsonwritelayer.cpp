@@ -14,9 +14,15 @@
 #include "ogr_geojson.h"
 #include "ogrgeojsonwriter.h"
 
+#include "cpl_error_internal.h"
 #include "cpl_vsi_virtual.h"
+#include "gdal_thread_pool.h"
 
 #include <algorithm>
+#include <cmath>
+
+// Number of features serialized by each worker thread in a batch
+constexpr int FEATURES_PER_THREAD_BATCH = 256;
 
 /************************************************************************/
 /*                         OGRGeoJSONWriteLayer()                       */
@@ -40,7 +46,7 @@ OGRGeoJSONWriteLayer::OGRGeoJSONWriteLayer(const char *pszName,
           CSLFetchNameValueDef(papszOptions, "WRAPDATELINE", "YES"))),
       osForeignMembers_(
           CSLFetchNameValueDef(papszOptions, "FOREIGN_MEMBERS_FEATURE", "")),
-      poCT_(poCT)
+      poCT_(poCT), m_nNumThreads(GeoJSONGetNumThreads())
 {
     if (!osForeignMembers_.empty())
     {
@@ -102,6 +108,8 @@ OGRGeoJSONWriteLayer::~OGRGeoJSONWriteLayer()
 
 void OGRGeoJSONWriteLayer::FinishWriting()
 {
+    FlushPendingFeatures();
+
     if (m_nPositionBeforeFCClosed == 0)
     {
         VSILFILE *fp = poDS_->GetOutputFile();
@@ -163,92 +171,64 @@ void OGRGeoJSONWriteLayer::FinishWriting()
 
 OGRErr OGRGeoJSONWriteLayer::SyncToDisk()
 {
+    const OGRErr eErr = FlushPendingFeatures();
+
     if (m_nPositionBeforeFCClosed == 0 && poDS_->GetFpOutputIsSeekable())
     {
         FinishWriting();
     }
 
-    return OGRERR_NONE;
+    return eErr;
 }
 
 /************************************************************************/
-/*                           ICreateFeature()                            */
+/*                      MightNeedGeometryRepair()                       */
 /************************************************************************/
 
-OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
+static bool OGRGeoJSONWriteLayerIsValid(const OGRGeometry *poGeom)
 {
-    VSILFILE *fp = poDS_->GetOutputFile();
-
-    OGRFeature *poFeatureToWrite;
-    if (poCT_ != nullptr || bRFC7946_)
-    {
-        poFeatureToWrite = new OGRFeature(poFeatureDefn_);
-        poFeatureToWrite->SetFrom(poFeature);
-        poFeatureToWrite->SetFID(poFeature->GetFID());
-        OGRGeometry *poGeometry = poFeatureToWrite->GetGeometryRef();
-        if (poGeometry)
-        {
-            const char *const apszOptions[] = {
-                bWrapDateLine_ ? "WRAPDATELINE=YES" : nullptr, nullptr};
-            OGRGeometry *poNewGeom = OGRGeometryFactory::transformWithOptions(
-                poGeometry, poCT_, const_cast<char **>(apszOptions),
-                oTransformCache_);
-            if (poNewGeom == nullptr)
-            {
-                delete poFeatureToWrite;
-                return OGRERR_FAILURE;
-            }
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    return poGeom->IsValid();
+}
 
-            OGREnvelope sEnvelope;
-            poNewGeom->getEnvelope(&sEnvelope);
-            if (sEnvelope.MinX < -180.0 || sEnvelope.MaxX > 180.0 ||
-                sEnvelope.MinY < -90.0 || sEnvelope.MaxY > 90.0)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Geometry extent outside of "
-                         "[-180.0,180.0]x[-90.0,90.0] bounds");
-                delete poFeatureToWrite;
-                return OGRERR_FAILURE;
-            }
+bool OGRGeoJSONWriteLayer::MightNeedGeometryRepair(
+    const OGRGeometry *poOrigGeom) const
+{
+    return OGRGeometryFactory::haveGEOS() &&
+           oWriteOptions_.nXYCoordPrecision >= 0 && poOrigGeom &&
+           wkbFlatten(poOrigGeom->getGeometryType()) != wkbPoint;
+}
 
-            poFeatureToWrite->SetGeometryDirectly(poNewGeom);
-        }
-    }
-    else
-    {
-        poFeatureToWrite = poFeature;
-    }
+/************************************************************************/
+/*                     RepairGeometryForPrecision()                     */
+/************************************************************************/
 
-    const auto IsValid = [](const OGRGeometry *poGeom)
-    {
-        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
-        return poGeom->IsValid();
-    };
-
-    // Special processing to detect and repair invalid geometries due to
-    // coordinate precision.
-    // Normally drivers shouldn't do that as similar code is triggered by
-    // setting the OGR_APPLY_GEOM_SET_PRECISION=YES configuration option by
-    // the generic OGRLayer::CreateFeature() code path. But this code predates
-    // its introduction and RFC99, and can be useful in RFC7946 mode due to
-    // coordinate reprojection.
-    OGRGeometry *poOrigGeom = poFeature->GetGeometryRef();
-    if (OGRGeometryFactory::haveGEOS() &&
-        oWriteOptions_.nXYCoordPrecision >= 0 && poOrigGeom &&
-        wkbFlatten(poOrigGeom->getGeometryType()) != wkbPoint &&
-        IsValid(poOrigGeom))
+// Special processing to detect and repair invalid geometries due to
+// coordinate precision.
+// Normally drivers shouldn't do that as similar code is triggered by
+// setting the OGR_APPLY_GEOM_SET_PRECISION=YES configuration option by
+// the generic OGRLayer::CreateFeature() code path. But this code predates
+// its introduction and RFC99, and can be useful in RFC7946 mode due to
+// coordinate reprojection.
+// Returns a geometry to write instead of poGeomToWrite, or nullptr.
+// This method may be called concurrently from several threads.
+std::unique_ptr<OGRGeometry> OGRGeoJSONWriteLayer::RepairGeometryForPrecision(
+    OGRGeometry *poOrigGeom, const OGRGeometry *poGeomToWrite,
+    bool bGeomTransformed) const
+{
+    std::unique_ptr<OGRGeometry> poValidGeom;
+    if (MightNeedGeometryRepair(poOrigGeom) &&
+        OGRGeoJSONWriteLayerIsValid(poOrigGeom))
     {
         const double dfXYResolution =
             std::pow(10.0, double(-oWriteOptions_.nXYCoordPrecision));
-        auto poNewGeom = std::unique_ptr<OGRGeometry>(
-            poFeatureToWrite->GetGeometryRef()->clone());
+        auto poNewGeom = std::unique_ptr<OGRGeometry>(poGeomToWrite->clone());
         OGRGeomCoordinatePrecision sPrecision;
         sPrecision.dfXYResolution = dfXYResolution;
         poNewGeom->roundCoordinates(sPrecision);
-        if (!IsValid(poNewGeom.get()))
+        if (!OGRGeoJSONWriteLayerIsValid(poNewGeom.get()))
         {
-            std::unique_ptr<OGRGeometry> poValidGeom;
-            if (poFeature == poFeatureToWrite)
+            if (!bGeomTransformed)
             {
                 CPLDebug("GeoJSON",
                          "Running SetPrecision() to correct an invalid "
@@ -266,7 +246,8 @@ OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
                     auto poValidGeomRoundCoordinates =
                         std::unique_ptr<OGRGeometry>(poValidGeom->clone());
                     poValidGeomRoundCoordinates->roundCoordinates(sPrecision);
-                    if (!IsValid(poValidGeomRoundCoordinates.get()))
+                    if (!OGRGeoJSONWriteLayerIsValid(
+                            poValidGeomRoundCoordinates.get()))
                     {
                         CPLDebug("GeoJSON",
                                  "Running SetPrecision() to correct an invalid "
@@ -279,26 +260,19 @@ OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
                     }
                 }
             }
-            if (poValidGeom)
-            {
-                if (poFeature == poFeatureToWrite)
-                {
-                    poFeatureToWrite = new OGRFeature(poFeatureDefn_);
-                    poFeatureToWrite->SetFrom(poFeature);
-                    poFeatureToWrite->SetFID(poFeature->GetFID());
-                }
-                poFeatureToWrite->SetGeometryDirectly(poValidGeom.release());
-            }
         }
     }
+    return poValidGeom;
+}
 
-    if (oWriteOptions_.bGenerateID && poFeatureToWrite->GetFID() == OGRNullFID)
-    {
-        poFeatureToWrite->SetFID(nOutCounter_);
-    }
-    json_object *poObj =
-        OGRGeoJSONWriteFeature(poFeatureToWrite, oWriteOptions_);
-    CPLAssert(nullptr != poObj);
+/************************************************************************/
+/*                       WriteSerializedFeature()                       */
+/************************************************************************/
+
+OGRErr OGRGeoJSONWriteLayer::WriteSerializedFeature(const char *pszJson,
+                                                    size_t nLen)
+{
+    VSILFILE *fp = poDS_->GetOutputFile();
 
     if (m_nPositionBeforeFCClosed)
     {
@@ -312,15 +286,8 @@ OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
         /* Separate "Feature" entries in "FeatureCollection" object. */
         VSIFPrintfL(fp, ",\n");
     }
-    const char *pszJson = json_object_to_json_string_ext(
-        poObj, JSON_C_TO_STRING_SPACED
-#ifdef JSON_C_TO_STRING_NOSLASHESCAPE
-                   | JSON_C_TO_STRING_NOSLASHESCAPE
-#endif
-    );
 
     OGRErr eErr = OGRERR_NONE;
-    size_t nLen = strlen(pszJson);
     if (!osForeignMembers_.empty())
     {
         if (nLen > 2 && pszJson[nLen - 2] == ' ' && pszJson[nLen - 1] == '}')
@@ -351,67 +318,52 @@ OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
         eErr = OGRERR_FAILURE;
     }
 
-    json_object_put(poObj);
-
     ++nOutCounter_;
 
-    OGRGeometry *poGeometry = poFeatureToWrite->GetGeometryRef();
-    if (poGeometry != nullptr && !poGeometry->IsEmpty())
-    {
-        OGREnvelope3D sEnvelope = OGRGeoJSONGetBBox(poGeometry, oWriteOptions_);
-        if (poGeometry->getCoordinateDimension() == 3)
-            bBBOX3D = true;
+    return eErr;
+}
 
-        if (!sEnvelopeLayer.IsInit())
-        {
-            sEnvelopeLayer = sEnvelope;
-        }
-        else if (oWriteOptions_.bBBOXRFC7946)
+/************************************************************************/
+/*                           MergeEnvelope()                            */
+/************************************************************************/
+
+void OGRGeoJSONWriteLayer::MergeEnvelope(const OGREnvelope3D &sEnvelope,
+                                         bool b3D)
+{
+    if (b3D)
+        bBBOX3D = true;
+
+    if (!sEnvelopeLayer.IsInit())
+    {
+        sEnvelopeLayer = sEnvelope;
+    }
+    else if (oWriteOptions_.bBBOXRFC7946)
+    {
+        const bool bEnvelopeCrossAM = (sEnvelope.MinX > sEnvelope.MaxX);
+        const bool bEnvelopeLayerCrossAM =
+            (sEnvelopeLayer.MinX > sEnvelopeLayer.MaxX);
+        if (bEnvelopeCrossAM)
         {
-            const bool bEnvelopeCrossAM = (sEnvelope.MinX > sEnvelope.MaxX);
-            const bool bEnvelopeLayerCrossAM =
-                (sEnvelopeLayer.MinX > sEnvelopeLayer.MaxX);
-            if (bEnvelopeCrossAM)
+            if (bEnvelopeLayerCrossAM)
             {
-                if (bEnvelopeLayerCrossAM)
-                {
-                    sEnvelopeLayer.MinX =
-                        std::min(sEnvelopeLayer.MinX, sEnvelope.MinX);
-                    sEnvelopeLayer.MaxX =
-                        std::max(sEnvelopeLayer.MaxX, sEnvelope.MaxX);
-                }
-                else
-                {
-                    if (sEnvelopeLayer.MinX > 0)
-                    {
-                        sEnvelopeLayer.MinX =
-                            std::min(sEnvelopeLayer.MinX, sEnvelope.MinX);
-                        sEnvelopeLayer.MaxX = sEnvelope.MaxX;
-                    }
-                    else if (sEnvelopeLayer.MaxX < 0)
-                    {
-                        sEnvelopeLayer.MaxX =
-                            std::max(sEnvelopeLayer.MaxX, sEnvelope.MaxX);
-                        sEnvelopeLayer.MinX = sEnvelope.MinX;
-                    }
-                    else
-                    {
-                        sEnvelopeLayer.MinX = -180.0;
-                        sEnvelopeLayer.MaxX = 180.0;
-                    }
-                }
+                sEnvelopeLayer.MinX =
+                    std::min(sEnvelopeLayer.MinX, sEnvelope.MinX);
+                sEnvelopeLayer.MaxX =
+                    std::max(sEnvelopeLayer.MaxX, sEnvelope.MaxX);
             }
-            else if (bEnvelopeLayerCrossAM)
+            else
             {
-                if (sEnvelope.MinX > 0)
+                if (sEnvelopeLayer.MinX > 0)
                 {
                     sEnvelopeLayer.MinX =
                         std::min(sEnvelopeLayer.MinX, sEnvelope.MinX);
+                    sEnvelopeLayer.MaxX = sEnvelope.MaxX;
                 }
-                else if (sEnvelope.MaxX < 0)
+                else if (sEnvelopeLayer.MaxX < 0)
                 {
                     sEnvelopeLayer.MaxX =
                         std::max(sEnvelopeLayer.MaxX, sEnvelope.MaxX);
+                    sEnvelopeLayer.MinX = sEnvelope.MinX;
                 }
                 else
                 {
@@ -419,21 +371,254 @@ OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
                     sEnvelopeLayer.MaxX = 180.0;
                 }
             }
-            else
+        }
+        else if (bEnvelopeLayerCrossAM)
+        {
+            if (sEnvelope.MinX > 0)
             {
                 sEnvelopeLayer.MinX =
                     std::min(sEnvelopeLayer.MinX, sEnvelope.MinX);
+            }
+            else if (sEnvelope.MaxX < 0)
+            {
                 sEnvelopeLayer.MaxX =
                     std::max(sEnvelopeLayer.MaxX, sEnvelope.MaxX);
             }
+            else
+            {
+                sEnvelopeLayer.MinX = -180.0;
+                sEnvelopeLayer.MaxX = 180.0;
+            }
+        }
+        else
+        {
+            sEnvelopeLayer.MinX = std::min(sEnvelopeLayer.MinX, sEnvelope.MinX);
+            sEnvelopeLayer.MaxX = std::max(sEnvelopeLayer.MaxX, sEnvelope.MaxX);
+        }
+
+        sEnvelopeLayer.MinY = std::min(sEnvelopeLayer.MinY, sEnvelope.MinY);
+        sEnvelopeLayer.MaxY = std::max(sEnvelopeLayer.MaxY, sEnvelope.MaxY);
+    }
+    else
+    {
+        sEnvelopeLayer.Merge(sEnvelope);
+    }
+}
+
+/************************************************************************/
+/*                        EncodePendingFeature()                        */
+/************************************************************************/
+
+// Called from worker threads.
+void OGRGeoJSONWriteLayer::EncodePendingFeature(PendingFeature &oPending) const
+{
+    OGRFeature *poFeatureToWrite = oPending.poFeature.get();
+    OGRGeometry *poGeometry = poFeatureToWrite->GetGeometryRef();
+    auto poValidGeom = RepairGeometryForPrecision(
+        oPending.poOrigGeom ? oPending.poOrigGeom.get() : poGeometry,
+        poGeometry, oPending.poOrigGeom != nullptr);
+    if (poValidGeom)
+    {
+        poFeatureToWrite->SetGeometryDirectly(poValidGeom.release());
+        poGeometry = poFeatureToWrite->GetGeometryRef();
+    }
+    oPending.poOrigGeom.reset();
+
+    json_object *poObj =
+        OGRGeoJSONWriteFeature(poFeatureToWrite, oWriteOptions_);
+    CPLAssert(nullptr != poObj);
+    oPending.osJSON = json_object_to_json_string_ext(
+        poObj, JSON_C_TO_STRING_SPACED
+#ifdef JSON_C_TO_STRING_NOSLASHESCAPE
+                   | JSON_C_TO_STRING_NOSLASHESCAPE
+#endif
+    );
+    json_object_put(poObj);
+
+    if (poGeometry != nullptr && !poGeometry->IsEmpty())
+    {
+        oPending.sEnvelope = OGRGeoJSONGetBBox(poGeometry, oWriteOptions_);
+        oPending.bHasEnvelope = true;
+        oPending.b3D = poGeometry->getCoordinateDimension() == 3;
+    }
+
+    oPending.poFeature.reset();
+}
+
+/************************************************************************/
+/*                        FlushPendingFeatures()                        */
+/************************************************************************/
+
+// Serialize pending features with worker threads, and write them in order.
+OGRErr OGRGeoJSONWriteLayer::FlushPendingFeatures()
+{
+    if (m_aoPendingFeatures.empty())
+        return OGRERR_NONE;
+
+    const size_t nFeatures = m_aoPendingFeatures.size();
+    const size_t nJobs =
+        std::min(static_cast<size_t>(m_nNumThreads), nFeatures);
+    std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(m_nNumThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        const size_t iStart = nFeatures * iJob / nJobs;
+        const size_t iEnd = nFeatures * (iJob + 1) / nJobs;
+        const auto EncodeRange = [this, &aoErrorAccumulators, iJob, iStart,
+                                  iEnd]()
+        {
+            auto oAccumulator =
+                aoErrorAccumulators[iJob].InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oAccumulator);
+            for (size_t i = iStart; i < iEnd; ++i)
+                EncodePendingFeature(m_aoPendingFeatures[i]);
+        };
+        if (!poJobQueue || !poJobQueue->SubmitJob(EncodeRange))
+            EncodeRange();
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    for (auto &oAccumulator : aoErrorAccumulators)
+        oAccumulator.ReplayErrors();
+
+    OGRErr eErr = OGRERR_NONE;
+    for (const auto &oPending : m_aoPendingFeatures)
+    {
+        if (WriteSerializedFeature(oPending.osJSON.c_str(),
+                                   oPending.osJSON.size()) != OGRERR_NONE)
+        {
+            eErr = OGRERR_FAILURE;
+        }
+        if (oPending.bHasEnvelope)
+            MergeEnvelope(oPending.sEnvelope, oPending.b3D);
+    }
+    m_aoPendingFeatures.clear();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                           ICreateFeature()                            */
+/************************************************************************/
+
+OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    OGRFeature *poFeatureToWrite;
+    if (poCT_ != nullptr || bRFC7946_)
+    {
+        poFeatureToWrite = new OGRFeature(poFeatureDefn_);
+        poFeatureToWrite->SetFrom(poFeature);
+        poFeatureToWrite->SetFID(poFeature->GetFID());
+        OGRGeometry *poGeometry = poFeatureToWrite->GetGeometryRef();
+        if (poGeometry)
+        {
+            const char *const apszOptions[] = {
+                bWrapDateLine_ ? "WRAPDATELINE=YES" : nullptr, nullptr};
+            OGRGeometry *poNewGeom = OGRGeometryFactory::transformWithOptions(
+                poGeometry, poCT_, const_cast<char **>(apszOptions),
+                oTransformCache_);
+            if (poNewGeom == nullptr)
+            {
+                delete poFeatureToWrite;
+                return OGRERR_FAILURE;
+            }
+
+            OGREnvelope sEnvelope;
+            poNewGeom->getEnvelope(&sEnvelope);
+            if (sEnvelope.MinX < -180.0 || sEnvelope.MaxX > 180.0 ||
+                sEnvelope.MinY < -90.0 || sEnvelope.MaxY > 90.0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Geometry extent outside of "
+                         "[-180.0,180.0]x[-90.0,90.0] bounds");
+                delete poFeatureToWrite;
+                return OGRERR_FAILURE;
+            }
+
+            poFeatureToWrite->SetGeometryDirectly(poNewGeom);
+        }
+    }
+    else
+    {
+        poFeatureToWrite = poFeature;
+    }
 
-            sEnvelopeLayer.MinY = std::min(sEnvelopeLayer.MinY, sEnvelope.MinY);
-            sEnvelopeLayer.MaxY = std::max(sEnvelopeLayer.MaxY, sEnvelope.MaxY);
+    // Once a first batch of features has been written synchronously, the
+    // (potentially costly) geometry repair and JSON serialization steps
+    // are deferred to worker threads, which process batches of features.
+    // Coordinate transformation is not thread-safe and is kept above.
+    const size_t nBatchSize =
+        static_cast<size_t>(m_nNumThreads) * FEATURES_PER_THREAD_BATCH;
+    if (m_nNumThreads >= 2 && static_cast<size_t>(nOutCounter_) >= nBatchSize)
+    {
+        PendingFeature oPending;
+        OGRGeometry *poOrigGeom = poFeature->GetGeometryRef();
+        if (poFeatureToWrite != poFeature)
+        {
+            oPending.poFeature.reset(poFeatureToWrite);
+            if (MightNeedGeometryRepair(poOrigGeom))
+                oPending.poOrigGeom.reset(poOrigGeom->clone());
         }
         else
         {
-            sEnvelopeLayer.Merge(sEnvelope);
+            oPending.poFeature.reset(poFeature->Clone());
+        }
+        if (oWriteOptions_.bGenerateID &&
+            oPending.poFeature->GetFID() == OGRNullFID)
+        {
+            const GIntBig nFID =
+                nOutCounter_ + static_cast<int>(m_aoPendingFeatures.size());
+            oPending.poFeature->SetFID(nFID);
+            poFeature->SetFID(nFID);
         }
+        m_aoPendingFeatures.push_back(std::move(oPending));
+        if (m_aoPendingFeatures.size() >= nBatchSize)
+            return FlushPendingFeatures();
+        return OGRERR_NONE;
+    }
+
+    OGRGeometry *poOrigGeom = poFeature->GetGeometryRef();
+    auto poValidGeom = RepairGeometryForPrecision(
+        poOrigGeom, poFeatureToWrite->GetGeometryRef(),
+        poFeatureToWrite != poFeature);
+    if (poValidGeom)
+    {
+        if (poFeature == poFeatureToWrite)
+        {
+            poFeatureToWrite = new OGRFeature(poFeatureDefn_);
+            poFeatureToWrite->SetFrom(poFeature);
+            poFeatureToWrite->SetFID(poFeature->GetFID());
+        }
+        poFeatureToWrite->SetGeometryDirectly(poValidGeom.release());
+    }
+
+    if (oWriteOptions_.bGenerateID && poFeatureToWrite->GetFID() == OGRNullFID)
+    {
+        poFeatureToWrite->SetFID(nOutCounter_);
+    }
+    json_object *poObj =
+        OGRGeoJSONWriteFeature(poFeatureToWrite, oWriteOptions_);
+    CPLAssert(nullptr != poObj);
+
+    const char *pszJson = json_object_to_json_string_ext(
+        poObj, JSON_C_TO_STRING_SPACED
+#ifdef JSON_C_TO_STRING_NOSLASHESCAPE
+                   | JSON_C_TO_STRING_NOSLASHESCAPE
+#endif
+    );
+
+    const OGRErr eErr = WriteSerializedFeature(pszJson, strlen(pszJson));
+
+    json_object_put(poObj);
+
+    OGRGeometry *poGeometry = poFeatureToWrite->GetGeometryRef();
+    if (poGeometry != nullptr && !poGeometry->IsEmpty())
+    {
+        MergeEnvelope(OGRGeoJSONGetBBox(poGeometry, oWriteOptions_),
+                      poGeometry->getCoordinateDimension() == 3);
     }
 
     if (poFeatureToWrite != poFeature)
@@ -449,6 +634,9 @@ OGRErr OGRGeoJSONWriteLayer::ICreateFeature(OGRFeature *poFeature)
 OGRErr OGRGeoJSONWriteLayer::CreateField(const OGRFieldDefn *poField,
                                          int /* bApproxOK */)
 {
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
     if (poFeatureDefn_->GetFieldIndexCaseSensitive(poField->GetNameRef()) >= 0)
     {
         CPLDebug("GeoJSON", "Field '%s' already present in schema",
@@ -485,6 +673,9 @@ int OGRGeoJSONWriteLayer::TestCapability(const char *pszCap)
 OGRErr OGRGeoJSONWriteLayer::IGetExtent(int /*iGeomField*/,
                                         OGREnvelope *psExtent, bool)
 {
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
     if (sEnvelopeLayer.IsInit())
     {
         *psExtent = sEnvelopeLayer;
@@ -19,14 +19,18 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <memory>
 #include <set>
 #include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "gmlutils.h"
 #include "ogr_geometry.h"
 
@@ -42,6 +46,21 @@ IGMLReader::~IGMLReader()
 {
 }
 
+/************************************************************************/
+/*                          GMLGetNumThreads()                          */
+/*                                                                      */
+/*      Number of threads used to build geometries when reading, and    */
+/*      to encode them when writing. OGR_GML_NUM_THREADS has precedence */
+/*      over GDAL_NUM_THREADS.                                          */
+/************************************************************************/
+
+int GMLGetNumThreads()
+{
+    return GDALGetNumThreads(
+        nullptr, nullptr, "OGR_GML_NUM_THREADS",
+        GDALGetNumThreads(nullptr, nullptr, "GDAL_NUM_THREADS", 1));
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                  No XERCES or EXPAT Library                          */
@@ -1265,6 +1284,10 @@ bool GMLReader::SaveClasses(const char *pszFile)
     return bSuccess;
 }
 
+// Number of features whose geometries are built concurrently by
+// PrescanForSchema()
+constexpr size_t PRESCAN_BATCH_SIZE = 1024;
+
 /************************************************************************/
 /*                          PrescanForSchema()                          */
 /*                                                                      */
@@ -1305,90 +1328,182 @@ bool GMLReader::PrescanForSchema(bool bGetExtents, bool bOnlyDetectSRS)
         m_papoClass[i]->SetSRSName(nullptr);
     }
 
-    GMLFeature *poFeature = nullptr;
     std::set<GMLFeatureClass *> knownClasses;
     bool bFoundPerFeatureSRSName = false;
 
-    while ((poFeature = NextFeature()) != nullptr)
+    // Building the geometries to get their type and extent is the costly
+    // part of the prescan. Features are read by batches, whose geometries
+    // are built by worker threads, and then merged in reading order.
+    struct PrescanFeature
+    {
+        std::unique_ptr<GMLFeature> poFeature{};
+        bool bGeometryColumnJustCreated = false;
+        std::vector<const CPLXMLNode *> apsGeometries{};
+        std::vector<std::unique_ptr<OGRGeometry>> apoGeometries{};
+    };
+
+    std::vector<PrescanFeature> aoBatch;
+    const int nThreads = bGetExtents ? GMLGetNumThreads() : 1;
+    auto poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    const size_t nMaxBatchSize = poJobQueue ? PRESCAN_BATCH_SIZE : 1;
+    std::vector<void *> ahCacheSRSWorkers;
+    if (poJobQueue)
     {
-        GMLFeatureClass *poClass = poFeature->GetClass();
+        for (int i = 0; i < nThreads; ++i)
+            ahCacheSRSWorkers.push_back(
+                GML_BuildOGRGeometryFromList_CreateCache());
+    }
 
-        if (knownClasses.find(poClass) == knownClasses.end())
+    const auto BuildGeometries = [this](PrescanFeature &oFeature,
+                                        void *hCacheSRSIn)
+    {
+        for (const CPLXMLNode *psGeom : oFeature.apsGeometries)
         {
-            knownClasses.insert(poClass);
-            if (m_pszGlobalSRSName && GML_IsLegitSRSName(m_pszGlobalSRSName))
+            std::unique_ptr<OGRGeometry> poGeometry;
+            if (psGeom != nullptr)
             {
-                poClass->SetSRSName(m_pszGlobalSRSName);
+                const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
+                poGeometry.reset(GML_BuildOGRGeometryFromList(
+                    myGeometryList, true, m_bInvertAxisOrderIfLatLong, nullptr,
+                    m_bConsiderEPSGAsURN, m_eSwapCoordinates,
+                    m_bGetSecondaryGeometryOption, hCacheSRSIn,
+                    m_bFaceHoleNegative));
             }
+            oFeature.apoGeometries.push_back(std::move(poGeometry));
         }
+    };
 
-        if (poLastClass != nullptr && poClass != poLastClass &&
-            poClass->GetFeatureCount() != -1)
-            m_nHasSequentialLayers = false;
-        poLastClass = poClass;
+    while (true)
+    {
+        aoBatch.clear();
+        GMLFeature *poFeature = nullptr;
+        while (aoBatch.size() < nMaxBatchSize &&
+               (poFeature = NextFeature()) != nullptr)
+        {
+            aoBatch.emplace_back();
+            PrescanFeature &oFeature = aoBatch.back();
+            oFeature.poFeature.reset(poFeature);
 
-        if (poClass->GetFeatureCount() == -1)
-            poClass->SetFeatureCount(1);
-        else
-            poClass->SetFeatureCount(poClass->GetFeatureCount() + 1);
+            GMLFeatureClass *poClass = poFeature->GetClass();
 
-        const CPLXMLNode *const *papsGeometry = poFeature->GetGeometryList();
-        bool bGeometryColumnJustCreated = false;
+            if (knownClasses.find(poClass) == knownClasses.end())
+            {
+                knownClasses.insert(poClass);
+                if (m_pszGlobalSRSName &&
+                    GML_IsLegitSRSName(m_pszGlobalSRSName))
+                {
+                    poClass->SetSRSName(m_pszGlobalSRSName);
+                }
+            }
 
-        const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
-        const CPLXMLNode *psBoundedByGeometry =
-            poFeature->GetBoundedByGeometry();
-        int nFeatureGeomCount = poFeature->GetGeometryCount();
-        if (psBoundedByGeometry && nFeatureGeomCount == 0 &&
-            strcmp(psBoundedByGeometry->pszValue, "null") != 0)
-        {
-            apsGeometries[0] = psBoundedByGeometry;
-            papsGeometry = apsGeometries;
-            nFeatureGeomCount = 1;
-        }
+            if (poLastClass != nullptr && poClass != poLastClass &&
+                poClass->GetFeatureCount() != -1)
+                m_nHasSequentialLayers = false;
+            poLastClass = poClass;
 
-        if (!bOnlyDetectSRS && papsGeometry != nullptr &&
-            papsGeometry[0] != nullptr)
-        {
-            if (poClass->GetGeometryPropertyCount() == 0)
+            if (poClass->GetFeatureCount() == -1)
+                poClass->SetFeatureCount(1);
+            else
+                poClass->SetFeatureCount(poClass->GetFeatureCount() + 1);
+
+            const CPLXMLNode *const *papsGeometry =
+                poFeature->GetGeometryList();
+
+            const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
+            const CPLXMLNode *psBoundedByGeometry =
+                poFeature->GetBoundedByGeometry();
+            int nFeatureGeomCount = poFeature->GetGeometryCount();
+            if (psBoundedByGeometry && nFeatureGeomCount == 0 &&
+                strcmp(psBoundedByGeometry->pszValue, "null") != 0)
             {
-                std::string osPath(poClass->GetSingleGeomElemPath());
-                if (osPath.empty() &&
-                    poClass->IsConsistentSingleGeomElemPath() &&
-                    papsGeometry[0] == psBoundedByGeometry)
+                apsGeometries[0] = psBoundedByGeometry;
+                papsGeometry = apsGeometries;
+                nFeatureGeomCount = 1;
+            }
+
+            if (!bOnlyDetectSRS && papsGeometry != nullptr &&
+                papsGeometry[0] != nullptr)
+            {
+                if (poClass->GetGeometryPropertyCount() == 0)
                 {
-                    osPath = "boundedBy";
+                    std::string osPath(poClass->GetSingleGeomElemPath());
+                    if (osPath.empty() &&
+                        poClass->IsConsistentSingleGeomElemPath() &&
+                        papsGeometry[0] == psBoundedByGeometry)
+                    {
+                        osPath = "boundedBy";
+                    }
+                    std::string osGeomName(osPath);
+                    const auto nPos = osGeomName.rfind('|');
+                    if (nPos != std::string::npos)
+                        osGeomName = osGeomName.substr(nPos + 1);
+                    oFeature.bGeometryColumnJustCreated = true;
+                    poClass->AddGeometryProperty(new GMLGeometryPropertyDefn(
+                        osGeomName.c_str(), osPath.c_str(), wkbUnknown, -1,
+                        true));
                 }
-                std::string osGeomName(osPath);
-                const auto nPos = osGeomName.rfind('|');
-                if (nPos != std::string::npos)
-                    osGeomName = osGeomName.substr(nPos + 1);
-                bGeometryColumnJustCreated = true;
-                poClass->AddGeometryProperty(new GMLGeometryPropertyDefn(
-                    osGeomName.c_str(), osPath.c_str(), wkbUnknown, -1, true));
+            }
+
+            if (bGetExtents && papsGeometry != nullptr)
+            {
+                const int nIters = std::min(
+                    nFeatureGeomCount, poClass->GetGeometryPropertyCount());
+                oFeature.apsGeometries.assign(papsGeometry,
+                                              papsGeometry + nIters);
             }
         }
 
-        if (bGetExtents && papsGeometry != nullptr)
+        if (aoBatch.empty())
+            break;
+
+        if (poJobQueue && aoBatch.size() > 1)
         {
-            const int nIters = std::min(nFeatureGeomCount,
-                                        poClass->GetGeometryPropertyCount());
-            for (int i = 0; i < nIters; ++i)
+            const size_t nJobs =
+                std::min(aoBatch.size(), ahCacheSRSWorkers.size());
+            std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+            for (size_t iJob = 0; iJob < nJobs; ++iJob)
             {
-                if (papsGeometry[i] == nullptr)
-                    continue;
+                const size_t iStart = iJob * aoBatch.size() / nJobs;
+                const size_t iEnd = (iJob + 1) * aoBatch.size() / nJobs;
+                void *hCacheSRSWorker = ahCacheSRSWorkers[iJob];
+                auto &oErrorAccumulator = aoErrorAccumulators[iJob];
+                poJobQueue->SubmitJob(
+                    [&aoBatch, &BuildGeometries, &oErrorAccumulator, iStart,
+                     iEnd, hCacheSRSWorker]()
+                    {
+                        auto oAccumulator =
+                            oErrorAccumulator.InstallForCurrentScope();
+                        CPL_IGNORE_RET_VAL(oAccumulator);
+                        for (size_t i = iStart; i < iEnd; ++i)
+                            BuildGeometries(aoBatch[i], hCacheSRSWorker);
+                    });
+            }
+            poJobQueue->WaitCompletion();
+            for (size_t iJob = 0; iJob < nJobs; ++iJob)
+                aoErrorAccumulators[iJob].ReplayErrors();
+        }
+        else
+        {
+            for (auto &oFeature : aoBatch)
+                BuildGeometries(oFeature, hCacheSRS);
+        }
 
-                const CPLXMLNode *myGeometryList[2] = {papsGeometry[i],
-                                                       nullptr};
-                OGRGeometry *poGeometry = GML_BuildOGRGeometryFromList(
-                    myGeometryList, true, m_bInvertAxisOrderIfLatLong, nullptr,
-                    m_bConsiderEPSGAsURN, m_eSwapCoordinates,
-                    m_bGetSecondaryGeometryOption, hCacheSRS,
-                    m_bFaceHoleNegative);
+        for (auto &oFeature : aoBatch)
+        {
+            GMLFeatureClass *poClass = oFeature.poFeature->GetClass();
+            for (size_t i = 0; i < oFeature.apoGeometries.size(); ++i)
+            {
+                const OGRGeometry *poGeometry = oFeature.apoGeometries[i].get();
                 if (poGeometry == nullptr)
                     continue;
 
-                auto poGeomProperty = poClass->GetGeometryProperty(i);
+                const CPLXMLNode *myGeometryList[2] = {
+                    oFeature.apsGeometries[i], nullptr};
+
+                auto poGeomProperty =
+                    poClass->GetGeometryProperty(static_cast<int>(i));
                 OGRwkbGeometryType eGType =
                     static_cast<OGRwkbGeometryType>(poGeomProperty->GetType());
 
@@ -1412,7 +1527,7 @@ bool GMLReader::PrescanForSchema(bool bGetExtents, bool bOnlyDetectSRS)
                 }
 
                 // Merge geometry type into layer.
-                if (bGeometryColumnJustCreated)
+                if (oFeature.bGeometryColumnJustCreated)
                 {
                     poGeomProperty->SetType(poGeometry->getGeometryType());
                 }
@@ -1450,13 +1565,12 @@ bool GMLReader::PrescanForSchema(bool bGetExtents, bool bOnlyDetectSRS)
 
                     poClass->SetExtents(dfXMin, dfXMax, dfYMin, dfYMax);
                 }
-                delete poGeometry;
             }
         }
-
-        delete poFeature;
     }
 
+    for (void *hCacheSRSWorker : ahCacheSRSWorkers)
+        GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRSWorker);
     GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRS);
 
     if (bGetExtents && m_bCanUseGlobalSRSName && m_pszGlobalSRSName &&
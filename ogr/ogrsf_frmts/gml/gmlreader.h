@@ -94,4 +94,6 @@ IGMLReader *CreateGMLReader(bool bUseExpatParserPreferably,
                             GMLSwapCoordinatesEnum eSwapCoordinates,
                             bool bGetSecondaryGeometryOption);
 
+int GMLGetNumThreads();
+
 #endif /* GMLREADER_H_INCLUDED */
@@ -16,10 +16,15 @@
 #define OGR_GML_H_INCLUDED
 
 #include "ogrsf_frmts.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
 #include "gmlreader.h"
 #include "gmlutils.h"
 
+#include <deque>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 class OGRGMLDataSource;
@@ -55,6 +60,55 @@ class OGRGMLLayer final : public OGRLayer
 
     bool bFaceHoleNegative;
 
+    // GML feature with its geometries, built in advance by a worker thread
+    // when reading ahead.
+    struct ReadAheadFeature
+    {
+        std::unique_ptr<GMLFeature> poGMLFeature{};
+        bool bGeometriesBuilt = false;
+        bool bGeometryError = false;
+        std::string osGeometryErrorMsg{};
+        std::vector<std::unique_ptr<OGRGeometry>> apoGeometries{};
+    };
+
+    // 0 = not determined yet, 1 = no read ahead
+    int m_nReadAheadThreads = 0;
+    bool m_bReadAheadEOF = false;
+    std::deque<ReadAheadFeature> m_aoReadAheadReady{};
+    std::vector<ReadAheadFeature> m_aoReadAheadInFlight{};
+    std::vector<std::unique_ptr<CPLErrorAccumulator>> m_apoErrorAccumulators{};
+    std::vector<void *> m_ahCacheSRSWorkers{};
+    CPLJobQueuePtr m_poJobQueue{};
+
+    void BuildGeometries(ReadAheadFeature &oFeature, void *hCacheSRSIn);
+    bool GetNextReadAheadFeature(ReadAheadFeature &oFeature);
+    void ClearReadAhead();
+
+    // Feature whose geometries are encoded to GML by a worker thread,
+    // before being written in order by FlushPendingFeatures().
+    struct PendingFeature
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        // Empty string if the export of the geometry failed
+        std::vector<std::string> aosGeometries{};
+    };
+
+    // 0 = not determined yet, 1 = features written directly
+    int m_nWriteThreads = 0;
+    std::vector<PendingFeature> m_aoPendingFeatures{};
+    // Thread-safe copies of the SRS of pending geometries
+    std::vector<std::pair<std::unique_ptr<OGRSpatialReference,
+                                          OGRSpatialReferenceReleaser>,
+                          std::unique_ptr<OGRSpatialReference,
+                                          OGRSpatialReferenceReleaser>>>
+        m_aoThreadSafeSRS{};
+
+    OGRSpatialReference *GetThreadSafeSRS(const OGRSpatialReference *poSRS);
+    std::string ExportGeometryToGML(const OGRFeature *poFeature,
+                                    int iGeomField) const;
+    OGRErr WriteFeature(OGRFeature *poFeature,
+                        const std::vector<std::string> *paosGeometries);
+
     CPL_DISALLOW_COPY_ASSIGN(OGRGMLLayer)
 
   public:
@@ -84,6 +138,8 @@ class OGRGMLLayer final : public OGRLayer
                                    int bApproxOK = TRUE) override;
 
     int TestCapability(const char *) override;
+
+    bool FlushPendingFeatures();
 };
 
 /************************************************************************/
@@ -97,6 +153,9 @@ class OGRGMLDataSource final : public GDALDataset
 
     OGRGMLLayer *TranslateGMLSchema(GMLFeatureClass *);
 
+    // Layer whose features are buffered to be encoded by worker threads
+    OGRGMLLayer *m_poLayerWithPendingFeatures = nullptr;
+
     char **papszCreateOptions;
 
     // output related parameters
@@ -223,6 +282,14 @@ class OGRGMLDataSource final : public GDALDataset
         return bIsOutputGML32;
     }
 
+    bool IsOutputNonSeekable() const
+    {
+        return bFpOutputIsNonSeekable;
+    }
+
+    bool SetLayerWithPendingFeatures(OGRGMLLayer *poLayer);
+    bool FlushPendingFeatures();
+
     /** Returns whether a writing error has occurred */
     inline bool HasWriteError() const
     {
@@ -98,6 +98,9 @@ CPLErr OGRGMLDataSource::Close()
     CPLErr eErr = CE_None;
     if (nOpenFlags != OPEN_FLAGS_CLOSED)
     {
+        if (!FlushPendingFeatures())
+            eErr = CE_Failure;
+
         if (fpOutput && !m_bWriteError)
         {
             if (nLayers == 0)
@@ -2215,6 +2218,32 @@ void OGRGMLDataSource::DeclareNewWriteSRS(const OGRSpatialReference *poSRS)
     }
 }
 
+/************************************************************************/
+/*                    SetLayerWithPendingFeatures()                     */
+/************************************************************************/
+
+// Register the layer that buffers features to be written, after having
+// written the features buffered by another layer.
+bool OGRGMLDataSource::SetLayerWithPendingFeatures(OGRGMLLayer *poLayer)
+{
+    if (m_poLayerWithPendingFeatures == poLayer)
+        return true;
+    const bool bRet = FlushPendingFeatures();
+    m_poLayerWithPendingFeatures = poLayer;
+    return bRet;
+}
+
+/************************************************************************/
+/*                        FlushPendingFeatures()                        */
+/************************************************************************/
+
+bool OGRGMLDataSource::FlushPendingFeatures()
+{
+    OGRGMLLayer *poLayer = m_poLayerWithPendingFeatures;
+    m_poLayerWithPendingFeatures = nullptr;
+    return poLayer == nullptr || poLayer->FlushPendingFeatures();
+}
+
 /************************************************************************/
 /*                           ICreateLayer()                             */
 /************************************************************************/
@@ -2235,6 +2264,9 @@ OGRGMLDataSource::ICreateLayer(const char *pszLayerName,
         return nullptr;
     }
 
+    if (!FlushPendingFeatures())
+        return nullptr;
+
     const auto eType =
         poSrcGeomFieldDefn ? poSrcGeomFieldDefn->GetType() : wkbNone;
     const auto poSRS =
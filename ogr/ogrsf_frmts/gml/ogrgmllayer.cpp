@@ -16,9 +16,19 @@
 #include "cpl_conv.h"
 #include "cpl_port.h"
 #include "cpl_string.h"
+#include "gdal_thread_pool.h"
 #include "ogr_p.h"
 #include "ogr_api.h"
 
+#include <algorithm>
+
+// Number of features read ahead, whose geometries are built concurrently
+constexpr size_t READ_AHEAD_BATCH_SIZE = 256;
+
+// Number of features buffered when writing, whose geometries are encoded
+// concurrently
+constexpr size_t WRITE_BATCH_SIZE = 256;
+
 /************************************************************************/
 /*                           OGRGMLLayer()                              */
 /************************************************************************/
@@ -53,12 +63,17 @@ OGRGMLLayer::OGRGMLLayer(const char *pszName, bool bWriterIn,
 OGRGMLLayer::~OGRGMLLayer()
 
 {
+    // Read-ahead jobs may still be using the feature definition
+    ClearReadAhead();
+
     CPLFree(pszFIDPrefix);
 
     if (poFeatureDefn)
         poFeatureDefn->Release();
 
     GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRS);
+    for (void *hCacheSRSWorker : m_ahCacheSRSWorkers)
+        GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRSWorker);
 }
 
 /************************************************************************/
@@ -71,6 +86,8 @@ void OGRGMLLayer::ResetReading()
     if (bWriter)
         return;
 
+    ClearReadAhead();
+
     if (poDS->GetReadMode() == INTERLEAVED_LAYERS ||
         poDS->GetReadMode() == SEQUENTIAL_LAYERS)
     {
@@ -97,6 +114,181 @@ void OGRGMLLayer::ResetReading()
     }
 }
 
+/************************************************************************/
+/*                          ClearReadAhead()                            */
+/************************************************************************/
+
+void OGRGMLLayer::ClearReadAhead()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    m_apoErrorAccumulators.clear();
+    m_aoReadAheadInFlight.clear();
+    m_aoReadAheadReady.clear();
+    m_bReadAheadEOF = false;
+}
+
+/************************************************************************/
+/*                          BuildGeometries()                           */
+/************************************************************************/
+
+// Build the geometries of a GML feature. This does not modify the state of
+// the layer, and can thus be called by worker threads, provided that each
+// one uses its own SRS cache.
+void OGRGMLLayer::BuildGeometries(ReadAheadFeature &oFeature,
+                                  void *hCacheSRSIn)
+{
+    const GMLFeature *poGMLFeature = oFeature.poGMLFeature.get();
+    oFeature.bGeometriesBuilt = true;
+
+    const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
+
+    const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
+    const CPLXMLNode *psBoundedByGeometry =
+        poGMLFeature->GetBoundedByGeometry();
+    if (psBoundedByGeometry && !(papsGeometry && papsGeometry[0]))
+    {
+        apsGeometries[0] = psBoundedByGeometry;
+        papsGeometry = apsGeometries;
+    }
+
+    const char *pszSRSName = poDS->GetGlobalSRSName();
+    if (poFeatureDefn->GetGeomFieldCount() > 1)
+    {
+        oFeature.apoGeometries.resize(poFeatureDefn->GetGeomFieldCount());
+        for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+        {
+            const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
+            if (psGeom != nullptr)
+            {
+                const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
+                OGRGeometry *poGeom = GML_BuildOGRGeometryFromList(
+                    myGeometryList, true, poDS->GetInvertAxisOrderIfLatLong(),
+                    pszSRSName, poDS->GetConsiderEPSGAsURN(),
+                    poDS->GetSwapCoordinates(),
+                    poDS->GetSecondaryGeometryOption(), hCacheSRSIn,
+                    bFaceHoleNegative);
+
+                // Do geometry type changes if needed to match layer
+                // geometry type.
+                if (poGeom != nullptr)
+                {
+                    oFeature.apoGeometries[i].reset(OGRGeometryFactory::forceTo(
+                        poGeom, poFeatureDefn->GetGeomFieldDefn(i)->GetType()));
+                }
+                else
+                {
+                    // We assume the createFromGML() function would have
+                    // already reported the error.
+                    oFeature.apoGeometries.clear();
+                    oFeature.bGeometryError = true;
+                    return;
+                }
+            }
+        }
+    }
+    else if (papsGeometry[0] &&
+             strcmp(papsGeometry[0]->pszValue, "null") == 0)
+    {
+        // do nothing
+    }
+    else if (papsGeometry[0] != nullptr)
+    {
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        OGRGeometry *poGeom = GML_BuildOGRGeometryFromList(
+            papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
+            pszSRSName, poDS->GetConsiderEPSGAsURN(),
+            poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
+            hCacheSRSIn, bFaceHoleNegative);
+        CPLPopErrorHandler();
+
+        // Do geometry type changes if needed to match layer geometry type.
+        if (poGeom != nullptr)
+        {
+            oFeature.apoGeometries.emplace_back(OGRGeometryFactory::forceTo(
+                poGeom, poFeatureDefn->GetGeomType()));
+        }
+        else
+        {
+            oFeature.bGeometryError = true;
+            oFeature.osGeometryErrorMsg = CPLGetLastErrorMsg();
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GetNextReadAheadFeature()                       */
+/************************************************************************/
+
+// Return the next feature of the layer, whose geometries have been built
+// by worker threads. The reading thread parses the next batch of features
+// while the previous one is processed by the workers.
+bool OGRGMLLayer::GetNextReadAheadFeature(ReadAheadFeature &oFeature)
+{
+    while (m_aoReadAheadReady.empty())
+    {
+        std::vector<ReadAheadFeature> aoNextBatch;
+        while (!m_bReadAheadEOF &&
+               aoNextBatch.size() < READ_AHEAD_BATCH_SIZE)
+        {
+            GMLFeature *poGMLFeature = poDS->GetReader()->NextFeature();
+            if (poGMLFeature == nullptr)
+            {
+                m_bReadAheadEOF = true;
+                break;
+            }
+            m_nFeaturesRead++;
+            if (poGMLFeature->GetClass() != poFClass)
+            {
+                delete poGMLFeature;
+                continue;
+            }
+            aoNextBatch.emplace_back();
+            aoNextBatch.back().poGMLFeature.reset(poGMLFeature);
+        }
+
+        if (m_aoReadAheadInFlight.empty() && aoNextBatch.empty())
+            return false;
+
+        m_poJobQueue->WaitCompletion();
+        for (auto &poErrorAccumulator : m_apoErrorAccumulators)
+            poErrorAccumulator->ReplayErrors();
+        m_apoErrorAccumulators.clear();
+        for (auto &oInFlight : m_aoReadAheadInFlight)
+            m_aoReadAheadReady.push_back(std::move(oInFlight));
+        m_aoReadAheadInFlight = std::move(aoNextBatch);
+
+        const size_t nFeatures = m_aoReadAheadInFlight.size();
+        const size_t nJobs = std::min(nFeatures, m_ahCacheSRSWorkers.size());
+        for (size_t iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const size_t iStart = iJob * nFeatures / nJobs;
+            const size_t iEnd = (iJob + 1) * nFeatures / nJobs;
+            void *hCacheSRSWorker = m_ahCacheSRSWorkers[iJob];
+            m_apoErrorAccumulators.push_back(
+                std::make_unique<CPLErrorAccumulator>());
+            CPLErrorAccumulator *poErrorAccumulator =
+                m_apoErrorAccumulators.back().get();
+            m_poJobQueue->SubmitJob(
+                [this, iStart, iEnd, hCacheSRSWorker, poErrorAccumulator]()
+                {
+                    auto oAccumulator =
+                        poErrorAccumulator->InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    for (size_t i = iStart; i < iEnd; ++i)
+                    {
+                        BuildGeometries(m_aoReadAheadInFlight[i],
+                                        hCacheSRSWorker);
+                    }
+                });
+        }
+    }
+
+    oFeature = std::move(m_aoReadAheadReady.front());
+    m_aoReadAheadReady.pop_front();
+    return true;
+}
+
 /************************************************************************/
 /*                              Increment()                             */
 /************************************************************************/
@@ -129,17 +321,46 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         poDS->SetLastReadLayer(this);
     }
 
+    // In the standard read mode, features of other layers are skipped, so
+    // features of this layer can be read ahead, and their geometries built
+    // by worker threads.
+    if (m_nReadAheadThreads == 0)
+    {
+        m_nReadAheadThreads = 1;
+        const int nThreads = poDS->GetReadMode() == STANDARD &&
+                                     poFeatureDefn->GetGeomFieldCount() > 0
+                                 ? GMLGetNumThreads()
+                                 : 1;
+        auto poThreadPool =
+            nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+        if (poThreadPool)
+        {
+            m_poJobQueue = poThreadPool->CreateJobQueue();
+            m_nReadAheadThreads = nThreads;
+            for (int i = 0; i < nThreads; ++i)
+                m_ahCacheSRSWorkers.push_back(
+                    GML_BuildOGRGeometryFromList_CreateCache());
+        }
+    }
+
     /* ==================================================================== */
     /*      Loop till we find and translate a feature meeting all our       */
     /*      requirements.                                                   */
     /* ==================================================================== */
     while (true)
     {
+        ReadAheadFeature oReadAheadFeature;
         GMLFeature *poGMLFeature = poDS->PeekStoredGMLFeature();
         if (poGMLFeature != nullptr)
         {
             poDS->SetStoredGMLFeature(nullptr);
         }
+        else if (m_nReadAheadThreads > 1)
+        {
+            if (!GetNextReadAheadFeature(oReadAheadFeature))
+                return nullptr;
+            poGMLFeature = oReadAheadFeature.poGMLFeature.release();
+        }
         else
         {
             poGMLFeature = poDS->GetReader()->NextFeature();
@@ -260,62 +481,30 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         /* --------------------------------------------------------------------
          */
 
-        OGRGeometry **papoGeometries = nullptr;
-        const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
-
-        const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
-        const CPLXMLNode *psBoundedByGeometry =
-            poGMLFeature->GetBoundedByGeometry();
-        if (psBoundedByGeometry && !(papsGeometry && papsGeometry[0]))
+        if (!oReadAheadFeature.bGeometriesBuilt)
         {
-            apsGeometries[0] = psBoundedByGeometry;
-            papsGeometry = apsGeometries;
+            oReadAheadFeature.poGMLFeature.reset(poGMLFeature);
+            BuildGeometries(oReadAheadFeature, hCacheSRS);
+            poGMLFeature = oReadAheadFeature.poGMLFeature.release();
         }
 
+        OGRGeometry **papoGeometries = nullptr;
         OGRGeometry *poGeom = nullptr;
 
         if (poFeatureDefn->GetGeomFieldCount() > 1)
         {
+            if (oReadAheadFeature.bGeometryError)
+            {
+                delete poGMLFeature;
+                return nullptr;
+            }
+
             papoGeometries = static_cast<OGRGeometry **>(CPLCalloc(
                 poFeatureDefn->GetGeomFieldCount(), sizeof(OGRGeometry *)));
-            const char *pszSRSName = poDS->GetGlobalSRSName();
             for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
             {
-                const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
-                if (psGeom != nullptr)
-                {
-                    const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
-                    poGeom = GML_BuildOGRGeometryFromList(
-                        myGeometryList, true,
-                        poDS->GetInvertAxisOrderIfLatLong(), pszSRSName,
-                        poDS->GetConsiderEPSGAsURN(),
-                        poDS->GetSwapCoordinates(),
-                        poDS->GetSecondaryGeometryOption(), hCacheSRS,
-                        bFaceHoleNegative);
-
-                    // Do geometry type changes if needed to match layer
-                    // geometry type.
-                    if (poGeom != nullptr)
-                    {
-                        papoGeometries[i] = OGRGeometryFactory::forceTo(
-                            poGeom,
-                            poFeatureDefn->GetGeomFieldDefn(i)->GetType());
-                        poGeom = nullptr;
-                    }
-                    else
-                    {
-                        // We assume the createFromGML() function would have
-                        // already reported the error.
-                        for (int j = 0; j < poFeatureDefn->GetGeomFieldCount();
-                             j++)
-                        {
-                            delete papoGeometries[j];
-                        }
-                        CPLFree(papoGeometries);
-                        delete poGMLFeature;
-                        return nullptr;
-                    }
-                }
+                papoGeometries[i] =
+                    oReadAheadFeature.apoGeometries[i].release();
             }
 
             if (m_poFilterGeom != nullptr && m_iGeomFieldFilter >= 0 &&
@@ -332,49 +521,28 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
                 continue;
             }
         }
-        else if (papsGeometry[0] &&
-                 strcmp(papsGeometry[0]->pszValue, "null") == 0)
+        else if (oReadAheadFeature.bGeometryError)
         {
-            // do nothing
+            const bool bGoOn = CPLTestBool(
+                CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
+
+            CPLError(bGoOn ? CE_Warning : CE_Failure, CPLE_AppDefined,
+                     "Geometry of feature " CPL_FRMT_GIB
+                     " %scannot be parsed: %s%s",
+                     nFID, pszGML_FID ? CPLSPrintf("%s ", pszGML_FID) : "",
+                     oReadAheadFeature.osGeometryErrorMsg.c_str(),
+                     bGoOn ? ". Skipping to next feature."
+                           : ". You may set the GML_SKIP_CORRUPTED_FEATURES "
+                             "configuration option to YES to skip to the next "
+                             "feature");
+            delete poGMLFeature;
+            if (bGoOn)
+                continue;
+            return nullptr;
         }
-        else if (papsGeometry[0] != nullptr)
+        else if (!oReadAheadFeature.apoGeometries.empty())
         {
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            CPLPushErrorHandler(CPLQuietErrorHandler);
-            poGeom = GML_BuildOGRGeometryFromList(
-                papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
-                pszSRSName, poDS->GetConsiderEPSGAsURN(),
-                poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
-                hCacheSRS, bFaceHoleNegative);
-            CPLPopErrorHandler();
-
-            // Do geometry type changes if needed to match layer geometry type.
-            if (poGeom != nullptr)
-            {
-                poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
-            }
-            else
-            {
-                const CPLString osLastErrorMsg(CPLGetLastErrorMsg());
-
-                const bool bGoOn = CPLTestBool(
-                    CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
-
-                CPLError(
-                    bGoOn ? CE_Warning : CE_Failure, CPLE_AppDefined,
-                    "Geometry of feature " CPL_FRMT_GIB
-                    " %scannot be parsed: %s%s",
-                    nFID, pszGML_FID ? CPLSPrintf("%s ", pszGML_FID) : "",
-                    osLastErrorMsg.c_str(),
-                    bGoOn ? ". Skipping to next feature."
-                          : ". You may set the GML_SKIP_CORRUPTED_FEATURES "
-                            "configuration option to YES to skip to the next "
-                            "feature");
-                delete poGMLFeature;
-                if (bGoOn)
-                    continue;
-                return nullptr;
-            }
+            poGeom = oReadAheadFeature.apoGeometries[0].release();
 
             if (m_poFilterGeom != nullptr && !FilterGeometry(poGeom))
             {
@@ -663,13 +831,6 @@ static void GMLWriteField(OGRGMLDataSource *poDS, VSILFILE *fp,
 OGRErr OGRGMLLayer::ICreateFeature(OGRFeature *poFeature)
 
 {
-    const bool bIsGML3Output = poDS->IsGML3Output();
-    VSILFILE *fp = poDS->GetOutputFP();
-    const bool bWriteSpaceIndentation = poDS->WriteSpaceIndentation();
-    const char *pszPrefix = poDS->GetAppPrefix();
-    const bool bRemoveAppPrefix = poDS->RemoveAppPrefix();
-    const bool bGMLFeatureCollection = poDS->GMLFeatureCollection();
-
     if (!bWriter || poDS->HasWriteError())
         return OGRERR_FAILURE;
 
@@ -679,6 +840,292 @@ OGRErr OGRGMLLayer::ICreateFeature(OGRFeature *poFeature)
                              TRUE))
         return OGRERR_FAILURE;
 
+    if (poFeature->GetFID() == OGRNullFID)
+        poFeature->SetFID(iNextGMLId++);
+
+    for (int iGeomField = 0; iGeomField < poFeatureDefn->GetGeomFieldCount();
+         iGeomField++)
+    {
+        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
+        const OGRSpatialReference *poSRS =
+            poFeatureDefn->GetGeomFieldDefn(iGeomField)->GetSpatialRef();
+        if (poGeom != nullptr && !poGeom->IsEmpty() &&
+            poGeom->getSpatialReference() == nullptr && poSRS != nullptr)
+            poGeom->assignSpatialReference(poSRS);
+
+        if (poGeom != nullptr && !poGeom->IsEmpty() &&
+            poDS->HasWriteGlobalSRS())
+        {
+            OGREnvelope3D sGeomBounds;
+            poGeom->getEnvelope(&sGeomBounds);
+            poDS->GrowExtents(&sGeomBounds, poGeom->getCoordinateDimension());
+        }
+    }
+
+    // Geometries can be encoded to GML by worker threads, in which case
+    // features are buffered and written by batches, and a write error may
+    // only be reported by a later call, or when closing the dataset.
+    // This is opt-in through GDAL_NUM_THREADS, and features are written
+    // directly to non-seekable outputs.
+    if (m_nWriteThreads == 0)
+    {
+        m_nWriteThreads = 1;
+        const int nThreads = poFeatureDefn->GetGeomFieldCount() > 0 &&
+                                     !poDS->IsOutputNonSeekable()
+                                 ? GMLGetNumThreads()
+                                 : 1;
+        auto poThreadPool =
+            nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+        if (poThreadPool)
+        {
+            if (!m_poJobQueue)
+                m_poJobQueue = poThreadPool->CreateJobQueue();
+            m_nWriteThreads = nThreads;
+        }
+    }
+
+    if (m_nWriteThreads <= 1)
+    {
+        if (!poDS->FlushPendingFeatures())
+            return OGRERR_FAILURE;
+        return WriteFeature(poFeature, nullptr);
+    }
+
+    if (!poDS->SetLayerWithPendingFeatures(this) || poDS->HasWriteError())
+        return OGRERR_FAILURE;
+
+    // The SRS objects are not thread-safe, so geometries of the buffered
+    // feature are assigned thread-safe copies of them.
+    PendingFeature oPendingFeature;
+    oPendingFeature.poFeature.reset(poFeature->Clone());
+    for (int iGeomField = 0; iGeomField < poFeatureDefn->GetGeomFieldCount();
+         iGeomField++)
+    {
+        OGRGeometry *poGeom =
+            oPendingFeature.poFeature->GetGeomFieldRef(iGeomField);
+        if (poGeom != nullptr && poGeom->getSpatialReference() != nullptr)
+        {
+            poGeom->assignSpatialReference(
+                GetThreadSafeSRS(poGeom->getSpatialReference()));
+        }
+    }
+    m_aoPendingFeatures.push_back(std::move(oPendingFeature));
+
+    if (m_aoPendingFeatures.size() >= WRITE_BATCH_SIZE &&
+        !FlushPendingFeatures())
+    {
+        return OGRERR_FAILURE;
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          GetThreadSafeSRS()                          */
+/************************************************************************/
+
+OGRSpatialReference *
+OGRGMLLayer::GetThreadSafeSRS(const OGRSpatialReference *poSRS)
+{
+    for (const auto &oPair : m_aoThreadSafeSRS)
+    {
+        if (oPair.first.get() == poSRS || oPair.second.get() == poSRS)
+            return oPair.second.get();
+    }
+
+    // Keep a reference on the source SRS, so that its address is not reused
+    // by another object.
+    std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceReleaser> poSrcSRS(
+        const_cast<OGRSpatialReference *>(poSRS));
+    poSrcSRS->Reference();
+    std::unique_ptr<OGRSpatialReference, OGRSpatialReferenceReleaser>
+        poThreadSafeSRS(new OGRSpatialReference());
+    poThreadSafeSRS->AssignAndSetThreadSafe(*poSRS);
+    m_aoThreadSafeSRS.emplace_back(std::move(poSrcSRS),
+                                   std::move(poThreadSafeSRS));
+    return m_aoThreadSafeSRS.back().second.get();
+}
+
+/************************************************************************/
+/*                        FlushPendingFeatures()                        */
+/************************************************************************/
+
+// Encode the geometries of the buffered features in worker threads, and
+// write the features in their creation order.
+bool OGRGMLLayer::FlushPendingFeatures()
+{
+    if (m_aoPendingFeatures.empty())
+        return true;
+
+    const size_t nFeatures = m_aoPendingFeatures.size();
+    const size_t nJobs =
+        std::min(nFeatures, static_cast<size_t>(m_nWriteThreads));
+    std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        const size_t iStart = iJob * nFeatures / nJobs;
+        const size_t iEnd = (iJob + 1) * nFeatures / nJobs;
+        CPLErrorAccumulator *poErrorAccumulator = &aoErrorAccumulators[iJob];
+        m_poJobQueue->SubmitJob(
+            [this, iStart, iEnd, poErrorAccumulator]()
+            {
+                auto oAccumulator =
+                    poErrorAccumulator->InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+                for (size_t i = iStart; i < iEnd; ++i)
+                {
+                    auto &oPendingFeature = m_aoPendingFeatures[i];
+                    for (int iGeomField = 0;
+                         iGeomField < poFeatureDefn->GetGeomFieldCount();
+                         iGeomField++)
+                    {
+                        oPendingFeature.aosGeometries.push_back(
+                            ExportGeometryToGML(
+                                oPendingFeature.poFeature.get(), iGeomField));
+                    }
+                }
+            });
+    }
+    m_poJobQueue->WaitCompletion();
+    for (auto &oErrorAccumulator : aoErrorAccumulators)
+        oErrorAccumulator.ReplayErrors();
+
+    bool bRet = true;
+    for (auto &oPendingFeature : m_aoPendingFeatures)
+    {
+        if (WriteFeature(oPendingFeature.poFeature.get(),
+                         &oPendingFeature.aosGeometries) != OGRERR_NONE)
+        {
+            bRet = false;
+            break;
+        }
+    }
+    m_aoPendingFeatures.clear();
+    return bRet;
+}
+
+/************************************************************************/
+/*                        ExportGeometryToGML()                         */
+/************************************************************************/
+
+// Return the GML encoding of a non-empty geometry of a feature, or an empty
+// string in case of error. This does not modify the state of the layer, and
+// can thus be called by worker threads.
+std::string OGRGMLLayer::ExportGeometryToGML(const OGRFeature *poFeature,
+                                             int iGeomField) const
+{
+    const bool bIsGML3Output = poDS->IsGML3Output();
+    const OGRGeomFieldDefn *poFieldDefn =
+        poFeatureDefn->GetGeomFieldDefn(iGeomField);
+    const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
+    if (poGeom == nullptr || poGeom->IsEmpty())
+        return std::string();
+
+    const auto &oCoordPrec = poFieldDefn->GetCoordinatePrecision();
+
+    char **papszOptions = nullptr;
+    if (bIsGML3Output)
+    {
+        papszOptions = CSLAddString(papszOptions, "FORMAT=GML3");
+        if (poDS->GetSRSNameFormat() == SRSNAME_SHORT)
+            papszOptions = CSLAddString(papszOptions, "SRSNAME_FORMAT=SHORT");
+        else if (poDS->GetSRSNameFormat() == SRSNAME_OGC_URN)
+            papszOptions =
+                CSLAddString(papszOptions, "SRSNAME_FORMAT=OGC_URN");
+        else if (poDS->GetSRSNameFormat() == SRSNAME_OGC_URL)
+            papszOptions =
+                CSLAddString(papszOptions, "SRSNAME_FORMAT=OGC_URL");
+    }
+    const char *pszSRSDimensionLoc = poDS->GetSRSDimensionLoc();
+    if (pszSRSDimensionLoc != nullptr)
+        papszOptions = CSLSetNameValue(papszOptions, "SRSDIMENSION_LOC",
+                                       pszSRSDimensionLoc);
+    if (poDS->IsGML32Output())
+    {
+        if (poFeatureDefn->GetGeomFieldCount() > 1)
+            papszOptions = CSLAddString(
+                papszOptions,
+                CPLSPrintf("GMLID=%s.%s." CPL_FRMT_GIB,
+                           poFeatureDefn->GetName(), poFieldDefn->GetNameRef(),
+                           poFeature->GetFID()));
+        else
+            papszOptions = CSLAddString(
+                papszOptions,
+                CPLSPrintf("GMLID=%s.geom." CPL_FRMT_GIB,
+                           poFeatureDefn->GetName(), poFeature->GetFID()));
+    }
+
+    if (oCoordPrec.dfXYResolution != OGRGeomCoordinatePrecision::UNKNOWN)
+    {
+        papszOptions = CSLAddString(
+            papszOptions,
+            CPLSPrintf("XY_COORD_RESOLUTION=%g", oCoordPrec.dfXYResolution));
+    }
+    if (oCoordPrec.dfZResolution != OGRGeomCoordinatePrecision::UNKNOWN)
+    {
+        papszOptions = CSLAddString(
+            papszOptions,
+            CPLSPrintf("Z_COORD_RESOLUTION=%g", oCoordPrec.dfZResolution));
+    }
+
+    char *pszGeometry = nullptr;
+    if (!bIsGML3Output && OGR_GT_IsNonLinear(poGeom->getGeometryType()))
+    {
+        OGRGeometry *poGeomTmp = OGRGeometryFactory::forceTo(
+            poGeom->clone(), OGR_GT_GetLinear(poGeom->getGeometryType()));
+        pszGeometry = poGeomTmp->exportToGML(papszOptions);
+        delete poGeomTmp;
+    }
+    else
+    {
+        if (wkbFlatten(poGeom->getGeometryType()) == wkbTriangle)
+        {
+            pszGeometry = poGeom->exportToGML(papszOptions);
+
+            const char *pszGMLID =
+                poDS->IsGML32Output()
+                    ? CPLSPrintf(" gml:id=\"%s\"",
+                                 CSLFetchNameValue(papszOptions, "GMLID"))
+                    : "";
+            char *pszNewGeom = CPLStrdup(
+                CPLSPrintf("<gml:TriangulatedSurface%s><gml:patches>%s<"
+                           "/gml:patches></gml:TriangulatedSurface>",
+                           pszGMLID, pszGeometry));
+            CPLFree(pszGeometry);
+            pszGeometry = pszNewGeom;
+        }
+        else
+        {
+            pszGeometry = poGeom->exportToGML(papszOptions);
+        }
+    }
+    CSLDestroy(papszOptions);
+
+    std::string osGeometry(pszGeometry ? pszGeometry : "");
+    CPLFree(pszGeometry);
+    return osGeometry;
+}
+
+/************************************************************************/
+/*                            WriteFeature()                            */
+/************************************************************************/
+
+// Write a feature, whose geometries may have been already encoded to GML.
+OGRErr
+OGRGMLLayer::WriteFeature(OGRFeature *poFeature,
+                          const std::vector<std::string> *paosGeometries)
+
+{
+    const bool bIsGML3Output = poDS->IsGML3Output();
+    VSILFILE *fp = poDS->GetOutputFP();
+    const bool bWriteSpaceIndentation = poDS->WriteSpaceIndentation();
+    const char *pszPrefix = poDS->GetAppPrefix();
+    const bool bRemoveAppPrefix = poDS->RemoveAppPrefix();
+    const bool bGMLFeatureCollection = poDS->GMLFeatureCollection();
+
+    if (poDS->HasWriteError())
+        return OGRERR_FAILURE;
+
     if (bWriteSpaceIndentation)
         VSIFPrintfL(fp, "  ");
     if (bIsGML3Output && !bGMLFeatureCollection)
@@ -693,9 +1140,6 @@ OGRErr OGRGMLLayer::ICreateFeature(OGRFeature *poFeature)
         poDS->PrintLine(fp, "<gml:featureMember>");
     }
 
-    if (poFeature->GetFID() == OGRNullFID)
-        poFeature->SetFID(iNextGMLId++);
-
     if (bWriteSpaceIndentation)
         VSIFPrintfL(fp, "    ");
     VSIFPrintfL(fp, "<");
@@ -752,12 +1196,6 @@ OGRErr OGRGMLLayer::ICreateFeature(OGRFeature *poFeature)
             const int nCoordDimension = poGeom->getCoordinateDimension();
 
             poGeom->getEnvelope(&sGeomBounds);
-            if (poDS->HasWriteGlobalSRS())
-                poDS->GrowExtents(&sGeomBounds, nCoordDimension);
-
-            if (poGeom->getSpatialReference() == nullptr &&
-                poFieldDefn->GetSpatialRef() != nullptr)
-                poGeom->assignSpatialReference(poFieldDefn->GetSpatialRef());
 
             const auto &oCoordPrec = poFieldDefn->GetCoordinatePrecision();
 
@@ -827,87 +1265,11 @@ OGRErr OGRGMLLayer::ICreateFeature(OGRFeature *poFeature)
                 CPLFree(pszSRSName);
             }
 
-            char **papszOptions = nullptr;
-            if (bIsGML3Output)
-            {
-                papszOptions = CSLAddString(papszOptions, "FORMAT=GML3");
-                if (poDS->GetSRSNameFormat() == SRSNAME_SHORT)
-                    papszOptions =
-                        CSLAddString(papszOptions, "SRSNAME_FORMAT=SHORT");
-                else if (poDS->GetSRSNameFormat() == SRSNAME_OGC_URN)
-                    papszOptions =
-                        CSLAddString(papszOptions, "SRSNAME_FORMAT=OGC_URN");
-                else if (poDS->GetSRSNameFormat() == SRSNAME_OGC_URL)
-                    papszOptions =
-                        CSLAddString(papszOptions, "SRSNAME_FORMAT=OGC_URL");
-            }
-            const char *pszSRSDimensionLoc = poDS->GetSRSDimensionLoc();
-            if (pszSRSDimensionLoc != nullptr)
-                papszOptions = CSLSetNameValue(papszOptions, "SRSDIMENSION_LOC",
-                                               pszSRSDimensionLoc);
-            if (poDS->IsGML32Output())
-            {
-                if (poFeatureDefn->GetGeomFieldCount() > 1)
-                    papszOptions = CSLAddString(
-                        papszOptions, CPLSPrintf("GMLID=%s.%s." CPL_FRMT_GIB,
-                                                 poFeatureDefn->GetName(),
-                                                 poFieldDefn->GetNameRef(),
-                                                 poFeature->GetFID()));
-                else
-                    papszOptions = CSLAddString(
-                        papszOptions, CPLSPrintf("GMLID=%s.geom." CPL_FRMT_GIB,
-                                                 poFeatureDefn->GetName(),
-                                                 poFeature->GetFID()));
-            }
-
-            if (oCoordPrec.dfXYResolution !=
-                OGRGeomCoordinatePrecision::UNKNOWN)
-            {
-                papszOptions = CSLAddString(
-                    papszOptions, CPLSPrintf("XY_COORD_RESOLUTION=%g",
-                                             oCoordPrec.dfXYResolution));
-            }
-            if (oCoordPrec.dfZResolution != OGRGeomCoordinatePrecision::UNKNOWN)
-            {
-                papszOptions = CSLAddString(
-                    papszOptions, CPLSPrintf("Z_COORD_RESOLUTION=%g",
-                                             oCoordPrec.dfZResolution));
-            }
-
-            char *pszGeometry = nullptr;
-            if (!bIsGML3Output && OGR_GT_IsNonLinear(poGeom->getGeometryType()))
-            {
-                OGRGeometry *poGeomTmp = OGRGeometryFactory::forceTo(
-                    poGeom->clone(),
-                    OGR_GT_GetLinear(poGeom->getGeometryType()));
-                pszGeometry = poGeomTmp->exportToGML(papszOptions);
-                delete poGeomTmp;
-            }
-            else
-            {
-                if (wkbFlatten(poGeom->getGeometryType()) == wkbTriangle)
-                {
-                    pszGeometry = poGeom->exportToGML(papszOptions);
-
-                    const char *pszGMLID =
-                        poDS->IsGML32Output()
-                            ? CPLSPrintf(
-                                  " gml:id=\"%s\"",
-                                  CSLFetchNameValue(papszOptions, "GMLID"))
-                            : "";
-                    char *pszNewGeom = CPLStrdup(
-                        CPLSPrintf("<gml:TriangulatedSurface%s><gml:patches>%s<"
-                                   "/gml:patches></gml:TriangulatedSurface>",
-                                   pszGMLID, pszGeometry));
-                    CPLFree(pszGeometry);
-                    pszGeometry = pszNewGeom;
-                }
-                else
-                {
-                    pszGeometry = poGeom->exportToGML(papszOptions);
-                }
-            }
-            CSLDestroy(papszOptions);
+            const std::string osGeometry =
+                paosGeometries ? (*paosGeometries)[iGeomField]
+                               : ExportGeometryToGML(poFeature, iGeomField);
+            const char *pszGeometry =
+                osGeometry.empty() ? nullptr : osGeometry.c_str();
             if (pszGeometry)
             {
                 if (bWriteSpaceIndentation)
@@ -926,7 +1288,6 @@ OGRErr OGRGMLLayer::ICreateFeature(OGRFeature *poFeature)
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Export of geometry to GML failed");
             }
-            CPLFree(pszGeometry);
         }
     }
 
@@ -1155,6 +1516,8 @@ OGRErr OGRGMLLayer::CreateField(const OGRFieldDefn *poField, int bApproxOK)
 {
     if (!bWriter || iNextGMLId != 0)
         return OGRERR_FAILURE;
+    if (!poDS->FlushPendingFeatures())
+        return OGRERR_FAILURE;
 
     /* -------------------------------------------------------------------- */
     /*      Enforce XML naming semantics on element name.                   */
@@ -1199,6 +1562,8 @@ OGRErr OGRGMLLayer::CreateGeomField(const OGRGeomFieldDefn *poField,
 {
     if (!bWriter || iNextGMLId != 0)
         return OGRERR_FAILURE;
+    if (!poDS->FlushPendingFeatures())
+        return OGRERR_FAILURE;
 
     /* -------------------------------------------------------------------- */
     /*      Enforce XML naming semantics on element name.                   */
@@ -774,6 +774,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 #endif
 
     void CheckGeometryType(const OGRFeature *poFeature);
+    void CheckGeometryType(OGRwkbGeometryType eGeomType);
 
     OGRErr ReadTableDefinition();
     void InitView();
@@ -789,6 +790,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                                         const char *pszNewName);
 
     OGRErr CreateOrUpsertFeature(OGRFeature *poFeature, bool bUpsert);
+    bool AddRTreeEntryForInsertedFeature(GIntBig nFID,
+                                         const OGREnvelope &oEnv);
+    void IncrementTotalFeatureCount();
 
     GIntBig GetTotalFeatureCount();
 
@@ -876,6 +880,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                           const int *panUpdatedGeomFieldsIdx,
                           bool bUpdateStyleString) override;
     OGRErr DeleteFeature(GIntBig nFID) override;
+    bool WriteArrowBatch(const struct ArrowSchema *schema,
+                         struct ArrowArray *array,
+                         CSLConstList papszOptions = nullptr) override;
 
     OGRErr ISetSpatialFilter(int iGeomField,
                              const OGRGeometry *poGeom) override;
@@ -13,6 +13,7 @@
 
 #include "ogr_geopackage.h"
 #include "ogrgeopackageutility.h"
+#include "ograrrowarrayhelper.h"
 #include "ogrlayerarrow.h"
 #include "ogrsqliteutility.h"
 #include "cpl_md5.h"
@@ -2151,33 +2152,35 @@ void OGRGeoPackageTableLayer::DisableFeatureCountTriggers(
  * reflect the dimensionality of feature geometries.
  */
 void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
+{
+    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    if (poGeom != nullptr)
+        CheckGeometryType(poGeom->getGeometryType());
+}
+
+void OGRGeoPackageTableLayer::CheckGeometryType(OGRwkbGeometryType eGeomType)
 {
     const OGRwkbGeometryType eLayerGeomType = GetGeomType();
     const OGRwkbGeometryType eFlattenLayerGeomType = wkbFlatten(eLayerGeomType);
-    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
     if (eFlattenLayerGeomType != wkbNone && eFlattenLayerGeomType != wkbUnknown)
     {
-        if (poGeom != nullptr)
+        const OGRwkbGeometryType eFlattenGeomType = wkbFlatten(eGeomType);
+        if (!OGR_GT_IsSubClassOf(eFlattenGeomType, eFlattenLayerGeomType) &&
+            !cpl::contains(m_eSetBadGeomTypeWarned, eFlattenGeomType))
         {
-            OGRwkbGeometryType eGeomType =
-                wkbFlatten(poGeom->getGeometryType());
-            if (!OGR_GT_IsSubClassOf(eGeomType, eFlattenLayerGeomType) &&
-                !cpl::contains(m_eSetBadGeomTypeWarned, eGeomType))
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "A geometry of type %s is inserted into layer %s "
-                         "of geometry type %s, which is not normally allowed "
-                         "by the GeoPackage specification, but the driver will "
-                         "however do it. "
-                         "To create a conformant GeoPackage, if using ogr2ogr, "
-                         "the -nlt option can be used to override the layer "
-                         "geometry type. "
-                         "This warning will no longer be emitted for this "
-                         "combination of layer and feature geometry type.",
-                         OGRToOGCGeomType(eGeomType), GetName(),
-                         OGRToOGCGeomType(eFlattenLayerGeomType));
-                m_eSetBadGeomTypeWarned.insert(eGeomType);
-            }
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "A geometry of type %s is inserted into layer %s "
+                     "of geometry type %s, which is not normally allowed "
+                     "by the GeoPackage specification, but the driver will "
+                     "however do it. "
+                     "To create a conformant GeoPackage, if using ogr2ogr, "
+                     "the -nlt option can be used to override the layer "
+                     "geometry type. "
+                     "This warning will no longer be emitted for this "
+                     "combination of layer and feature geometry type.",
+                     OGRToOGCGeomType(eFlattenGeomType), GetName(),
+                     OGRToOGCGeomType(eFlattenLayerGeomType));
+            m_eSetBadGeomTypeWarned.insert(eFlattenGeomType);
         }
     }
 
@@ -2185,50 +2188,46 @@ void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
     // if we have geometries with Z and M components
     if (m_nZFlag == 0 || m_nMFlag == 0)
     {
-        if (poGeom != nullptr)
+        bool bUpdateGpkgGeometryColumnsTable = false;
+        if (m_nZFlag == 0 && wkbHasZ(eGeomType))
         {
-            bool bUpdateGpkgGeometryColumnsTable = false;
-            const OGRwkbGeometryType eGeomType = poGeom->getGeometryType();
-            if (m_nZFlag == 0 && wkbHasZ(eGeomType))
-            {
-                if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Layer '%s' has been declared with non-Z geometry type "
-                        "%s, but it does contain geometries with Z. Setting "
-                        "the Z=2 hint into gpkg_geometry_columns",
-                        GetName(),
-                        OGRToOGCGeomType(eLayerGeomType, true, true, true));
-                }
-                m_nZFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
-            }
-            if (m_nMFlag == 0 && wkbHasM(eGeomType))
+            if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
             {
-                if (eLayerGeomType != wkbUnknown && !wkbHasM(eLayerGeomType))
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Layer '%s' has been declared with non-M geometry type "
-                        "%s, but it does contain geometries with M. Setting "
-                        "the M=2 hint into gpkg_geometry_columns",
-                        GetName(),
-                        OGRToOGCGeomType(eLayerGeomType, true, true, true));
-                }
-                m_nMFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
+                CPLError(
+                    CE_Warning, CPLE_AppDefined,
+                    "Layer '%s' has been declared with non-Z geometry type "
+                    "%s, but it does contain geometries with Z. Setting "
+                    "the Z=2 hint into gpkg_geometry_columns",
+                    GetName(),
+                    OGRToOGCGeomType(eLayerGeomType, true, true, true));
             }
-            if (bUpdateGpkgGeometryColumnsTable)
+            m_nZFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (m_nMFlag == 0 && wkbHasM(eGeomType))
+        {
+            if (eLayerGeomType != wkbUnknown && !wkbHasM(eLayerGeomType))
             {
-                /* Update gpkg_geometry_columns */
-                char *pszSQL = sqlite3_mprintf(
-                    "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
-                    "table_name = '%q' AND column_name = '%q'",
-                    m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
-                CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
-                sqlite3_free(pszSQL);
+                CPLError(
+                    CE_Warning, CPLE_AppDefined,
+                    "Layer '%s' has been declared with non-M geometry type "
+                    "%s, but it does contain geometries with M. Setting "
+                    "the M=2 hint into gpkg_geometry_columns",
+                    GetName(),
+                    OGRToOGCGeomType(eLayerGeomType, true, true, true));
             }
+            m_nMFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (bUpdateGpkgGeometryColumnsTable)
+        {
+            /* Update gpkg_geometry_columns */
+            char *pszSQL = sqlite3_mprintf(
+                "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
+                "table_name = '%q' AND column_name = '%q'",
+                m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
+            CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
+            sqlite3_free(pszSQL);
         }
     }
 }
@@ -2316,6 +2315,118 @@ static float rtreeValueUp(double d)
     return f;
 }
 
+/************************************************************************/
+/*                  AddRTreeEntryForInsertedFeature()                   */
+/************************************************************************/
+
+/** Record the bounding box of a newly inserted feature so that it ends up
+ * in the spatial index, either through the deferred update done within a
+ * transaction, or through the background R-Tree building thread.
+ */
+bool OGRGeoPackageTableLayer::AddRTreeEntryForInsertedFeature(
+    GIntBig nFID, const OGREnvelope &oEnv)
+{
+    if (!m_bDeferredSpatialIndexCreation && HasSpatialIndex() &&
+        m_poDS->IsInTransaction())
+    {
+        m_nCountInsertInTransaction++;
+        if (m_nCountInsertInTransactionThreshold < 0)
+        {
+            m_nCountInsertInTransactionThreshold = atoi(CPLGetConfigOption(
+                "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
+        }
+        if (m_nCountInsertInTransaction == m_nCountInsertInTransactionThreshold)
+        {
+            StartDeferredSpatialIndexUpdate();
+        }
+        else if (!m_aoRTreeTriggersSQL.empty())
+        {
+            if (m_aoRTreeEntries.size() == 1000 * 1000)
+            {
+                if (!FlushPendingSpatialIndexUpdate())
+                    return false;
+            }
+            GPKGRTreeEntry sEntry;
+            sEntry.nId = nFID;
+            sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+            sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+            sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+            sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+            m_aoRTreeEntries.push_back(sEntry);
+        }
+    }
+    else if (m_bAllowedRTreeThread && !m_bErrorDuringRTreeThread)
+    {
+        GPKGRTreeEntry sEntry;
+#ifdef DEBUG_VERBOSE
+        if (m_aoRTreeEntries.empty())
+            CPLDebug("GPKG",
+                     "Starting to fill m_aoRTreeEntries at FID " CPL_FRMT_GIB,
+                     nFID);
+#endif
+        sEntry.nId = nFID;
+        sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+        sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+        sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+        sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+        try
+        {
+            m_aoRTreeEntries.push_back(sEntry);
+            if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
+            {
+                m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
+                m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
+            }
+            if (!m_bThreadRTreeStarted &&
+                m_oQueueRTreeEntries.size() == m_nRTreeBatchesBeforeStart)
+            {
+                StartAsyncRTree();
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLDebug("GPKG", "Memory allocation error regarding RTree "
+                             "structures. Falling back to slower method");
+            if (m_bThreadRTreeStarted)
+                CancelAsyncRTree();
+            else
+                m_bAllowedRTreeThread = false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                    IncrementTotalFeatureCount()                      */
+/************************************************************************/
+
+void OGRGeoPackageTableLayer::IncrementTotalFeatureCount()
+{
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+    if (m_nTotalFeatureCount >= 0)
+    {
+        if (m_nTotalFeatureCount < std::numeric_limits<int64_t>::max())
+        {
+            m_nTotalFeatureCount++;
+        }
+        else
+        {
+            if (m_poDS->m_bHasGPKGOGRContents)
+            {
+                char *pszSQL = sqlite3_mprintf(
+                    "UPDATE gpkg_ogr_contents SET feature_count = null "
+                    "WHERE lower(table_name) = lower('%q')",
+                    m_pszTableName);
+                CPL_IGNORE_RET_VAL(sqlite3_exec(m_poDS->hDB, pszSQL, nullptr,
+                                                nullptr, nullptr));
+                sqlite3_free(pszSQL);
+            }
+            m_nTotalFeatureCount = -1;
+        }
+    }
+#endif
+}
+
 OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
                                                       bool bUpsert)
 {
@@ -2575,115 +2686,360 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
             poGeom->getEnvelope(&oEnv);
             UpdateExtent(&oEnv);
 
-            if (!bUpsert && !m_bDeferredSpatialIndexCreation &&
-                HasSpatialIndex() && m_poDS->IsInTransaction())
+            if (!bUpsert && !AddRTreeEntryForInsertedFeature(nFID, oEnv))
+                return OGRERR_FAILURE;
+        }
+    }
+
+    IncrementTotalFeatureCount();
+
+    m_bContentChanged = true;
+
+    /* All done! */
+    return OGRERR_NONE;
+}
+
+OGRErr OGRGeoPackageTableLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    return CreateOrUpsertFeature(poFeature, /* bUpsert=*/false);
+}
+
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+// Native implementation that binds the Arrow buffers directly onto the
+// prepared INSERT statement, and builds the GeoPackage geometry blob from the
+// WKB without instantiating an OGRGeometry for the common geometry types.
+// Falls back to the generic implementation (going through CreateFeature())
+// for layer or batch characteristics it does not handle.
+bool OGRGeoPackageTableLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                              struct ArrowArray *array,
+                                              CSLConstList papszOptions)
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+    if (!m_poDS->GetUpdate())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, UNSUPPORTED_OP_READ_ONLY,
+                 "WriteArrowBatch");
+        return false;
+    }
+
+    if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
+        return false;
+
+    CancelAsyncNextArrowArray();
+
+    OGRArrowArrayReaderHelper oReader(this, schema, array, papszOptions);
+    bool bUseNativeImpl =
+        oReader.IsCompatible() && m_iFIDAsRegularColumnIndex < 0 &&
+        !CPLTestBool(
+            CPLGetConfigOption("OGR_GPKG_WRITE_ARROW_BASE_IMPL", "NO"));
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    for (int iField = 0; bUseNativeImpl && iField < nFieldCount; ++iField)
+    {
+        const auto poFieldDefn = m_poFeatureDefn->GetFieldDefnUnsafe(iField);
+        const auto psCol = oReader.GetColumnForOGRField(iField);
+        // Generated fields, default values, and width enforcement are
+        // handled by the generic CreateFeature() code path.
+        if (poFieldDefn->IsGenerated() ||
+            (psCol == nullptr && poFieldDefn->GetDefault() != nullptr) ||
+            (poFieldDefn->GetType() == OFTString &&
+             poFieldDefn->GetWidth() > 0) ||
+            (psCol != nullptr &&
+             ((poFieldDefn->GetSubType() == OFSTBoolean &&
+               psCol->chFormat != 'b') ||
+              (poFieldDefn->GetSubType() == OFSTInt16 &&
+               psCol->chFormat != 'b' && psCol->chFormat != 's'))))
+        {
+            bUseNativeImpl = false;
+        }
+    }
+    if (!bUseNativeImpl)
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+    // To maximize performance of insertion, disable feature count triggers
+    if (m_bOGRFeatureCountTriggersEnabled)
+    {
+        DisableFeatureCountTriggers();
+    }
+#endif
+
+    const bool bWithFID = oReader.HasFIDColumn();
+    if (m_poInsertStatement &&
+        (m_bInsertStatementWithFID != bWithFID || m_bInsertStatementWithUpsert))
+    {
+        sqlite3_finalize(m_poInsertStatement);
+        m_poInsertStatement = nullptr;
+    }
+
+    if (!m_poInsertStatement)
+    {
+        // All fields are bound, so the content of the feature does not matter
+        OGRFeature oFeature(m_poFeatureDefn);
+        m_bInsertStatementWithFID = bWithFID;
+        m_bInsertStatementWithUpsert = false;
+        m_osInsertStatementUpsertUniqueColumnName.clear();
+        const CPLString osCommand = FeatureGenerateInsertSQL(
+            &oFeature, bWithFID, /* bBindUnsetFields = */ true,
+            /* bUpsert = */ false, std::string());
+        if (SQLPrepareWithError(m_poDS->GetDB(), osCommand, -1,
+                                &m_poInsertStatement, nullptr) != SQLITE_OK)
+        {
+            return false;
+        }
+    }
+
+    const bool bHasGeomField = m_poFeatureDefn->GetGeomFieldCount() > 0;
+    const bool bNoPrecisionRounding =
+        m_sBinaryPrecision.nXYBitPrecision == INT_MIN &&
+        m_sBinaryPrecision.nZBitPrecision == INT_MIN &&
+        m_sBinaryPrecision.nMBitPrecision == INT_MIN;
+    OGRwkbGeometryType eLastGeomType = wkbNone;
+    std::vector<GByte> abyGPKGGeom;
+    char szDate[32];
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    const auto ReportBindError = [this](const char *pszColumn)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "sqlite3_bind_() for column %s failed: %s", pszColumn,
+                 sqlite3_errmsg(m_poDS->GetDB()));
+    };
+
+    const auto ResetInsertStatement = [this]()
+    {
+        sqlite3_reset(m_poInsertStatement);
+        sqlite3_clear_bindings(m_poInsertStatement);
+        sqlite3_finalize(m_poInsertStatement);
+        m_poInsertStatement = nullptr;
+    };
+
+    const size_t nLength = oReader.GetLength();
+    for (size_t iRow = 0; iRow < nLength; ++iRow)
+    {
+        int nColCount = 1;
+        const GIntBig nInputFID = oReader.GetFID(iRow);
+        if (bWithFID)
+        {
+            const int err =
+                nInputFID == OGRNullFID
+                    ? sqlite3_bind_null(m_poInsertStatement, nColCount)
+                    : sqlite3_bind_int64(m_poInsertStatement, nColCount,
+                                         nInputFID);
+            ++nColCount;
+            if (err != SQLITE_OK)
             {
-                m_nCountInsertInTransaction++;
-                if (m_nCountInsertInTransactionThreshold < 0)
-                {
-                    m_nCountInsertInTransactionThreshold =
-                        atoi(CPLGetConfigOption(
-                            "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
-                }
-                if (m_nCountInsertInTransaction ==
-                    m_nCountInsertInTransactionThreshold)
+                ReportBindError(GetFIDColumn());
+                ResetInsertStatement();
+                return false;
+            }
+        }
+
+        OGREnvelope3D sEnvelope;
+        if (bHasGeomField)
+        {
+            size_t nWKBSize = 0;
+            const GByte *pabyWKB = oReader.GetWKB(iRow, nWKBSize);
+            int err = SQLITE_OK;
+            if (pabyWKB == nullptr)
+            {
+                err = sqlite3_bind_null(m_poInsertStatement, nColCount);
+            }
+            else
+            {
+                OGRwkbGeometryType eGeomType = wkbUnknown;
+                if (bNoPrecisionRounding &&
+                    GPkgGeometryFromWKB(pabyWKB, nWKBSize, m_iSrs,
+                                        abyGPKGGeom, eGeomType, sEnvelope))
                 {
-                    StartDeferredSpatialIndexUpdate();
+                    if (eGeomType != eLastGeomType)
+                    {
+                        CheckGeometryType(eGeomType);
+                        eLastGeomType = eGeomType;
+                    }
+                    err = sqlite3_bind_blob(
+                        m_poInsertStatement, nColCount, abyGPKGGeom.data(),
+                        static_cast<int>(abyGPKGGeom.size()), SQLITE_STATIC);
                 }
-                else if (!m_aoRTreeTriggersSQL.empty())
+                else
                 {
-                    if (m_aoRTreeEntries.size() == 1000 * 1000)
+                    // Curve geometries, non-native byte order, coordinate
+                    // precision rounding, etc.
+                    OGRGeometry *poGeomPtr = nullptr;
+                    if (OGRGeometryFactory::createFromWkb(
+                            pabyWKB, nullptr, &poGeomPtr, nWKBSize) !=
+                        OGRERR_NONE)
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "WriteArrowBatch: invalid WKB geometry");
+                        ResetInsertStatement();
+                        return false;
+                    }
+                    std::unique_ptr<OGRGeometry> poGeom(poGeomPtr);
+                    eGeomType = poGeom->getGeometryType();
+                    if (eGeomType != eLastGeomType)
+                    {
+                        CheckGeometryType(eGeomType);
+                        eLastGeomType = eGeomType;
+                    }
+                    size_t nBlobSize = 0;
+                    GByte *pabyBlob = GPkgGeometryFromOGR(
+                        poGeom.get(), m_iSrs, &m_sBinaryPrecision, &nBlobSize);
+                    if (!pabyBlob)
                     {
-                        if (!FlushPendingSpatialIndexUpdate())
-                            return OGRERR_FAILURE;
+                        ResetInsertStatement();
+                        return false;
                     }
-                    GPKGRTreeEntry sEntry;
-                    sEntry.nId = nFID;
-                    sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                    sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                    sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                    sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                    m_aoRTreeEntries.push_back(sEntry);
+                    err = sqlite3_bind_blob(m_poInsertStatement, nColCount,
+                                            pabyBlob,
+                                            static_cast<int>(nBlobSize),
+                                            CPLFree);
+                    CreateGeometryExtensionIfNecessary(poGeom.get());
+                    if (!poGeom->IsEmpty())
+                        poGeom->getEnvelope(&sEnvelope);
                 }
             }
-            else if (!bUpsert && m_bAllowedRTreeThread &&
-                     !m_bErrorDuringRTreeThread)
+            ++nColCount;
+            if (err != SQLITE_OK)
             {
-                GPKGRTreeEntry sEntry;
-#ifdef DEBUG_VERBOSE
-                if (m_aoRTreeEntries.empty())
-                    CPLDebug("GPKG",
-                             "Starting to fill m_aoRTreeEntries at "
-                             "FID " CPL_FRMT_GIB,
-                             nFID);
-#endif
-                sEntry.nId = nFID;
-                sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                try
+                ReportBindError(GetGeometryColumn());
+                ResetInsertStatement();
+                return false;
+            }
+        }
+
+        for (int iField = 0; iField < nFieldCount; ++iField)
+        {
+            const auto psCol = oReader.GetColumnForOGRField(iField);
+            int err = SQLITE_OK;
+            if (psCol == nullptr ||
+                OGRArrowArrayReaderHelper::IsNull(*psCol, iRow))
+            {
+                err = sqlite3_bind_null(m_poInsertStatement, nColCount);
+            }
+            else
+            {
+                const auto poFieldDefn =
+                    m_poFeatureDefn->GetFieldDefnUnsafe(iField);
+                switch (poFieldDefn->GetType())
                 {
-                    m_aoRTreeEntries.push_back(sEntry);
-                    if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
+                    case OFTInteger:
+                    case OFTInteger64:
                     {
-                        m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
-                        m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
+                        err = sqlite3_bind_int64(
+                            m_poInsertStatement, nColCount,
+                            OGRArrowArrayReaderHelper::GetInteger(*psCol,
+                                                                  iRow));
+                        break;
                     }
-                    if (!m_bThreadRTreeStarted &&
-                        m_oQueueRTreeEntries.size() ==
-                            m_nRTreeBatchesBeforeStart)
+
+                    case OFTReal:
                     {
-                        StartAsyncRTree();
+                        err = sqlite3_bind_double(
+                            m_poInsertStatement, nColCount,
+                            OGRArrowArrayReaderHelper::GetReal(*psCol, iRow));
+                        break;
                     }
-                }
-                catch (const std::bad_alloc &)
-                {
-                    CPLDebug("GPKG",
-                             "Memory allocation error regarding RTree "
-                             "structures. Falling back to slower method");
-                    if (m_bThreadRTreeStarted)
-                        CancelAsyncRTree();
-                    else
-                        m_bAllowedRTreeThread = false;
+
+                    case OFTString:
+                    {
+                        size_t nLen = 0;
+                        const GByte *pabyData =
+                            OGRArrowArrayReaderHelper::GetBytes(*psCol, iRow,
+                                                                nLen);
+                        err = sqlite3_bind_text(
+                            m_poInsertStatement, nColCount,
+                            reinterpret_cast<const char *>(pabyData),
+                            static_cast<int>(nLen), SQLITE_STATIC);
+                        break;
+                    }
+
+                    case OFTBinary:
+                    {
+                        size_t nLen = 0;
+                        const GByte *pabyData =
+                            OGRArrowArrayReaderHelper::GetBytes(*psCol, iRow,
+                                                                nLen);
+                        err = sqlite3_bind_blob(m_poInsertStatement, nColCount,
+                                                pabyData,
+                                                static_cast<int>(nLen),
+                                                SQLITE_STATIC);
+                        break;
+                    }
+
+                    case OFTDate:
+                    {
+                        const GIntBig nDays =
+                            OGRArrowArrayReaderHelper::GetInteger(*psCol, iRow);
+                        CPLUnixTimeToYMDHMS(nDays * 86400, &brokenDown);
+                        const int nYear = brokenDown.tm_year + 1900;
+                        if (nYear < 0 || nYear >= 10000)
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "WriteArrowBatch: year %d unsupported",
+                                     nYear);
+                            ResetInsertStatement();
+                            return false;
+                        }
+                        const int nLen =
+                            snprintf(szDate, sizeof(szDate), "%04d-%02d-%02d",
+                                     nYear, brokenDown.tm_mon + 1,
+                                     brokenDown.tm_mday);
+                        err = sqlite3_bind_text(m_poInsertStatement, nColCount,
+                                                szDate, nLen, SQLITE_TRANSIENT);
+                        break;
+                    }
+
+                    default:
+                        CPLAssert(false);
+                        break;
                 }
             }
+            ++nColCount;
+            if (err != SQLITE_OK)
+            {
+                ReportBindError(
+                    m_poFeatureDefn->GetFieldDefnUnsafe(iField)->GetNameRef());
+                ResetInsertStatement();
+                return false;
+            }
         }
-    }
 
-#ifdef ENABLE_GPKG_OGR_CONTENTS
-    if (m_nTotalFeatureCount >= 0)
-    {
-        if (m_nTotalFeatureCount < std::numeric_limits<int64_t>::max())
+        const int err = sqlite3_step(m_poInsertStatement);
+        if (err != SQLITE_OK && err != SQLITE_DONE)
         {
-            m_nTotalFeatureCount++;
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "failed to execute insert : %s",
+                     sqlite3_errmsg(m_poDS->GetDB())
+                         ? sqlite3_errmsg(m_poDS->GetDB())
+                         : "");
+            ResetInsertStatement();
+            return false;
         }
-        else
+        sqlite3_reset(m_poInsertStatement);
+        sqlite3_clear_bindings(m_poInsertStatement);
+
+        const GIntBig nFID = sqlite3_last_insert_rowid(m_poDS->GetDB());
+        if (!oReader.SetOutputFID(iRow, nInputFID, nFID))
+            return false;
+
+        if (sEnvelope.IsInit())
         {
-            if (m_poDS->m_bHasGPKGOGRContents)
-            {
-                char *pszSQL = sqlite3_mprintf(
-                    "UPDATE gpkg_ogr_contents SET feature_count = null "
-                    "WHERE lower(table_name) = lower('%q')",
-                    m_pszTableName);
-                CPL_IGNORE_RET_VAL(sqlite3_exec(m_poDS->hDB, pszSQL, nullptr,
-                                                nullptr, nullptr));
-                sqlite3_free(pszSQL);
-            }
-            m_nTotalFeatureCount = -1;
+            UpdateExtent(&sEnvelope);
+            if (!AddRTreeEntryForInsertedFeature(nFID, sEnvelope))
+                return false;
         }
-    }
-#endif
-
-    m_bContentChanged = true;
 
-    /* All done! */
-    return OGRERR_NONE;
-}
+        IncrementTotalFeatureCount();
+        m_bContentChanged = true;
+    }
 
-OGRErr OGRGeoPackageTableLayer::ICreateFeature(OGRFeature *poFeature)
-{
-    return CreateOrUpsertFeature(poFeature, /* bUpsert=*/false);
+    oReader.Finalize();
+    return true;
 }
 
 /************************************************************************/
@@ -4376,7 +4732,8 @@ int OGRGeoPackageTableLayer::TestCapability(const char *pszCap)
 {
     if (!m_bFeatureDefnCompleted)
         GetLayerDefn();
-    if (EQUAL(pszCap, OLCSequentialWrite))
+    if (EQUAL(pszCap, OLCSequentialWrite) ||
+        EQUAL(pszCap, OLCFastWriteArrowBatch))
     {
         return m_poDS->GetUpdate();
     }
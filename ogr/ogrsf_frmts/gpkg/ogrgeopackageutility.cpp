@@ -349,6 +349,83 @@ GByte *GPkgGeometryFromOGR(const OGRGeometry *poGeometry, int iSrsId,
     return pabyWkb;
 }
 
+/************************************************************************/
+/*                         GPkgGeometryFromWKB()                        */
+/************************************************************************/
+
+/** Build a GeoPackage geometry blob directly from an ISO WKB geometry,
+ * without instantiating an OGRGeometry. This produces the same result as
+ * GPkgGeometryFromOGR() with no coordinate precision rounding.
+ *
+ * Only native byte order WKB of the non-curve simple feature types is
+ * handled. Returns false if the WKB is not handled by this fast path, in
+ * which case the caller should go through GPkgGeometryFromOGR().
+ *
+ * On success, eGeomType is set to the geometry type, and sEnvelope to its
+ * extent (left uninitialized for an empty geometry).
+ */
+bool GPkgGeometryFromWKB(const GByte *pabyWKB, size_t nWKBSize, int iSrsId,
+                         std::vector<GByte> &abyGPKG,
+                         OGRwkbGeometryType &eGeomType,
+                         OGREnvelope3D &sEnvelope)
+{
+    bool bNeedSwap = false;
+    uint32_t nRawType = 0;
+    if (!OGRWKBGetGeomType(pabyWKB, nWKBSize, bNeedSwap, nRawType) ||
+        bNeedSwap || nRawType >= 4000)
+    {
+        return false;
+    }
+    const uint32_t nFlatType = nRawType % 1000;
+    if (nFlatType < wkbPoint || nFlatType > wkbMultiPolygon)
+        return false;
+    eGeomType = OGR_GT_SetModifier(static_cast<OGRwkbGeometryType>(nFlatType),
+                                   nRawType / 1000 == 1 || nRawType / 1000 == 3,
+                                   nRawType / 1000 == 2 ||
+                                       nRawType / 1000 == 3);
+
+    sEnvelope = OGREnvelope3D();
+    if (!OGRWKBGetBoundingBox(pabyWKB, nWKBSize, sEnvelope))
+        return false;
+
+    const bool bEmpty = !sEnvelope.IsInit();
+    const bool bPoint = nFlatType == wkbPoint;
+    const bool b3D = CPL_TO_BOOL(OGR_GT_HasZ(eGeomType));
+
+    // Same logic as in GPkgGeometryFromOGR()
+    GByte byEnv = 0;
+    GByte byFlags = static_cast<GByte>(CPL_IS_LSB);
+    if (bEmpty)
+        byFlags |= (1 << 4);
+    else if (!bPoint)
+        byEnv = b3D ? 2 : 1;
+    byFlags |= (byEnv << 1);
+
+    const size_t nHeaderLen = 2 + 1 + 1 + 4 + 8 * 2 * byEnv;
+    if (nWKBSize >
+        static_cast<size_t>(std::numeric_limits<int>::max()) - nHeaderLen)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, "too big geometry blob");
+        return false;
+    }
+    abyGPKG.resize(nHeaderLen + nWKBSize);
+    GByte *pabyPtr = abyGPKG.data();
+    pabyPtr[0] = 0x47;
+    pabyPtr[1] = 0x50;
+    pabyPtr[2] = 0;
+    pabyPtr[3] = byFlags;
+    memcpy(pabyPtr + 4, &iSrsId, 4);
+    if (byEnv > 0)
+    {
+        const double adfEnv[] = {sEnvelope.MinX, sEnvelope.MaxX,
+                                 sEnvelope.MinY, sEnvelope.MaxY,
+                                 sEnvelope.MinZ, sEnvelope.MaxZ};
+        memcpy(pabyPtr + 8, adfEnv, 8 * 2 * byEnv);
+    }
+    memcpy(pabyPtr + nHeaderLen, pabyWKB, nWKBSize);
+    return true;
+}
+
 OGRErr GPkgHeaderFromWKB(const GByte *pabyGpkg, size_t nGpkgLen,
                          GPkgHeader *poHeader)
 {
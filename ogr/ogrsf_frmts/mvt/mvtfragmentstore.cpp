@@ -0,0 +1,386 @@
+/******************************************************************************
+ *
+ * Project:  MVT Translator
+ * Purpose:  Temporary store of feature fragments for the MVT writer
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "mvtfragmentstore.h"
+
+#include "cpl_error.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <tuple>
+
+/************************************************************************/
+/*                    MVTFragmentStore::RunReader                       */
+/************************************************************************/
+
+// Sequential buffered reader of the records of a sorted run
+class MVTFragmentStore::RunReader
+{
+  public:
+    RunReader(VSIVirtualHandle *fp, uint64_t nOffset, uint64_t nSize,
+              size_t nBufferSize)
+        : m_fp(fp), m_nNextOffset(nOffset), m_nRemaining(nSize),
+          m_nBufferSize(std::max<size_t>(nBufferSize, 4096))
+    {
+    }
+
+    // Make the next record available in m_sHeader / GetFeature()
+    // Returns false at end of run, or on error (then m_bError is set)
+    bool Next()
+    {
+        m_iPos += m_nCurRecordSize;
+        m_nCurRecordSize = 0;
+        if (!Ensure(sizeof(RecordHeader)))
+            return false;
+        memcpy(&m_sHeader, m_abyBuffer.data() + m_iPos, sizeof(RecordHeader));
+        if (!Ensure(sizeof(RecordHeader) + m_sHeader.nFeatureSize))
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Truncated record in temporary file");
+            m_bError = true;
+            return false;
+        }
+        m_nCurRecordSize = sizeof(RecordHeader) + m_sHeader.nFeatureSize;
+        return true;
+    }
+
+    const RecordHeader &GetHeader() const
+    {
+        return m_sHeader;
+    }
+
+    const char *GetFeature() const
+    {
+        return reinterpret_cast<const char *>(m_abyBuffer.data() + m_iPos +
+                                              sizeof(RecordHeader));
+    }
+
+    bool HasError() const
+    {
+        return m_bError;
+    }
+
+  private:
+    VSIVirtualHandle *m_fp;
+    uint64_t m_nNextOffset;
+    uint64_t m_nRemaining;
+    const size_t m_nBufferSize;
+    std::vector<GByte> m_abyBuffer{};
+    size_t m_iPos = 0;
+    size_t m_nCurRecordSize = 0;
+    RecordHeader m_sHeader{};
+    bool m_bError = false;
+
+    // Make sure that at least nBytes are available from m_iPos
+    bool Ensure(size_t nBytes)
+    {
+        const size_t nAvailable = m_abyBuffer.size() - m_iPos;
+        if (nAvailable >= nBytes)
+            return true;
+        if (nBytes - nAvailable > m_nRemaining)
+            return false;
+        m_abyBuffer.erase(m_abyBuffer.begin(),
+                          m_abyBuffer.begin() + static_cast<ptrdiff_t>(m_iPos));
+        m_iPos = 0;
+        const size_t nToRead = static_cast<size_t>(std::min<uint64_t>(
+            m_nRemaining, std::max(m_nBufferSize, nBytes - nAvailable)));
+        m_abyBuffer.resize(nAvailable + nToRead);
+        if (m_fp->Seek(m_nNextOffset, SEEK_SET) != 0 ||
+            m_fp->Read(m_abyBuffer.data() + nAvailable, 1, nToRead) != nToRead)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Failed reading temporary file");
+            m_bError = true;
+            return false;
+        }
+        m_nNextOffset += nToRead;
+        m_nRemaining -= nToRead;
+        return true;
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(RunReader)
+};
+
+/************************************************************************/
+/*                         ~MVTFragmentStore()                          */
+/************************************************************************/
+
+MVTFragmentStore::~MVTFragmentStore()
+{
+    if (m_fp)
+    {
+        m_fp.reset();
+        if (m_bRemoveFile && !m_osFilename.empty())
+            VSIUnlink(m_osFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+bool MVTFragmentStore::Open(const std::string &osFilename, bool bRemoveFile,
+                            size_t nMaxRAM)
+{
+    m_osFilename = osFilename;
+    m_bRemoveFile = bRemoveFile;
+    m_nMaxRAM = std::max<size_t>(nMaxRAM, 1);
+    m_fp.reset(VSIFOpenL(osFilename.c_str(), "wb+"));
+    if (!m_fp)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 osFilename.c_str());
+        return false;
+    }
+    if (m_bRemoveFile && VSIUnlink(osFilename.c_str()) == 0)
+    {
+        // The file remains accessible through m_fp on POSIX systems
+        m_osFilename.clear();
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                                 Add()                                */
+/************************************************************************/
+
+bool MVTFragmentStore::Add(int nZ, int nX, int nY,
+                           const std::string &osLayerName, GIntBig nSerial,
+                           int nGeomType, double dfAreaOrLength,
+                           const std::string &osFeature)
+{
+    if (osFeature.size() > std::numeric_limits<uint32_t>::max())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, "Too large feature");
+        return false;
+    }
+
+    auto oIter = m_oMapLayerNameToIdx.find(osLayerName);
+    if (oIter == m_oMapLayerNameToIdx.end())
+    {
+        const uint32_t nLayerIdx =
+            static_cast<uint32_t>(m_aosLayerNames.size());
+        m_aosLayerNames.push_back(osLayerName);
+        oIter = m_oMapLayerNameToIdx.emplace(osLayerName, nLayerIdx).first;
+    }
+
+    RecordHeader sHeader;
+    sHeader.nZ = nZ;
+    sHeader.nX = nX;
+    sHeader.nY = nY;
+    sHeader.nLayerIdx = oIter->second;
+    sHeader.nSerial = static_cast<int64_t>(nSerial);
+    sHeader.dfAreaOrLength = dfAreaOrLength;
+    sHeader.nGeomType = nGeomType;
+    sHeader.nFeatureSize = static_cast<uint32_t>(osFeature.size());
+
+    const size_t nOffset = m_abyBuffer.size();
+    try
+    {
+        m_abyBuffer.resize(nOffset + sizeof(RecordHeader) + osFeature.size());
+        m_asIndex.push_back(IndexEntry{nZ, nX, nY, nOffset});
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in MVTFragmentStore::Add()");
+        return false;
+    }
+    memcpy(m_abyBuffer.data() + nOffset, &sHeader, sizeof(RecordHeader));
+    if (!osFeature.empty())
+    {
+        memcpy(m_abyBuffer.data() + nOffset + sizeof(RecordHeader),
+               osFeature.data(), osFeature.size());
+    }
+    ++m_nCount;
+
+    if (m_abyBuffer.size() + m_asIndex.size() * sizeof(IndexEntry) >
+        m_nMaxRAM)
+    {
+        return SpillRun();
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             SortIndex()                              */
+/************************************************************************/
+
+void MVTFragmentStore::SortIndex()
+{
+    // Stable to keep the insertion order of fragments of a same tile
+    std::stable_sort(m_asIndex.begin(), m_asIndex.end(),
+                     [](const IndexEntry &a, const IndexEntry &b)
+                     {
+                         return std::tie(a.nZ, a.nX, a.nY) <
+                                std::tie(b.nZ, b.nX, b.nY);
+                     });
+}
+
+/************************************************************************/
+/*                              SpillRun()                              */
+/************************************************************************/
+
+bool MVTFragmentStore::SpillRun()
+{
+    SortIndex();
+
+    const uint64_t nRunOffset = m_nFileSize;
+    if (m_fp->Seek(nRunOffset, SEEK_SET) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing temporary file");
+        return false;
+    }
+    for (const auto &sEntry : m_asIndex)
+    {
+        uint32_t nFeatureSize = 0;
+        memcpy(&nFeatureSize,
+               m_abyBuffer.data() + sEntry.nOffset +
+                   offsetof(RecordHeader, nFeatureSize),
+               sizeof(nFeatureSize));
+        const size_t nRecordSize = sizeof(RecordHeader) + nFeatureSize;
+        if (m_fp->Write(m_abyBuffer.data() + sEntry.nOffset, 1, nRecordSize) !=
+            nRecordSize)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Failed writing temporary file");
+            return false;
+        }
+        m_nFileSize += nRecordSize;
+    }
+    m_anRuns.emplace_back(nRunOffset, m_nFileSize - nRunOffset);
+
+    m_abyBuffer.clear();
+    m_asIndex.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                             ForEachTile()                            */
+/************************************************************************/
+
+bool MVTFragmentStore::ForEachTile(
+    const std::function<bool(int nZ, int nX, int nY,
+                             std::vector<Fragment> &asFragments)> &func)
+{
+    std::vector<Fragment> asFragments;
+
+    const auto AppendFragment =
+        [&asFragments](const RecordHeader &sHeader, const char *pszFeature)
+    {
+        asFragments.emplace_back();
+        auto &sFragment = asFragments.back();
+        sFragment.nLayerIdx = sHeader.nLayerIdx;
+        sFragment.nSerial = static_cast<GIntBig>(sHeader.nSerial);
+        sFragment.nGeomType = sHeader.nGeomType;
+        sFragment.dfAreaOrLength = sHeader.dfAreaOrLength;
+        sFragment.osFeature.assign(pszFeature, sHeader.nFeatureSize);
+    };
+
+    if (m_anRuns.empty())
+    {
+        SortIndex();
+        for (size_t i = 0; i < m_asIndex.size();)
+        {
+            const auto &sFirst = m_asIndex[i];
+            asFragments.clear();
+            size_t j = i;
+            for (; j < m_asIndex.size() && m_asIndex[j].nZ == sFirst.nZ &&
+                   m_asIndex[j].nX == sFirst.nX && m_asIndex[j].nY == sFirst.nY;
+                 ++j)
+            {
+                RecordHeader sHeader;
+                const GByte *pabyRecord =
+                    m_abyBuffer.data() + m_asIndex[j].nOffset;
+                memcpy(&sHeader, pabyRecord, sizeof(RecordHeader));
+                AppendFragment(sHeader, reinterpret_cast<const char *>(
+                                            pabyRecord + sizeof(RecordHeader)));
+            }
+            if (!func(sFirst.nZ, sFirst.nX, sFirst.nY, asFragments))
+                return false;
+            i = j;
+        }
+        return true;
+    }
+
+    if (!m_asIndex.empty() && !SpillRun())
+        return false;
+    std::vector<GByte>().swap(m_abyBuffer);
+    std::vector<IndexEntry>().swap(m_asIndex);
+
+    CPLDebug("MVT", "Merging %d runs of feature fragments",
+             static_cast<int>(m_anRuns.size()));
+
+    const size_t nBufferSize = m_nMaxRAM / m_anRuns.size();
+    std::vector<std::unique_ptr<RunReader>> apoReaders;
+    // Min-heap of ((z, x, y, index of run)). The index of run is part of
+    // the key so that fragments of a same tile are returned in insertion
+    // order.
+    using HeapItem = std::tuple<int, int, int, size_t>;
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>>
+        oHeap;
+    for (size_t i = 0; i < m_anRuns.size(); ++i)
+    {
+        apoReaders.emplace_back(std::make_unique<RunReader>(
+            m_fp.get(), m_anRuns[i].first, m_anRuns[i].second, nBufferSize));
+        auto &poReader = apoReaders.back();
+        if (poReader->Next())
+        {
+            const auto &sHeader = poReader->GetHeader();
+            oHeap.emplace(sHeader.nZ, sHeader.nX, sHeader.nY, i);
+        }
+        else if (poReader->HasError())
+        {
+            return false;
+        }
+    }
+
+    while (!oHeap.empty())
+    {
+        const int nZ = std::get<0>(oHeap.top());
+        const int nX = std::get<1>(oHeap.top());
+        const int nY = std::get<2>(oHeap.top());
+        asFragments.clear();
+        while (!oHeap.empty() && std::get<0>(oHeap.top()) == nZ &&
+               std::get<1>(oHeap.top()) == nX &&
+               std::get<2>(oHeap.top()) == nY)
+        {
+            const size_t iRun = std::get<3>(oHeap.top());
+            oHeap.pop();
+            auto &poReader = apoReaders[iRun];
+            // Consume all records of that tile in this run
+            while (true)
+            {
+                AppendFragment(poReader->GetHeader(), poReader->GetFeature());
+                if (!poReader->Next())
+                {
+                    if (poReader->HasError())
+                        return false;
+                    break;
+                }
+                const auto &sHeader = poReader->GetHeader();
+                if (sHeader.nZ != nZ || sHeader.nX != nX || sHeader.nY != nY)
+                {
+                    oHeap.emplace(sHeader.nZ, sHeader.nX, sHeader.nY, iRun);
+                    break;
+                }
+            }
+        }
+        if (!func(nZ, nX, nY, asFragments))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *
+ * Project:  MVT Translator
+ * Purpose:  Temporary store of feature fragments for the MVT writer
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef MVTFRAGMENTSTORE_H
+#define MVTFRAGMENTSTORE_H
+
+#include "cpl_port.h"
+#include "cpl_vsi_virtual.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/************************************************************************/
+/*                           MVTFragmentStore                           */
+/************************************************************************/
+
+/** Temporary store of the feature fragments generated by the MVT writer,
+ * that is a feature clipped to a tile and encoded as a single-feature
+ * compressed MVT layer.
+ *
+ * Fragments are serialized in RAM up to a given size. Beyond it, they are
+ * sorted by (z, x, y) and appended as a sorted run to a temporary file.
+ * ForEachTile() does a k-way merge of those runs, and calls a function with
+ * all the fragments of each tile, by increasing (z, x, y).
+ *
+ * This class is not thread-safe.
+ */
+class MVTFragmentStore
+{
+  public:
+    struct Fragment
+    {
+        uint32_t nLayerIdx = 0;
+        GIntBig nSerial = 0;
+        int nGeomType = 0;
+        double dfAreaOrLength = 0;
+        std::string osFeature{};
+    };
+
+    MVTFragmentStore() = default;
+    ~MVTFragmentStore();
+
+    bool Open(const std::string &osFilename, bool bRemoveFile,
+              size_t nMaxRAM);
+
+    bool Add(int nZ, int nX, int nY, const std::string &osLayerName,
+             GIntBig nSerial, int nGeomType, double dfAreaOrLength,
+             const std::string &osFeature);
+
+    GIntBig GetCount() const
+    {
+        return m_nCount;
+    }
+
+    const std::string &GetLayerName(uint32_t nLayerIdx) const
+    {
+        return m_aosLayerNames[nLayerIdx];
+    }
+
+    bool ForEachTile(
+        const std::function<bool(int nZ, int nX, int nY,
+                                 std::vector<Fragment> &asFragments)> &func);
+
+  private:
+    struct RecordHeader
+    {
+        int32_t nZ;
+        int32_t nX;
+        int32_t nY;
+        uint32_t nLayerIdx;
+        int64_t nSerial;
+        double dfAreaOrLength;
+        int32_t nGeomType;
+        uint32_t nFeatureSize;
+    };
+
+    struct IndexEntry
+    {
+        int32_t nZ;
+        int32_t nX;
+        int32_t nY;
+        size_t nOffset;  // in m_abyBuffer
+    };
+
+    class RunReader;
+
+    std::string m_osFilename{};
+    bool m_bRemoveFile = true;
+    VSIVirtualHandleUniquePtr m_fp{};
+    size_t m_nMaxRAM = 0;
+    GIntBig m_nCount = 0;
+
+    std::map<std::string, uint32_t> m_oMapLayerNameToIdx{};
+    std::vector<std::string> m_aosLayerNames{};
+
+    std::vector<GByte> m_abyBuffer{};
+    std::vector<IndexEntry> m_asIndex{};
+
+    // (offset, size) in m_fp of the sorted runs
+    std::vector<std::pair<uint64_t, uint64_t>> m_anRuns{};
+    uint64_t m_nFileSize = 0;
+
+    void SortIndex();
+    bool SpillRun();
+
+    CPL_DISALLOW_COPY_ASSIGN(MVTFragmentStore)
+};
+
+#endif  // MVTFRAGMENTSTORE_H
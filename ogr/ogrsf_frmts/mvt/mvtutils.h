@@ -16,6 +16,8 @@
 #include "cpl_json.h"
 #include "ogrsf_frmts.h"
 
+#include <string>
+
 #define MVT_LCO                                                                \
     "<LayerCreationOptionList>"                                                \
     "  <Option name='MINZOOM' type='int' min='0' max='22' "                    \
@@ -56,7 +58,7 @@
     "  <Option name='COMPRESS' scope='vector' type='boolean' description="     \
     "'Whether to GZip-compress tiles' default='YES'/>"                         \
     "  <Option name='TEMPORARY_DB' scope='vector' type='string' description='" \
-    "Filename with path for the temporary database'/>"
+    "Filename with path for the temporary file'/>"
 
 void OGRMVTInitFields(OGRFeatureDefn *poFeatureDefn,
                       const CPLJSONObject &oFields,
@@ -74,10 +76,35 @@ OGRFeature *OGRMVTCreateFeatureFrom(OGRFeature *poSrcFeature,
                                     bool bJsonField,
                                     OGRSpatialReference *poSRS);
 
+/************************************************************************/
+/*                            OGRMVTTileSink                            */
+/************************************************************************/
+
+/** Receiver of the tiles encoded by the MVT writer, used instead of writing
+ * them as a directory of files or a MBTiles database.
+ */
+class OGRMVTTileSink
+{
+  public:
+    virtual ~OGRMVTTileSink() = default;
+
+    /** Called for each encoded tile. nY=0 is the top-most row. */
+    virtual bool WriteTile(int nZ, int nX, int nY,
+                           std::string &&osTileData) = 0;
+
+    /** Called once, after all tiles, with the metadata items that would
+     * have been written in metadata.json. */
+    virtual bool WriteMetadata(const CPLJSONObject &oMetadata) = 0;
+};
+
 // #ifdef HAVE_MVT_WRITE_SUPPORT
 GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename, int nXSize,
                                        int nYSize, int nBandsIn,
                                        GDALDataType eDT, char **papszOptions);
+
+GDALDataset *OGRMVTWriterDatasetCreateForTileSink(const char *pszFilename,
+                                                  char **papszOptions,
+                                                  OGRMVTTileSink *poTileSink);
 // #endif
 
 #endif  // MVTUTILS_H
@@ -59,8 +59,13 @@ constexpr int knMAX_FILES_PER_DIR = 10000;
 
 #include "../sqlite/ogrsqlitevfs.h"
 
+#include "cpl_error_internal.h"
 #include "cpl_worker_thread_pool.h"
 
+#include "mvtfragmentstore.h"
+
+#include <atomic>
+#include <limits>
 #include <mutex>
 
 // Limitations from https://github.com/mapbox/mapbox-geostats
@@ -3347,12 +3352,10 @@ class OGRMVTWriterDataset final : public GDALDataset
     };
 
     std::vector<std::unique_ptr<OGRMVTWriterLayer>> m_apoLayers;
-    CPLString m_osTempDB;
-    mutable std::mutex m_oDBMutex;
+    mutable MVTFragmentStore m_oFragmentStore{};
+    mutable std::mutex m_oFragmentStoreMutex;
     mutable bool m_bWriteFeatureError = false;
     sqlite3_vfs *m_pMyVFS = nullptr;
-    sqlite3 *m_hDB = nullptr;
-    sqlite3_stmt *m_hInsertStmt = nullptr;
     int m_nMinZoom = 0;
     int m_nMaxZoom = 5;
     double m_dfSimplification = 0.0;
@@ -3365,11 +3368,11 @@ class OGRMVTWriterDataset final : public GDALDataset
     bool m_bGZip = true;
     mutable CPLWorkerThreadPool m_oThreadPool;
     bool m_bThreadPoolOK = false;
-    mutable GIntBig m_nTempTiles = 0;
     CPLString m_osName;
     CPLString m_osDescription;
     CPLString m_osType{"overlay"};
     sqlite3 *m_hDBMBTILES = nullptr;
+    OGRMVTTileSink *m_poTileSink = nullptr;  // not owned
     OGREnvelope m_oEnvelope;
     bool m_bMaxTileSizeOptSpecified = false;
     bool m_bMaxFeaturesOptSpecified = false;
@@ -3388,7 +3391,8 @@ class OGRMVTWriterDataset final : public GDALDataset
         1;  // Number of tiles along X axis at zoom level 0
     int m_nTileMatrixHeight0 =
         1;  // Number of tiles along Y axis at zoom level 0
-    bool m_bReuseTempFile = false;  // debug only
+    std::atomic<bool> m_bTooManyFeaturesWarningEmitted{false};
+    std::atomic<bool> m_bTooBigTileWarningEmitted{false};
 
     OGRErr PreGenerateForTile(
         int nZ, int nX, int nY, const CPLString &osTargetName,
@@ -3435,15 +3439,19 @@ class OGRMVTWriterDataset final : public GDALDataset
                        MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
                        unsigned &nFeaturesInTile);
 
+    static void MergeLayerProperties(
+        std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+        std::set<CPLString> &oSetLayers,
+        const std::map<CPLString, MVTLayerProperties> &oMapTileLayerProps);
+
     std::string
-    EncodeTile(int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer,
-               sqlite3_stmt *hStmtRows,
-               std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-               std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead);
+    EncodeTile(int nZ, int nX, int nY,
+               const std::vector<MVTFragmentStore::Fragment> &asFragments,
+               std::map<CPLString, MVTLayerProperties> &oMapLayerProps);
 
-    std::string RecodeTileLowerResolution(int nZ, int nX, int nY, int nExtent,
-                                          sqlite3_stmt *hStmtLayer,
-                                          sqlite3_stmt *hStmtRows);
+    std::string RecodeTileLowerResolution(
+        int nExtent,
+        const std::vector<MVTFragmentStore::Fragment> &asFragments);
 
     bool CreateOutput();
 
@@ -3469,6 +3477,10 @@ class OGRMVTWriterDataset final : public GDALDataset
                                int nBandsIn, GDALDataType eDT,
                                char **papszOptions);
 
+    static GDALDataset *CreateInternal(const char *pszFilename,
+                                       char **papszOptions,
+                                       OGRMVTTileSink *poTileSink);
+
     OGRSpatialReference *GetSRS()
     {
         return m_poSRS;
@@ -3643,23 +3655,10 @@ CPLErr OGRMVTWriterDataset::Close()
             if (!CreateOutput())
                 eErr = CE_Failure;
         }
-        if (m_hInsertStmt != nullptr)
-        {
-            sqlite3_finalize(m_hInsertStmt);
-        }
-        if (m_hDB)
-        {
-            sqlite3_close(m_hDB);
-        }
         if (m_hDBMBTILES)
         {
             sqlite3_close(m_hDBMBTILES);
         }
-        if (!m_osTempDB.empty() && !m_bReuseTempFile &&
-            CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
-        {
-            VSIUnlink(m_osTempDB);
-        }
 
         if (GDALDataset::Close() != CE_None)
             eErr = CE_Failure;
@@ -4325,42 +4324,25 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTileReal(
     oBuffer.assign(static_cast<char *>(pCompressed), nCompressedSize);
     CPLFree(pCompressed);
 
-    const auto InsertIntoDb = [&]()
-    {
-        m_nTempTiles++;
-        sqlite3_bind_int(m_hInsertStmt, 1, nZ);
-        sqlite3_bind_int(m_hInsertStmt, 2, nTileX);
-        sqlite3_bind_int(m_hInsertStmt, 3, nTileY);
-        sqlite3_bind_text(m_hInsertStmt, 4, osTargetName.c_str(), -1,
-                          SQLITE_STATIC);
-        sqlite3_bind_int64(m_hInsertStmt, 5, nSerial);
-        sqlite3_bind_blob(m_hInsertStmt, 6, oBuffer.data(),
-                          static_cast<int>(oBuffer.size()), SQLITE_STATIC);
-        sqlite3_bind_int(m_hInsertStmt, 7,
-                         static_cast<int>(poGPBFeature->getType()));
-        sqlite3_bind_double(m_hInsertStmt, 8, dfAreaOrLength);
-        int rc = sqlite3_step(m_hInsertStmt);
-        sqlite3_reset(m_hInsertStmt);
-        return rc;
+    const auto AddToStore = [&]()
+    {
+        return m_oFragmentStore.Add(nZ, nTileX, nTileY, osTargetName, nSerial,
+                                    static_cast<int>(poGPBFeature->getType()),
+                                    dfAreaOrLength, oBuffer);
     };
 
-    int rc;
+    bool bOK;
     if (m_bThreadPoolOK)
     {
-        std::lock_guard<std::mutex> oLock(m_oDBMutex);
-        rc = InsertIntoDb();
+        std::lock_guard<std::mutex> oLock(m_oFragmentStoreMutex);
+        bOK = AddToStore();
     }
     else
     {
-        rc = InsertIntoDb();
-    }
-
-    if (!(rc == SQLITE_OK || rc == SQLITE_DONE))
-    {
-        return OGRERR_FAILURE;
+        bOK = AddToStore();
     }
 
-    return OGRERR_NONE;
+    return bOK ? OGRERR_NONE : OGRERR_FAILURE;
 }
 
 /************************************************************************/
@@ -4395,7 +4377,7 @@ void OGRMVTWriterDataset::WriterTaskFunc(void *pParam)
         poTask->nSerial, poTask->poGeom.get(), poTask->sEnvelope);
     if (eErr != OGRERR_NONE)
     {
-        std::lock_guard oLock(poTask->poDS->m_oDBMutex);
+        std::lock_guard oLock(poTask->poDS->m_oFragmentStoreMutex);
         poTask->poDS->m_bWriteFeatureError = true;
     }
     delete poTask;
@@ -4435,7 +4417,7 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTile(
         // Do not queue more than 1000 jobs to avoid memory exhaustion
         m_oThreadPool.WaitCompletion(1000);
 
-        std::lock_guard oLock(m_oDBMutex);
+        std::lock_guard oLock(m_oFragmentStoreMutex);
         return m_bWriteFeatureError ? OGRERR_FAILURE : OGRERR_NONE;
     }
 }
@@ -4948,96 +4930,160 @@ void OGRMVTWriterDataset::EncodeFeature(
 }
 
 /************************************************************************/
-/*                            EncodeTile()                              */
+/*                       MergeLayerProperties()                         */
 /************************************************************************/
 
-std::string OGRMVTWriterDataset::EncodeTile(
-    int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer, sqlite3_stmt *hStmtRows,
+// Merge the properties of the layers of a tile into the global ones,
+// honouring the same limits as UpdateLayerProperties()
+void OGRMVTWriterDataset::MergeLayerProperties(
     std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-    std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead)
+    std::set<CPLString> &oSetLayers,
+    const std::map<CPLString, MVTLayerProperties> &oMapTileLayerProps)
 {
-    MVTTile oTargetTile;
-
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
-    unsigned nFeaturesInTile = 0;
-    const GIntBig nProgressStep =
-        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
-
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    for (const auto &oTileLayerIter : oMapTileLayerProps)
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+        const CPLString &osLayerName = oTileLayerIter.first;
+        const MVTLayerProperties &oSrcProps = oTileLayerIter.second;
 
-        auto oIterMapLayerProps = oMapLayerProps.find(pszLayerName);
-        MVTLayerProperties *poLayerProperties = nullptr;
+        auto oIterMapLayerProps = oMapLayerProps.find(osLayerName);
         if (oIterMapLayerProps == oMapLayerProps.end())
         {
             if (oSetLayers.size() < knMAX_COUNT_LAYERS)
             {
-                oSetLayers.insert(pszLayerName);
+                oSetLayers.insert(osLayerName);
                 if (oMapLayerProps.size() < knMAX_REPORT_LAYERS)
                 {
-                    MVTLayerProperties props;
-                    props.m_nMinZoom = nZ;
-                    props.m_nMaxZoom = nZ;
-                    oMapLayerProps[pszLayerName] = std::move(props);
-                    poLayerProperties = &(oMapLayerProps[pszLayerName]);
+                    oMapLayerProps[osLayerName] = oSrcProps;
                 }
             }
+            continue;
         }
-        else
+        MVTLayerProperties *poLayerProperties = &(oIterMapLayerProps->second);
+
+        poLayerProperties->m_nMinZoom =
+            std::min(oSrcProps.m_nMinZoom, poLayerProperties->m_nMinZoom);
+        poLayerProperties->m_nMaxZoom =
+            std::max(oSrcProps.m_nMaxZoom, poLayerProperties->m_nMaxZoom);
+        for (const auto &oCountIter : oSrcProps.m_oCountGeomType)
         {
-            poLayerProperties = &(oIterMapLayerProps->second);
+            poLayerProperties->m_oCountGeomType[oCountIter.first] +=
+                oCountIter.second;
         }
-        if (poLayerProperties)
+
+        for (const auto &oSrcField : oSrcProps.m_aoFields)
         {
-            poLayerProperties->m_nMinZoom =
-                std::min(nZ, poLayerProperties->m_nMinZoom);
-            poLayerProperties->m_nMaxZoom =
-                std::max(nZ, poLayerProperties->m_nMaxZoom);
+            const auto &osFieldName = oSrcField.m_osName;
+            auto oFieldIter =
+                poLayerProperties->m_oMapFieldNameToIdx.find(osFieldName);
+            if (oFieldIter == poLayerProperties->m_oMapFieldNameToIdx.end())
+            {
+                if (poLayerProperties->m_oSetFields.size() <
+                    knMAX_COUNT_FIELDS)
+                {
+                    poLayerProperties->m_oSetFields.insert(osFieldName);
+                    if (poLayerProperties->m_oMapFieldNameToIdx.size() <
+                        knMAX_REPORT_FIELDS)
+                    {
+                        poLayerProperties->m_oMapFieldNameToIdx[osFieldName] =
+                            poLayerProperties->m_aoFields.size();
+                        poLayerProperties->m_aoFields.push_back(oSrcField);
+                    }
+                }
+                continue;
+            }
+
+            auto &oDstField =
+                poLayerProperties->m_aoFields[oFieldIter->second];
+            if (oSrcField.m_eType == MVTTileLayerValue::ValueType::DOUBLE &&
+                oDstField.m_eType == MVTTileLayerValue::ValueType::DOUBLE)
+            {
+                oDstField.m_bAllInt =
+                    oDstField.m_bAllInt && oSrcField.m_bAllInt;
+                oDstField.m_dfMinVal =
+                    std::min(oDstField.m_dfMinVal, oSrcField.m_dfMinVal);
+                oDstField.m_dfMaxVal =
+                    std::max(oDstField.m_dfMaxVal, oSrcField.m_dfMaxVal);
+            }
+            for (const auto &oValue : oSrcField.m_oSetAllValues)
+            {
+                if (oDstField.m_oSetAllValues.size() >= knMAX_COUNT_VALUES)
+                    break;
+                oDstField.m_oSetAllValues.insert(oValue);
+                if (oDstField.m_oSetValues.size() < knMAX_REPORT_VALUES &&
+                    oSrcField.m_oSetValues.find(oValue) !=
+                        oSrcField.m_oSetValues.end())
+                {
+                    oDstField.m_oSetValues.insert(oValue);
+                }
+            }
+        }
+        for (const auto &osField : oSrcProps.m_oSetFields)
+        {
+            if (poLayerProperties->m_oSetFields.size() >= knMAX_COUNT_FIELDS)
+                break;
+            poLayerProperties->m_oSetFields.insert(osField);
+        }
+    }
+}
+
+/************************************************************************/
+/*                            EncodeTile()                              */
+/************************************************************************/
+
+// asFragments must be sorted by layer name and then by feature serial
+std::string OGRMVTWriterDataset::EncodeTile(
+    int nZ, int nX, int nY,
+    const std::vector<MVTFragmentStore::Fragment> &asFragments,
+    std::map<CPLString, MVTLayerProperties> &oMapLayerProps)
+{
+    MVTTile oTargetTile;
+
+    unsigned nFeaturesInTile = 0;
+    for (size_t i = 0;
+         nFeaturesInTile < m_nMaxFeatures && i < asFragments.size();)
+    {
+        const uint32_t nLayerIdx = asFragments[i].nLayerIdx;
+        const std::string &osLayerName =
+            m_oFragmentStore.GetLayerName(nLayerIdx);
+
+        MVTLayerProperties *poLayerProperties = nullptr;
+        auto oIterMapLayerProps = oMapLayerProps.find(osLayerName);
+        if (oIterMapLayerProps == oMapLayerProps.end())
+        {
+            MVTLayerProperties props;
+            props.m_nMinZoom = nZ;
+            props.m_nMaxZoom = nZ;
+            poLayerProperties =
+                &(oMapLayerProps[osLayerName] = std::move(props));
+        }
+        else
+        {
+            poLayerProperties = &(oIterMapLayerProps->second);
         }
 
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
+        poTargetLayer->setName(osLayerName);
         poTargetLayer->setVersion(m_nMVTVersion);
         poTargetLayer->setExtent(m_nExtent);
 
         std::map<CPLString, GUInt32> oMapKeyToIdx;
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
-        while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+        for (; nFeaturesInTile < m_nMaxFeatures && i < asFragments.size() &&
+               asFragments[i].nLayerIdx == nLayerIdx;
+             ++i)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, poLayerProperties, m_nExtent,
-                          nFeaturesInTile);
-
-            nTempTilesRead++;
-            if (nTempTilesRead == m_nTempTiles ||
-                (nTempTilesRead % nProgressStep) == 0)
-            {
-                const int nPct =
-                    static_cast<int>((100 * nTempTilesRead) / m_nTempTiles);
-                CPLDebug("MVT", "%d%%...", nPct);
-            }
+            const auto &osFeature = asFragments[i].osFeature;
+            EncodeFeature(osFeature.data(), static_cast<int>(osFeature.size()),
+                          poTargetLayer, oMapKeyToIdx, oMapValueToIdx,
+                          poLayerProperties, m_nExtent, nFeaturesInTile);
         }
-        sqlite3_reset(hStmtRows);
+        // Skip remaining fragments of the layer if the limit is reached
+        while (i < asFragments.size() && asFragments[i].nLayerIdx == nLayerIdx)
+            ++i;
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     size_t nSizeBefore = oTileBuffer.size();
     if (m_bGZip)
@@ -5047,9 +5093,9 @@ std::string OGRMVTWriterDataset::EncodeTile(
         static_cast<double>(nSizeAfter) / nSizeBefore;
 
     const bool bTooManyFeatures = nFeaturesInTile >= m_nMaxFeatures;
-    if (bTooManyFeatures && !m_bMaxFeaturesOptSpecified)
+    if (bTooManyFeatures && !m_bMaxFeaturesOptSpecified &&
+        !m_bTooManyFeaturesWarningEmitted.exchange(true))
     {
-        m_bMaxFeaturesOptSpecified = true;
         CPLError(CE_Warning, CPLE_AppDefined,
                  "At least one tile exceeded the default maximum number of "
                  "features per tile (%u) and was truncated to satisfy it.",
@@ -5060,9 +5106,9 @@ std::string OGRMVTWriterDataset::EncodeTile(
     // features, then sort by descending area / length until we get to the
     // limit.
     bool bTooBigTile = oTileBuffer.size() > m_nMaxTileSize;
-    if (bTooBigTile && !m_bMaxTileSizeOptSpecified)
+    if (bTooBigTile && !m_bMaxTileSizeOptSpecified &&
+        !m_bTooBigTileWarningEmitted.exchange(true))
     {
-        m_bMaxTileSizeOptSpecified = true;
         CPLError(CE_Warning, CPLE_AppDefined,
                  "At least one tile exceeded the default maximum tile size of "
                  "%u bytes and was encoded at lower resolution",
@@ -5074,8 +5120,7 @@ std::string OGRMVTWriterDataset::EncodeTile(
     {
         nExtent /= 2;
         nSizeBefore = oTileBuffer.size();
-        oTileBuffer = RecodeTileLowerResolution(nZ, nX, nY, nExtent, hStmtLayer,
-                                                hStmtRows);
+        oTileBuffer = RecodeTileLowerResolution(nExtent, asFragments);
         bTooBigTile = oTileBuffer.size() > m_nMaxTileSize;
         CPLDebug("MVT",
                  "Recoding tile %d/%d/%d with extent = %u. "
@@ -5103,17 +5148,18 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         const unsigned nTotalFeaturesInTile =
             std::min(m_nMaxFeatures, nFeaturesInTile);
-        char *pszSQL =
-            sqlite3_mprintf("SELECT layer, feature FROM temp "
-                            "WHERE z = %d AND x = %d AND y = %d ORDER BY "
-                            "area_or_length DESC LIMIT %d",
-                            nZ, nX, nY, nTotalFeaturesInTile);
-        sqlite3_stmt *hTmpStmt = nullptr;
-        CPL_IGNORE_RET_VAL(
-            sqlite3_prepare_v2(m_hDB, pszSQL, -1, &hTmpStmt, nullptr));
-        sqlite3_free(pszSQL);
-        if (!hTmpStmt)
-            return std::string();
+
+        // Select the nTotalFeaturesInTile fragments of largest area / length
+        std::vector<const MVTFragmentStore::Fragment *> apsSelected;
+        apsSelected.reserve(asFragments.size());
+        for (const auto &sFragment : asFragments)
+            apsSelected.push_back(&sFragment);
+        std::stable_sort(apsSelected.begin(), apsSelected.end(),
+                         [](const MVTFragmentStore::Fragment *a,
+                            const MVTFragmentStore::Fragment *b)
+                         { return a->dfAreaOrLength > b->dfAreaOrLength; });
+        if (apsSelected.size() > nTotalFeaturesInTile)
+            apsSelected.resize(nTotalFeaturesInTile);
 
         class TargetTileLayerProps
         {
@@ -5127,17 +5173,15 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         nFeaturesInTile = 0;
         const unsigned nCheckStep = std::max(1U, nTotalFeaturesInTile / 100);
-        while (sqlite3_step(hTmpStmt) == SQLITE_ROW)
+        for (const auto *psFragment : apsSelected)
         {
-            const char *pszLayerName = reinterpret_cast<const char *>(
-                sqlite3_column_text(hTmpStmt, 0));
-            int nBlobSize = sqlite3_column_bytes(hTmpStmt, 1);
-            const void *pabyBlob = sqlite3_column_blob(hTmpStmt, 1);
+            const std::string &osLayerName =
+                m_oFragmentStore.GetLayerName(psFragment->nLayerIdx);
 
             std::shared_ptr<MVTTileLayer> poTargetLayer;
             std::map<CPLString, GUInt32> *poMapKeyToIdx;
             std::map<MVTTileLayerValue, GUInt32> *poMapValueToIdx;
-            auto oIter = oMapLayerNameToTargetLayer.find(pszLayerName);
+            auto oIter = oMapLayerNameToTargetLayer.find(osLayerName);
             if (oIter == oMapLayerNameToTargetLayer.end())
             {
                 poTargetLayer =
@@ -5145,14 +5189,14 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 TargetTileLayerProps props;
                 props.m_poLayer = poTargetLayer;
                 oTargetTile.addLayer(poTargetLayer);
-                poTargetLayer->setName(pszLayerName);
+                poTargetLayer->setName(osLayerName);
                 poTargetLayer->setVersion(m_nMVTVersion);
                 poTargetLayer->setExtent(nExtent);
-                oMapLayerNameToTargetLayer[pszLayerName] = std::move(props);
+                oMapLayerNameToTargetLayer[osLayerName] = std::move(props);
                 poMapKeyToIdx =
-                    &oMapLayerNameToTargetLayer[pszLayerName].m_oMapKeyToIdx;
+                    &oMapLayerNameToTargetLayer[osLayerName].m_oMapKeyToIdx;
                 poMapValueToIdx =
-                    &oMapLayerNameToTargetLayer[pszLayerName].m_oMapValueToIdx;
+                    &oMapLayerNameToTargetLayer[osLayerName].m_oMapValueToIdx;
             }
             else
             {
@@ -5161,8 +5205,10 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 poMapValueToIdx = &oIter->second.m_oMapValueToIdx;
             }
 
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, *poMapKeyToIdx,
-                          *poMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
+            const auto &osFeature = psFragment->osFeature;
+            EncodeFeature(osFeature.data(), static_cast<int>(osFeature.size()),
+                          poTargetLayer, *poMapKeyToIdx, *poMapValueToIdx,
+                          nullptr, nExtent, nFeaturesInTile);
 
             if (nFeaturesInTile == nTotalFeaturesInTile ||
                 (bTooBigTile && (nFeaturesInTile % nCheckStep == 0)))
@@ -5183,8 +5229,6 @@ std::string OGRMVTWriterDataset::EncodeTile(
             CPLDebug("MVT", "For tile %d/%d/%d, final tile size is %u", nZ, nX,
                      nY, static_cast<unsigned>(oTileBuffer.size()));
         }
-
-        sqlite3_finalize(hTmpStmt);
     }
 
     return oTileBuffer;
@@ -5195,49 +5239,38 @@ std::string OGRMVTWriterDataset::EncodeTile(
 /************************************************************************/
 
 std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
-    int nZ, int nX, int nY, int nExtent, sqlite3_stmt *hStmtLayer,
-    sqlite3_stmt *hStmtRows)
+    int nExtent, const std::vector<MVTFragmentStore::Fragment> &asFragments)
 {
     MVTTile oTargetTile;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
     unsigned nFeaturesInTile = 0;
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    for (size_t i = 0;
+         nFeaturesInTile < m_nMaxFeatures && i < asFragments.size();)
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+        const uint32_t nLayerIdx = asFragments[i].nLayerIdx;
 
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
+        poTargetLayer->setName(m_oFragmentStore.GetLayerName(nLayerIdx));
         poTargetLayer->setVersion(m_nMVTVersion);
         poTargetLayer->setExtent(nExtent);
 
         std::map<CPLString, GUInt32> oMapKeyToIdx;
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
-        while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+        for (; nFeaturesInTile < m_nMaxFeatures && i < asFragments.size() &&
+               asFragments[i].nLayerIdx == nLayerIdx;
+             ++i)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
+            const auto &osFeature = asFragments[i].osFeature;
+            EncodeFeature(osFeature.data(), static_cast<int>(osFeature.size()),
+                          poTargetLayer, oMapKeyToIdx, oMapValueToIdx, nullptr,
+                          nExtent, nFeaturesInTile);
         }
-        sqlite3_reset(hStmtRows);
+        while (i < asFragments.size() && asFragments[i].nLayerIdx == nLayerIdx)
+            ++i;
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     if (m_bGZip)
         GZIPCompress(oTileBuffer);
@@ -5262,43 +5295,14 @@ bool OGRMVTWriterDataset::CreateOutput()
         return GenerateMetadata(0, oMapLayerProps);
     }
 
-    CPLDebug("MVT", "Building output file from temporary database...");
-
-    sqlite3_stmt *hStmtZXY = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        m_hDB, "SELECT DISTINCT z, x, y FROM temp ORDER BY z, x, y", -1,
-        &hStmtZXY, nullptr));
-    if (hStmtZXY == nullptr)
+    if (m_bWriteFeatureError)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Error while generating feature fragments");
         return false;
     }
 
-    sqlite3_stmt *hStmtLayer = nullptr;
-    CPL_IGNORE_RET_VAL(
-        sqlite3_prepare_v2(m_hDB,
-                           "SELECT DISTINCT layer FROM temp "
-                           "WHERE z = ? AND x = ? AND y = ? ORDER BY layer",
-                           -1, &hStmtLayer, nullptr));
-    if (hStmtLayer == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        return false;
-    }
-    sqlite3_stmt *hStmtRows = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        m_hDB,
-        "SELECT feature FROM temp "
-        "WHERE z = ? AND x = ? AND y = ? AND layer = ? ORDER BY idx",
-        -1, &hStmtRows, nullptr));
-    if (hStmtRows == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        sqlite3_finalize(hStmtLayer);
-        return false;
-    }
+    CPLDebug("MVT", "Building output file from temporary file...");
 
     sqlite3_stmt *hInsertStmt = nullptr;
     if (m_hDBMBTILES)
@@ -5311,31 +5315,71 @@ bool OGRMVTWriterDataset::CreateOutput()
         if (hInsertStmt == nullptr)
         {
             CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-            sqlite3_finalize(hStmtZXY);
-            sqlite3_finalize(hStmtLayer);
-            sqlite3_finalize(hStmtRows);
             return false;
         }
     }
 
+    // Tiles are encoded by batches, which are dispatched to the worker
+    // threads, and written in (z, x, y) order once a round of batches is
+    // completed. The batch boundaries do not depend on the number of threads,
+    // so that the output is deterministic.
+    struct TileToEncode
+    {
+        int nZ = 0;
+        int nX = 0;
+        int nY = 0;
+        std::vector<MVTFragmentStore::Fragment> asFragments{};
+        std::string osTileData{};
+        std::map<CPLString, MVTLayerProperties> oMapLayerProps{};
+    };
+
+    struct Batch
+    {
+        std::vector<TileToEncode> asTiles{};
+        size_t nFragmentBytes = 0;
+        CPLErrorAccumulator oErrorAccumulator{};
+    };
+
+    constexpr size_t knMAX_TILES_PER_BATCH = 64;
+    constexpr size_t knMAX_FRAGMENT_BYTES_PER_BATCH = 16 * 1024 * 1024;
+    const size_t nMaxBatchesPerRound =
+        m_bThreadPoolOK
+            ? static_cast<size_t>(std::max(1, m_oThreadPool.GetThreadCount()))
+            : 1;
+
+    std::vector<std::unique_ptr<Batch>> apoBatches;
+    const GIntBig nTotalFragments = m_oFragmentStore.GetCount();
+    const GIntBig nProgressStep =
+        std::max(static_cast<GIntBig>(1), nTotalFragments / 10);
+    GIntBig nFragmentsRead = 0;
     int nLastZ = -1;
     int nLastX = -1;
     bool bRet = true;
-    GIntBig nTempTilesRead = 0;
 
-    while (sqlite3_step(hStmtZXY) == SQLITE_ROW)
+    const auto EncodeBatch = [this](Batch *poBatch)
     {
-        int nZ = sqlite3_column_int(hStmtZXY, 0);
-        int nX = sqlite3_column_int(hStmtZXY, 1);
-        int nY = sqlite3_column_int(hStmtZXY, 2);
-
-        std::string oTileBuffer(EncodeTile(nZ, nX, nY, hStmtLayer, hStmtRows,
-                                           oMapLayerProps, oSetLayers,
-                                           nTempTilesRead));
+        auto oAccumulator = poBatch->oErrorAccumulator.InstallForCurrentScope();
+        CPL_IGNORE_RET_VAL(oAccumulator);
+        for (auto &oTile : poBatch->asTiles)
+        {
+            oTile.osTileData = EncodeTile(oTile.nZ, oTile.nX, oTile.nY,
+                                          oTile.asFragments,
+                                          oTile.oMapLayerProps);
+            std::vector<MVTFragmentStore::Fragment>().swap(oTile.asFragments);
+        }
+    };
 
+    const auto WriteTile = [this, hInsertStmt, &nLastZ,
+                            &nLastX](const TileToEncode &oTile)
+    {
+        const int nZ = oTile.nZ;
+        const int nX = oTile.nX;
+        const int nY = oTile.nY;
+        const std::string &oTileBuffer = oTile.osTileData;
+        bool bOK = true;
         if (oTileBuffer.empty())
         {
-            bRet = false;
+            bOK = false;
         }
         else if (hInsertStmt)
         {
@@ -5346,9 +5390,13 @@ bool OGRMVTWriterDataset::CreateOutput()
                               static_cast<int>(oTileBuffer.size()),
                               SQLITE_STATIC);
             const int rc = sqlite3_step(hInsertStmt);
-            bRet = (rc == SQLITE_OK || rc == SQLITE_DONE);
+            bOK = (rc == SQLITE_OK || rc == SQLITE_DONE);
             sqlite3_reset(hInsertStmt);
         }
+        else if (m_poTileSink)
+        {
+            bOK = m_poTileSink->WriteTile(nZ, nX, nY, std::string(oTileBuffer));
+        }
         else
         {
             const std::string osZDirname(CPLFormFilenameSafe(
@@ -5374,25 +5422,119 @@ bool OGRMVTWriterDataset::CreateOutput()
             {
                 const size_t nRet = VSIFWriteL(oTileBuffer.data(), 1,
                                                oTileBuffer.size(), fpOut);
-                bRet = (nRet == oTileBuffer.size());
+                bOK = (nRet == oTileBuffer.size());
                 VSIFCloseL(fpOut);
             }
             else
             {
-                bRet = false;
+                bOK = false;
             }
         }
 
-        if (!bRet)
+        if (!bOK)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Error while writing tile %d/%d/%d", nZ, nX, nY);
-            break;
         }
-    }
-    sqlite3_finalize(hStmtZXY);
-    sqlite3_finalize(hStmtLayer);
-    sqlite3_finalize(hStmtRows);
+        return bOK;
+    };
+
+    // Encode the pending batches, and write their tiles
+    const auto FlushBatches = [&]()
+    {
+        if (m_bThreadPoolOK && apoBatches.size() > 1)
+        {
+            for (auto &poBatch : apoBatches)
+            {
+                Batch *poBatchPtr = poBatch.get();
+                m_oThreadPool.SubmitJob([&EncodeBatch, poBatchPtr]()
+                                        { EncodeBatch(poBatchPtr); });
+            }
+            m_oThreadPool.WaitCompletion();
+        }
+        else
+        {
+            for (auto &poBatch : apoBatches)
+                EncodeBatch(poBatch.get());
+        }
+
+        bool bOK = true;
+        for (auto &poBatch : apoBatches)
+        {
+            poBatch->oErrorAccumulator.ReplayErrors();
+            for (auto &oTile : poBatch->asTiles)
+            {
+                MergeLayerProperties(oMapLayerProps, oSetLayers,
+                                     oTile.oMapLayerProps);
+                if (bOK && !WriteTile(oTile))
+                    bOK = false;
+            }
+        }
+        apoBatches.clear();
+        return bOK;
+    };
+
+    bRet = m_oFragmentStore.ForEachTile(
+        [&](int nZ, int nX, int nY,
+            std::vector<MVTFragmentStore::Fragment> &asFragments)
+        {
+            // Order of layers and features within the tile
+            std::sort(asFragments.begin(), asFragments.end(),
+                      [this](const MVTFragmentStore::Fragment &a,
+                             const MVTFragmentStore::Fragment &b)
+                      {
+                          if (a.nLayerIdx != b.nLayerIdx)
+                          {
+                              return m_oFragmentStore.GetLayerName(
+                                         a.nLayerIdx) <
+                                     m_oFragmentStore.GetLayerName(
+                                         b.nLayerIdx);
+                          }
+                          return a.nSerial < b.nSerial;
+                      });
+
+            if (apoBatches.empty() ||
+                apoBatches.back()->asTiles.size() == knMAX_TILES_PER_BATCH ||
+                apoBatches.back()->nFragmentBytes >=
+                    knMAX_FRAGMENT_BYTES_PER_BATCH)
+            {
+                if (apoBatches.size() == nMaxBatchesPerRound &&
+                    !FlushBatches())
+                {
+                    return false;
+                }
+                apoBatches.emplace_back(std::make_unique<Batch>());
+            }
+            auto &poBatch = apoBatches.back();
+            poBatch->asTiles.emplace_back();
+            auto &oTile = poBatch->asTiles.back();
+            oTile.nZ = nZ;
+            oTile.nX = nX;
+            oTile.nY = nY;
+            for (const auto &sFragment : asFragments)
+                poBatch->nFragmentBytes += sFragment.osFeature.size();
+            oTile.asFragments = std::move(asFragments);
+            asFragments = std::vector<MVTFragmentStore::Fragment>();
+
+            const GIntBig nFragmentsInTile =
+                static_cast<GIntBig>(oTile.asFragments.size());
+            if ((nFragmentsRead + nFragmentsInTile) / nProgressStep !=
+                    nFragmentsRead / nProgressStep ||
+                nFragmentsRead + nFragmentsInTile == nTotalFragments)
+            {
+                const int nPct = static_cast<int>(
+                    (100 * (nFragmentsRead + nFragmentsInTile)) /
+                    nTotalFragments);
+                CPLDebug("MVT", "%d%%...", nPct);
+            }
+            nFragmentsRead += nFragmentsInTile;
+            return true;
+        });
+    if (bRet)
+        bRet = FlushBatches();
+    else
+        apoBatches.clear();
+
     if (hInsertStmt)
         sqlite3_finalize(hInsertStmt);
 
@@ -5764,6 +5906,11 @@ bool OGRMVTWriterDataset::GenerateMetadata(
         return true;
     }
 
+    if (m_poTileSink)
+    {
+        return m_poTileSink->WriteMetadata(oRoot);
+    }
+
     return oDoc.Save(
         CPLFormFilenameSafe(GetDescription(), "metadata.json", nullptr));
 }
@@ -5801,111 +5948,106 @@ OGRErr OGRMVTWriterDataset::WriteFeature(OGRMVTWriterLayer *poLayer,
 
     if (!m_oEnvelope.IsInit())
     {
-        CPLDebug("MVT", "Creating temporary database...");
+        CPLDebug("MVT", "Creating temporary file...");
     }
 
     m_oEnvelope.Merge(sExtent);
 
-    if (!m_bReuseTempFile)
-    {
-        auto poFeatureContent =
-            std::shared_ptr<OGRMVTFeatureContent>(new OGRMVTFeatureContent());
-        auto poSharedGeom = std::shared_ptr<OGRGeometry>(poGeom->clone());
+    auto poFeatureContent =
+        std::shared_ptr<OGRMVTFeatureContent>(new OGRMVTFeatureContent());
+    auto poSharedGeom = std::shared_ptr<OGRGeometry>(poGeom->clone());
 
-        poFeatureContent->nFID = poFeature->GetFID();
+    poFeatureContent->nFID = poFeature->GetFID();
 
-        const OGRFeatureDefn *poFDefn = poFeature->GetDefnRef();
-        for (int i = 0; i < poFeature->GetFieldCount(); i++)
+    const OGRFeatureDefn *poFDefn = poFeature->GetDefnRef();
+    for (int i = 0; i < poFeature->GetFieldCount(); i++)
+    {
+        if (poFeature->IsFieldSetAndNotNull(i))
         {
-            if (poFeature->IsFieldSetAndNotNull(i))
+            MVTTileLayerValue oValue;
+            const OGRFieldDefn *poFieldDefn = poFDefn->GetFieldDefn(i);
+            OGRFieldType eFieldType = poFieldDefn->GetType();
+            if (eFieldType == OFTInteger || eFieldType == OFTInteger64)
             {
-                MVTTileLayerValue oValue;
-                const OGRFieldDefn *poFieldDefn = poFDefn->GetFieldDefn(i);
-                OGRFieldType eFieldType = poFieldDefn->GetType();
-                if (eFieldType == OFTInteger || eFieldType == OFTInteger64)
+                if (poFieldDefn->GetSubType() == OFSTBoolean)
                 {
-                    if (poFieldDefn->GetSubType() == OFSTBoolean)
-                    {
-                        oValue.setBoolValue(poFeature->GetFieldAsInteger(i) !=
-                                            0);
-                    }
-                    else
-                    {
-                        oValue.setValue(poFeature->GetFieldAsInteger64(i));
-                    }
+                    oValue.setBoolValue(poFeature->GetFieldAsInteger(i) != 0);
                 }
-                else if (eFieldType == OFTReal)
+                else
                 {
-                    oValue.setValue(poFeature->GetFieldAsDouble(i));
+                    oValue.setValue(poFeature->GetFieldAsInteger64(i));
                 }
-                else if (eFieldType == OFTDate || eFieldType == OFTDateTime)
+            }
+            else if (eFieldType == OFTReal)
+            {
+                oValue.setValue(poFeature->GetFieldAsDouble(i));
+            }
+            else if (eFieldType == OFTDate || eFieldType == OFTDateTime)
+            {
+                int nYear, nMonth, nDay, nHour, nMin, nTZ;
+                float fSec;
+                poFeature->GetFieldAsDateTime(i, &nYear, &nMonth, &nDay,
+                                              &nHour, &nMin, &fSec, &nTZ);
+                CPLString osFormatted;
+                if (eFieldType == OFTDate)
                 {
-                    int nYear, nMonth, nDay, nHour, nMin, nTZ;
-                    float fSec;
-                    poFeature->GetFieldAsDateTime(i, &nYear, &nMonth, &nDay,
-                                                  &nHour, &nMin, &fSec, &nTZ);
-                    CPLString osFormatted;
-                    if (eFieldType == OFTDate)
-                    {
-                        osFormatted.Printf("%04d-%02d-%02d", nYear, nMonth,
-                                           nDay);
-                    }
-                    else
-                    {
-                        char *pszFormatted =
-                            OGRGetXMLDateTime(poFeature->GetRawFieldRef(i));
-                        osFormatted = pszFormatted;
-                        CPLFree(pszFormatted);
-                    }
-                    oValue.setStringValue(osFormatted);
+                    osFormatted.Printf("%04d-%02d-%02d", nYear, nMonth, nDay);
                 }
                 else
                 {
-                    oValue.setStringValue(
-                        std::string(poFeature->GetFieldAsString(i)));
+                    char *pszFormatted =
+                        OGRGetXMLDateTime(poFeature->GetRawFieldRef(i));
+                    osFormatted = pszFormatted;
+                    CPLFree(pszFormatted);
                 }
-
-                poFeatureContent->oValues.emplace_back(
-                    std::pair<std::string, MVTTileLayerValue>(
-                        poFieldDefn->GetNameRef(), oValue));
+                oValue.setStringValue(osFormatted);
             }
+            else
+            {
+                oValue.setStringValue(
+                    std::string(poFeature->GetFieldAsString(i)));
+            }
+
+            poFeatureContent->oValues.emplace_back(
+                std::pair<std::string, MVTTileLayerValue>(
+                    poFieldDefn->GetNameRef(), oValue));
         }
+    }
 
-        for (int nZ = poLayer->m_nMinZoom; nZ <= poLayer->m_nMaxZoom; nZ++)
+    for (int nZ = poLayer->m_nMinZoom; nZ <= poLayer->m_nMaxZoom; nZ++)
+    {
+        double dfTileDim = m_dfTileDim0 / (1 << nZ);
+        double dfBuffer = dfTileDim * m_nBuffer / m_nExtent;
+        const int nTileMinX = std::max(
+            0, static_cast<int>((sExtent.MinX - m_dfTopX - dfBuffer) /
+                                dfTileDim));
+        const int nTileMinY = std::max(
+            0, static_cast<int>((m_dfTopY - sExtent.MaxY - dfBuffer) /
+                                dfTileDim));
+        const int nTileMaxX =
+            std::min(static_cast<int>((sExtent.MaxX - m_dfTopX + dfBuffer) /
+                                      dfTileDim),
+                     static_cast<int>(std::min<int64_t>(
+                         INT_MAX, (static_cast<int64_t>(1) << nZ) *
+                                          m_nTileMatrixWidth0 -
+                                      1)));
+        const int nTileMaxY =
+            std::min(static_cast<int>((m_dfTopY - sExtent.MinY + dfBuffer) /
+                                      dfTileDim),
+                     static_cast<int>(std::min<int64_t>(
+                         INT_MAX, (static_cast<int64_t>(1) << nZ) *
+                                          m_nTileMatrixHeight0 -
+                                      1)));
+        for (int iX = nTileMinX; iX <= nTileMaxX; iX++)
         {
-            double dfTileDim = m_dfTileDim0 / (1 << nZ);
-            double dfBuffer = dfTileDim * m_nBuffer / m_nExtent;
-            const int nTileMinX = std::max(
-                0, static_cast<int>((sExtent.MinX - m_dfTopX - dfBuffer) /
-                                    dfTileDim));
-            const int nTileMinY = std::max(
-                0, static_cast<int>((m_dfTopY - sExtent.MaxY - dfBuffer) /
-                                    dfTileDim));
-            const int nTileMaxX =
-                std::min(static_cast<int>((sExtent.MaxX - m_dfTopX + dfBuffer) /
-                                          dfTileDim),
-                         static_cast<int>(std::min<int64_t>(
-                             INT_MAX, (static_cast<int64_t>(1) << nZ) *
-                                              m_nTileMatrixWidth0 -
-                                          1)));
-            const int nTileMaxY =
-                std::min(static_cast<int>((m_dfTopY - sExtent.MinY + dfBuffer) /
-                                          dfTileDim),
-                         static_cast<int>(std::min<int64_t>(
-                             INT_MAX, (static_cast<int64_t>(1) << nZ) *
-                                              m_nTileMatrixHeight0 -
-                                          1)));
-            for (int iX = nTileMinX; iX <= nTileMaxX; iX++)
+            for (int iY = nTileMinY; iY <= nTileMaxY; iY++)
             {
-                for (int iY = nTileMinY; iY <= nTileMaxY; iY++)
+                if (PreGenerateForTile(
+                        nZ, iX, iY, poLayer->m_osTargetName,
+                        (nZ == poLayer->m_nMaxZoom), poFeatureContent,
+                        nSerial, poSharedGeom, sExtent) != OGRERR_NONE)
                 {
-                    if (PreGenerateForTile(
-                            nZ, iX, iY, poLayer->m_osTargetName,
-                            (nZ == poLayer->m_nMaxZoom), poFeatureContent,
-                            nSerial, poSharedGeom, sExtent) != OGRERR_NONE)
-                    {
-                        return OGRERR_FAILURE;
-                    }
+                    return OGRERR_FAILURE;
                 }
             }
         }
@@ -6038,6 +6180,20 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
         return nullptr;
     }
 
+    return CreateInternal(pszFilename, papszOptions, nullptr);
+}
+
+/************************************************************************/
+/*                           CreateInternal()                           */
+/************************************************************************/
+
+// When poTileSink is not null, encoded tiles and metadata are sent to it,
+// and nothing is created at pszFilename, except the temporary database
+// whose default name derives from it.
+GDALDataset *OGRMVTWriterDataset::CreateInternal(const char *pszFilename,
+                                                 char **papszOptions,
+                                                 OGRMVTTileSink *poTileSink)
+{
     const char *pszFormat = CSLFetchNameValue(papszOptions, "FORMAT");
     const bool bMBTILESExt =
         EQUAL(CPLGetExtensionSafe(pszFilename).c_str(), "mbtiles");
@@ -6045,11 +6201,8 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
     {
         pszFormat = "MBTILES";
     }
-    const bool bMBTILES = pszFormat != nullptr && EQUAL(pszFormat, "MBTILES");
-
-    // For debug only
-    bool bReuseTempFile =
-        CPLTestBool(CPLGetConfigOption("OGR_MVT_REUSE_TEMP_FILE", "NO"));
+    const bool bMBTILES = poTileSink == nullptr && pszFormat != nullptr &&
+                          EQUAL(pszFormat, "MBTILES");
 
     if (bMBTILES)
     {
@@ -6062,7 +6215,7 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
 
         VSIUnlink(pszFilename);
     }
-    else
+    else if (poTileSink == nullptr)
     {
         VSIStatBufL sStat;
         if (VSIStatL(pszFilename, &sStat) == 0)
@@ -6080,75 +6233,39 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
     }
 
     OGRMVTWriterDataset *poDS = new OGRMVTWriterDataset();
+    poDS->m_poTileSink = poTileSink;
     poDS->m_pMyVFS = OGRSQLiteCreateVFS(nullptr, poDS);
     sqlite3_vfs_register(poDS->m_pMyVFS, 0);
 
-    CPLString osTempDBDefault = CPLString(pszFilename) + ".temp.db";
-    if (STARTS_WITH(osTempDBDefault, "/vsizip/"))
+    CPLString osTempFileDefault = CPLString(pszFilename) + ".tmp_fragments";
+    if (STARTS_WITH(osTempFileDefault, "/vsizip/"))
     {
-        osTempDBDefault =
-            CPLString(pszFilename + strlen("/vsizip/")) + ".temp.db";
+        osTempFileDefault =
+            CPLString(pszFilename + strlen("/vsizip/")) + ".tmp_fragments";
     }
-    CPLString osTempDB = CSLFetchNameValueDef(papszOptions, "TEMPORARY_DB",
-                                              osTempDBDefault.c_str());
-    if (!bReuseTempFile)
-        VSIUnlink(osTempDB);
+    const CPLString osTempFile = CSLFetchNameValueDef(
+        papszOptions, "TEMPORARY_DB", osTempFileDefault.c_str());
 
-    sqlite3 *hDB = nullptr;
-    if (sqlite3_open_v2(osTempDB, &hDB,
-                        SQLITE_OPEN_READWRITE |
-                            (bReuseTempFile ? 0 : SQLITE_OPEN_CREATE) |
-                            SQLITE_OPEN_NOMUTEX,
-                        poDS->m_pMyVFS->zName) != SQLITE_OK ||
-        hDB == nullptr)
+    GIntBig nMaxRAM = 0;
+    const char *pszMaxRAM = CPLGetConfigOption("OGR_MVT_SORT_MAX_RAM", nullptr);
+    if (pszMaxRAM == nullptr ||
+        CPLParseMemorySize(pszMaxRAM, &nMaxRAM, nullptr) != CE_None)
     {
-        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", osTempDB.c_str());
-        delete poDS;
-        sqlite3_close(hDB);
-        return nullptr;
+        const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+        nMaxRAM = nUsableRAM > 0 ? nUsableRAM / 4 : 256 * 1024 * 1024;
     }
-    poDS->m_osTempDB = osTempDB;
-    poDS->m_hDB = hDB;
-    poDS->m_bReuseTempFile = bReuseTempFile;
+    nMaxRAM = std::min<GIntBig>(
+        std::max<GIntBig>(1, nMaxRAM),
+        static_cast<GIntBig>(std::numeric_limits<size_t>::max() / 2));
 
-    // For Unix
-    if (!poDS->m_bReuseTempFile &&
-        CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
-    {
-        VSIUnlink(osTempDB);
-    }
-
-    if (poDS->m_bReuseTempFile)
-    {
-        poDS->m_nTempTiles =
-            SQLGetInteger64(hDB, "SELECT COUNT(*) FROM temp", nullptr);
-    }
-    else
-    {
-        CPL_IGNORE_RET_VAL(SQLCommand(
-            hDB,
-            "PRAGMA page_size = 4096;"  // 4096: default since sqlite 3.12
-            "PRAGMA synchronous = OFF;"
-            "PRAGMA journal_mode = OFF;"
-            "PRAGMA temp_store = MEMORY;"
-            "CREATE TABLE temp(z INTEGER, x INTEGER, y INTEGER, layer TEXT, "
-            "idx INTEGER, feature BLOB, geomtype INTEGER, area_or_length "
-            "DOUBLE);"
-            "CREATE INDEX temp_index ON temp (z, x, y, layer, idx);"));
-    }
-
-    sqlite3_stmt *hInsertStmt = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        hDB,
-        "INSERT INTO temp (z,x,y,layer,idx,feature,geomtype,area_or_length) "
-        "VALUES (?,?,?,?,?,?,?,?)",
-        -1, &hInsertStmt, nullptr));
-    if (hInsertStmt == nullptr)
+    if (!poDS->m_oFragmentStore.Open(
+            osTempFile,
+            CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")),
+            static_cast<size_t>(nMaxRAM)))
     {
         delete poDS;
         return nullptr;
     }
-    poDS->m_hInsertStmt = hInsertStmt;
 
     poDS->m_nMinZoom = atoi(CSLFetchNameValueDef(
         papszOptions, "MINZOOM", CPLSPrintf("%d", poDS->m_nMinZoom)));
@@ -6233,10 +6350,11 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
         CSLFetchNameValue(papszOptions, "TILING_SCHEME");
     if (pszTilingScheme)
     {
-        if (bMBTILES)
+        if (bMBTILES || poTileSink)
         {
             CPLError(CE_Failure, CPLE_NotSupported,
-                     "Custom TILING_SCHEME not supported with MBTILES output");
+                     "Custom TILING_SCHEME not supported with %s output",
+                     bMBTILES ? "MBTILES" : "this");
             delete poDS;
             return nullptr;
         }
@@ -6327,6 +6445,14 @@ GDALDataset *OGRMVTWriterDatasetCreate(const char *pszFilename, int nXSize,
                                        eDT, papszOptions);
 }
 
+GDALDataset *OGRMVTWriterDatasetCreateForTileSink(const char *pszFilename,
+                                                  char **papszOptions,
+                                                  OGRMVTTileSink *poTileSink)
+{
+    return OGRMVTWriterDataset::CreateInternal(pszFilename, papszOptions,
+                                               poTileSink);
+}
+
 #endif  // HAVE_MVT_WRITE_SUPPORT
 
 /************************************************************************/
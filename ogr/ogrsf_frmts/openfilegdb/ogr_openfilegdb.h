@@ -22,8 +22,9 @@
 #include "gdal_rat.h"
 
 #include <array>
-#include <vector>
 #include <map>
+#include <memory>
+#include <vector>
 
 using namespace OpenFileGDB;
 
@@ -172,6 +173,19 @@ class OGROpenFileGDBLayer final : public OGRLayer
     std::string GetLaunderedFieldName(const std::string &osNameOri) const;
     std::string GetLaunderedLayerName(const std::string &osNameOri) const;
 
+    // Used by GetNextArrowArray()
+    bool m_bLastGetNextArrowArrayUsedOptimizedCodePath = false;
+    //! Rows selected by the filters, not yet returned by GetNextArrowArray()
+    std::vector<int64_t> m_anArrowCandidateRows{};
+    size_t m_nArrowCandidateRowsIdx = 0;
+    //! Additional table handles to decode rows from worker threads
+    std::vector<std::unique_ptr<FileGDBTable>> m_apoArrowWorkerTables{};
+    std::vector<std::unique_ptr<FileGDBOGRGeometryConverter>>
+        m_apoArrowWorkerGeomConverters{};
+    bool CanUseOptimizedGetNextArrowArray();
+    void CollectArrowCandidateRows(size_t nMaxRows);
+    int GetArrowWorkerTableCount(size_t nRows);
+
     mutable std::vector<std::string> m_aosTempStrings{};
     bool PrepareFileGDBFeature(OGRFeature *poFeature,
                                std::vector<OGRField> &fields,
@@ -264,6 +278,11 @@ class OGROpenFileGDBLayer final : public OGRLayer
     virtual OGRFeature *GetFeature(GIntBig nFeatureId) override;
     virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
 
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
+    const char *GetMetadataItem(const char *pszName,
+                                const char *pszDomain) override;
+
     virtual GIntBig GetFeatureCount(int bForce = TRUE) override;
     OGRErr IGetExtent(int iGeomField, OGREnvelope *psExtent,
                       bool bForce) override;
@@ -38,6 +38,10 @@
 #include "filegdbtable.h"
 #include "ogr_swq.h"
 #include "filegdb_coordprec_read.h"
+#include "ograrrowarrayhelper.h"
+#include "ogrlayerarrow.h"
+#include "cpl_error_internal.h"
+#include "gdal_thread_pool.h"
 
 OGROpenFileGDBGeomFieldDefn::~OGROpenFileGDBGeomFieldDefn() = default;
 
@@ -124,6 +128,8 @@ OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 
 void OGROpenFileGDBLayer::Close()
 {
+    m_apoArrowWorkerGeomConverters.clear();
+    m_apoArrowWorkerTables.clear();
     delete m_poLyrTable;
     m_poLyrTable = nullptr;
     m_bValidLayerDefn = FALSE;
@@ -906,6 +912,8 @@ void OGROpenFileGDBLayer::ResetReading()
     }
     m_bEOF = FALSE;
     m_iCurFeat = 0;
+    m_anArrowCandidateRows.clear();
+    m_nArrowCandidateRowsIdx = 0;
     if (m_poAttributeIterator)
         m_poAttributeIterator->Reset();
     if (m_poSpatialIndexIterator)
@@ -1719,6 +1727,36 @@ void OGROpenFileGDBLayer::BuildCombinedIterator()
     }
 }
 
+/***********************************************************************/
+/*                    OGROpenFileGDBPromoteGeometry()                  */
+/***********************************************************************/
+
+// Promote single part polygons and lines to their multi-part counterpart,
+// consistently with the layer geometry type.
+static OGRGeometry *OGROpenFileGDBPromoteGeometry(OGRGeometry *poGeom)
+{
+    if (poGeom == nullptr)
+        return nullptr;
+    OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
+    if (eFlattenType == wkbPolygon)
+        poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
+    else if (eFlattenType == wkbCurvePolygon)
+    {
+        OGRMultiSurface *poMS = new OGRMultiSurface();
+        poMS->addGeometryDirectly(poGeom);
+        poGeom = poMS;
+    }
+    else if (eFlattenType == wkbLineString)
+        poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
+    else if (eFlattenType == wkbCompoundCurve)
+    {
+        OGRMultiCurve *poMC = new OGRMultiCurve();
+        poMC->addGeometryDirectly(poGeom);
+        poGeom = poMC;
+    }
+    return poGeom;
+}
+
 /***********************************************************************/
 /*                         GetCurrentFeature()                         */
 /***********************************************************************/
@@ -1784,30 +1822,10 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
                     return nullptr;
                 }
 
-                OGRGeometry *poGeom = m_poGeomConverter->GetAsGeometry(psField);
+                OGRGeometry *poGeom = OGROpenFileGDBPromoteGeometry(
+                    m_poGeomConverter->GetAsGeometry(psField));
                 if (poGeom != nullptr)
                 {
-                    OGRwkbGeometryType eFlattenType =
-                        wkbFlatten(poGeom->getGeometryType());
-                    if (eFlattenType == wkbPolygon)
-                        poGeom =
-                            OGRGeometryFactory::forceToMultiPolygon(poGeom);
-                    else if (eFlattenType == wkbCurvePolygon)
-                    {
-                        OGRMultiSurface *poMS = new OGRMultiSurface();
-                        poMS->addGeometryDirectly(poGeom);
-                        poGeom = poMS;
-                    }
-                    else if (eFlattenType == wkbLineString)
-                        poGeom =
-                            OGRGeometryFactory::forceToMultiLineString(poGeom);
-                    else if (eFlattenType == wkbCompoundCurve)
-                    {
-                        OGRMultiCurve *poMC = new OGRMultiCurve();
-                        poMC->addGeometryDirectly(poGeom);
-                        poGeom = poMC;
-                    }
-
                     poGeom->assignSpatialReference(
                         m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef());
 
@@ -1979,6 +1997,741 @@ OGRFeature *OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/***********************************************************************/
+/*                  CanUseOptimizedGetNextArrowArray()                 */
+/***********************************************************************/
+
+bool OGROpenFileGDBLayer::CanUseOptimizedGetNextArrowArray()
+{
+    if (!m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
+        CPLTestBool(
+            CPLGetConfigOption("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "NO")))
+    {
+        return false;
+    }
+
+    // Attribute filters are only handled when they can be entirely
+    // evaluated with .atx indexes.
+    if (m_poAttrQuery != nullptr &&
+        !(m_poAttributeIterator != nullptr &&
+          m_bIteratorSufficientToEvaluateFilter))
+    {
+        return false;
+    }
+
+    if (m_iFIDAsRegularColumnIndex >= 0 ||
+        m_poLyrTable->HasDeletedFeaturesListed())
+    {
+        return false;
+    }
+
+    if (m_poFilterGeom != nullptr &&
+        (m_iGeomFieldIdx < 0 ||
+         m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored()))
+    {
+        return false;
+    }
+
+    const bool bDateTimeAsString = m_aosArrowArrayStreamOptions.FetchBool(
+        GAS_OPT_DATETIME_AS_STRING, false);
+    int iOGRIdx = 0;
+    for (int iGDBIdx = 0; iGDBIdx < m_poLyrTable->GetFieldCount(); iGDBIdx++)
+    {
+        if (iGDBIdx == m_iGeomFieldIdx ||
+            iGDBIdx == m_poLyrTable->GetObjectIdFieldIdx())
+        {
+            continue;
+        }
+        const OGRFieldDefn *poFieldDefn =
+            m_poFeatureDefn->GetFieldDefn(iOGRIdx);
+        iOGRIdx++;
+        if (poFieldDefn->IsIgnored())
+            continue;
+        if (iGDBIdx == m_iFieldToReadAsBinary)
+            return false;
+
+        const OGRFieldType eType = poFieldDefn->GetType();
+        bool bOK = false;
+        switch (m_poLyrTable->GetField(iGDBIdx)->GetType())
+        {
+            case FGFT_INT16:
+            case FGFT_INT32:
+                bOK = eType == OFTInteger;
+                break;
+            case FGFT_INT64:
+                bOK = eType == OFTInteger64;
+                break;
+            case FGFT_FLOAT32:
+            case FGFT_FLOAT64:
+                bOK = eType == OFTReal;
+                break;
+            case FGFT_STRING:
+            case FGFT_GUID:
+            case FGFT_GLOBALID:
+            case FGFT_XML:
+                bOK = eType == OFTString;
+                break;
+            case FGFT_BINARY:
+                bOK = eType == OFTBinary;
+                break;
+            case FGFT_DATE:
+                bOK = eType == OFTDate;
+                break;
+            case FGFT_DATETIME:
+            case FGFT_DATETIME_WITH_OFFSET:
+                bOK = eType == OFTDateTime && !bDateTimeAsString;
+                break;
+            default:
+                break;
+        }
+        if (!bOK)
+            return false;
+    }
+
+    return true;
+}
+
+/***********************************************************************/
+/*                     CollectArrowCandidateRows()                     */
+/***********************************************************************/
+
+// Fill m_anArrowCandidateRows with up to nMaxRows rows, using the same
+// source of rows as GetNextFeature().
+void OGROpenFileGDBLayer::CollectArrowCandidateRows(size_t nMaxRows)
+{
+    m_anArrowCandidateRows.clear();
+    m_nArrowCandidateRowsIdx = 0;
+    if (m_bEOF)
+        return;
+
+    FileGDBIterator *poIterator = m_poCombinedIterator ? m_poCombinedIterator
+                                  : m_poSpatialIndexIterator
+                                      ? m_poSpatialIndexIterator
+                                      : m_poAttributeIterator;
+
+    if (m_nFilteredFeatureCount >= 0)
+    {
+        while (m_anArrowCandidateRows.size() < nMaxRows &&
+               m_iCurFeat < m_nFilteredFeatureCount)
+        {
+            m_anArrowCandidateRows.push_back(
+                static_cast<int64_t>(reinterpret_cast<GUIntptr_t>(
+                    m_pahFilteredFeatures[m_iCurFeat++])));
+        }
+    }
+    else if (poIterator != nullptr)
+    {
+        while (m_anArrowCandidateRows.size() < nMaxRows)
+        {
+            const auto iRow = poIterator->GetNextRowSortedByFID();
+            if (iRow < 0)
+                break;
+            m_anArrowCandidateRows.push_back(iRow);
+        }
+    }
+    else if (m_poLyrTable->GetValidRecordCount() <
+             m_poLyrTable->GetTotalRecordCount() / 2)
+    {
+        // Sparse table: let GetAndSelectNextNonEmptyRow() skip empty blocks
+        const auto nTotalRecordCount = m_poLyrTable->GetTotalRecordCount();
+        while (m_anArrowCandidateRows.size() < nMaxRows &&
+               m_iCurFeat < nTotalRecordCount)
+        {
+            m_iCurFeat = m_poLyrTable->GetAndSelectNextNonEmptyRow(m_iCurFeat);
+            if (m_iCurFeat < 0)
+            {
+                if (m_poLyrTable->HasGotError())
+                    m_bEOF = TRUE;
+                m_iCurFeat = nTotalRecordCount;
+                break;
+            }
+            m_anArrowCandidateRows.push_back(m_iCurFeat);
+            m_iCurFeat++;
+        }
+    }
+    else
+    {
+        // Empty rows are skipped when decoding.
+        const auto nTotalRecordCount = m_poLyrTable->GetTotalRecordCount();
+        while (m_anArrowCandidateRows.size() < nMaxRows &&
+               m_iCurFeat < nTotalRecordCount)
+        {
+            m_anArrowCandidateRows.push_back(m_iCurFeat);
+            m_iCurFeat++;
+        }
+    }
+}
+
+/***********************************************************************/
+/*                      GetArrowWorkerTableCount()                     */
+/***********************************************************************/
+
+// Return the number of FileGDBTable instances (including m_poLyrTable)
+// that may be used to concurrently decode nRows rows.
+int OGROpenFileGDBLayer::GetArrowWorkerTableCount(size_t nRows)
+{
+    if (m_bEditable)
+        return 1;
+
+    int nThreads =
+        GDALGetNumThreads(nullptr, nullptr, "OPENFILEGDB_NUM_THREADS",
+                          std::min(4, CPLGetNumCPUs()));
+
+    // Not worth the overhead for small batches.
+    constexpr size_t MIN_ROWS_PER_THREAD = 1000;
+    nThreads = static_cast<int>(std::min(
+        static_cast<size_t>(nThreads),
+        std::max(static_cast<size_t>(1), nRows / MIN_ROWS_PER_THREAD)));
+
+    while (static_cast<int>(m_apoArrowWorkerTables.size()) < nThreads - 1)
+    {
+        auto poTable = std::make_unique<FileGDBTable>();
+        if (!poTable->Open(m_osGDBFilename, /* bUpdate = */ false,
+                           GetDescription()) ||
+            poTable->GetFieldCount() != m_poLyrTable->GetFieldCount())
+        {
+            break;
+        }
+        std::unique_ptr<FileGDBOGRGeometryConverter> poGeomConverter;
+        if (m_iGeomFieldIdx >= 0)
+        {
+            poGeomConverter.reset(FileGDBOGRGeometryConverter::BuildConverter(
+                cpl::down_cast<FileGDBGeomField *>(
+                    poTable->GetField(m_iGeomFieldIdx))));
+        }
+        m_apoArrowWorkerTables.push_back(std::move(poTable));
+        m_apoArrowWorkerGeomConverters.push_back(std::move(poGeomConverter));
+    }
+
+    return std::min(nThreads,
+                    1 + static_cast<int>(m_apoArrowWorkerTables.size()));
+}
+
+/***********************************************************************/
+/*                         GetNextArrowArray()                         */
+/***********************************************************************/
+
+namespace
+{
+struct OGROpenFileGDBArrowValue
+{
+    OGRField sField{};
+    size_t nOffset = 0;  // of string, binary or WKB content in abyData
+    size_t nLen = 0;
+    bool bNull = true;
+};
+
+struct OGROpenFileGDBArrowChunk
+{
+    //! Index in m_anArrowCandidateRows of each decoded row
+    std::vector<size_t> anCandidateIdx{};
+    //! (number of columns + 1) values per decoded row. Last one is geometry
+    std::vector<OGROpenFileGDBArrowValue> asValues{};
+    std::vector<GByte> abyData{};
+    bool bError = false;
+};
+
+struct OGROpenFileGDBArrowColumn
+{
+    int iGDBIdx = -1;
+    int iOGRIdx = -1;
+    int iArrowField = -1;
+    OGRFieldType eType = OFTString;
+    OGRFieldSubType eSubType = OFSTNone;
+    FileGDBFieldType eGDBType = FGFT_UNDEFINED;
+};
+}  // namespace
+
+// Specialized implementation that decodes rows directly into Arrow buffers,
+// without going through OGRFeature.
+// Rows to read are selected by the same spatial (.spx) and attribute (.atx)
+// index iterators as GetNextFeature(). Rows of a batch are then partitioned
+// between OPENFILEGDB_NUM_THREADS worker threads, each with its own table
+// handle, that decode attributes and geometries (converted to WKB).
+// Attribute filters that cannot be fully evaluated with indexes fall back
+// to the generic implementation.
+int OGROpenFileGDBLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                           struct ArrowArray *out_array)
+{
+    m_bLastGetNextArrowArrayUsedOptimizedCodePath = false;
+    if (!BuildLayerDefinition())
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+
+    if (!CanUseOptimizedGetNextArrowArray())
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    OGRArrowArrayHelper sHelper(m_poDS, m_poFeatureDefn,
+                                m_aosArrowArrayStreamOptions, out_array);
+    if (out_array->release == nullptr)
+    {
+        return ENOMEM;
+    }
+
+    if (sHelper.m_nChildren == 0)
+    {
+        out_array->release(out_array);
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    m_bLastGetNextArrowArrayUsedOptimizedCodePath = true;
+
+    // We do not go through GetCurrentFeature()
+    if (m_eSpatialIndexState == SPI_IN_BUILDING)
+        m_eSpatialIndexState = SPI_INVALID;
+
+    const auto ReturnError = [out_array]()
+    {
+        out_array->release(out_array);
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    };
+
+    std::vector<OGROpenFileGDBArrowColumn> asColumns;
+    {
+        int iOGRIdx = 0;
+        for (int iGDBIdx = 0; iGDBIdx < m_poLyrTable->GetFieldCount();
+             iGDBIdx++)
+        {
+            if (iGDBIdx == m_iGeomFieldIdx ||
+                iGDBIdx == m_poLyrTable->GetObjectIdFieldIdx())
+            {
+                continue;
+            }
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[iOGRIdx];
+            if (iArrowField >= 0)
+            {
+                const OGRFieldDefn *poFieldDefn =
+                    m_poFeatureDefn->GetFieldDefn(iOGRIdx);
+                OGROpenFileGDBArrowColumn sColumn;
+                sColumn.iGDBIdx = iGDBIdx;
+                sColumn.iOGRIdx = iOGRIdx;
+                sColumn.iArrowField = iArrowField;
+                sColumn.eType = poFieldDefn->GetType();
+                sColumn.eSubType = poFieldDefn->GetSubType();
+                sColumn.eGDBType = m_poLyrTable->GetField(iGDBIdx)->GetType();
+                asColumns.push_back(sColumn);
+            }
+            iOGRIdx++;
+        }
+    }
+    const size_t nColumns = asColumns.size();
+    const size_t nValuesPerRow = nColumns + 1;
+
+    const bool bReadGeometry =
+        m_iGeomFieldIdx >= 0 &&
+        !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored();
+    const int iGeomArrowField =
+        bReadGeometry ? sHelper.m_mapOGRGeomFieldToArrowField[0] : -1;
+
+    // Decode rows [iStart, iEnd[ of panRows with the provided table.
+    // Called from worker threads.
+    const auto DecodeRows =
+        [this, &asColumns, nValuesPerRow,
+         bReadGeometry](FileGDBTable *poTable,
+                        FileGDBOGRGeometryConverter *poGeomConverter,
+                        const int64_t *panRows, size_t iStart, size_t iEnd,
+                        OGROpenFileGDBArrowChunk &oChunk)
+    {
+        auto &asValues = oChunk.asValues;
+        auto &abyData = oChunk.abyData;
+        const auto AppendData = [&abyData](const void *pData, size_t nLen,
+                                           OGROpenFileGDBArrowValue &sValue)
+        {
+            sValue.nOffset = abyData.size();
+            sValue.nLen = nLen;
+            sValue.bNull = false;
+            abyData.insert(abyData.end(), static_cast<const GByte *>(pData),
+                           static_cast<const GByte *>(pData) + nLen);
+        };
+
+        for (size_t i = iStart; i < iEnd; ++i)
+        {
+            if (!poTable->SelectRow(panRows[i]))
+            {
+                if (poTable->HasGotError())
+                {
+                    oChunk.bError = true;
+                    return;
+                }
+                continue;  // deleted row
+            }
+
+            const size_t nValuesSizeBefore = asValues.size();
+            const size_t nDataSizeBefore = abyData.size();
+            asValues.resize(nValuesSizeBefore + nValuesPerRow);
+            auto pasValues = asValues.data() + nValuesSizeBefore;
+
+            // Read fields in table order, which is the most efficient
+            size_t iCol = 0;
+            bool bSkipRow = false;
+            for (int iGDBIdx = 0; iGDBIdx < poTable->GetFieldCount();
+                 iGDBIdx++)
+            {
+                if (iGDBIdx == m_iGeomFieldIdx)
+                {
+                    if (!bReadGeometry)
+                        continue;
+                    const OGRField *psField = poTable->GetFieldValue(iGDBIdx);
+                    if (psField == nullptr)
+                        continue;
+                    if (m_poFilterGeom != nullptr &&
+                        !poTable->DoesGeometryIntersectsFilterEnvelope(psField))
+                    {
+                        bSkipRow = true;
+                        break;
+                    }
+                    std::unique_ptr<OGRGeometry> poGeom(
+                        OGROpenFileGDBPromoteGeometry(
+                            poGeomConverter->GetAsGeometry(psField)));
+                    if (poGeom)
+                    {
+                        auto &sValue = pasValues[nValuesPerRow - 1];
+                        sValue.nOffset = abyData.size();
+                        sValue.nLen = poGeom->WkbSize();
+                        sValue.bNull = false;
+                        abyData.resize(sValue.nOffset + sValue.nLen);
+                        poGeom->exportToWkb(wkbNDR,
+                                            abyData.data() + sValue.nOffset,
+                                            wkbVariantIso);
+                    }
+                    continue;
+                }
+                if (iCol == asColumns.size() ||
+                    asColumns[iCol].iGDBIdx != iGDBIdx)
+                {
+                    continue;
+                }
+
+                const auto &sColumn = asColumns[iCol];
+                auto &sValue = pasValues[iCol];
+                ++iCol;
+                const OGRField *psField = poTable->GetFieldValue(iGDBIdx);
+                if (psField == nullptr)
+                    continue;
+                if (sColumn.eType == OFTString)
+                {
+                    AppendData(psField->String, strlen(psField->String),
+                               sValue);
+                }
+                else if (sColumn.eType == OFTBinary)
+                {
+                    AppendData(psField->Binary.paData,
+                               static_cast<size_t>(psField->Binary.nCount),
+                               sValue);
+                }
+                else
+                {
+                    sValue.sField = *psField;
+                    sValue.bNull = false;
+                    if (sColumn.eGDBType == FGFT_DATETIME)
+                        sValue.sField.Date.TZFlag = m_bTimeInUTC ? 100 : 0;
+                }
+            }
+
+            if (poTable->HasGotError())
+            {
+                oChunk.bError = true;
+                return;
+            }
+            if (bSkipRow)
+            {
+                asValues.resize(nValuesSizeBefore);
+                abyData.resize(nDataSizeBefore);
+                continue;
+            }
+            oChunk.anCandidateIdx.push_back(i);
+        }
+    };
+
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    int iFeat = 0;
+    bool bStop = false;
+    while (!bStop && iFeat < sHelper.m_nMaxBatchSize)
+    {
+        const size_t nWanted =
+            static_cast<size_t>(sHelper.m_nMaxBatchSize - iFeat);
+        if (m_nArrowCandidateRowsIdx == m_anArrowCandidateRows.size())
+            CollectArrowCandidateRows(nWanted);
+        const size_t nRows = std::min(
+            nWanted, m_anArrowCandidateRows.size() - m_nArrowCandidateRowsIdx);
+        if (nRows == 0)
+            break;
+        const int64_t *panRows =
+            m_anArrowCandidateRows.data() + m_nArrowCandidateRowsIdx;
+
+        /* ---------------------------------------------------------------- */
+        /*      Decode rows, possibly with several threads.                 */
+        /* ---------------------------------------------------------------- */
+        const int nJobs = GetArrowWorkerTableCount(nRows);
+        std::vector<OGROpenFileGDBArrowChunk> aoChunks(nJobs);
+        const OGREnvelope *psFilterEnvelope =
+            m_poFilterGeom ? &m_sFilterEnvelope : nullptr;
+        for (auto &poTable : m_apoArrowWorkerTables)
+            poTable->InstallFilterEnvelope(psFilterEnvelope);
+        if (nJobs == 1)
+        {
+            DecodeRows(m_poLyrTable, m_poGeomConverter.get(), panRows, 0,
+                       nRows, aoChunks[0]);
+        }
+        else
+        {
+            std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+            auto poJobQueue = GDALGetGlobalThreadPool(nJobs)->CreateJobQueue();
+            for (int iJob = 0; iJob < nJobs; ++iJob)
+            {
+                const size_t iStart = nRows * iJob / nJobs;
+                const size_t iEnd = nRows * (iJob + 1) / nJobs;
+                FileGDBTable *poTable =
+                    iJob == 0 ? m_poLyrTable
+                              : m_apoArrowWorkerTables[iJob - 1].get();
+                FileGDBOGRGeometryConverter *poGeomConverter =
+                    iJob == 0 ? m_poGeomConverter.get()
+                              : m_apoArrowWorkerGeomConverters[iJob - 1].get();
+                poJobQueue->SubmitJob(
+                    [&DecodeRows, &aoChunks, &aoErrorAccumulators, poTable,
+                     poGeomConverter, panRows, iJob, iStart, iEnd]()
+                    {
+                        auto oAccumulator =
+                            aoErrorAccumulators[iJob].InstallForCurrentScope();
+                        CPL_IGNORE_RET_VAL(oAccumulator);
+                        DecodeRows(poTable, poGeomConverter, panRows, iStart,
+                                   iEnd, aoChunks[iJob]);
+                    });
+            }
+            poJobQueue->WaitCompletion();
+            for (auto &oAccumulator : aoErrorAccumulators)
+                oAccumulator.ReplayErrors();
+        }
+        for (const auto &oChunk : aoChunks)
+        {
+            if (oChunk.bError)
+            {
+                m_bEOF = TRUE;
+                return ReturnError();
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Copy decoded values into the Arrow buffers, in row order.   */
+        /* ---------------------------------------------------------------- */
+        size_t nConsumedRows = nRows;
+        for (const auto &oChunk : aoChunks)
+        {
+            const GByte *pabyData = oChunk.abyData.data();
+            for (size_t iRow = 0; !bStop && iRow < oChunk.anCandidateIdx.size();
+                 ++iRow)
+            {
+                const auto pasValues =
+                    oChunk.asValues.data() + iRow * nValuesPerRow;
+                const auto &sGeomValue = pasValues[nColumns];
+                if (m_poFilterGeom != nullptr)
+                {
+                    OGREnvelope sEnvelope;
+                    if (sGeomValue.bNull ||
+                        !FilterWKBGeometry(pabyData + sGeomValue.nOffset,
+                                           sGeomValue.nLen,
+                                           /* bEnvelopeAlreadySet = */ false,
+                                           sEnvelope))
+                    {
+                        continue;
+                    }
+                }
+
+                if (iFeat > 0)
+                {
+                    // Check that we do not overflow the maximum size of
+                    // variable-length arrays.
+                    const auto WouldOverflow =
+                        [out_array, iFeat, nMemLimit](int iArrowField,
+                                                      size_t nLen)
+                    {
+                        const auto panOffsets =
+                            static_cast<const int32_t *>(
+                                out_array->children[iArrowField]->buffers[1]);
+                        const uint32_t nCurLength =
+                            static_cast<uint32_t>(panOffsets[iFeat]);
+                        return nLen <= nMemLimit &&
+                               nLen > nMemLimit - nCurLength;
+                    };
+                    bool bOverflow = iGeomArrowField >= 0 &&
+                                     !sGeomValue.bNull &&
+                                     WouldOverflow(iGeomArrowField,
+                                                   sGeomValue.nLen);
+                    for (size_t iCol = 0; !bOverflow && iCol < nColumns;
+                         ++iCol)
+                    {
+                        const auto eType = asColumns[iCol].eType;
+                        bOverflow = (eType == OFTString ||
+                                     eType == OFTBinary) &&
+                                    !pasValues[iCol].bNull &&
+                                    WouldOverflow(asColumns[iCol].iArrowField,
+                                                  pasValues[iCol].nLen);
+                    }
+                    if (bOverflow)
+                    {
+                        CPLDebug("OpenFileGDB",
+                                 "GetNextArrowArray(): premature "
+                                 "notification of %d features to "
+                                 "consumer due to too big array",
+                                 iFeat);
+                        // Resume from that row at next call
+                        nConsumedRows = oChunk.anCandidateIdx[iRow];
+                        bStop = true;
+                        break;
+                    }
+                }
+
+                if (sHelper.m_panFIDValues)
+                {
+                    sHelper.m_panFIDValues[iFeat] =
+                        panRows[oChunk.anCandidateIdx[iRow]] + 1;
+                }
+
+                for (size_t iCol = 0; iCol < nColumns; ++iCol)
+                {
+                    const auto &sColumn = asColumns[iCol];
+                    const auto &sValue = pasValues[iCol];
+                    auto psArray = out_array->children[sColumn.iArrowField];
+                    if (sValue.bNull)
+                    {
+                        if (!sHelper.SetNull(sColumn.iArrowField, iFeat))
+                            return ReturnError();
+                        continue;
+                    }
+                    switch (sColumn.eType)
+                    {
+                        case OFTInteger:
+                        {
+                            if (sColumn.eSubType == OFSTBoolean)
+                            {
+                                if (sValue.sField.Integer)
+                                    sHelper.SetBoolOn(psArray, iFeat);
+                            }
+                            else if (sColumn.eSubType == OFSTInt16)
+                            {
+                                sHelper.SetInt16(psArray, iFeat,
+                                                 static_cast<int16_t>(
+                                                     sValue.sField.Integer));
+                            }
+                            else
+                            {
+                                sHelper.SetInt32(psArray, iFeat,
+                                                 sValue.sField.Integer);
+                            }
+                            break;
+                        }
+
+                        case OFTInteger64:
+                        {
+                            sHelper.SetInt64(psArray, iFeat,
+                                             sValue.sField.Integer64);
+                            break;
+                        }
+
+                        case OFTReal:
+                        {
+                            if (sColumn.eSubType == OFSTFloat32)
+                            {
+                                sHelper.SetFloat(
+                                    psArray, iFeat,
+                                    static_cast<float>(sValue.sField.Real));
+                            }
+                            else
+                            {
+                                sHelper.SetDouble(psArray, iFeat,
+                                                  sValue.sField.Real);
+                            }
+                            break;
+                        }
+
+                        case OFTString:
+                        case OFTBinary:
+                        {
+                            GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                                sColumn.iArrowField, iFeat, sValue.nLen);
+                            if (outPtr == nullptr)
+                                return ReturnError();
+                            if (sValue.nLen)
+                                memcpy(outPtr, pabyData + sValue.nOffset,
+                                       sValue.nLen);
+                            break;
+                        }
+
+                        case OFTDate:
+                        {
+                            sHelper.SetDate(psArray, iFeat, brokenDown,
+                                            sValue.sField);
+                            break;
+                        }
+
+                        case OFTDateTime:
+                        {
+                            sHelper.SetDateTime(
+                                psArray, iFeat, brokenDown,
+                                sHelper.m_anTZFlags[sColumn.iOGRIdx],
+                                sValue.sField);
+                            break;
+                        }
+
+                        default:
+                            break;
+                    }
+                }
+
+                if (iGeomArrowField >= 0)
+                {
+                    if (sGeomValue.bNull)
+                    {
+                        if (!sHelper.SetNull(iGeomArrowField, iFeat))
+                            return ReturnError();
+                    }
+                    else
+                    {
+                        GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                            iGeomArrowField, iFeat, sGeomValue.nLen);
+                        if (outPtr == nullptr)
+                            return ReturnError();
+                        memcpy(outPtr, pabyData + sGeomValue.nOffset,
+                               sGeomValue.nLen);
+                    }
+                }
+
+                ++iFeat;
+            }
+        }
+        m_nArrowCandidateRowsIdx += nConsumedRows;
+    }
+
+    sHelper.Shrink(iFeat);
+    if (iFeat == 0)
+    {
+        out_array->release(out_array);
+        memset(out_array, 0, sizeof(*out_array));
+    }
+    return 0;
+}
+
+/***********************************************************************/
+/*                          GetMetadataItem()                          */
+/***********************************************************************/
+
+const char *OGROpenFileGDBLayer::GetMetadataItem(const char *pszName,
+                                                 const char *pszDomain)
+{
+    if (pszName && pszDomain && EQUAL(pszDomain, "__DEBUG__") &&
+        EQUAL(pszName, "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH"))
+    {
+        return m_bLastGetNextArrowArrayUsedOptimizedCodePath ? "YES" : "NO";
+    }
+    return OGRLayer::GetMetadataItem(pszName, pszDomain);
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
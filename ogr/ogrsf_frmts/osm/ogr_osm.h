@@ -18,6 +18,7 @@
 
 #include "ogrsf_frmts.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 
 #include <array>
 #include <set>
@@ -354,6 +355,30 @@ struct WayFeaturePair
     std::unique_ptr<OGRFeature> poFeature{};
     bool bIsArea = false;
     bool bAttrFilterAlreadyEvaluated = false;
+
+    /* Set by OGROSMDataSource::ResolveWay() */
+    int nResolvedNodes = 0;
+    std::vector<GByte> abyCompressedWay{};
+    /* Debug message, emitted from the reading thread */
+    std::string osDebugMsg{};
+};
+
+/* Multipolygon relation whose geometry is waiting to be assembled by
+   OGROSMDataSource::ProcessRelationsBatch() */
+struct OGROSMPendingRelation
+{
+    GIntBig nID = 0;
+    std::unique_ptr<OGRFeature> poFeature{};
+    bool bAttrFilterAlreadyEvaluated = false;
+
+    /* Polygons from closed ways */
+    std::vector<std::unique_ptr<OGRGeometry>> apoPolygons{};
+    /* Open ways, to be merged into rings */
+    OGRMultiLineString oMLS{};
+    /* Assembled multipolygon, or null if it could not be built */
+    std::unique_ptr<OGRGeometry> poGeom{};
+    /* Debug message, emitted from the reading thread */
+    std::string osDebugMsg{};
 };
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
@@ -476,6 +501,11 @@ class OGROSMDataSource final : public GDALDataset
     int nNonRedundantValuesLen = 0;
     std::vector<WayFeaturePair> m_asWayFeaturePairs{};
 
+    std::vector<std::unique_ptr<OGROSMPendingRelation>> m_apoPendingRelations{};
+    GIntBig m_nPendingRelationPoints = 0;
+
+    int m_nNumThreads = 1;
+
     std::vector<KeyDesc *> m_apsKeys{};
     std::map<const char *, KeyDesc *, OGROSMConstCharComp>
         m_aoMapIndexedKeys{}; /* map that is the reverse of asKeys */
@@ -493,6 +523,43 @@ class OGROSMDataSource final : public GDALDataset
     std::map<int, Bucket> m_oMapBuckets{};
     Bucket *GetBucket(int nBucketId);
 
+    // Dense node index: the coordinates of the node of id N are at offset
+    // N * sizeof(LonLat) of a sparse temporary file, which is memory mapped
+    // for lookups.
+    bool m_bDenseNodeIndex = false;
+    CPLString m_osDenseNodesFilename{};
+    bool m_bMustUnlinkDenseNodesFile = true;
+    VSILFILE *m_fpDenseNodes = nullptr;
+    vsi_l_offset m_nDenseNodesFileSize = 0;
+    // Nodes of ids [m_nDenseNodesBufferFirstId, m_nDenseNodesBufferLastId]
+    // not yet written in m_fpDenseNodes
+    std::vector<LonLat> m_asDenseNodesBuffer{};
+    GIntBig m_nDenseNodesBufferFirstId = -1;
+    GIntBig m_nDenseNodesBufferLastId = -1;
+    CPLVirtualMem *m_psDenseNodesMapping = nullptr;
+    const LonLat *m_pasDenseNodes = nullptr;
+    GIntBig m_nDenseNodesMapped = 0;
+
+    // The longitude is stored with its sign bit flipped, so that the holes
+    // of the file, which read as zeroes, decode to an invalid longitude and
+    // cannot be confused with a node at (0,0).
+    static int FlipDenseLonSign(int nLon)
+    {
+        return static_cast<int>(static_cast<unsigned>(nLon) ^ 0x80000000U);
+    }
+
+    bool GetDenseNode(GIntBig nID, LonLat &sLonLat) const
+    {
+        if (nID < 0 || nID >= m_nDenseNodesMapped)
+            return false;
+        const LonLat &sStored = m_pasDenseNodes[nID];
+        if (sStored.nLon == 0)
+            return false;
+        sLonLat.nLon = FlipDenseLonSign(sStored.nLon);
+        sLonLat.nLat = sStored.nLat;
+        return true;
+    }
+
     bool m_bNeedsToSaveWayInfo = false;
 
     static const GIntBig FILESIZE_NOT_INIT = -2;
@@ -502,10 +569,11 @@ class OGROSMDataSource final : public GDALDataset
     void CompressWay(bool bIsArea, unsigned int nTags,
                      const IndexedKVP *pasTags, int nPoints,
                      const LonLat *pasLonLatPairs, const OSMInfo *psInfo,
-                     std::vector<GByte> &abyCompressedWay);
+                     std::vector<GByte> &abyCompressedWay) const;
     void UncompressWay(int nBytes, const GByte *pabyCompressedWay,
                        bool *pbIsArea, std::vector<LonLat> &asCoords,
-                       unsigned int *pnTags, OSMTag *pasTags, OSMInfo *psInfo);
+                       unsigned int *pnTags, OSMTag *pasTags,
+                       OSMInfo *psInfo) const;
 
     bool ParseConf(CSLConstList papszOpenOptions);
     bool CreateTempDB();
@@ -520,16 +588,22 @@ class OGROSMDataSource final : public GDALDataset
     bool FlushCurrentSectorCompressedCase();
     bool FlushCurrentSectorNonCompressedCase();
     bool IndexPointCustom(const OSMNode *psNode);
+    bool InitDenseNodeIndex();
+    bool IndexPointDense(const OSMNode *psNode);
+    bool FlushDenseNodesBuffer();
+    bool MapDenseNodeIndex();
 
-    void IndexWay(GIntBig nWayID, bool bIsArea, unsigned int nTags,
-                  const IndexedKVP *pasTags, const LonLat *pasLonLatPairs,
-                  int nPairs, const OSMInfo *psInfo);
+    void IndexWay(GIntBig nWayID, const std::vector<GByte> &abyCompressedWay);
 
     bool StartTransactionCacheDB();
     bool CommitTransactionCacheDB();
 
-    int FindNode(GIntBig nID);
+    int FindNode(GIntBig nID) const;
+    void ResolveWay(WayFeaturePair &sWayFeaturePairs,
+                    std::vector<LonLat> &asLonLatCache,
+                    bool bMultiPolygonsInterested) const;
     void ProcessWaysBatch();
+    void ProcessRelationsBatch();
 
     void ProcessPolygonsStandalone();
 
@@ -538,13 +612,16 @@ class OGROSMDataSource final : public GDALDataset
     void LookupNodesCustom();
     void LookupNodesCustomCompressedCase();
     void LookupNodesCustomNonCompressedCase();
+    void LookupNodesDense();
 
     unsigned int
     LookupWays(std::map<GIntBig, std::pair<int, void *>> &aoMapWays,
                const OSMRelation *psRelation);
 
-    OGRGeometry *BuildMultiPolygon(const OSMRelation *psRelation,
-                                   unsigned int *pnTags, OSMTag *pasTags);
+    bool CollectMultiPolygonParts(const OSMRelation *psRelation,
+                                  unsigned int *pnTags, OSMTag *pasTags,
+                                  OGROSMPendingRelation &oPending);
+    static void AssembleMultiPolygon(OGROSMPendingRelation &oPending);
     OGRGeometry *BuildGeometryCollection(const OSMRelation *psRelation,
                                          bool bMultiLineString);
 
@@ -34,12 +34,16 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_port.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -81,6 +85,15 @@ constexpr unsigned int MAX_COUNT_FOR_TAGS_IN_WAY = 255;  // Must fit on 1 byte.
 
 constexpr int NODE_PER_BUCKET = 65536;
 
+// Number of consecutive node ids buffered before being written in the dense
+// node index
+constexpr int DENSE_NODES_BUFFER_SIZE = 65536;
+// Max node id of the dense node index (8 TB sparse file)
+constexpr GIntBig MAX_DENSE_NODE_ID = static_cast<GIntBig>(1) << 40;
+// Min size of the input file for the dense node index to be used by default
+constexpr GIntBig DENSE_NODE_INDEX_MIN_FILE_SIZE =
+    static_cast<GIntBig>(10) * 1024 * 1024 * 1024;
+
 static bool VALID_ID_FOR_CUSTOM_INDEXING(GIntBig _id)
 {
     return _id >= 0 && _id / NODE_PER_BUCKET < INT_MAX;
@@ -137,6 +150,14 @@ constexpr int MAX_NON_REDUNDANT_VALUES = MAX_DELAYED_FEATURES * 10;
 constexpr int MAX_NON_REDUNDANT_KEYS = MAX_DELAYED_FEATURES * 10;
 // Max number of features that are accumulated in panUnsortedReqIds
 constexpr int MAX_ACCUMULATED_NODES = 1000000;
+// Min number of ways in a batch for their geometries to be built by
+// several threads
+constexpr size_t MIN_WAYS_FOR_MULTITHREADING = 1000;
+// Max number of multipolygon relations whose geometry building is delayed,
+// to be done by several threads
+constexpr size_t MAX_PENDING_RELATIONS = 1000;
+// Max number of points in the member ways of the delayed relations
+constexpr GIntBig MAX_PENDING_RELATION_POINTS = 10 * 1000 * 1000;
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
 // Size of panHashedIndexes array. Must be in the list at
@@ -302,6 +323,17 @@ OGROSMDataSource::~OGROSMDataSource()
             VSIUnlink(m_osNodesFilename);
     }
 
+    if (m_psDenseNodesMapping)
+        CPLVirtualMemFree(m_psDenseNodesMapping);
+    if (m_fpDenseNodes)
+        VSIFCloseL(m_fpDenseNodes);
+    if (!m_osDenseNodesFilename.empty() && m_bMustUnlinkDenseNodesFile)
+    {
+        const char *pszVal = CPLGetConfigOption("OSM_UNLINK_TMPFILE", "YES");
+        if (!EQUAL(pszVal, "NOT_EVEN_AT_END"))
+            VSIUnlink(m_osDenseNodesFilename);
+    }
+
     CPLFree(m_pabySector);
     for (auto &oIter : m_oMapBuckets)
     {
@@ -398,6 +430,9 @@ bool OGROSMDataSource::IndexPoint(const OSMNode *psNode)
     if (!m_bIndexPoints)
         return true;
 
+    if (m_bDenseNodeIndex)
+        return IndexPointDense(psNode);
+
     if (m_bCustomIndexing)
         return IndexPointCustom(psNode);
 
@@ -701,6 +736,171 @@ bool OGROSMDataSource::IndexPointCustom(const OSMNode *psNode)
     return true;
 }
 
+/************************************************************************/
+/*                         InitDenseNodeIndex()                         */
+/************************************************************************/
+
+bool OGROSMDataSource::InitDenseNodeIndex()
+{
+    // The file must be a real file to be memory mapped
+    m_osDenseNodesFilename = CPLGenerateTempFilenameSafe("osm_tmp_dense_nodes");
+    m_fpDenseNodes = VSIFOpenL(m_osDenseNodesFilename, "wb+");
+    if (m_fpDenseNodes == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 m_osDenseNodesFilename.c_str());
+        return false;
+    }
+
+    /* On Unix filesystems, you can remove a file even if it */
+    /* opened */
+    const char *pszVal = CPLGetConfigOption("OSM_UNLINK_TMPFILE", "YES");
+    if (EQUAL(pszVal, "YES"))
+    {
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        m_bMustUnlinkDenseNodesFile = VSIUnlink(m_osDenseNodesFilename) != 0;
+        CPLPopErrorHandler();
+    }
+
+    try
+    {
+        m_asDenseNodesBuffer.resize(DENSE_NODES_BUFFER_SIZE);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate dense node index buffer");
+        return false;
+    }
+
+    CPLDebug("OSM", "Using dense node index in %s",
+             m_osDenseNodesFilename.c_str());
+    return true;
+}
+
+/************************************************************************/
+/*                          IndexPointDense()                           */
+/************************************************************************/
+
+bool OGROSMDataSource::IndexPointDense(const OSMNode *psNode)
+{
+    if (psNode->nID <= m_nPrevNodeId)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Non increasing node id. Use OSM_USE_CUSTOM_INDEXING=NO");
+        m_bStopParsing = true;
+        return false;
+    }
+    if (psNode->nID < 0 || psNode->nID > MAX_DENSE_NODE_ID)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unsupported node id value (" CPL_FRMT_GIB
+                 "). Use OSM_DENSE_NODE_INDEX=NO",
+                 psNode->nID);
+        m_bStopParsing = true;
+        return false;
+    }
+
+    if (m_nDenseNodesBufferFirstId < 0 ||
+        psNode->nID - m_nDenseNodesBufferFirstId >= DENSE_NODES_BUFFER_SIZE)
+    {
+        if (!FlushDenseNodesBuffer())
+        {
+            m_bStopParsing = true;
+            return false;
+        }
+        m_nDenseNodesBufferFirstId = psNode->nID;
+    }
+
+    LonLat &sLonLat = m_asDenseNodesBuffer[static_cast<size_t>(
+        psNode->nID - m_nDenseNodesBufferFirstId)];
+    sLonLat.nLon = FlipDenseLonSign(DBL_TO_INT(psNode->dfLon));
+    sLonLat.nLat = DBL_TO_INT(psNode->dfLat);
+    m_nDenseNodesBufferLastId = psNode->nID;
+
+    m_nPrevNodeId = psNode->nID;
+
+    return true;
+}
+
+/************************************************************************/
+/*                       FlushDenseNodesBuffer()                        */
+/************************************************************************/
+
+bool OGROSMDataSource::FlushDenseNodesBuffer()
+{
+    if (m_nDenseNodesBufferFirstId < 0)
+        return true;
+
+    // Skipped node ids are left as holes in the file, that read as zeroes.
+    const size_t nCount = static_cast<size_t>(m_nDenseNodesBufferLastId -
+                                              m_nDenseNodesBufferFirstId + 1);
+    const vsi_l_offset nOffset =
+        static_cast<vsi_l_offset>(m_nDenseNodesBufferFirstId) * sizeof(LonLat);
+    if (VSIFSeekL(m_fpDenseNodes, nOffset, SEEK_SET) != 0 ||
+        VSIFWriteL(m_asDenseNodesBuffer.data(), sizeof(LonLat), nCount,
+                   m_fpDenseNodes) != nCount)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write in %s",
+                 m_osDenseNodesFilename.c_str());
+        return false;
+    }
+    m_nDenseNodesFileSize = std::max(m_nDenseNodesFileSize,
+                                     nOffset + nCount * sizeof(LonLat));
+
+    memset(m_asDenseNodesBuffer.data(), 0, nCount * sizeof(LonLat));
+    m_nDenseNodesBufferFirstId = -1;
+    m_nDenseNodesBufferLastId = -1;
+
+    return true;
+}
+
+/************************************************************************/
+/*                         MapDenseNodeIndex()                          */
+/************************************************************************/
+
+bool OGROSMDataSource::MapDenseNodeIndex()
+{
+    if (!FlushDenseNodesBuffer())
+        return false;
+
+    const GIntBig nNodes =
+        static_cast<GIntBig>(m_nDenseNodesFileSize / sizeof(LonLat));
+    if (nNodes == m_nDenseNodesMapped)
+        return true;
+
+    // The file has grown since it was mapped, which only happens with
+    // files where nodes are interleaved with ways.
+    if (m_psDenseNodesMapping)
+        CPLVirtualMemFree(m_psDenseNodesMapping);
+    m_psDenseNodesMapping = nullptr;
+    m_pasDenseNodes = nullptr;
+    m_nDenseNodesMapped = 0;
+
+    if (VSIFFlushL(m_fpDenseNodes) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write in %s",
+                 m_osDenseNodesFilename.c_str());
+        return false;
+    }
+
+    m_psDenseNodesMapping =
+        CPLVirtualMemFileMapNew(m_fpDenseNodes, 0, m_nDenseNodesFileSize,
+                                VIRTUALMEM_READONLY, nullptr, nullptr);
+    if (m_psDenseNodesMapping == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot memory map %s. Use OSM_DENSE_NODE_INDEX=NO",
+                 m_osDenseNodesFilename.c_str());
+        return false;
+    }
+    m_pasDenseNodes = static_cast<const LonLat *>(
+        CPLVirtualMemGetAddr(m_psDenseNodesMapping));
+    m_nDenseNodesMapped = nNodes;
+
+    return true;
+}
+
 /************************************************************************/
 /*                             NotifyNodes()                            */
 /************************************************************************/
@@ -782,7 +982,9 @@ static void OGROSMNotifyNodes(unsigned int nNodes, OSMNode *pasNodes,
 
 void OGROSMDataSource::LookupNodes()
 {
-    if (m_bCustomIndexing)
+    if (m_bDenseNodeIndex)
+        LookupNodesDense();
+    else if (m_bCustomIndexing)
         LookupNodesCustom();
     else
         LookupNodesSQLite();
@@ -1277,6 +1479,43 @@ void OGROSMDataSource::LookupNodesCustomNonCompressedCase()
     m_nReqIds = j;
 }
 
+/************************************************************************/
+/*                          LookupNodesDense()                          */
+/************************************************************************/
+
+void OGROSMDataSource::LookupNodesDense()
+{
+    m_nReqIds = 0;
+
+    if (!MapDenseNodeIndex())
+    {
+        m_bStopParsing = true;
+        return;
+    }
+
+    CPLAssert(m_nUnsortedReqIds <=
+              static_cast<unsigned int>(MAX_ACCUMULATED_NODES));
+
+    for (unsigned int i = 0; i < m_nUnsortedReqIds; i++)
+    {
+        m_panReqIds[m_nReqIds++] = m_panUnsortedReqIds[i];
+    }
+
+    std::sort(m_panReqIds, m_panReqIds + m_nReqIds);
+
+    /* Remove duplicates and missing nodes */
+    unsigned int j = 0;  // Used after for.
+    for (unsigned int i = 0; i < m_nReqIds; i++)
+    {
+        if (!(i > 0 && m_panReqIds[i] == m_panReqIds[i - 1]) &&
+            GetDenseNode(m_panReqIds[i], m_pasLonLatArray[j]))
+        {
+            m_panReqIds[j++] = m_panReqIds[i];
+        }
+    }
+    m_nReqIds = j;
+}
+
 /************************************************************************/
 /*                            WriteVarInt()                             */
 /************************************************************************/
@@ -1368,7 +1607,7 @@ void OGROSMDataSource::CompressWay(bool bIsArea, unsigned int nTags,
                                    const IndexedKVP *pasTags, int nPoints,
                                    const LonLat *pasLonLatPairs,
                                    const OSMInfo *psInfo,
-                                   std::vector<GByte> &abyCompressedWay)
+                                   std::vector<GByte> &abyCompressedWay) const
 {
     abyCompressedWay.clear();
     abyCompressedWay.push_back((bIsArea) ? 1 : 0);
@@ -1453,7 +1692,7 @@ void OGROSMDataSource::UncompressWay(int nBytes, const GByte *pabyCompressedWay,
                                      bool *pbIsArea,
                                      std::vector<LonLat> &asCoords,
                                      unsigned int *pnTags, OSMTag *pasTags,
-                                     OSMInfo *psInfo)
+                                     OSMInfo *psInfo) const
 {
     asCoords.clear();
     const GByte *pabyPtr = pabyCompressedWay;
@@ -1542,28 +1781,16 @@ void OGROSMDataSource::UncompressWay(int nBytes, const GByte *pabyCompressedWay,
 /*                              IndexWay()                              */
 /************************************************************************/
 
-void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
-                                unsigned int nTags, const IndexedKVP *pasTags,
-                                const LonLat *pasLonLatPairs, int nPairs,
-                                const OSMInfo *psInfo)
+void OGROSMDataSource::IndexWay(GIntBig nWayID,
+                                const std::vector<GByte> &abyCompressedWay)
 {
     if (!m_bIndexWays)
         return;
 
     sqlite3_bind_int64(m_hInsertWayStmt, 1, nWayID);
-
-    const unsigned nTagsClamped = std::min(nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
-    if (nTagsClamped < nTags)
-    {
-        CPLDebug("OSM",
-                 "Too many tags for way " CPL_FRMT_GIB ": %u. "
-                 "Clamping to %u",
-                 nWayID, nTags, nTagsClamped);
-    }
-    CompressWay(bIsArea, nTagsClamped, pasTags, nPairs, pasLonLatPairs, psInfo,
-                m_abyWayBuffer);
-    sqlite3_bind_blob(m_hInsertWayStmt, 2, m_abyWayBuffer.data(),
-                      static_cast<int>(m_abyWayBuffer.size()), SQLITE_STATIC);
+    sqlite3_bind_blob(m_hInsertWayStmt, 2, abyCompressedWay.data(),
+                      static_cast<int>(abyCompressedWay.size()),
+                      SQLITE_STATIC);
 
     int rc = sqlite3_step(m_hInsertWayStmt);
     sqlite3_reset(m_hInsertWayStmt);
@@ -1579,7 +1806,7 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
 /*                              FindNode()                              */
 /************************************************************************/
 
-int OGROSMDataSource::FindNode(GIntBig nID)
+int OGROSMDataSource::FindNode(GIntBig nID) const
 {
     if (m_nReqIds == 0)
         return -1;
@@ -1599,136 +1826,242 @@ int OGROSMDataSource::FindNode(GIntBig nID)
 }
 
 /************************************************************************/
-/*                         ProcessWaysBatch()                           */
+/*                             ResolveWay()                             */
 /************************************************************************/
 
-void OGROSMDataSource::ProcessWaysBatch()
+// Resolve the node references of a way from the result of LookupNodes(),
+// and build its compressed form and its geometry.
+// Only reads the node lookup arrays, so that it can be called concurrently
+// on different ways of the batch.
+void OGROSMDataSource::ResolveWay(WayFeaturePair &sWayFeaturePairs,
+                                  std::vector<LonLat> &asLonLatCache,
+                                  bool bMultiPolygonsInterested) const
 {
-    if (m_asWayFeaturePairs.empty())
-        return;
-
-    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, int(m_asWayFeaturePairs.size()));
-    LookupNodes();
+    const bool bIsArea = sWayFeaturePairs.bIsArea;
+    asLonLatCache.clear();
 
-    for (WayFeaturePair &sWayFeaturePairs : m_asWayFeaturePairs)
+    if (m_bDenseNodeIndex)
     {
-        const bool bIsArea = sWayFeaturePairs.bIsArea;
-        m_asLonLatCache.clear();
-
+        LonLat sLonLat;
+        for (unsigned int i = 0; i < sWayFeaturePairs.nRefs; i++)
+        {
+            if (GetDenseNode(sWayFeaturePairs.panNodeRefs[i], sLonLat))
+                asLonLatCache.push_back(sLonLat);
+        }
+    }
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
-        if (m_bHashedIndexValid)
+    else if (m_bHashedIndexValid)
+    {
+        for (unsigned int i = 0; i < sWayFeaturePairs.nRefs; i++)
         {
-            for (unsigned int i = 0; i < sWayFeaturePairs.nRefs; i++)
+            int nIndInHashArray = static_cast<int>(
+                HASH_ID_FUNC(sWayFeaturePairs.panNodeRefs[i]) %
+                HASHED_INDEXES_ARRAY_SIZE);
+            int nIdx = m_panHashedIndexes[nIndInHashArray];
+            if (nIdx < -1)
             {
-                int nIndInHashArray = static_cast<int>(
-                    HASH_ID_FUNC(sWayFeaturePairs.panNodeRefs[i]) %
-                    HASHED_INDEXES_ARRAY_SIZE);
-                int nIdx = m_panHashedIndexes[nIndInHashArray];
-                if (nIdx < -1)
+                int iBucket = -nIdx - 2;
+                while (true)
                 {
-                    int iBucket = -nIdx - 2;
-                    while (true)
+                    nIdx = m_psCollisionBuckets[iBucket].nInd;
+                    if (m_panReqIds[nIdx] == sWayFeaturePairs.panNodeRefs[i])
+                        break;
+                    iBucket = m_psCollisionBuckets[iBucket].nNext;
+                    if (iBucket < 0)
                     {
-                        nIdx = m_psCollisionBuckets[iBucket].nInd;
-                        if (m_panReqIds[nIdx] ==
-                            sWayFeaturePairs.panNodeRefs[i])
-                            break;
-                        iBucket = m_psCollisionBuckets[iBucket].nNext;
-                        if (iBucket < 0)
-                        {
-                            nIdx = -1;
-                            break;
-                        }
+                        nIdx = -1;
+                        break;
                     }
                 }
-                else if (nIdx >= 0 &&
-                         m_panReqIds[nIdx] != sWayFeaturePairs.panNodeRefs[i])
-                    nIdx = -1;
+            }
+            else if (nIdx >= 0 &&
+                     m_panReqIds[nIdx] != sWayFeaturePairs.panNodeRefs[i])
+                nIdx = -1;
 
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+            if (nIdx >= 0)
+            {
+                asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
             }
         }
-        else
+    }
+    else
 #endif  // ENABLE_NODE_LOOKUP_BY_HASHING
+    {
+        int nIdx = -1;
+        for (unsigned int i = 0; i < sWayFeaturePairs.nRefs; i++)
         {
-            int nIdx = -1;
-            for (unsigned int i = 0; i < sWayFeaturePairs.nRefs; i++)
+            if (nIdx >= 0 && sWayFeaturePairs.panNodeRefs[i] ==
+                                 sWayFeaturePairs.panNodeRefs[i - 1] + 1)
             {
-                if (nIdx >= 0 && sWayFeaturePairs.panNodeRefs[i] ==
-                                     sWayFeaturePairs.panNodeRefs[i - 1] + 1)
-                {
-                    if (static_cast<unsigned>(nIdx + 1) < m_nReqIds &&
-                        m_panReqIds[nIdx + 1] ==
-                            sWayFeaturePairs.panNodeRefs[i])
-                        nIdx++;
-                    else
-                        nIdx = -1;
-                }
+                if (static_cast<unsigned>(nIdx + 1) < m_nReqIds &&
+                    m_panReqIds[nIdx + 1] == sWayFeaturePairs.panNodeRefs[i])
+                    nIdx++;
                 else
-                    nIdx = FindNode(sWayFeaturePairs.panNodeRefs[i]);
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+                    nIdx = -1;
             }
+            else
+                nIdx = FindNode(sWayFeaturePairs.panNodeRefs[i]);
+            if (nIdx >= 0)
+            {
+                asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
+            }
+        }
+    }
+
+    if (!asLonLatCache.empty() && bIsArea)
+    {
+        asLonLatCache.push_back(asLonLatCache[0]);
+    }
+
+    sWayFeaturePairs.nResolvedNodes = static_cast<int>(asLonLatCache.size());
+    if (asLonLatCache.size() < 2)
+        return;
+
+    if (m_bIndexWays)
+    {
+        if (bIsArea && bMultiPolygonsInterested)
+        {
+            const unsigned nTags = sWayFeaturePairs.nTags;
+            const unsigned nTagsClamped =
+                std::min(nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
+            if (nTagsClamped < nTags)
+            {
+                sWayFeaturePairs.osDebugMsg =
+                    CPLSPrintf("Too many tags for way " CPL_FRMT_GIB ": %u. "
+                               "Clamping to %u",
+                               sWayFeaturePairs.nWayID, nTags, nTagsClamped);
+            }
+            CompressWay(/* bIsArea = */ true, nTagsClamped,
+                        sWayFeaturePairs.pasTags,
+                        static_cast<int>(asLonLatCache.size()),
+                        asLonLatCache.data(), &sWayFeaturePairs.sInfo,
+                        sWayFeaturePairs.abyCompressedWay);
+        }
+        else
+        {
+            CompressWay(bIsArea, 0, nullptr,
+                        static_cast<int>(asLonLatCache.size()),
+                        asLonLatCache.data(), nullptr,
+                        sWayFeaturePairs.abyCompressedWay);
         }
+    }
+
+    if (sWayFeaturePairs.poFeature == nullptr)
+        return;
 
-        if (!m_asLonLatCache.empty() && bIsArea)
+    OGRLineString *poLS = new OGRLineString();
+    const int nPoints = static_cast<int>(asLonLatCache.size());
+    poLS->setNumPoints(nPoints, /*bZeroizeNewContent=*/false);
+    for (int i = 0; i < nPoints; i++)
+    {
+        poLS->setPoint(i, INT_TO_DBL(asLonLatCache[i].nLon),
+                       INT_TO_DBL(asLonLatCache[i].nLat));
+    }
+
+    sWayFeaturePairs.poFeature->SetGeometryDirectly(poLS);
+}
+
+/************************************************************************/
+/*                         ProcessWaysBatch()                           */
+/************************************************************************/
+
+void OGROSMDataSource::ProcessWaysBatch()
+{
+    if (m_asWayFeaturePairs.empty())
+        return;
+
+    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, int(m_asWayFeaturePairs.size()));
+    if (m_bDenseNodeIndex)
+    {
+        // Ways are directly resolved from the memory mapped node index
+        if (!MapDenseNodeIndex())
+            m_bStopParsing = true;
+    }
+    else
+    {
+        LookupNodes();
+    }
+
+    // The node lookup arrays are now read-only until the end of the batch,
+    // so ways can be resolved and their geometries built concurrently.
+    const bool bMultiPolygonsInterested =
+        m_apoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested();
+    const size_t nWays = m_asWayFeaturePairs.size();
+    auto poThreadPool =
+        m_nNumThreads > 1 && nWays >= MIN_WAYS_FOR_MULTITHREADING
+            ? GDALGetGlobalThreadPool(m_nNumThreads)
+            : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poJobQueue)
+    {
+        const size_t nJobs =
+            std::min(nWays, static_cast<size_t>(m_nNumThreads) * 4);
+        // Debug messages are not accumulated, but stored in the items and
+        // emitted below in item order
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+        for (size_t iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const size_t iStart = iJob * nWays / nJobs;
+            const size_t iEnd = (iJob + 1) * nWays / nJobs;
+            auto &oErrorAccumulator = aoErrorAccumulators[iJob];
+            poJobQueue->SubmitJob(
+                [this, iStart, iEnd, bMultiPolygonsInterested,
+                 &oErrorAccumulator]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    std::vector<LonLat> asLonLatCache;
+                    for (size_t i = iStart; i < iEnd; ++i)
+                    {
+                        ResolveWay(m_asWayFeaturePairs[i], asLonLatCache,
+                                   bMultiPolygonsInterested);
+                    }
+                });
+        }
+        poJobQueue->WaitCompletion();
+        for (auto &oErrorAccumulator : aoErrorAccumulators)
+            oErrorAccumulator.ReplayErrors();
+    }
+    else
+    {
+        for (WayFeaturePair &sWayFeaturePairs : m_asWayFeaturePairs)
         {
-            m_asLonLatCache.push_back(m_asLonLatCache[0]);
+            ResolveWay(sWayFeaturePairs, m_asLonLatCache,
+                       bMultiPolygonsInterested);
         }
+    }
 
-        if (m_asLonLatCache.size() < 2)
+    for (WayFeaturePair &sWayFeaturePairs : m_asWayFeaturePairs)
+    {
+        if (!sWayFeaturePairs.osDebugMsg.empty())
+            CPLDebug("OSM", "%s", sWayFeaturePairs.osDebugMsg.c_str());
+
+        if (sWayFeaturePairs.nResolvedNodes < 2)
         {
             CPLDebug("OSM",
                      "Way " CPL_FRMT_GIB
                      " with %d nodes that could be found. Discarding it",
-                     sWayFeaturePairs.nWayID,
-                     static_cast<int>(m_asLonLatCache.size()));
+                     sWayFeaturePairs.nWayID, sWayFeaturePairs.nResolvedNodes);
             sWayFeaturePairs.poFeature.reset();
             sWayFeaturePairs.bIsArea = false;
             continue;
         }
 
-        if (bIsArea && m_apoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested())
-        {
-            IndexWay(sWayFeaturePairs.nWayID, /*bIsArea = */ true,
-                     sWayFeaturePairs.nTags, sWayFeaturePairs.pasTags,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()),
-                     &sWayFeaturePairs.sInfo);
-        }
-        else
-            IndexWay(sWayFeaturePairs.nWayID, bIsArea, 0, nullptr,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()), nullptr);
+        IndexWay(sWayFeaturePairs.nWayID, sWayFeaturePairs.abyCompressedWay);
 
         if (sWayFeaturePairs.poFeature == nullptr)
         {
             continue;
         }
 
-        OGRLineString *poLS = new OGRLineString();
-        OGRGeometry *poGeom = poLS;
-
-        const int nPoints = static_cast<int>(m_asLonLatCache.size());
-        poLS->setNumPoints(nPoints, /*bZeroizeNewContent=*/false);
-        for (int i = 0; i < nPoints; i++)
-        {
-            poLS->setPoint(i, INT_TO_DBL(m_asLonLatCache[i].nLon),
-                           INT_TO_DBL(m_asLonLatCache[i].nLat));
-        }
-
-        sWayFeaturePairs.poFeature->SetGeometryDirectly(poGeom);
-
-        if (m_asLonLatCache.size() != sWayFeaturePairs.nRefs)
+        if (static_cast<unsigned>(sWayFeaturePairs.nResolvedNodes) !=
+            sWayFeaturePairs.nRefs)
             CPLDebug("OSM",
                      "For way " CPL_FRMT_GIB
                      ", got only %d nodes instead of %d",
-                     sWayFeaturePairs.nWayID, nPoints, sWayFeaturePairs.nRefs);
+                     sWayFeaturePairs.nWayID, sWayFeaturePairs.nResolvedNodes,
+                     sWayFeaturePairs.nRefs);
 
         bool bFilteredOut = false;
         if (!m_apoLayers[IDX_LYR_LINES]->AddFeature(
@@ -2204,12 +2537,14 @@ unsigned int OGROSMDataSource::LookupWays(
 }
 
 /************************************************************************/
-/*                          BuildMultiPolygon()                         */
+/*                      CollectMultiPolygonParts()                      */
 /************************************************************************/
 
-OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
-                                                 unsigned int *pnTags,
-                                                 OSMTag *pasTags)
+// Fetch the member ways of a multipolygon relation from the ways index.
+// The geometry itself is assembled later by AssembleMultiPolygon().
+bool OGROSMDataSource::CollectMultiPolygonParts(
+    const OSMRelation *psRelation, unsigned int *pnTags, OSMTag *pasTags,
+    OGROSMPendingRelation &oPending)
 {
     std::map<GIntBig, std::pair<int, void *>> aoMapWays;
     LookupWays(aoMapWays, psRelation);
@@ -2240,13 +2575,9 @@ OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
         for (auto &oIter : aoMapWays)
             CPLFree(oIter.second.second);
 
-        return nullptr;
+        return false;
     }
 
-    OGRMultiLineString oMLS;
-    std::vector<OGRGeometry *> apoPolygons(psRelation->nMembers);
-    int nPolys = 0;
-
     if (pnTags != nullptr)
         *pnTags = 0;
 
@@ -2284,10 +2615,10 @@ OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
                 m_asLonLatCache.front().nLon == m_asLonLatCache.back().nLon &&
                 m_asLonLatCache.front().nLat == m_asLonLatCache.back().nLat)
             {
-                OGRPolygon *poPoly = new OGRPolygon();
+                auto poPoly = std::make_unique<OGRPolygon>();
                 OGRLinearRing *poRing = new OGRLinearRing();
                 poPoly->addRingDirectly(poRing);
-                apoPolygons[nPolys++] = poPoly;
+                oPending.apoPolygons.push_back(std::move(poPoly));
                 poLS = poRing;
 
                 if (strcmp(psRelation->pasMembers[i].pszRole, "outer") == 0)
@@ -2302,7 +2633,7 @@ OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
             else
             {
                 poLS = new OGRLineString();
-                oMLS.addGeometryDirectly(poLS);
+                oPending.oMLS.addGeometryDirectly(poLS);
             }
 
             const int nPoints = static_cast<int>(m_asLonLatCache.size());
@@ -2312,14 +2643,32 @@ OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
                 poLS->setPoint(j, INT_TO_DBL(m_asLonLatCache[j].nLon),
                                INT_TO_DBL(m_asLonLatCache[j].nLat));
             }
+            m_nPendingRelationPoints += nPoints;
         }
     }
 
-    if (oMLS.getNumGeometries() > 0)
+    // cppcheck-suppress constVariableReference
+    for (auto &oIter : aoMapWays)
+        CPLFree(oIter.second.second);
+
+    return true;
+}
+
+/************************************************************************/
+/*                        AssembleMultiPolygon()                        */
+/************************************************************************/
+
+// Does not access the datasource, so that it can be run concurrently on
+// the pending relations.
+void OGROSMDataSource::AssembleMultiPolygon(OGROSMPendingRelation &oPending)
+{
+    auto &apoPolygons = oPending.apoPolygons;
+    if (oPending.oMLS.getNumGeometries() > 0)
     {
         auto poPolyFromEdges = std::unique_ptr<OGRGeometry>(
             OGRGeometry::FromHandle(OGRBuildPolygonFromEdges(
-                OGRGeometry::ToHandle(&oMLS), TRUE, FALSE, 0, nullptr)));
+                OGRGeometry::ToHandle(&oPending.oMLS), TRUE, FALSE, 0,
+                nullptr)));
         if (poPolyFromEdges && poPolyFromEdges->getGeometryType() == wkbPolygon)
         {
             const OGRPolygon *poSuperPoly = poPolyFromEdges->toPolygon();
@@ -2330,23 +2679,30 @@ OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
                         poRing->getX(poRing->getNumPoints() - 1) &&
                     poRing->getY(0) == poRing->getY(poRing->getNumPoints() - 1))
                 {
-                    OGRPolygon *poPoly = new OGRPolygon();
+                    auto poPoly = std::make_unique<OGRPolygon>();
                     poPoly->addRing(poRing);
-                    apoPolygons[nPolys++] = poPoly;
+                    apoPolygons.push_back(std::move(poPoly));
                 }
             }
         }
+        oPending.oMLS.empty();
     }
 
-    std::unique_ptr<OGRGeometry> poRet;
-
-    if (nPolys > 0)
+    if (!apoPolygons.empty())
     {
+        // organizePolygons() takes ownership of the polygons
+        std::vector<OGRGeometry *> apoRawPolygons;
+        apoRawPolygons.reserve(apoPolygons.size());
+        for (auto &poPoly : apoPolygons)
+            apoRawPolygons.push_back(poPoly.release());
+        apoPolygons.clear();
+
         int bIsValidGeometry = FALSE;
         const char *apszOptions[2] = {"METHOD=DEFAULT", nullptr};
         auto poGeom =
             std::unique_ptr<OGRGeometry>(OGRGeometryFactory::organizePolygons(
-                apoPolygons.data(), nPolys, &bIsValidGeometry, apszOptions));
+                apoRawPolygons.data(), static_cast<int>(apoRawPolygons.size()),
+                &bIsValidGeometry, apszOptions));
 
         if (poGeom && poGeom->getGeometryType() == wkbPolygon)
         {
@@ -2357,25 +2713,91 @@ OGRGeometry *OGROSMDataSource::BuildMultiPolygon(const OSMRelation *psRelation,
 
         if (poGeom && poGeom->getGeometryType() == wkbMultiPolygon)
         {
-            poRet = std::move(poGeom);
+            oPending.poGeom = std::move(poGeom);
         }
         else
         {
-            CPLDebug("OSM",
-                     "Relation " CPL_FRMT_GIB
-                     ": Geometry has incompatible type : %s",
-                     psRelation->nID,
-                     poGeom ? OGR_G_GetGeometryName(
-                                  OGRGeometry::ToHandle(poGeom.get()))
-                            : "null");
+            oPending.osDebugMsg = CPLSPrintf(
+                "Relation " CPL_FRMT_GIB
+                ": Geometry has incompatible type : %s",
+                oPending.nID,
+                poGeom ? OGR_G_GetGeometryName(
+                             OGRGeometry::ToHandle(poGeom.get()))
+                       : "null");
         }
     }
+}
 
-    // cppcheck-suppress constVariableReference
-    for (auto &oIter : aoMapWays)
-        CPLFree(oIter.second.second);
+/************************************************************************/
+/*                       ProcessRelationsBatch()                        */
+/************************************************************************/
+
+void OGROSMDataSource::ProcessRelationsBatch()
+{
+    if (m_apoPendingRelations.empty())
+        return;
+
+    // Polygonization of the rings is the costly part of multipolygon
+    // building, and only depends on the pending relation itself.
+    const size_t nRelations = m_apoPendingRelations.size();
+    auto poThreadPool = m_nNumThreads > 1 && nRelations > 1
+                            ? GDALGetGlobalThreadPool(m_nNumThreads)
+                            : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poJobQueue)
+    {
+        const size_t nJobs =
+            std::min(nRelations, static_cast<size_t>(m_nNumThreads) * 4);
+        // Debug messages are not accumulated, but stored in the items and
+        // emitted below in item order
+        std::vector<CPLErrorAccumulator> aoErrorAccumulators(nJobs);
+        for (size_t iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const size_t iStart = iJob * nRelations / nJobs;
+            const size_t iEnd = (iJob + 1) * nRelations / nJobs;
+            auto &oErrorAccumulator = aoErrorAccumulators[iJob];
+            poJobQueue->SubmitJob(
+                [this, iStart, iEnd, &oErrorAccumulator]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    for (size_t i = iStart; i < iEnd; ++i)
+                        AssembleMultiPolygon(*(m_apoPendingRelations[i]));
+                });
+        }
+        poJobQueue->WaitCompletion();
+        for (auto &oErrorAccumulator : aoErrorAccumulators)
+            oErrorAccumulator.ReplayErrors();
+    }
+    else
+    {
+        for (auto &poPending : m_apoPendingRelations)
+            AssembleMultiPolygon(*poPending);
+    }
+
+    for (auto &poPending : m_apoPendingRelations)
+    {
+        if (!poPending->osDebugMsg.empty())
+            CPLDebug("OSM", "%s", poPending->osDebugMsg.c_str());
+
+        if (!poPending->poGeom)
+            continue;
+
+        poPending->poFeature->SetGeometryDirectly(poPending->poGeom.release());
+
+        bool bFilteredOut = false;
+        if (!m_apoLayers[IDX_LYR_MULTIPOLYGONS]->AddFeature(
+                std::move(poPending->poFeature),
+                poPending->bAttrFilterAlreadyEvaluated, &bFilteredOut,
+                !m_bFeatureAdded))
+            m_bStopParsing = true;
+        else if (!bFilteredOut)
+            m_bFeatureAdded = true;
+    }
 
-    return poRet.release();
+    m_apoPendingRelations.clear();
+    m_nPendingRelationPoints = 0;
 }
 
 /************************************************************************/
@@ -2532,30 +2954,35 @@ void OGROSMDataSource::NotifyRelation(const OSMRelation *psRelation)
         }
     }
 
-    OGRGeometry *poGeom = nullptr;
-
     unsigned int nExtraTags = 0;
     OSMTag pasExtraTags[1 + MAX_COUNT_FOR_TAGS_IN_WAY];
 
     if (bMultiPolygon)
     {
+        // Member ways are fetched now, as the extra tags point to
+        // m_abyWayBuffer, but the geometry is assembled by
+        // ProcessRelationsBatch()
+        auto poPending = std::make_unique<OGROSMPendingRelation>();
+        poPending->nID = psRelation->nID;
         if (!bInterestingTagFound)
         {
-            poGeom = BuildMultiPolygon(psRelation, &nExtraTags, pasExtraTags);
+            if (!CollectMultiPolygonParts(psRelation, &nExtraTags,
+                                          pasExtraTags, *poPending))
+                return;
             CPLAssert(nExtraTags <= MAX_COUNT_FOR_TAGS_IN_WAY);
             pasExtraTags[nExtraTags].pszK = "type";
             pasExtraTags[nExtraTags].pszV = pszTypeV;
             nExtraTags++;
         }
-        else
-            poGeom = BuildMultiPolygon(psRelation, nullptr, nullptr);
-    }
-    else
-        poGeom = BuildGeometryCollection(psRelation, bMultiLineString);
+        else if (!CollectMultiPolygonParts(psRelation, nullptr, nullptr,
+                                           *poPending))
+            return;
 
-    if (poGeom != nullptr)
-    {
-        bool bAttrFilterAlreadyEvaluated = true;
+        if (poPending->apoPolygons.empty() &&
+            poPending->oMLS.getNumGeometries() == 0)
+            return;
+
+        poPending->bAttrFilterAlreadyEvaluated = true;
         if (poFeature == nullptr)
         {
             poFeature = std::make_unique<OGRFeature>(
@@ -2567,6 +2994,34 @@ void OGROSMDataSource::NotifyRelation(const OSMRelation *psRelation)
                 nExtraTags ? pasExtraTags : psRelation->pasTags,
                 &psRelation->sInfo);
 
+            poPending->bAttrFilterAlreadyEvaluated = false;
+        }
+        poPending->poFeature = std::move(poFeature);
+
+        m_apoPendingRelations.push_back(std::move(poPending));
+        if (m_apoPendingRelations.size() >= MAX_PENDING_RELATIONS ||
+            m_nPendingRelationPoints >= MAX_PENDING_RELATION_POINTS)
+        {
+            ProcessRelationsBatch();
+        }
+        return;
+    }
+
+    OGRGeometry *poGeom =
+        BuildGeometryCollection(psRelation, bMultiLineString);
+
+    if (poGeom != nullptr)
+    {
+        bool bAttrFilterAlreadyEvaluated = true;
+        if (poFeature == nullptr)
+        {
+            poFeature = std::make_unique<OGRFeature>(
+                m_apoLayers[iCurLayer]->GetLayerDefn());
+
+            m_apoLayers[iCurLayer]->SetFieldsFromTags(
+                poFeature.get(), psRelation->nID, false, psRelation->nTags,
+                psRelation->pasTags, &psRelation->sInfo);
+
             bAttrFilterAlreadyEvaluated = false;
         }
 
@@ -2730,6 +3185,15 @@ int OGROSMDataSource::Open(const char *pszFilename,
     m_bUseWaysIndex =
         CPLTestBool(CPLGetConfigOption("OSM_USE_WAYS_INDEX", "YES"));
 
+    // Number of threads used to build the geometries of ways and
+    // multipolygons
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    m_nNumThreads = CPLGetNumCPUs();
+    if (pszNumThreads && !EQUAL(pszNumThreads, "ALL_CPUS"))
+        m_nNumThreads =
+            std::max(1, std::min(2 * m_nNumThreads, atoi(pszNumThreads)));
+
     m_bCustomIndexing = CPLTestBool(CSLFetchNameValueDef(
         papszOpenOptionsIn, "USE_CUSTOM_INDEXING",
         CPLGetConfigOption("OSM_USE_CUSTOM_INDEXING", "YES")));
@@ -2741,6 +3205,34 @@ int OGROSMDataSource::Open(const char *pszFilename,
     if (m_bCompressNodes)
         CPLDebug("OSM", "Using compression for nodes DB");
 
+    if (m_bCustomIndexing)
+    {
+        const char *pszDenseNodeIndex = CSLFetchNameValueDef(
+            papszOpenOptionsIn, "DENSE_NODE_INDEX",
+            CPLGetConfigOption("OSM_DENSE_NODE_INDEX", "AUTO"));
+        if (EQUAL(pszDenseNodeIndex, "AUTO"))
+        {
+            VSIStatBufL sStat;
+            m_bDenseNodeIndex =
+                sizeof(void *) == 8 && CPLIsVirtualMemFileMapAvailable() &&
+                VSIStatL(pszFilename, &sStat) == 0 &&
+                sStat.st_size >= DENSE_NODE_INDEX_MIN_FILE_SIZE;
+        }
+        else if (CPLTestBool(pszDenseNodeIndex))
+        {
+            if (CPLIsVirtualMemFileMapAvailable())
+            {
+                m_bDenseNodeIndex = true;
+            }
+            else
+            {
+                CPLError(CE_Warning, CPLE_NotSupported,
+                         "Dense node index not supported on this "
+                         "platform. Using default node index");
+            }
+        }
+    }
+
     // Do not change the below order without updating the IDX_LYR_ constants!
     m_apoLayers.emplace_back(
         std::make_unique<OGROSMLayer>(this, IDX_LYR_POINTS, "points"));
@@ -2858,7 +3350,12 @@ int OGROSMDataSource::Open(const char *pszFilename,
         nSize = static_cast<GIntBig>(m_nMaxSizeForInMemoryDBInMB) * 1024 * 1024;
     }
 
-    if (m_bCustomIndexing)
+    if (m_bDenseNodeIndex)
+    {
+        if (!InitDenseNodeIndex())
+            return FALSE;
+    }
+    else if (m_bCustomIndexing)
     {
         m_pabySector = static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, SECTOR_SIZE));
 
@@ -3786,7 +4283,8 @@ int OGROSMDataSource::MyResetReading()
 {
     if (m_hDB == nullptr)
         return FALSE;
-    if (m_bCustomIndexing && m_fpNodes == nullptr)
+    if (m_bDenseNodeIndex ? m_fpDenseNodes == nullptr
+                          : m_bCustomIndexing && m_fpNodes == nullptr)
         return FALSE;
 
     OSM_ResetReading(m_psParser);
@@ -3827,6 +4325,8 @@ int OGROSMDataSource::MyResetReading()
 
     {
         m_asWayFeaturePairs.clear();
+        m_apoPendingRelations.clear();
+        m_nPendingRelationPoints = 0;
         m_nUnsortedReqIds = 0;
         m_nReqIds = 0;
         m_nAccumulatedTags = 0;
@@ -3847,7 +4347,25 @@ int OGROSMDataSource::MyResetReading()
         m_aoMapIndexedKeys.clear();
     }
 
-    if (m_bCustomIndexing)
+    if (m_bDenseNodeIndex)
+    {
+        m_nPrevNodeId = -1;
+
+        if (m_psDenseNodesMapping)
+            CPLVirtualMemFree(m_psDenseNodesMapping);
+        m_psDenseNodesMapping = nullptr;
+        m_pasDenseNodes = nullptr;
+        m_nDenseNodesMapped = 0;
+
+        VSIFTruncateL(m_fpDenseNodes, 0);
+        m_nDenseNodesFileSize = 0;
+
+        std::fill(m_asDenseNodesBuffer.begin(), m_asDenseNodesBuffer.end(),
+                  LonLat{0, 0});
+        m_nDenseNodesBufferFirstId = -1;
+        m_nDenseNodesBufferLastId = -1;
+    }
+    else if (m_bCustomIndexing)
     {
         m_nPrevNodeId = -1;
         m_nBucketOld = -1;
@@ -3988,6 +4506,7 @@ bool OGROSMDataSource::ParseNextChunk(int nIdxLayer,
 #endif
 
         OSMRetCode eRet = OSM_ProcessBlock(m_psParser);
+        ProcessRelationsBatch();
         if (pfnProgress != nullptr)
         {
             double dfPct = -1.0;
@@ -110,6 +110,13 @@ void RegisterOGROSM()
         "description='Whether to enable custom indexing.' default='YES'/>"
         "  <Option name='COMPRESS_NODES' type='boolean' description='Whether "
         "to compress nodes in temporary DB.' default='NO'/>"
+        "  <Option name='DENSE_NODE_INDEX' type='string-select' "
+        "description='Whether to index node locations in a memory mapped "
+        "array indexed by node id.' default='AUTO'>"
+        "    <Value>AUTO</Value>"
+        "    <Value>YES</Value>"
+        "    <Value>NO</Value>"
+        "  </Option>"
         "  <Option name='MAX_TMPFILE_SIZE' type='int' description='Maximum "
         "size in MB of in-memory temporary file. If it exceeds that value, it "
         "will go to disk' default='100'/>"
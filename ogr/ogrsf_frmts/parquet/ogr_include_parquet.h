@@ -42,6 +42,10 @@
 #include "parquet/arrow/reader.h"
 #include "parquet/arrow/writer.h"
 #include "parquet/arrow/schema.h"
+#if PARQUET_VERSION_MAJOR >= 13
+#include "parquet/bloom_filter.h"
+#include "parquet/bloom_filter_reader.h"
+#endif
 #if PARQUET_VERSION_MAJOR >= 21
 #include "parquet/geospatial/statistics.h"
 #endif
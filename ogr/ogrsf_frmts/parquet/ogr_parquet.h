@@ -16,9 +16,12 @@
 #include "ogrsf_frmts.h"
 
 #include "cpl_json.h"
+#include "cpl_vsi_virtual.h"
 
+#include <atomic>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <set>
 
 #include "../arrow_common/ogr_arrow.h"
@@ -82,6 +85,14 @@ class OGRParquetLayerBase CPL_NON_FINAL : public OGRArrowLayer
 /*                        OGRParquetLayer                               */
 /************************************************************************/
 
+//! Result of the evaluation of a filter against the statistics of a row group
+enum class IsConstraintPossibleRes
+{
+    YES,
+    NO,
+    UNKNOWN
+};
+
 class OGRParquetLayer final : public OGRParquetLayerBase
 
 {
@@ -143,6 +154,26 @@ class OGRParquetLayer final : public OGRParquetLayerBase
     OGRFeature *GetFeatureExplicitFID(GIntBig nFID);
     OGRFeature *GetFeatureByIndex(GIntBig nFID);
 
+    IsConstraintPossibleRes
+    IsConstraintPossibleForRowGroup(int iRowGroup, int64_t nFeatureIdxTotal,
+                                    const Constraint &constraint) const;
+    IsConstraintPossibleRes IsExprPossibleForRowGroup(
+        int iRowGroup, int64_t nFeatureIdxTotal, const swq_expr_node *poNode,
+        bool bNegate) const;
+    bool BuildConstraintFromExpr(const swq_expr_node *poColumn,
+                                 const swq_expr_node *poValue,
+                                 Constraint &constraint) const;
+    bool IsValueInBloomFilter(int iRowGroup, int iOGRField,
+                              const Constraint &constraint) const;
+    bool MayContainNulls(int iRowGroup, int iField) const;
+
+#if PARQUET_VERSION_MAJOR >= 13
+    //! Bloom filters, indexed by (row group, Parquet column), read while
+    //! selecting row groups. May contain null pointers.
+    mutable std::map<std::pair<int, int>, std::unique_ptr<parquet::BloomFilter>>
+        m_oMapBloomFilters{};
+#endif
+
     virtual std::string GetDriverUCName() const override
     {
         return "PARQUET";
@@ -330,12 +361,33 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool m_bForceCounterClockwiseOrientation = false;
     parquet::WriterProperties::Builder m_oWriterPropertiesBuilder{};
 
-    //! Temporary GeoPackage dataset. Only used in SORT_BY_BBOX mode
-    std::unique_ptr<GDALDataset> m_poTmpGPKG{};
-    //! Temporary GeoPackage layer. Only used in SORT_BY_BBOX mode
-    OGRLayer *m_poTmpGPKGLayer = nullptr;
-    //! Number of features written by ICreateFeature(). Only used in SORT_BY_BBOX mode
-    GIntBig m_nTmpFeatureCount = 0;
+    //! Whether SORT_BY_BBOX=YES is used
+    bool m_bSortByBBOX = false;
+
+    //! Feature pending for writing in SORT_BY_BBOX mode
+    struct SortItem
+    {
+        uint64_t nOffset = 0;  // in m_abySortBuffer or m_fpSortTmp
+        uint64_t nKey = 0;     // 0 if no geometry, else 1 << 32 | Hilbert code
+        double dfX = 0;        // center of the geometry bounding box
+        double dfY = 0;
+        uint32_t nSize = 0;  // size of the serialized feature
+    };
+
+    //! Pending features. Only used in SORT_BY_BBOX mode
+    std::vector<SortItem> m_asSortItems{};
+    //! Extent of the centers of the bounding boxes of pending features
+    OGREnvelope m_sSortExtent{};
+    //! Serialized features not yet spilled to m_fpSortTmp
+    std::vector<GByte> m_abySortBuffer{};
+    //! Maximum size of m_abySortBuffer before spilling it to m_fpSortTmp
+    size_t m_nSortMaxRAM = 0;
+    //! Temporary file with serialized features, once m_nSortMaxRAM is reached
+    VSIVirtualHandleUniquePtr m_fpSortTmp{};
+    //! Name of m_fpSortTmp
+    std::string m_osSortTmpFilename{};
+    //! Size of m_fpSortTmp
+    uint64_t m_nSortTmpFileSize = 0;
 
     //! Whether to write "geo" footer metadata;
     bool m_bWriteGeoMetadata = true;
@@ -372,8 +424,10 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
 
     std::string GetGeoMetadata() const;
 
-    //! Copy temporary GeoPackage layer to final Parquet file
-    bool CopyTmpGpkgLayerToFinalFile();
+    //! Spill pending features to temporary file in SORT_BY_BBOX mode
+    bool SpillSortBuffer();
+    //! Write pending features in Hilbert order in SORT_BY_BBOX mode
+    bool WriteSortedFeatures();
 
   public:
     OGRParquetWriterLayer(
@@ -428,13 +482,160 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
 
     GDALDataset *GetDataset() override;
 
+    //! Return the Parquet footer of the file, once it has been closed
+    std::shared_ptr<parquet::FileMetaData> GetFileMetaData() const
+    {
+        return m_poFileWriter ? m_poFileWriter->metadata() : nullptr;
+    }
+
   protected:
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
 
     friend class OGRParquetWriterDataset;
+    friend class OGRParquetPartitionedWriterLayer;
     bool Close();
 };
 
+/************************************************************************/
+/*                  OGRParquetPartitionedWriterLayer                    */
+/************************************************************************/
+
+class CPLErrorAccumulator;
+class CPLJobQueue;
+class CPLWorkerThreadPool;
+
+/** Layer writing a Hive-partitioned directory of Parquet files, with one
+ * sub-directory per distinct value of the PARTITION_BY fields and/or
+ * PARTITION_GRID_SIZE cell.
+ */
+class OGRParquetPartitionedWriterLayer final : public OGRLayer
+{
+    OGRParquetPartitionedWriterLayer(const OGRParquetPartitionedWriterLayer &) =
+        delete;
+    OGRParquetPartitionedWriterLayer &
+    operator=(const OGRParquetPartitionedWriterLayer &) = delete;
+
+    struct Partition
+    {
+        //! Directory of the partition, relative to the dataset directory
+        std::string osDirectory{};
+        //! Number of files created in this partition
+        int nFileCounter = 0;
+        //! Filename of the current file, relative to the dataset directory
+        std::string osCurFilename{};
+        //! Dataset of the current file, or null if no file is open
+        std::shared_ptr<OGRParquetWriterDataset> poDS{};
+        //! Layer of poDS
+        OGRParquetWriterLayer *poLayer = nullptr;
+        //! Features not yet submitted for writing
+        std::vector<std::unique_ptr<OGRFeature>> apoPendingFeatures{};
+        //! Queue of the jobs of this partition (at most one is running)
+        std::unique_ptr<CPLJobQueue> poJobQueue{};
+        //! Errors emitted by the running job
+        std::unique_ptr<CPLErrorAccumulator> poErrorAccumulator{};
+        //! Value of m_nUseCounter the last time a feature was added
+        uint64_t nLastUse = 0;
+    };
+
+    OGRParquetWriterDataset *m_poDataset = nullptr;
+    std::string m_osDirectory{};
+    CPLStringList m_aosOptions{};
+
+    //! Layer never written, used to validate options and fields
+    std::unique_ptr<OGRParquetWriterLayer> m_poTemplateLayer{};
+
+    std::vector<std::string> m_aosPartitionFields{};
+    double m_dfGridSize = 0;
+    int m_nMaxOpenFiles = 0;
+    bool m_bWriteMetadataFile = true;
+    //! Whether the layer was created with a geometry field
+    bool m_bCreatedWithGeomField = false;
+
+    bool m_bFirstFeature = true;
+    //! Index of the partition fields in the layer definition
+    std::vector<int> m_anPartitionFieldIdx{};
+    //! Map from layer fields to fields of the Parquet files
+    std::vector<int> m_anFieldMap{};
+
+    std::map<std::string, std::unique_ptr<Partition>> m_oMapPartitions{};
+    int m_nOpenFiles = 0;
+    uint64_t m_nUseCounter = 0;
+    GIntBig m_nFeatureCount = 0;
+
+    CPLWorkerThreadPool *m_poThreadPool = nullptr;
+    std::atomic<bool> m_bJobError{false};
+
+    std::mutex m_oMutexFileMetaData{};
+    //! Footers of closed files, with their relative filename
+    std::vector<
+        std::pair<std::string, std::shared_ptr<parquet::FileMetaData>>>
+        m_aoFileMetaData{};
+
+    bool m_bClosed = false;
+
+    std::string GetPartitionDirectory(OGRFeature *poFeature) const;
+    bool ResolvePartitionFields();
+    bool OpenPartitionFile(Partition &oPartition);
+    bool SubmitPendingFeatures(Partition &oPartition);
+    bool SubmitClosePartitionFile(Partition &oPartition);
+    void RunJob(Partition &oPartition, std::function<void()> task);
+    bool WaitPartition(Partition &oPartition);
+    bool WriteMetadataFile();
+
+  public:
+    OGRParquetPartitionedWriterLayer(OGRParquetWriterDataset *poDS,
+                                     const char *pszLayerName,
+                                     const std::string &osDirectory);
+    ~OGRParquetPartitionedWriterLayer() override;
+
+    bool SetOptions(CSLConstList papszOptions,
+                    const OGRSpatialReference *poSpatialRef,
+                    OGRwkbGeometryType eGType);
+
+    void ResetReading() override
+    {
+    }
+
+    OGRFeature *GetNextFeature() override
+    {
+        return nullptr;
+    }
+
+    OGRFeatureDefn *GetLayerDefn() override
+    {
+        return m_poTemplateLayer->GetLayerDefn();
+    }
+
+    const char *GetFIDColumn() override
+    {
+        return m_poTemplateLayer->GetFIDColumn();
+    }
+
+    GIntBig GetFeatureCount(int /* bForce */) override
+    {
+        return m_nFeatureCount;
+    }
+
+    int TestCapability(const char *pszCap) override;
+
+    OGRErr CreateField(const OGRFieldDefn *poField,
+                       int bApproxOK = TRUE) override;
+    OGRErr CreateGeomField(const OGRGeomFieldDefn *poField,
+                           int bApproxOK = TRUE) override;
+
+    bool AddFieldDomain(std::unique_ptr<OGRFieldDomain> &&domain,
+                        std::string &failureReason);
+    std::vector<std::string> GetFieldDomainNames() const;
+    const OGRFieldDomain *GetFieldDomain(const std::string &name) const;
+
+    GDALDataset *GetDataset() override;
+
+    bool Close();
+
+  protected:
+    OGRErr ICreateFeature(OGRFeature *poFeature) override;
+};
+
 /************************************************************************/
 /*                        OGRParquetWriterDataset                       */
 /************************************************************************/
@@ -443,12 +644,21 @@ class OGRParquetWriterDataset final : public GDALPamDataset
 {
     std::unique_ptr<arrow::MemoryPool> m_poMemoryPool{};
     std::unique_ptr<OGRParquetWriterLayer> m_poLayer{};
+    std::unique_ptr<OGRParquetPartitionedWriterLayer> m_poPartitionedLayer{};
     std::shared_ptr<arrow::io::OutputStream> m_poOutputStream{};
 
   public:
+    //! Constructor. If poOutputStream is null, the dataset description is
+    //! a directory in which ICreateLayer() writes a partitioned dataset.
+    //! Otherwise, ICreateLayer() replaces the output file by a directory
+    //! when the PARTITION_BY or PARTITION_GRID_SIZE layer creation options
+    //! are used.
     explicit OGRParquetWriterDataset(
         const std::shared_ptr<arrow::io::OutputStream> &poOutputStream);
 
+    static std::shared_ptr<arrow::io::OutputStream>
+    CreateOutputStream(const char *pszFilename);
+
     arrow::MemoryPool *GetMemoryPool() const
     {
         return m_poMemoryPool.get();
@@ -24,7 +24,6 @@
 
 #include "../arrow_common/ograrrowrandomaccessfile.h"
 #include "../arrow_common/vsiarrowfilesystem.hpp"
-#include "../arrow_common/ograrrowwritablefile.h"
 #include "../arrow_common/ograrrowdataset.hpp"
 #include "../arrow_common/ograrrowlayer.hpp"  // for the destructor
 
@@ -589,27 +588,22 @@ static GDALDataset *OGRParquetDriverCreate(const char *pszName, int nXSize,
     if (!(nXSize == 0 && nYSize == 0 && nBands == 0 && eType == GDT_Unknown))
         return nullptr;
 
+    // Whether the output is a file or a directory depends on the layer
+    // creation options. An existing directory is assumed to be the target
+    // of a partitioned dataset. Otherwise the output file is created right
+    // away so that errors are reported early, and ICreateLayer() replaces
+    // it with a directory if the layer is partitioned.
+    VSIStatBufL sStat;
+    if (VSIStatL(pszName, &sStat) == 0 && VSI_ISDIR(sStat.st_mode))
+        return new OGRParquetWriterDataset(nullptr);
+
     try
     {
-        std::shared_ptr<arrow::io::OutputStream> out_file;
-        if (STARTS_WITH(pszName, "/vsi") ||
-            CPLTestBool(CPLGetConfigOption("OGR_PARQUET_USE_VSI", "YES")))
-        {
-            VSILFILE *fp = VSIFOpenL(pszName, "wb");
-            if (fp == nullptr)
-            {
-                CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", pszName);
-                return nullptr;
-            }
-            out_file = std::make_shared<OGRArrowWritableFile>(fp);
-        }
-        else
-        {
-            PARQUET_ASSIGN_OR_THROW(out_file,
-                                    arrow::io::FileOutputStream::Open(pszName));
-        }
-
-        return new OGRParquetWriterDataset(out_file);
+        auto poOutputStream =
+            OGRParquetWriterDataset::CreateOutputStream(pszName);
+        if (!poOutputStream)
+            return nullptr;
+        return new OGRParquetWriterDataset(poOutputStream);
     }
     catch (const std::exception &e)
     {
@@ -865,6 +859,46 @@ void OGRParquetDriver::InitMetadata()
                                    "the bounding box of their geometries");
     }
 
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "PARTITION_BY");
+        CPLAddXMLAttributeAndValue(psOption, "type", "string");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Comma separated list of fields used to "
+                                   "partition features into a Hive-style "
+                                   "directory of files");
+    }
+
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "PARTITION_GRID_SIZE");
+        CPLAddXMLAttributeAndValue(psOption, "type", "float");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Size, in georeferenced units, of the cells "
+                                   "of a grid used to partition features into "
+                                   "a Hive-style directory of files");
+    }
+
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "MAX_OPEN_FILES");
+        CPLAddXMLAttributeAndValue(psOption, "type", "integer");
+        CPLAddXMLAttributeAndValue(psOption, "default", "256");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Maximum number of files simultaneously "
+                                   "open when writing a partitioned dataset");
+    }
+
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "WRITE_METADATA_FILE");
+        CPLAddXMLAttributeAndValue(psOption, "type", "boolean");
+        CPLAddXMLAttributeAndValue(psOption, "default", "YES");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Whether to write a _metadata file when "
+                                   "writing a partitioned dataset");
+    }
+
     char *pszXML = CPLSerializeXMLTree(oTree.get());
     GDALDriver::SetMetadataItem(GDAL_DS_LAYER_CREATIONOPTIONLIST, pszXML);
     CPLFree(pszXML);
@@ -1767,13 +1767,6 @@ bool OGRParquetLayer::CreateRecordBatchReader(
 /*                       IsConstraintPossible()                         */
 /************************************************************************/
 
-enum class IsConstraintPossibleRes
-{
-    YES,
-    NO,
-    UNKNOWN
-};
-
 template <class T>
 static IsConstraintPossibleRes IsConstraintPossible(int nOperation, T v, T min,
                                                     T max)
@@ -1830,6 +1823,551 @@ static IsConstraintPossibleRes IsConstraintPossible(int nOperation, T v, T min,
     return IsConstraintPossibleRes::YES;
 }
 
+/************************************************************************/
+/*                   IsConstraintPossibleForRowGroup()                  */
+/************************************************************************/
+
+IsConstraintPossibleRes OGRParquetLayer::IsConstraintPossibleForRowGroup(
+    int iRowGroup, int64_t nFeatureIdxTotal,
+    const Constraint &constraint) const
+{
+    OGRField sMin;
+    OGRField sMax;
+    OGR_RawField_SetNull(&sMin);
+    OGR_RawField_SetNull(&sMax);
+    bool bFoundMin = false;
+    bool bFoundMax = false;
+    OGRFieldType eType = OFTMaxType;
+    OGRFieldSubType eSubType = OFSTNone;
+    std::string osMinTmp, osMaxTmp;
+
+    const auto metadata = m_poArrowReader->parquet_reader()->metadata();
+    const int64_t nRowGroupRows = metadata->RowGroup(iRowGroup)->num_rows();
+
+    int iOGRField = constraint.iField;
+    if (constraint.iField == m_poFeatureDefn->GetFieldCount() + SPF_FID)
+    {
+        iOGRField = OGR_FID_INDEX;
+    }
+    if (constraint.nOperation != SWQ_ISNULL &&
+        constraint.nOperation != SWQ_ISNOTNULL)
+    {
+        if (iOGRField == OGR_FID_INDEX && m_iFIDParquetColumn < 0)
+        {
+            sMin.Integer64 = nFeatureIdxTotal;
+            sMax.Integer64 = nFeatureIdxTotal + nRowGroupRows - 1;
+            eType = OFTInteger64;
+        }
+        else if (!GetMinMaxForOGRField(iRowGroup, iOGRField, true, sMin,
+                                       bFoundMin, true, sMax, bFoundMax, eType,
+                                       eSubType, osMinTmp, osMaxTmp) ||
+                 !bFoundMin || !bFoundMax)
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+    }
+
+    IsConstraintPossibleRes res = IsConstraintPossibleRes::UNKNOWN;
+    if (constraint.eType == OGRArrowLayer::Constraint::Type::Integer &&
+        eType == OFTInteger)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   constraint.sValue.Integer, sMin.Integer,
+                                   sMax.Integer);
+    }
+    else if (constraint.eType == OGRArrowLayer::Constraint::Type::Integer64 &&
+             eType == OFTInteger64)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   constraint.sValue.Integer64, sMin.Integer64,
+                                   sMax.Integer64);
+    }
+    else if (constraint.eType == OGRArrowLayer::Constraint::Type::Real &&
+             eType == OFTReal)
+    {
+        res = IsConstraintPossible(constraint.nOperation,
+                                   constraint.sValue.Real, sMin.Real,
+                                   sMax.Real);
+    }
+    else if (constraint.eType == OGRArrowLayer::Constraint::Type::String &&
+             eType == OFTString)
+    {
+        res = IsConstraintPossible(
+            constraint.nOperation, std::string(constraint.sValue.String),
+            std::string(sMin.String), std::string(sMax.String));
+    }
+    else if (constraint.nOperation == SWQ_ISNULL ||
+             constraint.nOperation == SWQ_ISNOTNULL)
+    {
+        const int iCol = iOGRField == OGR_FID_INDEX
+                             ? m_iFIDParquetColumn
+                             : GetMapFieldIndexToParquetColumn()[iOGRField];
+        if (iCol >= 0)
+        {
+            const auto rowGroupColumnChunk =
+                metadata->RowGroup(iRowGroup)->ColumnChunk(iCol);
+            const auto rowGroupStats = rowGroupColumnChunk->statistics();
+            if (rowGroupColumnChunk->is_stats_set() && rowGroupStats)
+            {
+                res = IsConstraintPossibleRes::YES;
+                if (constraint.nOperation == SWQ_ISNULL &&
+                    rowGroupStats->num_values() == nRowGroupRows)
+                {
+                    res = IsConstraintPossibleRes::NO;
+                }
+                else if (constraint.nOperation == SWQ_ISNOTNULL &&
+                         rowGroupStats->num_values() == 0)
+                {
+                    res = IsConstraintPossibleRes::NO;
+                }
+            }
+        }
+    }
+    else
+    {
+        CPLDebug("PARQUET",
+                 "Unhandled combination of constraint.eType "
+                 "(%d) and eType (%d)",
+                 static_cast<int>(constraint.eType), eType);
+    }
+
+    // Statistics do not tell whether a value within [min, max] is actually
+    // present, but a bloom filter may.
+    if (res != IsConstraintPossibleRes::NO &&
+        constraint.nOperation == SWQ_EQ &&
+        !IsValueInBloomFilter(iRowGroup, iOGRField, constraint))
+    {
+        res = IsConstraintPossibleRes::NO;
+    }
+
+    return res;
+}
+
+/************************************************************************/
+/*                        IsValueInBloomFilter()                        */
+/************************************************************************/
+
+// Return false if the bloom filter of the column of the field in the row
+// group is available and proves that the value of the constraint is absent.
+bool OGRParquetLayer::IsValueInBloomFilter(int iRowGroup, int iOGRField,
+                                           const Constraint &constraint) const
+{
+#if PARQUET_VERSION_MAJOR >= 13
+    const int iCol = iOGRField == OGR_FID_INDEX
+                         ? m_iFIDParquetColumn
+                         : GetMapFieldIndexToParquetColumn()[iOGRField];
+    if (iCol < 0)
+        return true;
+    const auto &arrowType = iOGRField == OGR_FID_INDEX
+                                ? m_poFIDType
+                                : GetArrowFieldTypes()[iOGRField];
+    if (!arrowType)
+        return true;
+
+    const auto oKey = std::make_pair(iRowGroup, iCol);
+    auto oIter = m_oMapBloomFilters.find(oKey);
+    if (oIter == m_oMapBloomFilters.end())
+    {
+        std::unique_ptr<parquet::BloomFilter> poBloomFilter;
+        if (CPLTestBool(
+                CPLGetConfigOption("OGR_PARQUET_USE_BLOOM_FILTER", "YES")))
+        {
+            try
+            {
+                auto poRowGroupReader = m_poArrowReader->parquet_reader()
+                                            ->GetBloomFilterReader()
+                                            .RowGroup(iRowGroup);
+                if (poRowGroupReader)
+                    poBloomFilter =
+                        poRowGroupReader->GetColumnBloomFilter(iCol);
+            }
+            catch (const std::exception &e)
+            {
+                CPLDebug("PARQUET", "Cannot read bloom filter: %s", e.what());
+            }
+        }
+        oIter =
+            m_oMapBloomFilters.emplace(oKey, std::move(poBloomFilter)).first;
+    }
+    const auto &poBloomFilter = oIter->second;
+    if (!poBloomFilter)
+        return true;
+
+    // The hash must be computed on the value in the physical type of the
+    // column.
+    const auto physicalType = m_poArrowReader->parquet_reader()
+                                  ->metadata()
+                                  ->schema()
+                                  ->Column(iCol)
+                                  ->physical_type();
+    const auto eArrowTypeId = arrowType->id();
+    if (constraint.eType == OGRArrowLayer::Constraint::Type::Integer &&
+        physicalType == parquet::Type::INT32 &&
+        (eArrowTypeId == arrow::Type::INT8 ||
+         eArrowTypeId == arrow::Type::UINT8 ||
+         eArrowTypeId == arrow::Type::INT16 ||
+         eArrowTypeId == arrow::Type::UINT16 ||
+         eArrowTypeId == arrow::Type::INT32))
+    {
+        return poBloomFilter->FindHash(poBloomFilter->Hash(
+            static_cast<int32_t>(constraint.sValue.Integer)));
+    }
+    if (constraint.eType == OGRArrowLayer::Constraint::Type::Integer64 &&
+        physicalType == parquet::Type::INT64 &&
+        eArrowTypeId == arrow::Type::INT64)
+    {
+        return poBloomFilter->FindHash(poBloomFilter->Hash(
+            static_cast<int64_t>(constraint.sValue.Integer64)));
+    }
+    // Skip zero, since -0.0 and 0.0 compare equal, but hash differently
+    if (constraint.eType == OGRArrowLayer::Constraint::Type::Real &&
+        constraint.sValue.Real != 0 && !std::isnan(constraint.sValue.Real))
+    {
+        if (physicalType == parquet::Type::DOUBLE &&
+            eArrowTypeId == arrow::Type::DOUBLE)
+        {
+            return poBloomFilter->FindHash(
+                poBloomFilter->Hash(constraint.sValue.Real));
+        }
+        if (physicalType == parquet::Type::FLOAT &&
+            eArrowTypeId == arrow::Type::FLOAT)
+        {
+            const float fValue = static_cast<float>(constraint.sValue.Real);
+            if (static_cast<double>(fValue) == constraint.sValue.Real)
+                return poBloomFilter->FindHash(poBloomFilter->Hash(fValue));
+            // Value not representable as a float32
+            return false;
+        }
+    }
+    if (constraint.eType == OGRArrowLayer::Constraint::Type::String &&
+        physicalType == parquet::Type::BYTE_ARRAY &&
+        (eArrowTypeId == arrow::Type::STRING ||
+         eArrowTypeId == arrow::Type::LARGE_STRING))
+    {
+        const parquet::ByteArray oValue(
+            static_cast<uint32_t>(strlen(constraint.sValue.String)),
+            reinterpret_cast<const uint8_t *>(constraint.sValue.String));
+        return poBloomFilter->FindHash(poBloomFilter->Hash(&oValue));
+    }
+#else
+    CPL_IGNORE_RET_VAL(iRowGroup);
+    CPL_IGNORE_RET_VAL(iOGRField);
+    CPL_IGNORE_RET_VAL(constraint);
+#endif
+    return true;
+}
+
+/************************************************************************/
+/*                          MayContainNulls()                           */
+/************************************************************************/
+
+// Return false if the statistics of the column of the field (or FID) in the
+// row group prove that it has no null value.
+bool OGRParquetLayer::MayContainNulls(int iRowGroup, int iField) const
+{
+    const int iOGRField = iField == m_poFeatureDefn->GetFieldCount() + SPF_FID
+                              ? OGR_FID_INDEX
+                              : iField;
+    if (iOGRField == OGR_FID_INDEX && m_iFIDParquetColumn < 0)
+        return false;
+    const int iCol = iOGRField == OGR_FID_INDEX
+                         ? m_iFIDParquetColumn
+                         : GetMapFieldIndexToParquetColumn()[iOGRField];
+    if (iCol < 0)
+        return true;
+#if PARQUET_VERSION_MAJOR >= 7
+    const auto rowGroupColumnChunk = m_poArrowReader->parquet_reader()
+                                         ->metadata()
+                                         ->RowGroup(iRowGroup)
+                                         ->ColumnChunk(iCol);
+    const auto rowGroupStats = rowGroupColumnChunk->statistics();
+    if (rowGroupColumnChunk->is_stats_set() && rowGroupStats &&
+        rowGroupStats->HasNullCount())
+    {
+        return rowGroupStats->null_count() != 0;
+    }
+#else
+    CPL_IGNORE_RET_VAL(iRowGroup);
+#endif
+    return true;
+}
+
+/************************************************************************/
+/*                       BuildConstraintFromExpr()                      */
+/************************************************************************/
+
+bool OGRParquetLayer::BuildConstraintFromExpr(const swq_expr_node *poColumn,
+                                              const swq_expr_node *poValue,
+                                              Constraint &constraint) const
+{
+    if (poColumn->eNodeType != SNT_COLUMN ||
+        poValue->eNodeType != SNT_CONSTANT || poValue->is_null)
+        return false;
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    const OGRFieldDefn oDummyFIDFieldDefn(m_osFIDColumn.c_str(), OFTInteger64);
+    const OGRFieldDefn *poFieldDefn = nullptr;
+    if (poColumn->field_index == nFieldCount + SPF_FID)
+        poFieldDefn = &oDummyFIDFieldDefn;
+    else if (poColumn->field_index >= 0 && poColumn->field_index < nFieldCount)
+        poFieldDefn = m_poFeatureDefn->GetFieldDefn(poColumn->field_index);
+    else
+        return false;
+
+    // Only accept constants whose type matches the field type, to avoid
+    // lossy conversions (e.g. "int_field < 1.5" must not be turned into
+    // "int_field < 1")
+    switch (poFieldDefn->GetType())
+    {
+        case OFTInteger:
+            if (poValue->field_type != SWQ_INTEGER ||
+                poValue->int_value < INT_MIN || poValue->int_value > INT_MAX)
+                return false;
+            break;
+        case OFTInteger64:
+            if (poValue->field_type != SWQ_INTEGER &&
+                poValue->field_type != SWQ_INTEGER64)
+                return false;
+            break;
+        case OFTReal:
+            // Integer constants compared to a real field are promoted to
+            // SWQ_FLOAT by the SQL engine
+            if (poValue->field_type != SWQ_FLOAT)
+                return false;
+            break;
+        case OFTString:
+            if (poValue->field_type != SWQ_STRING)
+                return false;
+            break;
+        default:
+            return false;
+    }
+
+    constraint.iField = poColumn->field_index;
+    return FillTargetValueFromSrcExpr(poFieldDefn, &constraint, poValue);
+}
+
+/************************************************************************/
+/*                      IsExprPossibleForRowGroup()                     */
+/************************************************************************/
+
+// Evaluate whether the attribute filter expression (or its negation if
+// bNegate is true) may be true for at least one feature of a row group,
+// given its statistics. Unknown or unhandled sub-expressions are assumed to
+// be possibly true.
+// Negation is pushed down to the leaves, which is only valid for columns
+// without nulls: with OGR SQL semantics, "NOT (i > 5 AND s = 'x')" is true
+// when s is null, whereas "i <= 5 OR s <> 'x'" is not.
+IsConstraintPossibleRes OGRParquetLayer::IsExprPossibleForRowGroup(
+    int iRowGroup, int64_t nFeatureIdxTotal, const swq_expr_node *poNode,
+    bool bNegate) const
+{
+    if (poNode->eNodeType != SNT_OPERATION)
+        return IsConstraintPossibleRes::UNKNOWN;
+
+    const int nOp = poNode->nOperation;
+    const int nSubExprCount = poNode->nSubExprCount;
+
+    // Combine the results of sub-expressions with AND (bAnd == true) or OR
+    const auto Combine =
+        [](bool bAnd, const std::vector<IsConstraintPossibleRes> &aRes)
+    {
+        const auto eAbsorbing =
+            bAnd ? IsConstraintPossibleRes::NO : IsConstraintPossibleRes::YES;
+        bool bUnknown = false;
+        for (const auto res : aRes)
+        {
+            if (res == eAbsorbing)
+                return res;
+            if (res == IsConstraintPossibleRes::UNKNOWN)
+                bUnknown = true;
+        }
+        if (bUnknown)
+            return IsConstraintPossibleRes::UNKNOWN;
+        return bAnd ? IsConstraintPossibleRes::YES
+                    : IsConstraintPossibleRes::NO;
+    };
+
+    if ((nOp == SWQ_AND || nOp == SWQ_OR) && nSubExprCount >= 1)
+    {
+        // NOT (A AND B) is NOT A OR NOT B, and NOT (A OR B) is
+        // NOT A AND NOT B
+        const bool bAnd = (nOp == SWQ_AND) != bNegate;
+        std::vector<IsConstraintPossibleRes> aRes;
+        for (int i = 0; i < nSubExprCount; ++i)
+        {
+            aRes.push_back(IsExprPossibleForRowGroup(
+                iRowGroup, nFeatureIdxTotal, poNode->papoSubExpr[i], bNegate));
+            if (bAnd && aRes.back() == IsConstraintPossibleRes::NO)
+                break;
+        }
+        return Combine(bAnd, aRes);
+    }
+
+    if (nOp == SWQ_NOT && nSubExprCount == 1)
+    {
+        return IsExprPossibleForRowGroup(iRowGroup, nFeatureIdxTotal,
+                                         poNode->papoSubExpr[0], !bNegate);
+    }
+
+    if (IsComparisonOp(nOp) && nSubExprCount == 2)
+    {
+        const swq_expr_node *poColumn = GetColumnSubNode(poNode);
+        const swq_expr_node *poValue = GetConstantSubNode(poNode);
+        Constraint constraint;
+        if (poColumn == nullptr || poValue == nullptr ||
+            !BuildConstraintFromExpr(poColumn, poValue, constraint))
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+
+        int nConstraintOp = nOp;
+        if (poColumn != poNode->papoSubExpr[0])
+        {
+            // "constant op column": reverse the operator
+            if (nOp == SWQ_LT)
+                nConstraintOp = SWQ_GT;
+            else if (nOp == SWQ_LE)
+                nConstraintOp = SWQ_GE;
+            else if (nOp == SWQ_GT)
+                nConstraintOp = SWQ_LT;
+            else if (nOp == SWQ_GE)
+                nConstraintOp = SWQ_LE;
+        }
+        if (bNegate)
+        {
+            if (MayContainNulls(iRowGroup, constraint.iField))
+                return IsConstraintPossibleRes::UNKNOWN;
+
+            switch (nConstraintOp)
+            {
+                case SWQ_EQ:
+                    nConstraintOp = SWQ_NE;
+                    break;
+                case SWQ_NE:
+                    nConstraintOp = SWQ_EQ;
+                    break;
+                case SWQ_LT:
+                    nConstraintOp = SWQ_GE;
+                    break;
+                case SWQ_LE:
+                    nConstraintOp = SWQ_GT;
+                    break;
+                case SWQ_GT:
+                    nConstraintOp = SWQ_LE;
+                    break;
+                case SWQ_GE:
+                    nConstraintOp = SWQ_LT;
+                    break;
+                default:
+                    break;
+            }
+        }
+        constraint.nOperation = nConstraintOp;
+        return IsConstraintPossibleForRowGroup(iRowGroup, nFeatureIdxTotal,
+                                               constraint);
+    }
+
+    if (nOp == SWQ_IN && nSubExprCount >= 2)
+    {
+        // "x IN (a, b)" is "x = a OR x = b", and "NOT (x IN (a, b))" is
+        // "x <> a AND x <> b"
+        std::vector<IsConstraintPossibleRes> aRes;
+        for (int i = 1; i < nSubExprCount; ++i)
+        {
+            Constraint constraint;
+            if (!BuildConstraintFromExpr(poNode->papoSubExpr[0],
+                                         poNode->papoSubExpr[i], constraint) ||
+                (bNegate && MayContainNulls(iRowGroup, constraint.iField)))
+            {
+                return IsConstraintPossibleRes::UNKNOWN;
+            }
+            constraint.nOperation = bNegate ? SWQ_NE : SWQ_EQ;
+            aRes.push_back(IsConstraintPossibleForRowGroup(
+                iRowGroup, nFeatureIdxTotal, constraint));
+            if (!bNegate && aRes.back() != IsConstraintPossibleRes::NO)
+                break;
+        }
+        return Combine(bNegate, aRes);
+    }
+
+    if (nOp == SWQ_BETWEEN && nSubExprCount == 3 && !bNegate)
+    {
+        Constraint constraintMin;
+        Constraint constraintMax;
+        if (!BuildConstraintFromExpr(poNode->papoSubExpr[0],
+                                     poNode->papoSubExpr[1], constraintMin) ||
+            !BuildConstraintFromExpr(poNode->papoSubExpr[0],
+                                     poNode->papoSubExpr[2], constraintMax))
+        {
+            return IsConstraintPossibleRes::UNKNOWN;
+        }
+        constraintMin.nOperation = SWQ_GE;
+        constraintMax.nOperation = SWQ_LE;
+        return Combine(true, {IsConstraintPossibleForRowGroup(
+                                  iRowGroup, nFeatureIdxTotal, constraintMin),
+                              IsConstraintPossibleForRowGroup(
+                                  iRowGroup, nFeatureIdxTotal, constraintMax)});
+    }
+
+    if (nOp == SWQ_ISNULL && nSubExprCount == 1)
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        if (poColumn->eNodeType == SNT_COLUMN && poColumn->field_index >= 0 &&
+            poColumn->field_index < m_poFeatureDefn->GetFieldCount())
+        {
+            Constraint constraint;
+            constraint.iField = poColumn->field_index;
+            constraint.nOperation = bNegate ? SWQ_ISNOTNULL : SWQ_ISNULL;
+            return IsConstraintPossibleForRowGroup(iRowGroup, nFeatureIdxTotal,
+                                                   constraint);
+        }
+    }
+
+    // "x LIKE 'prefix%'": no value of the row group starts with the prefix
+    // if max < prefix, or if min > prefix and does not start with it.
+    // This does not apply when LIKE is evaluated as case-insensitive.
+    if (nOp == SWQ_LIKE && nSubExprCount == 2 && !bNegate &&
+        !CPLTestBool(CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE", "FALSE")) &&
+        poNode->papoSubExpr[0]->eNodeType == SNT_COLUMN &&
+        poNode->papoSubExpr[1]->eNodeType == SNT_CONSTANT &&
+        poNode->papoSubExpr[1]->field_type == SWQ_STRING &&
+        !poNode->papoSubExpr[1]->is_null)
+    {
+        const int iOGRField = poNode->papoSubExpr[0]->field_index;
+        const char *pszPattern = poNode->papoSubExpr[1]->string_value;
+        const std::string osPrefix(pszPattern, strcspn(pszPattern, "%_"));
+        if (iOGRField >= 0 && iOGRField < m_poFeatureDefn->GetFieldCount() &&
+            m_poFeatureDefn->GetFieldDefn(iOGRField)->GetType() ==
+                OFTString &&
+            !osPrefix.empty())
+        {
+            OGRField sMin;
+            OGRField sMax;
+            bool bFoundMin = false;
+            bool bFoundMax = false;
+            OGRFieldType eType = OFTMaxType;
+            OGRFieldSubType eSubType = OFSTNone;
+            std::string osMinTmp, osMaxTmp;
+            if (GetMinMaxForOGRField(iRowGroup, iOGRField, true, sMin,
+                                     bFoundMin, true, sMax, bFoundMax, eType,
+                                     eSubType, osMinTmp, osMaxTmp) &&
+                bFoundMin && bFoundMax && eType == OFTString)
+            {
+                if (osMaxTmp < osPrefix ||
+                    (osMinTmp > osPrefix &&
+                     !cpl::starts_with(osMinTmp, osPrefix)))
+                {
+                    return IsConstraintPossibleRes::NO;
+                }
+                return IsConstraintPossibleRes::YES;
+            }
+        }
+    }
+
+    return IsConstraintPossibleRes::UNKNOWN;
+}
+
 /************************************************************************/
 /*                           IncrFeatureIdx()                           */
 /************************************************************************/
@@ -1906,7 +2444,22 @@ bool OGRParquetLayer::ReadNextBatch()
                  1 &&
              m_anMapGeomFieldIndexToParquetColumns[m_iGeomFieldFilter][0] >= 0);
 #endif
-        if (m_asAttributeFilterConstraints.empty() && !bUSEBBOXFields &&
+        // The whole attribute filter expression is evaluated against the
+        // statistics of each row group, which handles OR, IN, NOT and
+        // LIKE 'prefix%', beyond the AND-ed constraints
+        // of m_asAttributeFilterConstraints.
+        const swq_expr_node *poAttrFilterNode = nullptr;
+        if (m_poAttrQuery &&
+            CPLTestBool(CPLGetConfigOption(
+                ("OGR_" + GetDriverUCName() + "_OPTIMIZED_ATTRIBUTE_FILTER")
+                    .c_str(),
+                "YES")))
+        {
+            poAttrFilterNode =
+                static_cast<const swq_expr_node *>(m_poAttrQuery->GetSWQExpr());
+        }
+
+        if (poAttrFilterNode == nullptr && !bUSEBBOXFields &&
             !(bIsGeoArrowStruct && m_poFilterGeom)
 #if PARQUET_VERSION_MAJOR >= 21
             && !bUseParquetGeoStat
@@ -2075,176 +2628,12 @@ bool OGRParquetLayer::ReadNextBatch()
                 }
 #endif
 
-                if (bSelectGroup)
+                if (bSelectGroup && poAttrFilterNode &&
+                    IsExprPossibleForRowGroup(iRowGroup, nFeatureIdxTotal,
+                                              poAttrFilterNode, false) ==
+                        IsConstraintPossibleRes::NO)
                 {
-                    for (auto &constraint : m_asAttributeFilterConstraints)
-                    {
-                        int iOGRField = constraint.iField;
-                        if (constraint.iField ==
-                            m_poFeatureDefn->GetFieldCount() + SPF_FID)
-                        {
-                            iOGRField = OGR_FID_INDEX;
-                        }
-                        if (constraint.nOperation != SWQ_ISNULL &&
-                            constraint.nOperation != SWQ_ISNOTNULL)
-                        {
-                            if (iOGRField == OGR_FID_INDEX &&
-                                m_iFIDParquetColumn < 0)
-                            {
-                                sMin.Integer64 = nFeatureIdxTotal;
-                                sMax.Integer64 =
-                                    nFeatureIdxTotal +
-                                    poRowGroup->metadata()->num_rows() - 1;
-                                eType = OFTInteger64;
-                            }
-                            else if (!GetMinMaxForOGRField(
-                                         iRowGroup, iOGRField, true, sMin,
-                                         bFoundMin, true, sMax, bFoundMax,
-                                         eType, eSubType, osMinTmp, osMaxTmp) ||
-                                     !bFoundMin || !bFoundMax)
-                            {
-                                bIterateEverything = true;
-                                break;
-                            }
-                        }
-
-                        IsConstraintPossibleRes res =
-                            IsConstraintPossibleRes::UNKNOWN;
-                        if (constraint.eType ==
-                                OGRArrowLayer::Constraint::Type::Integer &&
-                            eType == OFTInteger)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = %d, max = %d",
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     sMin.Integer, sMax.Integer);
-#endif
-                            res = IsConstraintPossible(
-                                constraint.nOperation,
-                                constraint.sValue.Integer, sMin.Integer,
-                                sMax.Integer);
-                        }
-                        else if (constraint.eType == OGRArrowLayer::Constraint::
-                                                         Type::Integer64 &&
-                                 eType == OFTInteger64)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = " CPL_FRMT_GIB
-                                     ", max = " CPL_FRMT_GIB,
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     static_cast<GIntBig>(sMin.Integer64),
-                                     static_cast<GIntBig>(sMax.Integer64));
-#endif
-                            res = IsConstraintPossible(
-                                constraint.nOperation,
-                                constraint.sValue.Integer64, sMin.Integer64,
-                                sMax.Integer64);
-                        }
-                        else if (constraint.eType ==
-                                     OGRArrowLayer::Constraint::Type::Real &&
-                                 eType == OFTReal)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = %g, max = %g",
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     sMin.Real, sMax.Real);
-#endif
-                            res = IsConstraintPossible(constraint.nOperation,
-                                                       constraint.sValue.Real,
-                                                       sMin.Real, sMax.Real);
-                        }
-                        else if (constraint.eType ==
-                                     OGRArrowLayer::Constraint::Type::String &&
-                                 eType == OFTString)
-                        {
-#if 0
-                            CPLDebug("PARQUET",
-                                     "Group %d, field %s, min = %s, max = %s",
-                                     iRowGroup,
-                                     iOGRField == OGR_FID_INDEX
-                                         ? m_osFIDColumn.c_str()
-                                         : m_poFeatureDefn->GetFieldDefn(iOGRField)
-                                               ->GetNameRef(),
-                                     sMin.String, sMax.String);
-#endif
-                            res = IsConstraintPossible(
-                                constraint.nOperation,
-                                std::string(constraint.sValue.String),
-                                std::string(sMin.String),
-                                std::string(sMax.String));
-                        }
-                        else if (constraint.nOperation == SWQ_ISNULL ||
-                                 constraint.nOperation == SWQ_ISNOTNULL)
-                        {
-                            const int iCol =
-                                iOGRField == OGR_FID_INDEX
-                                    ? m_iFIDParquetColumn
-                                    : GetMapFieldIndexToParquetColumn()
-                                          [iOGRField];
-                            if (iCol >= 0)
-                            {
-                                const auto metadata =
-                                    m_poArrowReader->parquet_reader()
-                                        ->metadata();
-                                const auto rowGroupColumnChunk =
-                                    metadata->RowGroup(iRowGroup)->ColumnChunk(
-                                        iCol);
-                                const auto rowGroupStats =
-                                    rowGroupColumnChunk->statistics();
-                                if (rowGroupColumnChunk->is_stats_set() &&
-                                    rowGroupStats)
-                                {
-                                    res = IsConstraintPossibleRes::YES;
-                                    if (constraint.nOperation == SWQ_ISNULL &&
-                                        rowGroupStats->num_values() ==
-                                            poRowGroup->metadata()->num_rows())
-                                    {
-                                        res = IsConstraintPossibleRes::NO;
-                                    }
-                                    else if (constraint.nOperation ==
-                                                 SWQ_ISNOTNULL &&
-                                             rowGroupStats->num_values() == 0)
-                                    {
-                                        res = IsConstraintPossibleRes::NO;
-                                    }
-                                }
-                            }
-                        }
-                        else
-                        {
-                            CPLDebug(
-                                "PARQUET",
-                                "Unhandled combination of constraint.eType "
-                                "(%d) and eType (%d)",
-                                static_cast<int>(constraint.eType), eType);
-                        }
-
-                        if (res == IsConstraintPossibleRes::NO)
-                        {
-                            bSelectGroup = false;
-                            break;
-                        }
-                        else if (res == IsConstraintPossibleRes::UNKNOWN)
-                        {
-                            bIterateEverything = true;
-                            break;
-                        }
-                    }
+                    bSelectGroup = false;
                 }
 
                 if (bSelectGroup)
@@ -2258,6 +2647,15 @@ bool OGRParquetLayer::ReadNextBatch()
 
                 nFeatureIdxTotal += poRowGroup->metadata()->num_rows();
             }
+#if PARQUET_VERSION_MAJOR >= 13
+            m_oMapBloomFilters.clear();
+#endif
+
+            if (!bIterateEverything &&
+                static_cast<int>(anSelectedGroups.size()) == nNumGroups)
+            {
+                bIterateEverything = true;
+            }
         }
 
         if (bIterateEverything)
@@ -2270,13 +2668,13 @@ bool OGRParquetLayer::ReadNextBatch()
         else
         {
             m_oFeatureIdxRemappingIter = m_asFeatureIdxRemapping.begin();
+            CPLDebug("PARQUET", "%d/%d row groups selected",
+                     int(anSelectedGroups.size()),
+                     m_poArrowReader->num_row_groups());
             if (anSelectedGroups.empty())
             {
                 return false;
             }
-            CPLDebug("PARQUET", "%d/%d row groups selected",
-                     int(anSelectedGroups.size()),
-                     m_poArrowReader->num_row_groups());
             m_nFeatureIdx = m_oFeatureIdxRemappingIter->second;
             ++m_oFeatureIdxRemappingIter;
             if (!CreateRecordBatchReader(anSelectedGroups))
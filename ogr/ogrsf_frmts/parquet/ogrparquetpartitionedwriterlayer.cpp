@@ -0,0 +1,739 @@
+/******************************************************************************
+ *
+ * Project:  Parquet Translator
+ * Purpose:  Implements OGRParquetPartitionedWriterLayer.
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "ogr_parquet.h"
+
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include "../arrow_common/ograrrowwriterlayer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Value of a partition key for null values, as understood by Arrow (and
+// other Hive-partitioning readers)
+constexpr const char *HIVE_DEFAULT_PARTITION = "__HIVE_DEFAULT_PARTITION__";
+
+// Number of features of a partition written by a single job
+constexpr size_t FEATURES_PER_JOB = 1000;
+
+/************************************************************************/
+/*                       EncodePartitionValue()                         */
+/************************************************************************/
+
+// Percent-encode characters that are not safe in a path component. This is
+// reversed by the URI segment decoding of Arrow HivePartitioning.
+static std::string EncodePartitionValue(const char *pszValue)
+{
+    std::string osRet;
+    for (const char *pszIter = pszValue; *pszIter; ++pszIter)
+    {
+        const unsigned char ch = static_cast<unsigned char>(*pszIter);
+        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+            (ch >= '0' && ch <= '9') || ch == '-' || ch == '_' || ch == '.' ||
+            ch == '~' || ch >= 0x80)
+        {
+            osRet += static_cast<char>(ch);
+        }
+        else
+        {
+            osRet += CPLSPrintf("%%%02X", ch);
+        }
+    }
+    return osRet;
+}
+
+/************************************************************************/
+/*                  OGRParquetPartitionedWriterLayer()                  */
+/************************************************************************/
+
+OGRParquetPartitionedWriterLayer::OGRParquetPartitionedWriterLayer(
+    OGRParquetWriterDataset *poDS, const char *pszLayerName,
+    const std::string &osDirectory)
+    : m_poDataset(poDS), m_osDirectory(osDirectory),
+      m_poTemplateLayer(std::make_unique<OGRParquetWriterLayer>(
+          poDS, poDS->GetMemoryPool(), nullptr, pszLayerName))
+{
+    SetDescription(pszLayerName);
+}
+
+/************************************************************************/
+/*                 ~OGRParquetPartitionedWriterLayer()                  */
+/************************************************************************/
+
+OGRParquetPartitionedWriterLayer::~OGRParquetPartitionedWriterLayer()
+{
+    OGRParquetPartitionedWriterLayer::Close();
+}
+
+/************************************************************************/
+/*                             SetOptions()                             */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::SetOptions(
+    CSLConstList papszOptions, const OGRSpatialReference *poSpatialRef,
+    OGRwkbGeometryType eGType)
+{
+    const char *pszPartitionBy =
+        CSLFetchNameValue(papszOptions, "PARTITION_BY");
+    if (pszPartitionBy)
+    {
+        const CPLStringList aosFields(CSLTokenizeString2(
+            pszPartitionBy, ",",
+            CSLT_HONOURSTRINGS | CSLT_STRIPLEADSPACES | CSLT_STRIPENDSPACES));
+        for (const char *pszField : aosFields)
+            m_aosPartitionFields.push_back(pszField);
+    }
+
+    const char *pszGridSize =
+        CSLFetchNameValue(papszOptions, "PARTITION_GRID_SIZE");
+    if (pszGridSize)
+    {
+        m_dfGridSize = CPLAtof(pszGridSize);
+        if (!(m_dfGridSize > 0) || !std::isfinite(m_dfGridSize))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "Invalid value for PARTITION_GRID_SIZE: %s", pszGridSize);
+            return false;
+        }
+        if (eGType == wkbNone)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "PARTITION_GRID_SIZE requires a geometry column");
+            return false;
+        }
+    }
+
+    if (m_aosPartitionFields.empty() && m_dfGridSize == 0)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "PARTITION_BY should list at least one field");
+        return false;
+    }
+
+    m_nMaxOpenFiles = std::max(
+        1, atoi(CSLFetchNameValueDef(papszOptions, "MAX_OPEN_FILES", "256")));
+    m_bWriteMetadataFile = CPLTestBool(
+        CSLFetchNameValueDef(papszOptions, "WRITE_METADATA_FILE", "YES"));
+
+    // Options passed to the layer of each file
+    m_aosOptions = CSLDuplicate(papszOptions);
+    for (const char *pszKey : {"PARTITION_BY", "PARTITION_GRID_SIZE",
+                               "MAX_OPEN_FILES", "WRITE_METADATA_FILE"})
+    {
+        m_aosOptions.SetNameValue(pszKey, nullptr);
+    }
+    m_bCreatedWithGeomField = eGType != wkbNone;
+
+    if (!m_poTemplateLayer->SetOptions(m_aosOptions.List(), poSpatialRef,
+                                       eGType))
+    {
+        return false;
+    }
+
+    const int nThreads =
+        GDALGetNumThreads(nullptr, nullptr, "OGR_PARQUET_NUM_THREADS",
+                          std::min(4, CPLGetNumCPUs()));
+    if (nThreads > 1)
+        m_poThreadPool = GDALGetGlobalThreadPool(nThreads);
+
+    return true;
+}
+
+/************************************************************************/
+/*                          TestCapability()                            */
+/************************************************************************/
+
+int OGRParquetPartitionedWriterLayer::TestCapability(const char *pszCap)
+{
+    if (EQUAL(pszCap, OLCCreateField) || EQUAL(pszCap, OLCCreateGeomField))
+        return m_bFirstFeature;
+
+    if (EQUAL(pszCap, OLCSequentialWrite) || EQUAL(pszCap, OLCStringsAsUTF8) ||
+        EQUAL(pszCap, OLCMeasuredGeometries))
+    {
+        return m_poTemplateLayer->TestCapability(pszCap);
+    }
+
+    return false;
+}
+
+/************************************************************************/
+/*                            CreateField()                             */
+/************************************************************************/
+
+OGRErr OGRParquetPartitionedWriterLayer::CreateField(
+    const OGRFieldDefn *poField, int bApproxOK)
+{
+    if (!m_bFirstFeature)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cannot add field after a first feature has been written");
+        return OGRERR_FAILURE;
+    }
+    return m_poTemplateLayer->CreateField(poField, bApproxOK);
+}
+
+/************************************************************************/
+/*                          CreateGeomField()                           */
+/************************************************************************/
+
+OGRErr OGRParquetPartitionedWriterLayer::CreateGeomField(
+    const OGRGeomFieldDefn *poField, int bApproxOK)
+{
+    if (!m_bFirstFeature)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cannot add field after a first feature has been written");
+        return OGRERR_FAILURE;
+    }
+    return m_poTemplateLayer->CreateGeomField(poField, bApproxOK);
+}
+
+/************************************************************************/
+/*                          AddFieldDomain()                            */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::AddFieldDomain(
+    std::unique_ptr<OGRFieldDomain> &&domain, std::string &failureReason)
+{
+    return m_poTemplateLayer->AddFieldDomain(std::move(domain), failureReason);
+}
+
+/************************************************************************/
+/*                        GetFieldDomainNames()                         */
+/************************************************************************/
+
+std::vector<std::string>
+OGRParquetPartitionedWriterLayer::GetFieldDomainNames() const
+{
+    return m_poTemplateLayer->GetFieldDomainNames();
+}
+
+/************************************************************************/
+/*                          GetFieldDomain()                            */
+/************************************************************************/
+
+const OGRFieldDomain *
+OGRParquetPartitionedWriterLayer::GetFieldDomain(const std::string &name) const
+{
+    return m_poTemplateLayer->GetFieldDomain(name);
+}
+
+/************************************************************************/
+/*                             GetDataset()                             */
+/************************************************************************/
+
+GDALDataset *OGRParquetPartitionedWriterLayer::GetDataset()
+{
+    return m_poDataset;
+}
+
+/************************************************************************/
+/*                       ResolvePartitionFields()                       */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::ResolvePartitionFields()
+{
+    const OGRFeatureDefn *poDefn = m_poTemplateLayer->GetLayerDefn();
+    for (const std::string &osField : m_aosPartitionFields)
+    {
+        const int iField = poDefn->GetFieldIndex(osField.c_str());
+        if (iField < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "PARTITION_BY field %s does not exist", osField.c_str());
+            return false;
+        }
+        const auto eType = poDefn->GetFieldDefn(iField)->GetType();
+        if (eType != OFTInteger && eType != OFTInteger64 &&
+            eType != OFTReal && eType != OFTString && eType != OFTDate &&
+            eType != OFTDateTime)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Field %s of type %s cannot be used in PARTITION_BY",
+                     osField.c_str(), OGRFieldDefn::GetFieldTypeName(eType));
+            return false;
+        }
+        m_anPartitionFieldIdx.push_back(iField);
+    }
+
+    if (m_dfGridSize > 0)
+    {
+        for (const char *pszName : {"grid_x", "grid_y"})
+        {
+            if (poDefn->GetFieldIndex(pszName) >= 0)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Field %s conflicts with the partition key of "
+                         "PARTITION_GRID_SIZE",
+                         pszName);
+                return false;
+            }
+        }
+    }
+
+    // Partition fields are not written in the files, since their value
+    // is encoded in the directory name
+    m_anFieldMap.resize(poDefn->GetFieldCount());
+    int iDstField = 0;
+    for (int i = 0; i < poDefn->GetFieldCount(); ++i)
+    {
+        if (std::find(m_anPartitionFieldIdx.begin(),
+                      m_anPartitionFieldIdx.end(),
+                      i) != m_anPartitionFieldIdx.end())
+        {
+            m_anFieldMap[i] = -1;
+        }
+        else
+        {
+            m_anFieldMap[i] = iDstField++;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       GetPartitionDirectory()                        */
+/************************************************************************/
+
+// Return the directory, relative to the dataset directory, of the partition
+// of the feature, e.g. "country=FR/grid_x=3/grid_y=-2"
+std::string
+OGRParquetPartitionedWriterLayer::GetPartitionDirectory(
+    OGRFeature *poFeature) const
+{
+    std::string osDir;
+    for (int iField : m_anPartitionFieldIdx)
+    {
+        if (!osDir.empty())
+            osDir += '/';
+        osDir += EncodePartitionValue(
+            poFeature->GetFieldDefnRef(iField)->GetNameRef());
+        osDir += '=';
+        const char *pszValue = poFeature->IsFieldSetAndNotNull(iField)
+                                   ? poFeature->GetFieldAsString(iField)
+                                   : "";
+        if (pszValue[0] == 0)
+            osDir += HIVE_DEFAULT_PARTITION;
+        else
+            osDir += EncodePartitionValue(pszValue);
+    }
+
+    if (m_dfGridSize > 0)
+    {
+        std::string osX(HIVE_DEFAULT_PARTITION);
+        std::string osY(HIVE_DEFAULT_PARTITION);
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(0);
+        if (poGeom && !poGeom->IsEmpty())
+        {
+            OGREnvelope sEnvelope;
+            poGeom->getEnvelope(&sEnvelope);
+            const double dfX = std::floor(
+                (sEnvelope.MinX + sEnvelope.MaxX) / 2 / m_dfGridSize);
+            const double dfY = std::floor(
+                (sEnvelope.MinY + sEnvelope.MaxY) / 2 / m_dfGridSize);
+            constexpr double MAX_CELL = 1e15;
+            if (std::fabs(dfX) < MAX_CELL && std::fabs(dfY) < MAX_CELL)
+            {
+                osX = std::to_string(static_cast<int64_t>(dfX));
+                osY = std::to_string(static_cast<int64_t>(dfY));
+            }
+        }
+        if (!osDir.empty())
+            osDir += '/';
+        osDir += "grid_x=";
+        osDir += osX;
+        osDir += "/grid_y=";
+        osDir += osY;
+    }
+
+    return osDir;
+}
+
+/************************************************************************/
+/*                         OpenPartitionFile()                          */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::OpenPartitionFile(Partition &oPartition)
+{
+    // Close the least recently used file if too many files are open
+    if (m_nOpenFiles >= m_nMaxOpenFiles)
+    {
+        Partition *poLRU = nullptr;
+        for (auto &[osKey, poOther] : m_oMapPartitions)
+        {
+            if (poOther->poDS &&
+                (poLRU == nullptr || poOther->nLastUse < poLRU->nLastUse))
+            {
+                poLRU = poOther.get();
+            }
+        }
+        if (poLRU && !SubmitClosePartitionFile(*poLRU))
+            return false;
+    }
+
+    if (oPartition.nFileCounter == 0)
+    {
+        const std::string osPartitionDir = CPLFormFilenameSafe(
+            m_osDirectory.c_str(), oPartition.osDirectory.c_str(), nullptr);
+        if (VSIMkdirRecursive(osPartitionDir.c_str(), 0755) != 0)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create directory %s",
+                     osPartitionDir.c_str());
+            return false;
+        }
+    }
+
+    oPartition.osCurFilename = oPartition.osDirectory;
+    oPartition.osCurFilename += "/part-";
+    oPartition.osCurFilename += std::to_string(oPartition.nFileCounter);
+    oPartition.osCurFilename += ".parquet";
+    ++oPartition.nFileCounter;
+    const std::string osFilename = CPLFormFilenameSafe(
+        m_osDirectory.c_str(), oPartition.osCurFilename.c_str(), nullptr);
+
+    std::shared_ptr<arrow::io::OutputStream> poOutputStream;
+    try
+    {
+        poOutputStream =
+            OGRParquetWriterDataset::CreateOutputStream(osFilename.c_str());
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Parquet exception: %s",
+                 e.what());
+    }
+    if (!poOutputStream)
+        return false;
+
+    auto poDS = std::make_shared<OGRParquetWriterDataset>(poOutputStream);
+    poDS->SetDescription(osFilename.c_str());
+    {
+        auto &oSrcMDMD = m_poDataset->GetMultiDomainMetadata();
+        for (CSLConstList papszDomainIter = oSrcMDMD.GetDomainList();
+             papszDomainIter && *papszDomainIter; ++papszDomainIter)
+        {
+            poDS->GetMultiDomainMetadata().SetMetadata(
+                oSrcMDMD.GetMetadata(*papszDomainIter), *papszDomainIter);
+        }
+    }
+
+    // Create the layer of the file with the same definition as the template
+    // layer, except the partition fields.
+    const OGRFeatureDefn *poDefn = m_poTemplateLayer->GetLayerDefn();
+    const int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    const bool bFirstGeomField = m_bCreatedWithGeomField && nGeomFieldCount > 0;
+    auto poLayer = static_cast<OGRParquetWriterLayer *>(poDS->CreateLayer(
+        GetDescription(),
+        bFirstGeomField ? poDefn->GetGeomFieldDefn(0) : nullptr,
+        m_aosOptions.List()));
+    if (!poLayer)
+        return false;
+    for (int i = bFirstGeomField ? 1 : 0; i < nGeomFieldCount; ++i)
+    {
+        if (poLayer->CreateGeomField(poDefn->GetGeomFieldDefn(i)) !=
+            OGRERR_NONE)
+            return false;
+    }
+    for (const std::string &osDomainName :
+         m_poTemplateLayer->GetFieldDomainNames())
+    {
+        const auto poDomain = m_poTemplateLayer->GetFieldDomain(osDomainName);
+        std::string osFailureReason;
+        if (poDomain &&
+            !poDS->AddFieldDomain(
+                std::unique_ptr<OGRFieldDomain>(poDomain->Clone()),
+                osFailureReason))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     osFailureReason.c_str());
+            return false;
+        }
+    }
+    for (int i = 0; i < poDefn->GetFieldCount(); ++i)
+    {
+        if (m_anFieldMap[i] >= 0 &&
+            poLayer->CreateField(poDefn->GetFieldDefn(i)) != OGRERR_NONE)
+            return false;
+    }
+    {
+        const CPLStringList aosDomains(GetMetadataDomainList());
+        for (const char *pszDomain : aosDomains)
+            poLayer->SetMetadata(GetMetadata(pszDomain), pszDomain);
+    }
+
+    oPartition.poDS = std::move(poDS);
+    oPartition.poLayer = poLayer;
+    ++m_nOpenFiles;
+    return true;
+}
+
+/************************************************************************/
+/*                              RunJob()                                */
+/************************************************************************/
+
+// Run task in the job queue of the partition, or immediately if not using
+// multi-threading. WaitPartition() must have been called before.
+void OGRParquetPartitionedWriterLayer::RunJob(Partition &oPartition,
+                                              std::function<void()> task)
+{
+    if (!oPartition.poJobQueue)
+    {
+        task();
+        return;
+    }
+
+    oPartition.poErrorAccumulator = std::make_unique<CPLErrorAccumulator>();
+    auto poErrorAccumulator = oPartition.poErrorAccumulator.get();
+    oPartition.poJobQueue->SubmitJob(
+        [poErrorAccumulator, task = std::move(task)]()
+        {
+            auto oContext = poErrorAccumulator->InstallForCurrentScope();
+            task();
+        });
+}
+
+/************************************************************************/
+/*                           WaitPartition()                            */
+/************************************************************************/
+
+// Wait for the job of the partition to be finished, and replay its errors
+bool OGRParquetPartitionedWriterLayer::WaitPartition(Partition &oPartition)
+{
+    if (oPartition.poJobQueue)
+    {
+        oPartition.poJobQueue->WaitCompletion();
+        if (oPartition.poErrorAccumulator)
+        {
+            oPartition.poErrorAccumulator->ReplayErrors();
+            oPartition.poErrorAccumulator.reset();
+        }
+    }
+    return !m_bJobError;
+}
+
+/************************************************************************/
+/*                       SubmitPendingFeatures()                        */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::SubmitPendingFeatures(
+    Partition &oPartition)
+{
+    if (oPartition.apoPendingFeatures.empty())
+        return true;
+    if (!WaitPartition(oPartition))
+        return false;
+
+    auto papoFeatures =
+        std::make_shared<std::vector<std::unique_ptr<OGRFeature>>>(
+            std::move(oPartition.apoPendingFeatures));
+    oPartition.apoPendingFeatures.clear();
+    OGRParquetWriterLayer *poLayer = oPartition.poLayer;
+    RunJob(oPartition,
+           [this, poLayer, papoFeatures]()
+           {
+               for (auto &poFeature : *papoFeatures)
+               {
+                   if (m_bJobError ||
+                       poLayer->CreateFeature(poFeature.get()) != OGRERR_NONE)
+                   {
+                       m_bJobError = true;
+                       break;
+                   }
+                   poFeature.reset();
+               }
+           });
+    return !m_bJobError;
+}
+
+/************************************************************************/
+/*                      SubmitClosePartitionFile()                      */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::SubmitClosePartitionFile(
+    Partition &oPartition)
+{
+    if (!oPartition.poDS)
+        return true;
+
+    bool bOK = SubmitPendingFeatures(oPartition);
+    bOK = WaitPartition(oPartition) && bOK;
+
+    auto poDS = std::move(oPartition.poDS);
+    OGRParquetWriterLayer *poLayer = oPartition.poLayer;
+    oPartition.poLayer = nullptr;
+    --m_nOpenFiles;
+
+    const std::string osFilename = oPartition.osCurFilename;
+    RunJob(oPartition,
+           [this, poDS, poLayer, osFilename]()
+           {
+               if (poDS->Close() != CE_None)
+               {
+                   m_bJobError = true;
+                   return;
+               }
+               if (m_bWriteMetadataFile)
+               {
+                   auto poMetaData = poLayer->GetFileMetaData();
+                   if (poMetaData)
+                   {
+                       std::lock_guard oLock(m_oMutexFileMetaData);
+                       m_aoFileMetaData.emplace_back(osFilename,
+                                                     std::move(poMetaData));
+                   }
+               }
+           });
+    return bOK && !m_bJobError;
+}
+
+/************************************************************************/
+/*                          ICreateFeature()                            */
+/************************************************************************/
+
+OGRErr OGRParquetPartitionedWriterLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    if (m_bClosed)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Layer has been closed");
+        return OGRERR_FAILURE;
+    }
+    if (m_bFirstFeature)
+    {
+        if (!ResolvePartitionFields())
+            return OGRERR_FAILURE;
+        m_bFirstFeature = false;
+    }
+    if (m_bJobError)
+        return OGRERR_FAILURE;
+
+    const std::string osDirectory = GetPartitionDirectory(poFeature);
+    auto &poPartition = m_oMapPartitions[osDirectory];
+    if (!poPartition)
+    {
+        poPartition = std::make_unique<Partition>();
+        poPartition->osDirectory = osDirectory;
+        if (m_poThreadPool)
+            poPartition->poJobQueue = m_poThreadPool->CreateJobQueue();
+    }
+    Partition &oPartition = *poPartition;
+    if (!oPartition.poDS && !OpenPartitionFile(oPartition))
+        return OGRERR_FAILURE;
+    oPartition.nLastUse = ++m_nUseCounter;
+
+    // Assign FIDs at the dataset level, so that they are unique among files
+    const char *pszFIDColumn = m_poTemplateLayer->GetFIDColumn();
+    if (pszFIDColumn[0] && poFeature->GetFID() == OGRNullFID)
+        poFeature->SetFID(m_nFeatureCount);
+
+    auto poDstFeature =
+        std::make_unique<OGRFeature>(oPartition.poLayer->GetLayerDefn());
+    if (poDstFeature->SetFrom(poFeature, m_anFieldMap.data(),
+                              /* bForgiving = */ TRUE) != OGRERR_NONE)
+    {
+        return OGRERR_FAILURE;
+    }
+    poDstFeature->SetFID(poFeature->GetFID());
+    oPartition.apoPendingFeatures.push_back(std::move(poDstFeature));
+    ++m_nFeatureCount;
+
+    if (oPartition.apoPendingFeatures.size() >= FEATURES_PER_JOB &&
+        !SubmitPendingFeatures(oPartition))
+    {
+        return OGRERR_FAILURE;
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         WriteMetadataFile()                          */
+/************************************************************************/
+
+// Write a _metadata file with the footers of all files, which enables
+// readers to open the dataset without listing and opening each file.
+bool OGRParquetPartitionedWriterLayer::WriteMetadataFile()
+{
+    if (m_aoFileMetaData.empty())
+        return true;
+
+    std::sort(m_aoFileMetaData.begin(), m_aoFileMetaData.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    const std::string osFilename =
+        CPLFormFilenameSafe(m_osDirectory.c_str(), "_metadata", nullptr);
+    try
+    {
+        std::shared_ptr<parquet::FileMetaData> poMergedMetaData;
+        for (auto &[osPartFilename, poMetaData] : m_aoFileMetaData)
+        {
+            poMetaData->set_file_path(osPartFilename);
+            if (!poMergedMetaData)
+                poMergedMetaData = poMetaData;
+            else
+                poMergedMetaData->AppendRowGroups(*poMetaData);
+        }
+
+        auto poOutputStream =
+            OGRParquetWriterDataset::CreateOutputStream(osFilename.c_str());
+        if (!poOutputStream)
+            return false;
+        parquet::WriteMetaDataFile(*poMergedMetaData, poOutputStream.get());
+        PARQUET_THROW_NOT_OK(poOutputStream->Close());
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot write %s: %s",
+                 osFilename.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+bool OGRParquetPartitionedWriterLayer::Close()
+{
+    if (m_bClosed)
+        return true;
+    m_bClosed = true;
+
+    bool bOK = true;
+    // First submit the pending features of all partitions, so that they are
+    // written in parallel, and then close all files.
+    for (auto &[osKey, poPartition] : m_oMapPartitions)
+    {
+        if (!SubmitPendingFeatures(*poPartition))
+            bOK = false;
+    }
+    for (auto &[osKey, poPartition] : m_oMapPartitions)
+    {
+        if (!SubmitClosePartitionFile(*poPartition))
+            bOK = false;
+    }
+    for (auto &[osKey, poPartition] : m_oMapPartitions)
+    {
+        if (!WaitPartition(*poPartition))
+            bOK = false;
+    }
+    m_oMapPartitions.clear();
+
+    if (bOK && m_bWriteMetadataFile && !WriteMetadataFile())
+        bOK = false;
+    m_aoFileMetaData.clear();
+
+    return bOK;
+}
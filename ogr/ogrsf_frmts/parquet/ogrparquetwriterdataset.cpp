@@ -12,6 +12,7 @@
 
 #include "ogr_parquet.h"
 
+#include "../arrow_common/ograrrowwritablefile.h"
 #include "../arrow_common/ograrrowwriterlayer.hpp"
 
 /************************************************************************/
@@ -25,6 +26,34 @@ OGRParquetWriterDataset::OGRParquetWriterDataset(
 {
 }
 
+/************************************************************************/
+/*                        CreateOutputStream()                          */
+/************************************************************************/
+
+/* static */
+std::shared_ptr<arrow::io::OutputStream>
+OGRParquetWriterDataset::CreateOutputStream(const char *pszFilename)
+{
+    std::shared_ptr<arrow::io::OutputStream> out_file;
+    if (STARTS_WITH(pszFilename, "/vsi") ||
+        CPLTestBool(CPLGetConfigOption("OGR_PARQUET_USE_VSI", "YES")))
+    {
+        VSILFILE *fp = VSIFOpenL(pszFilename, "wb");
+        if (fp == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", pszFilename);
+            return nullptr;
+        }
+        out_file = std::make_shared<OGRArrowWritableFile>(fp);
+    }
+    else
+    {
+        PARQUET_ASSIGN_OR_THROW(out_file,
+                                arrow::io::FileOutputStream::Open(pszFilename));
+    }
+    return out_file;
+}
+
 /************************************************************************/
 /*                                Close()                               */
 /************************************************************************/
@@ -39,6 +68,11 @@ CPLErr OGRParquetWriterDataset::Close()
             eErr = CE_Failure;
         }
 
+        if (m_poPartitionedLayer && !m_poPartitionedLayer->Close())
+        {
+            eErr = CE_Failure;
+        }
+
         if (GDALPamDataset::Close() != CE_None)
         {
             eErr = CE_Failure;
@@ -54,7 +88,7 @@ CPLErr OGRParquetWriterDataset::Close()
 
 int OGRParquetWriterDataset::GetLayerCount()
 {
-    return m_poLayer ? 1 : 0;
+    return (m_poLayer || m_poPartitionedLayer) ? 1 : 0;
 }
 
 /************************************************************************/
@@ -63,7 +97,11 @@ int OGRParquetWriterDataset::GetLayerCount()
 
 OGRLayer *OGRParquetWriterDataset::GetLayer(int idx)
 {
-    return idx == 0 ? m_poLayer.get() : nullptr;
+    if (idx != 0)
+        return nullptr;
+    if (m_poPartitionedLayer)
+        return m_poPartitionedLayer.get();
+    return m_poLayer.get();
 }
 
 /************************************************************************/
@@ -73,9 +111,9 @@ OGRLayer *OGRParquetWriterDataset::GetLayer(int idx)
 int OGRParquetWriterDataset::TestCapability(const char *pszCap)
 {
     if (EQUAL(pszCap, ODsCCreateLayer))
-        return m_poLayer == nullptr;
+        return m_poLayer == nullptr && m_poPartitionedLayer == nullptr;
     if (EQUAL(pszCap, ODsCAddFieldDomain))
-        return m_poLayer != nullptr;
+        return m_poLayer != nullptr || m_poPartitionedLayer != nullptr;
     return false;
 }
 
@@ -88,7 +126,7 @@ OGRParquetWriterDataset::ICreateLayer(const char *pszName,
                                       const OGRGeomFieldDefn *poGeomFieldDefn,
                                       CSLConstList papszOptions)
 {
-    if (m_poLayer)
+    if (m_poLayer || m_poPartitionedLayer)
     {
         CPLError(CE_Failure, CPLE_NotSupported,
                  "Can write only one layer in a Parquet file");
@@ -99,6 +137,57 @@ OGRParquetWriterDataset::ICreateLayer(const char *pszName,
     const auto poSpatialRef =
         poGeomFieldDefn ? poGeomFieldDefn->GetSpatialRef() : nullptr;
 
+    if (CSLFetchNameValue(papszOptions, "PARTITION_BY") ||
+        CSLFetchNameValue(papszOptions, "PARTITION_GRID_SIZE"))
+    {
+        // Hive-partitioned dataset: the dataset name is a directory, which
+        // replaces the empty file created by OGRParquetDriverCreate().
+        if (m_poOutputStream)
+        {
+            CPL_IGNORE_RET_VAL(m_poOutputStream->Close());
+            m_poOutputStream.reset();
+            VSIUnlink(GetDescription());
+        }
+
+        VSIStatBufL sStat;
+        if (VSIStatL(GetDescription(), &sStat) == 0)
+        {
+            if (!VSI_ISDIR(sStat.st_mode))
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "%s already exists and is not a directory",
+                         GetDescription());
+                return nullptr;
+            }
+        }
+        else if (VSIMkdir(GetDescription(), 0755) != 0)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create directory %s",
+                     GetDescription());
+            return nullptr;
+        }
+
+        auto poLayer = std::make_unique<OGRParquetPartitionedWriterLayer>(
+            this, pszName, GetDescription());
+        if (!poLayer->SetOptions(papszOptions, poSpatialRef, eGType))
+        {
+            return nullptr;
+        }
+        m_poPartitionedLayer = std::move(poLayer);
+        return m_poPartitionedLayer.get();
+    }
+
+    if (!m_poOutputStream)
+    {
+        // OGRParquetDriverCreate() did not create the output file, because
+        // the dataset name is an existing directory.
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "%s is a directory. The PARTITION_BY or PARTITION_GRID_SIZE "
+                 "layer creation option must be set to write into it",
+                 GetDescription());
+        return nullptr;
+    }
+
     m_poLayer = std::make_unique<OGRParquetWriterLayer>(
         this, m_poMemoryPool.get(), m_poOutputStream, pszName);
     if (!m_poLayer->SetOptions(papszOptions, poSpatialRef, eGType))
@@ -116,6 +205,11 @@ OGRParquetWriterDataset::ICreateLayer(const char *pszName,
 bool OGRParquetWriterDataset::AddFieldDomain(
     std::unique_ptr<OGRFieldDomain> &&domain, std::string &failureReason)
 {
+    if (m_poPartitionedLayer)
+    {
+        return m_poPartitionedLayer->AddFieldDomain(std::move(domain),
+                                                    failureReason);
+    }
     if (m_poLayer == nullptr)
     {
         failureReason = "Layer must be created";
@@ -131,6 +225,8 @@ bool OGRParquetWriterDataset::AddFieldDomain(
 std::vector<std::string>
 OGRParquetWriterDataset::GetFieldDomainNames(CSLConstList) const
 {
+    if (m_poPartitionedLayer)
+        return m_poPartitionedLayer->GetFieldDomainNames();
     return m_poLayer ? m_poLayer->GetFieldDomainNames()
                      : std::vector<std::string>();
 }
@@ -142,5 +238,7 @@ OGRParquetWriterDataset::GetFieldDomainNames(CSLConstList) const
 const OGRFieldDomain *
 OGRParquetWriterDataset::GetFieldDomain(const std::string &name) const
 {
+    if (m_poPartitionedLayer)
+        return m_poPartitionedLayer->GetFieldDomain(name);
     return m_poLayer ? m_poLayer->GetFieldDomain(name) : nullptr;
 }
@@ -21,9 +21,12 @@
 
 #include "../arrow_common/ograrrowwriterlayer.hpp"
 
+#include "ogr_hilbert.h"
 #include "ogr_wkb.h"
 
-#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 /************************************************************************/
@@ -47,9 +50,9 @@ OGRParquetWriterLayer::OGRParquetWriterLayer(
 
 bool OGRParquetWriterLayer::Close()
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
-        if (!CopyTmpGpkgLayerToFinalFile())
+        if (!WriteSortedFeatures())
             return false;
     }
 
@@ -63,220 +66,227 @@ bool OGRParquetWriterLayer::Close()
 }
 
 /************************************************************************/
-/*                     CopyTmpGpkgLayerToFinalFile()                    */
+/*                          SpillSortBuffer()                           */
 /************************************************************************/
 
-bool OGRParquetWriterLayer::CopyTmpGpkgLayerToFinalFile()
+// Append the serialized features of m_abySortBuffer to the temporary file
+// used in SORT_BY_BBOX mode, creating it if needed.
+bool OGRParquetWriterLayer::SpillSortBuffer()
 {
-    if (!m_poTmpGPKGLayer)
+    if (!m_fpSortTmp)
     {
-        return true;
+        m_osSortTmpFilename =
+            std::string(m_poDataset->GetDescription()) + ".tmp_sort";
+        CPLDebug("PARQUET", "Spilling features to %s",
+                 m_osSortTmpFilename.c_str());
+        m_fpSortTmp.reset(VSIFOpenL(m_osSortTmpFilename.c_str(), "w+b"));
+        if (!m_fpSortTmp)
+        {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                     m_osSortTmpFilename.c_str());
+            return false;
+        }
+        // Unlink it now to avoid stale temporary file if killing the process
+        // (only works on Unix)
+        if (VSIUnlink(m_osSortTmpFilename.c_str()) == 0)
+            m_osSortTmpFilename.clear();
+    }
+    if (!m_abySortBuffer.empty() &&
+        m_fpSortTmp->Write(m_abySortBuffer.data(), 1, m_abySortBuffer.size()) !=
+            m_abySortBuffer.size())
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write temporary features");
+        return false;
     }
+    m_nSortTmpFileSize += m_abySortBuffer.size();
+    m_abySortBuffer.clear();
+    return true;
+}
 
-    CPLDebug("PARQUET", "CopyTmpGpkgLayerToFinalFile(): start...");
+/************************************************************************/
+/*                        WriteSortedFeatures()                         */
+/************************************************************************/
 
-    VSIUnlink(m_poTmpGPKG->GetDescription());
+// Write the features collected in SORT_BY_BBOX mode to the Parquet file,
+// first the ones without geometry, and then the other ones along the Hilbert
+// curve of the center of their bounding box, so that each row group covers
+// a compact area.
+bool OGRParquetWriterLayer::WriteSortedFeatures()
+{
+    m_bSortByBBOX = false;
 
+    const auto CleanUp = [this]()
+    {
+        m_fpSortTmp.reset();
+        if (!m_osSortTmpFilename.empty())
+        {
+            VSIUnlink(m_osSortTmpFilename.c_str());
+            m_osSortTmpFilename.clear();
+        }
+        std::vector<SortItem>().swap(m_asSortItems);
+        std::vector<GByte>().swap(m_abySortBuffer);
+    };
+
+    CPLDebug("PARQUET", "WriteSortedFeatures(): start...");
+
+    if (m_fpSortTmp && !SpillSortBuffer())
+    {
+        CleanUp();
+        return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Sort features along the Hilbert curve of their bbox center.     */
+    /* -------------------------------------------------------------------- */
+    const double dfWidth = m_sSortExtent.MaxX - m_sSortExtent.MinX;
+    const double dfHeight = m_sSortExtent.MaxY - m_sSortExtent.MinY;
+    constexpr double HILBERT_MAX = 0xFFFF;
+    for (auto &sItem : m_asSortItems)
+    {
+        if (sItem.nKey == 0)
+            continue;
+        const double dfX =
+            dfWidth > 0
+                ? HILBERT_MAX * (sItem.dfX - m_sSortExtent.MinX) / dfWidth
+                : 0;
+        const double dfY =
+            dfHeight > 0
+                ? HILBERT_MAX * (sItem.dfY - m_sSortExtent.MinY) / dfHeight
+                : 0;
+        sItem.nKey = (static_cast<uint64_t>(1) << 32) |
+                     OGRHilbertIndex(static_cast<uint32_t>(dfX),
+                                     static_cast<uint32_t>(dfY));
+    }
+    // Offsets grow with insertion order, hence using them as a tie breaker
+    // makes the sort stable.
+    std::sort(m_asSortItems.begin(), m_asSortItems.end(),
+              [](const SortItem &a, const SortItem &b)
+              {
+                  if (a.nKey != b.nKey)
+                      return a.nKey < b.nKey;
+                  return a.nOffset < b.nOffset;
+              });
+
+    /* -------------------------------------------------------------------- */
+    /*      Write features in that order.                                   */
+    /* -------------------------------------------------------------------- */
     OGRFeature oFeat(m_poFeatureDefn);
 
     // Interval in terms of features between 2 debug progress report messages
     constexpr int PROGRESS_FC_INTERVAL = 100 * 1000;
 
-    // First, write features without geometries
+    const size_t nTotalCount = m_asSortItems.size();
+    std::vector<GByte> abyWindow;
+    std::vector<size_t> anWindowOffsets;
+    std::vector<size_t> anReadOrder;
+    size_t iItem = 0;
+    while (iItem < nTotalCount)
     {
-        auto poTmpLayer = std::unique_ptr<OGRLayer>(m_poTmpGPKG->ExecuteSQL(
-            "SELECT serialized_feature FROM tmp WHERE fid NOT IN (SELECT id "
-            "FROM rtree_tmp_geom)",
-            nullptr, nullptr));
-        if (!poTmpLayer)
-            return false;
-        for (const auto &poSrcFeature : poTmpLayer.get())
+        // When features have been spilled to the temporary file, process
+        // them by windows of at most m_nRowGroupSize features and
+        // m_nSortMaxRAM bytes, whose features are read by increasing offset
+        // to limit seeking.
+        size_t nWindowCount = nTotalCount - iItem;
+        if (m_fpSortTmp)
         {
-            int nBytesFeature = 0;
-            const GByte *pabyFeatureData =
-                poSrcFeature->GetFieldAsBinary(0, &nBytesFeature);
-            if (!oFeat.DeserializeFromBinary(pabyFeatureData, nBytesFeature))
+            size_t nWindowSize = 0;
+            nWindowCount = 0;
+            while (iItem + nWindowCount < nTotalCount &&
+                   static_cast<int64_t>(nWindowCount) < m_nRowGroupSize)
             {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Cannot deserialize feature");
-                return false;
+                const auto &sItem = m_asSortItems[iItem + nWindowCount];
+                if (nWindowCount > 0 &&
+                    nWindowSize + sItem.nSize > m_nSortMaxRAM)
+                    break;
+                nWindowSize += sItem.nSize;
+                ++nWindowCount;
             }
-            if (OGRArrowWriterLayer::ICreateFeature(&oFeat) != OGRERR_NONE)
+
+            anReadOrder.resize(nWindowCount);
+            for (size_t i = 0; i < nWindowCount; ++i)
+                anReadOrder[i] = i;
+            std::sort(anReadOrder.begin(), anReadOrder.end(),
+                      [this, iItem](size_t a, size_t b)
+                      {
+                          return m_asSortItems[iItem + a].nOffset <
+                                 m_asSortItems[iItem + b].nOffset;
+                      });
+            try
             {
+                abyWindow.resize(nWindowSize);
+                anWindowOffsets.resize(nWindowCount);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in WriteSortedFeatures()");
+                CleanUp();
                 return false;
             }
-
-            if ((m_nFeatureCount % PROGRESS_FC_INTERVAL) == 0)
+            size_t nWindowOffset = 0;
+            for (size_t i : anReadOrder)
             {
-                CPLDebugProgress(
-                    "PARQUET",
-                    "CopyTmpGpkgLayerToFinalFile(): %.02f%% progress",
-                    100.0 * double(m_nFeatureCount) /
-                        double(m_nTmpFeatureCount));
+                const auto &sItem = m_asSortItems[iItem + i];
+                if (m_fpSortTmp->Seek(sItem.nOffset, SEEK_SET) != 0 ||
+                    m_fpSortTmp->Read(abyWindow.data() + nWindowOffset, 1,
+                                      sItem.nSize) != sItem.nSize)
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Cannot read temporary features");
+                    CleanUp();
+                    return false;
+                }
+                anWindowOffsets[i] = nWindowOffset;
+                nWindowOffset += sItem.nSize;
             }
         }
 
-        if (!FlushFeatures())
-        {
-            return false;
-        }
-    }
-
-    // Now walk through the GPKG RTree for features with geometries
-    // Cf https://github.com/sqlite/sqlite/blob/master/ext/rtree/rtree.c
-    // for the description of the content of the rtree _node table
-    std::vector<std::pair<int64_t, int>> aNodeNoDepthPair;
-    int nTreeDepth = 0;
-    // Queue the root node
-    aNodeNoDepthPair.emplace_back(
-        std::make_pair(/* nodeNo = */ 1, /* depth = */ 0));
-    int nCountWrittenFeaturesSinceLastFlush = 0;
-    while (!aNodeNoDepthPair.empty())
-    {
-        const auto &oLastPair = aNodeNoDepthPair.back();
-        const int64_t nNodeNo = oLastPair.first;
-        const int nCurDepth = oLastPair.second;
-        //CPLDebug("PARQUET", "Reading nodeNode=%d, curDepth=%d", int(nNodeNo), nCurDepth);
-        aNodeNoDepthPair.pop_back();
-
-        auto poRTreeLayer = std::unique_ptr<OGRLayer>(m_poTmpGPKG->ExecuteSQL(
-            CPLSPrintf("SELECT data FROM rtree_tmp_geom_node WHERE nodeno "
-                       "= " CPL_FRMT_GIB,
-                       static_cast<GIntBig>(nNodeNo)),
-            nullptr, nullptr));
-        if (!poRTreeLayer)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
-            return false;
-        }
-        const auto poRTreeFeature =
-            std::unique_ptr<const OGRFeature>(poRTreeLayer->GetNextFeature());
-        if (!poRTreeFeature)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
-            return false;
-        }
-
-        int nNodeBytes = 0;
-        const GByte *pabyNodeData =
-            poRTreeFeature->GetFieldAsBinary(0, &nNodeBytes);
-        constexpr int BLOB_HEADER_SIZE = 4;
-        if (nNodeBytes < BLOB_HEADER_SIZE)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Not enough bytes when reading node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
-            return false;
-        }
-        if (nNodeNo == 1)
-        {
-            // Get the RTree depth from the root node
-            nTreeDepth = (pabyNodeData[0] << 8) | pabyNodeData[1];
-            //CPLDebug("PARQUET", "nTreeDepth = %d", nTreeDepth);
-        }
-
-        const int nCellCount = (pabyNodeData[2] << 8) | pabyNodeData[3];
-        constexpr int SIZEOF_CELL = 24;  // int64_t + 4 float
-        if (nNodeBytes < BLOB_HEADER_SIZE + SIZEOF_CELL * nCellCount)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Not enough bytes when reading node " CPL_FRMT_GIB,
-                     static_cast<GIntBig>(nNodeNo));
-            return false;
-        }
-
-        size_t nOffset = BLOB_HEADER_SIZE;
-        if (nCurDepth == nTreeDepth)
+        for (size_t i = 0; i < nWindowCount; ++i)
         {
-            // Leaf node: it references feature IDs.
+            const auto &sItem = m_asSortItems[iItem + i];
 
-            // If we are about to go above m_nRowGroupSize, flush past
-            // features now, to improve the spatial compacity of the row group.
-            if (m_nRowGroupSize > nCellCount &&
-                nCountWrittenFeaturesSinceLastFlush + nCellCount >
-                    m_nRowGroupSize)
+            // Start a new row group with the first feature with a geometry,
+            // so that the bounding box of row groups is not polluted by
+            // features without geometry.
+            if (sItem.nKey != 0 && (iItem + i == 0 ||
+                                    m_asSortItems[iItem + i - 1].nKey == 0))
             {
-                nCountWrittenFeaturesSinceLastFlush = 0;
                 if (!FlushFeatures())
                 {
+                    CleanUp();
                     return false;
                 }
             }
 
-            // nCellCount shouldn't be over 51 normally, but even 65535
-            // would be fine...
-            assert(nCellCount <= 65535);
-            for (int i = 0; i < nCellCount; ++i)
+            const GByte *pabyFeatureData =
+                m_fpSortTmp ? abyWindow.data() + anWindowOffsets[i]
+                            : m_abySortBuffer.data() + sItem.nOffset;
+            if (!oFeat.DeserializeFromBinary(pabyFeatureData, sItem.nSize))
             {
-                int64_t nFID;
-                memcpy(&nFID, pabyNodeData + nOffset, sizeof(int64_t));
-                CPL_MSBPTR64(&nFID);
-
-                const auto poSrcFeature = std::unique_ptr<const OGRFeature>(
-                    m_poTmpGPKGLayer->GetFeature(nFID));
-                if (!poSrcFeature)
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot get feature " CPL_FRMT_GIB,
-                             static_cast<GIntBig>(nFID));
-                    return false;
-                }
-
-                int nBytesFeature = 0;
-                const GByte *pabyFeatureData =
-                    poSrcFeature->GetFieldAsBinary(0, &nBytesFeature);
-                if (!oFeat.DeserializeFromBinary(pabyFeatureData,
-                                                 nBytesFeature))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot deserialize feature");
-                    return false;
-                }
-                if (OGRArrowWriterLayer::ICreateFeature(&oFeat) != OGRERR_NONE)
-                {
-                    return false;
-                }
-
-                nOffset += SIZEOF_CELL;
-
-                ++nCountWrittenFeaturesSinceLastFlush;
-
-                if ((m_nFeatureCount % PROGRESS_FC_INTERVAL) == 0 ||
-                    m_nFeatureCount == m_nTmpFeatureCount / 2)
-                {
-                    CPLDebugProgress(
-                        "PARQUET",
-                        "CopyTmpGpkgLayerToFinalFile(): %.02f%% progress",
-                        100.0 * double(m_nFeatureCount) /
-                            double(m_nTmpFeatureCount));
-                }
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot deserialize feature");
+                CleanUp();
+                return false;
+            }
+            if (OGRArrowWriterLayer::ICreateFeature(&oFeat) != OGRERR_NONE)
+            {
+                CleanUp();
+                return false;
             }
-        }
-        else
-        {
-            // Non-leaf node: it references child nodes.
 
-            // nCellCount shouldn't be over 51 normally, but even 65535
-            // would be fine...
-            assert(nCellCount <= 65535);
-            for (int i = 0; i < nCellCount; ++i)
+            if ((m_nFeatureCount % PROGRESS_FC_INTERVAL) == 0)
             {
-                int64_t nNode;
-                memcpy(&nNode, pabyNodeData + nOffset, sizeof(int64_t));
-                CPL_MSBPTR64(&nNode);
-                aNodeNoDepthPair.emplace_back(
-                    std::make_pair(nNode, nCurDepth + 1));
-                nOffset += SIZEOF_CELL;
+                CPLDebugProgress(
+                    "PARQUET", "WriteSortedFeatures(): %.02f%% progress",
+                    100.0 * double(m_nFeatureCount) / double(nTotalCount));
             }
         }
+        iItem += nWindowCount;
     }
 
-    CPLDebug("PARQUET",
-             "CopyTmpGpkgLayerToFinalFile(): 100%%, successfully finished");
+    CleanUp();
+
+    CPLDebug("PARQUET", "WriteSortedFeatures(): 100%%, successfully finished");
     return true;
 }
 
@@ -323,29 +333,19 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
 
     if (CPLTestBool(CSLFetchNameValueDef(papszOptions, "SORT_BY_BBOX", "NO")))
     {
-        const std::string osTmpGPKG(std::string(m_poDataset->GetDescription()) +
-                                    ".tmp.gpkg");
-        auto poGPKGDrv = GetGDALDriverManager()->GetDriverByName("GPKG");
-        if (!poGPKGDrv)
+        m_bSortByBBOX = true;
+
+        GIntBig nMaxRAM = 0;
+        const char *pszMaxRAM =
+            CPLGetConfigOption("OGR_PARQUET_SORT_MAX_RAM", nullptr);
+        if (pszMaxRAM == nullptr ||
+            CPLParseMemorySize(pszMaxRAM, &nMaxRAM, nullptr) != CE_None)
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Driver GPKG required for SORT_BY_BBOX layer creation option");
-            return false;
+            const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+            nMaxRAM = nUsableRAM > 0 ? nUsableRAM / 4 : 1024 * 1024 * 1024;
         }
-        m_poTmpGPKG.reset(poGPKGDrv->Create(osTmpGPKG.c_str(), 0, 0, 0,
-                                            GDT_Unknown, nullptr));
-        if (!m_poTmpGPKG)
-            return false;
-        m_poTmpGPKG->MarkSuppressOnClose();
-        m_poTmpGPKGLayer = m_poTmpGPKG->CreateLayer("tmp");
-        if (!m_poTmpGPKGLayer)
-            return false;
-        // Serialized feature
-        m_poTmpGPKGLayer->CreateField(
-            std::make_unique<OGRFieldDefn>("serialized_feature", OFTBinary)
-                .get());
-        CPL_IGNORE_RET_VAL(m_poTmpGPKGLayer->StartTransaction());
+        m_nSortMaxRAM = static_cast<size_t>(std::min<uint64_t>(
+            std::max<GIntBig>(1, nMaxRAM), std::numeric_limits<size_t>::max()));
     }
 
     const char *pszGeomEncoding =
@@ -939,19 +939,18 @@ OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
 {
     // If not using SORT_BY_BBOX=YES layer creation option, we can directly
     // write features to the final Parquet file
-    if (!m_poTmpGPKGLayer)
+    if (!m_bSortByBBOX)
         return OGRArrowWriterLayer::ICreateFeature(poFeature);
 
-    // SORT_BY_BBOX=YES case: we write for now a serialized version of poFeature
-    // in a temporary GeoPackage file.
+    // SORT_BY_BBOX=YES case: we keep for now a serialized version of
+    // poFeature, in RAM or in a temporary file, and the center of its bounding
+    // box. They are written in Hilbert order by WriteSortedFeatures() at
+    // closing time.
 
-    GIntBig nFID = poFeature->GetFID();
-    if (!m_osFIDColumn.empty() && nFID == OGRNullFID)
+    if (!m_osFIDColumn.empty() && poFeature->GetFID() == OGRNullFID)
     {
-        nFID = m_nTmpFeatureCount;
-        poFeature->SetFID(nFID);
+        poFeature->SetFID(static_cast<GIntBig>(m_asSortItems.size()));
     }
-    ++m_nTmpFeatureCount;
 
     std::vector<GByte> abyBuffer;
     // Serialize the source feature as a single array of bytes to preserve it
@@ -960,37 +959,47 @@ OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
     {
         return OGRERR_FAILURE;
     }
-
-    // SQLite3 limitation: a row must fit in slightly less than 1 GB.
-    constexpr int SOME_MARGIN = 128;
-    if (abyBuffer.size() > 1024 * 1024 * 1024 - SOME_MARGIN)
+    if (abyBuffer.size() > std::numeric_limits<uint32_t>::max())
     {
         CPLError(CE_Failure, CPLE_NotSupported,
-                 "Features larger than 1 GB are not supported");
+                 "Features larger than 4 GB are not supported");
         return OGRERR_FAILURE;
     }
 
-    OGRFeature oFeat(m_poTmpGPKGLayer->GetLayerDefn());
-    oFeat.SetFID(nFID);
-    oFeat.SetField(0, static_cast<int>(abyBuffer.size()), abyBuffer.data());
+    SortItem sItem;
+    sItem.nOffset = m_nSortTmpFileSize + m_abySortBuffer.size();
+    sItem.nSize = static_cast<uint32_t>(abyBuffer.size());
     const auto poSrcGeom = poFeature->GetGeometryRef();
     if (poSrcGeom && !poSrcGeom->IsEmpty())
     {
-        // For the purpose of building an RTree, just use the bounding box of
-        // the geometry as the geometry.
         OGREnvelope sEnvelope;
         poSrcGeom->getEnvelope(&sEnvelope);
-        auto poPoly = std::make_unique<OGRPolygon>();
-        auto poLR = std::make_unique<OGRLinearRing>();
-        poLR->addPoint(sEnvelope.MinX, sEnvelope.MinY);
-        poLR->addPoint(sEnvelope.MinX, sEnvelope.MaxY);
-        poLR->addPoint(sEnvelope.MaxX, sEnvelope.MaxY);
-        poLR->addPoint(sEnvelope.MaxX, sEnvelope.MinY);
-        poLR->addPoint(sEnvelope.MinX, sEnvelope.MinY);
-        poPoly->addRingDirectly(poLR.release());
-        oFeat.SetGeometryDirectly(poPoly.release());
+        sItem.dfX = (sEnvelope.MinX + sEnvelope.MaxX) / 2;
+        sItem.dfY = (sEnvelope.MinY + sEnvelope.MaxY) / 2;
+        if (!std::isnan(sItem.dfX) && !std::isnan(sItem.dfY))
+        {
+            // Actual key computed in WriteSortedFeatures()
+            sItem.nKey = 1;
+            m_sSortExtent.Merge(sItem.dfX, sItem.dfY);
+        }
+    }
+    try
+    {
+        m_abySortBuffer.insert(m_abySortBuffer.end(), abyBuffer.begin(),
+                               abyBuffer.end());
+        m_asSortItems.push_back(sItem);
     }
-    return m_poTmpGPKGLayer->CreateFeature(&oFeat);
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in ICreateFeature()");
+        return OGRERR_FAILURE;
+    }
+
+    if (m_abySortBuffer.size() >= m_nSortMaxRAM && !SpillSortBuffer())
+        return OGRERR_FAILURE;
+
+    return OGRERR_NONE;
 }
 
 /************************************************************************/
@@ -1089,7 +1098,7 @@ OGRParquetWriterLayer::WriteArrowBatch(const struct ArrowSchema *schema,
                                        struct ArrowArray *array,
                                        CSLConstList papszOptions)
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. Hence we fallback
@@ -1136,7 +1145,7 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap)
         return false;
 #endif
 
-    if (m_poTmpGPKGLayer && EQUAL(pszCap, OLCFastWriteArrowBatch))
+    if (m_bSortByBBOX && EQUAL(pszCap, OLCFastWriteArrowBatch))
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. So this is not
@@ -1155,7 +1164,7 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap)
 bool OGRParquetWriterLayer::CreateFieldFromArrowSchema(
     const struct ArrowSchema *schema, CSLConstList papszOptions)
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. But this process
@@ -1178,7 +1187,7 @@ bool OGRParquetWriterLayer::IsArrowSchemaSupported(
     const struct ArrowSchema *schema, CSLConstList papszOptions,
     std::string &osErrorMsg) const
 {
-    if (m_poTmpGPKGLayer)
+    if (m_bSortByBBOX)
     {
         // When using SORT_BY_BBOX=YES option, we can't directly write the
         // input array, because we need to sort features. But this process
@@ -196,10 +196,23 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
     int *m_panMapFieldNameToIndex = nullptr;
     int *m_panMapFieldNameToGeomIndex = nullptr;
 
+    // Whether the current cursor returns its records in binary format
+    bool m_bBinaryCursor = false;
+    bool m_bLastGetNextArrowArrayUsedOptimizedCodePath = false;
+
     int ParsePGDate(const char *, OGRField *);
 
     void SetInitialQueryCursor();
     void CloseCursor();
+    bool EnsureCurrentRecord();
+
+    // Whether the layer may read its records with a binary cursor
+    virtual bool CanUseBinaryCursor()
+    {
+        return false;
+    }
+
+    bool IsBinaryResultSupported(PGresult *hResult) const;
 
     virtual CPLString GetFromClauseForGetExtent() = 0;
     OGRErr RunGetExtentRequest(OGREnvelope &sExtent, int bForce,
@@ -218,6 +231,10 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
                                 const int *panMapFieldNameToIndex,
                                 const int *panMapFieldNameToGeomIndex,
                                 int iRecord);
+    OGRFeature *BinaryRecordToFeature(PGresult *hResult,
+                                      const int *panMapFieldNameToIndex,
+                                      const int *panMapFieldNameToGeomIndex,
+                                      int iRecord);
     OGRFeature *GetNextRawFeature();
 
   public:
@@ -247,6 +264,9 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
 
     virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
 
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
+
     OGRPGDataSource *GetDS()
     {
         return poDS;
@@ -304,9 +324,31 @@ class OGRPGTableLayer final : public OGRPGLayer
     bool bFIDColumnInCopyFields = false;
     int bFirstInsertion = true;
 
+    // PostgreSQL types of the columns of COPY that can be encoded in
+    // binary format
+    enum class CopyBinaryType
+    {
+        INT2,
+        INT4,
+        INT8,
+        FLOAT4,
+        FLOAT8,
+        BOOL,
+        TEXT,
+        BYTEA,
+        DATE,
+        GEOMETRY
+    };
+
+    // Whether COPY uses the binary format, with one type per copied column
+    bool m_bCopyBinary = false;
+    std::vector<CopyBinaryType> m_aeCopyBinaryTypes{};
+
     OGRErr CreateFeatureViaCopy(OGRFeature *poFeature);
+    OGRErr CreateFeatureViaCopyBinary(OGRFeature *poFeature);
     OGRErr CreateFeatureViaInsert(OGRFeature *poFeature);
     CPLString BuildCopyFields();
+    bool DetermineCopyBinaryTypes();
 
     int bHasWarnedIncompatibleGeom = false;
     void CheckGeomTypeCompatibility(int iGeomField, OGRGeometry *poGeom);
@@ -350,6 +392,8 @@ class OGRPGTableLayer final : public OGRPGLayer
     void LoadMetadata();
     void SerializeMetadata();
 
+    bool CanUseBinaryCursor() override;
+
   public:
     OGRPGTableLayer(OGRPGDataSource *, CPLString &osCurrentSchema,
                     const char *pszTableName, const char *pszSchemaName,
@@ -364,6 +408,9 @@ class OGRPGTableLayer final : public OGRPGLayer
     virtual OGRFeature *GetNextFeature() override;
     virtual GIntBig GetFeatureCount(int) override;
 
+    int GetNextArrowArray(struct ArrowArrayStream *,
+                          struct ArrowArray *out_array) override;
+
     OGRErr ISetSpatialFilter(int iGeomField,
                              const OGRGeometry *poGeom) override;
 
@@ -45,8 +45,13 @@ PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "ogr_p.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_time.h"
+#include "ograrrowarrayhelper.h"
 
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #define PQexec this_is_an_error
 
@@ -120,6 +125,7 @@ void OGRPGLayer::CloseCursor()
 
         hCursorResult = nullptr;
     }
+    m_bBinaryCursor = false;
 }
 
 /************************************************************************/
@@ -521,6 +527,121 @@ static char **OGRPGTokenizeStringListFromText(const char *pszText)
     return papszTokens;
 }
 
+/************************************************************************/
+/*                     Binary cursor value decoding                     */
+/*                                                                      */
+/*      Values of a binary cursor are in the binary send format of      */
+/*      their type, that is network-order integers and IEEE floats.     */
+/************************************************************************/
+
+// Number of days between 1970-01-01 and 2000-01-01, the epoch of the
+// binary representation of dates.
+constexpr int OGRPG_DAYS_1970_TO_2000 = 10957;
+
+/************************************************************************/
+/*                      OGRPGGetBinaryInteger()                         */
+/************************************************************************/
+
+// Returns the value of a binary bool, int2, int4 or int8.
+static GIntBig OGRPGGetBinaryInteger(Oid nTypeOID, const char *pabyData)
+{
+    switch (nTypeOID)
+    {
+        case BOOLOID:
+            return pabyData[0] != 0;
+
+        case INT2OID:
+        {
+            GInt16 nVal = 0;
+            memcpy(&nVal, pabyData, sizeof(nVal));
+            CPL_MSBPTR16(&nVal);
+            return nVal;
+        }
+
+        case INT4OID:
+        {
+            GInt32 nVal = 0;
+            memcpy(&nVal, pabyData, sizeof(nVal));
+            CPL_MSBPTR32(&nVal);
+            return nVal;
+        }
+
+        default:
+        {
+            CPLAssert(nTypeOID == INT8OID);
+            GIntBig nVal = 0;
+            memcpy(&nVal, pabyData, sizeof(nVal));
+            CPL_MSBPTR64(&nVal);
+            return nVal;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       OGRPGGetBinaryFloat4()                         */
+/************************************************************************/
+
+static float OGRPGGetBinaryFloat4(const char *pabyData)
+{
+    float fVal = 0;
+    memcpy(&fVal, pabyData, sizeof(fVal));
+    CPL_MSBPTR32(&fVal);
+    return fVal;
+}
+
+/************************************************************************/
+/*                       OGRPGGetBinaryReal()                           */
+/************************************************************************/
+
+// Returns the value of a binary float4 or float8.
+// A float4 value is converted to the double of its shortest decimal
+// representation, which is what its text representation gives.
+static double OGRPGGetBinaryReal(Oid nTypeOID, const char *pabyData)
+{
+    if (nTypeOID == FLOAT8OID)
+    {
+        double dfVal = 0;
+        memcpy(&dfVal, pabyData, sizeof(dfVal));
+        CPL_MSBPTR64(&dfVal);
+        return dfVal;
+    }
+
+    CPLAssert(nTypeOID == FLOAT4OID);
+    const float fVal = OGRPGGetBinaryFloat4(pabyData);
+    if (!std::isfinite(fVal))
+        return fVal;
+    char szBuffer[32];
+    for (int nPrecision = 6; nPrecision < 9; ++nPrecision)
+    {
+        CPLsnprintf(szBuffer, sizeof(szBuffer), "%.*g", nPrecision, fVal);
+        const double dfVal = CPLAtof(szBuffer);
+        if (static_cast<float>(dfVal) == fVal)
+            return dfVal;
+    }
+    CPLsnprintf(szBuffer, sizeof(szBuffer), "%.9g", fVal);
+    return CPLAtof(szBuffer);
+}
+
+/************************************************************************/
+/*                       OGRPGGetBinaryDate()                           */
+/************************************************************************/
+
+// Returns the number of days since 1970-01-01 of a binary date, or false
+// for the special 'infinity' and '-infinity' values.
+static bool OGRPGGetBinaryDate(const char *pabyData, int &nDaysSince1970)
+{
+    GInt32 nVal = 0;
+    memcpy(&nVal, pabyData, sizeof(nVal));
+    CPL_MSBPTR32(&nVal);
+    if (nVal == std::numeric_limits<GInt32>::min() ||
+        nVal == std::numeric_limits<GInt32>::max())
+    {
+        return false;
+    }
+    nDaysSince1970 = nVal + OGRPG_DAYS_1970_TO_2000;
+    return true;
+}
+
 /************************************************************************/
 /*                          RecordToFeature()                           */
 /*                                                                      */
@@ -1387,6 +1508,114 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
     return poFeature;
 }
 
+/************************************************************************/
+/*                       BinaryRecordToFeature()                        */
+/*                                                                      */
+/*      Same as RecordToFeature(), for a result set of a binary         */
+/*      cursor accepted by IsBinaryResultSupported().                   */
+/************************************************************************/
+
+OGRFeature *OGRPGLayer::BinaryRecordToFeature(
+    PGresult *hResult, const int *panMapFieldNameToIndex,
+    const int *panMapFieldNameToGeomIndex, int iRecord)
+
+{
+    OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
+
+    poFeature->SetFID(iNextShapeId);
+    m_nFeaturesRead++;
+
+    for (int iField = 0; iField < PQnfields(hResult); iField++)
+    {
+        const int iOGRField = panMapFieldNameToIndex[iField];
+        const bool bIsNull = PQgetisnull(hResult, iRecord, iField) != 0;
+        if (bIsNull)
+        {
+            if (iOGRField >= 0)
+                poFeature->SetFieldNull(iOGRField);
+            continue;
+        }
+
+        const Oid nTypeOID = PQftype(hResult, iField);
+        const char *pabyData = PQgetvalue(hResult, iRecord, iField);
+        const int nLength = PQgetlength(hResult, iRecord, iField);
+
+        if (pszFIDColumn != nullptr &&
+            EQUAL(PQfname(hResult, iField), pszFIDColumn))
+        {
+            poFeature->SetFID(OGRPGGetBinaryInteger(nTypeOID, pabyData));
+            continue;
+        }
+
+        const int iOGRGeomField = panMapFieldNameToGeomIndex[iField];
+        if (iOGRGeomField >= 0)
+        {
+            // Binary representation of geometry is EWKB
+            OGRGeometry *poGeom = OGRGeometryFromEWKB(
+                const_cast<GByte *>(reinterpret_cast<const GByte *>(pabyData)),
+                nLength, nullptr, false);
+            if (poGeom != nullptr)
+            {
+                poGeom->assignSpatialReference(
+                    poFeatureDefn->GetGeomFieldDefn(iOGRGeomField)
+                        ->GetSpatialRef());
+                poFeature->SetGeomFieldDirectly(iOGRGeomField, poGeom);
+            }
+            continue;
+        }
+
+        if (iOGRField < 0)
+            continue;
+
+        switch (nTypeOID)
+        {
+            case BOOLOID:
+            case INT2OID:
+            case INT4OID:
+            case INT8OID:
+                poFeature->SetField(iOGRField,
+                                    OGRPGGetBinaryInteger(nTypeOID, pabyData));
+                break;
+
+            case FLOAT4OID:
+            case FLOAT8OID:
+                poFeature->SetField(iOGRField,
+                                    OGRPGGetBinaryReal(nTypeOID, pabyData));
+                break;
+
+            case BYTEAOID:
+                poFeature->SetField(
+                    iOGRField, nLength,
+                    reinterpret_cast<const GByte *>(pabyData));
+                break;
+
+            case DATEOID:
+            {
+                int nDays = 0;
+                if (OGRPGGetBinaryDate(pabyData, nDays))
+                {
+                    struct tm brokendowntime;
+                    CPLUnixTimeToYMDHMS(static_cast<GIntBig>(nDays) * 86400,
+                                        &brokendowntime);
+                    poFeature->SetField(iOGRField,
+                                        brokendowntime.tm_year + 1900,
+                                        brokendowntime.tm_mon + 1,
+                                        brokendowntime.tm_mday);
+                }
+                break;
+            }
+
+            default:
+                // text, varchar and bpchar. PQgetvalue() null-terminates
+                // binary values too.
+                poFeature->SetField(iOGRField, pabyData);
+                break;
+        }
+    }
+
+    return poFeature;
+}
+
 /************************************************************************/
 /*                    OGRPGIsKnownGeomFuncPrefix()                      */
 /************************************************************************/
@@ -1474,13 +1703,15 @@ void OGRPGLayer::SetInitialQueryCursor()
 
     poDS->SoftStartTransaction();
 
+    const bool bTryBinaryCursor = CanUseBinaryCursor();
 #if defined(BINARY_CURSOR_ENABLED)
-    if (poDS->bUseBinaryCursor && bCanUseBinaryCursor)
+    if (!bTryBinaryCursor && poDS->bUseBinaryCursor && bCanUseBinaryCursor)
         osCommand.Printf("DECLARE %s BINARY CURSOR for %s", pszCursorName,
                          pszQueryStatement);
     else
 #endif
-        osCommand.Printf("DECLARE %s CURSOR for %s", pszCursorName,
+        osCommand.Printf("DECLARE %s %s for %s", pszCursorName,
+                         bTryBinaryCursor ? "BINARY CURSOR" : "CURSOR",
                          pszQueryStatement);
 
     hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
@@ -1498,14 +1729,128 @@ void OGRPGLayer::SetInitialQueryCursor()
                                   m_panMapFieldNameToIndex,
                                   m_panMapFieldNameToGeomIndex);
 
+    m_bBinaryCursor = false;
+    if (bTryBinaryCursor && hCursorResult &&
+        PQresultStatus(hCursorResult) == PGRES_TUPLES_OK)
+    {
+        m_bBinaryCursor = IsBinaryResultSupported(hCursorResult);
+        if (!m_bBinaryCursor)
+        {
+            // Some column has a type whose binary representation we do not
+            // decode: restart with a text cursor.
+            CPLDebug("PG", "Cannot use a binary cursor for layer %s",
+                     poFeatureDefn->GetName());
+            OGRPGClearResult(hCursorResult);
+
+            osCommand.Printf("CLOSE %s", pszCursorName);
+            hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+            OGRPGClearResult(hCursorResult);
+
+            osCommand.Printf("DECLARE %s CURSOR for %s", pszCursorName,
+                             pszQueryStatement);
+            hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+            OGRPGClearResult(hCursorResult);
+
+            osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
+            hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+        }
+    }
+
     nResultOffset = 0;
 }
 
 /************************************************************************/
-/*                         GetNextRawFeature()                          */
+/*                      IsBinaryResultSupported()                       */
 /************************************************************************/
 
-OGRFeature *OGRPGLayer::GetNextRawFeature()
+// Returns whether all the columns of the result set of a binary cursor have
+// a type that BinaryRecordToFeature() decodes into the type of the
+// corresponding OGR field.
+bool OGRPGLayer::IsBinaryResultSupported(PGresult *hResult) const
+{
+    const Oid nGeometryOID = poDS->GetGeometryOID();
+    for (int iField = 0; iField < PQnfields(hResult); iField++)
+    {
+        if (PQfformat(hResult, iField) != 1)
+            return false;
+
+        const Oid nTypeOID = PQftype(hResult, iField);
+        if (pszFIDColumn != nullptr &&
+            EQUAL(PQfname(hResult, iField), pszFIDColumn))
+        {
+            if (nTypeOID != INT4OID && nTypeOID != INT8OID)
+                return false;
+            continue;
+        }
+
+        const int iOGRGeomField = m_panMapFieldNameToGeomIndex[iField];
+        if (iOGRGeomField >= 0)
+        {
+            if (nGeometryOID == 0 || nTypeOID != nGeometryOID ||
+                poFeatureDefn->GetGeomFieldDefn(iOGRGeomField)->ePostgisType !=
+                    GEOM_TYPE_GEOMETRY)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        const int iOGRField = m_panMapFieldNameToIndex[iField];
+        if (iOGRField < 0)
+            continue;
+
+        const OGRFieldDefn *poFieldDefn =
+            poFeatureDefn->GetFieldDefn(iOGRField);
+        const OGRFieldType eType = poFieldDefn->GetType();
+        const OGRFieldSubType eSubType = poFieldDefn->GetSubType();
+        bool bOK = false;
+        switch (nTypeOID)
+        {
+            case BOOLOID:
+                bOK = eType == OFTInteger && eSubType == OFSTBoolean;
+                break;
+            case INT2OID:
+            case INT4OID:
+                bOK = (eType == OFTInteger || eType == OFTInteger64) &&
+                      eSubType != OFSTBoolean;
+                break;
+            case INT8OID:
+                bOK = eType == OFTInteger64;
+                break;
+            case FLOAT4OID:
+            case FLOAT8OID:
+                bOK = eType == OFTReal;
+                break;
+            case TEXTOID:
+            case VARCHAROID:
+            case BPCHAROID:
+                bOK = eType == OFTString && eSubType == OFSTNone;
+                break;
+            case BYTEAOID:
+                bOK = eType == OFTBinary;
+                break;
+            case DATEOID:
+                bOK = eType == OFTDate;
+                break;
+            default:
+                break;
+        }
+        if (!bOK)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        EnsureCurrentRecord()                         */
+/*                                                                      */
+/*      Make sure that hCursorResult contains the record at             */
+/*      nResultOffset, by starting the cursor or fetching its next      */
+/*      page if needed. Returns false at the end of the result set      */
+/*      or on error.                                                    */
+/************************************************************************/
+
+bool OGRPGLayer::EnsureCurrentRecord()
 
 {
     PGconn *hPGConn = poDS->GetPGConn();
@@ -1516,7 +1861,7 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Cursor used to read layer has been closed due to a COMMIT. "
                  "ResetReading() must be explicitly called to restart reading");
-        return nullptr;
+        return false;
     }
 
     /* -------------------------------------------------------------------- */
@@ -1538,7 +1883,7 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
         OGRPGClearResult(hCursorResult);
 
         iNextShapeId = MAX(1, iNextShapeId);
-        return nullptr;
+        return false;
     }
 
     /* -------------------------------------------------------------------- */
@@ -1569,15 +1914,32 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
 
         iNextShapeId = MAX(1, iNextShapeId);
 
-        return nullptr;
+        return false;
     }
 
+    return true;
+}
+
+/************************************************************************/
+/*                         GetNextRawFeature()                          */
+/************************************************************************/
+
+OGRFeature *OGRPGLayer::GetNextRawFeature()
+
+{
+    if (!EnsureCurrentRecord())
+        return nullptr;
+
     /* -------------------------------------------------------------------- */
     /*      Create a feature from the current result.                       */
     /* -------------------------------------------------------------------- */
     OGRFeature *poFeature =
-        RecordToFeature(hCursorResult, m_panMapFieldNameToIndex,
-                        m_panMapFieldNameToGeomIndex, nResultOffset);
+        m_bBinaryCursor
+            ? BinaryRecordToFeature(hCursorResult, m_panMapFieldNameToIndex,
+                                    m_panMapFieldNameToGeomIndex,
+                                    nResultOffset)
+            : RecordToFeature(hCursorResult, m_panMapFieldNameToIndex,
+                              m_panMapFieldNameToGeomIndex, nResultOffset);
 
     nResultOffset++;
     iNextShapeId++;
@@ -1648,6 +2010,255 @@ OGRErr OGRPGLayer::SetNextByIndex(GIntBig nIndex)
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                        GetNextArrowArray()                           */
+/************************************************************************/
+
+// Specialized implementation that decodes the records of a binary cursor
+// directly into Arrow buffers, without going through OGRFeature.
+// Falls back to the generic implementation when a binary cursor cannot be
+// used.
+int OGRPGLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                  struct ArrowArray *out_array)
+{
+    m_bLastGetNextArrowArrayUsedOptimizedCodePath = false;
+
+    if (bInvalidated || !CanUseBinaryCursor() ||
+        CPLTestBool(CPLGetConfigOption("OGR_PG_STREAM_BASE_IMPL", "NO")))
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    if (iNextShapeId == 0 && hCursorResult == nullptr)
+        SetInitialQueryCursor();
+    if (!m_bBinaryCursor)
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    OGRArrowArrayHelper sHelper(poDS, poFeatureDefn,
+                                m_aosArrowArrayStreamOptions, out_array);
+    if (out_array->release == nullptr)
+    {
+        return ENOMEM;
+    }
+
+    if (sHelper.m_nChildren == 0)
+    {
+        out_array->release(out_array);
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    m_bLastGetNextArrowArrayUsedOptimizedCodePath = true;
+
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    std::vector<GByte> abyWKB;
+
+    const auto ReturnError = [out_array]()
+    {
+        out_array->release(out_array);
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    };
+
+    int iFeat = 0;
+    while (iFeat < sHelper.m_nMaxBatchSize && EnsureCurrentRecord())
+    {
+        const int iRecord = nResultOffset;
+        const int nColumns = PQnfields(hCursorResult);
+
+        // Arrow field of each column, or -1 for the FID or skipped columns
+        const auto GetArrowField = [this, &sHelper](int iField)
+        {
+            const int iOGRGeomField = m_panMapFieldNameToGeomIndex[iField];
+            if (iOGRGeomField >= 0)
+                return sHelper.m_mapOGRGeomFieldToArrowField[iOGRGeomField];
+            const int iOGRField = m_panMapFieldNameToIndex[iField];
+            if (iOGRField >= 0)
+                return sHelper.m_mapOGRFieldToArrowField[iOGRField];
+            return -1;
+        };
+
+        // Notify the features collected so far to the consumer if this
+        // record would make a variable-length array exceed the memory limit
+        if (iFeat > 0)
+        {
+            bool bTooBig = false;
+            for (int iField = 0; !bTooBig && iField < nColumns; iField++)
+            {
+                const int iArrowField = GetArrowField(iField);
+                if (iArrowField < 0)
+                    continue;
+                const auto psArray = out_array->children[iArrowField];
+                if (psArray->n_buffers != 3)
+                    continue;
+                const auto panOffsets =
+                    static_cast<const int32_t *>(psArray->buffers[1]);
+                const uint32_t nCurLength =
+                    static_cast<uint32_t>(panOffsets[iFeat]);
+                const uint32_t nLength = static_cast<uint32_t>(
+                    PQgetlength(hCursorResult, iRecord, iField));
+                bTooBig = nLength <= nMemLimit &&
+                          nLength > nMemLimit - nCurLength;
+            }
+            if (bTooBig)
+            {
+                CPLDebug("PG",
+                         "GetNextArrowArray(): premature notification of %d "
+                         "features to consumer due to too big array",
+                         iFeat);
+                break;
+            }
+        }
+
+        GIntBig nFID = iNextShapeId;
+        for (int iField = 0; iField < nColumns; iField++)
+        {
+            const bool bIsNull =
+                PQgetisnull(hCursorResult, iRecord, iField) != 0;
+            const Oid nTypeOID = PQftype(hCursorResult, iField);
+            const char *pabyData = PQgetvalue(hCursorResult, iRecord, iField);
+            const int nLength = PQgetlength(hCursorResult, iRecord, iField);
+
+            if (pszFIDColumn != nullptr &&
+                EQUAL(PQfname(hCursorResult, iField), pszFIDColumn))
+            {
+                if (!bIsNull)
+                    nFID = OGRPGGetBinaryInteger(nTypeOID, pabyData);
+                continue;
+            }
+
+            const int iArrowField = GetArrowField(iField);
+            if (iArrowField < 0)
+                continue;
+
+            auto psArray = out_array->children[iArrowField];
+            if (bIsNull)
+            {
+                if (!sHelper.SetNull(iArrowField, iFeat))
+                    return ReturnError();
+                continue;
+            }
+
+            if (m_panMapFieldNameToGeomIndex[iField] >= 0)
+            {
+                // Convert EWKB to ISO WKB
+                std::unique_ptr<OGRGeometry> poGeom(OGRGeometryFromEWKB(
+                    const_cast<GByte *>(
+                        reinterpret_cast<const GByte *>(pabyData)),
+                    nLength, nullptr, false));
+                const size_t nWKBSize = poGeom ? poGeom->WkbSize() : 0;
+                abyWKB.resize(nWKBSize);
+                if (nWKBSize == 0 ||
+                    poGeom->exportToWkb(wkbNDR, abyWKB.data(),
+                                        wkbVariantIso) != OGRERR_NONE)
+                {
+                    if (!sHelper.SetNull(iArrowField, iFeat))
+                        return ReturnError();
+                    continue;
+                }
+                GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, nWKBSize);
+                if (outPtr == nullptr)
+                    return ReturnError();
+                memcpy(outPtr, abyWKB.data(), nWKBSize);
+                continue;
+            }
+
+            const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(
+                m_panMapFieldNameToIndex[iField]);
+            switch (poFieldDefn->GetType())
+            {
+                case OFTInteger:
+                {
+                    const GIntBig nVal =
+                        OGRPGGetBinaryInteger(nTypeOID, pabyData);
+                    if (poFieldDefn->GetSubType() == OFSTBoolean)
+                    {
+                        if (nVal)
+                            sHelper.SetBoolOn(psArray, iFeat);
+                    }
+                    else if (poFieldDefn->GetSubType() == OFSTInt16)
+                    {
+                        sHelper.SetInt16(psArray, iFeat,
+                                         static_cast<int16_t>(nVal));
+                    }
+                    else
+                    {
+                        sHelper.SetInt32(psArray, iFeat,
+                                         static_cast<int32_t>(nVal));
+                    }
+                    break;
+                }
+
+                case OFTInteger64:
+                {
+                    sHelper.SetInt64(psArray, iFeat,
+                                     OGRPGGetBinaryInteger(nTypeOID, pabyData));
+                    break;
+                }
+
+                case OFTReal:
+                {
+                    if (poFieldDefn->GetSubType() == OFSTFloat32)
+                    {
+                        sHelper.SetFloat(
+                            psArray, iFeat,
+                            nTypeOID == FLOAT4OID
+                                ? OGRPGGetBinaryFloat4(pabyData)
+                                : static_cast<float>(
+                                      OGRPGGetBinaryReal(nTypeOID, pabyData)));
+                    }
+                    else
+                    {
+                        sHelper.SetDouble(
+                            psArray, iFeat,
+                            OGRPGGetBinaryReal(nTypeOID, pabyData));
+                    }
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    int nDays = 0;
+                    if (!OGRPGGetBinaryDate(pabyData, nDays))
+                    {
+                        if (!sHelper.SetNull(iArrowField, iFeat))
+                            return ReturnError();
+                        break;
+                    }
+                    sHelper.SetInt32(psArray, iFeat, nDays);
+                    break;
+                }
+
+                default:
+                {
+                    // OFTString or OFTBinary
+                    GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                        iArrowField, iFeat, nLength);
+                    if (outPtr == nullptr)
+                        return ReturnError();
+                    memcpy(outPtr, pabyData, nLength);
+                    break;
+                }
+            }
+        }
+
+        if (sHelper.m_panFIDValues)
+            sHelper.m_panFIDValues[iFeat] = nFID;
+        ++m_nFeaturesRead;
+        ++iFeat;
+        nResultOffset++;
+        iNextShapeId++;
+    }
+
+    sHelper.Shrink(iFeat);
+    if (iFeat == 0)
+    {
+        out_array->release(out_array);
+        memset(out_array, 0, sizeof(*out_array));
+    }
+    return 0;
+}
+
 /************************************************************************/
 /*                        BYTEAToGByteArray()                           */
 /************************************************************************/
@@ -16,7 +16,9 @@
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "cpl_error.h"
+#include "cpl_time.h"
 #include "ogr_p.h"
+#include "ogr_recordbatch.h"
 
 #include <chrono>
 #include <condition_variable>
@@ -466,6 +468,12 @@ char **OGRPGTableLayer::GetMetadata(const char *pszDomain)
 const char *OGRPGTableLayer::GetMetadataItem(const char *pszName,
                                              const char *pszDomain)
 {
+    if (pszName && pszDomain && EQUAL(pszDomain, "__DEBUG__") &&
+        EQUAL(pszName, "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH"))
+    {
+        return m_bLastGetNextArrowArrayUsedOptimizedCodePath ? "YES" : "NO";
+    }
+
     LoadMetadata();
 
     GetMetadata(pszDomain);
@@ -1189,6 +1197,75 @@ OGRFeature *OGRPGTableLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                        GetNextArrowArray()                           */
+/************************************************************************/
+
+int OGRPGTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                       struct ArrowArray *out_array)
+{
+    if (bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+    poDS->EndCopy();
+
+    if (pszQueryStatement == nullptr)
+        ResetReading();
+
+    return OGRPGLayer::GetNextArrowArray(stream, out_array);
+}
+
+/************************************************************************/
+/*                        CanUseBinaryCursor()                          */
+/************************************************************************/
+
+// Quick check, on the layer definition, of whether reading with a binary
+// cursor may be possible. The actual column types of the result set are
+// then checked by IsBinaryResultSupported().
+bool OGRPGTableLayer::CanUseBinaryCursor()
+{
+    if (!CPLTestBool(CPLGetConfigOption("PG_USE_BINARY_CURSOR", "YES")) ||
+        poDS->bUseBinaryCursor || bWkbAsOid || iFIDAsRegularColumnIndex >= 0 ||
+        CPLTestBool(CPLGetConfigOption("PG_USE_BASE64", "NO")))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+    {
+        if (poFeatureDefn->GetGeomFieldDefn(i)->ePostgisType !=
+                GEOM_TYPE_GEOMETRY ||
+            !poDS->HavePostGIS() || poDS->sPostGISVersion.nMajor < 2)
+        {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        switch (poFieldDefn->GetType())
+        {
+            case OFTInteger:
+            case OFTInteger64:
+            case OFTReal:
+            case OFTBinary:
+            case OFTDate:
+                break;
+            case OFTString:
+                if (poFieldDefn->GetSubType() != OFSTNone)
+                    return false;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                            BuildFields()                             */
 /*                                                                      */
@@ -2128,6 +2205,9 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     /* Tell the datasource we are now planning to copy data */
     poDS->StartCopy(this);
 
+    if (m_bCopyBinary)
+        return CreateFeatureViaCopyBinary(poFeature);
+
     /* First process geometry */
     for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
     {
@@ -2242,6 +2322,275 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy(OGRFeature *poFeature)
     return result;
 }
 
+/************************************************************************/
+/*                    Binary COPY encoding helpers                      */
+/************************************************************************/
+
+// The binary format of COPY uses network byte order
+
+static void OGRPGAppendInt16(std::string &osData, GInt16 nVal)
+{
+    CPL_MSBPTR16(&nVal);
+    osData.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void OGRPGAppendInt32(std::string &osData, GInt32 nVal)
+{
+    CPL_MSBPTR32(&nVal);
+    osData.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void OGRPGAppendInt64(std::string &osData, GInt64 nVal)
+{
+    CPL_MSBPTR64(&nVal);
+    osData.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void OGRPGAppendBinaryValue(std::string &osData, const void *pData,
+                                   size_t nSize)
+{
+    OGRPGAppendInt32(osData, static_cast<GInt32>(nSize));
+    osData.append(static_cast<const char *>(pData), nSize);
+}
+
+/************************************************************************/
+/*                     CreateFeatureViaCopyBinary()                     */
+/************************************************************************/
+
+// Same as CreateFeatureViaCopy(), but with the binary format of COPY, which
+// avoids hex encoding geometries, and formatting and escaping values.
+OGRErr OGRPGTableLayer::CreateFeatureViaCopyBinary(OGRFeature *poFeature)
+{
+    std::string osRow;
+    OGRPGAppendInt16(osRow, static_cast<GInt16>(m_aeCopyBinaryTypes.size()));
+    size_t iColumn = 0;
+
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++, iColumn++)
+    {
+        const OGRPGGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom == nullptr)
+        {
+            OGRPGAppendInt32(osRow, -1);
+            continue;
+        }
+
+        CheckGeomTypeCompatibility(i, poGeom);
+
+        poGeom->closeRings();
+        poGeom->set3D(poGeomFieldDefn->GeometryTypeFlags &
+                      OGRGeometry::OGR_G_3D);
+        poGeom->setMeasured(poGeomFieldDefn->GeometryTypeFlags &
+                            OGRGeometry::OGR_G_MEASURED);
+
+        std::string osEWKB;
+        if (!OGRGeometryToEWKB(poGeom, poGeomFieldDefn->nSRSId,
+                               poDS->sPostGISVersion.nMajor,
+                               poDS->sPostGISVersion.nMinor, osEWKB))
+        {
+            return OGRERR_FAILURE;
+        }
+        OGRPGAppendBinaryValue(osRow, osEWKB.data(), osEWKB.size());
+    }
+
+    const auto ReportOutOfRange =
+        [this, poFeature](const char *pszFieldName, GIntBig nVal)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Value " CPL_FRMT_GIB " of field %s of feature " CPL_FRMT_GIB
+                 " of layer %s is out of range of its column type",
+                 nVal, pszFieldName, poFeature->GetFID(),
+                 poFeatureDefn->GetName());
+        return OGRERR_FAILURE;
+    };
+
+    if (bFIDColumnInCopyFields)
+    {
+        const GIntBig nFID = poFeature->GetFID();
+        if (nFID == OGRNullFID)
+        {
+            OGRPGAppendInt32(osRow, -1);
+        }
+        else if (m_aeCopyBinaryTypes[iColumn] == CopyBinaryType::INT4)
+        {
+            if (nFID < INT_MIN || nFID > INT_MAX)
+                return ReportOutOfRange(pszFIDColumn, nFID);
+            OGRPGAppendInt32(osRow, 4);
+            OGRPGAppendInt32(osRow, static_cast<GInt32>(nFID));
+        }
+        else
+        {
+            OGRPGAppendInt32(osRow, 8);
+            OGRPGAppendInt64(osRow, nFID);
+        }
+        iColumn++;
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsGenerated())
+            continue;
+
+        const CopyBinaryType eType = m_aeCopyBinaryTypes[iColumn++];
+        if (!poFeature->IsFieldSetAndNotNull(i))
+        {
+            OGRPGAppendInt32(osRow, -1);
+            continue;
+        }
+
+        switch (eType)
+        {
+            case CopyBinaryType::INT2:
+            {
+                const int nVal = poFeature->GetFieldAsInteger(i);
+                if (nVal < SHRT_MIN || nVal > SHRT_MAX)
+                    return ReportOutOfRange(poFieldDefn->GetNameRef(), nVal);
+                OGRPGAppendInt32(osRow, 2);
+                OGRPGAppendInt16(osRow, static_cast<GInt16>(nVal));
+                break;
+            }
+
+            case CopyBinaryType::INT4:
+            {
+                const GIntBig nVal = poFeature->GetFieldAsInteger64(i);
+                if (nVal < INT_MIN || nVal > INT_MAX)
+                    return ReportOutOfRange(poFieldDefn->GetNameRef(), nVal);
+                OGRPGAppendInt32(osRow, 4);
+                OGRPGAppendInt32(osRow, static_cast<GInt32>(nVal));
+                break;
+            }
+
+            case CopyBinaryType::INT8:
+            {
+                OGRPGAppendInt32(osRow, 8);
+                OGRPGAppendInt64(osRow, poFeature->GetFieldAsInteger64(i));
+                break;
+            }
+
+            case CopyBinaryType::FLOAT4:
+            {
+                const float fVal =
+                    static_cast<float>(poFeature->GetFieldAsDouble(i));
+                GInt32 nVal;
+                memcpy(&nVal, &fVal, sizeof(nVal));
+                OGRPGAppendInt32(osRow, 4);
+                OGRPGAppendInt32(osRow, nVal);
+                break;
+            }
+
+            case CopyBinaryType::FLOAT8:
+            {
+                const double dfVal = poFeature->GetFieldAsDouble(i);
+                GInt64 nVal;
+                memcpy(&nVal, &dfVal, sizeof(nVal));
+                OGRPGAppendInt32(osRow, 8);
+                OGRPGAppendInt64(osRow, nVal);
+                break;
+            }
+
+            case CopyBinaryType::BOOL:
+            {
+                const char chVal = poFeature->GetFieldAsInteger(i) ? 1 : 0;
+                OGRPGAppendBinaryValue(osRow, &chVal, 1);
+                break;
+            }
+
+            case CopyBinaryType::TEXT:
+            {
+                const char *pszStrValue = poFeature->GetFieldAsString(i);
+                size_t nLen = strlen(pszStrValue);
+
+                // Truncate to the maximum number of characters, as done in
+                // text mode.
+                const int nMaxWidth = poFieldDefn->GetWidth();
+                if (nMaxWidth > 0)
+                {
+                    int iUTFChar = 0;
+                    for (size_t iChar = 0; iChar < nLen; iChar++)
+                    {
+                        if ((pszStrValue[iChar] & 0xc0) != 0x80)
+                        {
+                            if (iUTFChar == nMaxWidth)
+                            {
+                                CPLDebug("PG",
+                                         "Truncated %s field value, it was "
+                                         "too long.",
+                                         poFieldDefn->GetNameRef());
+                                nLen = iChar;
+                                break;
+                            }
+                            iUTFChar++;
+                        }
+                    }
+                }
+
+                if (poDS->IsUTF8ClientEncoding() &&
+                    !CPLIsUTF8(pszStrValue, static_cast<int>(nLen)))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Non UTF-8 content found when writing "
+                             "feature " CPL_FRMT_GIB " of layer %s: %s",
+                             poFeature->GetFID(), poFeatureDefn->GetName(),
+                             pszStrValue);
+                    return OGRERR_FAILURE;
+                }
+
+                OGRPGAppendBinaryValue(osRow, pszStrValue, nLen);
+                break;
+            }
+
+            case CopyBinaryType::BYTEA:
+            {
+                int nLen = 0;
+                const GByte *pabyData = poFeature->GetFieldAsBinary(i, &nLen);
+                OGRPGAppendBinaryValue(osRow, pabyData, nLen);
+                break;
+            }
+
+            case CopyBinaryType::DATE:
+            {
+                // Number of days since 2000-01-01
+                const OGRField *psField = poFeature->GetRawFieldRef(i);
+                struct tm brokendowntime;
+                memset(&brokendowntime, 0, sizeof(brokendowntime));
+                brokendowntime.tm_year = psField->Date.Year - 1900;
+                brokendowntime.tm_mon = psField->Date.Month - 1;
+                brokendowntime.tm_mday = psField->Date.Day;
+                constexpr GIntBig DAYS_1970_TO_2000 = 10957;
+                const GIntBig nDays =
+                    CPLYMDHMSToUnixTime(&brokendowntime) / 86400 -
+                    DAYS_1970_TO_2000;
+                OGRPGAppendInt32(osRow, 4);
+                OGRPGAppendInt32(osRow, static_cast<GInt32>(nDays));
+                break;
+            }
+
+            case CopyBinaryType::GEOMETRY:
+            {
+                CPLAssert(false);
+                break;
+            }
+        }
+    }
+
+    int copyResult = PQputCopyData(poDS->GetPGConn(), osRow.c_str(),
+                                   static_cast<int>(osRow.size()));
+    switch (copyResult)
+    {
+        case 0:
+            CPLError(CE_Failure, CPLE_AppDefined, "Writing COPY data blocked.");
+            return OGRERR_FAILURE;
+        case -1:
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     PQerrorMessage(poDS->GetPGConn()));
+            return OGRERR_FAILURE;
+    }
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                           TestCapability()                           */
 /************************************************************************/
@@ -3427,12 +3776,13 @@ OGRErr OGRPGTableLayer::StartCopy()
     /*CPLDebug("PG", "OGRPGDataSource(%p)::StartCopy(%p)", poDS, this);*/
 
     CPLString osFields = BuildCopyFields();
+    m_bCopyBinary = DetermineCopyBinaryTypes();
 
     size_t size = osFields.size() + strlen(pszSqlTableName) + 100;
     char *pszCommand = static_cast<char *>(CPLMalloc(size));
 
-    snprintf(pszCommand, size, "COPY %s (%s) FROM STDIN;", pszSqlTableName,
-             osFields.c_str());
+    snprintf(pszCommand, size, "COPY %s (%s) FROM STDIN%s;", pszSqlTableName,
+             osFields.c_str(), m_bCopyBinary ? " WITH (FORMAT binary)" : "");
 
     PGconn *hPGConn = poDS->GetPGConn();
     PGresult *hResult = OGRPG_PQexec(hPGConn, pszCommand);
@@ -3442,8 +3792,24 @@ OGRErr OGRPGTableLayer::StartCopy()
         CPLError(CE_Failure, CPLE_AppDefined, "%s", PQerrorMessage(hPGConn));
     }
     else
+    {
         bCopyActive = TRUE;
 
+        if (m_bCopyBinary)
+        {
+            // Signature, flags and header extension length
+            std::string osHeader("PGCOPY\n\377\r\n\0", 11);
+            OGRPGAppendInt32(osHeader, 0);
+            OGRPGAppendInt32(osHeader, 0);
+            if (PQputCopyData(hPGConn, osHeader.c_str(),
+                              static_cast<int>(osHeader.size())) != 1)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                         PQerrorMessage(hPGConn));
+            }
+        }
+    }
+
     OGRPGClearResult(hResult);
     CPLFree(pszCommand);
 
@@ -3470,6 +3836,15 @@ OGRErr OGRPGTableLayer::EndCopy()
 
     bCopyActive = FALSE;
 
+    if (m_bCopyBinary)
+    {
+        // File trailer
+        std::string osTrailer;
+        OGRPGAppendInt16(osTrailer, -1);
+        CPL_IGNORE_RET_VAL(PQputCopyData(hPGConn, osTrailer.c_str(),
+                                         static_cast<int>(osTrailer.size())));
+    }
+
     int copyResult = PQputCopyEnd(hPGConn, nullptr);
 
     switch (copyResult)
@@ -3578,6 +3953,121 @@ CPLString OGRPGTableLayer::BuildCopyFields()
     return osFieldList;
 }
 
+/************************************************************************/
+/*                      DetermineCopyBinaryTypes()                      */
+/************************************************************************/
+
+// Return whether all the columns of BuildCopyFields() have a PostgreSQL type
+// that can be encoded in the binary format of COPY from the corresponding
+// OGR field type, and if so fill m_aeCopyBinaryTypes. Otherwise the text
+// format is used.
+bool OGRPGTableLayer::DetermineCopyBinaryTypes()
+{
+    m_aeCopyBinaryTypes.clear();
+
+    if (!CPLTestBool(CPLGetConfigOption("PG_USE_BINARY_COPY", "YES")) ||
+        poDS->sPostgreSQLVersion.nMajor < 9 ||
+        (pszFIDColumn != nullptr &&
+         poFeatureDefn->GetFieldIndex(pszFIDColumn) >= 0))
+    {
+        return false;
+    }
+
+    PGconn *hPGConn = poDS->GetPGConn();
+    CPLString osCommand;
+    osCommand.Printf(
+        "SELECT a.attname, t.typname FROM pg_attribute a "
+        "JOIN pg_type t ON t.oid = a.atttypid "
+        "WHERE a.attrelid = %s::regclass AND a.attnum > 0 "
+        "AND NOT a.attisdropped",
+        OGRPGEscapeString(hPGConn, pszSqlTableName).c_str());
+    PGresult *hResult = OGRPG_PQexec(hPGConn, osCommand.c_str());
+    std::map<std::string, std::string> oMapColumnNameToType;
+    if (hResult && PQresultStatus(hResult) == PGRES_TUPLES_OK)
+    {
+        for (int iRecord = 0; iRecord < PQntuples(hResult); iRecord++)
+        {
+            oMapColumnNameToType[PQgetvalue(hResult, iRecord, 0)] =
+                PQgetvalue(hResult, iRecord, 1);
+        }
+    }
+    OGRPGClearResult(hResult);
+
+    const auto GetColumnType = [&oMapColumnNameToType](const char *pszName)
+    {
+        const auto oIter = oMapColumnNameToType.find(pszName);
+        return oIter == oMapColumnNameToType.end() ? std::string()
+                                                   : oIter->second;
+    };
+
+    for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+    {
+        const OGRPGGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        if (poGeomFieldDefn->ePostgisType != GEOM_TYPE_GEOMETRY ||
+            poDS->sPostGISVersion.nMajor < 2 ||
+            GetColumnType(poGeomFieldDefn->GetNameRef()) != "geometry")
+        {
+            return false;
+        }
+        m_aeCopyBinaryTypes.push_back(CopyBinaryType::GEOMETRY);
+    }
+
+    if (bFIDColumnInCopyFields)
+    {
+        const std::string osType = GetColumnType(pszFIDColumn);
+        if (osType == "int4")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT4);
+        else if (osType == "int8")
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT8);
+        else
+            return false;
+    }
+
+    for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+    {
+        const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsGenerated())
+            continue;
+
+        const std::string osType = GetColumnType(poFieldDefn->GetNameRef());
+        const OGRFieldType eOGRType = poFieldDefn->GetType();
+        const bool bIsInteger =
+            (eOGRType == OFTInteger || eOGRType == OFTInteger64) &&
+            poFieldDefn->GetSubType() != OFSTBoolean;
+        // Text mode rounds real values to the width and precision of the
+        // field, if set.
+        const bool bIsReal =
+            eOGRType == OFTReal && poFieldDefn->GetWidth() == 0;
+
+        if (osType == "int2" && bIsInteger && eOGRType == OFTInteger)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT2);
+        else if (osType == "int4" && bIsInteger)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT4);
+        else if (osType == "int8" && bIsInteger)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::INT8);
+        else if (osType == "float4" && bIsReal)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::FLOAT4);
+        else if (osType == "float8" && bIsReal)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::FLOAT8);
+        else if (osType == "bool" && eOGRType == OFTInteger &&
+                 poFieldDefn->GetSubType() == OFSTBoolean)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::BOOL);
+        else if ((osType == "text" || osType == "varchar" ||
+                  osType == "bpchar") &&
+                 eOGRType == OFTString)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::TEXT);
+        else if (osType == "bytea" && eOGRType == OFTBinary)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::BYTEA);
+        else if (osType == "date" && eOGRType == OFTDate)
+            m_aeCopyBinaryTypes.push_back(CopyBinaryType::DATE);
+        else
+            return false;
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                    CheckGeomTypeCompatibility()                      */
 /************************************************************************/
@@ -335,16 +335,20 @@ class OGRPMTilesVectorLayer final
 
 #ifdef HAVE_MVT_WRITE_SUPPORT
 
+class OGRPMTilesArchiveWriter;
+
 /************************************************************************/
 /*                     OGRPMTilesWriterDataset                          */
 /************************************************************************/
 
 class OGRPMTilesWriterDataset final : public GDALDataset
 {
-    std::unique_ptr<GDALDataset> m_poMBTilesWriterDataset{};
+    // Must be declared before m_poMVTWriterDataset that references it
+    std::unique_ptr<OGRPMTilesArchiveWriter> m_poArchiveWriter{};
+    std::unique_ptr<GDALDataset> m_poMVTWriterDataset{};
 
   public:
-    OGRPMTilesWriterDataset() = default;
+    OGRPMTilesWriterDataset();
 
     ~OGRPMTilesWriterDataset() override;
 
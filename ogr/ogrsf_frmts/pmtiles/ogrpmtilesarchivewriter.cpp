@@ -0,0 +1,820 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Implementation of PMTiles
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "ogrpmtilesarchivewriter.h"
+
+#include "include_pmtiles.h"
+
+#include "cpl_compressor.h"
+#include "cpl_conv.h"
+#include "cpl_md5.h"
+#include "cpl_string.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+
+/************************************************************************/
+/*                         ProcessMetadata()                            */
+/************************************************************************/
+
+// Build the PMTiles header and JSON metadata from MBTiles-like metadata
+// items, that is name/value pairs, where the value of the "json" item is
+// a serialized JSON object whose members are merged at the top level.
+static bool ProcessMetadata(const CPLJSONObject &oMetadataItems,
+                            pmtiles::headerv3 &sHeader, std::string &osMetadata)
+{
+    CPLJSONObject oObj;
+    CPLJSONDocument oJsonDoc;
+    for (const auto &oItem : oMetadataItems.GetChildren())
+    {
+        const std::string osName = oItem.GetName();
+        if (EQUAL(osName.c_str(), "json"))
+        {
+            if (!oJsonDoc.LoadMemory(oItem.ToString()))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot parse 'json' metadata item");
+                return false;
+            }
+            for (const auto &oChild : oJsonDoc.GetRoot().GetChildren())
+            {
+                oObj.Add(oChild.GetName(), oChild);
+            }
+        }
+        else
+        {
+            oObj.Add(osName, oItem.ToString());
+        }
+    }
+
+    // MBTiles advertises scheme=tms. Override this
+    oObj.Set("scheme", "xyz");
+
+    const auto osFormat = oObj.GetString("format", "{missing}");
+    if (osFormat != "pbf")
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "format=%s unhandled",
+                 osFormat.c_str());
+        return false;
+    }
+
+    int nMinZoom = atoi(oObj.GetString("minzoom", "-1").c_str());
+    if (nMinZoom < 0 || nMinZoom > 255)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Missing or invalid minzoom");
+        return false;
+    }
+
+    int nMaxZoom = atoi(oObj.GetString("maxzoom", "-1").c_str());
+    if (nMaxZoom < 0 || nMaxZoom > 255)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Missing or invalid maxzoom");
+        return false;
+    }
+
+    const CPLStringList aosCenter(
+        CSLTokenizeString2(oObj.GetString("center").c_str(), ",", 0));
+    if (aosCenter.size() != 3)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Expected 3 values for center");
+        return false;
+    }
+    const double dfCenterLong = CPLAtof(aosCenter[0]);
+    const double dfCenterLat = CPLAtof(aosCenter[1]);
+    if (std::fabs(dfCenterLong) > 180 || std::fabs(dfCenterLat) > 90)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid center");
+        return false;
+    }
+    const int nCenterZoom = atoi(aosCenter[2]);
+    if (nCenterZoom < 0 || nCenterZoom > 255)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Missing or invalid center zoom");
+        return false;
+    }
+
+    const CPLStringList aosBounds(
+        CSLTokenizeString2(oObj.GetString("bounds").c_str(), ",", 0));
+    if (aosBounds.size() != 4)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Expected 4 values for bounds");
+        return false;
+    }
+    const double dfMinX = CPLAtof(aosBounds[0]);
+    const double dfMinY = CPLAtof(aosBounds[1]);
+    const double dfMaxX = CPLAtof(aosBounds[2]);
+    const double dfMaxY = CPLAtof(aosBounds[3]);
+    if (std::fabs(dfMinX) > 180 || std::fabs(dfMinY) > 90 ||
+        std::fabs(dfMaxX) > 180 || std::fabs(dfMaxY) > 90)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid bounds");
+        return false;
+    }
+
+    CPLJSONDocument oMetadataDoc;
+    oMetadataDoc.SetRoot(oObj);
+    osMetadata = oMetadataDoc.SaveAsString();
+    // CPLDebugOnly("PMTiles", "Metadata = %s", osMetadata.c_str());
+
+    sHeader.root_dir_offset = 127;
+    sHeader.root_dir_bytes = 0;
+    sHeader.json_metadata_offset = 0;
+    sHeader.json_metadata_bytes = 0;
+    sHeader.leaf_dirs_offset = 0;
+    sHeader.leaf_dirs_bytes = 0;
+    sHeader.tile_data_offset = 0;
+    sHeader.tile_data_bytes = 0;
+    sHeader.addressed_tiles_count = 0;
+    sHeader.tile_entries_count = 0;
+    sHeader.tile_contents_count = 0;
+    sHeader.clustered = true;
+    sHeader.internal_compression = pmtiles::COMPRESSION_GZIP;
+    sHeader.tile_compression = pmtiles::COMPRESSION_GZIP;
+    sHeader.tile_type = pmtiles::TILETYPE_MVT;
+    sHeader.min_zoom = static_cast<uint8_t>(nMinZoom);
+    sHeader.max_zoom = static_cast<uint8_t>(nMaxZoom);
+    sHeader.min_lon_e7 = static_cast<int32_t>(dfMinX * 10e6);
+    sHeader.min_lat_e7 = static_cast<int32_t>(dfMinY * 10e6);
+    sHeader.max_lon_e7 = static_cast<int32_t>(dfMaxX * 10e6);
+    sHeader.max_lat_e7 = static_cast<int32_t>(dfMaxY * 10e6);
+    sHeader.center_zoom = static_cast<uint8_t>(nCenterZoom);
+    sHeader.center_lon_e7 = static_cast<int32_t>(dfCenterLong * 10e6);
+    sHeader.center_lat_e7 = static_cast<int32_t>(dfCenterLat * 10e6);
+
+    return true;
+}
+
+/************************************************************************/
+/*                      OGRPMTilesArchiveWriter()                       */
+/************************************************************************/
+
+OGRPMTilesArchiveWriter::OGRPMTilesArchiveWriter(const std::string &osFilename)
+    : m_osFilename(osFilename)
+{
+}
+
+/************************************************************************/
+/*                     ~OGRPMTilesArchiveWriter()                       */
+/************************************************************************/
+
+OGRPMTilesArchiveWriter::~OGRPMTilesArchiveWriter()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    CleanUp();
+
+    // Do not leave a truncated archive behind if Finalize() has not been
+    // called or has failed.
+    if (m_fpOut)
+    {
+        m_fpOut.reset();
+        VSIUnlink(m_osFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                              CleanUp()                               */
+/************************************************************************/
+
+void OGRPMTilesArchiveWriter::CleanUp()
+{
+    m_fpData.reset();
+    if (!m_osDataTmpFilename.empty())
+    {
+        VSIUnlink(m_osDataTmpFilename.c_str());
+        m_osDataTmpFilename.clear();
+    }
+    if (m_fpRuns)
+    {
+        m_fpRuns.reset();
+        if (!m_osRunsTmpFilename.empty())
+            VSIUnlink(m_osRunsTmpFilename.c_str());
+    }
+    m_osRunsTmpFilename.clear();
+    decltype(m_oMapMD5ToData)().swap(m_oMapMD5ToData);
+    std::vector<TileRecord>().swap(m_asRecords);
+}
+
+/************************************************************************/
+/*                                Init()                                */
+/************************************************************************/
+
+bool OGRPMTilesArchiveWriter::Init()
+{
+    m_fpOut.reset(VSIFOpenL(m_osFilename.c_str(), "wb"));
+    if (!m_fpOut)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
+                 m_osFilename.c_str());
+        return false;
+    }
+
+    std::string osTmpBase(m_osFilename);
+    if (!VSIIsLocal(m_osFilename.c_str()))
+    {
+        osTmpBase =
+            CPLGenerateTempFilenameSafe(CPLGetFilename(m_osFilename.c_str()));
+    }
+
+    m_osDataTmpFilename = osTmpBase + ".tmp_tiles";
+    m_fpData.reset(VSIFOpenL(m_osDataTmpFilename.c_str(), "wb+"));
+    if (!m_fpData)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot open %s for write",
+                 m_osDataTmpFilename.c_str());
+        return false;
+    }
+    // Unlink it now to avoid stale temporary file if killing the process
+    // (only works on Unix)
+    if (VSIUnlink(m_osDataTmpFilename.c_str()) == 0)
+        m_osDataTmpFilename.clear();
+
+    // Created on demand by SpillRecords()
+    m_osRunsTmpFilename = osTmpBase + ".tmp_sort";
+
+    GIntBig nMaxRAM = 0;
+    const char *pszMaxRAM =
+        CPLGetConfigOption("OGR_PMTILES_SORT_MAX_RAM", nullptr);
+    if (pszMaxRAM == nullptr ||
+        CPLParseMemorySize(pszMaxRAM, &nMaxRAM, nullptr) != CE_None)
+    {
+        const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+        nMaxRAM = nUsableRAM > 0 ? nUsableRAM / 10 : 256 * 1024 * 1024;
+    }
+    // Half of the budget is for the records to sort, and the other half
+    // for the deduplication map, whose entries are estimated to take the
+    // size of the key and value, plus the node and bucket pointers and the
+    // cached hash.
+    const uint64_t nHalfMaxRAM =
+        static_cast<uint64_t>(std::max<GIntBig>(1, nMaxRAM)) / 2;
+    const uint64_t nMaxRecords = nHalfMaxRAM / sizeof(TileRecord);
+    m_nMaxRecordsInRAM = static_cast<size_t>(std::max<uint64_t>(
+        1,
+        std::min<uint64_t>(nMaxRecords, std::numeric_limits<size_t>::max())));
+    constexpr size_t MD5_MAP_ENTRY_SIZE =
+        sizeof(decltype(m_oMapMD5ToData)::value_type) + 3 * sizeof(void *);
+    m_nMaxMD5InRAM = static_cast<size_t>(
+        std::min<uint64_t>(nHalfMaxRAM / MD5_MAP_ENTRY_SIZE,
+                           std::numeric_limits<size_t>::max()));
+
+    const int nThreads =
+        GDALGetNumThreads(nullptr, nullptr, "OGR_PMTILES_NUM_THREADS",
+                          std::min(4, CPLGetNumCPUs()));
+    if (nThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+        {
+            m_poJobQueue = poThreadPool->CreateJobQueue();
+            // Bound the number of tiles waiting in RAM to be processed
+            m_nMaxPendingJobs = 4 * nThreads;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                              WriteTile()                             */
+/************************************************************************/
+
+bool OGRPMTilesArchiveWriter::WriteTile(int nZ, int nX, int nY,
+                                        std::string &&osTileData)
+{
+    if (m_bError)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing temporary tile data");
+        return false;
+    }
+
+    if (nZ < 0 || nZ > 30 || nX < 0 || nX >= (1 << nZ) || nY < 0 ||
+        nY >= (1 << nZ))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid tile %d/%d/%d", nZ, nX,
+                 nY);
+        return false;
+    }
+    uint64_t nTileId;
+    try
+    {
+        nTileId = pmtiles::zxy_to_tileid(static_cast<uint8_t>(nZ), nX, nY);
+    }
+    catch (const std::exception &e)
+    {
+        // shouldn't happen given previous checks
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot compute tile id: %s",
+                 e.what());
+        return false;
+    }
+
+    if (!m_poJobQueue)
+    {
+        if (!AddTile(nTileId, osTileData))
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Failed writing temporary tile data");
+            return false;
+        }
+        return true;
+    }
+
+    // Hashing, deduplication and writing of the tile content happen in a
+    // worker thread, while the caller prepares the next tile.
+    auto poTileData = std::make_shared<std::string>(std::move(osTileData));
+    m_poJobQueue->SubmitJob(
+        [this, nTileId, poTileData]()
+        {
+            if (!m_bError && !AddTile(nTileId, *poTileData))
+                m_bError = true;
+        });
+    m_poJobQueue->WaitCompletion(m_nMaxPendingJobs);
+    return true;
+}
+
+/************************************************************************/
+/*                              AddTile()                               */
+/************************************************************************/
+
+// May be called from a worker thread: errors must not be emitted here.
+bool OGRPMTilesArchiveWriter::AddTile(uint64_t nTileId,
+                                      const std::string &osTileData)
+{
+    std::array<unsigned char, 16> abyMD5;
+    CPLMD5Context md5context;
+    CPLMD5Init(&md5context);
+    CPLMD5Update(&md5context, osTileData.data(), osTileData.size());
+    CPLMD5Final(&abyMD5[0], &md5context);
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    try
+    {
+        TileRecord sRecord;
+        sRecord.nTileId = nTileId;
+        auto oIter = m_oMapMD5ToData.find(abyMD5);
+        if (oIter != m_oMapMD5ToData.end())
+        {
+            sRecord.nDataOffset = oIter->second.first;
+            sRecord.nDataLength = oIter->second.second;
+        }
+        else
+        {
+            if (!osTileData.empty() &&
+                m_fpData->Write(osTileData.data(), osTileData.size(), 1) != 1)
+            {
+                return false;
+            }
+            sRecord.nDataOffset = m_nDataSize;
+            sRecord.nDataLength = osTileData.size();
+            // Once the map is full, new contents are no longer deduplicated.
+            // Repeated contents, like empty sea or land tiles, are typically
+            // met early.
+            if (m_oMapMD5ToData.size() < m_nMaxMD5InRAM)
+            {
+                m_oMapMD5ToData[abyMD5] = std::pair<uint64_t, uint64_t>(
+                    sRecord.nDataOffset, sRecord.nDataLength);
+            }
+            else
+            {
+                m_bMD5MapFull = true;
+            }
+            m_nDataSize += osTileData.size();
+        }
+        m_asRecords.push_back(sRecord);
+        ++m_nRecordCount;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    if (m_asRecords.size() >= m_nMaxRecordsInRAM)
+        return SpillRecords();
+    return true;
+}
+
+/************************************************************************/
+/*                            SpillRecords()                            */
+/************************************************************************/
+
+// Sort m_asRecords by tile_id and append them as a new run to the
+// temporary file of runs, creating it if needed.
+bool OGRPMTilesArchiveWriter::SpillRecords()
+{
+    if (!m_fpRuns)
+    {
+        CPLDebug("PMTiles", "Spilling tile records to %s",
+                 m_osRunsTmpFilename.c_str());
+        m_fpRuns.reset(VSIFOpenL(m_osRunsTmpFilename.c_str(), "wb+"));
+        if (!m_fpRuns)
+            return false;
+        if (VSIUnlink(m_osRunsTmpFilename.c_str()) == 0)
+            m_osRunsTmpFilename.clear();
+    }
+
+    std::sort(m_asRecords.begin(), m_asRecords.end(),
+              [](const TileRecord &a, const TileRecord &b)
+              { return a.nTileId < b.nTileId; });
+
+    const uint64_t nOffset =
+        m_anRuns.empty()
+            ? 0
+            : m_anRuns.back().first +
+                  m_anRuns.back().second * sizeof(TileRecord);
+    if (m_fpRuns->Seek(nOffset, SEEK_SET) != 0 ||
+        m_fpRuns->Write(m_asRecords.data(), sizeof(TileRecord),
+                        m_asRecords.size()) != m_asRecords.size())
+    {
+        return false;
+    }
+    m_anRuns.emplace_back(nOffset, m_asRecords.size());
+    m_asRecords.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                        ForEachSortedRecord()                         */
+/************************************************************************/
+
+// Call f() on all records by increasing tile_id, doing a k-way merge of the
+// spilled runs if there are any.
+bool OGRPMTilesArchiveWriter::ForEachSortedRecord(
+    const std::function<bool(const TileRecord &)> &f)
+{
+    if (m_anRuns.empty())
+    {
+        std::sort(m_asRecords.begin(), m_asRecords.end(),
+                  [](const TileRecord &a, const TileRecord &b)
+                  { return a.nTileId < b.nTileId; });
+        for (const auto &sRecord : m_asRecords)
+        {
+            if (!f(sRecord))
+                return false;
+        }
+        return true;
+    }
+
+    if (!m_asRecords.empty() && !SpillRecords())
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing temporary records");
+        return false;
+    }
+    std::vector<TileRecord>().swap(m_asRecords);
+
+    CPLDebug("PMTiles", "Merging %d runs of tile records",
+             static_cast<int>(m_anRuns.size()));
+
+    struct RunReader
+    {
+        uint64_t nNextOffset = 0;
+        size_t nRemaining = 0;
+        std::vector<TileRecord> asBuffer{};
+        size_t iPos = 0;
+    };
+
+    const size_t nBufferRecords =
+        std::max<size_t>(1, m_nMaxRecordsInRAM / m_anRuns.size());
+    std::vector<RunReader> asReaders(m_anRuns.size());
+
+    const auto Refill = [this, nBufferRecords](RunReader &oReader)
+    {
+        const size_t nToRead = std::min(oReader.nRemaining, nBufferRecords);
+        oReader.asBuffer.resize(nToRead);
+        oReader.iPos = 0;
+        if (nToRead == 0)
+            return true;
+        if (m_fpRuns->Seek(oReader.nNextOffset, SEEK_SET) != 0 ||
+            m_fpRuns->Read(oReader.asBuffer.data(), sizeof(TileRecord),
+                           nToRead) != nToRead)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Failed reading temporary records");
+            return false;
+        }
+        oReader.nNextOffset += nToRead * sizeof(TileRecord);
+        oReader.nRemaining -= nToRead;
+        return true;
+    };
+
+    // Min-heap of (tile_id, index of run)
+    using HeapItem = std::pair<uint64_t, size_t>;
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>>
+        oHeap;
+    for (size_t i = 0; i < m_anRuns.size(); ++i)
+    {
+        asReaders[i].nNextOffset = m_anRuns[i].first;
+        asReaders[i].nRemaining = m_anRuns[i].second;
+        if (!Refill(asReaders[i]))
+            return false;
+        if (!asReaders[i].asBuffer.empty())
+            oHeap.emplace(asReaders[i].asBuffer[0].nTileId, i);
+    }
+
+    while (!oHeap.empty())
+    {
+        const size_t iRun = oHeap.top().second;
+        oHeap.pop();
+        auto &oReader = asReaders[iRun];
+        if (!f(oReader.asBuffer[oReader.iPos]))
+            return false;
+        ++oReader.iPos;
+        if (oReader.iPos == oReader.asBuffer.size() && !Refill(oReader))
+            return false;
+        if (oReader.iPos < oReader.asBuffer.size())
+            oHeap.emplace(oReader.asBuffer[oReader.iPos].nTileId, iRun);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                            WriteMetadata()                           */
+/************************************************************************/
+
+bool OGRPMTilesArchiveWriter::WriteMetadata(const CPLJSONObject &oMetadata)
+{
+    m_oMetadata = oMetadata;
+    m_bMetadataSet = true;
+    return true;
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+bool OGRPMTilesArchiveWriter::Finalize()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    if (m_bError)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing temporary tile data");
+        CleanUp();
+        return false;
+    }
+    if (!m_bMetadataSet)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Missing metadata");
+        CleanUp();
+        return false;
+    }
+
+    pmtiles::headerv3 sHeader;
+    std::string osMetadata;
+    if (!ProcessMetadata(m_oMetadata, sHeader, osMetadata))
+    {
+        CleanUp();
+        return false;
+    }
+
+    if (m_bMD5MapFull)
+    {
+        CPLDebug("PMTiles",
+                 "Only the first " CPL_FRMT_GUIB " distinct tile contents "
+                 "have been used for deduplication, due to "
+                 "OGR_PMTILES_SORT_MAX_RAM",
+                 static_cast<GUIntBig>(m_nMaxMD5InRAM));
+    }
+
+    // Not needed any longer
+    decltype(m_oMapMD5ToData)().swap(m_oMapMD5ToData);
+
+    // Build the directory entries from the records sorted by tile_id, and
+    // assign to each distinct tile content its offset in the output tile
+    // data section, in a way that corresponds to the "clustered" mode, that
+    // is "offsets are either contiguous with the previous offset+length, or
+    // refer to a lesser offset, when writing with deduplication."
+    std::vector<pmtiles::entryv3> asPMTilesEntries;
+    std::unordered_map<uint64_t, uint64_t> oMapDataOffsetToFileOffset;
+    // (offset in m_fpData, length) of tile contents in output order
+    std::vector<std::pair<uint64_t, uint32_t>> anDataToCopy;
+    uint64_t nFileOffset = 0;
+    uint64_t nAddressedTiles = 0;
+    uint64_t nLastTileId = 0;
+    uint64_t nLastDataOffset = 0;
+    bool bOK;
+    try
+    {
+        bOK = ForEachSortedRecord(
+            [&](const TileRecord &sRecord)
+            {
+                if (!asPMTilesEntries.empty() &&
+                    sRecord.nTileId == nLastTileId)
+                {
+                    CPLError(CE_Warning, CPLE_AppDefined,
+                             "Tile with tile_id " CPL_FRMT_GUIB
+                             " written several times. Only keeping one.",
+                             static_cast<GUIntBig>(sRecord.nTileId));
+                    return true;
+                }
+                if (sRecord.nDataLength >
+                    std::numeric_limits<uint32_t>::max())
+                {
+                    CPLError(CE_Failure, CPLE_NotSupported,
+                             "Too large tile content");
+                    return false;
+                }
+
+                ++nAddressedTiles;
+                if (!asPMTilesEntries.empty() &&
+                    sRecord.nTileId == nLastTileId + 1 &&
+                    sRecord.nDataOffset == nLastDataOffset)
+                {
+                    // If the tile id immediately follows the previous one
+                    // and has the same tile data, increase the run_length
+                    asPMTilesEntries.back().run_length++;
+                }
+                else
+                {
+                    pmtiles::entryv3 sPMTilesEntry;
+                    sPMTilesEntry.tile_id = sRecord.nTileId;
+                    sPMTilesEntry.run_length = 1;
+                    sPMTilesEntry.length =
+                        static_cast<uint32_t>(sRecord.nDataLength);
+
+                    auto oIter =
+                        oMapDataOffsetToFileOffset.find(sRecord.nDataOffset);
+                    if (oIter != oMapDataOffsetToFileOffset.end())
+                    {
+                        // Point to previously written tile data if this
+                        // content has already been written
+                        sPMTilesEntry.offset = oIter->second;
+                    }
+                    else
+                    {
+                        sPMTilesEntry.offset = nFileOffset;
+                        oMapDataOffsetToFileOffset[sRecord.nDataOffset] =
+                            nFileOffset;
+                        anDataToCopy.emplace_back(sRecord.nDataOffset,
+                                                  sPMTilesEntry.length);
+                        nFileOffset += sRecord.nDataLength;
+                    }
+                    asPMTilesEntries.push_back(sPMTilesEntry);
+                }
+                nLastTileId = sRecord.nTileId;
+                nLastDataOffset = sRecord.nDataOffset;
+                return true;
+            });
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory building directories: %s", e.what());
+        bOK = false;
+    }
+    oMapDataOffsetToFileOffset.clear();
+    if (m_fpRuns)
+    {
+        m_fpRuns.reset();
+        if (!m_osRunsTmpFilename.empty())
+            VSIUnlink(m_osRunsTmpFilename.c_str());
+        m_osRunsTmpFilename.clear();
+    }
+    if (!bOK)
+    {
+        CleanUp();
+        return false;
+    }
+
+    CPLDebug("PMTiles",
+             CPL_FRMT_GUIB " tiles, %u directory entries, %u distinct contents",
+             static_cast<GUIntBig>(nAddressedTiles),
+             static_cast<unsigned>(asPMTilesEntries.size()),
+             static_cast<unsigned>(anDataToCopy.size()));
+
+    const CPLCompressor *psCompressor = CPLGetCompressor("gzip");
+    assert(psCompressor);
+    std::string osCompressed;
+
+    struct compression_exception : std::exception
+    {
+        const char *what() const noexcept override
+        {
+            return "Compression failed";
+        }
+    };
+
+    const auto oCompressFunc = [psCompressor,
+                                &osCompressed](const std::string &osBytes,
+                                               uint8_t) -> std::string
+    {
+        osCompressed.resize(32 + osBytes.size() * 2);
+        size_t nOutputSize = osCompressed.size();
+        void *pOutputData = &osCompressed[0];
+        if (!psCompressor->pfnFunc(osBytes.data(), osBytes.size(), &pOutputData,
+                                   &nOutputSize, nullptr,
+                                   psCompressor->user_data))
+        {
+            throw compression_exception();
+        }
+        osCompressed.resize(nOutputSize);
+        return osCompressed;
+    };
+
+    std::string osCompressedMetadata;
+
+    std::string osRootBytes;
+    std::string osLeaveBytes;
+    int nNumLeaves;
+    try
+    {
+        osCompressedMetadata =
+            oCompressFunc(osMetadata, pmtiles::COMPRESSION_GZIP);
+
+        // Build the root and leave directories (one depth max)
+        std::tie(osRootBytes, osLeaveBytes, nNumLeaves) =
+            pmtiles::make_root_leaves(oCompressFunc, pmtiles::COMPRESSION_GZIP,
+                                      asPMTilesEntries);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot build directories: %s",
+                 e.what());
+        CleanUp();
+        return false;
+    }
+
+    // Finalize the header fields related to offsets and size of the
+    // different parts of the file
+    sHeader.root_dir_bytes = osRootBytes.size();
+    sHeader.json_metadata_offset =
+        sHeader.root_dir_offset + sHeader.root_dir_bytes;
+    sHeader.json_metadata_bytes = osCompressedMetadata.size();
+    sHeader.leaf_dirs_offset =
+        sHeader.json_metadata_offset + sHeader.json_metadata_bytes;
+    sHeader.leaf_dirs_bytes = osLeaveBytes.size();
+    sHeader.tile_data_offset =
+        sHeader.leaf_dirs_offset + sHeader.leaf_dirs_bytes;
+    sHeader.tile_data_bytes = nFileOffset;
+
+    // Nomber of tiles that are addressable in the PMTiles archive, that is
+    // the number of tiles we would have if not deduplicating them
+    sHeader.addressed_tiles_count = nAddressedTiles;
+
+    // Number of tile entries in root and leave directories
+    // ie entries whose run_length >= 1
+    sHeader.tile_entries_count = asPMTilesEntries.size();
+
+    // Number of distinct tile blobs
+    sHeader.tile_contents_count = anDataToCopy.size();
+
+    std::vector<pmtiles::entryv3>().swap(asPMTilesEntries);
+
+    // Now build the final file!
+    const auto osHeader = sHeader.serialize();
+
+    if (m_fpOut->Write(osHeader.data(), osHeader.size(), 1) != 1 ||
+        m_fpOut->Write(osRootBytes.data(), osRootBytes.size(), 1) != 1 ||
+        m_fpOut->Write(osCompressedMetadata.data(), osCompressedMetadata.size(),
+                       1) != 1 ||
+        (!osLeaveBytes.empty() &&
+         m_fpOut->Write(osLeaveBytes.data(), osLeaveBytes.size(), 1) != 1))
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+        CleanUp();
+        return false;
+    }
+
+    // Copy distinct tile contents from the temporary file, in the order
+    // of their first reference.
+    std::string osBuffer;
+    for (const auto &[nDataOffset, nDataLength] : anDataToCopy)
+    {
+        if (nDataLength == 0)
+            continue;
+        osBuffer.resize(nDataLength);
+        if (m_fpData->Seek(nDataOffset, SEEK_SET) != 0 ||
+            m_fpData->Read(&osBuffer[0], nDataLength, 1) != 1 ||
+            m_fpOut->Write(osBuffer.data(), nDataLength, 1) != 1)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Failed writing");
+            CleanUp();
+            return false;
+        }
+    }
+
+    CleanUp();
+
+    if (m_fpOut->Close() != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Failed writing %s",
+                 m_osFilename.c_str());
+        return false;
+    }
+    m_fpOut.reset();
+
+    return true;
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Implementation of PMTiles
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef OGRPMTILESARCHIVEWRITER_H_INCLUDED
+#define OGRPMTILESARCHIVEWRITER_H_INCLUDED
+
+#include "cpl_json.h"
+#include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
+
+#include "mvtutils.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/************************************************************************/
+/*                        OGRPMTilesArchiveWriter                       */
+/************************************************************************/
+
+/** Writes a PMTiles v3 archive from tiles received in any order.
+ *
+ * Tile contents are deduplicated with a MD5 hash as soon as they are
+ * received, and unique contents are appended to a temporary file. The
+ * (tile_id, content) records are sorted by tile_id with an external merge
+ * sort, whose runs are spilled to another temporary file when exceeding
+ * their half of OGR_PMTILES_SORT_MAX_RAM. The other half bounds the number
+ * of hashes remembered for deduplication. Finalize() builds the directories
+ * from the
+ * sorted records, and writes the header, directories and tile data in
+ * clustered order to the output file.
+ */
+class OGRPMTilesArchiveWriter final : public OGRMVTTileSink
+{
+  public:
+    explicit OGRPMTilesArchiveWriter(const std::string &osFilename);
+    ~OGRPMTilesArchiveWriter() override;
+
+    bool Init();
+
+    bool WriteTile(int nZ, int nX, int nY, std::string &&osTileData) override;
+    bool WriteMetadata(const CPLJSONObject &oMetadata) override;
+
+    bool Finalize();
+
+  private:
+    struct TileRecord
+    {
+        uint64_t nTileId;
+        uint64_t nDataOffset;  // in m_fpData
+        uint64_t nDataLength;
+    };
+
+    // From https://codereview.stackexchange.com/questions/171999/specializing-stdhash-for-stdarray
+    // We do not use std::hash<std::array<T, N>> as the name of the struct
+    // because with gcc 5.4 we get the following error:
+    // https://stackoverflow.com/questions/25594644/warning-specialization-of-template-in-different-namespace
+    struct HashMD5
+    {
+        CPL_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+        size_t operator()(const std::array<unsigned char, 16> &key) const
+        {
+            std::hash<unsigned char> hasher;
+            size_t result = 0;
+            for (size_t i = 0; i < key.size(); ++i)
+            {
+                result = result * 31 + hasher(key[i]);
+            }
+            return result;
+        }
+    };
+
+    const std::string m_osFilename;
+    VSIVirtualHandleUniquePtr m_fpOut{};
+
+    // Unique tile contents, in reception order
+    std::string m_osDataTmpFilename{};
+    VSIVirtualHandleUniquePtr m_fpData{};
+    uint64_t m_nDataSize = 0;
+    std::unordered_map<std::array<unsigned char, 16>,
+                       std::pair<uint64_t, uint64_t>, HashMD5>
+        m_oMapMD5ToData{};
+    size_t m_nMaxMD5InRAM = 0;
+    bool m_bMD5MapFull = false;
+
+    // Sorted runs of records
+    std::string m_osRunsTmpFilename{};
+    VSIVirtualHandleUniquePtr m_fpRuns{};
+    std::vector<std::pair<uint64_t, size_t>> m_anRuns{};  // (offset, count)
+    std::vector<TileRecord> m_asRecords{};
+    size_t m_nMaxRecordsInRAM = 0;
+    uint64_t m_nRecordCount = 0;
+
+    CPLJSONObject m_oMetadata{};
+    bool m_bMetadataSet = false;
+
+    std::mutex m_oMutex{};
+    std::atomic<bool> m_bError{false};
+    CPLJobQueuePtr m_poJobQueue{};
+    int m_nMaxPendingJobs = 0;
+
+    bool AddTile(uint64_t nTileId, const std::string &osTileData);
+    bool SpillRecords();
+    bool ForEachSortedRecord(const std::function<bool(const TileRecord &)> &f);
+    void CleanUp();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRPMTilesArchiveWriter)
+};
+
+#endif /* OGRPMTILESARCHIVEWRITER_H_INCLUDED */
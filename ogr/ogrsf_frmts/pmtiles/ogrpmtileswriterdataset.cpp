@@ -15,7 +15,13 @@
 #ifdef HAVE_MVT_WRITE_SUPPORT
 
 #include "mvtutils.h"
-#include "ogrpmtilesfrommbtiles.h"
+#include "ogrpmtilesarchivewriter.h"
+
+/************************************************************************/
+/*                      OGRPMTilesWriterDataset()                       */
+/************************************************************************/
+
+OGRPMTilesWriterDataset::OGRPMTilesWriterDataset() = default;
 
 /************************************************************************/
 /*                     ~OGRPMTilesWriterDataset()                       */
@@ -35,25 +41,18 @@ CPLErr OGRPMTilesWriterDataset::Close()
     CPLErr eErr = CE_None;
     if (nOpenFlags != OPEN_FLAGS_CLOSED)
     {
-        if (m_poMBTilesWriterDataset)
+        if (m_poMVTWriterDataset)
         {
-            if (m_poMBTilesWriterDataset->Close() != CE_None)
+            // Closing the MVT writer sends the encoded tiles and the
+            // metadata to the archive writer
+            if (m_poMVTWriterDataset->Close() != CE_None ||
+                !m_poArchiveWriter->Finalize())
             {
                 eErr = CE_Failure;
             }
-            else
-            {
-                if (!OGRPMTilesConvertFromMBTiles(
-                        GetDescription(),
-                        m_poMBTilesWriterDataset->GetDescription()))
-                {
-                    eErr = CE_Failure;
-                }
-            }
-
-            VSIUnlink(m_poMBTilesWriterDataset->GetDescription());
-            m_poMBTilesWriterDataset.reset();
+            m_poMVTWriterDataset.reset();
         }
+        m_poArchiveWriter.reset();
 
         if (GDALDataset::Close() != CE_None)
             eErr = CE_Failure;
@@ -70,27 +69,44 @@ bool OGRPMTilesWriterDataset::Create(const char *pszFilename,
 {
     SetDescription(pszFilename);
     CPLStringList aosOptions(papszOptions);
-    aosOptions.SetNameValue("FORMAT", "MBTILES");
-
-    // Let's build a temporary file that contains the tile data in
-    // a way that corresponds to the "clustered" mode, that is
-    // "offsets are either contiguous with the previous offset+length, or
-    // refer to a lesser offset, when writing with deduplication."
-    std::string osTmpFile(pszFilename);
-    if (!VSIIsLocal(pszFilename))
+
+    if (aosOptions.FetchNameValue("TILING_SCHEME"))
     {
-        osTmpFile = CPLGenerateTempFilenameSafe(CPLGetFilename(pszFilename));
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Custom TILING_SCHEME not supported with PMTiles output");
+        return false;
     }
-    osTmpFile += ".tmp.mbtiles";
 
     if (!aosOptions.FetchNameValue("NAME"))
         aosOptions.SetNameValue("NAME",
                                 CPLGetBasenameSafe(pszFilename).c_str());
 
-    m_poMBTilesWriterDataset.reset(OGRMVTWriterDatasetCreate(
-        osTmpFile.c_str(), 0, 0, 0, GDT_Unknown, aosOptions.List()));
+    // Keep the temporary file of the MVT writer on a local file system
+    if (!aosOptions.FetchNameValue("TEMPORARY_DB") && !VSIIsLocal(pszFilename))
+    {
+        aosOptions.SetNameValue(
+            "TEMPORARY_DB",
+            (CPLGenerateTempFilenameSafe(CPLGetFilename(pszFilename)) +
+             ".tmp_fragments")
+                .c_str());
+    }
+
+    m_poArchiveWriter = std::make_unique<OGRPMTilesArchiveWriter>(pszFilename);
+    if (!m_poArchiveWriter->Init())
+    {
+        m_poArchiveWriter.reset();
+        return false;
+    }
+
+    m_poMVTWriterDataset.reset(OGRMVTWriterDatasetCreateForTileSink(
+        pszFilename, aosOptions.List(), m_poArchiveWriter.get()));
+    if (!m_poMVTWriterDataset)
+    {
+        m_poArchiveWriter.reset();
+        return false;
+    }
 
-    return m_poMBTilesWriterDataset != nullptr;
+    return true;
 }
 
 /************************************************************************/
@@ -102,8 +118,8 @@ OGRPMTilesWriterDataset::ICreateLayer(const char *pszLayerName,
                                       const OGRGeomFieldDefn *poGeomFieldDefn,
                                       CSLConstList papszOptions)
 {
-    return m_poMBTilesWriterDataset->CreateLayer(pszLayerName, poGeomFieldDefn,
-                                                 papszOptions);
+    return m_poMVTWriterDataset->CreateLayer(pszLayerName, poGeomFieldDefn,
+                                             papszOptions);
 }
 
 /************************************************************************/
@@ -112,7 +128,7 @@ OGRPMTilesWriterDataset::ICreateLayer(const char *pszLayerName,
 
 int OGRPMTilesWriterDataset::TestCapability(const char *pszCap)
 {
-    return m_poMBTilesWriterDataset->TestCapability(pszCap);
+    return m_poMVTWriterDataset->TestCapability(pszCap);
 }
 
 #endif  // HAVE_MVT_WRITE_SUPPORT
@@ -23,6 +23,8 @@
 #include "shapefil.h"
 #include "shp_vsi.h"
 #include "ogrlayerpool.h"
+#include "cpl_virtualmem.h"
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -89,6 +91,46 @@ class OGRShapeGeomFieldDefn final : public OGRGeomFieldDefn
     }
 };
 
+/************************************************************************/
+/*                         OGRShapeHilbertRTree                         */
+/************************************************************************/
+
+/** Packed Hilbert R-tree of shape bounding boxes, stored in a .hrt file */
+class OGRShapeHilbertRTree
+{
+    CPL_DISALLOW_COPY_ASSIGN(OGRShapeHilbertRTree)
+
+    int m_nRecords = 0;
+    int m_nItems = 0;
+    int m_nNodeSize = 0;
+    unsigned int m_nSHPFileSize = 0;
+    GIntBig m_nSHPMTime = 0;
+    OGREnvelope m_sExtent{};
+    uint64_t m_nNodes = 0;
+    //! Index of the first node of each level, from leaves to root.
+    std::vector<uint64_t> m_anLevelStart{};
+    //! Nodes, when built or loaded in memory
+    std::vector<GByte> m_abyNodes{};
+    VSILFILE *m_fp = nullptr;
+    CPLVirtualMem *m_psVirtualMem = nullptr;
+    const GByte *m_pabyNodes = nullptr;
+
+    OGRShapeHilbertRTree() = default;
+    bool ComputeLevels();
+
+  public:
+    static constexpr int DEFAULT_NODE_SIZE = 16;
+
+    ~OGRShapeHilbertRTree();
+
+    static std::unique_ptr<OGRShapeHilbertRTree>
+    Build(SHPHandle hSHP, int nNodeSize, GIntBig nSHPMTime);
+    static std::unique_ptr<OGRShapeHilbertRTree>
+    Open(const char *pszFilename, SHPHandle hSHP, GIntBig nSHPMTime);
+    bool Write(const char *pszFilename) const;
+    std::vector<int> Search(const OGREnvelope &sEnvelope) const;
+};
+
 /************************************************************************/
 /*                            OGRShapeLayer                             */
 /************************************************************************/
@@ -136,6 +178,15 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     SBNSearchHandle m_hSBN = nullptr;
     bool CheckForSBN();
 
+    bool m_bCheckedForHilbertRTree = false;
+    std::unique_ptr<OGRShapeHilbertRTree> m_poHilbertRTree{};
+    // Whether m_poHilbertRTree has been built automatically and has no .hrt
+    bool m_bHilbertRTreeInMemory = false;
+    bool m_bTriedAutoBuildHilbertRTree = false;
+    bool CheckForHilbertRTree();
+    bool AutoBuildHilbertRTree();
+    GIntBig GetSHPModificationTime() const;
+
     bool m_bSbnSbxDeleted = false;
 
     CPLString ConvertCodePage(const char *);
@@ -194,6 +245,7 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
 
   public:
     OGRErr CreateSpatialIndex(int nMaxDepth);
+    OGRErr CreateHilbertRTreeSpatialIndex();
     OGRErr DropSpatialIndex();
     OGRErr Repack();
     OGRErr RecomputeExtent();
@@ -1046,6 +1046,7 @@ OGRLayer *OGRShapeDataSource::GetLayerByName(const char *pszLayerNameIn)
 /*      SPATIAL INDEX commands.  Support forms are:                     */
 /*                                                                      */
 /*        CREATE SPATIAL INDEX ON layer_name [DEPTH n]                  */
+/*        CREATE SPATIAL INDEX ON layer_name TYPE {QIX|HILBERT}         */
 /*        DROP SPATIAL INDEX ON layer_name                              */
 /*        REPACK layer_name                                             */
 /*        RECOMPUTE EXTENT ON layer_name                                */
@@ -1183,22 +1184,32 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
     if (CSLCount(papszTokens) < 5 || !EQUAL(papszTokens[0], "CREATE") ||
         !EQUAL(papszTokens[1], "SPATIAL") || !EQUAL(papszTokens[2], "INDEX") ||
         !EQUAL(papszTokens[3], "ON") || CSLCount(papszTokens) > 7 ||
-        (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5], "DEPTH")))
+        CSLCount(papszTokens) == 6 ||
+        (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5], "DEPTH") &&
+         !(EQUAL(papszTokens[5], "TYPE") &&
+           (EQUAL(papszTokens[6], "QIX") || EQUAL(papszTokens[6], "HILBERT")))))
     {
         CSLDestroy(papszTokens);
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Syntax error in CREATE SPATIAL INDEX command.\n"
                  "Was '%s'\n"
                  "Should be of form 'CREATE SPATIAL INDEX ON <table> "
-                 "[DEPTH <n>]'",
+                 "[DEPTH <n>]' or 'CREATE SPATIAL INDEX ON <table> "
+                 "TYPE {QIX|HILBERT}'",
                  pszStatement);
         return nullptr;
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Get depth if provided.                                          */
+    /*      Get depth or index type if provided.                            */
     /* -------------------------------------------------------------------- */
-    const int nDepth = CSLCount(papszTokens) == 7 ? atoi(papszTokens[6]) : 0;
+    const bool bHilbertRTree = CSLCount(papszTokens) == 7 &&
+                               EQUAL(papszTokens[5], "TYPE") &&
+                               EQUAL(papszTokens[6], "HILBERT");
+    const int nDepth = CSLCount(papszTokens) == 7 &&
+                               EQUAL(papszTokens[5], "DEPTH")
+                           ? atoi(papszTokens[6])
+                           : 0;
 
     /* -------------------------------------------------------------------- */
     /*      What layer are we operating on.                                 */
@@ -1216,7 +1227,10 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
 
     CSLDestroy(papszTokens);
 
-    poLayer->CreateSpatialIndex(nDepth);
+    if (bHilbertRTree)
+        poLayer->CreateHilbertRTreeSpatialIndex();
+    else
+        poLayer->CreateSpatialIndex(nDepth);
     return nullptr;
 }
 
@@ -1227,8 +1241,8 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
 const char *const *OGRShapeDataSource::GetExtensionsForDeletion()
 {
     static const char *const apszExtensions[] = {
-        "shp",  "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind", "qix", "cpg",
-        "qpj",  // QGIS projection file
+        "shp", "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind", "qix", "hrt",
+        "cpg", "qpj",  // QGIS projection file
         nullptr};
     return apszExtensions;
 }
@@ -0,0 +1,588 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Implements OGRShapeHilbertRTree class: packed Hilbert R-tree
+ *           spatial index stored in a .hrt sidecar file.
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "ogrshape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_vsi.h"
+#include "ogr_hilbert.h"
+
+/* -------------------------------------------------------------------- */
+/*      File layout (all values little-endian):                         */
+/*                                                                      */
+/*      0   char[8]   magic "OGRHRT01"                                  */
+/*      8   uint32    number of records of the .shp at build time       */
+/*      12  uint32    number of indexed (non-null) shapes               */
+/*      16  uint32    size in bytes of the .shp at build time           */
+/*      20  uint16    node size (maximum number of children of a node)  */
+/*      22  uint16    reserved (0)                                      */
+/*      24  double[4] extent: minx, miny, maxx, maxy                    */
+/*      56  int64     modification time of the .shp at build time, in  */
+/*                    seconds since the Epoch                           */
+/*      64  nodes, root first and leaves last. Each node is made of     */
+/*          minx, miny, maxx, maxy as doubles and a uint64 value that   */
+/*          is the index of the first child node for internal nodes,    */
+/*          or the shape id for leaves.                                 */
+/* -------------------------------------------------------------------- */
+
+constexpr const char HRT_MAGIC[] = "OGRHRT01";
+constexpr int HRT_HEADER_SIZE = 64;
+constexpr int HRT_NODE_SIZE_IN_BYTES = 4 * 8 + 8;
+
+/************************************************************************/
+/*                        Little-endian helpers                         */
+/************************************************************************/
+
+static double ReadDouble(const GByte *pabyData)
+{
+    double dfVal;
+    memcpy(&dfVal, pabyData, sizeof(dfVal));
+    CPL_LSBPTR64(&dfVal);
+    return dfVal;
+}
+
+static uint64_t ReadUInt64(const GByte *pabyData)
+{
+    uint64_t nVal;
+    memcpy(&nVal, pabyData, sizeof(nVal));
+    CPL_LSBPTR64(&nVal);
+    return nVal;
+}
+
+static uint32_t ReadUInt32(const GByte *pabyData)
+{
+    uint32_t nVal;
+    memcpy(&nVal, pabyData, sizeof(nVal));
+    CPL_LSBPTR32(&nVal);
+    return nVal;
+}
+
+static void WriteDouble(GByte *pabyData, double dfVal)
+{
+    CPL_LSBPTR64(&dfVal);
+    memcpy(pabyData, &dfVal, sizeof(dfVal));
+}
+
+static void WriteUInt64(GByte *pabyData, uint64_t nVal)
+{
+    CPL_LSBPTR64(&nVal);
+    memcpy(pabyData, &nVal, sizeof(nVal));
+}
+
+static void WriteUInt32(GByte *pabyData, uint32_t nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    memcpy(pabyData, &nVal, sizeof(nVal));
+}
+
+/************************************************************************/
+/*                       ~OGRShapeHilbertRTree()                        */
+/************************************************************************/
+
+OGRShapeHilbertRTree::~OGRShapeHilbertRTree()
+{
+    if (m_psVirtualMem)
+        CPLVirtualMemFree(m_psVirtualMem);
+    if (m_fp)
+        VSIFCloseL(m_fp);
+}
+
+/************************************************************************/
+/*                           ComputeLevels()                            */
+/************************************************************************/
+
+// Compute the index of the first node of each level (leaves first) and
+// the total number of nodes.
+bool OGRShapeHilbertRTree::ComputeLevels()
+{
+    m_anLevelStart.clear();
+    m_nNodes = 0;
+    if (m_nItems == 0)
+        return true;
+
+    std::vector<uint64_t> anLevelNodeCount;
+    uint64_t n = m_nItems;
+    anLevelNodeCount.push_back(n);
+    m_nNodes = n;
+    while (n != 1)
+    {
+        n = (n + m_nNodeSize - 1) / m_nNodeSize;
+        anLevelNodeCount.push_back(n);
+        m_nNodes += n;
+    }
+
+    uint64_t nStart = m_nNodes;
+    for (const auto nCount : anLevelNodeCount)
+    {
+        nStart -= nCount;
+        m_anLevelStart.push_back(nStart);
+    }
+    return m_nNodes <= std::numeric_limits<size_t>::max() /
+                           HRT_NODE_SIZE_IN_BYTES;
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+// Build the tree in memory from the bounding boxes of the shapes. Those are
+// read directly from the .shp record headers, in a single pass over the file,
+// without decoding the shapes.
+std::unique_ptr<OGRShapeHilbertRTree>
+OGRShapeHilbertRTree::Build(SHPHandle hSHP, int nNodeSize, GIntBig nSHPMTime)
+{
+    struct Item
+    {
+        double dfMinX, dfMinY, dfMaxX, dfMaxY;
+        uint32_t nHilbert;
+        int nShapeId;
+    };
+
+    std::vector<Item> asItems;
+    OGREnvelope sExtent;
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the bounding box of non-null shapes.                    */
+    /* -------------------------------------------------------------------- */
+    constexpr size_t BUFFER_SIZE = 1024 * 1024;
+    constexpr unsigned MAX_HEADER_SIZE = 8 + 4 + 4 * 8;
+    std::vector<GByte> abyBuffer;
+    SAOffset nBufferOffset = 0;
+    size_t nBufferSize = 0;
+    try
+    {
+        abyBuffer.resize(BUFFER_SIZE);
+        asItems.reserve(hSHP->nRecords);
+
+        for (int iShape = 0; iShape < hSHP->nRecords; ++iShape)
+        {
+            const unsigned nContentSize = hSHP->panRecSize[iShape];
+            if (hSHP->panRecOffset[iShape] == 0 || nContentSize < 4)
+                continue;
+            const SAOffset nOffset = hSHP->panRecOffset[iShape];
+            const unsigned nToRead =
+                std::min(MAX_HEADER_SIZE, 8 + nContentSize);
+            if (nOffset < nBufferOffset ||
+                nOffset + nToRead > nBufferOffset + nBufferSize)
+            {
+                if (hSHP->sHooks.FSeek(hSHP->fpSHP, nOffset, 0) != 0)
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Cannot seek to shape %d", iShape);
+                    return nullptr;
+                }
+                nBufferOffset = nOffset;
+                nBufferSize = hSHP->sHooks.FRead(abyBuffer.data(), 1,
+                                                 BUFFER_SIZE, hSHP->fpSHP);
+                if (nBufferSize < nToRead)
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Cannot read shape %d", iShape);
+                    return nullptr;
+                }
+            }
+            const GByte *pabyRec =
+                abyBuffer.data() + static_cast<size_t>(nOffset - nBufferOffset);
+
+            Item sItem;
+            const int nSHPType = static_cast<int>(ReadUInt32(pabyRec + 8));
+            if (nSHPType == SHPT_NULL)
+                continue;
+            if (nSHPType == SHPT_POINT || nSHPType == SHPT_POINTM ||
+                nSHPType == SHPT_POINTZ)
+            {
+                if (nContentSize < 4 + 2 * 8)
+                    continue;
+                sItem.dfMinX = ReadDouble(pabyRec + 12);
+                sItem.dfMinY = ReadDouble(pabyRec + 12 + 8);
+                sItem.dfMaxX = sItem.dfMinX;
+                sItem.dfMaxY = sItem.dfMinY;
+            }
+            else
+            {
+                if (nContentSize < 4 + 4 * 8)
+                    continue;
+                sItem.dfMinX = ReadDouble(pabyRec + 12);
+                sItem.dfMinY = ReadDouble(pabyRec + 12 + 8);
+                sItem.dfMaxX = ReadDouble(pabyRec + 12 + 2 * 8);
+                sItem.dfMaxY = ReadDouble(pabyRec + 12 + 3 * 8);
+            }
+            // Also rejects NaN
+            if (!(sItem.dfMinX <= sItem.dfMaxX &&
+                  sItem.dfMinY <= sItem.dfMaxY) ||
+                !std::isfinite(sItem.dfMinX) || !std::isfinite(sItem.dfMaxX) ||
+                !std::isfinite(sItem.dfMinY) || !std::isfinite(sItem.dfMaxY))
+            {
+                continue;
+            }
+            sItem.nHilbert = 0;
+            sItem.nShapeId = iShape;
+            sExtent.Merge(sItem.dfMinX, sItem.dfMinY);
+            sExtent.Merge(sItem.dfMaxX, sItem.dfMaxY);
+            asItems.push_back(sItem);
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory when building spatial index");
+        return nullptr;
+    }
+
+    auto poTree = std::unique_ptr<OGRShapeHilbertRTree>(
+        new OGRShapeHilbertRTree());
+    poTree->m_nRecords = hSHP->nRecords;
+    poTree->m_nItems = static_cast<int>(asItems.size());
+    poTree->m_nNodeSize = nNodeSize;
+    poTree->m_nSHPFileSize = hSHP->nFileSize;
+    poTree->m_nSHPMTime = nSHPMTime;
+    if (!asItems.empty())
+        poTree->m_sExtent = sExtent;
+    if (!poTree->ComputeLevels())
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Too many shapes to build spatial index");
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Sort items along the Hilbert curve of their center.             */
+    /* -------------------------------------------------------------------- */
+    const double dfWidth = sExtent.MaxX - sExtent.MinX;
+    const double dfHeight = sExtent.MaxY - sExtent.MinY;
+    constexpr double HILBERT_MAX = 0xFFFF;
+    for (auto &sItem : asItems)
+    {
+        const double dfX =
+            dfWidth > 0 ? HILBERT_MAX *
+                              ((sItem.dfMinX + sItem.dfMaxX) / 2 -
+                               sExtent.MinX) /
+                              dfWidth
+                        : 0;
+        const double dfY =
+            dfHeight > 0 ? HILBERT_MAX *
+                               ((sItem.dfMinY + sItem.dfMaxY) / 2 -
+                                sExtent.MinY) /
+                               dfHeight
+                         : 0;
+        sItem.nHilbert = OGRHilbertIndex(static_cast<uint32_t>(dfX),
+                                         static_cast<uint32_t>(dfY));
+    }
+    std::sort(asItems.begin(), asItems.end(),
+              [](const Item &a, const Item &b)
+              {
+                  if (a.nHilbert != b.nHilbert)
+                      return a.nHilbert < b.nHilbert;
+                  return a.nShapeId < b.nShapeId;
+              });
+
+    /* -------------------------------------------------------------------- */
+    /*      Fill leaves, and then upper levels from bottom to top.          */
+    /* -------------------------------------------------------------------- */
+    try
+    {
+        poTree->m_abyNodes.resize(
+            static_cast<size_t>(poTree->m_nNodes) * HRT_NODE_SIZE_IN_BYTES);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory when building spatial index");
+        return nullptr;
+    }
+    GByte *pabyNodes = poTree->m_abyNodes.data();
+    const auto WriteNode = [pabyNodes](uint64_t nIdx, double dfMinX,
+                                       double dfMinY, double dfMaxX,
+                                       double dfMaxY, uint64_t nValue)
+    {
+        GByte *pabyNode =
+            pabyNodes + static_cast<size_t>(nIdx) * HRT_NODE_SIZE_IN_BYTES;
+        WriteDouble(pabyNode, dfMinX);
+        WriteDouble(pabyNode + 8, dfMinY);
+        WriteDouble(pabyNode + 16, dfMaxX);
+        WriteDouble(pabyNode + 24, dfMaxY);
+        WriteUInt64(pabyNode + 32, nValue);
+    };
+
+    if (!asItems.empty())
+    {
+        const uint64_t nLeafStart = poTree->m_anLevelStart[0];
+        for (size_t i = 0; i < asItems.size(); ++i)
+        {
+            const auto &sItem = asItems[i];
+            WriteNode(nLeafStart + i, sItem.dfMinX, sItem.dfMinY, sItem.dfMaxX,
+                      sItem.dfMaxY, static_cast<uint64_t>(sItem.nShapeId));
+        }
+    }
+
+    const size_t nLevels = poTree->m_anLevelStart.size();
+    for (size_t iLevel = 0; iLevel + 1 < nLevels; ++iLevel)
+    {
+        const uint64_t nStart = poTree->m_anLevelStart[iLevel];
+        const uint64_t nEnd = iLevel == 0
+                                  ? poTree->m_nNodes
+                                  : poTree->m_anLevelStart[iLevel - 1];
+        uint64_t nParent = poTree->m_anLevelStart[iLevel + 1];
+        for (uint64_t nFirstChild = nStart; nFirstChild < nEnd;
+             nFirstChild += nNodeSize, ++nParent)
+        {
+            const uint64_t nLastChild =
+                std::min(nEnd, nFirstChild + static_cast<uint64_t>(nNodeSize));
+            OGREnvelope sNodeEnvelope;
+            for (uint64_t nChild = nFirstChild; nChild < nLastChild; ++nChild)
+            {
+                const GByte *pabyNode =
+                    pabyNodes +
+                    static_cast<size_t>(nChild) * HRT_NODE_SIZE_IN_BYTES;
+                sNodeEnvelope.Merge(ReadDouble(pabyNode),
+                                    ReadDouble(pabyNode + 8));
+                sNodeEnvelope.Merge(ReadDouble(pabyNode + 16),
+                                    ReadDouble(pabyNode + 24));
+            }
+            WriteNode(nParent, sNodeEnvelope.MinX, sNodeEnvelope.MinY,
+                      sNodeEnvelope.MaxX, sNodeEnvelope.MaxY, nFirstChild);
+        }
+    }
+
+    poTree->m_pabyNodes = pabyNodes;
+    return poTree;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+// Write the tree to a temporary file that is then renamed to pszFilename,
+// so that concurrent readers never see a partially written index.
+// Does not emit errors.
+bool OGRShapeHilbertRTree::Write(const char *pszFilename) const
+{
+    const std::string osTmpFilename = std::string(pszFilename) + ".tmp";
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+        return false;
+
+    GByte abyHeader[HRT_HEADER_SIZE] = {0};
+    memcpy(abyHeader, HRT_MAGIC, 8);
+    WriteUInt32(abyHeader + 8, static_cast<uint32_t>(m_nRecords));
+    WriteUInt32(abyHeader + 12, static_cast<uint32_t>(m_nItems));
+    WriteUInt32(abyHeader + 16, m_nSHPFileSize);
+    uint16_t nNodeSize = static_cast<uint16_t>(m_nNodeSize);
+    CPL_LSBPTR16(&nNodeSize);
+    memcpy(abyHeader + 20, &nNodeSize, sizeof(nNodeSize));
+    WriteDouble(abyHeader + 24, m_sExtent.MinX);
+    WriteDouble(abyHeader + 32, m_sExtent.MinY);
+    WriteDouble(abyHeader + 40, m_sExtent.MaxX);
+    WriteDouble(abyHeader + 48, m_sExtent.MaxY);
+    WriteUInt64(abyHeader + 56, static_cast<uint64_t>(m_nSHPMTime));
+
+    const size_t nNodesSize =
+        static_cast<size_t>(m_nNodes) * HRT_NODE_SIZE_IN_BYTES;
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+    if (bOK && nNodesSize > 0)
+        bOK = VSIFWriteL(m_pabyNodes, nNodesSize, 1, fp) == 1;
+    bOK = VSIFCloseL(fp) == 0 && bOK;
+    if (bOK && VSIRename(osTmpFilename.c_str(), pszFilename) != 0)
+    {
+        // Renaming over an existing file is not possible on Windows
+        VSIUnlink(pszFilename);
+        bOK = VSIRename(osTmpFilename.c_str(), pszFilename) == 0;
+    }
+    if (!bOK)
+    {
+        CPLDebug("SHAPE", "Cannot write %s", pszFilename);
+        VSIUnlink(osTmpFilename.c_str());
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+// Open an existing .hrt file. Nodes are memory-mapped when the file is a
+// regular file of the operating system, and otherwise loaded in memory.
+// Returns nullptr if the file does not exist, is corrupted or does not
+// correspond to the current state of the .shp file.
+std::unique_ptr<OGRShapeHilbertRTree>
+OGRShapeHilbertRTree::Open(const char *pszFilename, SHPHandle hSHP,
+                           GIntBig nSHPMTime)
+{
+    VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+    if (fp == nullptr)
+        return nullptr;
+
+    auto poTree = std::unique_ptr<OGRShapeHilbertRTree>(
+        new OGRShapeHilbertRTree());
+    poTree->m_fp = fp;
+
+    GByte abyHeader[HRT_HEADER_SIZE];
+    if (VSIFReadL(abyHeader, sizeof(abyHeader), 1, fp) != 1 ||
+        memcmp(abyHeader, HRT_MAGIC, 8) != 0)
+    {
+        CPLDebug("SHAPE", "%s is not a valid spatial index file",
+                 pszFilename);
+        return nullptr;
+    }
+    poTree->m_nRecords = static_cast<int>(ReadUInt32(abyHeader + 8));
+    poTree->m_nItems = static_cast<int>(ReadUInt32(abyHeader + 12));
+    poTree->m_nSHPFileSize = ReadUInt32(abyHeader + 16);
+    uint16_t nNodeSize;
+    memcpy(&nNodeSize, abyHeader + 20, sizeof(nNodeSize));
+    CPL_LSBPTR16(&nNodeSize);
+    poTree->m_nNodeSize = nNodeSize;
+    poTree->m_sExtent.MinX = ReadDouble(abyHeader + 24);
+    poTree->m_sExtent.MinY = ReadDouble(abyHeader + 32);
+    poTree->m_sExtent.MaxX = ReadDouble(abyHeader + 40);
+    poTree->m_sExtent.MaxY = ReadDouble(abyHeader + 48);
+    poTree->m_nSHPMTime = static_cast<GIntBig>(ReadUInt64(abyHeader + 56));
+
+    // The modification time catches edits that keep the same file size
+    if (poTree->m_nRecords != hSHP->nRecords ||
+        poTree->m_nSHPFileSize != hSHP->nFileSize ||
+        poTree->m_nSHPMTime != nSHPMTime)
+    {
+        CPLDebug("SHAPE",
+                 "%s does not match the current content of the .shp file. "
+                 "Ignoring it",
+                 pszFilename);
+        return nullptr;
+    }
+    if (poTree->m_nNodeSize < 2 || poTree->m_nItems < 0 ||
+        poTree->m_nItems > poTree->m_nRecords || !poTree->ComputeLevels())
+    {
+        CPLDebug("SHAPE", "%s is corrupted", pszFilename);
+        return nullptr;
+    }
+
+    const vsi_l_offset nNodesSize =
+        static_cast<vsi_l_offset>(poTree->m_nNodes) * HRT_NODE_SIZE_IN_BYTES;
+    if (VSIFSeekL(fp, 0, SEEK_END) != 0 ||
+        VSIFTellL(fp) != HRT_HEADER_SIZE + nNodesSize)
+    {
+        CPLDebug("SHAPE", "%s has not the expected size", pszFilename);
+        return nullptr;
+    }
+    if (nNodesSize == 0)
+        return poTree;
+
+    if (CPLIsVirtualMemFileMapAvailable())
+    {
+        poTree->m_psVirtualMem =
+            CPLVirtualMemFileMapNew(fp, 0, HRT_HEADER_SIZE + nNodesSize,
+                                    VIRTUALMEM_READONLY, nullptr, nullptr);
+    }
+    if (poTree->m_psVirtualMem)
+    {
+        const GByte *pabyData = static_cast<const GByte *>(
+            CPLVirtualMemGetAddr(poTree->m_psVirtualMem));
+        poTree->m_pabyNodes = pabyData + HRT_HEADER_SIZE;
+    }
+    else
+    {
+        try
+        {
+            poTree->m_abyNodes.resize(static_cast<size_t>(nNodesSize));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory when loading %s", pszFilename);
+            return nullptr;
+        }
+        if (VSIFSeekL(fp, HRT_HEADER_SIZE, SEEK_SET) != 0 ||
+            VSIFReadL(poTree->m_abyNodes.data(), poTree->m_abyNodes.size(), 1,
+                      fp) != 1)
+        {
+            CPLDebug("SHAPE", "Cannot read %s", pszFilename);
+            return nullptr;
+        }
+        poTree->m_pabyNodes = poTree->m_abyNodes.data();
+        VSIFCloseL(fp);
+        poTree->m_fp = nullptr;
+    }
+
+    return poTree;
+}
+
+/************************************************************************/
+/*                               Search()                               */
+/************************************************************************/
+
+// Return the ids, in ascending order, of the shapes whose bounding box
+// intersects sEnvelope.
+std::vector<int>
+OGRShapeHilbertRTree::Search(const OGREnvelope &sEnvelope) const
+{
+    std::vector<int> anShapeIds;
+    if (m_nNodes == 0 || !sEnvelope.Intersects(m_sExtent))
+        return anShapeIds;
+
+    const uint64_t nLeafStart = m_anLevelStart[0];
+    std::vector<uint64_t> anStack;
+    anStack.push_back(0);
+    while (!anStack.empty())
+    {
+        const uint64_t nIdx = anStack.back();
+        anStack.pop_back();
+
+        const GByte *pabyNode =
+            m_pabyNodes + static_cast<size_t>(nIdx) * HRT_NODE_SIZE_IN_BYTES;
+        if (ReadDouble(pabyNode) > sEnvelope.MaxX ||
+            ReadDouble(pabyNode + 8) > sEnvelope.MaxY ||
+            ReadDouble(pabyNode + 16) < sEnvelope.MinX ||
+            ReadDouble(pabyNode + 24) < sEnvelope.MinY)
+        {
+            continue;
+        }
+
+        const uint64_t nValue = ReadUInt64(pabyNode + 32);
+        if (nIdx >= nLeafStart)
+        {
+            if (nValue < static_cast<uint64_t>(m_nRecords))
+                anShapeIds.push_back(static_cast<int>(nValue));
+            continue;
+        }
+
+        // Children are all in the level below the one of the current node.
+        uint64_t nLevelEnd = m_nNodes;
+        for (size_t iLevel = 0; iLevel < m_anLevelStart.size(); ++iLevel)
+        {
+            if (nValue >= m_anLevelStart[iLevel])
+            {
+                nLevelEnd = iLevel == 0 ? m_nNodes : m_anLevelStart[iLevel - 1];
+                break;
+            }
+        }
+        // nValue <= nIdx would mean a corrupted file, causing infinite loops
+        if (nValue <= nIdx || nValue >= nLevelEnd)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Corrupted spatial index: invalid child index");
+            anShapeIds.clear();
+            return anShapeIds;
+        }
+        const uint64_t nChildEnd = std::min(
+            nLevelEnd, nValue + static_cast<uint64_t>(m_nNodeSize));
+        for (uint64_t nChild = nChildEnd; nChild > nValue; --nChild)
+            anStack.push_back(nChild - 1);
+    }
+
+    std::sort(anShapeIds.begin(), anShapeIds.end());
+    return anShapeIds;
+}
@@ -612,6 +612,105 @@ bool OGRShapeLayer::CheckForSBN()
     return m_hSBN != nullptr;
 }
 
+/************************************************************************/
+/*                        CheckForHilbertRTree()                        */
+/************************************************************************/
+
+bool OGRShapeLayer::CheckForHilbertRTree()
+
+{
+    if (m_bCheckedForHilbertRTree)
+        return m_poHilbertRTree != nullptr;
+
+    m_bCheckedForHilbertRTree = true;
+    if (m_hSHP == nullptr)
+        return false;
+
+    const std::string osHRTFilename =
+        CPLResetExtensionSafe(m_osFullName.c_str(), "hrt");
+
+    m_poHilbertRTree = OGRShapeHilbertRTree::Open(
+        osHRTFilename.c_str(), m_hSHP, GetSHPModificationTime());
+    m_bHilbertRTreeInMemory = false;
+
+    return m_poHilbertRTree != nullptr;
+}
+
+/************************************************************************/
+/*                       GetSHPModificationTime()                       */
+/************************************************************************/
+
+// Used to detect a .hrt file that is out of date. Returns 0 if unknown.
+GIntBig OGRShapeLayer::GetSHPModificationTime() const
+
+{
+    for (const char *pszExt : {"shp", "SHP"})
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(CPLResetExtensionSafe(m_osFullName.c_str(), pszExt)
+                         .c_str(),
+                     &sStat) == 0)
+        {
+            return static_cast<GIntBig>(sStat.st_mtime);
+        }
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                       AutoBuildHilbertRTree()                        */
+/*                                                                      */
+/*      Build a spatial index at the first spatial filter query on      */
+/*      large layers that have none, as controlled by the               */
+/*      SHAPE_AUTO_SPATIAL_INDEX and                                    */
+/*      SHAPE_AUTO_SPATIAL_INDEX_MIN_FEATURES configuration options.    */
+/*      The index is kept in memory, unless SHAPE_AUTO_SPATIAL_INDEX    */
+/*      is set to YES.                                                  */
+/************************************************************************/
+
+bool OGRShapeLayer::AutoBuildHilbertRTree()
+
+{
+    if (m_bTriedAutoBuildHilbertRTree || m_bUpdateAccess || m_hSHP == nullptr)
+        return false;
+    m_bTriedAutoBuildHilbertRTree = true;
+
+    const char *pszAuto =
+        CPLGetConfigOption("SHAPE_AUTO_SPATIAL_INDEX", "IN_MEMORY");
+    const bool bInMemory = EQUAL(pszAuto, "IN_MEMORY");
+    if (!bInMemory && !CPLTestBool(pszAuto))
+        return false;
+    const int nMinFeatures = atoi(CPLGetConfigOption(
+        "SHAPE_AUTO_SPATIAL_INDEX_MIN_FEATURES", "1000000"));
+    if (m_hSHP->nRecords < nMinFeatures)
+        return false;
+
+    CPLDebug("SHAPE", "Automatically building spatial index for %s",
+             m_osFullName.c_str());
+    m_poHilbertRTree = OGRShapeHilbertRTree::Build(
+        m_hSHP, OGRShapeHilbertRTree::DEFAULT_NODE_SIZE,
+        GetSHPModificationTime());
+    if (m_poHilbertRTree == nullptr)
+        return false;
+    m_bCheckedForHilbertRTree = true;
+    m_bHilbertRTreeInMemory = true;
+
+    // Persist it when asked and possible, so that next openings benefit
+    // from it.
+    if (!bInMemory && !m_poDS->IsZip())
+    {
+        const std::string osHRTFilename =
+            CPLResetExtensionSafe(m_osFullName.c_str(), "hrt");
+        if (m_poHilbertRTree->Write(osHRTFilename.c_str()))
+        {
+            CPLDebug("SHAPE", "Created index file %s", osHRTFilename.c_str());
+            m_bHilbertRTreeInMemory = false;
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                            ScanIndices()                             */
 /*                                                                      */
@@ -675,16 +774,24 @@ bool OGRShapeLayer::ScanIndices()
 
     if (bTryQIXorSBN)
     {
-        if (!m_bCheckedForQIX)
+        if (!m_bCheckedForHilbertRTree)
+            CPL_IGNORE_RET_VAL(CheckForHilbertRTree());
+        if (m_poHilbertRTree == nullptr && !m_bCheckedForQIX)
             CPL_IGNORE_RET_VAL(CheckForQIX());
-        if (m_hQIX == nullptr && !m_bCheckedForSBN)
+        if (m_poHilbertRTree == nullptr && m_hQIX == nullptr &&
+            !m_bCheckedForSBN)
             CPL_IGNORE_RET_VAL(CheckForSBN());
+        if (m_poHilbertRTree == nullptr && m_hQIX == nullptr &&
+            m_hSBN == nullptr)
+            CPL_IGNORE_RET_VAL(AutoBuildHilbertRTree());
     }
 
     /* -------------------------------------------------------------------- */
     /*      Compute spatial index if appropriate.                           */
     /* -------------------------------------------------------------------- */
-    if (bTryQIXorSBN && (m_hQIX != nullptr || m_hSBN != nullptr) &&
+    if (bTryQIXorSBN &&
+        (m_poHilbertRTree != nullptr || m_hQIX != nullptr ||
+         m_hSBN != nullptr) &&
         m_panSpatialFIDs == nullptr)
     {
         double adfBoundsMin[4] = {oSpatialFilterEnvelope.MinX,
@@ -692,7 +799,18 @@ bool OGRShapeLayer::ScanIndices()
         double adfBoundsMax[4] = {oSpatialFilterEnvelope.MaxX,
                                   oSpatialFilterEnvelope.MaxY, 0.0, 0.0};
 
-        if (m_hQIX != nullptr)
+        if (m_poHilbertRTree != nullptr)
+        {
+            const auto anShapeIds =
+                m_poHilbertRTree->Search(oSpatialFilterEnvelope);
+            m_nSpatialFIDCount = static_cast<int>(anShapeIds.size());
+            m_panSpatialFIDs = static_cast<int *>(
+                malloc(sizeof(int) * std::max<size_t>(1, anShapeIds.size())));
+            if (m_panSpatialFIDs != nullptr && !anShapeIds.empty())
+                memcpy(m_panSpatialFIDs, anShapeIds.data(),
+                       sizeof(int) * anShapeIds.size());
+        }
+        else if (m_hQIX != nullptr)
             m_panSpatialFIDs = SHPSearchDiskTreeEx(
                 m_hQIX, adfBoundsMin, adfBoundsMax, &m_nSpatialFIDCount);
         else
@@ -1088,7 +1206,7 @@ OGRErr OGRShapeLayer::ISetFeature(OGRFeature *poFeature)
     }
 
     m_bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHilbertRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     unsigned int nOffset = 0;
@@ -1166,7 +1284,7 @@ OGRErr OGRShapeLayer::DeleteFeature(GIntBig nFID)
         return OGRERR_FAILURE;
 
     m_bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHilbertRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
     m_eNeedRepack = YES;
 
@@ -1190,7 +1308,7 @@ OGRErr OGRShapeLayer::ICreateFeature(OGRFeature *poFeature)
     }
 
     m_bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHilbertRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     poFeature->SetFID(OGRNullFID);
@@ -1788,7 +1906,8 @@ int OGRShapeLayer::TestCapability(const char *pszCap)
 
     if (EQUAL(pszCap, OLCFastFeatureCount))
     {
-        if (!(m_poFilterGeom == nullptr || CheckForQIX() || CheckForSBN()))
+        if (!(m_poFilterGeom == nullptr || CheckForHilbertRTree() ||
+              CheckForQIX() || CheckForSBN()))
             return FALSE;
 
         if (m_poAttrQuery != nullptr)
@@ -1803,7 +1922,7 @@ int OGRShapeLayer::TestCapability(const char *pszCap)
         return m_bUpdateAccess;
 
     if (EQUAL(pszCap, OLCFastSpatialFilter))
-        return CheckForQIX() || CheckForSBN();
+        return CheckForHilbertRTree() || CheckForQIX() || CheckForSBN();
 
     if (EQUAL(pszCap, OLCFastGetExtent))
         return TRUE;
@@ -2632,7 +2751,7 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     if (!StartUpdate("DropSpatialIndex"))
         return OGRERR_FAILURE;
 
-    if (!CheckForQIX() && !CheckForSBN())
+    if (!CheckForHilbertRTree() && !CheckForQIX() && !CheckForSBN())
     {
         CPLError(CE_Warning, CPLE_AppDefined,
                  "Layer %s has no spatial index, DROP SPATIAL INDEX failed.",
@@ -2640,8 +2759,14 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
         return OGRERR_FAILURE;
     }
 
+    const bool bHadHRT =
+        m_poHilbertRTree != nullptr && !m_bHilbertRTreeInMemory;
     const bool bHadQIX = m_hQIX != nullptr;
 
+    m_poHilbertRTree.reset();
+    m_bHilbertRTreeInMemory = false;
+    m_bCheckedForHilbertRTree = false;
+
     SHPCloseDiskTree(m_hQIX);
     m_hQIX = nullptr;
     m_bCheckedForQIX = false;
@@ -2650,6 +2775,21 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     m_hSBN = nullptr;
     m_bCheckedForSBN = false;
 
+    if (bHadHRT)
+    {
+        const std::string osHRTFilename =
+            CPLResetExtensionSafe(m_osFullName.c_str(), "hrt");
+        CPLDebug("SHAPE", "Unlinking index file %s", osHRTFilename.c_str());
+
+        if (VSIUnlink(osHRTFilename.c_str()) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to delete file %s.\n%s", osHRTFilename.c_str(),
+                     VSIStrerror(errno));
+            return OGRERR_FAILURE;
+        }
+    }
+
     if (bHadQIX)
     {
         const std::string osQIXFilename =
@@ -2702,7 +2842,7 @@ OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
     /* -------------------------------------------------------------------- */
     /*      If we have an existing spatial index, blow it away first.       */
     /* -------------------------------------------------------------------- */
-    if (CheckForQIX())
+    if (CheckForHilbertRTree() || CheckForQIX())
         DropSpatialIndex();
 
     m_bCheckedForQIX = false;
@@ -2748,6 +2888,57 @@ OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                   CreateHilbertRTreeSpatialIndex()                   */
+/************************************************************************/
+
+OGRErr OGRShapeLayer::CreateHilbertRTreeSpatialIndex()
+
+{
+    if (!StartUpdate("CreateSpatialIndex"))
+        return OGRERR_FAILURE;
+
+    if (m_hSHP == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Layer %s has no geometry, CREATE SPATIAL INDEX failed.",
+                 m_poFeatureDefn->GetName());
+        return OGRERR_FAILURE;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      If we have an existing spatial index, blow it away first.       */
+    /* -------------------------------------------------------------------- */
+    if (CheckForHilbertRTree() || CheckForQIX() || CheckForSBN())
+        DropSpatialIndex();
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the tree and write it to the .hrt file.                   */
+    /* -------------------------------------------------------------------- */
+    OGRShapeLayer::SyncToDisk();
+    auto poTree = OGRShapeHilbertRTree::Build(
+        m_hSHP, OGRShapeHilbertRTree::DEFAULT_NODE_SIZE,
+        GetSHPModificationTime());
+    if (poTree == nullptr)
+        return OGRERR_FAILURE;
+
+    const std::string osHRTFilename =
+        CPLResetExtensionSafe(m_osFullName.c_str(), "hrt");
+    CPLDebug("SHAPE", "Creating index file %s", osHRTFilename.c_str());
+    if (!poTree->Write(osHRTFilename.c_str()))
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write %s",
+                 osHRTFilename.c_str());
+        return OGRERR_FAILURE;
+    }
+
+    m_poHilbertRTree = std::move(poTree);
+    m_bHilbertRTreeInMemory = false;
+    m_bCheckedForHilbertRTree = true;
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                       CheckFileDeletion()                            */
 /************************************************************************/
@@ -2923,7 +3114,7 @@ OGRErr OGRShapeLayer::Repack()
     /*      Cleanup any existing spatial index.  It will become             */
     /*      meaningless when the fids change.                               */
     /* -------------------------------------------------------------------- */
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHilbertRTree() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     /* -------------------------------------------------------------------- */
@@ -3664,6 +3855,13 @@ void OGRShapeLayer::CloseUnderlyingLayer()
     m_hSBN = nullptr;
     m_bCheckedForSBN = false;
 
+    // An index that only lives in memory cannot be re-opened.
+    if (!m_bHilbertRTreeInMemory)
+    {
+        m_poHilbertRTree.reset();
+        m_bCheckedForHilbertRTree = false;
+    }
+
     m_eFileDescriptorsState = FD_CLOSED;
 }
 
@@ -3711,6 +3909,13 @@ void OGRShapeLayer::AddToFileList(CPLStringList &oFileList)
             oFileList.AddStringDirectly(
                 VSIGetCanonicalFilename(poGeomFieldDefn->GetPrjFilename()));
         }
+        if (CheckForHilbertRTree() && !m_bHilbertRTreeInMemory)
+        {
+            const std::string osHRTFilename =
+                CPLResetExtensionSafe(m_osFullName.c_str(), "hrt");
+            oFileList.AddStringDirectly(
+                VSIGetCanonicalFilename(osHRTFilename.c_str()));
+        }
         if (CheckForQIX())
         {
             const std::string osQIXFilename =
@@ -3852,9 +4057,12 @@ GDALDataset *OGRShapeLayer::GetDataset()
 /*                        GetNextArrowArray()                           */
 /************************************************************************/
 
-// Specialized implementation restricted to situations where only retrieving
-// of FID values is asked (without filters)
-// In other cases, fall back to generic implementation.
+// Specialized implementation that decodes DBF records and SHP shapes directly
+// into Arrow buffers, without going through OGRFeature.
+// DBF records are read by blocks of consecutive records, and attributes are
+// then decoded column by column.
+// Attribute filters, as well as spatial filters on layers whose geometry is
+// ignored, fall back to the generic implementation.
 int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                                      struct ArrowArray *out_array)
 {
@@ -3865,21 +4073,46 @@ int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         return EIO;
     }
 
-    if (!m_hDBF || m_poAttrQuery != nullptr || m_poFilterGeom != nullptr)
+    if (m_poAttrQuery != nullptr ||
+        CPLTestBool(CPLGetConfigOption("OGR_SHAPE_STREAM_BASE_IMPL", "NO")))
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    // Pending modifications of the current DBF record would be missed by
+    // our direct reads.
+    if (m_hDBF && (m_hDBF->bCurrentRecordModified ||
+                   (m_hSHP && m_hSHP->nRecords != m_hDBF->nRecords)))
     {
         return OGRLayer::GetNextArrowArray(stream, out_array);
     }
 
-    // If any field is not ignored, use generic implementation
     const int nFieldCount = m_poFeatureDefn->GetFieldCount();
     for (int i = 0; i < nFieldCount; ++i)
     {
-        if (!m_poFeatureDefn->GetFieldDefn(i)->IsIgnored())
-            return OGRLayer::GetNextArrowArray(stream, out_array);
+        const OGRFieldDefn *poFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            continue;
+        switch (poFieldDefn->GetType())
+        {
+            case OFTString:
+            case OFTInteger:
+            case OFTInteger64:
+            case OFTReal:
+            case OFTDate:
+                break;
+            default:
+                return OGRLayer::GetNextArrowArray(stream, out_array);
+        }
     }
-    if (GetGeomType() != wkbNone &&
-        !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored())
+
+    const bool bReadGeometry =
+        m_hSHP != nullptr && m_poFeatureDefn->GetGeomFieldCount() == 1 &&
+        !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored();
+    if (m_poFilterGeom != nullptr && !bReadGeometry)
+    {
         return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
 
     OGRArrowArrayHelper sHelper(m_poDS, m_poFeatureDefn,
                                 m_aosArrowArrayStreamOptions, out_array);
@@ -3888,38 +4121,426 @@ int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         return ENOMEM;
     }
 
-    if (!sHelper.m_bIncludeFID)
+    if (sHelper.m_nChildren == 0)
     {
         out_array->release(out_array);
         return OGRLayer::GetNextArrowArray(stream, out_array);
     }
 
     m_bLastGetNextArrowArrayUsedOptimizedCodePath = true;
-    int nCount = 0;
-    while (m_iNextShapeId < m_nTotalShapeCount)
+
+    if (m_poFilterGeom != nullptr && m_iNextShapeId == 0 &&
+        m_iMatchingFID == 0 && m_panMatchingFIDs == nullptr)
+    {
+        ScanIndices();
+    }
+
+    const int iGeomArrowField =
+        bReadGeometry ? sHelper.m_mapOGRGeomFieldToArrowField[0] : -1;
+    const OGRwkbGeometryType eLayerGeomType =
+        bReadGeometry ? m_poFeatureDefn->GetGeomFieldDefn(0)->GetType()
+                      : wkbNone;
+    const int nRecordLength = m_hDBF ? m_hDBF->nRecordLength : 0;
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+
+    // Number of DBF records read in a single I/O operation
+    const int nMaxChunkSize = std::max(
+        1, std::min(sHelper.m_nMaxBatchSize,
+                    nRecordLength > 0 ? (1024 * 1024) / nRecordLength : 4096));
+
+    std::vector<int> anShapeIds;
+    std::vector<GByte> abyRecords;
+    std::vector<const char *> apszRecords;
+    std::vector<GByte> abyWKB;
+    std::string osTmp;
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    const auto ReturnError = [out_array]()
     {
-        const bool bIsDeleted =
-            CPL_TO_BOOL(DBFIsRecordDeleted(m_hDBF, m_iNextShapeId));
-        if (bIsDeleted)
+        out_array->release(out_array);
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    };
+
+    int iFeat = 0;
+    bool bStop = false;
+    while (!bStop && iFeat < sHelper.m_nMaxBatchSize)
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Collect the next chunk of candidate shape ids.              */
+        /* ---------------------------------------------------------------- */
+        const int nChunkSize =
+            std::min(nMaxChunkSize, sHelper.m_nMaxBatchSize - iFeat);
+        anShapeIds.clear();
+        if (m_panMatchingFIDs != nullptr)
         {
-            ++m_iNextShapeId;
-            continue;
+            while (static_cast<int>(anShapeIds.size()) < nChunkSize &&
+                   m_panMatchingFIDs[m_iMatchingFID] != OGRNullFID)
+            {
+                anShapeIds.push_back(
+                    static_cast<int>(m_panMatchingFIDs[m_iMatchingFID]));
+                ++m_iMatchingFID;
+            }
         }
-        if (VSIFEofL(VSI_SHP_GetVSIL(m_hDBF->fp)) ||
-            VSIFErrorL(VSI_SHP_GetVSIL(m_hDBF->fp)))
+        else
         {
-            out_array->release(out_array);
-            memset(out_array, 0, sizeof(*out_array));
-            return EIO;
+            while (static_cast<int>(anShapeIds.size()) < nChunkSize &&
+                   m_iNextShapeId < m_nTotalShapeCount)
+            {
+                anShapeIds.push_back(m_iNextShapeId);
+                ++m_iNextShapeId;
+            }
         }
-        sHelper.m_panFIDValues[nCount] = m_iNextShapeId;
-        ++m_iNextShapeId;
-        ++nCount;
-        if (nCount == sHelper.m_nMaxBatchSize)
+        if (anShapeIds.empty())
             break;
+        const int nCandidates = static_cast<int>(anShapeIds.size());
+
+        /* ---------------------------------------------------------------- */
+        /*      Read the DBF records, by runs of consecutive records.       */
+        /* ---------------------------------------------------------------- */
+        if (m_hDBF)
+        {
+            abyRecords.resize(static_cast<size_t>(nCandidates) *
+                              nRecordLength);
+            for (int i = 0; i < nCandidates;)
+            {
+                int j = i + 1;
+                while (j < nCandidates &&
+                       anShapeIds[j] == anShapeIds[j - 1] + 1)
+                    ++j;
+                const SAOffset nOffset =
+                    static_cast<SAOffset>(nRecordLength) * anShapeIds[i] +
+                    m_hDBF->nHeaderLength;
+                if (m_hDBF->sHooks.FSeek(m_hDBF->fp, nOffset, SEEK_SET) != 0 ||
+                    m_hDBF->sHooks.FRead(
+                        abyRecords.data() +
+                            static_cast<size_t>(i) * nRecordLength,
+                        nRecordLength, j - i, m_hDBF->fp) !=
+                        static_cast<SAOffset>(j - i))
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Cannot read DBF records %d to %d", anShapeIds[i],
+                             anShapeIds[j - 1]);
+                    return ReturnError();
+                }
+                i = j;
+            }
+            m_hDBF->bRequireNextWriteSeek = TRUE;
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Process shapes and FIDs, row by row.                        */
+        /* ---------------------------------------------------------------- */
+        apszRecords.clear();
+        const int iFeatChunkStart = iFeat;
+        for (int iCandidate = 0; iCandidate < nCandidates; ++iCandidate)
+        {
+            const int iShape = anShapeIds[iCandidate];
+            const char *pszRecord =
+                m_hDBF ? reinterpret_cast<const char *>(abyRecords.data()) +
+                             static_cast<size_t>(iCandidate) * nRecordLength
+                       : nullptr;
+            if (pszRecord && *pszRecord == '*')
+                continue;  // deleted record
+
+            if (bReadGeometry)
+            {
+                SHPObject *psShape = SHPReadObject(m_hSHP, iShape);
+                if (m_poFilterGeom != nullptr && psShape != nullptr &&
+                    psShape->nSHPType != SHPT_NULL &&
+                    (psShape->nSHPType == SHPT_POINT ||
+                     psShape->nSHPType == SHPT_POINTZ ||
+                     psShape->nSHPType == SHPT_POINTM ||
+                     (psShape->dfXMin != psShape->dfXMax &&
+                      psShape->dfYMin != psShape->dfYMax)) &&
+                    (m_sFilterEnvelope.MaxX < psShape->dfXMin ||
+                     m_sFilterEnvelope.MaxY < psShape->dfYMin ||
+                     psShape->dfXMax < m_sFilterEnvelope.MinX ||
+                     psShape->dfYMax < m_sFilterEnvelope.MinY))
+                {
+                    SHPDestroyObject(psShape);
+                    continue;
+                }
+
+                size_t nWKBSize = 0;
+                if (psShape != nullptr && psShape->nSHPType == SHPT_POINT &&
+                    eLayerGeomType == wkbPoint)
+                {
+                    // Fast path for 2D points: directly build the WKB
+                    nWKBSize = 1 + sizeof(uint32_t) + 2 * sizeof(double);
+                    abyWKB.resize(nWKBSize);
+                    abyWKB[0] = wkbNDR;
+                    uint32_t nType = wkbPoint;
+                    double dfX = psShape->padfX[0];
+                    double dfY = psShape->padfY[0];
+                    CPL_LSBPTR32(&nType);
+                    CPL_LSBPTR64(&dfX);
+                    CPL_LSBPTR64(&dfY);
+                    memcpy(abyWKB.data() + 1, &nType, sizeof(nType));
+                    memcpy(abyWKB.data() + 5, &dfX, sizeof(dfX));
+                    memcpy(abyWKB.data() + 13, &dfY, sizeof(dfY));
+                    SHPDestroyObject(psShape);
+                }
+                else
+                {
+                    std::unique_ptr<OGRGeometry> poGeom(
+                        SHPReadOGRObject(m_hSHP, iShape, psShape,
+                                         m_bHasWarnedWrongWindingOrder));
+                    if (poGeom && eLayerGeomType != wkbUnknown)
+                    {
+                        // Same normalization as SHPReadOGRFeature()
+                        poGeom->set3D(wkbHasZ(eLayerGeomType));
+                        poGeom->setMeasured(wkbHasM(eLayerGeomType));
+                    }
+                    if (poGeom)
+                    {
+                        nWKBSize = poGeom->WkbSize();
+                        abyWKB.resize(nWKBSize);
+                        if (poGeom->exportToWkb(wkbNDR, abyWKB.data(),
+                                                wkbVariantIso) != OGRERR_NONE)
+                        {
+                            nWKBSize = 0;
+                        }
+                    }
+                }
+
+                if (m_poFilterGeom != nullptr)
+                {
+                    OGREnvelope sEnvelope;
+                    if (nWKBSize == 0 ||
+                        !FilterWKBGeometry(abyWKB.data(), nWKBSize,
+                                           /* bEnvelopeAlreadySet = */ false,
+                                           sEnvelope))
+                    {
+                        continue;
+                    }
+                }
+
+                if (iGeomArrowField >= 0)
+                {
+                    auto psArray = out_array->children[iGeomArrowField];
+                    if (nWKBSize == 0)
+                    {
+                        if (!sHelper.SetNull(iGeomArrowField, iFeat))
+                            return ReturnError();
+                    }
+                    else
+                    {
+                        if (iFeat > 0)
+                        {
+                            const auto panOffsets = static_cast<int32_t *>(
+                                const_cast<void *>(psArray->buffers[1]));
+                            const uint32_t nCurLength =
+                                static_cast<uint32_t>(panOffsets[iFeat]);
+                            if (nWKBSize <= nMemLimit &&
+                                nWKBSize > nMemLimit - nCurLength)
+                            {
+                                CPLDebug("Shape",
+                                         "GetNextArrowArray(): premature "
+                                         "notification of %d features to "
+                                         "consumer due to too big array",
+                                         iFeat);
+                                // Rewind to that shape for the next call
+                                if (m_panMatchingFIDs != nullptr)
+                                    m_iMatchingFID -= nCandidates - iCandidate;
+                                else
+                                    m_iNextShapeId = iShape;
+                                bStop = true;
+                                break;
+                            }
+                        }
+                        GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                            iGeomArrowField, iFeat, nWKBSize);
+                        if (outPtr == nullptr)
+                            return ReturnError();
+                        memcpy(outPtr, abyWKB.data(), nWKBSize);
+                    }
+                }
+            }
+
+            if (sHelper.m_panFIDValues)
+                sHelper.m_panFIDValues[iFeat] = iShape;
+            if (pszRecord)
+                apszRecords.push_back(pszRecord);
+            ++m_nFeaturesRead;
+            ++iFeat;
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Decode attributes of accepted records, column by column.    */
+        /* ---------------------------------------------------------------- */
+        for (int iField = 0; m_hDBF && iField < nFieldCount; ++iField)
+        {
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[iField];
+            if (iArrowField < 0)
+                continue;
+            const OGRFieldDefn *poFieldDefn =
+                m_poFeatureDefn->GetFieldDefnUnsafe(iField);
+            const OGRFieldType eType = poFieldDefn->GetType();
+            const OGRFieldSubType eSubType = poFieldDefn->GetSubType();
+            const char chNativeType = m_hDBF->pachFieldType[iField];
+            const int nFieldOffset = m_hDBF->panFieldOffset[iField];
+            const int nFieldSize = m_hDBF->panFieldSize[iField];
+            auto psArray = out_array->children[iArrowField];
+
+            for (int iRow = 0; iRow < static_cast<int>(apszRecords.size());
+                 ++iRow)
+            {
+                const int iRowFeat = iFeatChunkStart + iRow;
+
+                // Same trimming as DBFReadStringAttribute()
+                const char *pszVal = apszRecords[iRow] + nFieldOffset;
+                size_t nLen = strnlen(pszVal, nFieldSize);
+                while (nLen > 0 && *pszVal == ' ')
+                {
+                    ++pszVal;
+                    --nLen;
+                }
+                while (nLen > 0 && pszVal[nLen - 1] == ' ')
+                    --nLen;
+
+                // Same logic as DBFIsAttributeNULL() / SHPReadOGRFeature()
+                bool bIsNull;
+                if (eType == OFTString)
+                {
+                    bIsNull = (nLen == 0);
+                }
+                else
+                {
+                    switch (chNativeType)
+                    {
+                        case 'N':
+                        case 'F':
+                            bIsNull = nLen == 0 || pszVal[0] == '*';
+                            break;
+                        case 'D':
+                            bIsNull =
+                                nLen == 0 ||
+                                (nLen >= 8 &&
+                                 memcmp(pszVal, "00000000", 8) == 0) ||
+                                (nLen == 1 && pszVal[0] == '0') ||
+                                (static_cast<int>(nLen) == nFieldSize &&
+                                 std::all_of(pszVal, pszVal + nLen,
+                                             [](char ch)
+                                             { return ch == '0'; }));
+                            break;
+                        case 'L':
+                            bIsNull = nLen > 0 && pszVal[0] == '?';
+                            break;
+                        default:
+                            bIsNull = (nLen == 0);
+                            break;
+                    }
+                }
+                if (bIsNull)
+                {
+                    if (!sHelper.SetNull(iArrowField, iRowFeat))
+                        return ReturnError();
+                    continue;
+                }
+
+                if (eType == OFTString)
+                {
+                    const char *pszUTF8 = pszVal;
+                    size_t nUTF8Len = nLen;
+                    char *pszRecoded = nullptr;
+                    if (!m_osEncoding.empty())
+                    {
+                        osTmp.assign(pszVal, nLen);
+                        pszRecoded = CPLRecode(osTmp.c_str(),
+                                               m_osEncoding.c_str(),
+                                               CPL_ENC_UTF8);
+                        pszUTF8 = pszRecoded;
+                        nUTF8Len = strlen(pszRecoded);
+                    }
+                    GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                        iArrowField, iRowFeat, nUTF8Len);
+                    if (outPtr == nullptr)
+                    {
+                        CPLFree(pszRecoded);
+                        return ReturnError();
+                    }
+                    memcpy(outPtr, pszUTF8, nUTF8Len);
+                    CPLFree(pszRecoded);
+                    continue;
+                }
+
+                if (eType == OFTInteger && eSubType == OFSTBoolean)
+                {
+                    const char ch = nLen ? pszVal[0] : 0;
+                    if (ch == 'T' || ch == 't' || ch == 'Y' || ch == 'y')
+                        sHelper.SetBoolOn(psArray, iRowFeat);
+                    continue;
+                }
+
+                osTmp.assign(pszVal, nLen);
+                switch (eType)
+                {
+                    case OFTInteger:
+                    {
+                        const long long nVal64 =
+                            std::strtoll(osTmp.c_str(), nullptr, 10);
+                        const int nVal = nVal64 > INT_MAX   ? INT_MAX
+                                         : nVal64 < INT_MIN ? INT_MIN
+                                                            : static_cast<int>(
+                                                                  nVal64);
+                        sHelper.SetInt32(psArray, iRowFeat, nVal);
+                        break;
+                    }
+
+                    case OFTInteger64:
+                    {
+                        sHelper.SetInt64(
+                            psArray, iRowFeat,
+                            std::strtoll(osTmp.c_str(), nullptr, 10));
+                        break;
+                    }
+
+                    case OFTReal:
+                    {
+                        sHelper.SetDouble(psArray, iRowFeat,
+                                          CPLStrtod(osTmp.c_str(), nullptr));
+                        break;
+                    }
+
+                    case OFTDate:
+                    {
+                        OGRField sFld;
+                        memset(&sFld, 0, sizeof(sFld));
+                        const char *pszDateValue = osTmp.c_str();
+                        if (nLen >= 10 && pszDateValue[2] == '/' &&
+                            pszDateValue[5] == '/')
+                        {
+                            sFld.Date.Month =
+                                static_cast<GByte>(atoi(pszDateValue + 0));
+                            sFld.Date.Day =
+                                static_cast<GByte>(atoi(pszDateValue + 3));
+                            sFld.Date.Year =
+                                static_cast<GInt16>(atoi(pszDateValue + 6));
+                        }
+                        else
+                        {
+                            const int nFullDate = atoi(pszDateValue);
+                            sFld.Date.Year =
+                                static_cast<GInt16>(nFullDate / 10000);
+                            sFld.Date.Month =
+                                static_cast<GByte>((nFullDate / 100) % 100);
+                            sFld.Date.Day = static_cast<GByte>(nFullDate % 100);
+                        }
+                        sHelper.SetDate(psArray, iRowFeat, brokenDown, sFld);
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+            }
+        }
     }
-    sHelper.Shrink(nCount);
-    if (nCount == 0)
+
+    sHelper.Shrink(iFeat);
+    if (iFeat == 0)
     {
         out_array->release(out_array);
         memset(out_array, 0, sizeof(*out_array));
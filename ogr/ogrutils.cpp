@@ -24,8 +24,6 @@
 #include <cstring>
 #include <cctype>
 #include <limits>
-#include <sstream>
-#include <iomanip>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -231,26 +229,39 @@ std::string OGRFormatDouble(double val, const OGRWktOptions &opts, int nDimIdx)
     if (std::isnan(val))
         return "nan";
 
-    static thread_local std::locale classic_locale = []()
-    { return std::locale::classic(); }();
-    std::ostringstream oss;
-    oss.imbue(classic_locale);  // Make sure we output decimal points.
-    bool l_round(opts.round);
-    if (opts.format == OGRWktFormat::F ||
-        (opts.format == OGRWktFormat::Default && fabs(val) < 1))
-        oss << std::fixed;
+    const bool bFixed = opts.format == OGRWktFormat::F ||
+                        (opts.format == OGRWktFormat::Default && fabs(val) < 1);
+    const bool l_round = bFixed && opts.round;
+    const int nPrecision = nDimIdx < 3    ? opts.xyPrecision
+                           : nDimIdx == 3 ? opts.zPrecision
+                                          : opts.mPrecision;
+
+    // CPLsnprintf() is much faster than std::ostringstream, and gives the
+    // same result as it uses the same "%.*f" / "%.*G" formatting under the
+    // hood, with a decimal point whatever the current locale.
+    // Uppercase because OGC spec says capital 'E'.
+    char szFormatting[32];
+    CPLsnprintf(szFormatting, sizeof(szFormatting), "%%.%d%c", nPrecision,
+                bFixed ? 'f' : 'G');
+    const auto Format = [&szFormatting, val](char *pszBuf, size_t nSize)
+    {
+        return CPLsnprintf(pszBuf, nSize, szFormatting, val);
+    };
+
+    std::string sval;
+    char szBuffer[64];
+    const int nLen = Format(szBuffer, sizeof(szBuffer));
+    if (nLen < 0)
+        return sval;
+    if (static_cast<size_t>(nLen) < sizeof(szBuffer))
+    {
+        sval.assign(szBuffer, nLen);
+    }
     else
     {
-        // Uppercase because OGC spec says capital 'E'.
-        oss << std::uppercase;
-        l_round = false;
+        sval.resize(nLen);
+        Format(&sval[0], sval.size() + 1);
     }
-    oss << std::setprecision(nDimIdx < 3    ? opts.xyPrecision
-                             : nDimIdx == 3 ? opts.zPrecision
-                                            : opts.mPrecision);
-    oss << val;
-
-    std::string sval = oss.str();
 
     if (l_round)
         intelliround(sval);
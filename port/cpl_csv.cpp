@@ -13,6 +13,7 @@
 
 #include "cpl_port.h"
 #include "cpl_csv.h"
+#include "cpl_csv_priv.h"
 
 #include <cstddef>
 #include <cstdlib>
@@ -259,32 +260,52 @@ void CSVDeaccess(const char *pszFilename)
 /*      semantics.                                                      */
 /************************************************************************/
 
-static char **CSVSplitLine(const char *pszString, const char *pszDelimiter,
-                           bool bKeepLeadingAndClosingQuotes,
-                           bool bMergeDelimiter)
+/** Tokenize a CSV line into fields in the form of a string list.
+ *
+ * The return result is a stringlist, in the sense of the CSL functions, to
+ * be freed with CSLDestroy().
+ *
+ * @param pszString Line to tokenize (may be NULL).
+ * @param pszDelimiter Delimiter sequence (can be multiple bytes)
+ * @param bKeepLeadingAndClosingQuotes Whether the leading and closing double
+ *                                     quote characters should be kept.
+ * @param bMergeDelimiter Whether consecutive delimiters should be considered
+ *                        as a single one. Should generally be set to false.
+ */
+char **CSVSplitLine(const char *pszString, const char *pszDelimiter,
+                    bool bKeepLeadingAndClosingQuotes, bool bMergeDelimiter)
 
 {
     CPLStringList aosRetList;
     if (pszString == nullptr)
         return static_cast<char **>(CPLCalloc(sizeof(char *), 1));
 
-    char *pszToken = static_cast<char *>(CPLCalloc(10, 1));
-    int nTokenMax = 10;
+    char *pszToken = nullptr;
+    int nTokenMax = 0;
     const size_t nDelimiterLength = strlen(pszDelimiter);
 
     const char *pszIter = pszString;
     while (*pszIter != '\0')
     {
-        bool bInString = false;
-
-        int nTokenLen = 0;
-
-        // Try to find the next delimiter, marking end of token.
-        do
+        if (*pszIter != '"' && nDelimiterLength > 0)
         {
-            // End if this is a delimiter skip it and break.
-            if (!bInString &&
-                strncmp(pszIter, pszDelimiter, nDelimiterLength) == 0)
+            // Fast path for a field that does not start with a double quote:
+            // double quotes in the middle of a field are not special, so the
+            // field extends up to the next delimiter. strchr() / strstr() are
+            // typically vectorized by the C library.
+            const char *pszEnd = nDelimiterLength == 1
+                                     ? strchr(pszIter, pszDelimiter[0])
+                                     : strstr(pszIter, pszDelimiter);
+            if (pszEnd == nullptr)
+                pszEnd = pszIter + strlen(pszIter);
+            const size_t nLen = static_cast<size_t>(pszEnd - pszIter);
+            char *pszField = static_cast<char *>(CPLMalloc(nLen + 1));
+            memcpy(pszField, pszIter, nLen);
+            pszField[nLen] = '\0';
+            aosRetList.AddStringDirectly(pszField);
+
+            pszIter = pszEnd;
+            if (*pszIter != '\0')
             {
                 pszIter += nDelimiterLength;
                 if (bMergeDelimiter)
@@ -293,41 +314,91 @@ static char **CSVSplitLine(const char *pszString, const char *pszDelimiter,
                            0)
                         pszIter += nDelimiterLength;
                 }
-                break;
+            }
+        }
+        else
+        {
+            if (pszToken == nullptr)
+            {
+                nTokenMax = 10;
+                pszToken = static_cast<char *>(CPLCalloc(nTokenMax, 1));
             }
 
-            if (*pszIter == '"')
+            bool bInString = false;
+
+            int nTokenLen = 0;
+
+            // Try to find the next delimiter, marking end of token.
+            do
             {
-                if (!bInString && nTokenLen > 0)
+                // End if this is a delimiter skip it and break.
+                if (!bInString &&
+                    strncmp(pszIter, pszDelimiter, nDelimiterLength) == 0)
                 {
-                    // do not treat in a special way double quotes that appear
-                    // in the middle of a field (similarly to OpenOffice)
-                    // Like in records: 1,50°46'06.6"N 116°42'04.4,foo
+                    pszIter += nDelimiterLength;
+                    if (bMergeDelimiter)
+                    {
+                        while (strncmp(pszIter, pszDelimiter,
+                                       nDelimiterLength) == 0)
+                            pszIter += nDelimiterLength;
+                    }
+                    break;
                 }
-                else if (!bInString || pszIter[1] != '"')
+
+                if (*pszIter == '"')
                 {
-                    bInString = !bInString;
-                    if (!bKeepLeadingAndClosingQuotes)
-                        continue;
+                    if (!bInString && nTokenLen > 0)
+                    {
+                        // do not treat in a special way double quotes that
+                        // appear in the middle of a field (similarly to
+                        // OpenOffice)
+                        // Like in records: 1,50°46'06.6"N 116°42'04.4,foo
+                    }
+                    else if (!bInString || pszIter[1] != '"')
+                    {
+                        bInString = !bInString;
+                        if (!bKeepLeadingAndClosingQuotes)
+                            continue;
+                    }
+                    else  // Doubled quotes in string resolve to one quote.
+                    {
+                        pszIter++;
+                    }
                 }
-                else  // Doubled quotes in string resolve to one quote.
+
+                // Within a quoted string, everything up to the next double
+                // quote can be copied at once.
+                size_t nSpan = 1;
+                if (bInString && *pszIter != '"')
                 {
-                    pszIter++;
+                    const char *pszQuote = strchr(pszIter, '"');
+                    nSpan = pszQuote ? static_cast<size_t>(pszQuote - pszIter)
+                                     : strlen(pszIter);
                 }
-            }
 
-            if (nTokenLen >= nTokenMax - 2)
-            {
-                nTokenMax = nTokenMax * 2 + 10;
-                pszToken = static_cast<char *>(CPLRealloc(pszToken, nTokenMax));
-            }
+                if (nSpan > static_cast<size_t>(INT_MAX - 10 - nTokenLen) / 2)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "CSVSplitLine(): too large token");
+                    CPLFree(pszToken);
+                    return static_cast<char **>(CPLCalloc(sizeof(char *), 1));
+                }
+                if (nTokenLen + static_cast<int>(nSpan) >= nTokenMax - 2)
+                {
+                    nTokenMax =
+                        (nTokenLen + static_cast<int>(nSpan)) * 2 + 10;
+                    pszToken =
+                        static_cast<char *>(CPLRealloc(pszToken, nTokenMax));
+                }
 
-            pszToken[nTokenLen] = *pszIter;
-            nTokenLen++;
-        } while (*(++pszIter) != '\0');
+                memcpy(pszToken + nTokenLen, pszIter, nSpan);
+                nTokenLen += static_cast<int>(nSpan);
+                pszIter += nSpan - 1;
+            } while (*(++pszIter) != '\0');
 
-        pszToken[nTokenLen] = '\0';
-        aosRetList.AddString(pszToken);
+            pszToken[nTokenLen] = '\0';
+            aosRetList.AddString(pszToken);
+        }
 
         // If the last token is an empty token, then we have to catch
         // it now, otherwise we won't reenter the loop and it will be lost.
@@ -658,33 +729,39 @@ CSVReadParseLineGeneric(void *fp, const char *(*pfnReadLine)(void *, size_t),
         {
             for (; i < osWorkLine.size(); ++i)
             {
-                if (osWorkLine[i] == '\"')
+                // Skip directly to the next double quote character
+                const char *pszQuote = static_cast<const char *>(
+                    memchr(osWorkLine.data() + i, '"', osWorkLine.size() - i));
+                if (pszQuote == nullptr)
                 {
-                    if (!bInString)
-                    {
-                        // Only consider " as the start of a quoted string
-                        // if it is the first character of the line, or
-                        // if it is immediately after the field delimiter.
-                        if (i == 0 ||
-                            (i >= nDelimiterLength &&
-                             osWorkLine.compare(i - nDelimiterLength,
-                                                nDelimiterLength, pszDelimiter,
-                                                nDelimiterLength) == 0))
-                        {
-                            bInString = true;
-                        }
-                    }
-                    else if (i + 1 < osWorkLine.size() &&
-                             osWorkLine[i + 1] == '"')
-                    {
-                        // Escaped double quote in a quoted string
-                        ++i;
-                    }
-                    else
+                    i = osWorkLine.size();
+                    break;
+                }
+                i = static_cast<size_t>(pszQuote - osWorkLine.data());
+                if (!bInString)
+                {
+                    // Only consider " as the start of a quoted string
+                    // if it is the first character of the line, or
+                    // if it is immediately after the field delimiter.
+                    if (i == 0 ||
+                        (i >= nDelimiterLength &&
+                         osWorkLine.compare(i - nDelimiterLength,
+                                            nDelimiterLength, pszDelimiter,
+                                            nDelimiterLength) == 0))
                     {
-                        bInString = false;
+                        bInString = true;
                     }
                 }
+                else if (i + 1 < osWorkLine.size() &&
+                         osWorkLine[i + 1] == '"')
+                {
+                    // Escaped double quote in a quoted string
+                    ++i;
+                }
+                else
+                {
+                    bInString = false;
+                }
             }
 
             if (!bInString)
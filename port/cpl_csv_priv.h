@@ -0,0 +1,27 @@
+/******************************************************************************
+ *
+ * Project:  Common Portability Library
+ * Purpose:  Private declarations of the CSV reading functions.
+ * Author:   Frank Warmerdam, warmerdam@pobox.com
+ *
+ ******************************************************************************
+ * Copyright (c) 1999, Frank Warmerdam
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef CPL_CSV_PRIV_H_INCLUDED
+#define CPL_CSV_PRIV_H_INCLUDED
+
+#ifdef GDAL_COMPILATION
+// internal only
+
+#include "cpl_port.h"
+
+char CPL_DLL **CSVSplitLine(const char *pszString, const char *pszDelimiter,
+                            bool bKeepLeadingAndClosingQuotes,
+                            bool bMergeDelimiter);
+
+#endif /* GDAL_COMPILATION */
+
+#endif /* ndef CPL_CSV_PRIV_H_INCLUDED */